@@ -1,5 +1,8 @@
 using System;
+using System.Collections;
+using System.Collections.Generic;
 using System.Runtime.CompilerServices;
+using System.Threading.Tasks;
 
 namespace Forge
 {
@@ -75,11 +78,173 @@ namespace Forge
         }
     }
 
+    // Opt-in for parallel OnUpdate on engine worker threads.
+    // A [ThreadSafe] script may only read/write its own entity's components
+    // (Transform) and must not share mutable static state. Structural changes
+    // (Name, hierarchy) are deferred and applied on the main thread after the
+    // parallel phase.
+    [AttributeUsage(AttributeTargets.Class, Inherited = false)]
+    public sealed class ThreadSafeAttribute : Attribute {}
+
     public abstract class MonoBehaviour : Entity
     {
         // These are called by the C++ engine
         protected virtual void OnStart() {}
         protected virtual void OnUpdate(float deltaTime) {}
+
+        protected Coroutine StartCoroutine(IEnumerator routine) => Coroutine.Start(routine);
+        protected void StopCoroutine(Coroutine coroutine) => coroutine?.Stop();
+    }
+
+    // Yield instructions understood by Coroutine.
+    // `yield return null` waits one frame; `yield return someTask` (or
+    // WaitForTask) resumes on the first frame after the task completes.
+    public sealed class WaitForSeconds
+    {
+        public readonly float Seconds;
+        public WaitForSeconds(float seconds) { Seconds = seconds; }
+    }
+
+    public sealed class WaitForFrames
+    {
+        public readonly int Frames;
+        public WaitForFrames(int frames) { Frames = frames; }
+    }
+
+    public sealed class WaitForTask
+    {
+        public readonly Task Task;
+        public WaitForTask(Task task) { Task = task; }
+    }
+
+    // A suspended coroutine costs nothing per frame: the wait is registered
+    // in the engine's timer wheel and the engine calls ResumeBatch once per
+    // frame with only the coroutines that are due.
+    public sealed class Coroutine
+    {
+        private static readonly Dictionary<int, Coroutine> s_Active = new Dictionary<int, Coroutine>();
+        private static readonly object s_Lock = new object();
+        private static int s_NextID = 1;
+
+        public readonly int ID;
+        private readonly IEnumerator m_Routine;
+        private readonly TaskCompletionSource<bool> m_Completion;
+
+        public bool IsRunning
+        {
+            get { lock (s_Lock) return s_Active.ContainsKey(ID); }
+        }
+
+        private Coroutine(IEnumerator routine, TaskCompletionSource<bool> completion)
+        {
+            m_Routine = routine;
+            m_Completion = completion;
+            lock (s_Lock)
+            {
+                ID = s_NextID++;
+                s_Active.Add(ID, this);
+            }
+        }
+
+        public static Coroutine Start(IEnumerator routine)
+        {
+            var coroutine = new Coroutine(routine, null);
+            coroutine.Step();
+            return coroutine;
+        }
+
+        // Awaitable waits for async methods. There is no SynchronizationContext,
+        // so continuations run inline on the main thread inside ResumeBatch.
+        public static Task Delay(float seconds)
+        {
+            var coroutine = new Coroutine(null, new TaskCompletionSource<bool>());
+            InternalCalls.Coroutine_WaitSeconds(coroutine.ID, seconds);
+            return coroutine.m_Completion.Task;
+        }
+
+        public static Task NextFrame(int frames = 1)
+        {
+            var coroutine = new Coroutine(null, new TaskCompletionSource<bool>());
+            InternalCalls.Coroutine_WaitFrames(coroutine.ID, frames);
+            return coroutine.m_Completion.Task;
+        }
+
+        public void Stop()
+        {
+            bool wasActive;
+            lock (s_Lock) wasActive = s_Active.Remove(ID);
+            // Frees the pending native wait so it never fires
+            if (wasActive)
+                InternalCalls.Coroutine_Cancel(ID);
+        }
+
+        private void Step()
+        {
+            if (m_Routine == null)
+            {
+                Stop();
+                m_Completion.SetResult(true);
+                return;
+            }
+
+            try
+            {
+                if (!m_Routine.MoveNext())
+                {
+                    Stop();
+                    return;
+                }
+            }
+            catch (Exception e)
+            {
+                Console.WriteLine($"Coroutine {ID} failed: {e}");
+                Stop();
+                return;
+            }
+
+            switch (m_Routine.Current)
+            {
+                case WaitForSeconds wait:
+                    InternalCalls.Coroutine_WaitSeconds(ID, wait.Seconds);
+                    break;
+                case WaitForFrames wait:
+                    InternalCalls.Coroutine_WaitFrames(ID, wait.Frames);
+                    break;
+                case WaitForTask wait:
+                    Await(wait.Task);
+                    break;
+                case Task task:
+                    Await(task);
+                    break;
+                default:
+                    InternalCalls.Coroutine_WaitFrames(ID, 1);
+                    break;
+            }
+        }
+
+        private void Await(Task task)
+        {
+            // Signal is thread-safe; the resume itself always happens on the
+            // main thread at the next ResumeBatch.
+            int id = ID;
+            task.ContinueWith(_ => InternalCalls.Coroutine_Signal(id),
+                              TaskContinuationOptions.ExecuteSynchronously);
+        }
+
+        // Called by the C++ engine with every coroutine due this frame
+        private static void ResumeBatch(int[] ids)
+        {
+            foreach (int id in ids)
+            {
+                Coroutine coroutine;
+                lock (s_Lock)
+                {
+                    if (!s_Active.TryGetValue(id, out coroutine))
+                        continue;
+                }
+                coroutine.Step();
+            }
+        }
     }
 
     internal static class InternalCalls
@@ -107,5 +272,17 @@ namespace Forge
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         internal static extern void Transform_SetScale(uint entityID, ref Vector3 value);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern void Coroutine_WaitSeconds(int coroutineID, float seconds);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern void Coroutine_WaitFrames(int coroutineID, int frames);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern void Coroutine_Signal(int coroutineID);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        internal static extern void Coroutine_Cancel(int coroutineID);
     }
 }
@@ -1,6 +1,7 @@
 using Forge;
 using System;
 
+[ThreadSafe]
 public class PlayerController : MonoBehaviour
 {
     public float Speed = 5.0f;
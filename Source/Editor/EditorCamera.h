@@ -13,6 +13,9 @@ public:
   DirectX::XMMATRIX GetProjectionMatrix(float aspectRatio) const;
 
   float GetDistance() const { return m_Distance; }
+  float GetFOV() const { return m_FOV; } // vertical, degrees
+  float GetNearPlane() const { return m_NearPlane; }
+  float GetFarPlane() const { return m_FarPlane; }
   void SetDistance(float distance) { m_Distance = distance; }
 
   DirectX::XMFLOAT3 GetPosition() const { return m_Position; }
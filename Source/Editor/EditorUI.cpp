@@ -1,9 +1,15 @@
 #include "EditorUI.h"
+#include "../Runtime/Renderer/DX12Context.h"
+#include "../Runtime/Scripting/ScriptEngine.h"
+#include "../Runtime/Scripting/ScriptProfiler.h"
 #include <backends/imgui_impl_dx12.h>
 #include <backends/imgui_impl_win32.h>
 #include <imgui.h>
 #include <imgui_internal.h>
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
+#include <map>
 
 namespace Forge {
 
@@ -14,11 +20,8 @@ void EditorUI::SetActiveScene(std::shared_ptr<Scene> scene) {
   m_ActiveScene = scene;
 }
 
-void EditorUI::Initialize(void *windowHandle, ID3D12Device *device,
-                          int numFrames, DXGI_FORMAT rtvFormat,
-                          ID3D12DescriptorHeap *srvHeap,
-                          D3D12_CPU_DESCRIPTOR_HANDLE fontSrvCpu,
-                          D3D12_GPU_DESCRIPTOR_HANDLE fontSrvGpu) {
+void EditorUI::Initialize(void *windowHandle, DX12Context *context,
+                          DXGI_FORMAT rtvFormat) {
   IMGUI_CHECKVERSION();
   ImGui::CreateContext();
   ImGuiIO &io = ImGui::GetIO();
@@ -29,8 +32,11 @@ void EditorUI::Initialize(void *windowHandle, ID3D12Device *device,
   ImGui::StyleColorsDark();
 
   ImGui_ImplWin32_Init(windowHandle);
-  ImGui_ImplDX12_Init(device, numFrames, rtvFormat, srvHeap, fontSrvCpu,
-                      fontSrvGpu);
+  // ImGui keeps per-frame vertex/index buffers: one per frame in flight
+  ImGui_ImplDX12_Init(context->GetDevice(), context->GetFramesInFlight(),
+                      rtvFormat, context->GetSRVHeap(),
+                      context->GetImGuiFontSRVCPU(),
+                      context->GetImGuiFontSRVGPU());
 
   // Fix: Re-enable RendererHasTextures and build font atlas
   io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
@@ -39,7 +45,15 @@ void EditorUI::Initialize(void *windowHandle, ID3D12Device *device,
   io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
 
   // Initialize isolated Scene View Renderer
-  m_SceneViewRenderer.Initialize(device, srvHeap);
+  m_Context = context;
+  m_SceneViewRenderer.Initialize(context->GetRHIDevice(),
+                                 context->GetDescriptorAllocator(),
+                                 context->GetUploadRing(),
+                                 context->GetUploadManager(),
+                                 context->GetShaderHotReload(),
+                                 context->GetParallelRecorder(),
+                                 context->GetRenderGraph(),
+                                 context->GetReleaseQueue());
 }
 
 void EditorUI::Shutdown() {
@@ -55,9 +69,13 @@ void EditorUI::NewFrame() {
   ImGui::NewFrame();
 }
 
-void EditorUI::Draw(ID3D12GraphicsCommandList *commandList) {
+void EditorUI::Draw(RHICommandList *commandList) {
+  FORGE_PROFILE_SCOPE("EditorUI::Draw");
   // Render Scene View (isolated from UI) - PHASE 2: pass camera
-  m_SceneViewRenderer.Render(commandList, &m_EditorCamera);
+  // The mesh pass may fork command lists; ImGui records on the list
+  // returned here (DX12Context::GetCommandList)
+  m_SceneViewRenderer.Render(commandList, &m_EditorCamera,
+                             m_ActiveScene.get());
 
   // Draw Editor UI panels
   DrawDockSpace();
@@ -65,12 +83,23 @@ void EditorUI::Draw(ID3D12GraphicsCommandList *commandList) {
   DrawInspector();
   DrawContentBrowser();
   DrawViewport();
+  DrawScriptProfiler();
+  DrawProfiler();
+  DrawRendererStats();
 
-  ImGui::Render();
+  {
+    FORGE_PROFILE_SCOPE("ImGui::Render");
+    ImGui::Render();
+  }
 }
 
 void EditorUI::Render(ID3D12GraphicsCommandList *commandList) {
-  ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList);
+  {
+    GPUProfileScope gpuScope(m_Context ? m_Context->GetGPUProfiler() : nullptr,
+                             m_Context ? m_Context->GetCommandList() : nullptr,
+                             "ImGui");
+    ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList);
+  }
 
   ImGuiIO &io = ImGui::GetIO();
   if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
@@ -120,6 +149,9 @@ void EditorUI::DrawDockSpace() {
     ImGui::DockBuilderDockWindow("Viewport", dockMain);
     ImGui::DockBuilderDockWindow("Inspector", dockRight);
     ImGui::DockBuilderDockWindow("Content Browser", dockBottom);
+    ImGui::DockBuilderDockWindow("Script Profiler", dockBottom);
+    ImGui::DockBuilderDockWindow("Profiler", dockBottom);
+    ImGui::DockBuilderDockWindow("Renderer Stats", dockBottom);
 
     ImGui::DockBuilderFinish(dockSpaceId);
   }
@@ -135,6 +167,16 @@ void EditorUI::DrawDockSpace() {
       }
       if (ImGui::MenuItem("Save Scene", "Ctrl+S")) {
       }
+      if (ImGui::MenuItem("Save CPU Screenshot")) {
+        // Software rasterizer, viewport size: diffable against GPU output
+        RasterImage image = m_SceneViewRenderer.RenderSoftware(
+            &m_EditorCamera, m_ActiveScene.get(),
+            m_SceneViewRenderer.GetWidth(), m_SceneViewRenderer.GetHeight());
+        if (image.WritePPM("SceneView.ppm"))
+          std::cout << "[EditorUI] Saved SceneView.ppm" << std::endl;
+        else
+          std::cerr << "[EditorUI] Failed to write SceneView.ppm" << std::endl;
+      }
       ImGui::Separator();
       if (ImGui::MenuItem("Exit", "Alt+F4")) {
         PostQuitMessage(0);
@@ -153,6 +195,9 @@ void EditorUI::DrawDockSpace() {
       ImGui::MenuItem("Inspector");
       ImGui::MenuItem("Content Browser");
       ImGui::MenuItem("Viewport");
+      ImGui::MenuItem("Script Profiler");
+      ImGui::MenuItem("Profiler");
+      ImGui::MenuItem("Renderer Stats");
       ImGui::EndMenu();
     }
     if (ImGui::BeginMenu("Help")) {
@@ -308,6 +353,59 @@ void EditorUI::DrawInspector() {
       ImGui::DragFloat3("Rotation", &transform.Rotation.x, 0.1f);
       ImGui::DragFloat3("Scale", &transform.Scale.x, 0.1f);
     }
+
+    // Mesh
+    if (MeshComponent *mesh = m_SelectedEntity->GetMesh()) {
+      if (ImGui::CollapsingHeader("Mesh", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const char *meshNames[] = {"Cube", "Sphere"};
+        int meshIndex = (int)mesh->MeshID;
+        if (ImGui::Combo("Mesh", &meshIndex, meshNames,
+                         IM_ARRAYSIZE(meshNames)))
+          mesh->MeshID = (uint32_t)meshIndex;
+        int material = (int)mesh->MaterialID;
+        if (ImGui::InputInt("Material", &material) && material >= 0)
+          mesh->MaterialID = (uint32_t)material;
+        if (ImGui::Button("Remove Mesh"))
+          m_SelectedEntity->RemoveMesh();
+      }
+    } else if (ImGui::Button("Add Mesh")) {
+      m_SelectedEntity->AddMesh();
+    }
+
+    // LOD (meshes with a LOD chain)
+    if (LODComponent *lod = m_SelectedEntity->GetLOD()) {
+      if (ImGui::CollapsingHeader("LOD", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::InputInt("Forced LOD", &lod->ForcedLOD);
+        if (lod->ForcedLOD < -1)
+          lod->ForcedLOD = -1;
+        ImGui::DragFloat("Bias", &lod->Bias, 0.05f, -4.0f, 4.0f);
+        ImGui::Text("Current LOD: %u", (unsigned)lod->CurrentLOD);
+        if (ImGui::Button("Remove LOD"))
+          m_SelectedEntity->RemoveLOD();
+      }
+    } else if (ImGui::Button("Add LOD")) {
+      m_SelectedEntity->AddLOD();
+    }
+
+    // Light
+    if (LightComponent *light = m_SelectedEntity->GetLight()) {
+      if (ImGui::CollapsingHeader("Light", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const char *typeNames[] = {"Directional", "Point", "Spot"};
+        int type = (int)light->Type;
+        if (ImGui::Combo("Type", &type, typeNames, IM_ARRAYSIZE(typeNames)))
+          light->Type = (LightType)type;
+        ImGui::ColorEdit3("Color", &light->Color.x);
+        ImGui::DragFloat("Intensity", &light->Intensity, 0.05f, 0.0f, 100.0f);
+        if (light->Type != LightType::Directional)
+          ImGui::DragFloat("Range", &light->Range, 0.1f, 0.0f, 1000.0f);
+        if (light->Type == LightType::Spot)
+          ImGui::SliderFloat("Spot Angle", &light->SpotAngle, 1.0f, 89.0f);
+        if (ImGui::Button("Remove Light"))
+          m_SelectedEntity->RemoveLight();
+      }
+    } else if (ImGui::Button("Add Light")) {
+      m_SelectedEntity->AddLight();
+    }
   } else {
     ImGui::Text("No Entity Selected");
   }
@@ -419,7 +517,7 @@ void EditorUI::DrawViewport() {
 
   // Display Scene View RT as Image
   if (m_SceneViewRenderer.IsValid()) {
-    ImGui::Image((ImTextureID)m_SceneViewRenderer.GetSRV().ptr, viewportSize);
+    ImGui::Image((ImTextureID)m_SceneViewRenderer.GetSRV().Ptr, viewportSize);
   }
 
   // Input Isolation [GLOBAL RULE] - PHASE 3
@@ -443,4 +541,403 @@ void EditorUI::DrawViewport() {
   ImGui::PopStyleVar();
 }
 
+void EditorUI::DrawScriptProfiler() {
+  ImGui::Begin("Script Profiler");
+
+  bool enabled = ScriptProfiler::IsEnabled();
+  if (ImGui::Checkbox("Enabled", &enabled)) {
+    ScriptProfiler::SetEnabled(enabled);
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Reset")) {
+    ScriptProfiler::Reset();
+  }
+  ImGui::SameLine();
+  if (ScriptProfiler::IsCapturing()) {
+    if (ImGui::Button("Stop Capture")) {
+      ScriptProfiler::StopCapture();
+      ScriptProfiler::ExportTrace("script_trace.json");
+    }
+  } else if (ImGui::Button("Capture Trace")) {
+    ScriptProfiler::StartCapture();
+  }
+
+  const ScriptStartupStats &startup = ScriptEngine::GetStartupStats();
+  ImGui::Text("Startup (%s): init %.1f ms, load %.1f ms, first frame %.1f ms",
+              startup.AOTEnabled && startup.AOTImageFound ? "AOT" : "JIT",
+              startup.InitMs, startup.LoadAssemblyMs,
+              startup.FirstInstantiateMs + startup.FirstUpdateMs);
+
+  ScriptGCStats gc = ScriptProfiler::GetGCStats();
+  ImGui::Text("GC: %llu collections (nursery %llu / major %llu)",
+              (unsigned long long)gc.CollectionCount,
+              (unsigned long long)gc.CollectionsByGeneration[0],
+              (unsigned long long)gc.CollectionsByGeneration[1]);
+  ImGui::Text("GC Pause: last %.3f ms, max %.3f ms, total %.2f ms",
+              gc.LastPauseMs, gc.MaxPauseMs, gc.TotalPauseMs);
+
+  ScriptHeapStats heap = ScriptEngine::GetHeapStats();
+  ImGui::Text("Heap: %.1f / %.1f MB used, +%.1f KB/frame",
+              heap.UsedBytes / (1024.0 * 1024.0),
+              heap.HeapSizeBytes / (1024.0 * 1024.0),
+              heap.AvgGrowthPerFrameBytes / 1024.0);
+  ImGui::Text("Paced GC: %llu in slack, %llu urgent (last %.3f ms, est. "
+              "%.3f ms)",
+              (unsigned long long)heap.PacedCollections,
+              (unsigned long long)heap.UrgentCollections, heap.LastPacedMs,
+              heap.EstimatedMinorMs);
+  ImGui::Separator();
+
+  if (ImGui::BeginTable("ScriptStats", 4,
+                        ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV |
+                            ImGuiTableFlags_Resizable |
+                            ImGuiTableFlags_ScrollY)) {
+    ImGui::TableSetupColumn("Class / Method",
+                            ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Inclusive (ms)");
+    ImGui::TableSetupColumn("Alloc (KB)");
+    ImGui::TableHeadersRow();
+
+    for (const ScriptClassStats &cls : ScriptProfiler::GetClassStats()) {
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      bool opened = ImGui::TreeNodeEx(cls.ClassName.c_str(),
+                                      ImGuiTreeNodeFlags_SpanFullWidth);
+      ImGui::TableSetColumnIndex(1);
+      ImGui::Text("%llu", (unsigned long long)cls.CallCount);
+      ImGui::TableSetColumnIndex(2);
+      ImGui::Text("%.3f", cls.InclusiveMs);
+      ImGui::TableSetColumnIndex(3);
+      ImGui::Text("%.1f", cls.AllocatedBytes / 1024.0);
+
+      if (opened) {
+        for (const ScriptMethodStats &method : cls.Methods) {
+          ImGui::TableNextRow();
+          ImGui::TableSetColumnIndex(0);
+          ImGui::TreeNodeEx(method.MethodName.c_str(),
+                            ImGuiTreeNodeFlags_Leaf |
+                                ImGuiTreeNodeFlags_NoTreePushOnOpen |
+                                ImGuiTreeNodeFlags_SpanFullWidth);
+          ImGui::TableSetColumnIndex(1);
+          ImGui::Text("%llu", (unsigned long long)method.CallCount);
+          ImGui::TableSetColumnIndex(2);
+          ImGui::Text("%.3f", method.InclusiveMs);
+          ImGui::TableSetColumnIndex(3);
+          ImGui::Text("%.1f", method.AllocatedBytes / 1024.0);
+        }
+        ImGui::TreePop();
+      }
+    }
+    ImGui::EndTable();
+  }
+
+  ImGui::End();
+}
+
+void EditorUI::DrawProfiler() {
+  ImGui::Begin("Profiler");
+
+  bool enabled = Profiler::IsEnabled();
+  if (ImGui::Checkbox("Enabled", &enabled)) {
+    Profiler::SetEnabled(enabled);
+  }
+  ImGui::SameLine();
+  ImGui::Checkbox("Pause", &m_ProfilerPaused);
+  ImGui::SameLine();
+  if (ImGui::Button("Reset")) {
+    Profiler::Reset();
+    m_ProfilerFrames.clear();
+    m_ProfilerSelectedFrame = -1;
+  }
+  ImGui::SameLine();
+  if (Profiler::IsCapturing()) {
+    if (ImGui::Button("Stop Capture")) {
+      Profiler::StopCapture();
+      Profiler::ExportTrace("frame_trace.json");
+    }
+  } else if (ImGui::Button("Capture Trace")) {
+    Profiler::StartCapture();
+  }
+
+#if !FORGE_PROFILE
+  ImGui::TextDisabled("Markers are compiled out (FORGE_ENABLE_PROFILER=OFF)");
+#endif
+  ProfilerStats stats = Profiler::GetStats();
+  ImGui::Text("%u threads, %llu events, %llu dropped, %u frames captured",
+              stats.Threads, (unsigned long long)stats.Events,
+              (unsigned long long)stats.DroppedEvents, stats.CapturedFrames);
+
+  if (!m_ProfilerPaused) {
+    m_ProfilerFrames = Profiler::GetHistory();
+    m_ProfilerSelectedFrame = (int)m_ProfilerFrames.size() - 1;
+  }
+  if (m_ProfilerFrames.empty()) {
+    ImGui::End();
+    return;
+  }
+  m_ProfilerSelectedFrame = std::clamp(m_ProfilerSelectedFrame, 0,
+                                       (int)m_ProfilerFrames.size() - 1);
+
+  // Frame times; clicking a bar pauses on that frame
+  std::vector<float> frameMs;
+  float maxMs = 0.0f;
+  for (const ProfileFrame &frame : m_ProfilerFrames) {
+    frameMs.push_back((frame.EndNs - frame.StartNs) / 1e6f);
+    maxMs = std::max(maxMs, frameMs.back());
+  }
+  const ProfileFrame &selected = m_ProfilerFrames[m_ProfilerSelectedFrame];
+  char overlay[64];
+  snprintf(overlay, sizeof(overlay), "frame %llu: %.3f ms",
+           (unsigned long long)selected.Index,
+           frameMs[m_ProfilerSelectedFrame]);
+  ImGui::PlotHistogram("##FrameTimes", frameMs.data(), (int)frameMs.size(), 0,
+                       overlay, 0.0f, maxMs * 1.1f,
+                       ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+  if (ImGui::IsItemClicked()) {
+    float t = (ImGui::GetMousePos().x - ImGui::GetItemRectMin().x) /
+              std::max(ImGui::GetItemRectSize().x, 1.0f);
+    m_ProfilerSelectedFrame = (int)(t * frameMs.size());
+    m_ProfilerPaused = true;
+  }
+
+  // Timeline of the selected frame: a lane per thread, a row per depth
+  const double frameNs =
+      (double)std::max<int64_t>(selected.EndNs - selected.StartNs, 1);
+  std::vector<std::string> threadNames = Profiler::GetThreadNames();
+  std::vector<uint32_t> laneDepth(threadNames.size(), 0);
+  std::vector<bool> laneUsed(threadNames.size(), false);
+  for (const ProfileEvent &e : selected.Events) {
+    if (e.Thread >= threadNames.size())
+      continue;
+    laneUsed[e.Thread] = true;
+    laneDepth[e.Thread] = std::max(laneDepth[e.Thread], e.Depth + 1);
+  }
+  const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+  std::vector<float> laneTop(threadNames.size(), 0.0f);
+  float timelineHeight = 0.0f;
+  for (size_t t = 0; t < threadNames.size(); t++) {
+    if (!laneUsed[t])
+      continue;
+    laneTop[t] = timelineHeight;
+    timelineHeight += (laneDepth[t] + 1) * rowHeight;
+  }
+
+  if (ImGui::BeginChild("Timeline",
+                        ImVec2(0.0f, std::min(timelineHeight + 4.0f, 240.0f)),
+                        true, ImGuiWindowFlags_HorizontalScrollbar)) {
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+    ImGui::InvisibleButton("##TimelineCanvas",
+                           ImVec2(width, std::max(timelineHeight, 1.0f)));
+    const bool canvasHovered = ImGui::IsItemHovered();
+    const ImVec2 mouse = ImGui::GetMousePos();
+
+    for (size_t t = 0; t < threadNames.size(); t++) {
+      if (laneUsed[t]) {
+        drawList->AddText(ImVec2(origin.x + 2.0f, origin.y + laneTop[t]),
+                          ImGui::GetColorU32(ImGuiCol_TextDisabled),
+                          threadNames[t].c_str());
+      }
+    }
+    const ProfileEvent *hovered = nullptr;
+    for (const ProfileEvent &e : selected.Events) {
+      if (e.Thread >= threadNames.size())
+        continue;
+      float x0 = origin.x +
+                 (float)((e.StartNs - selected.StartNs) / frameNs) * width;
+      float x1 =
+          origin.x + (float)((e.EndNs - selected.StartNs) / frameNs) * width;
+      x1 = std::max(x1, x0 + 1.0f);
+      float y0 = origin.y + laneTop[e.Thread] + (e.Depth + 1) * rowHeight;
+      ImVec2 min(x0, y0), max(x1, y0 + rowHeight - 1.0f);
+
+      // Stable colour per marker name
+      uint32_t hash = 2166136261u;
+      for (const char *c = e.Name; *c; c++)
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+      ImU32 color = IM_COL32(80 + hash % 120, 80 + (hash >> 8) % 120,
+                             80 + (hash >> 16) % 120, 255);
+      drawList->AddRectFilled(min, max, color);
+      if (x1 - x0 > 8.0f) {
+        drawList->PushClipRect(min, max, true);
+        drawList->AddText(ImVec2(x0 + 2.0f, y0), IM_COL32_WHITE, e.Name);
+        drawList->PopClipRect();
+      }
+      if (canvasHovered && mouse.x >= min.x && mouse.x < max.x &&
+          mouse.y >= min.y && mouse.y < max.y)
+        hovered = &e;
+    }
+    if (hovered) {
+      ImGui::SetTooltip("%s\n%.3f ms (at +%.3f ms)", hovered->Name,
+                        (hovered->EndNs - hovered->StartNs) / 1e6,
+                        (hovered->StartNs - selected.StartNs) / 1e6);
+    }
+  }
+  ImGui::EndChild();
+
+  // Totals per marker name in the selected frame
+  struct MarkerTotal {
+    uint32_t Calls = 0;
+    int64_t Ns = 0;
+  };
+  std::map<std::string, MarkerTotal> totals;
+  for (const ProfileEvent &e : selected.Events) {
+    MarkerTotal &total = totals[e.Name];
+    total.Calls++;
+    total.Ns += e.EndNs - e.StartNs;
+  }
+  if (ImGui::BeginTable("ProfilerMarkers", 3,
+                        ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV |
+                            ImGuiTableFlags_Resizable |
+                            ImGuiTableFlags_ScrollY)) {
+    ImGui::TableSetupColumn("Marker", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Inclusive (ms)");
+    ImGui::TableHeadersRow();
+    for (const auto &[name, total] : totals) {
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::TextUnformatted(name.c_str());
+      ImGui::TableSetColumnIndex(1);
+      ImGui::Text("%u", total.Calls);
+      ImGui::TableSetColumnIndex(2);
+      ImGui::Text("%.3f", total.Ns / 1e6);
+    }
+    ImGui::EndTable();
+  }
+
+  ImGui::End();
+}
+
+void EditorUI::DrawRendererStats() {
+  ImGui::Begin("Renderer Stats");
+
+  if (!m_Context) {
+    ImGui::End();
+    return;
+  }
+
+  const FrameSyncStats &frameSync = m_Context->GetFrameSyncStats();
+  ImGui::Text("Frames in flight: %u, CPU stalls %llu (last %.3f ms)",
+              m_Context->GetFramesInFlight(),
+              (unsigned long long)frameSync.CPUStalls, frameSync.LastStallMs);
+
+  const RingAllocatorStats &upload = m_Context->GetUploadRing()->GetStats();
+  ImGui::Text("Upload ring: %.1f / %.1f KB (peak %.1f KB), failed %llu",
+              upload.UsedBytes / 1024.0, upload.Capacity / 1024.0,
+              upload.PeakUsedBytes / 1024.0,
+              (unsigned long long)upload.FailedAllocations);
+
+  const UploadManagerStats &copies = m_Context->GetUploadManager()->GetStats();
+  ImGui::Text("Copy queue: %llu uploads (%.1f KB) in %llu batches, %u "
+              "pending, staging peak %.1f KB, stalls %llu",
+              (unsigned long long)copies.Uploads, copies.Bytes / 1024.0,
+              (unsigned long long)copies.Batches, copies.PendingBatches,
+              copies.Staging.PeakUsedBytes / 1024.0,
+              (unsigned long long)copies.StagingStalls);
+
+  DescriptorAllocatorStats descriptors =
+      m_Context->GetDescriptorAllocator()->GetStats();
+  ImGui::Text("Descriptors (persistent): %llu / %llu, %llu free blocks, "
+              "fragmentation %.0f%%, pending frees %u",
+              (unsigned long long)descriptors.Persistent.UsedSize,
+              (unsigned long long)descriptors.Persistent.Capacity,
+              (unsigned long long)descriptors.Persistent.FreeBlocks,
+              descriptors.Persistent.GetFragmentation() * 100.0,
+              descriptors.PendingFrees);
+  ImGui::Text("Descriptors (transient): %llu / %llu (peak %llu)",
+              (unsigned long long)descriptors.Transient.UsedBytes,
+              (unsigned long long)descriptors.Transient.Capacity,
+              (unsigned long long)descriptors.Transient.PeakUsedBytes);
+  ImGui::Text("Descriptors (staging): %llu / %llu",
+              (unsigned long long)descriptors.Staging.UsedSize,
+              (unsigned long long)descriptors.Staging.Capacity);
+
+  const DrawBatchStats &batches = m_SceneViewRenderer.GetBatchStats();
+  ImGui::Text("Meshes: %llu instances in %llu draw calls, %llu material / "
+              "%llu mesh changes",
+              (unsigned long long)batches.Items,
+              (unsigned long long)batches.DrawCalls,
+              (unsigned long long)batches.MaterialChanges,
+              (unsigned long long)batches.MeshChanges);
+
+  bool occlusion = m_SceneViewRenderer.IsOcclusionCullingEnabled();
+  if (ImGui::Checkbox("Occlusion culling", &occlusion))
+    m_SceneViewRenderer.SetOcclusionCulling(occlusion);
+  const OcclusionStats &occlusionStats =
+      m_SceneViewRenderer.GetOcclusionStats();
+  if (occlusion) {
+    ImGui::SameLine();
+    ImGui::Text("%u objects: %u frustum / %u occlusion culled, %u occluders "
+                "(%u triangles)%s",
+                occlusionStats.Objects, occlusionStats.FrustumCulled,
+                occlusionStats.OcclusionCulled, occlusionStats.Occluders,
+                occlusionStats.OccluderTriangles,
+                occlusionStats.SIMD ? ", AVX2" : "");
+  }
+
+  LODSettings lodSettings = m_SceneViewRenderer.GetLODSettings();
+  if (ImGui::SliderFloat("LOD bias", &lodSettings.Bias, -2.0f, 2.0f))
+    m_SceneViewRenderer.SetLODSettings(lodSettings);
+  const LODSelectionStats &lodStats = m_SceneViewRenderer.GetLODStats();
+  ImGui::SameLine();
+  ImGui::Text("%u LOD entities, per level %u / %u / %u / %u, %u changed",
+              lodStats.Instances, lodStats.PerLevel[0], lodStats.PerLevel[1],
+              lodStats.PerLevel[2], lodStats.PerLevel[3], lodStats.Changes);
+
+  const ClusteredLightCuller &lights = m_SceneViewRenderer.GetLightCuller();
+  const ClusterCullStats &lightStats = lights.GetStats();
+  ImGui::Text("Light clusters: %ux%ux%u, %u / %u lights visible, %u "
+              "occupied, %u indices (max %u per cluster)%s",
+              lights.GetTilesX(), lights.GetTilesY(), lights.GetDepthSlices(),
+              lightStats.VisibleLights, lightStats.Lights,
+              lightStats.OccupiedClusters, lightStats.Indices,
+              lightStats.MaxClusterLights, lightStats.SIMD ? ", AVX2" : "");
+
+  const RenderGraphStats &graph = m_Context->GetRenderGraph()->GetStats();
+  ImGui::Text("Render graph: %u passes (%u culled), %u barriers in %u "
+              "batches, transients %.1f MB in %.1f MB of heaps",
+              graph.Passes, graph.CulledPasses, graph.Barriers,
+              graph.BarrierBatches, graph.TransientBytes / (1024.0 * 1024.0),
+              graph.HeapBytes / (1024.0 * 1024.0));
+
+  const DeferredReleaseStats &releases =
+      m_Context->GetReleaseQueue()->GetStats();
+  ImGui::Text("Viewport: %dx%d, %llu resize(s), %u release(s) pending "
+              "(peak %u)",
+              m_SceneViewRenderer.GetWidth(), m_SceneViewRenderer.GetHeight(),
+              (unsigned long long)m_SceneViewRenderer.GetResizeCount(),
+              releases.Pending, releases.PeakPending);
+
+  const ParallelRecordStats &recording =
+      m_Context->GetParallelRecorder()->GetStats();
+  ImGui::Text("Command lists: %u last frame, mesh pass split %u way(s) "
+              "(%llu / %llu passes parallel)",
+              frameSync.LastCommandLists,
+              std::max(recording.LastListCount, 1u),
+              (unsigned long long)recording.ParallelPasses,
+              (unsigned long long)recording.Passes);
+
+  // Read back with the frame latency; also on the Profiler timeline
+  GPUProfiler *gpuProfiler = m_Context->GetGPUProfiler();
+  if (!gpuProfiler->IsAvailable()) {
+    ImGui::TextDisabled("GPU timings: no timestamp queries on this queue");
+  } else {
+    const GPUProfilerStats &gpu = gpuProfiler->GetStats();
+    ImGui::Text("GPU: %.3f ms, %u frame(s) pending, %llu lost, %llu scopes "
+                "dropped",
+                gpu.LastFrameMs, gpu.PendingFrames,
+                (unsigned long long)gpu.FramesLost,
+                (unsigned long long)gpu.DroppedScopes);
+    for (const GPUScopeTiming &timing : gpuProfiler->GetLastFrame()) {
+      ImGui::Text("%*s%s: %.3f ms", (int)timing.Depth * 2, "", timing.Name,
+                  timing.GetMs());
+    }
+  }
+
+  ImGui::End();
+}
+
 } // namespace Forge
@@ -1,4 +1,5 @@
 #pragma once
+#include "../Runtime/Core/Profiler.h"
 #include "../Runtime/Scene/Entity.h"
 #include "../Runtime/Scene/Scene.h"
 #include <Windows.h>
@@ -24,14 +25,12 @@ public:
 
   void SetActiveScene(std::shared_ptr<Scene> scene);
 
-  void Initialize(void *windowHandle, ID3D12Device *device, int numFrames,
-                  DXGI_FORMAT rtvFormat, ID3D12DescriptorHeap *srvHeap,
-                  D3D12_CPU_DESCRIPTOR_HANDLE fontSrvCpu,
-                  D3D12_GPU_DESCRIPTOR_HANDLE fontSrvGpu);
+  void Initialize(void *windowHandle, DX12Context *context,
+                  DXGI_FORMAT rtvFormat);
   void Shutdown();
 
   void NewFrame();
-  void Draw(ID3D12GraphicsCommandList *commandList);
+  void Draw(RHICommandList *commandList);
   void Render(ID3D12GraphicsCommandList *commandList);
 
 private:
@@ -40,6 +39,9 @@ private:
   void DrawInspector();
   void DrawContentBrowser();
   void DrawViewport();
+  void DrawScriptProfiler();
+  void DrawProfiler();
+  void DrawRendererStats();
 
   void DrawEntityNode(Entity *entity);
 
@@ -49,8 +51,14 @@ private:
   Entity *m_RenamingEntity = nullptr;
   EditorCamera m_EditorCamera;
 
+  // Profiler panel: the history snapshot shown (kept while paused)
+  std::vector<ProfileFrame> m_ProfilerFrames;
+  int m_ProfilerSelectedFrame = -1;
+  bool m_ProfilerPaused = false;
+
   // Isolated Scene View Renderer
   SceneViewRenderer m_SceneViewRenderer;
+  DX12Context *m_Context = nullptr;
 };
 
 } // namespace Forge
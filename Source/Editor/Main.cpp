@@ -1,7 +1,11 @@
+#include "../Runtime/Core/Profiler.h"
 #include "../Runtime/Core/Window.h"
 #include "../Runtime/Renderer/DX12Context.h"
+#include "../Runtime/Scripting/ScriptEngine.h"
 #include "EditorUI.h"
 #include <Windows.h>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 
@@ -45,18 +49,26 @@ int RunGameLoop() {
   }
   std::cout << "[Main] DX12 Context Initialized." << std::endl;
 
-  // 3. Initialize Editor UI
+  // 3. Initialize Scripting (Mono runtime, script workers, GC pacer)
+  Forge::ScriptEngine::Init();
+#ifdef FORGE_SCRIPT_ASSEMBLY_PATH
+  if (std::filesystem::exists(FORGE_SCRIPT_ASSEMBLY_PATH))
+    Forge::ScriptEngine::LoadAssembly(FORGE_SCRIPT_ASSEMBLY_PATH);
+#endif
+
+  // 4. Initialize Editor UI
   std::unique_ptr<Forge::EditorUI> editor = std::make_unique<Forge::EditorUI>();
-  editor->Initialize(window->GetHandle(), renderer->GetDevice(), 2,
-                     DXGI_FORMAT_R8G8B8A8_UNORM, renderer->GetSRVHeap(),
-                     renderer->GetSRVDescriptorHandleStartCPU(),
-                     renderer->GetSRVDescriptorHandleStartGPU());
+  editor->Initialize(window->GetHandle(), renderer.get(),
+                     DXGI_FORMAT_R8G8B8A8_UNORM);
 
   // --- Step 1 Init: Create Scene and Entities ---
   auto scene = std::make_shared<Forge::Scene>();
 
   auto *cam = scene->CreateEntity("Main Camera");
   auto *light = scene->CreateEntity("Directional Light");
+  Forge::LightComponent sun;
+  sun.Type = Forge::LightType::Directional;
+  light->AddLight(sun);
   auto *player = scene->CreateEntity("Player");
   auto *model = scene->CreateEntity("Character Model");
   model->SetParent(player);
@@ -66,12 +78,13 @@ int RunGameLoop() {
 
   std::cout << "[Main] Editor UI Initialized." << std::endl;
 
-  // 4. Main Loop
+  // 5. Main Loop
   std::cout << "[Main] Entering Game Loop..." << std::endl;
 
   // Force a flush
   std::cout << std::flush;
 
+  Forge::Profiler::SetThreadName("Main");
   MSG msg = {};
   while (msg.message != WM_QUIT) {
     // Process Window Messages
@@ -80,19 +93,30 @@ int RunGameLoop() {
       DispatchMessage(&msg);
     } else {
       // Idle Loop (Game Logic)
+      FORGE_PROFILE_FRAME();
+      FORGE_PROFILE_SCOPE("Frame");
+      auto frameStart = std::chrono::steady_clock::now();
       renderer->BeginFrame();
 
       // UI
       editor->NewFrame();
       editor->Draw(renderer->GetCommandList());
-      editor->Render(renderer->GetCommandList());
+      editor->Render(renderer->GetNativeCommandList());
 
+      // Paced GC in the slack left before EndFrame presents
+      Forge::ScriptEngine::OnFrameEnd(
+          std::chrono::duration<float, std::milli>(
+              std::chrono::steady_clock::now() - frameStart)
+              .count());
       renderer->EndFrame();
     }
   }
 
   std::cout << "[Main] Loop Exited. Shutting down..." << std::endl;
+  // Frames may still be in flight; editor resources must outlive them
+  renderer->WaitIdle();
   editor->Shutdown();
+  Forge::ScriptEngine::Shutdown();
   renderer->CleanUp();
   window->Shutdown();
 
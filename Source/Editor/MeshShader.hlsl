@@ -0,0 +1,38 @@
+// Instanced mesh: per-instance world matrix rows come from vertex slot 1
+struct VS_INPUT {
+    float3 pos : POSITION;
+    float3 normal : NORMAL;
+    float4 world0 : WORLD0;
+    float4 world1 : WORLD1;
+    float4 world2 : WORLD2;
+    float4 world3 : WORLD3;
+};
+
+struct PS_INPUT {
+    float4 pos : SV_POSITION;
+    float3 normal : NORMAL;
+};
+
+cbuffer SceneBuffer : register(b0) {
+    matrix viewProj;
+};
+
+cbuffer MaterialBuffer : register(b1) {
+    float4 baseColor;
+};
+
+PS_INPUT VSMain(VS_INPUT input) {
+    float4x4 world = float4x4(input.world0, input.world1, input.world2, input.world3);
+    float4 worldPos = mul(float4(input.pos, 1.0f), world);
+
+    PS_INPUT output;
+    output.pos = mul(worldPos, viewProj);
+    output.normal = mul(input.normal, (float3x3)world);
+    return output;
+}
+
+float4 PSMain(PS_INPUT input) : SV_TARGET {
+    float3 lightDir = normalize(float3(0.4f, 1.0f, 0.3f));
+    float ndotl = saturate(dot(normalize(input.normal), lightDir));
+    return float4(baseColor.rgb * (0.25f + 0.75f * ndotl), baseColor.a);
+}
@@ -1,298 +1,322 @@
 #include "SceneViewRenderer.h"
+#include "../Runtime/Core/JobSystem.h"
+#include "../Runtime/Core/Profiler.h"
+#include "../Runtime/Scene/Scene.h"
 #include "EditorCamera.h"
 #include <DirectXMath.h>
-#include <d3dcompiler.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <string>
 #include <vector>
 
+namespace Forge {
 
-#pragma comment(lib, "d3dcompiler.lib")
+// MeshComponent::MaterialID -> base color (until real materials exist)
+static const float MaterialPalette[][4] = {
+    {0.80f, 0.80f, 0.80f, 1.0f}, {0.85f, 0.30f, 0.25f, 1.0f},
+    {0.30f, 0.70f, 0.35f, 1.0f}, {0.25f, 0.45f, 0.85f, 1.0f},
+    {0.90f, 0.75f, 0.25f, 1.0f}, {0.65f, 0.35f, 0.80f, 1.0f},
+};
+static constexpr uint32_t MaterialPaletteSize =
+    sizeof(MaterialPalette) / sizeof(MaterialPalette[0]);
 
-namespace Forge {
+// A new viewport size must hold this many frames before the targets are
+// recreated (~65 ms at 60 Hz)
+static constexpr int ResizeSettleFrames = 4;
+
+// Built-in sphere LOD chain: segments around (rings = segments / 2)
+static const uint32_t SphereLODSegments[] = {48, 24, 12, 6};
+static constexpr float SphereRadius = 0.5f;
 
 SceneViewRenderer::SceneViewRenderer() = default;
 SceneViewRenderer::~SceneViewRenderer() { Shutdown(); }
 
-void SceneViewRenderer::Initialize(ID3D12Device *device,
-                                   ID3D12DescriptorHeap *srvHeap) {
+void SceneViewRenderer::Initialize(RHIDevice *device,
+                                   DescriptorAllocator *descriptors,
+                                   UploadRing *uploadRing,
+                                   UploadManager *uploads,
+                                   ShaderHotReload *shaders,
+                                   ParallelCommandRecorder *recorder,
+                                   RenderGraph *graph,
+                                   DeferredReleaseQueue *releaseQueue) {
   m_Device = device;
-  m_SrvHeap = srvHeap;
-
-  // RTV Heap 생성 (1개)
-  D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
-  rtvHeapDesc.NumDescriptors = 1;
-  rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-  rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-  m_Device->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&m_RtvHeap));
-  m_RtvHandle = m_RtvHeap->GetCPUDescriptorHandleForHeapStart();
-
-  // DSV Heap 생성 (1개)
-  D3D12_DESCRIPTOR_HEAP_DESC dsvHeapDesc = {};
-  dsvHeapDesc.NumDescriptors = 1;
-  dsvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
-  dsvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-  m_Device->CreateDescriptorHeap(&dsvHeapDesc, IID_PPV_ARGS(&m_DsvHeap));
-  m_DsvHandle = m_DsvHeap->GetCPUDescriptorHandleForHeapStart();
+  m_Descriptors = descriptors;
+  m_UploadRing = uploadRing;
+  m_Uploads = uploads;
+  m_Shaders = shaders;
+  m_Recorder = recorder;
+  m_Graph = graph;
+  m_ReleaseQueue = releaseQueue;
 
   std::cout << "[SceneViewRenderer] Initialized." << std::endl;
 
   // Create Grid resources
   CreateGridPSO();
   CreateGridGeometry();
+  CreateMeshPSO();
+  CreateMeshGeometry();
 }
 
 void SceneViewRenderer::Shutdown() {
   ReleaseResources();
-  m_RtvHeap.Reset();
-  m_DsvHeap.Reset();
+  m_GridPSO = nullptr;
+  m_GridVB.reset();
+  m_MeshPSO = nullptr;
+  m_Meshes.clear();
 }
 
 void SceneViewRenderer::Resize(int width, int height) {
   if (width <= 0 || height <= 0)
     return;
 
-  // Only create once - resize disabled for stability
-  // (GPU sync required for safe resize, too complex for PHASE 1)
-  if (m_ColorRT != nullptr)
+  // First size: create right away so the viewport has something to show
+  if (m_ColorRT == nullptr) {
+    m_Width = width;
+    m_Height = height;
+    CreateResources();
+    return;
+  }
+
+  if (width == m_Width && height == m_Height) {
+    m_PendingWidth = m_PendingHeight = m_PendingFrames = 0;
     return;
+  }
+  if (width != m_PendingWidth || height != m_PendingHeight) {
+    m_PendingWidth = width;
+    m_PendingHeight = height;
+    m_PendingFrames = 0;
+    return;
+  }
+  m_PendingFrames++;
+}
 
-  m_Width = width;
-  m_Height = height;
+void SceneViewRenderer::ApplyPendingResize() {
+  if (m_PendingWidth <= 0 || m_PendingFrames < ResizeSettleFrames)
+    return;
 
+  // No GPU wait: frames still in flight keep sampling the old target and
+  // SRV slot, both released once those frames complete
+  ReleaseResources();
+  m_Width = m_PendingWidth;
+  m_Height = m_PendingHeight;
+  m_PendingWidth = m_PendingHeight = m_PendingFrames = 0;
   CreateResources();
+  m_ResizeCount++;
 }
 
 void SceneViewRenderer::CreateResources() {
   if (!m_Device || m_Width <= 0 || m_Height <= 0)
     return;
 
-  D3D12_HEAP_PROPERTIES heapProps = {};
-  heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
-
   // 1. Color Render Target
-  D3D12_RESOURCE_DESC rtDesc = {};
-  rtDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-  rtDesc.Width = m_Width;
-  rtDesc.Height = m_Height;
-  rtDesc.DepthOrArraySize = 1;
-  rtDesc.MipLevels = 1;
-  rtDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-  rtDesc.SampleDesc.Count = 1;
-  rtDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-
-  D3D12_CLEAR_VALUE clearValue = {};
-  clearValue.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+  RHIClearValue clearValue;
+  clearValue.Format = RHIFormat::RGBA8_UNorm;
   clearValue.Color[0] = 0.1f;
   clearValue.Color[1] = 0.1f;
   clearValue.Color[2] = 0.1f;
   clearValue.Color[3] = 1.0f;
 
-  HRESULT hr = m_Device->CreateCommittedResource(
-      &heapProps, D3D12_HEAP_FLAG_NONE, &rtDesc,
-      D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, &clearValue,
-      IID_PPV_ARGS(&m_ColorRT));
-  if (FAILED(hr)) {
+  RHIResourceDesc rtDesc = RHIResourceDesc::Texture2D(
+      m_Width, m_Height, RHIFormat::RGBA8_UNorm, RHIResourceFlag_RenderTarget,
+      RHIResourceState::PixelShaderResource, "SceneView Color");
+  rtDesc.ClearValue = &clearValue;
+  m_ColorRT = m_Device->CreateResource(rtDesc);
+  if (!m_ColorRT) {
     std::cerr << "[SceneViewRenderer] Failed to create ColorRT" << std::endl;
     return;
   }
 
-  // 2. Depth Render Target
-  rtDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-  rtDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
-  clearValue.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-  clearValue.DepthStencil.Depth = 1.0f;
-  clearValue.DepthStencil.Stencil = 0;
-
-  hr = m_Device->CreateCommittedResource(
-      &heapProps, D3D12_HEAP_FLAG_NONE, &rtDesc,
-      D3D12_RESOURCE_STATE_DEPTH_WRITE, &clearValue, IID_PPV_ARGS(&m_DepthRT));
-  if (FAILED(hr)) {
-    std::cerr << "[SceneViewRenderer] Failed to create DepthRT" << std::endl;
-    return;
-  }
-
-  // 3. Create RTV
-  m_Device->CreateRenderTargetView(m_ColorRT.Get(), nullptr, m_RtvHandle);
-
-  // 4. Create DSV
-  m_Device->CreateDepthStencilView(m_DepthRT.Get(), nullptr, m_DsvHandle);
-
-  // 5. Create SRV for ImGui (고정 슬롯 SRV_SLOT)
-  UINT handleSize = m_Device->GetDescriptorHandleIncrementSize(
-      D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+  // Occlusion buffer: 256 pixels wide, viewport aspect
+  m_OcclusionCuller.SetResolution(256, (uint32_t)std::max(
+                                           256 * m_Height / m_Width, 4));
 
-  D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle =
-      m_SrvHeap->GetCPUDescriptorHandleForHeapStart();
-  cpuHandle.ptr += handleSize * SRV_SLOT;
-
-  m_Device->CreateShaderResourceView(m_ColorRT.Get(), nullptr, cpuHandle);
-
-  m_SrvHandle = m_SrvHeap->GetGPUDescriptorHandleForHeapStart();
-  m_SrvHandle.ptr += handleSize * SRV_SLOT;
+  // 2. Create SRV for ImGui (RTV / depth come from the render graph)
+  if (!m_Srv.IsValid())
+    m_Srv = m_Descriptors->AllocatePersistent();
+  m_Device->CreateShaderResourceView(m_ColorRT.get(), m_Srv.CPU);
 
   std::cout << "[SceneViewRenderer] Resources created: " << m_Width << "x"
             << m_Height << std::endl;
 }
 
 void SceneViewRenderer::ReleaseResources() {
-  m_ColorRT.Reset();
-  m_DepthRT.Reset();
+  // Slot is recycled once the GPU is past the current frame
+  if (m_Descriptors)
+    m_Descriptors->FreePersistent(m_Srv);
+  if (m_ReleaseQueue)
+    m_ReleaseQueue->Retire(std::move(m_ColorRT));
+  m_ColorRT.reset();
 }
 
-void SceneViewRenderer::Render(ID3D12GraphicsCommandList *commandList,
-                               const EditorCamera *camera) {
-  if (!m_ColorRT || !m_DepthRT)
-    return;
-
-  // Transition to Render Target
-  D3D12_RESOURCE_BARRIER barrier = {};
-  barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-  barrier.Transition.pResource = m_ColorRT.Get();
-  barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-  barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-  barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-  commandList->ResourceBarrier(1, &barrier);
-
-  // Set Render Target
-  commandList->OMSetRenderTargets(1, &m_RtvHandle, FALSE, &m_DsvHandle);
-
-  // Clear
-  float clearColor[] = {0.1f, 0.1f, 0.1f, 1.0f};
-  commandList->ClearRenderTargetView(m_RtvHandle, clearColor, 0, nullptr);
-  commandList->ClearDepthStencilView(m_DsvHandle, D3D12_CLEAR_FLAG_DEPTH, 1.0f,
-                                     0, 0, nullptr);
-
-  // [PHASE 4] Render Grid
+RHICommandList *SceneViewRenderer::Render(RHICommandList *commandList,
+                                          const EditorCamera *camera,
+                                          const Scene *scene) {
+  FORGE_PROFILE_SCOPE("SceneViewRenderer::Render");
+  // Before recording, so the SRV ImGui shows this frame is the new target
+  ApplyPendingResize();
+  if (!m_ColorRT)
+    return commandList;
+
+  // Per-frame constants come from the upload ring (root CBV b0)
+  UploadAllocation sceneConstants;
   if (camera && m_Width > 0 && m_Height > 0) {
-    D3D12_VIEWPORT viewport = {0.0f, 0.0f, (float)m_Width, (float)m_Height,
-                               0.0f, 1.0f};
-    D3D12_RECT scissor = {0, 0, m_Width, m_Height};
-    commandList->RSSetViewports(1, &viewport);
-    commandList->RSSetScissorRects(1, &scissor);
-
-    if (m_GridPSO && m_GridRootSig && m_GridVB && m_GridVertexCount > 0) {
-      commandList->SetPipelineState(m_GridPSO.Get());
-      commandList->SetGraphicsRootSignature(m_GridRootSig.Get());
-
-      float aspect = (float)m_Width / (float)m_Height;
-      DirectX::XMMATRIX viewProj =
-          camera->GetViewMatrix() * camera->GetProjectionMatrix(aspect);
-      commandList->SetGraphicsRoot32BitConstants(0, 16, &viewProj, 0);
-
-      commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
-      commandList->IASetVertexBuffers(0, 1, &m_GridVBV);
-      commandList->DrawInstanced(m_GridVertexCount, 1, 0, 0);
-    }
+    float aspect = (float)m_Width / (float)m_Height;
+    DirectX::XMMATRIX viewProj =
+        camera->GetViewMatrix() * camera->GetProjectionMatrix(aspect);
+    sceneConstants = m_UploadRing->Upload(viewProj);
+    DirectX::XMFLOAT4X4 cullViewProj;
+    DirectX::XMStoreFloat4x4(&cullViewProj, viewProj);
+    std::copy(&cullViewProj.m[0][0], &cullViewProj.m[0][0] + 16, m_ViewProj);
+
+    DirectX::XMFLOAT3 position = camera->GetPosition();
+    const float eye[3] = {position.x, position.y, position.z};
+    m_LODSelector.SetView(eye, DirectX::XMConvertToRadians(camera->GetFOV()),
+                          (float)m_Height);
+    if (scene)
+      CullLights(camera, scene);
   }
 
-  // Transition back to Shader Resource
-  barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-  barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-  commandList->ResourceBarrier(1, &barrier);
-}
+  // Color is sampled by ImGui afterwards; depth only lives inside the graph
+  m_Graph->Reset();
+  RGResourceHandle color = m_Graph->Import(
+      "SceneView Color", m_ColorRT.get(), RHIResourceState::PixelShaderResource,
+      RHIResourceState::PixelShaderResource);
+  RGResourceHandle depth =
+      m_Graph->CreateTexture("SceneView Depth", m_Width, m_Height,
+                             RHIFormat::D24_UNorm_S8_UInt,
+                             RHIResourceFlag_DepthStencil);
+
+  // [PHASE 4] Clear + Grid
+  m_Graph->AddPass(
+      "Grid",
+      [&](RGPassBuilder &builder) {
+        builder.Write(color, RHIResourceState::RenderTarget);
+        builder.Write(depth, RHIResourceState::DepthWrite);
+      },
+      [&](RGContext &context) {
+        RHICommandList *list = context.CommandList;
+        RHICPUDescriptor rtv = context.GetRTV(color);
+        RHICPUDescriptor dsv = context.GetDSV(depth);
+        list->SetRenderTargets(&rtv, 1, &dsv);
+
+        float clearColor[] = {0.1f, 0.1f, 0.1f, 1.0f};
+        list->ClearRenderTarget(rtv, clearColor);
+        list->ClearDepthStencil(dsv, 1.0f, 0);
+
+        if (!sceneConstants.IsValid() || !m_GridPSO ||
+            !m_Uploads->IsComplete(m_GridUpload) || m_GridVertexCount == 0)
+          return;
+        list->SetViewport(
+            {0.0f, 0.0f, (float)m_Width, (float)m_Height, 0.0f, 1.0f});
+        list->SetScissor({0, 0, m_Width, m_Height});
+        list->SetPipelineState(m_GridPSO->Get());
+        list->SetGraphicsConstantBuffer(0, sceneConstants.GPUAddress);
+        list->SetPrimitiveTopology(RHIPrimitiveTopology::LineList);
+        list->SetVertexBuffer(0, m_GridVB.get(), 0,
+                              (uint32_t)m_GridVB->GetDesc().Width,
+                              m_GridVertexStride);
+        list->Draw(m_GridVertexCount, 1, 0, 0);
+      });
+
+  if (sceneConstants.IsValid() && scene && m_MeshPSO) {
+    m_Graph->AddPass(
+        "Meshes",
+        [&](RGPassBuilder &builder) {
+          builder.Write(color, RHIResourceState::RenderTarget);
+          builder.Write(depth, RHIResourceState::DepthWrite);
+        },
+        [&](RGContext &context) {
+          context.CommandList = RenderMeshes(
+              context.CommandList, scene, sceneConstants.GPUAddress,
+              context.GetRTV(color), context.GetDSV(depth));
+        });
+  }
 
-void SceneViewRenderer::CreateGridPSO() {
-  if (!m_Device)
-    return;
+  if (!m_Graph->Compile())
+    return commandList;
+  // The passes time themselves; this scope is the whole scene view
+  GPUProfiler *gpuProfiler = m_Graph->GetGPUProfiler();
+  uint32_t gpuScope = gpuProfiler
+                          ? gpuProfiler->BeginScope(commandList, "SceneView")
+                          : GPUProfiler::InvalidScope;
+  commandList = m_Graph->Execute(commandList);
+  if (gpuProfiler)
+    gpuProfiler->EndScope(commandList, gpuScope);
+  return commandList;
+}
 
-  // 1. Root Signature
-  D3D12_ROOT_PARAMETER rootParameters[1] = {};
-  rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
-  rootParameters[0].Constants.ShaderRegister = 0;
-  rootParameters[0].Constants.Num32BitValues = 16;
-  rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
-
-  D3D12_ROOT_SIGNATURE_DESC rootSigDesc = {
-      1, rootParameters, 0, nullptr,
-      D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT};
-
-  Microsoft::WRL::ComPtr<ID3DBlob> signature;
-  Microsoft::WRL::ComPtr<ID3DBlob> error;
-  HRESULT hr = D3D12SerializeRootSignature(
-      &rootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
-  if (FAILED(hr)) {
-    std::cerr << "[SceneViewRenderer] Failed to serialize root signature"
-              << std::endl;
-    return;
+RasterImage SceneViewRenderer::RenderSoftware(const EditorCamera *camera,
+                                              const Scene *scene, int width,
+                                              int height) {
+  if (!camera || width <= 0 || height <= 0)
+    return {};
+
+  DirectX::XMFLOAT4X4 viewProj;
+  DirectX::XMStoreFloat4x4(&viewProj,
+                           camera->GetViewMatrix() *
+                               camera->GetProjectionMatrix((float)width /
+                                                           (float)height));
+  const float clearColor[4] = {0.1f, 0.1f, 0.1f, 1.0f};
+  m_SoftwareRasterizer.Begin((uint32_t)width, (uint32_t)height,
+                             &viewProj.m[0][0], clearColor);
+
+  const float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+  const float gridColor[4] = {0.3f, 0.3f, 0.3f, 1.0f};
+  if (!m_GridPositions.empty()) {
+    m_SoftwareRasterizer.DrawLines(
+        m_GridPositions.data(), (uint32_t)m_GridPositions.size() / 3,
+        3 * sizeof(float), identity, gridColor);
   }
 
-  hr = m_Device->CreateRootSignature(0, signature->GetBufferPointer(),
-                                     signature->GetBufferSize(),
-                                     IID_PPV_ARGS(&m_GridRootSig));
-  if (FAILED(hr)) {
-    std::cerr << "[SceneViewRenderer] Failed to create root signature"
-              << std::endl;
-    return;
+  if (scene) {
+    for (const auto &entity : scene->GetEntities()) {
+      const MeshComponent *mesh = entity->GetMesh();
+      if (!mesh || mesh->MeshID >= m_Meshes.size())
+        continue;
+      // Levels picked by the last GPU frame
+      const MeshBuffers &buffers = m_Meshes[GetDrawMeshID(*entity)];
+      if (buffers.Positions.empty())
+        continue;
+      DirectX::XMFLOAT4X4 world;
+      DirectX::XMStoreFloat4x4(&world, entity->GetWorldTransform());
+      m_SoftwareRasterizer.DrawTriangles(
+          buffers.Positions.data(), (uint32_t)buffers.Positions.size() / 3,
+          3 * sizeof(float), &world.m[0][0],
+          MaterialPalette[mesh->MaterialID % MaterialPaletteSize]);
+    }
   }
 
-  // 2. Compile Shaders
-  Microsoft::WRL::ComPtr<ID3DBlob> vs;
-  Microsoft::WRL::ComPtr<ID3DBlob> ps;
-
-  hr = D3DCompileFromFile(L"Source/Editor/GridShader.hlsl", nullptr, nullptr,
-                          "VSMain", "vs_5_0", 0, 0, &vs, &error);
-  if (FAILED(hr)) {
-    std::cerr << "[SceneViewRenderer] Failed to compile VS" << std::endl;
-    return;
-  }
+  m_SoftwareRasterizer.Render(&JobSystem::Get());
+  return m_SoftwareRasterizer.GetColorImage();
+}
 
-  hr = D3DCompileFromFile(L"Source/Editor/GridShader.hlsl", nullptr, nullptr,
-                          "PSMain", "ps_5_0", 0, 0, &ps, &error);
-  if (FAILED(hr)) {
-    std::cerr << "[SceneViewRenderer] Failed to compile PS" << std::endl;
+void SceneViewRenderer::CreateGridPSO() {
+  if (!m_Device)
     return;
-  }
 
-  // 3. Input Layout
-  D3D12_INPUT_ELEMENT_DESC inputElementDescs[] = {
-      {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0,
-       D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-      {"COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12,
-       D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0}};
-
-  // 4. PSO
-  D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
-  psoDesc.InputLayout = {inputElementDescs, _countof(inputElementDescs)};
-  psoDesc.pRootSignature = m_GridRootSig.Get();
-  psoDesc.VS = {vs->GetBufferPointer(), vs->GetBufferSize()};
-  psoDesc.PS = {ps->GetBufferPointer(), ps->GetBufferSize()};
-
-  psoDesc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
-  psoDesc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
-  psoDesc.RasterizerState.DepthClipEnable = TRUE;
-
-  psoDesc.BlendState.AlphaToCoverageEnable = FALSE;
-  psoDesc.BlendState.IndependentBlendEnable = FALSE;
-  const D3D12_RENDER_TARGET_BLEND_DESC defaultRtbDesc = {
-      FALSE,
-      FALSE,
-      D3D12_BLEND_ONE,
-      D3D12_BLEND_ZERO,
-      D3D12_BLEND_OP_ADD,
-      D3D12_BLEND_ONE,
-      D3D12_BLEND_ZERO,
-      D3D12_BLEND_OP_ADD,
-      D3D12_LOGIC_OP_NOOP,
-      D3D12_COLOR_WRITE_ENABLE_ALL,
-  };
-  for (UINT i = 0; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i)
-    psoDesc.BlendState.RenderTarget[i] = defaultRtbDesc;
-
-  psoDesc.DepthStencilState.DepthEnable = TRUE;
-  psoDesc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
-  psoDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
-  psoDesc.DepthStencilState.StencilEnable = FALSE;
-
-  psoDesc.SampleMask = UINT_MAX;
-  psoDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE;
-  psoDesc.NumRenderTargets = 1;
-  psoDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
-  psoDesc.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
-  psoDesc.SampleDesc.Count = 1;
-
-  hr =
-      m_Device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&m_GridPSO));
-  if (FAILED(hr)) {
+  // Pipeline (root signature: b0 = SceneBuffer CBV). Shaders come from the
+  // shader cache (no compile on warm start) and are rebuilt in the
+  // background whenever GridShader.hlsl changes.
+  RHIGraphicsPipelineDesc desc;
+  RHIRootParameter sceneBuffer;
+  sceneBuffer.ParameterType = RHIRootParameter::Type::ConstantBuffer;
+  sceneBuffer.ShaderRegister = 0;
+  sceneBuffer.Visibility = RHIShaderVisibility::Vertex;
+  desc.RootParameters.push_back(sceneBuffer);
+
+  desc.InputLayout = {{"POSITION", 0, RHIFormat::RGB32_Float, 0, 0},
+                      {"COLOR", 0, RHIFormat::RGBA32_Float, 0, 12}};
+  desc.Topology = RHIPrimitiveTopology::LineList;
+  desc.RTVFormat = RHIFormat::RGBA8_UNorm;
+  desc.DSVFormat = RHIFormat::D24_UNorm_S8_UInt;
+  desc.DepthEnable = true;
+  desc.DebugName = "Grid";
+
+  m_GridPSO = m_Shaders->CreatePipeline(
+      desc, {"Source/Editor/GridShader.hlsl", "VSMain", "vs_5_0"},
+      {"Source/Editor/GridShader.hlsl", "PSMain", "ps_5_0"});
+  if (!m_GridPSO) {
     std::cerr << "[SceneViewRenderer] Failed to create Grid PSO" << std::endl;
     return;
   }
@@ -319,34 +343,362 @@ void SceneViewRenderer::CreateGridGeometry() {
     vertices.push_back({{(float)size, 0, (float)i}, color});
   }
 
-  m_GridVertexCount = (UINT)vertices.size();
+  m_GridVertexCount = (uint32_t)vertices.size();
+  m_GridPositions.clear();
+  for (const Vertex &vertex : vertices) {
+    m_GridPositions.insert(m_GridPositions.end(),
+                           {vertex.pos.x, vertex.pos.y, vertex.pos.z});
+  }
+  m_GridVertexStride = sizeof(Vertex);
   size_t bufferSize = vertices.size() * sizeof(Vertex);
 
-  D3D12_HEAP_PROPERTIES heapProps = {D3D12_HEAP_TYPE_UPLOAD};
-  D3D12_RESOURCE_DESC bufferDesc = {};
-  bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-  bufferDesc.Width = bufferSize;
-  bufferDesc.Height = 1;
-  bufferDesc.DepthOrArraySize = 1;
-  bufferDesc.MipLevels = 1;
-  bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
-  bufferDesc.SampleDesc.Count = 1;
-  bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-
-  m_Device->CreateCommittedResource(
-      &heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc,
-      D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&m_GridVB));
-
-  void *pData;
-  m_GridVB->Map(0, nullptr, &pData);
-  memcpy(pData, vertices.data(), bufferSize);
-  m_GridVB->Unmap(0, nullptr);
-
-  m_GridVBV.BufferLocation = m_GridVB->GetGPUVirtualAddress();
-  m_GridVBV.StrideInBytes = sizeof(Vertex);
-  m_GridVBV.SizeInBytes = (UINT)bufferSize;
+  m_GridVB = m_Device->CreateResource(RHIResourceDesc::Buffer(
+      bufferSize, RHIHeapType::Default, RHIResourceState::Common, "Grid VB"));
+  if (!m_GridVB)
+    return;
+
+  m_GridUpload = m_Uploads->UploadBuffer(
+      m_GridVB.get(), 0, vertices.data(), bufferSize,
+      RHIResourceState::VertexAndConstantBuffer);
 
   std::cout << "[SceneViewRenderer] Grid Geometry Created." << std::endl;
 }
 
+RHICommandList *SceneViewRenderer::RenderMeshes(RHICommandList *commandList,
+                                                const Scene *scene,
+                                                uint64_t sceneConstants,
+                                                RHICPUDescriptor rtv,
+                                                RHICPUDescriptor dsv) {
+  // 1. Occlusion culling (unit-cube bounds, the mesh's coarsest LOD level
+  // as occluder: it lies inside every finer level)
+  m_CullObjects.clear();
+  m_CullEntities.clear();
+  for (const auto &entity : scene->GetEntities()) {
+    const MeshComponent *mesh = entity->GetMesh();
+    if (!mesh || mesh->MeshID >= m_Meshes.size() ||
+        !m_Uploads->IsComplete(m_Meshes[mesh->MeshID].Upload))
+      continue;
+    uint32_t levelCount = m_LODSelector.GetLevelCount(mesh->MeshID);
+    const MeshBuffers &buffers =
+        m_Meshes[levelCount > 0
+                     ? m_LODSelector.GetLevelMesh(mesh->MeshID, levelCount - 1)
+                     : mesh->MeshID];
+    OcclusionObject object;
+    DirectX::XMFLOAT4X4 world;
+    DirectX::XMStoreFloat4x4(&world, entity->GetWorldTransform());
+    std::copy(&world.m[0][0], &world.m[0][0] + 16, object.World);
+    for (int c = 0; c < 3; c++) {
+      object.BoundsMin[c] = -0.5f;
+      object.BoundsMax[c] = 0.5f;
+    }
+    object.OccluderPositions = buffers.Positions.data();
+    object.OccluderVertexCount = (uint32_t)buffers.Positions.size() / 3;
+    object.OccluderStride = 3 * sizeof(float);
+    m_CullObjects.push_back(object);
+    m_CullEntities.push_back(entity.get());
+  }
+  if (m_OcclusionCulling) {
+    m_OcclusionCuller.Cull(m_ViewProj, m_CullObjects.data(),
+                           (uint32_t)m_CullObjects.size(), m_CullVisible,
+                           &JobSystem::Get());
+  } else {
+    m_CullVisible.assign(m_CullObjects.size(), 1);
+  }
+
+  // 2. LOD selection for the visible entities that have a chain (bounding
+  // sphere of the unit-cube bounds, largest axis scale)
+  m_LODInstances.clear();
+  m_LODEntities.clear();
+  m_LODLevels.clear();
+  for (uint32_t i = 0; i < (uint32_t)m_CullObjects.size(); i++) {
+    const Entity &entity = *m_CullEntities[i];
+    const LODComponent *lod = entity.GetLOD();
+    uint32_t meshID = entity.GetMesh()->MeshID;
+    if (!m_CullVisible[i] || !lod || !m_LODSelector.HasChain(meshID))
+      continue;
+    const float *world = m_CullObjects[i].World;
+    LODInstance instance;
+    float scale = 0.0f;
+    for (int row = 0; row < 3; row++) {
+      const float *axis = world + row * 4;
+      scale = std::max(scale, std::sqrt(axis[0] * axis[0] +
+                                        axis[1] * axis[1] + axis[2] * axis[2]));
+    }
+    std::copy(world + 12, world + 15, instance.Center);
+    instance.Scale = std::max(scale, 1e-6f);
+    instance.Radius = 0.87f * instance.Scale;
+    instance.Chain = meshID;
+    instance.Bias = lod->Bias;
+    instance.ForcedLevel = lod->ForcedLOD;
+    m_LODInstances.push_back(instance);
+    m_LODEntities.push_back(i);
+    m_LODLevels.push_back(lod->CurrentLOD);
+  }
+  m_LODSelector.Select(m_LODInstances.data(),
+                       (uint32_t)m_LODInstances.size(), m_LODLevels.data(),
+                       &JobSystem::Get());
+  for (size_t i = 0; i < m_LODEntities.size(); i++)
+    m_CullEntities[m_LODEntities[i]]->GetLOD()->CurrentLOD = m_LODLevels[i];
+
+  // 3. Collect + sort by (material, mesh)
+  m_Batcher.Reset();
+  for (size_t i = 0; i < m_CullObjects.size(); i++) {
+    if (!m_CullVisible[i])
+      continue;
+    const Entity &entity = *m_CullEntities[i];
+    uint32_t meshID = GetDrawMeshID(entity);
+    if (!m_Uploads->IsComplete(m_Meshes[meshID].Upload))
+      meshID = entity.GetMesh()->MeshID; // level still uploading
+    m_Batcher.Submit(entity.GetMesh()->MaterialID, meshID,
+                     m_CullObjects[i].World);
+  }
+  m_Batcher.Build();
+
+  uint32_t instanceCount = m_Batcher.GetInstanceCount();
+  if (instanceCount == 0)
+    return commandList;
+
+  // 4. World matrices in batch order -> instance buffer (vertex slot 1)
+  UploadAllocation instances = m_UploadRing->Allocate(
+      instanceCount * sizeof(InstanceTransform), 16);
+  if (!instances.IsValid())
+    return commandList;
+  m_Batcher.PackInstances((InstanceTransform *)instances.CPU);
+
+  // 5. One DrawInstanced per batch. Large passes are split across command
+  // lists recorded in parallel; each list binds the full pass state.
+  const std::vector<DrawBatch> &batches = m_Batcher.GetBatches();
+  auto setup = [&](RHICommandList *list) {
+    list->SetRenderTargets(&rtv, 1, &dsv);
+    list->SetViewport({0.0f, 0.0f, (float)m_Width, (float)m_Height, 0.0f,
+                       1.0f});
+    list->SetScissor({0, 0, m_Width, m_Height});
+    list->SetPipelineState(m_MeshPSO->Get());
+    list->SetGraphicsConstantBuffer(0, sceneConstants);
+    list->SetPrimitiveTopology(RHIPrimitiveTopology::TriangleList);
+    list->SetVertexBuffer(1, instances.Buffer, instances.Offset,
+                          (uint32_t)instances.Size,
+                          sizeof(InstanceTransform));
+  };
+  auto record = [&](RHICommandList *list, uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; i++) {
+      const DrawBatch &batch = batches[i];
+      const MeshBuffers &mesh = m_Meshes[batch.MeshID];
+      // First batch of a slice starts from an empty list: bind everything
+      if (i == begin || batch.MaterialChanged) {
+        list->SetGraphicsConstants(
+            1, 4, MaterialPalette[batch.MaterialID % MaterialPaletteSize]);
+      }
+      if (i == begin || batch.MeshChanged) {
+        list->SetVertexBuffer(0, mesh.VB.get(), 0,
+                              (uint32_t)mesh.VB->GetDesc().Width,
+                              mesh.VertexStride);
+      }
+      list->Draw(mesh.VertexCount, batch.InstanceCount, 0,
+                 batch.FirstInstance);
+    }
+  };
+  return m_Recorder->Record((uint32_t)batches.size(), setup, record);
+}
+
+void SceneViewRenderer::CreateMeshPSO() {
+  if (!m_Device)
+    return;
+
+  // b0 = SceneBuffer CBV, b1 = material color (root constants)
+  RHIGraphicsPipelineDesc desc;
+  RHIRootParameter sceneBuffer;
+  sceneBuffer.ParameterType = RHIRootParameter::Type::ConstantBuffer;
+  sceneBuffer.ShaderRegister = 0;
+  sceneBuffer.Visibility = RHIShaderVisibility::Vertex;
+  desc.RootParameters.push_back(sceneBuffer);
+
+  RHIRootParameter material;
+  material.ParameterType = RHIRootParameter::Type::Constants;
+  material.ShaderRegister = 1;
+  material.Num32BitValues = 4;
+  material.Visibility = RHIShaderVisibility::Pixel;
+  desc.RootParameters.push_back(material);
+
+  // Slot 0: mesh vertices, slot 1: per-instance world matrix rows
+  desc.InputLayout = {
+      {"POSITION", 0, RHIFormat::RGB32_Float, 0, 0},
+      {"NORMAL", 0, RHIFormat::RGB32_Float, 0, 12},
+      {"WORLD", 0, RHIFormat::RGBA32_Float, 1, 0, true},
+      {"WORLD", 1, RHIFormat::RGBA32_Float, 1, 16, true},
+      {"WORLD", 2, RHIFormat::RGBA32_Float, 1, 32, true},
+      {"WORLD", 3, RHIFormat::RGBA32_Float, 1, 48, true}};
+  desc.Topology = RHIPrimitiveTopology::TriangleList;
+  desc.RTVFormat = RHIFormat::RGBA8_UNorm;
+  desc.DSVFormat = RHIFormat::D24_UNorm_S8_UInt;
+  desc.DepthEnable = true;
+  desc.DebugName = "Mesh";
+
+  m_MeshPSO = m_Shaders->CreatePipeline(
+      desc, {"Source/Editor/MeshShader.hlsl", "VSMain", "vs_5_0"},
+      {"Source/Editor/MeshShader.hlsl", "PSMain", "ps_5_0"});
+  if (!m_MeshPSO) {
+    std::cerr << "[SceneViewRenderer] Failed to create Mesh PSO" << std::endl;
+    return;
+  }
+
+  std::cout << "[SceneViewRenderer] Mesh PSO Created." << std::endl;
+}
+
+void SceneViewRenderer::CreateMeshGeometry() {
+  if (!m_Device)
+    return;
+
+  struct Vertex {
+    DirectX::XMFLOAT3 pos;
+    DirectX::XMFLOAT3 normal;
+  };
+
+  // Non-indexed vertices -> DEFAULT-heap VB through the copy queue
+  auto upload = [&](uint32_t meshID, const std::vector<Vertex> &vertices,
+                    const char *name) {
+    MeshBuffers &mesh = m_Meshes[meshID];
+    mesh.VertexCount = (uint32_t)vertices.size();
+    mesh.VertexStride = sizeof(Vertex);
+    for (const Vertex &vertex : vertices) {
+      mesh.Positions.insert(mesh.Positions.end(),
+                            {vertex.pos.x, vertex.pos.y, vertex.pos.z});
+    }
+    size_t bufferSize = vertices.size() * sizeof(Vertex);
+    mesh.VB = m_Device->CreateResource(RHIResourceDesc::Buffer(
+        bufferSize, RHIHeapType::Default, RHIResourceState::Common, name));
+    if (!mesh.VB)
+      return false;
+    mesh.Upload = m_Uploads->UploadBuffer(
+        mesh.VB.get(), 0, vertices.data(), bufferSize,
+        RHIResourceState::VertexAndConstantBuffer);
+    return true;
+  };
+
+  // Sphere LOD 0 keeps its BuiltinMesh ID, coarser levels follow Count
+  const uint32_t sphereLevels =
+      sizeof(SphereLODSegments) / sizeof(SphereLODSegments[0]);
+  m_Meshes.resize((size_t)BuiltinMesh::Count + sphereLevels - 1);
+
+  // Unit cube, 6 faces x 2 triangles
+  std::vector<Vertex> vertices;
+  const float faces[6][3][3] = {
+      // normal, u, v
+      {{1, 0, 0}, {0, 0, 1}, {0, 1, 0}},  {{-1, 0, 0}, {0, 1, 0}, {0, 0, 1}},
+      {{0, 1, 0}, {1, 0, 0}, {0, 0, 1}},  {{0, -1, 0}, {0, 0, 1}, {1, 0, 0}},
+      {{0, 0, 1}, {0, 1, 0}, {1, 0, 0}},  {{0, 0, -1}, {1, 0, 0}, {0, 1, 0}},
+  };
+  const float corners[6][2] = {{-1, -1}, {1, -1}, {1, 1},
+                               {-1, -1}, {1, 1},  {-1, 1}};
+  for (const auto &face : faces) {
+    for (const auto &corner : corners) {
+      Vertex vertex;
+      vertex.pos = {0.5f * (face[0][0] + corner[0] * face[1][0] +
+                            corner[1] * face[2][0]),
+                    0.5f * (face[0][1] + corner[0] * face[1][1] +
+                            corner[1] * face[2][1]),
+                    0.5f * (face[0][2] + corner[0] * face[1][2] +
+                            corner[1] * face[2][2])};
+      vertex.normal = {face[0][0], face[0][1], face[0][2]};
+      vertices.push_back(vertex);
+    }
+  }
+  if (!upload((uint32_t)BuiltinMesh::Cube, vertices, "Cube VB"))
+    return;
+
+  // UV spheres, same winding as the cube. Every level's vertices are also
+  // vertices of the finer ones, so coarser levels lie inside finer ones.
+  // Geometric error = sagitta of one segment, R (1 - cos(pi / segments)).
+  const float pi = DirectX::XM_PI;
+  std::vector<LODLevel> sphereChain;
+  for (uint32_t level = 0; level < sphereLevels; level++) {
+    const uint32_t segments = SphereLODSegments[level];
+    const uint32_t rings = segments / 2;
+    auto point = [&](uint32_t ring, uint32_t segment) {
+      float theta = pi * ring / rings;
+      float phi = 2.0f * pi * segment / segments;
+      Vertex vertex;
+      vertex.normal = {std::sin(theta) * std::cos(phi), std::cos(theta),
+                       std::sin(theta) * std::sin(phi)};
+      vertex.pos = {SphereRadius * vertex.normal.x,
+                    SphereRadius * vertex.normal.y,
+                    SphereRadius * vertex.normal.z};
+      return vertex;
+    };
+    vertices.clear();
+    for (uint32_t ring = 0; ring < rings; ring++) {
+      for (uint32_t segment = 0; segment < segments; segment++) {
+        Vertex topLeft = point(ring, segment);
+        Vertex topRight = point(ring, segment + 1);
+        Vertex bottomLeft = point(ring + 1, segment);
+        Vertex bottomRight = point(ring + 1, segment + 1);
+        // The pole rows have one degenerate triangle per quad
+        if (ring + 1 < rings)
+          vertices.insert(vertices.end(), {bottomLeft, bottomRight, topRight});
+        if (ring > 0)
+          vertices.insert(vertices.end(), {bottomLeft, topRight, topLeft});
+      }
+    }
+
+    uint32_t meshID = level == 0 ? (uint32_t)BuiltinMesh::Sphere
+                                 : (uint32_t)BuiltinMesh::Count + level - 1;
+    std::string name = "Sphere LOD" + std::to_string(level) + " VB";
+    if (!upload(meshID, vertices, name.c_str()))
+      return;
+    sphereChain.push_back(
+        {meshID, SphereRadius * (1.0f - std::cos(pi / segments))});
+  }
+  m_LODSelector.SetChain((uint32_t)BuiltinMesh::Sphere, sphereChain);
+
+  std::cout << "[SceneViewRenderer] Mesh Geometry Created." << std::endl;
+}
+
+void SceneViewRenderer::CullLights(const EditorCamera *camera,
+                                   const Scene *scene) {
+  FORGE_PROFILE_SCOPE("CullLights");
+  m_ClusterLights.clear();
+  for (const auto &entity : scene->GetEntities()) {
+    const LightComponent *light = entity->GetLight();
+    if (!light || light->Type == LightType::Directional)
+      continue;
+    DirectX::XMFLOAT4X4 world;
+    DirectX::XMStoreFloat4x4(&world, entity->GetWorldTransform());
+    DirectX::XMVECTOR axis = DirectX::XMVector3Normalize(
+        DirectX::XMVectorSet(world._31, world._32, world._33, 0.0f));
+    ClusterLight clusterLight;
+    clusterLight.Position[0] = world._41;
+    clusterLight.Position[1] = world._42;
+    clusterLight.Position[2] = world._43;
+    clusterLight.Range = light->Range;
+    clusterLight.Direction[0] = DirectX::XMVectorGetX(axis);
+    clusterLight.Direction[1] = DirectX::XMVectorGetY(axis);
+    clusterLight.Direction[2] = DirectX::XMVectorGetZ(axis);
+    clusterLight.CosAngle =
+        std::cos(DirectX::XMConvertToRadians(light->SpotAngle));
+    clusterLight.Type = light->Type == LightType::Spot
+                            ? ClusterLightType::Spot
+                            : ClusterLightType::Point;
+    m_ClusterLights.push_back(clusterLight);
+  }
+
+  DirectX::XMFLOAT4X4 view;
+  DirectX::XMStoreFloat4x4(&view, camera->GetViewMatrix());
+  m_LightCuller.SetResolution((uint32_t)m_Width, (uint32_t)m_Height);
+  m_LightCuller.SetView(&view.m[0][0],
+                        DirectX::XMConvertToRadians(camera->GetFOV()),
+                        camera->GetNearPlane(), camera->GetFarPlane());
+  m_LightCuller.Cull(m_ClusterLights.data(),
+                     (uint32_t)m_ClusterLights.size(), &JobSystem::Get());
+}
+
+uint32_t SceneViewRenderer::GetDrawMeshID(const Entity &entity) const {
+  uint32_t meshID = entity.GetMesh()->MeshID;
+  const LODComponent *lod = entity.GetLOD();
+  uint32_t levelCount = m_LODSelector.GetLevelCount(meshID);
+  if (!lod || levelCount == 0)
+    return meshID;
+  return m_LODSelector.GetLevelMesh(
+      meshID, std::min<uint32_t>(lod->CurrentLOD, levelCount - 1));
+}
+
 } // namespace Forge
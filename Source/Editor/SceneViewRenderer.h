@@ -1,11 +1,25 @@
 #pragma once
-#include <d3d12.h>
-#include <dxgi1_4.h>
-#include <wrl/client.h>
+#include "../Runtime/RHI/DeferredRelease.h"
+#include "../Runtime/RHI/DescriptorAllocator.h"
+#include "../Runtime/RHI/ParallelRecorder.h"
+#include "../Runtime/RHI/RHI.h"
+#include "../Runtime/RHI/UploadManager.h"
+#include "../Runtime/RHI/UploadRing.h"
+#include "../Runtime/Renderer/ClusteredLightCuller.h"
+#include "../Runtime/Renderer/DrawBatcher.h"
+#include "../Runtime/Renderer/LODSelector.h"
+#include "../Runtime/Renderer/OcclusionCuller.h"
+#include "../Runtime/Renderer/RenderGraph.h"
+#include "../Runtime/Renderer/ShaderHotReload.h"
+#include "../Runtime/Renderer/SoftwareRasterizer.h"
+#include <memory>
+#include <vector>
 
 namespace Forge {
 
 class EditorCamera;
+class Entity;
+class Scene;
 
 // 독립적인 Scene View 렌더 리소스
 // EditorUI와 완전 분리됨
@@ -14,19 +28,32 @@ public:
   SceneViewRenderer();
   ~SceneViewRenderer();
 
-  // 초기화 (Device, SRV Heap 전달)
-  void Initialize(ID3D12Device *device, ID3D12DescriptorHeap *srvHeap);
+  // 초기화 (Device, Descriptor Allocator, 프레임별 Upload Ring, 정적
+  // 데이터용 Upload Manager(copy queue), 셰이더 핫 리로드(캐시 포함), 병렬
+  // 커맨드 기록기, 프레임 렌더 그래프, 지연 해제 큐 전달)
+  void Initialize(RHIDevice *device, DescriptorAllocator *descriptors,
+                  UploadRing *uploadRing, UploadManager *uploads,
+                  ShaderHotReload *shaders, ParallelCommandRecorder *recorder,
+                  RenderGraph *graph, DeferredReleaseQueue *releaseQueue);
   void Shutdown();
 
-  // 크기 변경 시 RT 재생성
+  // 크기 변경 요청 (매 프레임 호출). 크기가 ResizeSettleFrames 동안
+  // 유지되면 다음 Render에서 RT 재생성, 이전 RT는 GPU 완료 후 해제
   void Resize(int width, int height);
 
-  // 렌더링 (카메라 기반)
-  void Render(ID3D12GraphicsCommandList *commandList,
-              const EditorCamera *camera);
+  // 렌더링 (카메라 기반, scene의 MeshComponent는 인스턴싱으로 배치)
+  // 메시 패스는 여러 커맨드 리스트에 병렬 기록될 수 있음: 이후 기록은
+  // 반환된 리스트에 해야 한다
+  RHICommandList *Render(RHICommandList *commandList,
+                         const EditorCamera *camera, const Scene *scene);
+
+  // 같은 카메라/씬을 CPU(SoftwareRasterizer)로 렌더링 (GPU 불필요)
+  // 스크린샷, 썸네일, GPU 결과와의 비교용
+  RasterImage RenderSoftware(const EditorCamera *camera, const Scene *scene,
+                             int width, int height);
 
   // ImGui Image용 SRV Handle
-  D3D12_GPU_DESCRIPTOR_HANDLE GetSRV() const { return m_SrvHandle; }
+  RHIGPUDescriptor GetSRV() const { return m_Srv.GPU; }
 
   // 크기 조회
   int GetWidth() const { return m_Width; }
@@ -35,40 +62,112 @@ public:
   // 리소스 유효 여부
   bool IsValid() const { return m_ColorRT != nullptr; }
 
+  // Times the targets were recreated for a new viewport size
+  uint64_t GetResizeCount() const { return m_ResizeCount; }
+
+  // Draw calls / state changes of the last mesh pass
+  const DrawBatchStats &GetBatchStats() const { return m_Batcher.GetStats(); }
+
+  // CPU occlusion culling of the mesh pass (on by default)
+  void SetOcclusionCulling(bool enabled) { m_OcclusionCulling = enabled; }
+  bool IsOcclusionCullingEnabled() const { return m_OcclusionCulling; }
+  const OcclusionStats &GetOcclusionStats() const {
+    return m_OcclusionCuller.GetStats();
+  }
+
+  // Screen-space-error LOD selection for entities with a LODComponent
+  void SetLODSettings(const LODSettings &settings) {
+    m_LODSelector.SetSettings(settings);
+  }
+  const LODSettings &GetLODSettings() const {
+    return m_LODSelector.GetSettings();
+  }
+  const LODSelectionStats &GetLODStats() const {
+    return m_LODSelector.GetStats();
+  }
+
+  // Point and spot lights assigned to the view's clusters each frame
+  const ClusteredLightCuller &GetLightCuller() const { return m_LightCuller; }
+
 private:
   void CreateResources();
   void ReleaseResources();
+  void ApplyPendingResize();
 
-  ID3D12Device *m_Device = nullptr;
-  ID3D12DescriptorHeap *m_SrvHeap = nullptr;
-
-  // Render Target Resources
-  Microsoft::WRL::ComPtr<ID3D12Resource> m_ColorRT;
-  Microsoft::WRL::ComPtr<ID3D12Resource> m_DepthRT;
+  RHIDevice *m_Device = nullptr;
+  DescriptorAllocator *m_Descriptors = nullptr;
+  UploadRing *m_UploadRing = nullptr;
+  UploadManager *m_Uploads = nullptr;
+  ShaderHotReload *m_Shaders = nullptr;
+  ParallelCommandRecorder *m_Recorder = nullptr;
+  RenderGraph *m_Graph = nullptr;
+  DeferredReleaseQueue *m_ReleaseQueue = nullptr;
 
-  // Descriptor Heaps (RTV/DSV는 자체 보유)
-  Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_RtvHeap;
-  Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_DsvHeap;
-
-  D3D12_CPU_DESCRIPTOR_HANDLE m_RtvHandle = {};
-  D3D12_CPU_DESCRIPTOR_HANDLE m_DsvHandle = {};
-  D3D12_GPU_DESCRIPTOR_HANDLE m_SrvHandle = {};
+  // Render Target Resources (depth는 렌더 그래프의 transient 텍스처)
+  std::unique_ptr<RHIResource> m_ColorRT;
+  DescriptorRange m_Srv; // ImGui::Image 용 SRV (persistent)
 
   int m_Width = 0;
   int m_Height = 0;
 
-  // Grid Rendering Resources
-  Microsoft::WRL::ComPtr<ID3D12RootSignature> m_GridRootSig;
-  Microsoft::WRL::ComPtr<ID3D12PipelineState> m_GridPSO;
-  Microsoft::WRL::ComPtr<ID3D12Resource> m_GridVB;
-  D3D12_VERTEX_BUFFER_VIEW m_GridVBV = {};
-  UINT m_GridVertexCount = 0;
+  // Debounced resize: dragging a splitter changes the size every frame
+  int m_PendingWidth = 0;
+  int m_PendingHeight = 0;
+  int m_PendingFrames = 0; // frames the pending size has been stable
+  uint64_t m_ResizeCount = 0;
+
+  // Grid Rendering Resources (vertex buffers live in DEFAULT heaps and are
+  // drawn once their copy-queue upload completed)
+  ReloadablePipeline *m_GridPSO = nullptr; // owned by ShaderHotReload
+  std::unique_ptr<RHIResource> m_GridVB;
+  UploadTicket m_GridUpload;
+  uint32_t m_GridVertexStride = 0;
+  uint32_t m_GridVertexCount = 0;
+  std::vector<float> m_GridPositions; // CPU copy (float3) for RenderSoftware
+
+  // Mesh Rendering Resources (index = MeshComponent::MeshID)
+  struct MeshBuffers {
+    std::unique_ptr<RHIResource> VB;
+    UploadTicket Upload;
+    uint32_t VertexCount = 0;
+    uint32_t VertexStride = 0;
+    std::vector<float> Positions; // CPU copy (float3) for RenderSoftware
+  };
+  std::vector<MeshBuffers> m_Meshes;
+  ReloadablePipeline *m_MeshPSO = nullptr;
+  DrawBatcher m_Batcher;
+
+  // Entities are culled against a low-resolution masked depth buffer of
+  // the largest ones before they reach the batcher
+  OcclusionCuller m_OcclusionCuller;
+  bool m_OcclusionCulling = true;
+  float m_ViewProj[16] = {}; // this frame's camera, row-major
+  std::vector<OcclusionObject> m_CullObjects;
+  std::vector<const Entity *> m_CullEntities;
+  std::vector<uint8_t> m_CullVisible;
+
+  // Visible entities with a LODComponent draw the level picked for their
+  // screen-space error (chains registered by CreateMeshGeometry)
+  LODSelector m_LODSelector;
+  std::vector<LODInstance> m_LODInstances;
+  std::vector<uint32_t> m_LODEntities; // index into m_CullEntities
+  std::vector<uint8_t> m_LODLevels;
+  SoftwareRasterizer m_SoftwareRasterizer;
+
+  // Cluster light lists of the camera's view (not uploaded yet: no shader
+  // reads them)
+  ClusteredLightCuller m_LightCuller;
+  std::vector<ClusterLight> m_ClusterLights;
 
   void CreateGridPSO();
   void CreateGridGeometry();
-
-  // SRV Heap 내 슬롯 인덱스 (고정)
-  static const UINT SRV_SLOT = 10;
+  void CreateMeshPSO();
+  void CreateMeshGeometry();
+  uint32_t GetDrawMeshID(const Entity &entity) const;
+  void CullLights(const EditorCamera *camera, const Scene *scene);
+  RHICommandList *RenderMeshes(RHICommandList *commandList, const Scene *scene,
+                               uint64_t sceneConstants, RHICPUDescriptor rtv,
+                               RHICPUDescriptor dsv);
 };
 
 } // namespace Forge
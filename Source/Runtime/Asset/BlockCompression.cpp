@@ -0,0 +1,926 @@
+#include "BlockCompression.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Forge {
+
+namespace {
+
+// 16 pixels as channel planes, with a per-pixel weight (0 = ignored by the
+// fit, e.g. punch-through pixels)
+struct Block {
+  alignas(32) float Channel[4][16];
+  alignas(32) float Weight[16];
+};
+
+void LoadBlock(const uint8_t pixels[64], Block &block) {
+  for (int i = 0; i < 16; i++) {
+    for (int c = 0; c < 4; c++)
+      block.Channel[c][i] = pixels[i * 4 + c];
+    block.Weight[i] = 1.0f;
+  }
+}
+
+// Nearest palette entry per pixel under per-channel weights. Returns the
+// summed weighted squared error. Both paths do the same float operations
+// in the same order, so they pick the same indices.
+float SelectIndices(const Block &block, const float (*palette)[4], int count,
+                    const float weights[4], uint8_t indices[16]) {
+  float errors[16];
+#if defined(__AVX2__)
+  __m256 channelWeight[4];
+  for (int c = 0; c < 4; c++)
+    channelWeight[c] = _mm256_set1_ps(weights[c]);
+  for (int half = 0; half < 16; half += 8) {
+    __m256 pixel[4];
+    for (int c = 0; c < 4; c++)
+      pixel[c] = _mm256_load_ps(block.Channel[c] + half);
+    __m256 best = _mm256_set1_ps(FLT_MAX);
+    __m256 bestIndex = _mm256_setzero_ps();
+    for (int k = 0; k < count; k++) {
+      __m256 distance = _mm256_setzero_ps();
+      for (int c = 0; c < 4; c++) {
+        __m256 d = _mm256_sub_ps(pixel[c], _mm256_set1_ps(palette[k][c]));
+        distance = _mm256_add_ps(
+            distance, _mm256_mul_ps(_mm256_mul_ps(d, d), channelWeight[c]));
+      }
+      __m256 closer = _mm256_cmp_ps(distance, best, _CMP_LT_OQ);
+      best = _mm256_blendv_ps(best, distance, closer);
+      bestIndex = _mm256_blendv_ps(bestIndex, _mm256_set1_ps((float)k), closer);
+    }
+    best = _mm256_mul_ps(best, _mm256_load_ps(block.Weight + half));
+    _mm256_storeu_ps(errors + half, best);
+    alignas(32) int32_t lanes[8];
+    _mm256_store_si256((__m256i *)lanes, _mm256_cvtps_epi32(bestIndex));
+    for (int i = 0; i < 8; i++)
+      indices[half + i] = (uint8_t)lanes[i];
+  }
+#else
+  for (int i = 0; i < 16; i++) {
+    float best = FLT_MAX;
+    int bestIndex = 0;
+    for (int k = 0; k < count; k++) {
+      float distance = 0.0f;
+      for (int c = 0; c < 4; c++) {
+        float d = block.Channel[c][i] - palette[k][c];
+        distance = distance + d * d * weights[c];
+      }
+      if (distance < best) {
+        best = distance;
+        bestIndex = k;
+      }
+    }
+    errors[i] = best * block.Weight[i];
+    indices[i] = (uint8_t)bestIndex;
+  }
+#endif
+  float total = 0.0f;
+  for (int i = 0; i < 16; i++)
+    total += errors[i];
+  return total;
+}
+
+// Weighted mean and principal axis (power iteration) of the channels with
+// a nonzero mask. The axis is zero for a flat block.
+void FitAxis(const Block &block, const float mask[4], float mean[4],
+             float axis[4]) {
+  float total = 0.0f;
+  for (int c = 0; c < 4; c++)
+    mean[c] = axis[c] = 0.0f;
+  for (int i = 0; i < 16; i++) {
+    total += block.Weight[i];
+    for (int c = 0; c < 4; c++)
+      mean[c] += block.Weight[i] * block.Channel[c][i];
+  }
+  if (total <= 0.0f)
+    return;
+  for (int c = 0; c < 4; c++)
+    mean[c] /= total;
+
+  float covariance[4][4] = {};
+  for (int i = 0; i < 16; i++) {
+    float d[4];
+    for (int c = 0; c < 4; c++)
+      d[c] = mask[c] != 0.0f ? block.Channel[c][i] - mean[c] : 0.0f;
+    for (int r = 0; r < 4; r++) {
+      for (int c = 0; c < 4; c++)
+        covariance[r][c] += block.Weight[i] * d[r] * d[c];
+    }
+  }
+  int start = 0;
+  for (int c = 1; c < 4; c++) {
+    if (covariance[c][c] > covariance[start][start])
+      start = c;
+  }
+  if (covariance[start][start] < 1e-4f)
+    return;
+
+  float v[4];
+  for (int c = 0; c < 4; c++)
+    v[c] = covariance[start][c];
+  for (int iteration = 0; iteration < 8; iteration++) {
+    float next[4] = {};
+    for (int r = 0; r < 4; r++) {
+      for (int c = 0; c < 4; c++)
+        next[r] += covariance[r][c] * v[c];
+    }
+    float scale = std::max({std::abs(next[0]), std::abs(next[1]),
+                            std::abs(next[2]), std::abs(next[3])});
+    if (scale <= 0.0f)
+      return;
+    for (int c = 0; c < 4; c++)
+      v[c] = next[c] / scale;
+  }
+  float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2] +
+                           v[3] * v[3]);
+  for (int c = 0; c < 4; c++)
+    axis[c] = v[c] / length;
+}
+
+// Extremes of the weighted pixels along the axis, clamped to [0, 255]
+void AxisEndpoints(const Block &block, const float mean[4],
+                   const float axis[4], float low[4], float high[4]) {
+  float minimum = 0.0f, maximum = 0.0f;
+  for (int i = 0; i < 16; i++) {
+    if (block.Weight[i] <= 0.0f)
+      continue;
+    float t = 0.0f;
+    for (int c = 0; c < 4; c++)
+      t += axis[c] * (block.Channel[c][i] - mean[c]);
+    minimum = std::min(minimum, t);
+    maximum = std::max(maximum, t);
+  }
+  for (int c = 0; c < 4; c++) {
+    low[c] = std::clamp(mean[c] + minimum * axis[c], 0.0f, 255.0f);
+    high[c] = std::clamp(mean[c] + maximum * axis[c], 0.0f, 255.0f);
+  }
+}
+
+// Least-squares endpoints for fixed indices: pixel i is
+// (1 - w) * e0 + w * e1 with w = indexWeights[indices[i]]. False if the
+// system is singular (all pixels on one weight).
+bool RefineEndpoints(const Block &block, const uint8_t indices[16],
+                     const float *indexWeights, float e0[4], float e1[4]) {
+  float a = 0.0f, b = 0.0f, c = 0.0f;
+  float r0[4] = {}, r1[4] = {};
+  for (int i = 0; i < 16; i++) {
+    float pixelWeight = block.Weight[i];
+    float w = indexWeights[indices[i]], v = 1.0f - w;
+    a += pixelWeight * v * v;
+    b += pixelWeight * v * w;
+    c += pixelWeight * w * w;
+    for (int ch = 0; ch < 4; ch++) {
+      r0[ch] += pixelWeight * v * block.Channel[ch][i];
+      r1[ch] += pixelWeight * w * block.Channel[ch][i];
+    }
+  }
+  float determinant = a * c - b * b;
+  if (std::abs(determinant) < 1e-6f)
+    return false;
+  for (int ch = 0; ch < 4; ch++) {
+    e0[ch] = std::clamp((c * r0[ch] - b * r1[ch]) / determinant, 0.0f, 255.0f);
+    e1[ch] = std::clamp((a * r1[ch] - b * r0[ch]) / determinant, 0.0f, 255.0f);
+  }
+  return true;
+}
+
+// --- 128-bit little-endian bit streams (BC7) ---
+
+struct BitStream {
+  uint8_t *Bytes;
+  int Position = 0;
+
+  void Write(uint32_t value, int count) {
+    for (int i = 0; i < count; i++, Position++) {
+      if ((value >> i) & 1)
+        Bytes[Position >> 3] |= (uint8_t)(1u << (Position & 7));
+    }
+  }
+  uint32_t Read(int count) {
+    uint32_t value = 0;
+    for (int i = 0; i < count; i++, Position++)
+      value |= (uint32_t)((Bytes[Position >> 3] >> (Position & 7)) & 1) << i;
+    return value;
+  }
+};
+
+// --- BC1 ---
+
+const float ColorWeights[4] = {1.0f, 1.0f, 1.0f, 0.0f};
+const float AlphaWeights[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+
+void Expand565(uint16_t color, int out[3]) {
+  int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+  out[0] = (r << 3) | (r >> 2);
+  out[1] = (g << 2) | (g >> 4);
+  out[2] = (b << 3) | (b >> 2);
+}
+
+uint16_t Quantize565(const float color[3]) {
+  int r = (int)std::lround(color[0] * 31.0f / 255.0f);
+  int g = (int)std::lround(color[1] * 63.0f / 255.0f);
+  int b = (int)std::lround(color[2] * 31.0f / 255.0f);
+  return (uint16_t)(std::clamp(r, 0, 31) << 11 | std::clamp(g, 0, 63) << 5 |
+                    std::clamp(b, 0, 31));
+}
+
+// Palette in index order; threeColor: c2 = midpoint, c3 = transparent black
+void BC1Palette(uint16_t c0, uint16_t c1, bool threeColor,
+                float palette[4][4]) {
+  int a[3], b[3];
+  Expand565(c0, a);
+  Expand565(c1, b);
+  for (int c = 0; c < 3; c++) {
+    palette[0][c] = (float)a[c];
+    palette[1][c] = (float)b[c];
+    if (threeColor) {
+      palette[2][c] = (float)((a[c] + b[c] + 1) / 2);
+      palette[3][c] = 0.0f;
+    } else {
+      palette[2][c] = (float)((2 * a[c] + b[c] + 1) / 3);
+      palette[3][c] = (float)((a[c] + 2 * b[c] + 1) / 3);
+    }
+  }
+  for (int k = 0; k < 4; k++)
+    palette[k][3] = (threeColor && k == 3) ? 0.0f : 255.0f;
+}
+
+// Best (e0, e1) per 8-bit value for a solid block drawn with index 2
+// ((2 * e0 + e1) / 3), for 5- and 6-bit channels
+struct SingleColorTables {
+  uint8_t Match5[256][2];
+  uint8_t Match6[256][2];
+
+  SingleColorTables() {
+    Build(Match5, 5);
+    Build(Match6, 6);
+  }
+  static void Build(uint8_t table[256][2], int bits) {
+    int levels = 1 << bits;
+    for (int value = 0; value < 256; value++) {
+      int bestError = 256;
+      for (int e0 = 0; e0 < levels; e0++) {
+        for (int e1 = 0; e1 < levels; e1++) {
+          int a = bits == 5 ? (e0 << 3) | (e0 >> 2) : (e0 << 2) | (e0 >> 4);
+          int b = bits == 5 ? (e1 << 3) | (e1 >> 2) : (e1 << 2) | (e1 >> 4);
+          int error = std::abs((2 * a + b + 1) / 3 - value);
+          if (error < bestError) {
+            bestError = error;
+            table[value][0] = (uint8_t)e0;
+            table[value][1] = (uint8_t)e1;
+          }
+        }
+      }
+    }
+  }
+};
+
+struct BC1Result {
+  uint16_t C0 = 0, C1 = 0;
+  uint8_t Indices[16] = {};
+  float Error = FLT_MAX;
+};
+
+void TryBC1(const Block &block, uint16_t c0, uint16_t c1, bool threeColor,
+            BC1Result &best) {
+  float palette[4][4];
+  BC1Palette(c0, c1, threeColor, palette);
+  uint8_t indices[16];
+  float error =
+      SelectIndices(block, palette, threeColor ? 3 : 4, ColorWeights, indices);
+  if (error < best.Error) {
+    best.C0 = c0;
+    best.C1 = c1;
+    best.Error = error;
+    memcpy(best.Indices, indices, 16);
+  }
+}
+
+// The color half of BC1 / BC3. threeColor: punch-through mode, pixels with
+// zero weight become transparent.
+void EncodeColorBlock(const Block &block, bool threeColor, BCQuality quality,
+                      uint8_t out[8]) {
+  BC1Result best;
+
+  bool solid = !threeColor;
+  for (int i = 1; i < 16 && solid; i++) {
+    for (int c = 0; c < 3; c++)
+      solid &= block.Channel[c][i] == block.Channel[c][0];
+  }
+  if (solid) {
+    static const SingleColorTables tables;
+    int r = (int)block.Channel[0][0], g = (int)block.Channel[1][0],
+        b = (int)block.Channel[2][0];
+    uint16_t c0 = (uint16_t)(tables.Match5[r][0] << 11 |
+                             tables.Match6[g][0] << 5 | tables.Match5[b][0]);
+    uint16_t c1 = (uint16_t)(tables.Match5[r][1] << 11 |
+                             tables.Match6[g][1] << 5 | tables.Match5[b][1]);
+    TryBC1(block, c0, c1, false, best);
+  } else {
+    float mean[4], axis[4], low[4], high[4];
+    FitAxis(block, ColorWeights, mean, axis);
+    AxisEndpoints(block, mean, axis, low, high);
+    TryBC1(block, Quantize565(high), Quantize565(low), threeColor, best);
+
+    static const float weights4[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+    static const float weights3[3] = {0.0f, 1.0f, 0.5f};
+    int iterations = quality == BCQuality::Fast     ? 0
+                     : quality == BCQuality::Normal ? 1
+                                                    : 3;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+      float e0[4], e1[4];
+      if (!RefineEndpoints(block, best.Indices,
+                           threeColor ? weights3 : weights4, e0, e1))
+        break;
+      float previous = best.Error;
+      TryBC1(block, Quantize565(e0), Quantize565(e1), threeColor, best);
+      if (best.Error >= previous)
+        break;
+    }
+
+    // High: greedy +-1 steps on each endpoint channel
+    if (quality == BCQuality::High) {
+      static const int shifts[3] = {11, 5, 0};
+      static const int limits[3] = {31, 63, 31};
+      for (int round = 0; round < 2; round++) {
+        float previous = best.Error;
+        for (int endpoint = 0; endpoint < 2; endpoint++) {
+          for (int c = 0; c < 3; c++) {
+            for (int delta = -1; delta <= 1; delta += 2) {
+              uint16_t color = endpoint == 0 ? best.C0 : best.C1;
+              int value = ((color >> shifts[c]) & limits[c]) + delta;
+              if (value < 0 || value > limits[c])
+                continue;
+              color = (uint16_t)((color & ~(limits[c] << shifts[c])) |
+                                 value << shifts[c]);
+              TryBC1(block, endpoint == 0 ? color : best.C0,
+                     endpoint == 0 ? best.C1 : color, threeColor, best);
+            }
+          }
+        }
+        if (best.Error >= previous)
+          break;
+      }
+    }
+  }
+
+  // Mode is chosen by endpoint order: c0 > c1 four colors, else three
+  uint16_t c0 = best.C0, c1 = best.C1;
+  uint8_t *indices = best.Indices;
+  if (threeColor) {
+    if (c0 > c1) {
+      std::swap(c0, c1);
+      for (int i = 0; i < 16; i++)
+        indices[i] = indices[i] < 2 ? indices[i] ^ 1 : indices[i];
+    }
+    for (int i = 0; i < 16; i++) {
+      if (block.Weight[i] <= 0.0f)
+        indices[i] = 3;
+    }
+  } else if (c0 < c1) {
+    std::swap(c0, c1);
+    for (int i = 0; i < 16; i++)
+      indices[i] ^= 1; // 0 <-> 1, 2 <-> 3
+  } else if (c0 == c1) {
+    memset(indices, 0, 16); // every palette entry is c0
+  }
+
+  out[0] = (uint8_t)c0;
+  out[1] = (uint8_t)(c0 >> 8);
+  out[2] = (uint8_t)c1;
+  out[3] = (uint8_t)(c1 >> 8);
+  uint32_t bits = 0;
+  for (int i = 0; i < 16; i++)
+    bits |= (uint32_t)indices[i] << (i * 2);
+  memcpy(out + 4, &bits, 4);
+}
+
+void DecodeColorBlock(const uint8_t block[8], bool allowThreeColor,
+                      uint8_t out[64]) {
+  uint16_t c0 = (uint16_t)(block[0] | block[1] << 8);
+  uint16_t c1 = (uint16_t)(block[2] | block[3] << 8);
+  float palette[4][4];
+  BC1Palette(c0, c1, allowThreeColor && c0 <= c1, palette);
+  for (int i = 0; i < 16; i++) {
+    int index = (block[4 + i / 4] >> ((i % 4) * 2)) & 3;
+    for (int c = 0; c < 4; c++)
+      out[i * 4 + c] = (uint8_t)palette[index][c];
+  }
+}
+
+// --- BC4 ---
+
+void BC4Palette(int a0, int a1, int palette[8]) {
+  palette[0] = a0;
+  palette[1] = a1;
+  if (a0 > a1) {
+    for (int k = 2; k < 8; k++)
+      palette[k] = ((8 - k) * a0 + (k - 1) * a1 + 3) / 7;
+  } else {
+    for (int k = 2; k < 6; k++)
+      palette[k] = ((6 - k) * a0 + (k - 1) * a1 + 2) / 5;
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+}
+
+int TryBC4(const int values[16], int a0, int a1, uint8_t indices[16]) {
+  int palette[8];
+  BC4Palette(a0, a1, palette);
+  int error = 0;
+  for (int i = 0; i < 16; i++) {
+    int best = INT32_MAX;
+    for (int k = 0; k < 8; k++) {
+      int d = values[i] - palette[k];
+      if (d * d < best) {
+        best = d * d;
+        indices[i] = (uint8_t)k;
+      }
+    }
+    error += best;
+  }
+  return error;
+}
+
+// Endpoint fit per mode. Eight-value mode (a0 > a1) spans min..max;
+// six-value mode (a0 <= a1) spans the values strictly between 0 and 255,
+// which it has exact entries for.
+void EncodeBC4Values(const int values[16], BCQuality quality, uint8_t out[8]) {
+  int minimum = 255, maximum = 0, innerMin = 255, innerMax = 0;
+  for (int i = 0; i < 16; i++) {
+    minimum = std::min(minimum, values[i]);
+    maximum = std::max(maximum, values[i]);
+    if (values[i] > 0 && values[i] < 255) {
+      innerMin = std::min(innerMin, values[i]);
+      innerMax = std::max(innerMax, values[i]);
+    }
+  }
+
+  int bestA0 = maximum, bestA1 = minimum, bestError = INT32_MAX;
+  uint8_t bestIndices[16] = {};
+  auto consider = [&](int a0, int a1) {
+    uint8_t indices[16];
+    int error = TryBC4(values, a0, a1, indices);
+    if (error < bestError) {
+      bestError = error;
+      bestA0 = a0;
+      bestA1 = a1;
+      memcpy(bestIndices, indices, 16);
+    }
+  };
+
+  if (minimum == maximum) {
+    consider(minimum, minimum);
+  } else {
+    consider(maximum, minimum);
+    if (quality != BCQuality::Fast && innerMin <= innerMax)
+      consider(innerMin, innerMax);
+  }
+
+  // High: least squares on the eight-value mode, then +-2 around the best
+  if (quality == BCQuality::High && minimum != maximum) {
+    for (int iteration = 0; iteration < 2 && bestA0 > bestA1; iteration++) {
+      float a = 0.0f, b = 0.0f, c = 0.0f, r0 = 0.0f, r1 = 0.0f;
+      for (int i = 0; i < 16; i++) {
+        int k = bestIndices[i];
+        float w = k == 0 ? 0.0f : k == 1 ? 1.0f : (float)(k - 1) / 7.0f;
+        a += (1 - w) * (1 - w);
+        b += (1 - w) * w;
+        c += w * w;
+        r0 += (1 - w) * values[i];
+        r1 += w * values[i];
+      }
+      float determinant = a * c - b * b;
+      if (std::abs(determinant) < 1e-6f)
+        break;
+      int a0 = std::clamp((int)std::lround((c * r0 - b * r1) / determinant),
+                          0, 255);
+      int a1 = std::clamp((int)std::lround((a * r1 - b * r0) / determinant),
+                          0, 255);
+      if (a0 <= a1)
+        break;
+      consider(a0, a1);
+    }
+    int centerA0 = bestA0, centerA1 = bestA1;
+    for (int d0 = -2; d0 <= 2; d0++) {
+      for (int d1 = -2; d1 <= 2; d1++) {
+        int a0 = centerA0 + d0, a1 = centerA1 + d1;
+        if (a0 < 0 || a0 > 255 || a1 < 0 || a1 > 255)
+          continue;
+        if ((centerA0 > centerA1) == (a0 > a1))
+          consider(a0, a1);
+      }
+    }
+  }
+
+  out[0] = (uint8_t)bestA0;
+  out[1] = (uint8_t)bestA1;
+  uint64_t bits = 0;
+  for (int i = 0; i < 16; i++)
+    bits |= (uint64_t)bestIndices[i] << (i * 3);
+  for (int b = 0; b < 6; b++)
+    out[2 + b] = (uint8_t)(bits >> (b * 8));
+}
+
+// --- BC7 ---
+
+const int Weights2[4] = {0, 21, 43, 64};
+const int Weights4[16] = {0,  4,  9,  13, 17, 21, 26, 30,
+                          34, 38, 43, 47, 51, 55, 60, 64};
+
+int Interpolate(int e0, int e1, int weight) {
+  return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+}
+
+struct Mode6Result {
+  uint8_t Endpoint[2][4] = {}; // 7 bits
+  uint8_t PBit[2] = {};
+  uint8_t Indices[16] = {};
+  float Error = FLT_MAX;
+};
+
+void TryMode6(const Block &block, const float e0[4], const float e1[4],
+              int p0, int p1, Mode6Result &best) {
+  const float *endpoints[2] = {e0, e1};
+  const int pbits[2] = {p0, p1};
+  Mode6Result result;
+  int expanded[2][4];
+  for (int e = 0; e < 2; e++) {
+    result.PBit[e] = (uint8_t)pbits[e];
+    for (int c = 0; c < 4; c++) {
+      int q = (int)std::lround((endpoints[e][c] - pbits[e]) * 0.5f);
+      result.Endpoint[e][c] = (uint8_t)std::clamp(q, 0, 127);
+      expanded[e][c] = result.Endpoint[e][c] << 1 | pbits[e];
+    }
+  }
+  float palette[16][4];
+  for (int k = 0; k < 16; k++) {
+    for (int c = 0; c < 4; c++)
+      palette[k][c] =
+          (float)Interpolate(expanded[0][c], expanded[1][c], Weights4[k]);
+  }
+  static const float weights[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+  result.Error = SelectIndices(block, palette, 16, weights, result.Indices);
+  if (result.Error < best.Error)
+    best = result;
+}
+
+// Each endpoint's p-bit picked on its own quantization error
+int NearestPBit(const float endpoint[4]) {
+  float errors[2] = {};
+  for (int p = 0; p < 2; p++) {
+    for (int c = 0; c < 4; c++) {
+      int q = std::clamp((int)std::lround((endpoint[c] - p) * 0.5f), 0, 127);
+      float d = endpoint[c] - (float)(q << 1 | p);
+      errors[p] += d * d;
+    }
+  }
+  return errors[1] < errors[0] ? 1 : 0;
+}
+
+Mode6Result FitMode6(const Block &block, BCQuality quality) {
+  static const float mask[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+  float mean[4], axis[4], e0[4], e1[4];
+  FitAxis(block, mask, mean, axis);
+  AxisEndpoints(block, mean, axis, e0, e1);
+
+  // Opaque blocks keep alpha exactly 255: both p-bits set
+  bool opaque = true;
+  for (int i = 0; i < 16; i++)
+    opaque &= block.Channel[3][i] == 255.0f;
+
+  Mode6Result best;
+  auto tryPBits = [&](const float *a, const float *b) {
+    if (opaque) {
+      TryMode6(block, a, b, 1, 1, best);
+    } else if (quality == BCQuality::Fast) {
+      TryMode6(block, a, b, NearestPBit(a), NearestPBit(b), best);
+    } else {
+      for (int p = 0; p < 4; p++)
+        TryMode6(block, a, b, p & 1, p >> 1, best);
+    }
+  };
+  tryPBits(e0, e1);
+
+  static const float weights[16] = {
+      0 / 64.0f,  4 / 64.0f,  9 / 64.0f,  13 / 64.0f, 17 / 64.0f, 21 / 64.0f,
+      26 / 64.0f, 30 / 64.0f, 34 / 64.0f, 38 / 64.0f, 43 / 64.0f, 47 / 64.0f,
+      51 / 64.0f, 55 / 64.0f, 60 / 64.0f, 64 / 64.0f};
+  int iterations = quality == BCQuality::Fast     ? 0
+                   : quality == BCQuality::Normal ? 1
+                                                  : 3;
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    float previous = best.Error;
+    if (!RefineEndpoints(block, best.Indices, weights, e0, e1))
+      break;
+    tryPBits(e0, e1);
+    if (best.Error >= previous)
+      break;
+  }
+  return best;
+}
+
+void WriteMode6(Mode6Result result, uint8_t out[16]) {
+  // Anchor: pixel 0's index must have its top bit clear
+  if (result.Indices[0] >= 8) {
+    std::swap(result.Endpoint[0], result.Endpoint[1]);
+    std::swap(result.PBit[0], result.PBit[1]);
+    for (int i = 0; i < 16; i++)
+      result.Indices[i] = (uint8_t)(15 - result.Indices[i]);
+  }
+  memset(out, 0, 16);
+  BitStream bits = {out};
+  bits.Write(1u << 6, 7);
+  for (int c = 0; c < 4; c++) {
+    bits.Write(result.Endpoint[0][c], 7);
+    bits.Write(result.Endpoint[1][c], 7);
+  }
+  bits.Write(result.PBit[0], 1);
+  bits.Write(result.PBit[1], 1);
+  for (int i = 0; i < 16; i++)
+    bits.Write(result.Indices[i], i == 0 ? 3 : 4);
+}
+
+struct Mode5Result {
+  uint32_t Rotation = 0;
+  uint8_t Color[2][3] = {}; // 7 bits
+  uint8_t Alpha[2] = {};
+  uint8_t ColorIndices[16] = {};
+  uint8_t AlphaIndices[16] = {};
+  float Error = FLT_MAX;
+};
+
+int Expand7(int value) { return value << 1 | value >> 6; }
+
+float TryMode5Color(const Block &block, const float e0[4], const float e1[4],
+                    uint8_t color[2][3], uint8_t indices[16]) {
+  float palette[4][4] = {};
+  for (int c = 0; c < 3; c++) {
+    color[0][c] = (uint8_t)std::clamp(
+        (int)std::lround(e0[c] * 127.0f / 255.0f), 0, 127);
+    color[1][c] = (uint8_t)std::clamp(
+        (int)std::lround(e1[c] * 127.0f / 255.0f), 0, 127);
+    for (int k = 0; k < 4; k++)
+      palette[k][c] = (float)Interpolate(Expand7(color[0][c]),
+                                         Expand7(color[1][c]), Weights2[k]);
+  }
+  return SelectIndices(block, palette, 4, ColorWeights, indices);
+}
+
+float TryMode5Alpha(const Block &block, int a0, int a1, uint8_t indices[16]) {
+  float palette[4][4] = {};
+  for (int k = 0; k < 4; k++)
+    palette[k][3] = (float)Interpolate(a0, a1, Weights2[k]);
+  return SelectIndices(block, palette, 4, AlphaWeights, indices);
+}
+
+// Rotation r > 0 swaps channel r - 1 with alpha, giving that channel its
+// own indices
+Mode5Result FitMode5(const uint8_t pixels[64], uint32_t rotation) {
+  uint8_t rotated[64];
+  memcpy(rotated, pixels, 64);
+  if (rotation > 0) {
+    for (int i = 0; i < 16; i++)
+      std::swap(rotated[i * 4 + rotation - 1], rotated[i * 4 + 3]);
+  }
+  Block block;
+  LoadBlock(rotated, block);
+  static const float weights2[4] = {0.0f, 21 / 64.0f, 43 / 64.0f, 1.0f};
+
+  Mode5Result result;
+  result.Rotation = rotation;
+
+  // Color: principal axis, then least squares
+  float mean[4], axis[4], e0[4], e1[4];
+  FitAxis(block, ColorWeights, mean, axis);
+  AxisEndpoints(block, mean, axis, e0, e1);
+  float colorError =
+      TryMode5Color(block, e0, e1, result.Color, result.ColorIndices);
+  for (int iteration = 0; iteration < 2; iteration++) {
+    uint8_t color[2][3], indices[16];
+    if (!RefineEndpoints(block, result.ColorIndices, weights2, e0, e1))
+      break;
+    float error = TryMode5Color(block, e0, e1, color, indices);
+    if (error >= colorError)
+      break;
+    colorError = error;
+    memcpy(result.Color, color, sizeof(color));
+    memcpy(result.ColorIndices, indices, 16);
+  }
+
+  // Alpha: range, then least squares
+  int minimum = 255, maximum = 0;
+  for (int i = 0; i < 16; i++) {
+    minimum = std::min(minimum, (int)rotated[i * 4 + 3]);
+    maximum = std::max(maximum, (int)rotated[i * 4 + 3]);
+  }
+  result.Alpha[0] = (uint8_t)minimum;
+  result.Alpha[1] = (uint8_t)maximum;
+  float alphaError =
+      TryMode5Alpha(block, minimum, maximum, result.AlphaIndices);
+  for (int iteration = 0; iteration < 2 && minimum != maximum; iteration++) {
+    uint8_t indices[16];
+    if (!RefineEndpoints(block, result.AlphaIndices, weights2, e0, e1))
+      break;
+    int a0 = (int)std::lround(e0[3]), a1 = (int)std::lround(e1[3]);
+    float error = TryMode5Alpha(block, a0, a1, indices);
+    if (error >= alphaError)
+      break;
+    alphaError = error;
+    result.Alpha[0] = (uint8_t)a0;
+    result.Alpha[1] = (uint8_t)a1;
+    memcpy(result.AlphaIndices, indices, 16);
+  }
+  result.Error = colorError + alphaError;
+  return result;
+}
+
+void WriteMode5(Mode5Result result, uint8_t out[16]) {
+  if (result.ColorIndices[0] >= 2) {
+    std::swap(result.Color[0], result.Color[1]);
+    for (int i = 0; i < 16; i++)
+      result.ColorIndices[i] = (uint8_t)(3 - result.ColorIndices[i]);
+  }
+  if (result.AlphaIndices[0] >= 2) {
+    std::swap(result.Alpha[0], result.Alpha[1]);
+    for (int i = 0; i < 16; i++)
+      result.AlphaIndices[i] = (uint8_t)(3 - result.AlphaIndices[i]);
+  }
+  memset(out, 0, 16);
+  BitStream bits = {out};
+  bits.Write(1u << 5, 6);
+  bits.Write(result.Rotation, 2);
+  for (int c = 0; c < 3; c++) {
+    bits.Write(result.Color[0][c], 7);
+    bits.Write(result.Color[1][c], 7);
+  }
+  bits.Write(result.Alpha[0], 8);
+  bits.Write(result.Alpha[1], 8);
+  for (int i = 0; i < 16; i++)
+    bits.Write(result.ColorIndices[i], i == 0 ? 1 : 2);
+  for (int i = 0; i < 16; i++)
+    bits.Write(result.AlphaIndices[i], i == 0 ? 1 : 2);
+}
+
+} // namespace
+
+void EncodeBC1(const uint8_t pixels[64], uint8_t out[8], BCQuality quality) {
+  Block block;
+  LoadBlock(pixels, block);
+  bool threeColor = false, anyOpaque = false;
+  for (int i = 0; i < 16; i++) {
+    if (pixels[i * 4 + 3] < 128) {
+      block.Weight[i] = 0.0f;
+      threeColor = true;
+    } else {
+      anyOpaque = true;
+    }
+  }
+  if (!anyOpaque) {
+    static const uint8_t transparent[8] = {0, 0, 0, 0, 0xFF, 0xFF, 0xFF, 0xFF};
+    memcpy(out, transparent, 8);
+    return;
+  }
+  EncodeColorBlock(block, threeColor, quality, out);
+}
+
+void EncodeBC3(const uint8_t pixels[64], uint8_t out[16], BCQuality quality) {
+  EncodeBC4(pixels, 3, out, quality);
+  Block block;
+  LoadBlock(pixels, block);
+  EncodeColorBlock(block, false, quality, out + 8);
+}
+
+void EncodeBC4(const uint8_t pixels[64], uint32_t channel, uint8_t out[8],
+               BCQuality quality) {
+  int values[16];
+  for (int i = 0; i < 16; i++)
+    values[i] = pixels[i * 4 + channel];
+  EncodeBC4Values(values, quality, out);
+}
+
+void EncodeBC5(const uint8_t pixels[64], uint8_t out[16], BCQuality quality) {
+  EncodeBC4(pixels, 0, out, quality);
+  EncodeBC4(pixels, 1, out + 8, quality);
+}
+
+void EncodeBC7(const uint8_t pixels[64], uint8_t out[16], BCQuality quality) {
+  Block block;
+  LoadBlock(pixels, block);
+  Mode6Result mode6 = FitMode6(block, quality);
+  bool alphaVaries = false;
+  for (int i = 1; i < 16; i++)
+    alphaVaries |= pixels[i * 4 + 3] != pixels[3];
+  // Normal: mode 5 without rotation where alpha does not follow the color
+  // line; High: every rotation, opaque blocks included
+  uint32_t rotations = quality == BCQuality::High ? 4
+                       : quality == BCQuality::Normal && alphaVaries ? 1
+                                                                     : 0;
+  if (rotations > 0 && mode6.Error > 0.0f) {
+    Mode5Result mode5;
+    for (uint32_t rotation = 0; rotation < rotations; rotation++) {
+      Mode5Result candidate = FitMode5(pixels, rotation);
+      if (candidate.Error < mode5.Error)
+        mode5 = candidate;
+    }
+    if (mode5.Error < mode6.Error) {
+      WriteMode5(mode5, out);
+      return;
+    }
+  }
+  WriteMode6(mode6, out);
+}
+
+void DecodeBC1(const uint8_t block[8], uint8_t out[64]) {
+  DecodeColorBlock(block, true, out);
+}
+
+void DecodeBC3(const uint8_t block[16], uint8_t out[64]) {
+  DecodeColorBlock(block + 8, false, out);
+  DecodeBC4(block, 3, out);
+}
+
+void DecodeBC4(const uint8_t block[8], uint32_t channel, uint8_t out[64]) {
+  int palette[8];
+  BC4Palette(block[0], block[1], palette);
+  uint64_t bits = 0;
+  for (int b = 0; b < 6; b++)
+    bits |= (uint64_t)block[2 + b] << (b * 8);
+  for (int i = 0; i < 16; i++)
+    out[i * 4 + channel] = (uint8_t)palette[(bits >> (i * 3)) & 7];
+}
+
+void DecodeBC5(const uint8_t block[16], uint8_t out[64]) {
+  DecodeBC4(block, 0, out);
+  DecodeBC4(block + 8, 1, out);
+  for (int i = 0; i < 16; i++) {
+    out[i * 4 + 2] = 0;
+    out[i * 4 + 3] = 255;
+  }
+}
+
+void DecodeBC7(const uint8_t block[16], uint8_t out[64]) {
+  BitStream bits = {const_cast<uint8_t *>(block)};
+  int mode = 0;
+  while (mode < 8 && bits.Read(1) == 0)
+    mode++;
+
+  memset(out, 0, 64);
+  if (mode == 6) {
+    int endpoint[2][4];
+    for (int c = 0; c < 4; c++) {
+      endpoint[0][c] = (int)bits.Read(7) << 1;
+      endpoint[1][c] = (int)bits.Read(7) << 1;
+    }
+    for (int e = 0; e < 2; e++) {
+      int p = (int)bits.Read(1);
+      for (int c = 0; c < 4; c++)
+        endpoint[e][c] |= p;
+    }
+    for (int i = 0; i < 16; i++) {
+      int weight = Weights4[bits.Read(i == 0 ? 3 : 4)];
+      for (int c = 0; c < 4; c++)
+        out[i * 4 + c] =
+            (uint8_t)Interpolate(endpoint[0][c], endpoint[1][c], weight);
+    }
+  } else if (mode == 5) {
+    uint32_t rotation = bits.Read(2);
+    int color[2][3], alpha[2];
+    for (int c = 0; c < 3; c++) {
+      color[0][c] = Expand7((int)bits.Read(7));
+      color[1][c] = Expand7((int)bits.Read(7));
+    }
+    alpha[0] = (int)bits.Read(8);
+    alpha[1] = (int)bits.Read(8);
+    for (int i = 0; i < 16; i++) {
+      int weight = Weights2[bits.Read(i == 0 ? 1 : 2)];
+      for (int c = 0; c < 3; c++)
+        out[i * 4 + c] =
+            (uint8_t)Interpolate(color[0][c], color[1][c], weight);
+    }
+    for (int i = 0; i < 16; i++) {
+      int weight = Weights2[bits.Read(i == 0 ? 1 : 2)];
+      out[i * 4 + 3] = (uint8_t)Interpolate(alpha[0], alpha[1], weight);
+    }
+    if (rotation > 0) {
+      for (int i = 0; i < 16; i++)
+        std::swap(out[i * 4 + rotation - 1], out[i * 4 + 3]);
+    }
+  }
+}
+
+bool IsBlockCompressionSIMDAvailable() {
+#if defined(__AVX2__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace Forge
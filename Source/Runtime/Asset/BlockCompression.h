@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+
+namespace Forge {
+
+// BCn block encoders and decoders. A block is 4x4 RGBA8 pixels in row
+// order (64 bytes); edge blocks are padded by the caller. Encoders are
+// deterministic and thread-safe, so blocks can be encoded in any order on
+// any thread.
+//
+// Palette interpolation follows the D3D rules (BC1 thirds, BC4 sevenths /
+// fifths, BC7 6-bit weights), rounded to nearest.
+
+enum class BCQuality {
+  Fast,   // principal axis endpoints only
+  Normal, // + least-squares endpoint refinement
+  High,   // + more refinement, BC1/BC4 endpoint search, BC7 mode 5
+};
+
+// BC1: RGB 5:6:5 endpoints, 2-bit indices. Blocks with pixels below half
+// alpha use the 3-color mode with transparent black (punch-through alpha).
+void EncodeBC1(const uint8_t pixels[64], uint8_t out[8], BCQuality quality);
+// BC3: BC4 alpha + BC1 color (always 4-color)
+void EncodeBC3(const uint8_t pixels[64], uint8_t out[16], BCQuality quality);
+// BC4: one channel (0..3) of the pixels
+void EncodeBC4(const uint8_t pixels[64], uint32_t channel, uint8_t out[8],
+               BCQuality quality);
+// BC5: red and green as two BC4 blocks (normal map XY)
+void EncodeBC5(const uint8_t pixels[64], uint8_t out[16], BCQuality quality);
+// BC7: mode 6 (RGBA 7.7.7.7 + p-bit, 4-bit indices; opaque blocks keep
+// alpha 255). Normal also tries mode 5 (RGB 7.7.7 + separate 8-bit alpha)
+// on blocks with varying alpha, High tries it with every channel rotation;
+// the better mode is kept. Partitioned modes are not used.
+void EncodeBC7(const uint8_t pixels[64], uint8_t out[16], BCQuality quality);
+
+// Decoders write 64 bytes of RGBA8. BC4 fills only `channel`; BC5 writes
+// R and G with B = 0, A = 255. BC7 decodes modes 5 and 6 (the ones
+// EncodeBC7 writes); other modes decode to zero.
+void DecodeBC1(const uint8_t block[8], uint8_t out[64]);
+void DecodeBC3(const uint8_t block[16], uint8_t out[64]);
+void DecodeBC4(const uint8_t block[8], uint32_t channel, uint8_t out[64]);
+void DecodeBC5(const uint8_t block[16], uint8_t out[64]);
+void DecodeBC7(const uint8_t block[16], uint8_t out[64]);
+
+// True when the index search runs 8 pixels at a time (AVX2 build)
+bool IsBlockCompressionSIMDAvailable();
+
+} // namespace Forge
@@ -0,0 +1,333 @@
+#include "MeshCooker.h"
+#include "MeshFile.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Forge {
+
+namespace {
+
+// Meshes smaller than this are not simplified further
+constexpr size_t MinLODTriangles = 16;
+
+uint16_t QuantizeUNorm16(float value, float offset, float scale) {
+  float unorm = scale > 0.0f ? (value - offset) / scale : 0.0f;
+  return (uint16_t)std::lround(std::clamp(unorm, 0.0f, 1.0f) * 65535.0f);
+}
+
+int8_t QuantizeSNorm8(float value) {
+  return (int8_t)std::lround(std::clamp(value, -1.0f, 1.0f) * 127.0f);
+}
+
+uint64_t AlignOffset(uint64_t offset) {
+  return (offset + MeshFileAlignment - 1) & ~(uint64_t)(MeshFileAlignment - 1);
+}
+
+} // namespace
+
+bool CookMesh(const ImportedMesh &mesh, const MeshCookSettings &settings,
+              std::vector<uint8_t> &outFile, MeshCookStats *outStats,
+              std::string &outError) {
+  const uint32_t vertexCount = mesh.GetVertexCount();
+  if (vertexCount == 0 || mesh.Normals.size() != vertexCount * 3 ||
+      mesh.UVs.size() != vertexCount * 2) {
+    outError = "mesh has no vertices or mismatched attribute arrays";
+    return false;
+  }
+  if (settings.MeshletMaxVertices < 3 || settings.MeshletMaxVertices > 256 ||
+      settings.MeshletMaxTriangles < 1 || settings.MeshletMaxTriangles > 65535) {
+    outError = "meshlet limits out of range";
+    return false;
+  }
+  const float *positions = mesh.Positions.data();
+
+  // Valid, non-degenerate triangles only
+  std::vector<uint32_t> lod0;
+  lod0.reserve(mesh.Indices.size());
+  for (size_t t = 0; t + 2 < mesh.Indices.size(); t += 3) {
+    uint32_t a = mesh.Indices[t], b = mesh.Indices[t + 1],
+             c = mesh.Indices[t + 2];
+    if (a >= vertexCount || b >= vertexCount || c >= vertexCount) {
+      outError = "index out of range";
+      return false;
+    }
+    if (a != b && b != c && a != c)
+      lod0.insert(lod0.end(), {a, b, c});
+  }
+  if (lod0.empty()) {
+    outError = "no non-degenerate triangles";
+    return false;
+  }
+
+  MeshCookStats stats;
+  stats.ACMRBefore =
+      AnalyzeVertexCache(lod0.data(), lod0.size(), vertexCount).ACMR;
+  if (settings.Analyze) {
+    stats.OverdrawBefore =
+        AnalyzeOverdraw(lod0.data(), lod0.size(), positions, vertexCount)
+            .Overdraw;
+  }
+
+  float boundsMin[3], boundsMax[3];
+  for (int c = 0; c < 3; c++) {
+    boundsMin[c] = boundsMax[c] = positions[lod0[0] * 3 + c];
+  }
+  for (uint32_t index : lod0) {
+    for (int c = 0; c < 3; c++) {
+      boundsMin[c] = std::min(boundsMin[c], positions[index * 3 + c]);
+      boundsMax[c] = std::max(boundsMax[c], positions[index * 3 + c]);
+    }
+  }
+  float diagonal = std::sqrt((boundsMax[0] - boundsMin[0]) *
+                                 (boundsMax[0] - boundsMin[0]) +
+                             (boundsMax[1] - boundsMin[1]) *
+                                 (boundsMax[1] - boundsMin[1]) +
+                             (boundsMax[2] - boundsMin[2]) *
+                                 (boundsMax[2] - boundsMin[2]));
+
+  auto optimize = [&](std::vector<uint32_t> &indices) {
+    OptimizeVertexCache(indices.data(), indices.size(), vertexCount);
+    if (settings.OptimizeOverdraw) {
+      OptimizeOverdraw(indices.data(), indices.size(), positions, vertexCount,
+                       settings.OverdrawThreshold);
+    }
+  };
+
+  // 1. LOD chain: each level simplified from the previous one
+  std::vector<std::vector<uint32_t>> lods;
+  std::vector<float> lodErrors;
+  optimize(lod0);
+  lods.push_back(std::move(lod0));
+  lodErrors.push_back(0.0f);
+  const uint32_t maxLODs = std::clamp(settings.MaxLODs, 1u, MaxMeshLODs);
+  while (lods.size() < maxLODs) {
+    const std::vector<uint32_t> &previous = lods.back();
+    size_t target = (size_t)(previous.size() / 3 * settings.LODReduction) * 3;
+    // Errors add up along the chain, so each level gets what is left
+    const float budget = settings.LODMaxError * diagonal - lodErrors.back();
+    if (target / 3 < MinLODTriangles || budget <= 0.0f)
+      break;
+    std::vector<uint32_t> simplified(previous.size());
+    float error = 0.0f;
+    size_t count =
+        SimplifyMesh(simplified.data(), previous.data(), previous.size(),
+                     positions, vertexCount, target, budget, &error);
+    // Stuck on locked borders / the error limit: no useful level left
+    if (count == 0 || count > previous.size() * 9 / 10)
+      break;
+    simplified.resize(count);
+    optimize(simplified);
+    lods.push_back(std::move(simplified));
+    lodErrors.push_back(lodErrors.back() + error);
+  }
+
+  // 2. One index buffer for all LODs, vertices in first-use order
+  std::vector<uint32_t> indices;
+  std::vector<uint32_t> firstIndex;
+  for (const std::vector<uint32_t> &lod : lods) {
+    firstIndex.push_back((uint32_t)indices.size());
+    indices.insert(indices.end(), lod.begin(), lod.end());
+  }
+  std::vector<uint32_t> remap;
+  const uint32_t usedVertices = OptimizeVertexFetch(
+      indices.data(), indices.size(), vertexCount, remap);
+  std::vector<float> remappedPositions(usedVertices * 3);
+  std::vector<uint32_t> source(usedVertices);
+  for (uint32_t v = 0; v < vertexCount; v++) {
+    if (remap[v] == ~0u)
+      continue;
+    source[remap[v]] = v;
+    std::copy(positions + v * 3, positions + v * 3 + 3,
+              remappedPositions.data() + remap[v] * 3);
+  }
+  stats.ACMRAfter =
+      AnalyzeVertexCache(indices.data(), lods[0].size(), usedVertices).ACMR;
+  if (settings.Analyze) {
+    stats.OverdrawAfter = AnalyzeOverdraw(indices.data(), lods[0].size(),
+                                          remappedPositions.data(),
+                                          usedVertices)
+                              .Overdraw;
+  }
+
+  // 3. Quantize
+  MeshFileHeader header = {};
+  header.Magic = MeshFileMagic;
+  header.Version = MeshFileVersion;
+  header.VertexCount = usedVertices;
+  header.VertexStride = sizeof(MeshFileVertex);
+  header.IndexSize = usedVertices <= 0xFFFF ? 2 : 4;
+  header.LODCount = (uint32_t)lods.size();
+  header.MeshletMaxVertices = settings.MeshletMaxVertices;
+  header.MeshletMaxTriangles = settings.MeshletMaxTriangles;
+  float uvMin[2] = {mesh.UVs[source[0] * 2], mesh.UVs[source[0] * 2 + 1]};
+  float uvMax[2] = {uvMin[0], uvMin[1]};
+  for (uint32_t v : source) {
+    for (int c = 0; c < 2; c++) {
+      uvMin[c] = std::min(uvMin[c], mesh.UVs[v * 2 + c]);
+      uvMax[c] = std::max(uvMax[c], mesh.UVs[v * 2 + c]);
+    }
+  }
+  for (int c = 0; c < 3; c++) {
+    header.BoundsMin[c] = boundsMin[c];
+    header.BoundsMax[c] = boundsMax[c];
+    header.PositionOffset[c] = boundsMin[c];
+    header.PositionScale[c] = boundsMax[c] - boundsMin[c];
+  }
+  for (int c = 0; c < 2; c++) {
+    header.UVOffset[c] = uvMin[c];
+    header.UVScale[c] = uvMax[c] - uvMin[c];
+  }
+
+  std::vector<MeshFileVertex> vertices(usedVertices);
+  for (uint32_t i = 0; i < usedVertices; i++) {
+    const uint32_t v = source[i];
+    MeshFileVertex &vertex = vertices[i];
+    float error = 0.0f;
+    for (int c = 0; c < 3; c++) {
+      float value = positions[v * 3 + c];
+      vertex.Position[c] = QuantizeUNorm16(value, header.PositionOffset[c],
+                                           header.PositionScale[c]);
+      float decoded = header.PositionOffset[c] +
+                      vertex.Position[c] / 65535.0f * header.PositionScale[c];
+      error += (decoded - value) * (decoded - value);
+    }
+    vertex.Position[3] = 0;
+    stats.MaxPositionError = std::max(stats.MaxPositionError, std::sqrt(error));
+
+    const float *normal = &mesh.Normals[v * 3];
+    float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] +
+                             normal[2] * normal[2]);
+    for (int c = 0; c < 3; c++)
+      vertex.Normal[c] =
+          QuantizeSNorm8(length > 0.0f ? normal[c] / length : 0.0f);
+    vertex.Normal[3] = 0;
+    for (int c = 0; c < 2; c++)
+      vertex.UV[c] = QuantizeUNorm16(mesh.UVs[v * 2 + c], header.UVOffset[c],
+                                     header.UVScale[c]);
+  }
+
+  // 4. Meshlets per LOD
+  std::vector<MeshFileLOD> lodTable(lods.size());
+  std::vector<Meshlet> meshlets;
+  std::vector<uint32_t> meshletVertices;
+  std::vector<uint8_t> meshletTriangles;
+  for (size_t lod = 0; lod < lods.size(); lod++) {
+    MeshFileLOD &entry = lodTable[lod];
+    entry = {};
+    entry.FirstIndex = firstIndex[lod];
+    entry.IndexCount = (uint32_t)lods[lod].size();
+    entry.FirstMeshlet = (uint32_t)meshlets.size();
+    entry.GeometricError = lodErrors[lod];
+    BuildMeshlets(indices.data() + entry.FirstIndex, entry.IndexCount,
+                  remappedPositions.data(), usedVertices,
+                  settings.MeshletMaxVertices, settings.MeshletMaxTriangles,
+                  meshlets, meshletVertices, meshletTriangles);
+    entry.MeshletCount = (uint32_t)meshlets.size() - entry.FirstMeshlet;
+    stats.LODTriangles[lod] = entry.IndexCount / 3;
+    stats.LODErrors[lod] = entry.GeometricError;
+  }
+  std::vector<MeshFileMeshlet> meshletTable(meshlets.size());
+  for (size_t i = 0; i < meshlets.size(); i++) {
+    const Meshlet &built = meshlets[i];
+    MeshFileMeshlet &meshlet = meshletTable[i];
+    meshlet = {};
+    meshlet.VertexOffset = built.VertexOffset;
+    meshlet.TriangleOffset = built.TriangleOffset;
+    meshlet.VertexCount = (uint16_t)built.VertexCount;
+    meshlet.TriangleCount = (uint16_t)built.TriangleCount;
+    std::copy(built.Center, built.Center + 3, meshlet.Center);
+    // Quantized vertices may move by up to MaxPositionError
+    meshlet.Radius = built.Radius + stats.MaxPositionError;
+    for (int c = 0; c < 3; c++)
+      meshlet.ConeAxis[c] = QuantizeSNorm8(built.ConeAxis[c]);
+    // Rounded up: a larger cutoff only culls less
+    meshlet.ConeCutoff =
+        (int8_t)std::min(127.0f, std::ceil(built.ConeCutoff * 127.0f));
+  }
+  header.MeshletCount = (uint32_t)meshletTable.size();
+
+  // 5. Layout
+  uint64_t offset = AlignOffset(sizeof(MeshFileHeader));
+  auto place = [&](uint64_t bytes, uint64_t &outOffset) {
+    outOffset = offset;
+    offset = AlignOffset(offset + bytes);
+  };
+  header.VertexBytes = vertices.size() * sizeof(MeshFileVertex);
+  place(header.VertexBytes, header.VertexOffset);
+  header.IndexBytes = indices.size() * header.IndexSize;
+  place(header.IndexBytes, header.IndexOffset);
+  place(lodTable.size() * sizeof(MeshFileLOD), header.LODOffset);
+  place(meshletTable.size() * sizeof(MeshFileMeshlet), header.MeshletOffset);
+  header.MeshletVertexBytes = meshletVertices.size() * sizeof(uint32_t);
+  place(header.MeshletVertexBytes, header.MeshletVertexOffset);
+  header.MeshletTriangleBytes = meshletTriangles.size();
+  place(header.MeshletTriangleBytes, header.MeshletTriangleOffset);
+  header.FileSize = offset;
+
+  outFile.assign(offset, 0);
+  auto write = [&](uint64_t at, const void *data, size_t bytes) {
+    if (bytes)
+      std::memcpy(outFile.data() + at, data, bytes);
+  };
+  write(0, &header, sizeof(header));
+  write(header.VertexOffset, vertices.data(), header.VertexBytes);
+  if (header.IndexSize == 2) {
+    std::vector<uint16_t> narrow(indices.begin(), indices.end());
+    write(header.IndexOffset, narrow.data(), header.IndexBytes);
+  } else {
+    write(header.IndexOffset, indices.data(), header.IndexBytes);
+  }
+  write(header.LODOffset, lodTable.data(),
+        lodTable.size() * sizeof(MeshFileLOD));
+  write(header.MeshletOffset, meshletTable.data(),
+        meshletTable.size() * sizeof(MeshFileMeshlet));
+  write(header.MeshletVertexOffset, meshletVertices.data(),
+        header.MeshletVertexBytes);
+  write(header.MeshletTriangleOffset, meshletTriangles.data(),
+        header.MeshletTriangleBytes);
+
+  stats.Vertices = usedVertices;
+  stats.LODs = header.LODCount;
+  stats.Meshlets = header.MeshletCount;
+  stats.Bytes = header.FileSize;
+  if (outStats)
+    *outStats = stats;
+  return true;
+}
+
+bool CookMeshFile(const std::string &inputPath, const std::string &outputPath,
+                  const MeshCookSettings &settings, MeshCookStats *outStats,
+                  std::string &outError) {
+  ImportedMesh mesh;
+  if (!ImportMesh(inputPath, mesh, outError))
+    return false;
+  std::vector<uint8_t> cooked;
+  if (!CookMesh(mesh, settings, cooked, outStats, outError))
+    return false;
+
+  std::error_code ec;
+  std::filesystem::path output(outputPath);
+  if (output.has_parent_path())
+    std::filesystem::create_directories(output.parent_path(), ec);
+  std::string temp = outputPath + ".tmp";
+  {
+    std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+    if (!file ||
+        !file.write((const char *)cooked.data(), (std::streamsize)cooked.size())) {
+      outError = "cannot write " + temp;
+      return false;
+    }
+  }
+  std::filesystem::rename(temp, outputPath, ec);
+  if (ec) {
+    outError = "cannot replace " + outputPath + ": " + ec.message();
+    return false;
+  }
+  return true;
+}
+
+} // namespace Forge
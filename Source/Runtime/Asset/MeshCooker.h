@@ -0,0 +1,50 @@
+#pragma once
+#include "MeshImporter.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Forge {
+
+struct MeshCookSettings {
+  bool OptimizeOverdraw = true;
+  // ACMR may grow by this factor when clusters are reordered for overdraw
+  float OverdrawThreshold = 1.05f;
+  uint32_t MaxLODs = 4;      // including LOD 0, at most MaxMeshLODs
+  float LODReduction = 0.5f; // triangle ratio between consecutive LODs
+  // Largest simplification error, as a fraction of the bounding box
+  // diagonal; LOD generation stops once it is reached
+  float LODMaxError = 0.02f;
+  uint32_t MeshletMaxVertices = 64; // at most 256
+  uint32_t MeshletMaxTriangles = 124;
+  bool Analyze = false; // fill the overdraw statistics (slower)
+};
+
+static constexpr uint32_t MaxMeshLODs = 8;
+
+struct MeshCookStats {
+  uint32_t Vertices = 0; // after optimization (unused ones dropped)
+  uint32_t LODs = 0;
+  uint32_t LODTriangles[MaxMeshLODs] = {};
+  float LODErrors[MaxMeshLODs] = {};
+  uint32_t Meshlets = 0;
+  float ACMRBefore = 0.0f, ACMRAfter = 0.0f; // LOD 0, 16-entry FIFO
+  float OverdrawBefore = 0.0f, OverdrawAfter = 0.0f; // with Analyze
+  float MaxPositionError = 0.0f; // quantization, object space
+  uint64_t Bytes = 0;
+};
+
+// Import-independent part: optimizes, simplifies, quantizes and builds
+// meshlets, then serializes the .fmesh image (see MeshFile.h).
+// Deterministic: the same input and settings give the same bytes.
+bool CookMesh(const ImportedMesh &mesh, const MeshCookSettings &settings,
+              std::vector<uint8_t> &outFile, MeshCookStats *outStats,
+              std::string &outError);
+
+// Import + cook + write (via a temporary file and rename, so readers never
+// map a half-written mesh)
+bool CookMeshFile(const std::string &inputPath, const std::string &outputPath,
+                  const MeshCookSettings &settings, MeshCookStats *outStats,
+                  std::string &outError);
+
+} // namespace Forge
@@ -0,0 +1,122 @@
+#include "MeshFile.h"
+#include <algorithm>
+#include <iostream>
+
+namespace Forge {
+
+bool MeshFile::Open(const std::string &path) {
+  if (!m_File.Open(path)) {
+    std::cerr << "[MeshFile] Cannot map " << path << std::endl;
+    return false;
+  }
+  std::string error;
+  if (!Validate(m_File.GetData(), m_File.GetSize(), &error)) {
+    std::cerr << "[MeshFile] " << path << ": " << error << std::endl;
+    m_File.Close();
+    return false;
+  }
+  return true;
+}
+
+bool MeshFile::Validate(const uint8_t *data, size_t size,
+                        std::string *error) {
+  auto fail = [&](const char *message) {
+    if (error)
+      *error = message;
+    return false;
+  };
+  if (!data || size < sizeof(MeshFileHeader))
+    return fail("truncated header");
+  const MeshFileHeader &header =
+      *reinterpret_cast<const MeshFileHeader *>(data);
+  if (header.Magic != MeshFileMagic)
+    return fail("not a cooked mesh");
+  if (header.Version != MeshFileVersion)
+    return fail("unsupported version (re-cook the source mesh)");
+  if (header.FileSize != size)
+    return fail("file size does not match the header");
+  if (header.VertexStride != sizeof(MeshFileVertex) ||
+      (header.IndexSize != 2 && header.IndexSize != 4))
+    return fail("unsupported vertex or index format");
+  if (header.LODCount == 0)
+    return fail("no LODs");
+
+  // Every section aligned and inside the file
+  auto inside = [&](uint64_t offset, uint64_t bytes) {
+    return offset % MeshFileAlignment == 0 && offset <= size &&
+           bytes <= size - offset;
+  };
+  if (!inside(header.VertexOffset, header.VertexBytes) ||
+      header.VertexBytes != (uint64_t)header.VertexCount * sizeof(MeshFileVertex) ||
+      !inside(header.IndexOffset, header.IndexBytes) ||
+      header.IndexBytes % header.IndexSize != 0 ||
+      !inside(header.LODOffset, (uint64_t)header.LODCount * sizeof(MeshFileLOD)) ||
+      !inside(header.MeshletOffset,
+              (uint64_t)header.MeshletCount * sizeof(MeshFileMeshlet)) ||
+      !inside(header.MeshletVertexOffset, header.MeshletVertexBytes) ||
+      !inside(header.MeshletTriangleOffset, header.MeshletTriangleBytes))
+    return fail("section out of range");
+
+  // LOD and meshlet ranges, so consumers can index without checks
+  const uint64_t indexCount = header.IndexBytes / header.IndexSize;
+  const MeshFileLOD *lods =
+      reinterpret_cast<const MeshFileLOD *>(data + header.LODOffset);
+  for (uint32_t i = 0; i < header.LODCount; i++) {
+    if ((uint64_t)lods[i].FirstIndex + lods[i].IndexCount > indexCount ||
+        lods[i].IndexCount % 3 != 0 ||
+        (uint64_t)lods[i].FirstMeshlet + lods[i].MeshletCount >
+            header.MeshletCount)
+      return fail("LOD range out of bounds");
+  }
+  const MeshFileMeshlet *meshlets =
+      reinterpret_cast<const MeshFileMeshlet *>(data + header.MeshletOffset);
+  for (uint32_t i = 0; i < header.MeshletCount; i++) {
+    const MeshFileMeshlet &meshlet = meshlets[i];
+    if (meshlet.VertexCount > header.MeshletMaxVertices ||
+        meshlet.TriangleCount > header.MeshletMaxTriangles ||
+        ((uint64_t)meshlet.VertexOffset + meshlet.VertexCount) *
+                sizeof(uint32_t) >
+            header.MeshletVertexBytes ||
+        (uint64_t)meshlet.TriangleOffset + meshlet.TriangleCount * 3u >
+            header.MeshletTriangleBytes)
+      return fail("meshlet range out of bounds");
+  }
+  return true;
+}
+
+uint32_t MeshFile::GetIndex(uint32_t i) const {
+  return GetHeader().IndexSize == 2
+             ? static_cast<const uint16_t *>(GetIndices())[i]
+             : static_cast<const uint32_t *>(GetIndices())[i];
+}
+
+const RHIInputElement *MeshFile::GetInputLayout(uint32_t &outCount) {
+  static const RHIInputElement layout[] = {
+      {"POSITION", 0, RHIFormat::RGBA16_UNorm, 0, 0},
+      {"NORMAL", 0, RHIFormat::RGBA8_SNorm, 0, 8},
+      {"TEXCOORD", 0, RHIFormat::RG16_UNorm, 0, 12},
+  };
+  outCount = sizeof(layout) / sizeof(layout[0]);
+  return layout;
+}
+
+void MeshFile::DecodePosition(const MeshFileVertex &vertex,
+                              float out[3]) const {
+  const MeshFileHeader &header = GetHeader();
+  for (int c = 0; c < 3; c++)
+    out[c] = header.PositionOffset[c] +
+             vertex.Position[c] / 65535.0f * header.PositionScale[c];
+}
+
+void MeshFile::DecodeNormal(const MeshFileVertex &vertex, float out[3]) {
+  for (int c = 0; c < 3; c++)
+    out[c] = std::max(vertex.Normal[c] / 127.0f, -1.0f);
+}
+
+void MeshFile::DecodeUV(const MeshFileVertex &vertex, float out[2]) const {
+  const MeshFileHeader &header = GetHeader();
+  for (int c = 0; c < 2; c++)
+    out[c] = header.UVOffset[c] + vertex.UV[c] / 65535.0f * header.UVScale[c];
+}
+
+} // namespace Forge
@@ -0,0 +1,136 @@
+#pragma once
+#include "../Core/MappedFile.h"
+#include "../RHI/RHI.h"
+#include <cstdint>
+#include <string>
+
+namespace Forge {
+
+// Cooked mesh file (.fmesh), written by MeshCooker. Little-endian, every
+// section 16-byte aligned and in GPU layout, so a mapped file is uploaded
+// and drawn as is:
+//   header | vertices | indices (all LODs) | LOD table | meshlets |
+//   meshlet vertices (uint32) | meshlet triangles (3 x uint8, padded)
+static constexpr uint32_t MeshFileMagic = 0x48534D46; // "FMSH"
+static constexpr uint32_t MeshFileVersion = 1;
+static constexpr uint32_t MeshFileAlignment = 16;
+
+// 16 bytes. Position is UNORM16 over the mesh bounds (w unused),
+// normal SNORM8 (w unused), UV UNORM16 over the mesh's UV range.
+struct MeshFileVertex {
+  uint16_t Position[4];
+  int8_t Normal[4];
+  uint16_t UV[2];
+};
+
+struct MeshFileLOD {
+  uint32_t FirstIndex;
+  uint32_t IndexCount;
+  uint32_t FirstMeshlet;
+  uint32_t MeshletCount;
+  float GeometricError; // object space, for LODSelector chains
+  uint32_t Reserved[3];
+};
+
+// Up to MaxVertices / MaxTriangles; triangles index the meshlet's vertex
+// list, which indexes the vertex buffer
+struct MeshFileMeshlet {
+  uint32_t VertexOffset;   // into the meshlet vertex section
+  uint32_t TriangleOffset; // into the meshlet triangle section, in bytes
+  uint16_t VertexCount;
+  uint16_t TriangleCount;
+  float Center[3]; // bounding sphere, object space
+  float Radius;
+  int8_t ConeAxis[3]; // normal cone for backface culling, SNORM8
+  int8_t ConeCutoff;  // see Meshlet::ConeCutoff, SNORM8; 127 = unusable
+};
+
+struct MeshFileHeader {
+  uint32_t Magic;
+  uint32_t Version;
+  uint32_t VertexCount;
+  uint32_t VertexStride; // sizeof(MeshFileVertex)
+  uint32_t IndexSize;    // 2 or 4 bytes
+  uint32_t LODCount;
+  uint32_t MeshletCount;
+  uint32_t MeshletMaxVertices;
+  uint32_t MeshletMaxTriangles;
+  uint32_t Reserved;
+  // Dequantization: value = offset + unorm * scale
+  float PositionOffset[3];
+  float PositionScale[3];
+  float UVOffset[2];
+  float UVScale[2];
+  float BoundsMin[3];
+  float BoundsMax[3];
+  // Byte ranges from the start of the file
+  uint64_t VertexOffset, VertexBytes;
+  uint64_t IndexOffset, IndexBytes;
+  uint64_t LODOffset;
+  uint64_t MeshletOffset;
+  uint64_t MeshletVertexOffset, MeshletVertexBytes;
+  uint64_t MeshletTriangleOffset, MeshletTriangleBytes;
+  uint64_t FileSize;
+};
+
+// The layout is the file format
+static_assert(sizeof(MeshFileVertex) == 16, "MeshFileVertex layout");
+static_assert(sizeof(MeshFileLOD) == 32, "MeshFileLOD layout");
+static_assert(sizeof(MeshFileMeshlet) == 32, "MeshFileMeshlet layout");
+static_assert(sizeof(MeshFileHeader) == 192, "MeshFileHeader layout");
+
+// Read-only view of a cooked mesh. Open maps the file and validates the
+// header and every section range; the accessors point into the mapping.
+class MeshFile {
+public:
+  bool Open(const std::string &path);
+  void Close() { m_File.Close(); }
+  bool IsOpen() const { return m_File.IsOpen(); }
+
+  // Checks a cooked mesh already in memory; error explains a failure
+  static bool Validate(const uint8_t *data, size_t size, std::string *error);
+
+  const MeshFileHeader &GetHeader() const {
+    return *reinterpret_cast<const MeshFileHeader *>(m_File.GetData());
+  }
+  const MeshFileVertex *GetVertices() const {
+    return Section<MeshFileVertex>(GetHeader().VertexOffset);
+  }
+  const void *GetIndices() const {
+    return Section<uint8_t>(GetHeader().IndexOffset);
+  }
+  const MeshFileLOD *GetLODs() const {
+    return Section<MeshFileLOD>(GetHeader().LODOffset);
+  }
+  const MeshFileMeshlet *GetMeshlets() const {
+    return Section<MeshFileMeshlet>(GetHeader().MeshletOffset);
+  }
+  const uint32_t *GetMeshletVertices() const {
+    return Section<uint32_t>(GetHeader().MeshletVertexOffset);
+  }
+  const uint8_t *GetMeshletTriangles() const {
+    return Section<uint8_t>(GetHeader().MeshletTriangleOffset);
+  }
+  uint32_t GetIndex(uint32_t i) const;
+
+  // Vertex buffer layout (slot 0) and index buffer format
+  static const RHIInputElement *GetInputLayout(uint32_t &outCount);
+  RHIFormat GetIndexFormat() const {
+    return GetHeader().IndexSize == 2 ? RHIFormat::R16_UInt
+                                      : RHIFormat::R32_UInt;
+  }
+
+  // Dequantized attributes, for tools and CPU-side consumers
+  void DecodePosition(const MeshFileVertex &vertex, float out[3]) const;
+  static void DecodeNormal(const MeshFileVertex &vertex, float out[3]);
+  void DecodeUV(const MeshFileVertex &vertex, float out[2]) const;
+
+private:
+  template <typename T> const T *Section(uint64_t offset) const {
+    return reinterpret_cast<const T *>(m_File.GetData() + offset);
+  }
+
+  MappedFile m_File;
+};
+
+} // namespace Forge
@@ -0,0 +1,230 @@
+#include "MeshImporter.h"
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace Forge {
+
+namespace {
+
+struct OBJVertexKey {
+  int32_t Position, UV, Normal; // 0-based, -1 = absent
+
+  bool operator==(const OBJVertexKey &other) const {
+    return Position == other.Position && UV == other.UV &&
+           Normal == other.Normal;
+  }
+};
+
+struct OBJVertexKeyHash {
+  size_t operator()(const OBJVertexKey &key) const {
+    uint64_t hash = (uint64_t)(uint32_t)key.Position * 0x9E3779B97F4A7C15ull;
+    hash ^= (uint64_t)(uint32_t)key.UV * 0xC2B2AE3D27D4EB4Full + (hash >> 29);
+    hash ^= (uint64_t)(uint32_t)key.Normal * 0x165667B19E3779F9ull +
+            (hash >> 32);
+    return (size_t)hash;
+  }
+};
+
+const char *SkipSpaces(const char *p) {
+  while (*p == ' ' || *p == '\t')
+    p++;
+  return p;
+}
+
+// OBJ indices are 1-based; negative ones count back from the end
+bool ResolveIndex(long index, size_t count, int32_t &out) {
+  if (index > 0 && (size_t)index <= count)
+    out = (int32_t)(index - 1);
+  else if (index < 0 && (size_t)-index <= count)
+    out = (int32_t)(count + index);
+  else
+    return false;
+  return true;
+}
+
+} // namespace
+
+bool ImportMesh(const std::string &path, ImportedMesh &outMesh,
+                std::string &outError) {
+  std::string extension = std::filesystem::path(path).extension().string();
+  for (char &c : extension)
+    c = (char)std::tolower((unsigned char)c);
+  if (extension == ".fbx") {
+    outError = "FBX import is not supported (no FBX SDK); export as OBJ";
+    return false;
+  }
+  if (extension != ".obj") {
+    outError = "unknown mesh format '" + extension + "'";
+    return false;
+  }
+
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    outError = "cannot open file";
+    return false;
+  }
+  std::stringstream text;
+  text << file.rdbuf();
+  return ImportOBJ(text.str(), outMesh, outError);
+}
+
+bool ImportOBJ(const std::string &text, ImportedMesh &outMesh,
+               std::string &outError) {
+  outMesh = {};
+  std::vector<float> positions, uvs, normals;
+  std::unordered_map<OBJVertexKey, uint32_t, OBJVertexKeyHash> vertexMap;
+  std::vector<uint32_t> polygon;
+  bool missingNormals = false;
+
+  size_t lineNumber = 0;
+  const char *p = text.c_str();
+  while (*p) {
+    lineNumber++;
+    const char *line = SkipSpaces(p);
+    const char *lineEnd = std::strchr(line, '\n');
+    if (!lineEnd)
+      lineEnd = line + std::strlen(line);
+    p = *lineEnd ? lineEnd + 1 : lineEnd;
+
+    auto readFloats = [&](const char *cursor, int count,
+                          std::vector<float> &out) {
+      for (int i = 0; i < count; i++) {
+        char *end = nullptr;
+        float value = std::strtof(cursor, &end);
+        if (end == cursor || end > lineEnd)
+          return false;
+        out.push_back(value);
+        cursor = end;
+      }
+      return true;
+    };
+    auto error = [&](const char *message) {
+      outError = "line " + std::to_string(lineNumber) + ": " + message;
+      return false;
+    };
+
+    if (line[0] == 'v' && line[1] == ' ') {
+      if (!readFloats(line + 2, 3, positions))
+        return error("bad vertex position");
+    } else if (line[0] == 'v' && line[1] == 't' && line[2] == ' ') {
+      if (!readFloats(line + 3, 2, uvs))
+        return error("bad texture coordinate");
+    } else if (line[0] == 'v' && line[1] == 'n' && line[2] == ' ') {
+      if (!readFloats(line + 3, 3, normals))
+        return error("bad vertex normal");
+    } else if (line[0] == 'f' && line[1] == ' ') {
+      // v, v/vt, v//vn or v/vt/vn per corner
+      polygon.clear();
+      const char *cursor = SkipSpaces(line + 2);
+      while (cursor < lineEnd && *cursor != '\r' && *cursor != '\n') {
+        long values[3] = {0, 0, 0};
+        for (int part = 0; part < 3; part++) {
+          char *end = nullptr;
+          values[part] = std::strtol(cursor, &end, 10);
+          cursor = end;
+          if (*cursor != '/')
+            break;
+          cursor++;
+        }
+        OBJVertexKey key = {-1, -1, -1};
+        if (!ResolveIndex(values[0], positions.size() / 3, key.Position) ||
+            (values[1] != 0 &&
+             !ResolveIndex(values[1], uvs.size() / 2, key.UV)) ||
+            (values[2] != 0 &&
+             !ResolveIndex(values[2], normals.size() / 3, key.Normal)))
+          return error("face index out of range");
+        missingNormals |= key.Normal < 0;
+
+        auto [it, inserted] =
+            vertexMap.try_emplace(key, (uint32_t)vertexMap.size());
+        if (inserted) {
+          const float *position = &positions[key.Position * 3];
+          outMesh.Positions.insert(outMesh.Positions.end(),
+                                   {position[0], position[1], position[2]});
+          if (key.UV >= 0)
+            outMesh.UVs.insert(outMesh.UVs.end(),
+                               {uvs[key.UV * 2], uvs[key.UV * 2 + 1]});
+          else
+            outMesh.UVs.insert(outMesh.UVs.end(), {0.0f, 0.0f});
+          if (key.Normal >= 0) {
+            const float *normal = &normals[key.Normal * 3];
+            outMesh.Normals.insert(outMesh.Normals.end(),
+                                   {normal[0], normal[1], normal[2]});
+          } else {
+            outMesh.Normals.insert(outMesh.Normals.end(), {0.0f, 0.0f, 0.0f});
+          }
+        }
+        polygon.push_back(it->second);
+        cursor = SkipSpaces(cursor);
+      }
+      if (polygon.size() < 3)
+        return error("face with fewer than 3 vertices");
+      for (size_t i = 1; i + 1 < polygon.size(); i++)
+        outMesh.Indices.insert(outMesh.Indices.end(),
+                               {polygon[0], polygon[i], polygon[i + 1]});
+    }
+    // Groups, objects, materials, smoothing groups and comments are ignored
+  }
+
+  if (outMesh.Indices.empty()) {
+    outError = "no faces";
+    return false;
+  }
+  if (missingNormals)
+    GenerateNormals(outMesh);
+  return true;
+}
+
+void GenerateNormals(ImportedMesh &mesh) {
+  // Accumulate per position, so UV seams do not show up as shading seams
+  struct PositionHash {
+    size_t operator()(const std::array<uint32_t, 3> &bits) const {
+      return (size_t)(bits[0] * 73856093u ^ bits[1] * 19349663u ^
+                      bits[2] * 83492791u);
+    }
+  };
+  const uint32_t vertexCount = mesh.GetVertexCount();
+  std::unordered_map<std::array<uint32_t, 3>, uint32_t, PositionHash> welded;
+  std::vector<uint32_t> positionIndex(vertexCount);
+  for (uint32_t i = 0; i < vertexCount; i++) {
+    std::array<uint32_t, 3> bits;
+    std::memcpy(bits.data(), &mesh.Positions[i * 3], sizeof(bits));
+    positionIndex[i] = welded.try_emplace(bits, i).first->second;
+  }
+
+  std::vector<float> accumulated(vertexCount * 3, 0.0f);
+  for (size_t t = 0; t + 2 < mesh.Indices.size(); t += 3) {
+    const float *a = &mesh.Positions[mesh.Indices[t] * 3];
+    const float *b = &mesh.Positions[mesh.Indices[t + 1] * 3];
+    const float *c = &mesh.Positions[mesh.Indices[t + 2] * 3];
+    float e0[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    float e1[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    // Cross product length = 2 x area: larger faces weigh more
+    float n[3] = {e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2],
+                  e0[0] * e1[1] - e0[1] * e1[0]};
+    for (int corner = 0; corner < 3; corner++) {
+      float *sum = &accumulated[positionIndex[mesh.Indices[t + corner]] * 3];
+      for (int axis = 0; axis < 3; axis++)
+        sum[axis] += n[axis];
+    }
+  }
+
+  mesh.Normals.resize(vertexCount * 3);
+  for (uint32_t i = 0; i < vertexCount; i++) {
+    const float *sum = &accumulated[positionIndex[i] * 3];
+    float length = std::sqrt(sum[0] * sum[0] + sum[1] * sum[1] +
+                             sum[2] * sum[2]);
+    for (int axis = 0; axis < 3; axis++)
+      mesh.Normals[i * 3 + axis] =
+          length > 0.0f ? sum[axis] / length : (axis == 1 ? 1.0f : 0.0f);
+  }
+}
+
+} // namespace Forge
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Forge {
+
+// Indexed triangle mesh with unique (position, normal, UV) vertices, as
+// produced by an importer and consumed by MeshCooker
+struct ImportedMesh {
+  std::vector<float> Positions; // float3 per vertex
+  std::vector<float> Normals;   // float3 per vertex
+  std::vector<float> UVs;       // float2 per vertex
+  std::vector<uint32_t> Indices;
+
+  uint32_t GetVertexCount() const { return (uint32_t)Positions.size() / 3; }
+};
+
+// Source formats by extension. Wavefront OBJ (all groups merged into one
+// mesh, polygons fan-triangulated, missing normals generated). FBX needs
+// the vendor SDK and is rejected with a hint to export OBJ instead.
+bool ImportMesh(const std::string &path, ImportedMesh &outMesh,
+                std::string &outError);
+bool ImportOBJ(const std::string &text, ImportedMesh &outMesh,
+               std::string &outError);
+
+// Area-weighted vertex normals from the triangles
+void GenerateNormals(ImportedMesh &mesh);
+
+} // namespace Forge
@@ -0,0 +1,720 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+
+namespace Forge {
+
+namespace {
+
+struct Vec3 {
+  float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+
+Vec3 Load(const float *positions, uint32_t index) {
+  const float *p = positions + index * 3;
+  return {p[0], p[1], p[2]};
+}
+
+Vec3 Sub(const Vec3 &a, const Vec3 &b) {
+  return {a.X - b.X, a.Y - b.Y, a.Z - b.Z};
+}
+
+Vec3 Cross(const Vec3 &a, const Vec3 &b) {
+  return {a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z,
+          a.X * b.Y - a.Y * b.X};
+}
+
+float Dot(const Vec3 &a, const Vec3 &b) {
+  return a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+}
+
+float Length(const Vec3 &a) { return std::sqrt(Dot(a, a)); }
+
+// Twice the area, pointing along the front-face normal
+Vec3 TriangleNormal(const float *positions, const uint32_t *triangle) {
+  Vec3 a = Load(positions, triangle[0]);
+  return Cross(Sub(Load(positions, triangle[1]), a),
+               Sub(Load(positions, triangle[2]), a));
+}
+
+// Vertex -> triangle lists (CSR)
+struct Adjacency {
+  std::vector<uint32_t> Offsets; // vertexCount + 1
+  std::vector<uint32_t> Triangles;
+
+  void Build(const uint32_t *indices, size_t indexCount,
+             uint32_t vertexCount) {
+    Offsets.assign(vertexCount + 1, 0);
+    for (size_t i = 0; i < indexCount; i++)
+      Offsets[indices[i] + 1]++;
+    for (uint32_t v = 0; v < vertexCount; v++)
+      Offsets[v + 1] += Offsets[v];
+    Triangles.resize(indexCount);
+    std::vector<uint32_t> cursor(Offsets.begin(), Offsets.end() - 1);
+    for (size_t i = 0; i < indexCount; i++)
+      Triangles[cursor[indices[i]]++] = (uint32_t)(i / 3);
+  }
+};
+
+} // namespace
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t *indices, size_t indexCount,
+                                    uint32_t vertexCount, uint32_t cacheSize) {
+  VertexCacheStats stats;
+  if (indexCount == 0)
+    return stats;
+  // Insertion stamps: a vertex is cached while fewer than cacheSize misses
+  // happened since it was inserted
+  std::vector<uint64_t> inserted(vertexCount, 0);
+  uint64_t misses = 0;
+  for (size_t i = 0; i < indexCount; i++) {
+    uint32_t v = indices[i];
+    if (inserted[v] == 0 || misses - inserted[v] >= cacheSize) {
+      misses++;
+      inserted[v] = misses;
+    }
+  }
+  size_t usedCount = 0;
+  for (uint64_t stamp : inserted)
+    usedCount += stamp != 0 ? 1 : 0;
+  stats.ACMR = (float)misses / (float)(indexCount / 3);
+  stats.ATVR = usedCount ? (float)misses / (float)usedCount : 0.0f;
+  return stats;
+}
+
+OverdrawStats AnalyzeOverdraw(const uint32_t *indices, size_t indexCount,
+                              const float *positions, uint32_t vertexCount) {
+  constexpr int Resolution = 256;
+  OverdrawStats stats;
+  if (indexCount == 0 || vertexCount == 0)
+    return stats;
+
+  Vec3 minimum = Load(positions, 0), maximum = minimum;
+  for (uint32_t v = 1; v < vertexCount; v++) {
+    Vec3 p = Load(positions, v);
+    minimum = {std::min(minimum.X, p.X), std::min(minimum.Y, p.Y),
+               std::min(minimum.Z, p.Z)};
+    maximum = {std::max(maximum.X, p.X), std::max(maximum.Y, p.Y),
+               std::max(maximum.Z, p.Z)};
+  }
+  float extent = std::max({maximum.X - minimum.X, maximum.Y - minimum.Y,
+                           maximum.Z - minimum.Z, 1e-6f});
+
+  std::vector<float> depth(Resolution * Resolution);
+  std::vector<uint8_t> covered(Resolution * Resolution);
+  for (int view = 0; view < 6; view++) {
+    // Orthographic view along +-X/Y/Z; (u, v) on screen, depth away
+    const int axis = view >> 1;
+    const float sign = (view & 1) ? -1.0f : 1.0f;
+    auto project = [&](uint32_t index, float out[3]) {
+      Vec3 p = Sub(Load(positions, index), minimum);
+      float coords[3] = {p.X / extent, p.Y / extent, p.Z / extent};
+      // (axis + 2, axis + 1) on screen: a triangle whose TriangleNormal
+      // faces the viewer then has positive screen area
+      out[0] = coords[(axis + 2) % 3] * (Resolution - 1);
+      out[1] = coords[(axis + 1) % 3] * (Resolution - 1);
+      out[2] = sign > 0 ? coords[axis] : 1.0f - coords[axis];
+      if (sign < 0) // mirror so both views of an axis see front faces CCW
+        out[0] = (Resolution - 1) - out[0];
+    };
+    std::fill(depth.begin(), depth.end(), 2.0f);
+    std::fill(covered.begin(), covered.end(), 0);
+
+    for (size_t t = 0; t + 2 < indexCount; t += 3) {
+      float a[3], b[3], c[3];
+      project(indices[t], a);
+      project(indices[t + 1], b);
+      project(indices[t + 2], c);
+      float area = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+      if (area <= 0.0f)
+        continue; // back face or degenerate
+      int x0 = std::max((int)std::floor(std::min({a[0], b[0], c[0]})), 0);
+      int x1 = std::min((int)std::ceil(std::max({a[0], b[0], c[0]})),
+                        Resolution - 1);
+      int y0 = std::max((int)std::floor(std::min({a[1], b[1], c[1]})), 0);
+      int y1 = std::min((int)std::ceil(std::max({a[1], b[1], c[1]})),
+                        Resolution - 1);
+      for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+          float px = x + 0.5f, py = y + 0.5f;
+          float w0 = (c[0] - b[0]) * (py - b[1]) - (c[1] - b[1]) * (px - b[0]);
+          float w1 = (a[0] - c[0]) * (py - c[1]) - (a[1] - c[1]) * (px - c[0]);
+          float w2 = (b[0] - a[0]) * (py - a[1]) - (b[1] - a[1]) * (px - a[0]);
+          if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+            continue;
+          float z = (w0 * a[2] + w1 * b[2] + w2 * c[2]) / area;
+          int pixel = y * Resolution + x;
+          if (!covered[pixel]) {
+            covered[pixel] = 1;
+            stats.Covered++;
+          }
+          if (z < depth[pixel]) {
+            depth[pixel] = z;
+            stats.Shaded++;
+          }
+        }
+      }
+    }
+  }
+  stats.Overdraw =
+      stats.Covered ? (float)stats.Shaded / (float)stats.Covered : 0.0f;
+  return stats;
+}
+
+void OptimizeVertexCache(uint32_t *indices, size_t indexCount,
+                         uint32_t vertexCount) {
+  constexpr int CacheSize = 32;
+  constexpr int MaxValence = 32; // score table size; larger valences clamp
+  const uint32_t triangleCount = (uint32_t)(indexCount / 3);
+  if (triangleCount == 0)
+    return;
+
+  // Score tables (Forsyth's constants)
+  float cacheScores[CacheSize];
+  for (int i = 0; i < CacheSize; i++) {
+    cacheScores[i] =
+        i < 3 ? 0.75f
+              : std::pow(1.0f - (float)(i - 3) / (CacheSize - 3), 1.5f);
+  }
+  float valenceScores[MaxValence + 1];
+  valenceScores[0] = 0.0f;
+  for (int i = 1; i <= MaxValence; i++)
+    valenceScores[i] = 2.0f / std::sqrt((float)i);
+
+  Adjacency adjacency;
+  adjacency.Build(indices, indexCount, vertexCount);
+  std::vector<uint32_t> liveCount(vertexCount);
+  for (uint32_t v = 0; v < vertexCount; v++)
+    liveCount[v] = adjacency.Offsets[v + 1] - adjacency.Offsets[v];
+
+  std::vector<int32_t> cachePosition(vertexCount, -1);
+  std::vector<float> vertexScore(vertexCount);
+  auto scoreVertex = [&](uint32_t v) {
+    if (liveCount[v] == 0)
+      return -1.0f;
+    float score = cachePosition[v] >= 0 ? cacheScores[cachePosition[v]] : 0.0f;
+    return score + valenceScores[std::min<uint32_t>(liveCount[v], MaxValence)];
+  };
+  for (uint32_t v = 0; v < vertexCount; v++)
+    vertexScore[v] = scoreVertex(v);
+
+  std::vector<float> triangleScore(triangleCount);
+  std::vector<uint8_t> emitted(triangleCount, 0);
+  for (uint32_t t = 0; t < triangleCount; t++) {
+    triangleScore[t] = vertexScore[indices[t * 3]] +
+                       vertexScore[indices[t * 3 + 1]] +
+                       vertexScore[indices[t * 3 + 2]];
+  }
+
+  std::vector<uint32_t> output;
+  output.reserve(indexCount);
+  uint32_t cache[CacheSize + 3];
+  int cacheCount = 0;
+  uint32_t scanCursor = 0;
+
+  uint32_t best = 0;
+  for (uint32_t t = 1; t < triangleCount; t++)
+    best = triangleScore[t] > triangleScore[best] ? t : best;
+
+  for (uint32_t step = 0; step < triangleCount; step++) {
+    if (best == ~0u) {
+      // Dead end: next triangle in input order
+      while (emitted[scanCursor])
+        scanCursor++;
+      best = scanCursor;
+    }
+    const uint32_t *triangle = indices + best * 3;
+    output.insert(output.end(), triangle, triangle + 3);
+    emitted[best] = 1;
+
+    // Drop the triangle from its vertices' live lists
+    for (int corner = 0; corner < 3; corner++) {
+      uint32_t v = triangle[corner];
+      uint32_t *begin = adjacency.Triangles.data() + adjacency.Offsets[v];
+      uint32_t *end = begin + liveCount[v];
+      *std::find(begin, end, best) = end[-1];
+      liveCount[v]--;
+    }
+
+    // New cache: the triangle's vertices in front, then the old order
+    uint32_t next[CacheSize + 3];
+    int nextCount = 0;
+    for (int corner = 0; corner < 3; corner++) {
+      if (std::find(next, next + nextCount, triangle[corner]) ==
+          next + nextCount)
+        next[nextCount++] = triangle[corner];
+    }
+    for (int i = 0; i < cacheCount; i++) {
+      if (std::find(next, next + nextCount, cache[i]) == next + nextCount)
+        next[nextCount++] = cache[i];
+    }
+    for (int i = 0; i < nextCount; i++)
+      cachePosition[next[i]] = i < CacheSize ? i : -1;
+    cacheCount = std::min(nextCount, CacheSize);
+    for (int i = 0; i < cacheCount; i++)
+      cache[i] = next[i];
+
+    // Rescore what changed and pick the best triangle around the cache
+    best = ~0u;
+    float bestScore = -1.0f;
+    for (int i = 0; i < nextCount; i++) {
+      uint32_t v = next[i];
+      vertexScore[v] = scoreVertex(v);
+    }
+    for (int i = 0; i < nextCount; i++) {
+      uint32_t v = next[i];
+      const uint32_t *live = adjacency.Triangles.data() + adjacency.Offsets[v];
+      for (uint32_t j = 0; j < liveCount[v]; j++) {
+        uint32_t t = live[j];
+        float score = vertexScore[indices[t * 3]] +
+                      vertexScore[indices[t * 3 + 1]] +
+                      vertexScore[indices[t * 3 + 2]];
+        triangleScore[t] = score;
+        if (score > bestScore || (score == bestScore && t < best)) {
+          bestScore = score;
+          best = t;
+        }
+      }
+    }
+  }
+  std::copy(output.begin(), output.end(), indices);
+}
+
+void OptimizeOverdraw(uint32_t *indices, size_t indexCount,
+                      const float *positions, uint32_t vertexCount,
+                      float threshold) {
+  constexpr uint32_t CacheSize = 16;
+  const uint32_t triangleCount = (uint32_t)(indexCount / 3);
+  if (triangleCount < 2)
+    return;
+
+  // Cache misses of a triangle range simulated from a cold cache
+  std::vector<uint64_t> inserted(vertexCount, 0);
+  uint64_t stampBase = 0, misses = 0;
+  auto resetCache = [&]() {
+    stampBase += misses + CacheSize + 1;
+    misses = 0;
+  };
+  auto countMisses = [&](uint32_t t) {
+    uint32_t triangleMisses = 0;
+    for (int corner = 0; corner < 3; corner++) {
+      uint32_t v = indices[t * 3 + corner];
+      uint64_t now = stampBase + misses;
+      if (inserted[v] <= stampBase || now - inserted[v] >= CacheSize) {
+        misses++;
+        inserted[v] = stampBase + misses;
+        triangleMisses++;
+      }
+    }
+    return triangleMisses;
+  };
+
+  // Hard boundaries: the cache optimizer restarted (all three vertices
+  // missed)
+  std::vector<uint32_t> hard = {0};
+  resetCache();
+  for (uint32_t t = 0; t < triangleCount; t++) {
+    if (countMisses(t) == 3 && t > 0)
+      hard.push_back(t);
+  }
+  hard.push_back(triangleCount);
+
+  // Soft boundaries: split a hard cluster wherever the part so far, drawn
+  // from a cold cache, stays within threshold x the cluster's ACMR
+  std::vector<uint32_t> clusters;
+  for (size_t h = 0; h + 1 < hard.size(); h++) {
+    uint32_t begin = hard[h], end = hard[h + 1];
+    resetCache();
+    for (uint32_t t = begin; t < end; t++)
+      countMisses(t);
+    float clusterACMR = (float)misses / (float)(end - begin);
+
+    uint32_t start = begin;
+    resetCache();
+    for (uint32_t t = begin; t < end; t++) {
+      countMisses(t);
+      uint32_t count = t + 1 - start;
+      if (t + 1 < end &&
+          (float)misses / (float)count <= clusterACMR * threshold) {
+        clusters.push_back(start);
+        start = t + 1;
+        resetCache();
+      }
+    }
+    clusters.push_back(start);
+  }
+  clusters.push_back(triangleCount);
+
+  // Sort key: how far the cluster faces out from the mesh center
+  Vec3 meshCenter;
+  float meshArea = 0.0f;
+  std::vector<Vec3> clusterCenter(clusters.size() - 1);
+  std::vector<Vec3> clusterNormal(clusters.size() - 1);
+  for (size_t c = 0; c + 1 < clusters.size(); c++) {
+    Vec3 center, normal;
+    float area = 0.0f;
+    for (uint32_t t = clusters[c]; t < clusters[c + 1]; t++) {
+      const uint32_t *triangle = indices + t * 3;
+      Vec3 n = TriangleNormal(positions, triangle);
+      float weight = Length(n);
+      Vec3 a = Load(positions, triangle[0]), b = Load(positions, triangle[1]),
+           d = Load(positions, triangle[2]);
+      center.X += (a.X + b.X + d.X) * weight;
+      center.Y += (a.Y + b.Y + d.Y) * weight;
+      center.Z += (a.Z + b.Z + d.Z) * weight;
+      normal.X += n.X;
+      normal.Y += n.Y;
+      normal.Z += n.Z;
+      area += weight;
+    }
+    meshCenter.X += center.X;
+    meshCenter.Y += center.Y;
+    meshCenter.Z += center.Z;
+    meshArea += area;
+    float inverse = area > 0.0f ? 1.0f / (3.0f * area) : 0.0f;
+    clusterCenter[c] = {center.X * inverse, center.Y * inverse,
+                        center.Z * inverse};
+    float length = Length(normal);
+    clusterNormal[c] = length > 0.0f
+                           ? Vec3{normal.X / length, normal.Y / length,
+                                  normal.Z / length}
+                           : Vec3{};
+  }
+  float inverse = meshArea > 0.0f ? 1.0f / (3.0f * meshArea) : 0.0f;
+  meshCenter = {meshCenter.X * inverse, meshCenter.Y * inverse,
+                meshCenter.Z * inverse};
+
+  std::vector<float> sortKey(clusters.size() - 1);
+  for (size_t c = 0; c < sortKey.size(); c++)
+    sortKey[c] = Dot(Sub(clusterCenter[c], meshCenter), clusterNormal[c]);
+  std::vector<uint32_t> order(sortKey.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return sortKey[a] > sortKey[b];
+  });
+
+  std::vector<uint32_t> output;
+  output.reserve(indexCount);
+  for (uint32_t c : order) {
+    output.insert(output.end(), indices + clusters[c] * 3,
+                  indices + clusters[c + 1] * 3);
+  }
+  std::copy(output.begin(), output.end(), indices);
+}
+
+uint32_t OptimizeVertexFetch(uint32_t *indices, size_t indexCount,
+                             uint32_t vertexCount,
+                             std::vector<uint32_t> &outRemap) {
+  outRemap.assign(vertexCount, ~0u);
+  uint32_t next = 0;
+  for (size_t i = 0; i < indexCount; i++) {
+    uint32_t &remapped = outRemap[indices[i]];
+    if (remapped == ~0u)
+      remapped = next++;
+    indices[i] = remapped;
+  }
+  return next;
+}
+
+namespace {
+
+// Symmetric 4x4 error quadric (plane equations summed, area weighted)
+struct Quadric {
+  double A2 = 0, AB = 0, AC = 0, AD = 0, B2 = 0, BC = 0, BD = 0, C2 = 0,
+         CD = 0, D2 = 0;
+  double Weight = 0;
+
+  void AddPlane(double a, double b, double c, double d, double weight) {
+    A2 += weight * a * a;
+    AB += weight * a * b;
+    AC += weight * a * c;
+    AD += weight * a * d;
+    B2 += weight * b * b;
+    BC += weight * b * c;
+    BD += weight * b * d;
+    C2 += weight * c * c;
+    CD += weight * c * d;
+    D2 += weight * d * d;
+    Weight += weight;
+  }
+  void Add(const Quadric &q) {
+    A2 += q.A2;
+    AB += q.AB;
+    AC += q.AC;
+    AD += q.AD;
+    B2 += q.B2;
+    BC += q.BC;
+    BD += q.BD;
+    C2 += q.C2;
+    CD += q.CD;
+    D2 += q.D2;
+    Weight += q.Weight;
+  }
+  // Weighted mean squared distance of p to the planes
+  double Error(const Vec3 &p) const {
+    double x = p.X, y = p.Y, z = p.Z;
+    double error = A2 * x * x + B2 * y * y + C2 * z * z + 2 * AB * x * y +
+                   2 * AC * x * z + 2 * BC * y * z + 2 * AD * x + 2 * BD * y +
+                   2 * CD * z + D2;
+    return Weight > 0 ? std::max(error, 0.0) / Weight : 0.0;
+  }
+};
+
+} // namespace
+
+size_t SimplifyMesh(uint32_t *outIndices, const uint32_t *indices,
+                    size_t indexCount, const float *positions,
+                    uint32_t vertexCount, size_t targetIndexCount,
+                    float maxError, float *outError) {
+  std::vector<uint32_t> current(indices, indices + indexCount);
+  float resultError = 0.0f;
+
+  std::vector<Quadric> quadrics(vertexCount);
+  for (size_t t = 0; t + 2 < indexCount; t += 3) {
+    Vec3 n = TriangleNormal(positions, indices + t);
+    float length = Length(n);
+    if (length <= 0.0f)
+      continue;
+    Vec3 p = Load(positions, indices[t]);
+    double a = n.X / length, b = n.Y / length, c = n.Z / length;
+    double d = -(a * p.X + b * p.Y + c * p.Z);
+    for (int corner = 0; corner < 3; corner++)
+      quadrics[indices[t + corner]].AddPlane(a, b, c, d, 0.5 * length);
+  }
+
+  // Locked: vertices on an open edge (mesh border or attribute seam) or a
+  // non-manifold one
+  std::vector<uint8_t> locked(vertexCount, 0);
+  {
+    std::unordered_map<uint64_t, uint32_t> edges;
+    edges.reserve(indexCount);
+    for (size_t t = 0; t + 2 < indexCount; t += 3) {
+      for (int e = 0; e < 3; e++) {
+        uint64_t a = indices[t + e], b = indices[t + (e + 1) % 3];
+        edges[(a << 32) | b]++;
+      }
+    }
+    for (const auto &[key, count] : edges) {
+      uint64_t a = key >> 32, b = key & 0xffffffffu;
+      auto opposite = edges.find((b << 32) | a);
+      if (count != 1 || opposite == edges.end() || opposite->second != 1) {
+        locked[a] = 1;
+        locked[b] = 1;
+      }
+    }
+  }
+
+  std::vector<uint32_t> remap(vertexCount);
+  std::iota(remap.begin(), remap.end(), 0u);
+  std::vector<uint8_t> touched(vertexCount);
+  Adjacency adjacency;
+  struct Collapse {
+    double Cost;
+    uint32_t From, To;
+  };
+  std::vector<Collapse> collapses;
+  const double maxCost = (double)maxError * maxError;
+
+  while (current.size() > targetIndexCount) {
+    adjacency.Build(current.data(), current.size(), vertexCount);
+
+    collapses.clear();
+    for (size_t t = 0; t + 2 < current.size(); t += 3) {
+      for (int e = 0; e < 3; e++) {
+        uint32_t a = current[t + e], b = current[t + (e + 1) % 3];
+        for (int direction = 0; direction < 2; direction++) {
+          uint32_t from = direction ? b : a, to = direction ? a : b;
+          if (locked[from])
+            continue;
+          Quadric q = quadrics[from];
+          q.Add(quadrics[to]);
+          double cost = q.Error(Load(positions, to));
+          if (cost <= maxCost)
+            collapses.push_back({cost, from, to});
+        }
+      }
+    }
+    if (collapses.empty())
+      break;
+    std::sort(collapses.begin(), collapses.end(),
+              [](const Collapse &a, const Collapse &b) {
+                if (a.Cost != b.Cost)
+                  return a.Cost < b.Cost;
+                return a.From != b.From ? a.From < b.From : a.To < b.To;
+              });
+
+    // Independent collapses, cheapest first, until the target is reached
+    std::fill(touched.begin(), touched.end(), 0);
+    size_t trianglesLeft = current.size() / 3;
+    const size_t targetTriangles = targetIndexCount / 3;
+    size_t applied = 0;
+    for (const Collapse &collapse : collapses) {
+      if (trianglesLeft <= targetTriangles)
+        break;
+      const uint32_t from = collapse.From, to = collapse.To;
+      if (touched[from] || touched[to])
+        continue;
+
+      // Triangles around 'from' that survive must not flip
+      const uint32_t *begin =
+          adjacency.Triangles.data() + adjacency.Offsets[from];
+      const uint32_t *end =
+          adjacency.Triangles.data() + adjacency.Offsets[from + 1];
+      bool valid = true;
+      uint32_t removed = 0;
+      for (const uint32_t *t = begin; t != end && valid; t++) {
+        const uint32_t *triangle = current.data() + *t * 3;
+        if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+          removed++;
+          continue;
+        }
+        uint32_t moved[3];
+        for (int corner = 0; corner < 3; corner++)
+          moved[corner] = triangle[corner] == from ? to : triangle[corner];
+        Vec3 before = TriangleNormal(positions, triangle);
+        Vec3 after = TriangleNormal(positions, moved);
+        valid = Dot(before, after) > 0.25f * Length(before) * Length(after);
+      }
+      if (!valid || removed == 0)
+        continue;
+
+      remap[from] = to;
+      quadrics[to].Add(quadrics[from]);
+      for (const uint32_t *t = begin; t != end; t++) {
+        for (int corner = 0; corner < 3; corner++)
+          touched[current[*t * 3 + corner]] = 1;
+      }
+      trianglesLeft -= removed;
+      resultError = std::max(resultError, (float)std::sqrt(collapse.Cost));
+      applied++;
+    }
+    if (applied == 0)
+      break;
+
+    // Apply and drop the collapsed (degenerate) triangles
+    size_t write = 0;
+    for (size_t t = 0; t + 2 < current.size(); t += 3) {
+      uint32_t a = remap[current[t]], b = remap[current[t + 1]],
+               c = remap[current[t + 2]];
+      if (a == b || b == c || a == c)
+        continue;
+      current[write++] = a;
+      current[write++] = b;
+      current[write++] = c;
+    }
+    current.resize(write);
+  }
+
+  if (outError)
+    *outError = resultError;
+  std::copy(current.begin(), current.end(), outIndices);
+  return current.size();
+}
+
+void BuildMeshlets(const uint32_t *indices, size_t indexCount,
+                   const float *positions, uint32_t vertexCount,
+                   uint32_t maxVertices, uint32_t maxTriangles,
+                   std::vector<Meshlet> &outMeshlets,
+                   std::vector<uint32_t> &outVertices,
+                   std::vector<uint8_t> &outTriangles) {
+  // Local slot of each vertex in the open meshlet, valid while the stamp
+  // matches
+  std::vector<uint32_t> slotStamp(vertexCount, 0);
+  std::vector<uint8_t> slot(vertexCount, 0);
+  uint32_t stamp = 1;
+  Meshlet meshlet;
+  meshlet.VertexOffset = (uint32_t)outVertices.size();
+  meshlet.TriangleOffset = (uint32_t)outTriangles.size();
+
+  auto finish = [&]() {
+    if (meshlet.TriangleCount == 0)
+      return;
+    // Bounding sphere around the AABB center
+    const uint32_t *vertices = outVertices.data() + meshlet.VertexOffset;
+    Vec3 minimum = Load(positions, vertices[0]), maximum = minimum;
+    for (uint32_t i = 1; i < meshlet.VertexCount; i++) {
+      Vec3 p = Load(positions, vertices[i]);
+      minimum = {std::min(minimum.X, p.X), std::min(minimum.Y, p.Y),
+                 std::min(minimum.Z, p.Z)};
+      maximum = {std::max(maximum.X, p.X), std::max(maximum.Y, p.Y),
+                 std::max(maximum.Z, p.Z)};
+    }
+    Vec3 center = {(minimum.X + maximum.X) * 0.5f,
+                   (minimum.Y + maximum.Y) * 0.5f,
+                   (minimum.Z + maximum.Z) * 0.5f};
+    float radius = 0.0f;
+    for (uint32_t i = 0; i < meshlet.VertexCount; i++)
+      radius = std::max(radius,
+                        Length(Sub(Load(positions, vertices[i]), center)));
+    meshlet.Center[0] = center.X;
+    meshlet.Center[1] = center.Y;
+    meshlet.Center[2] = center.Z;
+    meshlet.Radius = radius;
+
+    // Normal cone: average normal, widest deviation from it
+    const uint8_t *triangles = outTriangles.data() + meshlet.TriangleOffset;
+    std::vector<Vec3> normals(meshlet.TriangleCount);
+    Vec3 axis;
+    for (uint32_t t = 0; t < meshlet.TriangleCount; t++) {
+      uint32_t triangle[3] = {vertices[triangles[t * 3]],
+                              vertices[triangles[t * 3 + 1]],
+                              vertices[triangles[t * 3 + 2]]};
+      Vec3 n = TriangleNormal(positions, triangle);
+      float length = Length(n);
+      normals[t] = length > 0.0f
+                       ? Vec3{n.X / length, n.Y / length, n.Z / length}
+                       : Vec3{};
+      axis = {axis.X + normals[t].X, axis.Y + normals[t].Y,
+              axis.Z + normals[t].Z};
+    }
+    float axisLength = Length(axis);
+    meshlet.ConeCutoff = 1.0f;
+    if (axisLength > 0.0f) {
+      axis = {axis.X / axisLength, axis.Y / axisLength, axis.Z / axisLength};
+      float minDot = 1.0f;
+      for (const Vec3 &n : normals)
+        minDot = std::min(minDot, Dot(n, axis));
+      meshlet.ConeAxis[0] = axis.X;
+      meshlet.ConeAxis[1] = axis.Y;
+      meshlet.ConeAxis[2] = axis.Z;
+      // Back-facing from every direction within 90 - spread of the axis
+      if (minDot > 0.0f)
+        meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+
+    outMeshlets.push_back(meshlet);
+    meshlet = {};
+    meshlet.VertexOffset = (uint32_t)outVertices.size();
+    meshlet.TriangleOffset = (uint32_t)outTriangles.size();
+    stamp++;
+  };
+
+  for (size_t t = 0; t + 2 < indexCount; t += 3) {
+    uint32_t newVertices = 0;
+    for (int corner = 0; corner < 3; corner++) {
+      uint32_t v = indices[t + corner];
+      bool duplicate = (corner > 0 && indices[t] == v) ||
+                       (corner > 1 && indices[t + 1] == v);
+      newVertices += (slotStamp[v] != stamp && !duplicate) ? 1 : 0;
+    }
+    if (meshlet.VertexCount + newVertices > maxVertices ||
+        meshlet.TriangleCount + 1 > maxTriangles)
+      finish();
+
+    for (int corner = 0; corner < 3; corner++) {
+      uint32_t v = indices[t + corner];
+      if (slotStamp[v] != stamp) {
+        slotStamp[v] = stamp;
+        slot[v] = (uint8_t)meshlet.VertexCount++;
+        outVertices.push_back(v);
+      }
+      outTriangles.push_back(slot[v]);
+    }
+    meshlet.TriangleCount++;
+  }
+  finish();
+}
+
+} // namespace Forge
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Forge {
+
+// Index-buffer optimization, simplification and meshlet building for
+// indexed triangle lists (positions: float3 per vertex). Everything is
+// deterministic so cooked files are reproducible.
+
+struct VertexCacheStats {
+  float ACMR = 0.0f; // post-transform cache misses per triangle (0.5..3)
+  float ATVR = 0.0f; // misses per vertex (1 = each vertex transformed once)
+};
+
+struct OverdrawStats {
+  uint64_t Covered = 0; // pixels covered, summed over the views
+  uint64_t Shaded = 0;  // pixels that passed the depth test
+  float Overdraw = 0.0f; // Shaded / Covered (1 = none)
+};
+
+// FIFO cache of cacheSize entries, like the post-transform caches of
+// current GPUs
+VertexCacheStats AnalyzeVertexCache(const uint32_t *indices, size_t indexCount,
+                                    uint32_t vertexCount,
+                                    uint32_t cacheSize = 16);
+// Rasterizes the mesh in index order from the six axis directions (back
+// faces culled, depth test on)
+OverdrawStats AnalyzeOverdraw(const uint32_t *indices, size_t indexCount,
+                              const float *positions, uint32_t vertexCount);
+
+// Reorders triangles for the post-transform cache (Forsyth, "Linear-Speed
+// Vertex Cache Optimisation")
+void OptimizeVertexCache(uint32_t *indices, size_t indexCount,
+                         uint32_t vertexCount);
+
+// Reorders clusters of a cache-optimized list so outward-facing ones draw
+// first (Sander et al., "Fast Triangle Reordering for Vertex Locality and
+// Reduced Overdraw"). Clusters may split where their ACMR stays within
+// threshold x the original one.
+void OptimizeOverdraw(uint32_t *indices, size_t indexCount,
+                      const float *positions, uint32_t vertexCount,
+                      float threshold);
+
+// Vertex order = first use in the index list. Rewrites the indices and
+// fills outRemap[old] = new (~0u for unused vertices); returns the number
+// of used vertices.
+uint32_t OptimizeVertexFetch(uint32_t *indices, size_t indexCount,
+                             uint32_t vertexCount,
+                             std::vector<uint32_t> &outRemap);
+
+// Quadric-error edge collapse down to targetIndexCount, never moving
+// border / seam vertices and never flipping a triangle. maxError bounds
+// the collapse error (object-space distance); the largest one taken is
+// returned in outError. Returns the new index count (into outIndices,
+// which must hold indexCount entries).
+size_t SimplifyMesh(uint32_t *outIndices, const uint32_t *indices,
+                    size_t indexCount, const float *positions,
+                    uint32_t vertexCount, size_t targetIndexCount,
+                    float maxError, float *outError);
+
+struct Meshlet {
+  uint32_t VertexOffset = 0;   // into BuildMeshlets' outVertices
+  uint32_t TriangleOffset = 0; // into outTriangles (3 bytes per triangle)
+  uint32_t VertexCount = 0;
+  uint32_t TriangleCount = 0;
+  float Center[3] = {}; // bounding sphere
+  float Radius = 0.0f;
+  // Normal cone: every triangle faces away from a camera at eye when
+  // dot(Center - eye, ConeAxis) >= ConeCutoff * |Center - eye| + Radius.
+  // ConeCutoff = 1 disables the test.
+  float ConeAxis[3] = {0.0f, 0.0f, 1.0f};
+  float ConeCutoff = 1.0f;
+};
+
+// Greedy split of the list in order (cache-optimized input keeps meshlets
+// compact). Meshlet triangle indices are local (uint8) into the meshlet's
+// vertex list.
+void BuildMeshlets(const uint32_t *indices, size_t indexCount,
+                   const float *positions, uint32_t vertexCount,
+                   uint32_t maxVertices, uint32_t maxTriangles,
+                   std::vector<Meshlet> &outMeshlets,
+                   std::vector<uint32_t> &outVertices,
+                   std::vector<uint8_t> &outTriangles);
+
+} // namespace Forge
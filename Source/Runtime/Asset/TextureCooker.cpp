@@ -0,0 +1,380 @@
+#include "TextureCooker.h"
+#include "../Core/JobSystem.h"
+#include "TextureFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Forge {
+
+namespace {
+
+struct SRGBTables {
+  float ToLinear[256];
+  // Linear value halfway (in sRGB) between consecutive 8-bit codes
+  float Thresholds[255];
+
+  SRGBTables() {
+    auto decode = [](double c) {
+      return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+    };
+    for (int i = 0; i < 256; i++)
+      ToLinear[i] = (float)decode(i / 255.0);
+    for (int i = 0; i < 255; i++)
+      Thresholds[i] = (float)decode((i + 0.5) / 255.0);
+  }
+};
+
+const SRGBTables &GetSRGBTables() {
+  static const SRGBTables tables;
+  return tables;
+}
+
+// Exact round-to-nearest in sRGB space
+uint8_t LinearToSRGB8(float value) {
+  const float *thresholds = GetSRGBTables().Thresholds;
+  return (uint8_t)(std::upper_bound(thresholds, thresholds + 255, value) -
+                   thresholds);
+}
+
+uint8_t FloatToUNorm8(float value) {
+  return (uint8_t)std::clamp((int)std::lround(value * 255.0f), 0, 255);
+}
+
+// Output rows [y0, y1) of the 2x2 box filter of src (width x height)
+void DownsampleRows(const float *src, uint32_t width, uint32_t height,
+                    float *dst, uint32_t outWidth, uint32_t y0, uint32_t y1) {
+  for (uint32_t y = y0; y < y1; y++) {
+    const float *row0 = src + (size_t)std::min(2 * y, height - 1) * width * 4;
+    const float *row1 =
+        src + (size_t)std::min(2 * y + 1, height - 1) * width * 4;
+    float *out = dst + (size_t)y * outWidth * 4;
+    uint32_t x = 0;
+#if defined(__AVX2__)
+    // Two output texels (four source texels per row) per iteration
+    const __m256 quarter = _mm256_set1_ps(0.25f);
+    for (; 2 * x + 3 < width && x + 1 < outWidth; x += 2) {
+      __m256 left = _mm256_add_ps(_mm256_loadu_ps(row0 + 8 * x),
+                                  _mm256_loadu_ps(row1 + 8 * x));
+      __m256 right = _mm256_add_ps(_mm256_loadu_ps(row0 + 8 * x + 8),
+                                   _mm256_loadu_ps(row1 + 8 * x + 8));
+      __m256 even = _mm256_permute2f128_ps(left, right, 0x20);
+      __m256 odd = _mm256_permute2f128_ps(left, right, 0x31);
+      _mm256_storeu_ps(out + 4 * x,
+                       _mm256_mul_ps(_mm256_add_ps(even, odd), quarter));
+    }
+#endif
+    for (; x < outWidth; x++) {
+      const uint32_t x0 = std::min(2 * x, width - 1);
+      const uint32_t x1 = std::min(2 * x + 1, width - 1);
+      for (int c = 0; c < 4; c++) {
+        out[x * 4 + c] = ((row0[x0 * 4 + c] + row1[x0 * 4 + c]) +
+                          (row0[x1 * 4 + c] + row1[x1 * 4 + c])) *
+                         0.25f;
+      }
+    }
+  }
+}
+
+void ForRows(JobSystem *jobs, uint32_t count, uint32_t batchSize,
+             const JobSystem::RangeFunction &function) {
+  if (jobs)
+    jobs->ParallelFor(count, batchSize, function);
+  else
+    function(0, count, 0);
+}
+
+TextureFormat ResolveFormat(const ImportedImage &image,
+                            const TextureCookSettings &settings) {
+  if (settings.Format != TextureFormat::Auto)
+    return settings.Format;
+  if (settings.Kind == TextureKind::NormalMap)
+    return TextureFormat::BC5;
+  if (settings.Quality == BCQuality::High)
+    return TextureFormat::BC7;
+  for (size_t i = 3; i < image.Pixels.size(); i += 4) {
+    if (image.Pixels[i] != 255)
+      return TextureFormat::BC3;
+  }
+  return TextureFormat::BC1;
+}
+
+RHIFormat GetRHIFormat(TextureFormat format, TextureKind kind) {
+  bool srgb = kind == TextureKind::Color;
+  switch (format) {
+  case TextureFormat::BC1:
+    return srgb ? RHIFormat::BC1_UNorm_sRGB : RHIFormat::BC1_UNorm;
+  case TextureFormat::BC3:
+    return srgb ? RHIFormat::BC3_UNorm_sRGB : RHIFormat::BC3_UNorm;
+  case TextureFormat::BC5:
+    return RHIFormat::BC5_UNorm; // no sRGB variant
+  case TextureFormat::BC7:
+    return srgb ? RHIFormat::BC7_UNorm_sRGB : RHIFormat::BC7_UNorm;
+  default:
+    return RHIFormat::Unknown;
+  }
+}
+
+// 4x4 block at (bx, by), edge texels repeated past the image
+void GatherBlock(const ImportedImage &image, uint32_t bx, uint32_t by,
+                 uint8_t block[64]) {
+  for (uint32_t py = 0; py < 4; py++) {
+    uint32_t y = std::min(by * 4 + py, image.Height - 1);
+    for (uint32_t px = 0; px < 4; px++) {
+      uint32_t x = std::min(bx * 4 + px, image.Width - 1);
+      memcpy(block + (py * 4 + px) * 4,
+             image.Pixels.data() + ((size_t)y * image.Width + x) * 4, 4);
+    }
+  }
+}
+
+float PSNR(double squaredError, double samples) {
+  if (samples <= 0.0 || squaredError <= 0.0)
+    return 99.0f;
+  double mse = squaredError / samples;
+  return (float)std::min(99.0, 10.0 * std::log10(255.0 * 255.0 / mse));
+}
+
+} // namespace
+
+void GenerateMipChain(const ImportedImage &image, TextureKind kind,
+                      bool fullChain, std::vector<ImportedImage> &outMips,
+                      JobSystem *jobs) {
+  outMips.assign(1, image);
+  if (!fullChain || image.Width == 0 || image.Height == 0)
+    return;
+
+  const SRGBTables &srgb = GetSRGBTables();
+  const bool color = kind == TextureKind::Color;
+  uint32_t width = image.Width, height = image.Height;
+  std::vector<float> level((size_t)width * height * 4);
+  for (size_t i = 0; i < level.size(); i++) {
+    uint8_t value = image.Pixels[i];
+    level[i] = color && i % 4 != 3 ? srgb.ToLinear[value] : value / 255.0f;
+  }
+
+  std::vector<float> next;
+  while ((width > 1 || height > 1) && outMips.size() < MaxTextureMips) {
+    uint32_t outWidth = std::max(width / 2, 1u);
+    uint32_t outHeight = std::max(height / 2, 1u);
+    next.resize((size_t)outWidth * outHeight * 4);
+    ImportedImage mip;
+    mip.Width = outWidth;
+    mip.Height = outHeight;
+    mip.Pixels.resize(next.size());
+    ForRows(jobs, outHeight, 16,
+            [&](uint32_t begin, uint32_t end, uint32_t) {
+              DownsampleRows(level.data(), width, height, next.data(),
+                             outWidth, begin, end);
+              for (size_t i = (size_t)begin * outWidth;
+                   i < (size_t)end * outWidth; i++) {
+                float *texel = next.data() + i * 4;
+                if (kind == TextureKind::NormalMap) {
+                  float n[3] = {texel[0] * 2.0f - 1.0f, texel[1] * 2.0f - 1.0f,
+                                texel[2] * 2.0f - 1.0f};
+                  float length =
+                      std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                  if (length > 1e-6f) {
+                    for (int c = 0; c < 3; c++)
+                      texel[c] = n[c] / length * 0.5f + 0.5f;
+                  }
+                }
+                uint8_t *out = mip.Pixels.data() + i * 4;
+                for (int c = 0; c < 3; c++)
+                  out[c] = color ? LinearToSRGB8(texel[c])
+                                 : FloatToUNorm8(texel[c]);
+                out[3] = FloatToUNorm8(texel[3]);
+              }
+            });
+    outMips.push_back(std::move(mip));
+    level.swap(next);
+    width = outWidth;
+    height = outHeight;
+  }
+}
+
+bool CookTexture(const ImportedImage &image,
+                 const TextureCookSettings &settings,
+                 std::vector<uint8_t> &outFile, TextureCookStats *outStats,
+                 std::string &outError, JobSystem *jobs) {
+  if (image.Width == 0 || image.Height == 0 ||
+      image.Pixels.size() != (size_t)image.Width * image.Height * 4) {
+    outError = "empty or malformed image";
+    return false;
+  }
+  if (image.Width > 16384 || image.Height > 16384) {
+    outError = "image is larger than 16384 (the D3D12 texture limit)";
+    return false;
+  }
+
+  using ClockType = std::chrono::steady_clock;
+  auto milliseconds = [](ClockType::time_point start) {
+    return std::chrono::duration<double, std::milli>(ClockType::now() - start)
+        .count();
+  };
+  TextureCookStats stats;
+  const TextureFormat format = ResolveFormat(image, settings);
+  stats.Format = GetRHIFormat(format, settings.Kind);
+  stats.Width = image.Width;
+  stats.Height = image.Height;
+
+  // 1. Mips
+  auto start = ClockType::now();
+  std::vector<ImportedImage> mips;
+  GenerateMipChain(image, settings.Kind, settings.GenerateMips, mips, jobs);
+  stats.MipMs = milliseconds(start);
+  stats.Mips = (uint32_t)mips.size();
+
+  // 2. Layout: header, then each mip's blocks
+  outFile.clear();
+  AppendDDSHeader(outFile, stats.Format, image.Width, image.Height,
+                  stats.Mips);
+  struct BlockRow {
+    uint32_t Mip;
+    uint32_t Y;
+    size_t Offset;
+  };
+  std::vector<BlockRow> rows;
+  uint64_t pixels = 0;
+  size_t offset = outFile.size();
+  for (uint32_t mip = 0; mip < stats.Mips; mip++) {
+    const uint64_t rowBytes = GetRowBytes(stats.Format, mips[mip].Width);
+    const uint32_t rowCount = GetRowCount(stats.Format, mips[mip].Height);
+    for (uint32_t y = 0; y < rowCount; y++)
+      rows.push_back({mip, y, offset + (size_t)(y * rowBytes)});
+    offset += (size_t)(rowBytes * rowCount);
+    pixels += (uint64_t)mips[mip].Width * mips[mip].Height;
+    stats.SourceBytes += (uint64_t)mips[mip].Width * mips[mip].Height * 4;
+  }
+  outFile.resize(offset);
+
+  // 3. Block rows in parallel
+  const uint32_t blockBytes = GetFormatSize(stats.Format);
+  start = ClockType::now();
+  ForRows(jobs, (uint32_t)rows.size(), 1,
+          [&](uint32_t begin, uint32_t end, uint32_t) {
+            uint8_t block[64];
+            for (uint32_t r = begin; r < end; r++) {
+              const BlockRow &row = rows[r];
+              const ImportedImage &mip = mips[row.Mip];
+              uint8_t *out = outFile.data() + row.Offset;
+              for (uint32_t bx = 0; bx * 4 < mip.Width; bx++) {
+                GatherBlock(mip, bx, row.Y, block);
+                uint8_t *dst = out + (size_t)bx * blockBytes;
+                switch (format) {
+                case TextureFormat::BC1:
+                  EncodeBC1(block, dst, settings.Quality);
+                  break;
+                case TextureFormat::BC3:
+                  EncodeBC3(block, dst, settings.Quality);
+                  break;
+                case TextureFormat::BC5:
+                  EncodeBC5(block, dst, settings.Quality);
+                  break;
+                default:
+                  EncodeBC7(block, dst, settings.Quality);
+                  break;
+                }
+              }
+            }
+          });
+  stats.EncodeMs = milliseconds(start);
+  stats.MPixelsPerSecond =
+      stats.EncodeMs > 0.0 ? pixels / (stats.EncodeMs * 1000.0) : 0.0;
+  stats.Bytes = outFile.size();
+
+  // 4. Analysis: decode mip 0 and compare with the source
+  if (settings.Analyze) {
+    const uint8_t *blocks = outFile.data() + rows[0].Offset;
+    double colorError = 0.0, colorSamples = 0.0, alphaError = 0.0;
+    const bool hasAlpha = format != TextureFormat::BC5;
+    const int colorChannels = format == TextureFormat::BC5 ? 2 : 3;
+    uint8_t decoded[64];
+    const uint32_t blocksX = (image.Width + 3) / 4;
+    for (uint32_t by = 0; by * 4 < image.Height; by++) {
+      for (uint32_t bx = 0; bx < blocksX; bx++) {
+        const uint8_t *block =
+            blocks + ((size_t)by * blocksX + bx) * blockBytes;
+        switch (format) {
+        case TextureFormat::BC1:
+          DecodeBC1(block, decoded);
+          break;
+        case TextureFormat::BC3:
+          DecodeBC3(block, decoded);
+          break;
+        case TextureFormat::BC5:
+          DecodeBC5(block, decoded);
+          break;
+        default:
+          DecodeBC7(block, decoded);
+          break;
+        }
+        for (uint32_t p = 0; p < 16; p++) {
+          uint32_t x = bx * 4 + p % 4, y = by * 4 + p / 4;
+          if (x >= image.Width || y >= image.Height)
+            continue;
+          const uint8_t *source =
+              image.Pixels.data() + ((size_t)y * image.Width + x) * 4;
+          // Color counts as much as it is visible
+          double visibility = hasAlpha ? source[3] / 255.0 : 1.0;
+          for (int c = 0; c < colorChannels; c++) {
+            double d = (double)source[c] - decoded[p * 4 + c];
+            colorError += d * d * visibility;
+          }
+          colorSamples += visibility * colorChannels;
+          double d = (double)source[3] - decoded[p * 4 + 3];
+          alphaError += hasAlpha ? d * d : 0.0;
+        }
+      }
+    }
+    uint64_t texels = (uint64_t)image.Width * image.Height;
+    stats.ColorPSNR = PSNR(colorError, colorSamples);
+    stats.AlphaPSNR = PSNR(alphaError, texels);
+  }
+
+  if (outStats)
+    *outStats = stats;
+  return true;
+}
+
+bool CookTextureFile(const std::string &inputPath,
+                     const std::string &outputPath,
+                     const TextureCookSettings &settings,
+                     TextureCookStats *outStats, std::string &outError,
+                     JobSystem *jobs) {
+  ImportedImage image;
+  if (!ImportImage(inputPath, image, outError))
+    return false;
+  std::vector<uint8_t> cooked;
+  if (!CookTexture(image, settings, cooked, outStats, outError, jobs))
+    return false;
+
+  std::error_code ec;
+  std::filesystem::path output(outputPath);
+  if (output.has_parent_path())
+    std::filesystem::create_directories(output.parent_path(), ec);
+  std::string temp = outputPath + ".tmp";
+  {
+    std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+    if (!file ||
+        !file.write((const char *)cooked.data(), (std::streamsize)cooked.size())) {
+      outError = "cannot write " + temp;
+      return false;
+    }
+  }
+  std::filesystem::rename(temp, outputPath, ec);
+  if (ec) {
+    outError = "cannot replace " + outputPath + ": " + ec.message();
+    return false;
+  }
+  return true;
+}
+
+} // namespace Forge
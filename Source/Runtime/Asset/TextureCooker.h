@@ -0,0 +1,71 @@
+#pragma once
+#include "../RHI/RHI.h"
+#include "BlockCompression.h"
+#include "TextureImporter.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Forge {
+
+class JobSystem;
+
+enum class TextureFormat {
+  Auto, // BC5 for normal maps; otherwise BC7 at High quality, else BC1
+        // for opaque images and BC3 for images with alpha
+  BC1,
+  BC3,
+  BC5,
+  BC7,
+};
+
+enum class TextureKind {
+  Color,     // sRGB: mips filtered in linear space, *_sRGB format
+  Linear,    // data (masks, roughness...): filtered as stored
+  NormalMap, // XY(Z) in [0, 1]: filtered, then renormalized
+};
+
+struct TextureCookSettings {
+  TextureFormat Format = TextureFormat::Auto;
+  TextureKind Kind = TextureKind::Color;
+  BCQuality Quality = BCQuality::Normal; // speed / quality preset
+  bool GenerateMips = true;              // full chain down to 1x1
+  bool Analyze = false; // decode the result and measure PSNR (slower)
+};
+
+struct TextureCookStats {
+  uint32_t Width = 0, Height = 0, Mips = 0;
+  RHIFormat Format = RHIFormat::Unknown;
+  uint64_t SourceBytes = 0; // the same mip chain as RGBA8
+  uint64_t Bytes = 0;       // DDS file
+  double MipMs = 0.0;       // mip generation
+  double EncodeMs = 0.0;    // block compression, all mips
+  double MPixelsPerSecond = 0.0; // encoded pixels / EncodeMs
+  // With Analyze: mip 0 against the source, in dB (99 = lossless)
+  float ColorPSNR = 0.0f; // RGB weighted by alpha, or RG for BC5
+  float AlphaPSNR = 0.0f; // 99 for formats without alpha
+};
+
+// Mip chain as RGBA8, mip 0 first (a copy of image). Each level is a 2x2
+// box filter of the previous one (edge texels repeat for odd sizes),
+// computed in float, in linear space for Color.
+void GenerateMipChain(const ImportedImage &image, TextureKind kind,
+                      bool fullChain, std::vector<ImportedImage> &outMips,
+                      JobSystem *jobs = nullptr);
+
+// Mips + block compression into a DDS image (see TextureFile.h). Block
+// rows of all mips are encoded in parallel on `jobs` (serially without
+// one). Deterministic: the bytes do not depend on the thread count.
+bool CookTexture(const ImportedImage &image,
+                 const TextureCookSettings &settings,
+                 std::vector<uint8_t> &outFile, TextureCookStats *outStats,
+                 std::string &outError, JobSystem *jobs = nullptr);
+
+// Import + cook + write (via a temporary file and rename)
+bool CookTextureFile(const std::string &inputPath,
+                     const std::string &outputPath,
+                     const TextureCookSettings &settings,
+                     TextureCookStats *outStats, std::string &outError,
+                     JobSystem *jobs = nullptr);
+
+} // namespace Forge
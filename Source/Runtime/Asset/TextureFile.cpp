@@ -0,0 +1,165 @@
+#include "TextureFile.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace Forge {
+
+namespace {
+
+constexpr uint32_t MakeFourCC(char a, char b, char c, char d) {
+  return (uint32_t)(uint8_t)a | (uint32_t)(uint8_t)b << 8 |
+         (uint32_t)(uint8_t)c << 16 | (uint32_t)(uint8_t)d << 24;
+}
+
+// DDS header flags
+constexpr uint32_t DDSD_CAPS = 0x1, DDSD_HEIGHT = 0x2, DDSD_WIDTH = 0x4,
+                   DDSD_PIXELFORMAT = 0x1000, DDSD_MIPMAPCOUNT = 0x20000,
+                   DDSD_LINEARSIZE = 0x80000;
+constexpr uint32_t DDPF_FOURCC = 0x4;
+constexpr uint32_t DDSCAPS_COMPLEX = 0x8, DDSCAPS_TEXTURE = 0x1000,
+                   DDSCAPS_MIPMAP = 0x400000;
+constexpr uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+constexpr uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+
+struct DXGIFormatEntry {
+  RHIFormat Format;
+  uint32_t DXGIFormat; // DXGI_FORMAT value
+};
+
+const DXGIFormatEntry DXGIFormats[] = {
+    {RHIFormat::BC1_UNorm, 71}, {RHIFormat::BC1_UNorm_sRGB, 72},
+    {RHIFormat::BC3_UNorm, 77}, {RHIFormat::BC3_UNorm_sRGB, 78},
+    {RHIFormat::BC5_UNorm, 83}, {RHIFormat::BC7_UNorm, 98},
+    {RHIFormat::BC7_UNorm_sRGB, 99},
+};
+
+} // namespace
+
+void AppendDDSHeader(std::vector<uint8_t> &out, RHIFormat format,
+                     uint32_t width, uint32_t height, uint32_t mipCount) {
+  DDSHeader header = {};
+  header.Size = sizeof(DDSHeader);
+  header.Flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT |
+                 DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE;
+  header.Height = height;
+  header.Width = width;
+  header.PitchOrLinearSize =
+      (uint32_t)(GetRowBytes(format, width) * GetRowCount(format, height));
+  header.MipMapCount = mipCount;
+  header.PixelFormat.Size = sizeof(DDSPixelFormat);
+  header.PixelFormat.Flags = DDPF_FOURCC;
+  header.PixelFormat.FourCC = MakeFourCC('D', 'X', '1', '0');
+  header.Caps = DDSCAPS_TEXTURE |
+                (mipCount > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+
+  DDSHeaderDXT10 extension = {};
+  for (const DXGIFormatEntry &entry : DXGIFormats) {
+    if (entry.Format == format)
+      extension.DXGIFormat = entry.DXGIFormat;
+  }
+  extension.ResourceDimension = DDS_DIMENSION_TEXTURE2D;
+  extension.ArraySize = 1;
+
+  uint32_t magic = DDSMagic;
+  const uint8_t *parts[3] = {(const uint8_t *)&magic, (const uint8_t *)&header,
+                             (const uint8_t *)&extension};
+  const size_t sizes[3] = {sizeof(magic), sizeof(header), sizeof(extension)};
+  for (int i = 0; i < 3; i++)
+    out.insert(out.end(), parts[i], parts[i] + sizes[i]);
+}
+
+bool TextureFile::Open(const std::string &path) {
+  if (!m_File.Open(path)) {
+    std::cerr << "[TextureFile] Cannot map " << path << std::endl;
+    return false;
+  }
+  std::string error;
+  if (!Parse(m_File.GetData(), m_File.GetSize(), m_Layout, &error)) {
+    std::cerr << "[TextureFile] " << path << ": " << error << std::endl;
+    m_File.Close();
+    return false;
+  }
+  return true;
+}
+
+bool TextureFile::Parse(const uint8_t *data, size_t size,
+                        TextureLayout &outLayout, std::string *error) {
+  auto fail = [&](const char *message) {
+    if (error)
+      *error = message;
+    return false;
+  };
+  if (!data || size < 4 + sizeof(DDSHeader))
+    return fail("truncated header");
+  uint32_t magic;
+  DDSHeader header;
+  memcpy(&magic, data, 4);
+  memcpy(&header, data + 4, sizeof(header));
+  if (magic != DDSMagic || header.Size != sizeof(DDSHeader) ||
+      header.PixelFormat.Size != sizeof(DDSPixelFormat))
+    return fail("not a DDS file");
+  if (!(header.PixelFormat.Flags & DDPF_FOURCC))
+    return fail("uncompressed DDS is not supported");
+
+  TextureLayout layout;
+  size_t offset = 4 + sizeof(DDSHeader);
+  switch (header.PixelFormat.FourCC) {
+  case MakeFourCC('D', 'X', 'T', '1'):
+    layout.Format = RHIFormat::BC1_UNorm;
+    break;
+  case MakeFourCC('D', 'X', 'T', '5'):
+    layout.Format = RHIFormat::BC3_UNorm;
+    break;
+  case MakeFourCC('A', 'T', 'I', '2'):
+  case MakeFourCC('B', 'C', '5', 'U'):
+    layout.Format = RHIFormat::BC5_UNorm;
+    break;
+  case MakeFourCC('D', 'X', '1', '0'): {
+    DDSHeaderDXT10 extension;
+    if (size < offset + sizeof(extension))
+      return fail("truncated DX10 header");
+    memcpy(&extension, data + offset, sizeof(extension));
+    offset += sizeof(extension);
+    if (extension.ResourceDimension != DDS_DIMENSION_TEXTURE2D ||
+        extension.ArraySize != 1 ||
+        (extension.MiscFlag & DDS_RESOURCE_MISC_TEXTURECUBE))
+      return fail("only single 2D textures are supported");
+    for (const DXGIFormatEntry &entry : DXGIFormats) {
+      if (entry.DXGIFormat == extension.DXGIFormat)
+        layout.Format = entry.Format;
+    }
+    break;
+  }
+  default:
+    break;
+  }
+  if (layout.Format == RHIFormat::Unknown)
+    return fail("unsupported DDS format (BC1/BC3/BC5/BC7 only)");
+
+  layout.Width = header.Width;
+  layout.Height = header.Height;
+  layout.MipCount = header.MipMapCount > 0 ? header.MipMapCount : 1;
+  uint32_t fullChain = 1;
+  while (fullChain < 32 &&
+         (std::max(layout.Width, layout.Height) >> fullChain) > 0)
+    fullChain++;
+  if (layout.Width == 0 || layout.Height == 0 || layout.MipCount > fullChain ||
+      layout.MipCount > MaxTextureMips)
+    return fail("bad texture size or mip count");
+
+  for (uint32_t mip = 0; mip < layout.MipCount; mip++) {
+    uint64_t bytes =
+        GetRowBytes(layout.Format, GetMipSize(layout.Width, mip)) *
+        GetRowCount(layout.Format, GetMipSize(layout.Height, mip));
+    if (bytes > size - offset)
+      return fail("mip data out of range");
+    layout.MipOffset[mip] = offset;
+    layout.MipBytes[mip] = bytes;
+    offset += bytes;
+  }
+  outLayout = layout;
+  return true;
+}
+
+} // namespace Forge
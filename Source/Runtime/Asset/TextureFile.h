@@ -0,0 +1,94 @@
+#pragma once
+#include "../Core/MappedFile.h"
+#include "../RHI/RHI.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Forge {
+
+// Cooked textures are DDS files: "DDS " | DDS_HEADER | DDS_HEADER_DXT10 |
+// mips from largest to smallest, each a tight array of 4x4 blocks. Any
+// tool that reads DX10 DDS files opens them.
+static constexpr uint32_t DDSMagic = 0x20534444; // "DDS "
+static constexpr uint32_t MaxTextureMips = 16;
+
+struct DDSPixelFormat {
+  uint32_t Size; // 32
+  uint32_t Flags;
+  uint32_t FourCC;
+  uint32_t RGBBitCount;
+  uint32_t RBitMask, GBitMask, BBitMask, ABitMask;
+};
+
+struct DDSHeader {
+  uint32_t Size; // 124
+  uint32_t Flags;
+  uint32_t Height;
+  uint32_t Width;
+  uint32_t PitchOrLinearSize;
+  uint32_t Depth;
+  uint32_t MipMapCount;
+  uint32_t Reserved1[11];
+  DDSPixelFormat PixelFormat;
+  uint32_t Caps, Caps2, Caps3, Caps4;
+  uint32_t Reserved2;
+};
+
+struct DDSHeaderDXT10 {
+  uint32_t DXGIFormat;
+  uint32_t ResourceDimension; // 3 = Texture2D
+  uint32_t MiscFlag;
+  uint32_t ArraySize;
+  uint32_t MiscFlags2;
+};
+
+static_assert(sizeof(DDSPixelFormat) == 32, "DDS_PIXELFORMAT layout");
+static_assert(sizeof(DDSHeader) == 124, "DDS_HEADER layout");
+static_assert(sizeof(DDSHeaderDXT10) == 20, "DDS_HEADER_DXT10 layout");
+
+// Magic + headers for a 2D block-compressed texture; mip data follows
+void AppendDDSHeader(std::vector<uint8_t> &out, RHIFormat format,
+                     uint32_t width, uint32_t height, uint32_t mipCount);
+
+// Where each mip of a parsed DDS lives
+struct TextureLayout {
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+  uint32_t MipCount = 0;
+  RHIFormat Format = RHIFormat::Unknown;
+  uint64_t MipOffset[MaxTextureMips] = {};
+  uint64_t MipBytes[MaxTextureMips] = {};
+};
+
+// Read-only view of a block-compressed 2D DDS: BC1/BC3/BC5/BC7 with a DX10
+// header, or the legacy DXT1/DXT5/ATI2 FourCCs. Open maps the file and
+// checks that every mip is inside it; mip data points into the mapping and
+// can be handed to UploadManager::UploadTexture as is.
+class TextureFile {
+public:
+  bool Open(const std::string &path);
+  void Close() { m_File.Close(); }
+  bool IsOpen() const { return m_File.IsOpen(); }
+
+  static bool Parse(const uint8_t *data, size_t size, TextureLayout &outLayout,
+                    std::string *error);
+
+  const TextureLayout &GetLayout() const { return m_Layout; }
+  RHIFormat GetFormat() const { return m_Layout.Format; }
+  uint32_t GetMipCount() const { return m_Layout.MipCount; }
+  const uint8_t *GetMipData(uint32_t mip) const {
+    return m_File.GetData() + m_Layout.MipOffset[mip];
+  }
+  uint64_t GetMipBytes(uint32_t mip) const { return m_Layout.MipBytes[mip]; }
+  // Bytes per row of blocks (the rowBytes of a texture upload)
+  uint64_t GetMipRowBytes(uint32_t mip) const {
+    return GetRowBytes(m_Layout.Format, GetMipSize(m_Layout.Width, mip));
+  }
+
+private:
+  MappedFile m_File;
+  TextureLayout m_Layout;
+};
+
+} // namespace Forge
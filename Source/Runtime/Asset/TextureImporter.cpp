@@ -0,0 +1,674 @@
+#include "TextureImporter.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Forge {
+
+namespace {
+
+// --- Checksums ---
+
+uint32_t UpdateCRC32(uint32_t crc, const uint8_t *data, size_t size) {
+  static const auto table = [] {
+    std::vector<uint32_t> entries(256);
+    for (uint32_t n = 0; n < 256; n++) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; k++)
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      entries[n] = c;
+    }
+    return entries;
+  }();
+  crc = ~crc;
+  for (size_t i = 0; i < size; i++)
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+uint32_t Adler32(const uint8_t *data, size_t size) {
+  uint32_t a = 1, b = 0;
+  while (size > 0) {
+    size_t block = std::min<size_t>(size, 5552); // no overflow before mod
+    for (size_t i = 0; i < block; i++) {
+      a += data[i];
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+    data += block;
+    size -= block;
+  }
+  return (b << 16) | a;
+}
+
+uint32_t ReadBE32(const uint8_t *p) {
+  return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 |
+         p[3];
+}
+
+void WriteBE32(std::vector<uint8_t> &out, uint32_t value) {
+  out.insert(out.end(), {(uint8_t)(value >> 24), (uint8_t)(value >> 16),
+                         (uint8_t)(value >> 8), (uint8_t)value});
+}
+
+// --- Inflate (RFC 1950/1951) ---
+
+const uint16_t LengthBase[29] = {3,  4,  5,  6,   7,   8,   9,   10,  11, 13,
+                                 15, 17, 19, 23,  27,  31,  35,  43,  51, 59,
+                                 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t LengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+                                 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t DistanceBase[30] = {
+    1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+    33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+    1025, 1537, 2049, 3073, 4097, 6145,  8193,  12289, 16385, 24577};
+const uint8_t DistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2,  2,  3,  3,
+                                   4, 4, 5, 5, 6, 6, 7,  7,  8,  8,
+                                   9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+class BitReader {
+public:
+  BitReader(const uint8_t *data, size_t size) : m_Data(data), m_Size(size) {}
+
+  // Up to 16 bits, least significant first
+  uint32_t Read(int count) {
+    while (m_Count < count) {
+      if (m_Position >= m_Size) {
+        m_Overrun = true;
+        return 0;
+      }
+      m_Bits |= (uint32_t)m_Data[m_Position++] << m_Count;
+      m_Count += 8;
+    }
+    uint32_t value = m_Bits & ((1u << count) - 1);
+    m_Bits >>= count;
+    m_Count -= count;
+    return value;
+  }
+  void AlignToByte() {
+    m_Bits = 0;
+    m_Count = 0;
+  }
+  bool ReadBytes(uint8_t *out, size_t count) {
+    if (m_Size - m_Position < count) {
+      m_Overrun = true;
+      return false;
+    }
+    memcpy(out, m_Data + m_Position, count);
+    m_Position += count;
+    return true;
+  }
+  size_t GetPosition() const { return m_Position; }
+  bool HasOverrun() const { return m_Overrun; }
+
+private:
+  const uint8_t *m_Data;
+  size_t m_Size;
+  size_t m_Position = 0;
+  uint32_t m_Bits = 0;
+  int m_Count = 0;
+  bool m_Overrun = false;
+};
+
+// Canonical Huffman code: code counts per length, symbols in code order
+struct HuffmanCode {
+  uint16_t Counts[16];
+  uint16_t Symbols[288];
+};
+
+// Rejects over-subscribed codes; incomplete ones are allowed (a single
+// distance code is legal)
+bool BuildHuffman(HuffmanCode &code, const uint8_t *lengths, int count) {
+  memset(code.Counts, 0, sizeof(code.Counts));
+  for (int symbol = 0; symbol < count; symbol++)
+    code.Counts[lengths[symbol]]++;
+  int left = 1;
+  for (int length = 1; length < 16; length++) {
+    left = (left << 1) - code.Counts[length];
+    if (left < 0)
+      return false;
+  }
+  uint16_t offsets[16] = {};
+  for (int length = 1; length < 15; length++)
+    offsets[length + 1] = offsets[length] + code.Counts[length];
+  for (int symbol = 0; symbol < count; symbol++) {
+    if (lengths[symbol] != 0)
+      code.Symbols[offsets[lengths[symbol]]++] = (uint16_t)symbol;
+  }
+  return true;
+}
+
+int DecodeSymbol(BitReader &reader, const HuffmanCode &code) {
+  int bits = 0, first = 0, index = 0;
+  for (int length = 1; length < 16; length++) {
+    bits |= (int)reader.Read(1);
+    int count = code.Counts[length];
+    if (bits - first < count)
+      return code.Symbols[index + bits - first];
+    index += count;
+    first = (first + count) << 1;
+    bits <<= 1;
+  }
+  return -1;
+}
+
+bool InflateCodes(BitReader &reader, const HuffmanCode &literals,
+                  const HuffmanCode &distances, std::vector<uint8_t> &out) {
+  for (;;) {
+    int symbol = DecodeSymbol(reader, literals);
+    if (symbol < 0 || reader.HasOverrun())
+      return false;
+    if (symbol < 256) {
+      out.push_back((uint8_t)symbol);
+      continue;
+    }
+    if (symbol == 256)
+      return true;
+    symbol -= 257;
+    if (symbol >= 29)
+      return false;
+    uint32_t length = LengthBase[symbol] + reader.Read(LengthExtra[symbol]);
+    symbol = DecodeSymbol(reader, distances);
+    if (symbol < 0 || symbol >= 30)
+      return false;
+    uint32_t distance =
+        DistanceBase[symbol] + reader.Read(DistanceExtra[symbol]);
+    if (distance > out.size() || reader.HasOverrun())
+      return false;
+    size_t from = out.size() - distance;
+    for (uint32_t i = 0; i < length; i++) // may overlap its own output
+      out.push_back(out[from + i]);
+  }
+}
+
+bool Inflate(const uint8_t *data, size_t size, std::vector<uint8_t> &out,
+             std::string &outError) {
+  if (size < 6 || (data[0] & 0x0F) != 8 || (data[0] * 256 + data[1]) % 31 ||
+      (data[1] & 0x20)) {
+    outError = "bad zlib header";
+    return false;
+  }
+  BitReader reader(data + 2, size - 2);
+  bool last = false;
+  while (!last) {
+    last = reader.Read(1) != 0;
+    uint32_t type = reader.Read(2);
+    if (type == 0) {
+      reader.AlignToByte();
+      uint8_t header[4];
+      if (!reader.ReadBytes(header, 4) ||
+          (header[0] | header[1] << 8) != (~(header[2] | header[3] << 8) &
+                                           0xFFFF)) {
+        outError = "bad stored block";
+        return false;
+      }
+      size_t length = header[0] | header[1] << 8;
+      size_t start = out.size();
+      out.resize(start + length);
+      if (!reader.ReadBytes(out.data() + start, length)) {
+        outError = "truncated stored block";
+        return false;
+      }
+    } else if (type == 1) {
+      static const auto fixed = [] {
+        std::pair<HuffmanCode, HuffmanCode> codes;
+        uint8_t lengths[288];
+        std::fill(lengths, lengths + 144, 8);
+        std::fill(lengths + 144, lengths + 256, 9);
+        std::fill(lengths + 256, lengths + 280, 7);
+        std::fill(lengths + 280, lengths + 288, 8);
+        BuildHuffman(codes.first, lengths, 288);
+        std::fill(lengths, lengths + 30, 5);
+        BuildHuffman(codes.second, lengths, 30);
+        return codes;
+      }();
+      if (!InflateCodes(reader, fixed.first, fixed.second, out)) {
+        outError = "corrupt deflate data";
+        return false;
+      }
+    } else if (type == 2) {
+      static const uint8_t order[19] = {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+                                        11, 4,  12, 3, 13, 2, 14, 1, 15};
+      int literalCount = (int)reader.Read(5) + 257;
+      int distanceCount = (int)reader.Read(5) + 1;
+      int lengthCount = (int)reader.Read(4) + 4;
+      uint8_t lengths[288 + 32] = {};
+      for (int i = 0; i < lengthCount; i++)
+        lengths[order[i]] = (uint8_t)reader.Read(3);
+      HuffmanCode lengthCode, literals, distances;
+      bool valid = literalCount <= 286 && distanceCount <= 30 &&
+                   BuildHuffman(lengthCode, lengths, 19);
+      memset(lengths, 0, sizeof(lengths));
+      for (int i = 0; valid && i < literalCount + distanceCount;) {
+        int symbol = DecodeSymbol(reader, lengthCode);
+        if (symbol < 0) {
+          valid = false;
+        } else if (symbol < 16) {
+          lengths[i++] = (uint8_t)symbol;
+        } else {
+          uint8_t value = 0;
+          int repeat;
+          if (symbol == 16) {
+            valid = i > 0;
+            value = valid ? lengths[i - 1] : 0;
+            repeat = 3 + (int)reader.Read(2);
+          } else if (symbol == 17) {
+            repeat = 3 + (int)reader.Read(3);
+          } else {
+            repeat = 11 + (int)reader.Read(7);
+          }
+          valid &= i + repeat <= literalCount + distanceCount;
+          for (; valid && repeat > 0; repeat--)
+            lengths[i++] = value;
+        }
+      }
+      valid = valid && !reader.HasOverrun() && lengths[256] != 0 &&
+              BuildHuffman(literals, lengths, literalCount) &&
+              BuildHuffman(distances, lengths + literalCount, distanceCount);
+      if (!valid || !InflateCodes(reader, literals, distances, out)) {
+        outError = "corrupt deflate data";
+        return false;
+      }
+    } else {
+      outError = "bad deflate block type";
+      return false;
+    }
+    if (reader.HasOverrun()) {
+      outError = "truncated deflate data";
+      return false;
+    }
+  }
+
+  size_t end = 2 + reader.GetPosition();
+  if (end + 4 > size || ReadBE32(data + end) != Adler32(out.data(), out.size())) {
+    outError = "zlib checksum mismatch";
+    return false;
+  }
+  return true;
+}
+
+// --- Deflate (fixed Huffman, greedy LZ77) ---
+
+class BitWriter {
+public:
+  explicit BitWriter(std::vector<uint8_t> &out) : m_Out(out) {}
+
+  void Write(uint32_t value, int count) {
+    m_Bits |= value << m_Count;
+    m_Count += count;
+    while (m_Count >= 8) {
+      m_Out.push_back((uint8_t)m_Bits);
+      m_Bits >>= 8;
+      m_Count -= 8;
+    }
+  }
+  // Huffman codes go most significant bit first
+  void WriteCode(uint32_t code, int count) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < count; i++)
+      reversed |= ((code >> i) & 1) << (count - 1 - i);
+    Write(reversed, count);
+  }
+  void Flush() {
+    if (m_Count > 0)
+      m_Out.push_back((uint8_t)m_Bits);
+    m_Bits = 0;
+    m_Count = 0;
+  }
+
+private:
+  std::vector<uint8_t> &m_Out;
+  uint32_t m_Bits = 0;
+  int m_Count = 0;
+};
+
+void WriteFixedLiteral(BitWriter &writer, uint32_t symbol) {
+  if (symbol < 144)
+    writer.WriteCode(0x30 + symbol, 8);
+  else if (symbol < 256)
+    writer.WriteCode(0x190 + symbol - 144, 9);
+  else if (symbol < 280)
+    writer.WriteCode(symbol - 256, 7);
+  else
+    writer.WriteCode(0xC0 + symbol - 280, 8);
+}
+
+void Deflate(const uint8_t *data, size_t size, std::vector<uint8_t> &out) {
+  constexpr uint32_t WindowSize = 32768, HashBits = 15, MaxChain = 32;
+  out.insert(out.end(), {0x78, 0x01}); // zlib, 32K window, fastest
+  BitWriter writer(out);
+  writer.Write(1, 1); // final block
+  writer.Write(1, 2); // fixed Huffman
+
+  std::vector<int32_t> head(1u << HashBits, -1);
+  std::vector<int32_t> previous(WindowSize, -1);
+  auto hash = [&](size_t i) {
+    uint32_t value = data[i] | data[i + 1] << 8 | data[i + 2] << 16;
+    return (value * 2654435761u) >> (32 - HashBits);
+  };
+  auto insert = [&](size_t i) {
+    if (i + 2 < size) {
+      uint32_t h = hash(i);
+      previous[i % WindowSize] = head[h];
+      head[h] = (int32_t)i;
+    }
+  };
+
+  size_t i = 0;
+  while (i < size) {
+    uint32_t bestLength = 0, bestDistance = 0;
+    if (i + 2 < size) {
+      int32_t candidate = head[hash(i)];
+      size_t maxLength = std::min<size_t>(258, size - i);
+      for (uint32_t chain = 0; chain < MaxChain && candidate >= 0 &&
+                               i - candidate <= WindowSize - 1;
+           chain++) {
+        uint32_t length = 0;
+        while (length < maxLength && data[candidate + length] == data[i + length])
+          length++;
+        if (length > bestLength) {
+          bestLength = length;
+          bestDistance = (uint32_t)(i - candidate);
+          if (length == maxLength)
+            break;
+        }
+        int32_t next = previous[candidate % WindowSize];
+        if (next >= candidate)
+          break; // slot reused by a newer position
+        candidate = next;
+      }
+    }
+
+    if (bestLength >= 3) {
+      int symbol = 28;
+      while (LengthBase[symbol] > bestLength)
+        symbol--;
+      WriteFixedLiteral(writer, 257 + symbol);
+      writer.Write(bestLength - LengthBase[symbol], LengthExtra[symbol]);
+      int distance = 29;
+      while (DistanceBase[distance] > bestDistance)
+        distance--;
+      writer.WriteCode(distance, 5);
+      writer.Write(bestDistance - DistanceBase[distance],
+                   DistanceExtra[distance]);
+      for (uint32_t k = 0; k < bestLength; k++)
+        insert(i + k);
+      i += bestLength;
+    } else {
+      WriteFixedLiteral(writer, data[i]);
+      insert(i);
+      i++;
+    }
+  }
+  WriteFixedLiteral(writer, 256);
+  writer.Flush();
+  WriteBE32(out, Adler32(data, size));
+}
+
+// --- PNG filters ---
+
+uint8_t Paeth(int a, int b, int c) {
+  int p = a + b - c;
+  int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+  if (pa <= pb && pa <= pc)
+    return (uint8_t)a;
+  return (uint8_t)(pb <= pc ? b : c);
+}
+
+// In place; previous is the unfiltered row above (zeros for the first)
+bool Unfilter(uint8_t type, uint8_t *row, const uint8_t *previous,
+              size_t rowBytes, size_t bytesPerPixel) {
+  for (size_t i = 0; i < rowBytes; i++) {
+    int a = i >= bytesPerPixel ? row[i - bytesPerPixel] : 0;
+    int b = previous[i];
+    int c = i >= bytesPerPixel ? previous[i - bytesPerPixel] : 0;
+    switch (type) {
+    case 0:
+      break;
+    case 1:
+      row[i] = (uint8_t)(row[i] + a);
+      break;
+    case 2:
+      row[i] = (uint8_t)(row[i] + b);
+      break;
+    case 3:
+      row[i] = (uint8_t)(row[i] + ((a + b) >> 1));
+      break;
+    case 4:
+      row[i] = (uint8_t)(row[i] + Paeth(a, b, c));
+      break;
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+bool ImportImage(const std::string &path, ImportedImage &outImage,
+                 std::string &outError) {
+  std::string extension = std::filesystem::path(path).extension().string();
+  for (char &c : extension)
+    c = (char)std::tolower((unsigned char)c);
+  if (extension != ".png") {
+    outError = "unsupported image format '" + extension + "' (PNG only)";
+    return false;
+  }
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    outError = "cannot open " + path;
+    return false;
+  }
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+  return DecodePNG(data.data(), data.size(), outImage, outError);
+}
+
+bool DecodePNG(const uint8_t *data, size_t size, ImportedImage &outImage,
+               std::string &outError) {
+  static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n',
+                                       0x1A, '\n'};
+  if (size < 8 || memcmp(data, signature, 8) != 0) {
+    outError = "not a PNG file";
+    return false;
+  }
+
+  uint32_t width = 0, height = 0;
+  uint8_t bitDepth = 0, colorType = 0, interlace = 0;
+  std::vector<uint8_t> palette, transparency, compressed;
+  bool header = false, end = false;
+  for (size_t offset = 8; !end;) {
+    if (size - offset < 12) {
+      outError = "truncated PNG";
+      return false;
+    }
+    uint32_t length = ReadBE32(data + offset);
+    const uint8_t *type = data + offset + 4;
+    const uint8_t *chunk = type + 4;
+    if (length > size - offset - 12) {
+      outError = "truncated PNG";
+      return false;
+    }
+    if (ReadBE32(chunk + length) != UpdateCRC32(0, type, length + 4)) {
+      outError = "PNG chunk checksum mismatch";
+      return false;
+    }
+    if (memcmp(type, "IHDR", 4) == 0 && length == 13) {
+      width = ReadBE32(chunk);
+      height = ReadBE32(chunk + 4);
+      bitDepth = chunk[8];
+      colorType = chunk[9];
+      interlace = chunk[12];
+      header = true;
+    } else if (memcmp(type, "PLTE", 4) == 0) {
+      palette.assign(chunk, chunk + length);
+    } else if (memcmp(type, "tRNS", 4) == 0) {
+      transparency.assign(chunk, chunk + length);
+    } else if (memcmp(type, "IDAT", 4) == 0) {
+      compressed.insert(compressed.end(), chunk, chunk + length);
+    } else if (memcmp(type, "IEND", 4) == 0) {
+      end = true;
+    } else if (!(type[0] & 0x20)) {
+      outError = "unknown critical PNG chunk";
+      return false;
+    }
+    offset += 12 + length;
+  }
+
+  static const uint8_t channelsByType[7] = {1, 0, 3, 1, 2, 0, 4};
+  uint32_t channels = colorType <= 6 ? channelsByType[colorType] : 0;
+  bool validDepth = colorType == 3 ? (bitDepth <= 8 && !(bitDepth & (bitDepth - 1)))
+                    : colorType == 0 ? (bitDepth <= 16 && !(bitDepth & (bitDepth - 1)))
+                                     : (bitDepth == 8 || bitDepth == 16);
+  if (!header || width == 0 || height == 0 || channels == 0 || !validDepth ||
+      (colorType == 3 && palette.size() < 3)) {
+    outError = "unsupported or malformed PNG header";
+    return false;
+  }
+  if (interlace != 0) {
+    outError = "interlaced PNG is not supported";
+    return false;
+  }
+  if ((uint64_t)width * height > (1ull << 28)) {
+    outError = "PNG is too large";
+    return false;
+  }
+
+  const size_t bitsPerPixel = (size_t)channels * bitDepth;
+  const size_t rowBytes = (width * bitsPerPixel + 7) / 8;
+  const size_t bytesPerPixel = std::max<size_t>(bitsPerPixel / 8, 1);
+  std::vector<uint8_t> raw;
+  raw.reserve((rowBytes + 1) * height);
+  if (!Inflate(compressed.data(), compressed.size(), raw, outError))
+    return false;
+  if (raw.size() < (rowBytes + 1) * height) {
+    outError = "PNG image data is too short";
+    return false;
+  }
+
+  outImage.Width = width;
+  outImage.Height = height;
+  outImage.Pixels.resize((size_t)width * height * 4);
+  std::vector<uint8_t> zeros(rowBytes, 0);
+  const uint32_t maxValue = (1u << bitDepth) - 1;
+  for (uint32_t y = 0; y < height; y++) {
+    uint8_t *row = raw.data() + y * (rowBytes + 1) + 1;
+    const uint8_t *previous = y > 0 ? row - (rowBytes + 1) : zeros.data();
+    if (!Unfilter(row[-1], row, previous, rowBytes, bytesPerPixel)) {
+      outError = "bad PNG filter type";
+      return false;
+    }
+
+    // Sample c of pixel x at full depth
+    auto sample = [&](uint32_t x, uint32_t c) -> uint32_t {
+      size_t index = (size_t)x * channels + c;
+      if (bitDepth == 16)
+        return row[index * 2] << 8 | row[index * 2 + 1];
+      if (bitDepth == 8)
+        return row[index];
+      size_t bit = index * bitDepth;
+      return (row[bit / 8] >> (8 - bitDepth - bit % 8)) & maxValue;
+    };
+    auto to8 = [&](uint32_t value) -> uint8_t {
+      return bitDepth == 16 ? (uint8_t)((value * 255 + 32767) / 65535)
+                            : (uint8_t)(value * 255 / maxValue);
+    };
+
+    uint8_t *out = outImage.Pixels.data() + (size_t)y * width * 4;
+    for (uint32_t x = 0; x < width; x++, out += 4) {
+      if (colorType == 3) {
+        uint32_t index = sample(x, 0);
+        if (index * 3 + 2 >= palette.size()) {
+          outError = "PNG palette index out of range";
+          return false;
+        }
+        out[0] = palette[index * 3];
+        out[1] = palette[index * 3 + 1];
+        out[2] = palette[index * 3 + 2];
+        out[3] = index < transparency.size() ? transparency[index] : 255;
+        continue;
+      }
+      uint32_t values[4];
+      for (uint32_t c = 0; c < channels; c++)
+        values[c] = sample(x, c);
+      bool gray = colorType == 0 || colorType == 4;
+      out[0] = to8(values[0]);
+      out[1] = to8(values[gray ? 0 : 1]);
+      out[2] = to8(values[gray ? 0 : 2]);
+      out[3] = colorType == 4   ? to8(values[1])
+               : colorType == 6 ? to8(values[3])
+                                : 255;
+      // tRNS on gray / RGB: one fully transparent color key
+      if (colorType == 0 && transparency.size() >= 2 &&
+          values[0] == (uint32_t)(transparency[0] << 8 | transparency[1]))
+        out[3] = 0;
+      if (colorType == 2 && transparency.size() >= 6 &&
+          values[0] == (uint32_t)(transparency[0] << 8 | transparency[1]) &&
+          values[1] == (uint32_t)(transparency[2] << 8 | transparency[3]) &&
+          values[2] == (uint32_t)(transparency[4] << 8 | transparency[5]))
+        out[3] = 0;
+    }
+  }
+  return true;
+}
+
+std::vector<uint8_t> EncodePNG(const ImportedImage &image) {
+  const size_t rowBytes = (size_t)image.Width * 4;
+
+  // Per row, the filter with the smallest sum of absolute residuals
+  std::vector<uint8_t> filtered((rowBytes + 1) * image.Height);
+  std::vector<uint8_t> candidate(rowBytes), zeros(rowBytes, 0);
+  for (uint32_t y = 0; y < image.Height; y++) {
+    const uint8_t *row = image.Pixels.data() + y * rowBytes;
+    const uint8_t *previous = y > 0 ? row - rowBytes : zeros.data();
+    uint8_t *out = filtered.data() + y * (rowBytes + 1);
+    uint64_t bestCost = ~0ull;
+    for (uint8_t type = 0; type < 5; type++) {
+      uint64_t cost = 0;
+      for (size_t i = 0; i < rowBytes; i++) {
+        int a = i >= 4 ? row[i - 4] : 0;
+        int b = previous[i];
+        int c = i >= 4 ? previous[i - 4] : 0;
+        int predicted = type == 0   ? 0
+                        : type == 1 ? a
+                        : type == 2 ? b
+                        : type == 3 ? (a + b) >> 1
+                                    : Paeth(a, b, c);
+        candidate[i] = (uint8_t)(row[i] - predicted);
+        cost += std::abs((int)(int8_t)candidate[i]);
+      }
+      if (cost < bestCost) {
+        bestCost = cost;
+        out[0] = type;
+        std::copy(candidate.begin(), candidate.end(), out + 1);
+      }
+    }
+  }
+
+  std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  auto writeChunk = [&](const char *type, const std::vector<uint8_t> &data) {
+    WriteBE32(png, (uint32_t)data.size());
+    size_t start = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    WriteBE32(png, UpdateCRC32(0, png.data() + start, data.size() + 4));
+  };
+  std::vector<uint8_t> header;
+  WriteBE32(header, image.Width);
+  WriteBE32(header, image.Height);
+  header.insert(header.end(), {8, 6, 0, 0, 0}); // 8-bit RGBA
+  writeChunk("IHDR", header);
+  std::vector<uint8_t> compressed;
+  Deflate(filtered.data(), filtered.size(), compressed);
+  writeChunk("IDAT", compressed);
+  writeChunk("IEND", {});
+  return png;
+}
+
+} // namespace Forge
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Forge {
+
+// RGBA8 image as produced by an importer and consumed by TextureCooker
+struct ImportedImage {
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+  std::vector<uint8_t> Pixels; // RGBA8, rows top to bottom
+};
+
+// Source formats by extension. PNG: gray, gray + alpha, RGB, RGBA (8 and
+// 16 bits) and palette images, with tRNS transparency; Adam7-interlaced
+// files are rejected. 16-bit channels are rounded to 8 bits.
+bool ImportImage(const std::string &path, ImportedImage &outImage,
+                 std::string &outError);
+bool DecodePNG(const uint8_t *data, size_t size, ImportedImage &outImage,
+               std::string &outError);
+
+// RGBA8 PNG (per-row filters, fixed-Huffman deflate). Previews and
+// generated test images; not tuned for size.
+std::vector<uint8_t> EncodePNG(const ImportedImage &image);
+
+} // namespace Forge
@@ -0,0 +1,40 @@
+#include "FileWatcher.h"
+
+namespace Forge {
+
+FileWatcher::FileState FileWatcher::Stat(const std::string &path) {
+  FileState state;
+  std::error_code ec;
+  state.WriteTime = std::filesystem::last_write_time(path, ec);
+  if (ec)
+    return state;
+  state.Size = std::filesystem::file_size(path, ec);
+  state.Exists = !ec;
+  return state;
+}
+
+void FileWatcher::Watch(const std::string &path) {
+  if (!IsWatching(path))
+    m_Files[path] = Stat(path);
+}
+
+void FileWatcher::Unwatch(const std::string &path) { m_Files.erase(path); }
+
+void FileWatcher::Poll(std::vector<std::string> &outChanged) {
+  for (auto &[path, state] : m_Files) {
+    FileState current = Stat(path);
+    bool same = current.Exists == state.Exists &&
+                current.WriteTime == state.WriteTime &&
+                current.Size == state.Size;
+    if (!same) {
+      current.Pending = true;
+      state = current;
+    } else if (state.Pending && state.Exists) {
+      // Unchanged for a full poll interval: the write is done
+      state.Pending = false;
+      outChanged.push_back(path);
+    }
+  }
+}
+
+} // namespace Forge
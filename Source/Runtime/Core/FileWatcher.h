@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Forge {
+
+// Polling file watcher (last write time + size). Portable and cheap for
+// the handful of files an editor watches. A change is reported once the
+// file looks the same on two consecutive polls, so editors that save in
+// several writes are not picked up half-written. Not thread-safe.
+class FileWatcher {
+public:
+  // Records the current state; no change is reported for it
+  void Watch(const std::string &path);
+  void Unwatch(const std::string &path);
+  bool IsWatching(const std::string &path) const {
+    return m_Files.count(path) != 0;
+  }
+
+  // Appends the paths that changed and have settled since the last report
+  void Poll(std::vector<std::string> &outChanged);
+
+  size_t GetWatchCount() const { return m_Files.size(); }
+
+private:
+  struct FileState {
+    std::filesystem::file_time_type WriteTime{};
+    uintmax_t Size = 0;
+    bool Exists = false;
+    bool Pending = false; // changed, waiting to settle
+  };
+
+  static FileState Stat(const std::string &path);
+
+  std::unordered_map<std::string, FileState> m_Files;
+};
+
+} // namespace Forge
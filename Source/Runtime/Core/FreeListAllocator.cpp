@@ -0,0 +1,103 @@
+#include "FreeListAllocator.h"
+
+namespace Forge {
+
+void FreeListAllocator::Reset(uint64_t capacity) {
+  m_Capacity = capacity;
+  m_UsedSize = 0;
+  m_Allocations = 0;
+  m_FailedAllocations = 0;
+  m_FreeByOffset.clear();
+  m_FreeBySize.clear();
+  if (capacity > 0)
+    InsertFree(0, capacity);
+}
+
+void FreeListAllocator::InsertFree(uint64_t offset, uint64_t size) {
+  m_FreeByOffset[offset] = size;
+  m_FreeBySize.emplace(size, offset);
+}
+
+void FreeListAllocator::EraseFree(std::map<uint64_t, uint64_t>::iterator it) {
+  auto range = m_FreeBySize.equal_range(it->second);
+  for (auto sizeIt = range.first; sizeIt != range.second; ++sizeIt) {
+    if (sizeIt->second == it->first) {
+      m_FreeBySize.erase(sizeIt);
+      break;
+    }
+  }
+  m_FreeByOffset.erase(it);
+}
+
+uint64_t FreeListAllocator::Allocate(uint64_t size, uint64_t alignment) {
+  if (size == 0)
+    return InvalidOffset;
+  if (alignment == 0)
+    alignment = 1;
+
+  // Smallest block that fits (including alignment padding)
+  for (auto it = m_FreeBySize.lower_bound(size); it != m_FreeBySize.end();
+       ++it) {
+    uint64_t blockOffset = it->second;
+    uint64_t blockSize = it->first;
+    uint64_t aligned = (blockOffset + alignment - 1) & ~(alignment - 1);
+    uint64_t padding = aligned - blockOffset;
+    if (padding + size > blockSize)
+      continue;
+
+    EraseFree(m_FreeByOffset.find(blockOffset));
+    if (padding > 0)
+      InsertFree(blockOffset, padding);
+    uint64_t remainder = blockSize - padding - size;
+    if (remainder > 0)
+      InsertFree(aligned + size, remainder);
+
+    m_UsedSize += size;
+    m_Allocations++;
+    return aligned;
+  }
+
+  m_FailedAllocations++;
+  return InvalidOffset;
+}
+
+void FreeListAllocator::Free(uint64_t offset, uint64_t size) {
+  if (size == 0)
+    return;
+
+  m_UsedSize -= size;
+  m_Allocations--;
+
+  // Merge with the neighbours
+  auto next = m_FreeByOffset.lower_bound(offset);
+  if (next != m_FreeByOffset.end() && offset + size == next->first) {
+    size += next->second;
+    EraseFree(next);
+  }
+
+  auto prev = m_FreeByOffset.lower_bound(offset);
+  if (prev != m_FreeByOffset.begin()) {
+    --prev;
+    if (prev->first + prev->second == offset) {
+      offset = prev->first;
+      size += prev->second;
+      EraseFree(prev);
+    }
+  }
+
+  InsertFree(offset, size);
+}
+
+FreeListStats FreeListAllocator::GetStats() const {
+  FreeListStats stats;
+  stats.Capacity = m_Capacity;
+  stats.UsedSize = m_UsedSize;
+  stats.Allocations = m_Allocations;
+  stats.FreeBlocks = m_FreeByOffset.size();
+  stats.LargestFreeBlock =
+      m_FreeBySize.empty() ? 0 : m_FreeBySize.rbegin()->first;
+  stats.FailedAllocations = m_FailedAllocations;
+  return stats;
+}
+
+} // namespace Forge
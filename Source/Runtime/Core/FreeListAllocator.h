@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <map>
+
+namespace Forge {
+
+struct FreeListStats {
+  uint64_t Capacity = 0;
+  uint64_t UsedSize = 0;
+  uint64_t Allocations = 0; // live
+  uint64_t FreeBlocks = 0;
+  uint64_t LargestFreeBlock = 0;
+  uint64_t FailedAllocations = 0;
+
+  // 0 = all free space is one block, ->1 = free space is scattered
+  double GetFragmentation() const {
+    uint64_t freeSize = Capacity - UsedSize;
+    return freeSize == 0 ? 0.0
+                         : 1.0 - (double)LargestFreeBlock / (double)freeSize;
+  }
+};
+
+// Best-fit range allocator over [0, capacity) with coalescing frees.
+// Unit-agnostic (bytes, descriptor slots, ...). Not thread-safe.
+class FreeListAllocator {
+public:
+  static constexpr uint64_t InvalidOffset = UINT64_MAX;
+
+  explicit FreeListAllocator(uint64_t capacity = 0) { Reset(capacity); }
+
+  void Reset(uint64_t capacity);
+
+  // alignment must be a power of two
+  uint64_t Allocate(uint64_t size, uint64_t alignment = 1);
+  void Free(uint64_t offset, uint64_t size);
+
+  FreeListStats GetStats() const;
+
+private:
+  void InsertFree(uint64_t offset, uint64_t size);
+  void EraseFree(std::map<uint64_t, uint64_t>::iterator it);
+
+  uint64_t m_Capacity = 0;
+  uint64_t m_UsedSize = 0;
+  uint64_t m_Allocations = 0;
+  uint64_t m_FailedAllocations = 0;
+
+  std::map<uint64_t, uint64_t> m_FreeByOffset;     // offset -> size
+  std::multimap<uint64_t, uint64_t> m_FreeBySize;  // size -> offset
+};
+
+} // namespace Forge
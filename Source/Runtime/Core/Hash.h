@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Forge {
+
+// 64-bit FNV-1a. Used for content keys (shader cache, pipeline cache), not
+// for security.
+static constexpr uint64_t HashSeed = 0xcbf29ce484222325ull;
+
+inline uint64_t HashBytes(const void *data, size_t size,
+                          uint64_t hash = HashSeed) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+inline uint64_t HashString(std::string_view text, uint64_t hash = HashSeed) {
+  // Length first so ("ab","c") and ("a","bc") differ
+  uint64_t length = text.size();
+  hash = HashBytes(&length, sizeof(length), hash);
+  return HashBytes(text.data(), text.size(), hash);
+}
+
+template <typename T> inline uint64_t HashValue(const T &value, uint64_t hash) {
+  return HashBytes(&value, sizeof(T), hash);
+}
+
+} // namespace Forge
@@ -0,0 +1,146 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <string>
+
+namespace Forge {
+
+JobSystem::JobSystem(uint32_t workerCount, WorkerCallback onWorkerStart,
+                     WorkerCallback onWorkerStop)
+    : m_OnWorkerStart(std::move(onWorkerStart)),
+      m_OnWorkerStop(std::move(onWorkerStop)) {
+  if (workerCount == 0) {
+    uint32_t hardwareThreads = std::thread::hardware_concurrency();
+    workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+  }
+
+  m_Workers.reserve(workerCount);
+  for (uint32_t i = 0; i < workerCount; i++) {
+    m_Workers.emplace_back(&JobSystem::WorkerMain, this, i);
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Quit = true;
+  }
+  m_WakeCondition.notify_all();
+  for (std::thread &worker : m_Workers) {
+    worker.join();
+  }
+}
+
+JobSystem &JobSystem::Get() {
+  static JobSystem s_Instance;
+  return s_Instance;
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize,
+                            const RangeFunction &function) {
+  if (count == 0)
+    return;
+
+  batchSize = std::max(batchSize, 1u);
+  uint32_t callerIndex = GetThreadCount() - 1;
+  if (m_Workers.empty() || count <= batchSize) {
+    function(0, count, callerIndex);
+    return;
+  }
+
+  std::lock_guard<std::mutex> parallelLock(m_ParallelForMutex);
+
+  ParallelJob job;
+  job.Function = &function;
+  job.Count = count;
+  job.BatchSize = batchSize;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_ActiveJob = &job;
+    m_JobGeneration++;
+  }
+  m_WakeCondition.notify_all();
+
+  RunBatches(job, callerIndex);
+
+  // No new worker may join once the job is unpublished; wait for the ones
+  // still inside RunBatches (job lives on this stack frame).
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_ActiveJob = nullptr;
+  m_DoneCondition.wait(lock, [&job] { return job.ActiveWorkers == 0; });
+}
+
+void JobSystem::Submit(std::function<void()> task) {
+  if (m_Workers.empty()) {
+    task();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Tasks.push_back(std::move(task));
+  }
+  m_WakeCondition.notify_one();
+}
+
+void JobSystem::RunBatches(ParallelJob &job, uint32_t workerIndex) {
+  for (;;) {
+    uint32_t begin = job.NextIndex.fetch_add(job.BatchSize);
+    if (begin >= job.Count)
+      break;
+    uint32_t end = std::min(begin + job.BatchSize, job.Count);
+    (*job.Function)(begin, end, workerIndex);
+  }
+}
+
+void JobSystem::WorkerMain(uint32_t workerIndex) {
+#if FORGE_PROFILE
+  Profiler::SetThreadName("Job Worker " + std::to_string(workerIndex));
+#endif
+  if (m_OnWorkerStart)
+    m_OnWorkerStart(workerIndex);
+
+  uint64_t seenGeneration = 0;
+  for (;;) {
+    ParallelJob *job = nullptr;
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_WakeCondition.wait(lock, [&] {
+        return m_Quit || !m_Tasks.empty() ||
+               (m_ActiveJob && m_JobGeneration != seenGeneration);
+      });
+
+      if (m_ActiveJob && m_JobGeneration != seenGeneration) {
+        job = m_ActiveJob;
+        job->ActiveWorkers++;
+        seenGeneration = m_JobGeneration;
+      } else if (!m_Tasks.empty()) {
+        task = std::move(m_Tasks.front());
+        m_Tasks.pop_front();
+      } else {
+        break; // m_Quit with nothing left to do
+      }
+    }
+
+    if (job) {
+      {
+        FORGE_PROFILE_SCOPE("ParallelFor");
+        RunBatches(*job, workerIndex);
+      }
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        job->ActiveWorkers--;
+      }
+      m_DoneCondition.notify_all();
+    } else {
+      FORGE_PROFILE_SCOPE("Job Task");
+      task();
+    }
+  }
+
+  if (m_OnWorkerStop)
+    m_OnWorkerStop(workerIndex);
+}
+
+} // namespace Forge
@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Forge {
+
+// 고정 크기 워커 스레드 풀
+// ParallelFor는 호출 스레드도 작업에 참여하고, 끝날 때까지 반환하지 않는다.
+class JobSystem {
+public:
+  // Called on each worker right after it starts / right before it exits
+  // (e.g. to attach the thread to a runtime such as Mono).
+  using WorkerCallback = std::function<void(uint32_t workerIndex)>;
+  // [begin, end) slice, workerIndex in [0, GetThreadCount())
+  using RangeFunction =
+      std::function<void(uint32_t begin, uint32_t end, uint32_t workerIndex)>;
+
+  // workerCount == 0 => hardware_concurrency - 1
+  explicit JobSystem(uint32_t workerCount = 0,
+                     WorkerCallback onWorkerStart = nullptr,
+                     WorkerCallback onWorkerStop = nullptr);
+  ~JobSystem();
+
+  JobSystem(const JobSystem &) = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+
+  // Workers + the calling thread. The caller always uses the last index.
+  uint32_t GetThreadCount() const { return (uint32_t)m_Workers.size() + 1; }
+
+  void ParallelFor(uint32_t count, uint32_t batchSize,
+                   const RangeFunction &function);
+
+  // Fire-and-forget background task (not run by ParallelFor callers)
+  void Submit(std::function<void()> task);
+
+  // Shared pool for engine systems that don't need per-thread setup
+  static JobSystem &Get();
+
+private:
+  struct ParallelJob {
+    const RangeFunction *Function = nullptr;
+    uint32_t Count = 0;
+    uint32_t BatchSize = 1;
+    std::atomic<uint32_t> NextIndex = 0;
+    uint32_t ActiveWorkers = 0; // guarded by m_Mutex
+  };
+
+  void WorkerMain(uint32_t workerIndex);
+  static void RunBatches(ParallelJob &job, uint32_t workerIndex);
+
+  std::vector<std::thread> m_Workers;
+  WorkerCallback m_OnWorkerStart;
+  WorkerCallback m_OnWorkerStop;
+
+  std::mutex m_Mutex;
+  std::condition_variable m_WakeCondition;
+  std::condition_variable m_DoneCondition;
+  std::deque<std::function<void()>> m_Tasks;
+  ParallelJob *m_ActiveJob = nullptr;
+  uint64_t m_JobGeneration = 0;
+  bool m_Quit = false;
+
+  std::mutex m_ParallelForMutex; // one ParallelFor at a time per pool
+};
+
+} // namespace Forge
@@ -0,0 +1,107 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Forge {
+
+MappedFile::MappedFile(MappedFile &&other) noexcept { *this = std::move(other); }
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    Close();
+    std::swap(m_Data, other.m_Data);
+    std::swap(m_Size, other.m_Size);
+#ifdef _WIN32
+    std::swap(m_File, other.m_File);
+    std::swap(m_Mapping, other.m_Mapping);
+#endif
+  }
+  return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string &path) {
+  Close();
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
+  }
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  void *data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+                       : nullptr;
+  if (!data) {
+    if (mapping)
+      CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+  m_File = file;
+  m_Mapping = mapping;
+  m_Data = static_cast<const uint8_t *>(data);
+  m_Size = (size_t)size.QuadPart;
+  return true;
+}
+
+void MappedFile::Close() {
+  if (m_Data)
+    UnmapViewOfFile(m_Data);
+  if (m_Mapping)
+    CloseHandle(m_Mapping);
+  if (m_File)
+    CloseHandle(m_File);
+  m_Data = nullptr;
+  m_Size = 0;
+  m_File = nullptr;
+  m_Mapping = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::string &path) {
+  Close();
+  int file = open(path.c_str(), O_RDONLY);
+  if (file < 0)
+    return false;
+  struct stat info;
+  if (fstat(file, &info) != 0 || info.st_size == 0) {
+    close(file);
+    return false;
+  }
+  void *data =
+      mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file); // the mapping keeps the file referenced
+  if (data == MAP_FAILED)
+    return false;
+  m_Data = static_cast<const uint8_t *>(data);
+  m_Size = (size_t)info.st_size;
+  return true;
+}
+
+void MappedFile::Close() {
+  if (m_Data)
+    munmap(const_cast<uint8_t *>(m_Data), m_Size);
+  m_Data = nullptr;
+  m_Size = 0;
+}
+
+#endif
+
+} // namespace Forge
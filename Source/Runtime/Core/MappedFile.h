@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Forge {
+
+// Read-only memory-mapped file (mmap / CreateFileMapping). Pages are loaded
+// on first touch, so a cooked asset can be handed to an upload without
+// being read into a heap buffer first. Move-only.
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile() { Close(); }
+
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // Empty files cannot be mapped and fail to open
+  bool Open(const std::string &path);
+  void Close();
+
+  bool IsOpen() const { return m_Data != nullptr; }
+  const uint8_t *GetData() const { return m_Data; }
+  size_t GetSize() const { return m_Size; }
+
+private:
+  const uint8_t *m_Data = nullptr;
+  size_t m_Size = 0;
+#ifdef _WIN32
+  void *m_File = nullptr;    // HANDLE
+  void *m_Mapping = nullptr; // HANDLE
+#endif
+};
+
+} // namespace Forge
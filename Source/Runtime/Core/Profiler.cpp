@@ -0,0 +1,374 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define FORGE_PROFILER_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define FORGE_PROFILER_TSC 0
+#endif
+
+namespace Forge {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Marker timestamps: the TSC where there is one (a few ns to read, against
+// tens for the OS clock), converted to nanoseconds when a frame collects
+// them
+int64_t ReadTicks() {
+#if FORGE_PROFILER_TSC
+  return (int64_t)__rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+// As recorded; Start and End in ticks
+struct RawEvent {
+  const char *Name;
+  int64_t Start;
+  int64_t End;
+  uint32_t Depth;
+};
+
+// One thread's events. The thread is the only writer of Events and Head;
+// the collector (under ProfilerData::Mutex) is the only writer of Tail.
+// A slot is written only once the collector has moved Tail past it, so
+// neither side ever waits for or races with the other. Tracks have no ring.
+struct ThreadBuffer {
+  std::unique_ptr<RawEvent[]> Events;
+  std::atomic<uint64_t> Head = 0; // events written
+  std::atomic<uint64_t> Tail = 0; // events collected
+  std::atomic<uint64_t> Dropped = 0;
+  uint32_t Index = 0;
+  uint32_t Depth = 0; // open scopes, writer only
+  std::string Name;   // under ProfilerData::Mutex
+};
+
+struct ProfilerData {
+  std::atomic<bool> Enabled = true;
+  Clock::time_point Epoch = Clock::now();
+  int64_t EpochTicks = ReadTicks();
+
+  std::mutex Mutex;
+  // Buffers outlive their threads (the names stay in the history)
+  std::vector<std::unique_ptr<ThreadBuffer>> Threads;
+  std::deque<ProfileFrame> History;
+  std::vector<ProfileFrame> Capture;
+  bool Capturing = false;
+  uint64_t FrameIndex = 0;
+  // Tick to nanosecond conversion: each frame's events are placed
+  // relative to its start, with the rate measured over the whole run
+  int64_t FrameStartTicks = EpochTicks;
+  int64_t FrameStartNs = 0;
+  uint64_t Events = 0;
+  uint64_t DroppedBefore = 0; // of buffers at the last Reset
+  // Track events that started in the open frame
+  std::vector<ProfileEvent> TrackEvents;
+  std::unordered_set<std::string> Names; // InternName
+};
+
+ProfilerData &GetData() {
+  static ProfilerData s_Data;
+  return s_Data;
+}
+
+thread_local ThreadBuffer *t_Buffer = nullptr;
+
+ThreadBuffer &GetThreadBuffer() {
+  if (!t_Buffer) {
+    ProfilerData &data = GetData();
+    std::lock_guard<std::mutex> lock(data.Mutex);
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->Events.reset(new RawEvent[Profiler::ThreadBufferEvents]);
+    buffer->Index = (uint32_t)data.Threads.size();
+    buffer->Name = "Thread " + std::to_string(buffer->Index);
+    t_Buffer = buffer.get();
+    data.Threads.push_back(std::move(buffer));
+  }
+  return *t_Buffer;
+}
+
+} // namespace
+
+void WriteJsonString(std::ostream &out, const std::string &str) {
+  out << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\')
+      out << '\\';
+    out << c;
+  }
+  out << '"';
+}
+
+void Profiler::SetEnabled(bool enabled) { GetData().Enabled = enabled; }
+
+bool Profiler::IsEnabled() {
+  return GetData().Enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::Reset() {
+  ProfilerData &data = GetData();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+  data.History.clear();
+  data.Capture.clear();
+  data.TrackEvents.clear();
+  data.Capturing = false;
+  data.Events = 0;
+  data.DroppedBefore = 0;
+  for (const auto &buffer : data.Threads)
+    data.DroppedBefore += buffer->Dropped.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const std::string &name) {
+  ThreadBuffer &buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> lock(GetData().Mutex);
+  buffer.Name = name;
+}
+
+std::vector<std::string> Profiler::GetThreadNames() {
+  ProfilerData &data = GetData();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+  std::vector<std::string> names;
+  for (const auto &buffer : data.Threads)
+    names.push_back(buffer->Name);
+  return names;
+}
+
+uint32_t Profiler::CreateTrack(const std::string &name) {
+  ProfilerData &data = GetData();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+  auto buffer = std::make_unique<ThreadBuffer>();
+  buffer->Index = (uint32_t)data.Threads.size();
+  buffer->Name = name;
+  data.Threads.push_back(std::move(buffer));
+  return data.Threads.back()->Index;
+}
+
+void Profiler::AddTrackEvent(uint32_t track, const char *name,
+                             int64_t startNs, int64_t endNs, uint32_t depth) {
+  ProfilerData &data = GetData();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+  const ProfileEvent event = {name, startNs, endNs, track, depth};
+  if (startNs >= data.FrameStartNs) {
+    data.TrackEvents.push_back(event);
+    return;
+  }
+  auto frame = std::find_if(
+      data.History.rbegin(), data.History.rend(),
+      [&](const ProfileFrame &frame) { return frame.StartNs <= startNs; });
+  if (frame == data.History.rend()) {
+    // Older than the history
+    data.Threads[track]->Dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  frame->Events.push_back(event);
+  data.Events++;
+  for (auto captured = data.Capture.rbegin(); captured != data.Capture.rend();
+       ++captured) {
+    if (captured->Index > frame->Index)
+      continue;
+    if (captured->Index == frame->Index)
+      captured->Events.push_back(event);
+    break;
+  }
+}
+
+int64_t Profiler::GetTimeNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now() - GetData().Epoch)
+      .count();
+}
+
+const char *Profiler::InternName(const std::string &name) {
+  ProfilerData &data = GetData();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+  return data.Names.insert(name).first->c_str();
+}
+
+int64_t Profiler::Now() { return ReadTicks(); }
+
+uint32_t Profiler::BeginScope() { return GetThreadBuffer().Depth++; }
+
+void Profiler::EndScope(const char *name, int64_t start, uint32_t depth) {
+  int64_t end = Now();
+  ThreadBuffer &buffer = GetThreadBuffer();
+  buffer.Depth = depth;
+  uint64_t head = buffer.Head.load(std::memory_order_relaxed);
+  if (head - buffer.Tail.load(std::memory_order_acquire) >=
+      ThreadBufferEvents) {
+    buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.Events[head % ThreadBufferEvents] = {name, start, end, depth};
+  buffer.Head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::NextFrame() {
+  ProfilerData &data = GetData();
+  const int64_t nowTicks = ReadTicks();
+  const Clock::time_point now = Clock::now();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+
+  double nsPerTick = 1.0;
+#if FORGE_PROFILER_TSC
+  if (nowTicks > data.EpochTicks) {
+    nsPerTick =
+        std::chrono::duration<double, std::nano>(now - data.Epoch).count() /
+        (double)(nowTicks - data.EpochTicks);
+  }
+#endif
+  auto toNs = [&](int64_t ticks) {
+    return data.FrameStartNs +
+           (int64_t)((double)(ticks - data.FrameStartTicks) * nsPerTick);
+  };
+
+  ProfileFrame frame;
+  frame.Index = data.FrameIndex++;
+  frame.StartNs = data.FrameStartNs;
+  frame.EndNs = toNs(nowTicks);
+  size_t eventCount = 0;
+  for (const auto &buffer : data.Threads) {
+    eventCount += buffer->Head.load(std::memory_order_acquire) -
+                  buffer->Tail.load(std::memory_order_relaxed);
+  }
+  frame.Events.reserve(eventCount);
+  for (const auto &buffer : data.Threads) {
+    uint64_t tail = buffer->Tail.load(std::memory_order_relaxed);
+    uint64_t head = buffer->Head.load(std::memory_order_acquire);
+    for (uint64_t i = tail; i < head; i++) {
+      const RawEvent &raw = buffer->Events[i % ThreadBufferEvents];
+      frame.Events.push_back({raw.Name, toNs(raw.Start), toNs(raw.End),
+                              buffer->Index, raw.Depth});
+    }
+    buffer->Tail.store(head, std::memory_order_release);
+  }
+  // Track events timed past this frame (a queue clock running slightly
+  // ahead) wait for the frame they started in
+  auto later = std::stable_partition(
+      data.TrackEvents.begin(), data.TrackEvents.end(),
+      [&](const ProfileEvent &event) { return event.StartNs < frame.EndNs; });
+  frame.Events.insert(frame.Events.end(), data.TrackEvents.begin(), later);
+  data.TrackEvents.erase(data.TrackEvents.begin(), later);
+  data.FrameStartTicks = nowTicks;
+  data.FrameStartNs = frame.EndNs;
+  data.Events += frame.Events.size();
+
+  if (data.Capturing && data.Capture.size() < MaxCaptureFrames)
+    data.Capture.push_back(frame);
+  data.History.push_back(std::move(frame));
+  while (data.History.size() > HistoryFrames)
+    data.History.pop_front();
+}
+
+std::vector<ProfileFrame> Profiler::GetHistory() {
+  ProfilerData &data = GetData();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+  return {data.History.begin(), data.History.end()};
+}
+
+void Profiler::StartCapture() {
+  ProfilerData &data = GetData();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+  data.Capture.clear();
+  data.Capturing = true;
+}
+
+void Profiler::StopCapture() {
+  ProfilerData &data = GetData();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+  data.Capturing = false;
+}
+
+bool Profiler::IsCapturing() {
+  ProfilerData &data = GetData();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+  return data.Capturing;
+}
+
+bool Profiler::ExportTrace(const std::string &path) {
+  std::ofstream out(path);
+  if (!out) {
+    std::cerr << "[Profiler] Failed to open " << path << std::endl;
+    return false;
+  }
+
+  ProfilerData &data = GetData();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+  std::vector<const ProfileFrame *> frames;
+  if (!data.Capture.empty()) {
+    for (const ProfileFrame &frame : data.Capture)
+      frames.push_back(&frame);
+  } else {
+    for (const ProfileFrame &frame : data.History)
+      frames.push_back(&frame);
+  }
+
+  // Timestamps in microseconds, with nanosecond digits
+  auto writeUs = [&](int64_t ns) {
+    out << ns / 1000 << '.' << (char)('0' + ns / 100 % 10)
+        << (char)('0' + ns / 10 % 10) << (char)('0' + ns % 10);
+  };
+
+  out << "{\"traceEvents\":[\n";
+  bool first = true;
+  for (const auto &buffer : data.Threads) {
+    out << (first ? "" : ",\n")
+        << "{\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->Index
+        << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+    WriteJsonString(out, buffer->Name);
+    out << "}}";
+    first = false;
+  }
+  size_t eventCount = 0;
+  for (const ProfileFrame *frame : frames) {
+    for (const ProfileEvent &e : frame->Events) {
+      out << (first ? "" : ",\n") << "{\"ph\":\"X\",\"pid\":0,\"tid\":"
+          << e.Thread << ",\"ts\":";
+      writeUs(e.StartNs);
+      out << ",\"dur\":";
+      writeUs(e.EndNs - e.StartNs);
+      out << ",\"cat\":\"cpu\",\"name\":";
+      WriteJsonString(out, e.Name);
+      out << ",\"args\":{\"frame\":" << frame->Index << "}}";
+      first = false;
+      eventCount++;
+    }
+  }
+  out << "\n]}\n";
+
+  std::cout << "[Profiler] Exported " << eventCount << " events ("
+            << frames.size() << " frames) to " << path << std::endl;
+  return true;
+}
+
+ProfilerStats Profiler::GetStats() {
+  ProfilerData &data = GetData();
+  std::lock_guard<std::mutex> lock(data.Mutex);
+  ProfilerStats stats;
+  stats.Threads = (uint32_t)data.Threads.size();
+  stats.Events = data.Events;
+  for (const auto &buffer : data.Threads)
+    stats.DroppedEvents += buffer->Dropped.load(std::memory_order_relaxed);
+  stats.DroppedEvents -= data.DroppedBefore;
+  stats.CapturedFrames = (uint32_t)data.Capture.size();
+  return stats;
+}
+
+} // namespace Forge
@@ -0,0 +1,138 @@
+#pragma once
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Markers are compiled in when FORGE_PROFILE is 1 (CMake option
+// FORGE_ENABLE_PROFILER); otherwise FORGE_PROFILE_SCOPE and
+// FORGE_PROFILE_FRAME expand to nothing and their arguments are not
+// evaluated.
+#ifndef FORGE_PROFILE
+#define FORGE_PROFILE 0
+#endif
+
+namespace Forge {
+
+// A finished scope. Name is the marker's string literal.
+struct ProfileEvent {
+  const char *Name;
+  int64_t StartNs; // since the profiler's epoch
+  int64_t EndNs;
+  uint32_t Thread; // index into Profiler::GetThreadNames
+  uint32_t Depth;  // nesting on its thread, 0 = outermost
+};
+
+// The events that finished between two FORGE_PROFILE_FRAME markers, each
+// thread's in the order they ended (children before their parent)
+struct ProfileFrame {
+  uint64_t Index = 0;
+  int64_t StartNs = 0;
+  int64_t EndNs = 0;
+  std::vector<ProfileEvent> Events;
+};
+
+struct ProfilerStats {
+  uint32_t Threads = 0;
+  uint64_t Events = 0;        // collected since start or Reset
+  uint64_t DroppedEvents = 0; // a thread outran its buffer within a frame
+  uint32_t CapturedFrames = 0;
+};
+
+// Hierarchical CPU profiler. FORGE_PROFILE_SCOPE("Name") times the rest
+// of the enclosing block; the event goes to a buffer owned by the calling
+// thread (a ring with one writer, published by an atomic index), so
+// markers take no locks and never wait for the reader. FORGE_PROFILE_FRAME
+// on the main thread closes a frame: every thread's new events are
+// collected into it, and the last HistoryFrames frames are kept for the
+// editor panel. A capture additionally keeps every frame until it stops
+// (up to MaxCaptureFrames), for ExportTrace (Chrome trace JSON,
+// chrome://tracing / Perfetto).
+//
+// Names must outlive the profiler (string literals). Events of scopes that
+// end after a frame marker belong to the next frame.
+class Profiler {
+public:
+  static constexpr uint32_t HistoryFrames = 240;
+  static constexpr uint32_t MaxCaptureFrames = 3600;
+  // Per thread; events a thread finishes past this within one frame are
+  // dropped (counted in ProfilerStats::DroppedEvents)
+  static constexpr uint32_t ThreadBufferEvents = 1u << 15;
+
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled();
+  // Drops the history, the capture and the totals
+  static void Reset();
+
+  // Shown in the panel and the trace; threads are "Thread N" until named
+  static void SetThreadName(const std::string &name);
+  // Threads and tracks, by ProfileEvent::Thread
+  static std::vector<std::string> GetThreadNames();
+
+  // A timeline that is not a CPU thread (a GPU queue). Its events arrive
+  // late, with absolute times, and are filed into the frame they started in
+  // while that frame is still in the history (and the capture).
+  static uint32_t CreateTrack(const std::string &name);
+  static void AddTrackEvent(uint32_t track, const char *name, int64_t startNs,
+                            int64_t endNs, uint32_t depth);
+  // Now, on the events' timescale
+  static int64_t GetTimeNs();
+  // A stable copy of a name that is not a string literal
+  static const char *InternName(const std::string &name);
+
+  // Closes the current frame (FORGE_PROFILE_FRAME)
+  static void NextFrame();
+  // Oldest first; the last entry is the newest complete frame
+  static std::vector<ProfileFrame> GetHistory();
+
+  static void StartCapture();
+  static void StopCapture();
+  static bool IsCapturing();
+  // Captured frames, or the history when nothing was captured
+  static bool ExportTrace(const std::string &path);
+
+  static ProfilerStats GetStats();
+
+  // Marker internals (Now is in ticks, see ProfileFrame for nanoseconds)
+  static int64_t Now();
+  static uint32_t BeginScope(); // depth of the new scope
+  static void EndScope(const char *name, int64_t start, uint32_t depth);
+};
+
+// Quoted, escaped JSON string (trace exports)
+void WriteJsonString(std::ostream &out, const std::string &str);
+
+class ProfileScope {
+public:
+  explicit ProfileScope(const char *name)
+      : m_Name(Profiler::IsEnabled() ? name : nullptr) {
+    if (m_Name) {
+      m_Depth = Profiler::BeginScope();
+      m_Start = Profiler::Now();
+    }
+  }
+  ~ProfileScope() {
+    if (m_Name)
+      Profiler::EndScope(m_Name, m_Start, m_Depth);
+  }
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+  const char *m_Name;
+  int64_t m_Start = 0;
+  uint32_t m_Depth = 0;
+};
+
+} // namespace Forge
+
+#if FORGE_PROFILE
+#define FORGE_PROFILE_CONCAT_INNER(a, b) a##b
+#define FORGE_PROFILE_CONCAT(a, b) FORGE_PROFILE_CONCAT_INNER(a, b)
+#define FORGE_PROFILE_SCOPE(name)                                              \
+  ::Forge::ProfileScope FORGE_PROFILE_CONCAT(forgeProfileScope, __LINE__)(name)
+#define FORGE_PROFILE_FRAME() ::Forge::Profiler::NextFrame()
+#else
+#define FORGE_PROFILE_SCOPE(name)
+#define FORGE_PROFILE_FRAME()
+#endif
@@ -0,0 +1,66 @@
+#include "RingAllocator.h"
+#include <algorithm>
+
+namespace Forge {
+
+void RingAllocator::Reset(uint64_t capacity) {
+  m_Capacity = capacity;
+  m_Head = 0;
+  m_Tail = 0;
+  m_FrameStart = 0;
+  m_Frames.clear();
+  m_Stats = {};
+  m_Stats.Capacity = capacity;
+}
+
+uint64_t RingAllocator::Allocate(uint64_t size, uint64_t alignment) {
+  if (m_Capacity == 0) {
+    m_Stats.FailedAllocations++;
+    return InvalidOffset;
+  }
+  if (alignment == 0)
+    alignment = 1;
+
+  uint64_t offset = m_Head % m_Capacity;
+  uint64_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+  uint64_t padding = aligned - offset;
+
+  // Doesn't fit before the end: skip the tail and start over at 0
+  if (aligned + size > m_Capacity) {
+    padding = m_Capacity - offset;
+    aligned = 0;
+  }
+
+  if (size > m_Capacity || GetUsedBytes() + padding + size > m_Capacity) {
+    m_Stats.FailedAllocations++;
+    return InvalidOffset;
+  }
+
+  m_Head += padding + size;
+  m_Stats.Allocations++;
+  m_Stats.UsedBytes = GetUsedBytes();
+  m_Stats.PeakUsedBytes = std::max(m_Stats.PeakUsedBytes, m_Stats.UsedBytes);
+  m_Stats.FrameBytes = m_Head - m_FrameStart;
+  return aligned;
+}
+
+void RingAllocator::FinishFrame(uint64_t fenceValue) {
+  m_Frames.push_back({fenceValue, m_Head});
+  m_FrameStart = m_Head;
+}
+
+void RingAllocator::Reclaim(uint64_t completedFenceValue) {
+  while (!m_Frames.empty() &&
+         m_Frames.front().FenceValue <= completedFenceValue) {
+    m_Tail = m_Frames.front().Head;
+    m_Frames.pop_front();
+  }
+
+  // Fully drained: rewind so the next frame gets contiguous space
+  if (m_Frames.empty() && m_Tail == m_Head && m_FrameStart == m_Head) {
+    m_Head = m_Tail = m_FrameStart = 0;
+  }
+  m_Stats.UsedBytes = GetUsedBytes();
+}
+
+} // namespace Forge
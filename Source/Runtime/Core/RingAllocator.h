@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+
+namespace Forge {
+
+struct RingAllocatorStats {
+  uint64_t Capacity = 0;
+  uint64_t UsedBytes = 0;     // live bytes incl. alignment / wrap padding
+  uint64_t PeakUsedBytes = 0;
+  uint64_t FrameBytes = 0;    // allocated since the last FinishFrame
+  uint64_t Allocations = 0;
+  uint64_t FailedAllocations = 0;
+};
+
+// Linear ring over [0, capacity) reclaimed by fence value.
+// Allocations never straddle the end; the tail is skipped instead.
+// Offsets only - the owner maps them onto real memory. Not thread-safe.
+class RingAllocator {
+public:
+  static constexpr uint64_t InvalidOffset = UINT64_MAX;
+
+  explicit RingAllocator(uint64_t capacity = 0) { Reset(capacity); }
+
+  void Reset(uint64_t capacity);
+
+  // alignment must be a power of two. Returns InvalidOffset when the ring
+  // is full (the GPU has not released enough frames yet).
+  uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+  // Every allocation since the previous call is released once fenceValue
+  // has completed.
+  void FinishFrame(uint64_t fenceValue);
+  void Reclaim(uint64_t completedFenceValue);
+
+  uint64_t GetCapacity() const { return m_Capacity; }
+  uint64_t GetUsedBytes() const { return m_Head - m_Tail; }
+  const RingAllocatorStats &GetStats() const { return m_Stats; }
+
+private:
+  struct FrameMarker {
+    uint64_t FenceValue;
+    uint64_t Head; // m_Head when the frame finished
+  };
+
+  uint64_t m_Capacity = 0;
+  // Monotonic byte positions; physical offset = position % capacity
+  uint64_t m_Head = 0;
+  uint64_t m_Tail = 0;
+  uint64_t m_FrameStart = 0;
+  std::deque<FrameMarker> m_Frames;
+
+  RingAllocatorStats m_Stats;
+};
+
+} // namespace Forge
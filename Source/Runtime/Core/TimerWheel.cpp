@@ -0,0 +1,143 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+namespace Forge {
+
+TimerWheel::TimerWheel(uint64_t startTick) : m_CurrentTick(startTick) {
+  for (uint32_t level = 0; level < LevelCount; level++) {
+    for (uint32_t slot = 0; slot < SlotCount; slot++) {
+      m_Slots[level][slot] = InvalidNode;
+    }
+  }
+}
+
+TimerWheel::TimerID TimerWheel::Schedule(uint64_t payload, uint64_t dueTick) {
+  // Level 0 slot for the current tick has already been processed
+  if (dueTick <= m_CurrentTick)
+    dueTick = m_CurrentTick + 1;
+
+  uint32_t index;
+  uint32_t generation = 1;
+  if (m_FreeList != InvalidNode) {
+    index = m_FreeList;
+    m_FreeList = m_Nodes[index].Next;
+    generation = m_Nodes[index].Generation;
+  } else {
+    index = (uint32_t)m_Nodes.size();
+    m_Nodes.push_back({});
+  }
+
+  m_Nodes[index] = {dueTick,    payload, InvalidNode, InvalidNode,
+                    generation, 0,       0,           true};
+  Insert(index);
+  m_PendingCount++;
+  return ((TimerID)generation << 32) | index;
+}
+
+bool TimerWheel::Cancel(TimerID timer) {
+  uint32_t index = (uint32_t)timer;
+  if (index >= m_Nodes.size())
+    return false;
+  Node &node = m_Nodes[index];
+  if (!node.Active || node.Generation != (uint32_t)(timer >> 32))
+    return false;
+
+  if (node.Prev != InvalidNode)
+    m_Nodes[node.Prev].Next = node.Next;
+  else
+    m_Slots[node.Level][node.Slot] = node.Next;
+  if (node.Next != InvalidNode)
+    m_Nodes[node.Next].Prev = node.Prev;
+  m_LevelCounts[node.Level]--;
+  Release(index);
+  return true;
+}
+
+void TimerWheel::Release(uint32_t nodeIndex) {
+  Node &node = m_Nodes[nodeIndex];
+  node.Active = false;
+  node.Generation = node.Generation == UINT32_MAX ? 1 : node.Generation + 1;
+  node.Next = m_FreeList;
+  m_FreeList = nodeIndex;
+  m_PendingCount--;
+}
+
+void TimerWheel::Insert(uint32_t nodeIndex) {
+  Node &node = m_Nodes[nodeIndex];
+  uint64_t delta = node.DueTick - m_CurrentTick;
+
+  uint32_t level = 0;
+  while (level < LevelCount - 1 &&
+         delta >= (uint64_t(1) << (SlotBits * (level + 1)))) {
+    level++;
+  }
+
+  uint32_t slot = (uint32_t)(node.DueTick >> (SlotBits * level)) & SlotMask;
+  node.Level = (uint8_t)level;
+  node.Slot = (uint8_t)slot;
+  node.Prev = InvalidNode;
+  node.Next = m_Slots[level][slot];
+  if (node.Next != InvalidNode)
+    m_Nodes[node.Next].Prev = nodeIndex;
+  m_Slots[level][slot] = nodeIndex;
+  m_LevelCounts[level]++;
+}
+
+void TimerWheel::Cascade(uint32_t level) {
+  uint32_t slot = (uint32_t)(m_CurrentTick >> (SlotBits * level)) & SlotMask;
+  uint32_t nodeIndex = m_Slots[level][slot];
+  m_Slots[level][slot] = InvalidNode;
+
+  while (nodeIndex != InvalidNode) {
+    uint32_t next = m_Nodes[nodeIndex].Next;
+    m_LevelCounts[level]--;
+    Insert(nodeIndex);
+    nodeIndex = next;
+  }
+}
+
+void TimerWheel::Advance(uint64_t tick, std::vector<uint64_t> &outExpired) {
+  while (m_CurrentTick < tick) {
+    // Nothing pending: jump straight to the target
+    if (m_PendingCount == 0) {
+      m_CurrentTick = tick;
+      return;
+    }
+
+    // Lower levels empty: nothing fires or cascades before the next slot
+    // boundary of the lowest occupied level
+    uint32_t lowest = 0;
+    while (m_LevelCounts[lowest] == 0 && lowest < LevelCount - 1)
+      lowest++;
+    if (lowest > 0) {
+      uint64_t lowerMask = (uint64_t(1) << (SlotBits * lowest)) - 1;
+      m_CurrentTick = std::min(tick, m_CurrentTick | lowerMask);
+      if (m_CurrentTick == tick)
+        return;
+    }
+
+    m_CurrentTick++;
+
+    // Higher levels first, so entries cascading from level N+1 into the
+    // level N slot that is due right now are picked up this tick.
+    for (uint32_t level = LevelCount - 1; level > 0; level--) {
+      uint64_t lowerMask = (uint64_t(1) << (SlotBits * level)) - 1;
+      if ((m_CurrentTick & lowerMask) == 0)
+        Cascade(level);
+    }
+
+    uint32_t slot = (uint32_t)m_CurrentTick & SlotMask;
+    uint32_t nodeIndex = m_Slots[0][slot];
+    m_Slots[0][slot] = InvalidNode;
+
+    while (nodeIndex != InvalidNode) {
+      uint32_t next = m_Nodes[nodeIndex].Next;
+      outExpired.push_back(m_Nodes[nodeIndex].Payload);
+      m_LevelCounts[0]--;
+      Release(nodeIndex);
+      nodeIndex = next;
+    }
+  }
+}
+
+} // namespace Forge
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Forge {
+
+// Hierarchical timer wheel (4 levels x 256 slots)
+// Schedule / Cancel: O(1), Advance: O(expired timers + cascaded timers),
+// empty stretches are skipped a wheel level at a time.
+// Timers further out than 2^32 ticks park in the top level and are
+// re-cascaded until they come into range.
+class TimerWheel {
+public:
+  // Node index and generation; a fired or cancelled timer's ID goes stale
+  using TimerID = uint64_t;
+  static constexpr TimerID InvalidTimer = 0;
+
+  explicit TimerWheel(uint64_t startTick = 0);
+
+  // Due ticks at or before the current tick fire on the next Advance.
+  TimerID Schedule(uint64_t payload, uint64_t dueTick);
+  // False if the timer already fired or was cancelled
+  bool Cancel(TimerID timer);
+
+  // Moves time forward to `tick` and appends the payloads of every timer
+  // with dueTick <= tick (in due order).
+  void Advance(uint64_t tick, std::vector<uint64_t> &outExpired);
+
+  uint64_t GetCurrentTick() const { return m_CurrentTick; }
+  size_t GetPendingCount() const { return m_PendingCount; }
+
+private:
+  static constexpr uint32_t LevelCount = 4;
+  static constexpr uint32_t SlotBits = 8;
+  static constexpr uint32_t SlotCount = 1u << SlotBits;
+  static constexpr uint32_t SlotMask = SlotCount - 1;
+  static constexpr uint32_t InvalidNode = UINT32_MAX;
+
+  struct Node {
+    uint64_t DueTick;
+    uint64_t Payload;
+    uint32_t Next;
+    uint32_t Prev;       // InvalidNode: head of its slot
+    uint32_t Generation; // bumped on release, never 0
+    uint8_t Level;
+    uint8_t Slot;
+    bool Active;
+  };
+
+  void Insert(uint32_t nodeIndex);
+  void Cascade(uint32_t level);
+  void Release(uint32_t nodeIndex);
+
+  std::vector<Node> m_Nodes;
+  uint32_t m_FreeList = InvalidNode;
+  uint32_t m_Slots[LevelCount][SlotCount];
+  uint32_t m_LevelCounts[LevelCount] = {};
+
+  uint64_t m_CurrentTick;
+  size_t m_PendingCount = 0;
+};
+
+} // namespace Forge
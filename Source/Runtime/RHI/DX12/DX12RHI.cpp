@@ -0,0 +1,926 @@
+#include "DX12RHI.h"
+#include <iostream>
+#include <vector>
+
+using Microsoft::WRL::ComPtr;
+
+namespace Forge {
+
+DXGI_FORMAT ToDXGIFormat(RHIFormat format) {
+  switch (format) {
+  case RHIFormat::RGBA8_UNorm:
+    return DXGI_FORMAT_R8G8B8A8_UNORM;
+  case RHIFormat::RGBA16_Float:
+    return DXGI_FORMAT_R16G16B16A16_FLOAT;
+  case RHIFormat::R32_Float:
+    return DXGI_FORMAT_R32_FLOAT;
+  case RHIFormat::R32_UInt:
+    return DXGI_FORMAT_R32_UINT;
+  case RHIFormat::RG32_Float:
+    return DXGI_FORMAT_R32G32_FLOAT;
+  case RHIFormat::RGB32_Float:
+    return DXGI_FORMAT_R32G32B32_FLOAT;
+  case RHIFormat::RGBA32_Float:
+    return DXGI_FORMAT_R32G32B32A32_FLOAT;
+  case RHIFormat::RGBA16_UNorm:
+    return DXGI_FORMAT_R16G16B16A16_UNORM;
+  case RHIFormat::RGBA8_SNorm:
+    return DXGI_FORMAT_R8G8B8A8_SNORM;
+  case RHIFormat::RG16_UNorm:
+    return DXGI_FORMAT_R16G16_UNORM;
+  case RHIFormat::R16_UInt:
+    return DXGI_FORMAT_R16_UINT;
+  case RHIFormat::BC1_UNorm:
+    return DXGI_FORMAT_BC1_UNORM;
+  case RHIFormat::BC1_UNorm_sRGB:
+    return DXGI_FORMAT_BC1_UNORM_SRGB;
+  case RHIFormat::BC3_UNorm:
+    return DXGI_FORMAT_BC3_UNORM;
+  case RHIFormat::BC3_UNorm_sRGB:
+    return DXGI_FORMAT_BC3_UNORM_SRGB;
+  case RHIFormat::BC5_UNorm:
+    return DXGI_FORMAT_BC5_UNORM;
+  case RHIFormat::BC7_UNorm:
+    return DXGI_FORMAT_BC7_UNORM;
+  case RHIFormat::BC7_UNorm_sRGB:
+    return DXGI_FORMAT_BC7_UNORM_SRGB;
+  case RHIFormat::D24_UNorm_S8_UInt:
+    return DXGI_FORMAT_D24_UNORM_S8_UINT;
+  case RHIFormat::D32_Float:
+    return DXGI_FORMAT_D32_FLOAT;
+  default:
+    return DXGI_FORMAT_UNKNOWN;
+  }
+}
+
+D3D12_RESOURCE_STATES ToD3D12States(RHIResourceState state) {
+  if (state == RHIResourceState::GenericRead)
+    return D3D12_RESOURCE_STATE_GENERIC_READ;
+
+  D3D12_RESOURCE_STATES result = D3D12_RESOURCE_STATE_COMMON;
+  auto map = [&](RHIResourceState bit, D3D12_RESOURCE_STATES native) {
+    if (HasAnyState(state, bit))
+      result |= native;
+  };
+  map(RHIResourceState::VertexAndConstantBuffer,
+      D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+  map(RHIResourceState::IndexBuffer, D3D12_RESOURCE_STATE_INDEX_BUFFER);
+  map(RHIResourceState::RenderTarget, D3D12_RESOURCE_STATE_RENDER_TARGET);
+  map(RHIResourceState::UnorderedAccess,
+      D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+  map(RHIResourceState::DepthWrite, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+  map(RHIResourceState::DepthRead, D3D12_RESOURCE_STATE_DEPTH_READ);
+  map(RHIResourceState::NonPixelShaderResource,
+      D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+  map(RHIResourceState::PixelShaderResource,
+      D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+  map(RHIResourceState::CopyDest, D3D12_RESOURCE_STATE_COPY_DEST);
+  map(RHIResourceState::CopySource, D3D12_RESOURCE_STATE_COPY_SOURCE);
+  map(RHIResourceState::Present, D3D12_RESOURCE_STATE_PRESENT);
+  return result;
+}
+
+namespace {
+
+D3D12_COMMAND_LIST_TYPE ToCommandListType(RHIQueueType type) {
+  switch (type) {
+  case RHIQueueType::Compute:
+    return D3D12_COMMAND_LIST_TYPE_COMPUTE;
+  case RHIQueueType::Copy:
+    return D3D12_COMMAND_LIST_TYPE_COPY;
+  default:
+    return D3D12_COMMAND_LIST_TYPE_DIRECT;
+  }
+}
+
+D3D12_DESCRIPTOR_HEAP_TYPE ToHeapType(RHIDescriptorHeapType type) {
+  switch (type) {
+  case RHIDescriptorHeapType::Sampler:
+    return D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER;
+  case RHIDescriptorHeapType::RTV:
+    return D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+  case RHIDescriptorHeapType::DSV:
+    return D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
+  default:
+    return D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+  }
+}
+
+D3D12_SHADER_VISIBILITY ToVisibility(RHIShaderVisibility visibility) {
+  switch (visibility) {
+  case RHIShaderVisibility::Vertex:
+    return D3D12_SHADER_VISIBILITY_VERTEX;
+  case RHIShaderVisibility::Pixel:
+    return D3D12_SHADER_VISIBILITY_PIXEL;
+  default:
+    return D3D12_SHADER_VISIBILITY_ALL;
+  }
+}
+
+D3D_PRIMITIVE_TOPOLOGY ToTopology(RHIPrimitiveTopology topology) {
+  switch (topology) {
+  case RHIPrimitiveTopology::PointList:
+    return D3D_PRIMITIVE_TOPOLOGY_POINTLIST;
+  case RHIPrimitiveTopology::LineList:
+    return D3D_PRIMITIVE_TOPOLOGY_LINELIST;
+  default:
+    return D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+  }
+}
+
+D3D12_PRIMITIVE_TOPOLOGY_TYPE ToTopologyType(RHIPrimitiveTopology topology) {
+  switch (topology) {
+  case RHIPrimitiveTopology::PointList:
+    return D3D12_PRIMITIVE_TOPOLOGY_TYPE_POINT;
+  case RHIPrimitiveTopology::LineList:
+    return D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE;
+  default:
+    return D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+  }
+}
+
+class DX12RHIResource : public RHIResource {
+public:
+  DX12RHIResource(ComPtr<ID3D12Resource> resource,
+                  const RHIResourceDesc &desc)
+      : Resource(std::move(resource)) {
+    m_Desc = desc;
+  }
+
+  void *Map() override {
+    void *data = nullptr;
+    D3D12_RANGE readRange = {0, 0};
+    if (FAILED(Resource->Map(0, &readRange, &data)))
+      return nullptr;
+    return data;
+  }
+  void Unmap() override { Resource->Unmap(0, nullptr); }
+
+  uint64_t GetGPUAddress() const override {
+    return Resource->GetGPUVirtualAddress();
+  }
+
+  ComPtr<ID3D12Resource> Resource;
+};
+
+class DX12RHIHeap : public RHIHeap {
+public:
+  DX12RHIHeap(ComPtr<ID3D12Heap> heap, const RHIHeapDesc &desc)
+      : Heap(std::move(heap)) {
+    m_Desc = desc;
+  }
+
+  ComPtr<ID3D12Heap> Heap;
+};
+
+class DX12RHIQueryHeap : public RHIQueryHeap {
+public:
+  DX12RHIQueryHeap(ComPtr<ID3D12QueryHeap> heap, const RHIQueryHeapDesc &desc)
+      : Heap(std::move(heap)) {
+    m_Desc = desc;
+  }
+
+  ComPtr<ID3D12QueryHeap> Heap;
+};
+
+class DX12RHIPipelineState : public RHIPipelineState {
+public:
+  ComPtr<ID3D12RootSignature> RootSignature;
+  ComPtr<ID3D12PipelineState> PipelineState;
+};
+
+class DX12RHIPipelineLibrary : public RHIPipelineLibrary {
+public:
+  DX12RHIPipelineLibrary(DX12RHIDevice *device, const void *data,
+                         size_t size)
+      : m_Device(device), m_Blob((const uint8_t *)data,
+                                 (const uint8_t *)data + size) {}
+
+  const std::vector<uint8_t> &GetBlob() const { return m_Blob; }
+
+  std::unique_ptr<RHIPipelineState>
+  Load(const std::string &name, const RHIGraphicsPipelineDesc &desc) override {
+    std::wstring wideName(name.begin(), name.end());
+    return m_Device->CreateGraphicsPipeline(desc, Library.Get(),
+                                            wideName.c_str());
+  }
+
+  bool Store(const std::string &name, RHIPipelineState *pipeline) override {
+    auto *dx = static_cast<DX12RHIPipelineState *>(pipeline);
+    std::wstring wideName(name.begin(), name.end());
+    return SUCCEEDED(
+        Library->StorePipeline(wideName.c_str(), dx->PipelineState.Get()));
+  }
+
+  std::vector<uint8_t> Serialize() const override {
+    std::vector<uint8_t> data(Library->GetSerializedSize());
+    if (FAILED(Library->Serialize(data.data(), data.size())))
+      data.clear();
+    return data;
+  }
+
+private:
+  DX12RHIDevice *m_Device;
+  // The library references the blob it was created from: keep it alive
+  // (declared before Library so it is destroyed after it)
+  std::vector<uint8_t> m_Blob;
+
+public:
+  ComPtr<ID3D12PipelineLibrary> Library;
+};
+
+class DX12RHIDescriptorHeap : public RHIDescriptorHeap {
+public:
+  DX12RHIDescriptorHeap(ComPtr<ID3D12DescriptorHeap> heap,
+                        const RHIDescriptorHeapDesc &desc, uint32_t increment)
+      : Heap(std::move(heap)), m_Increment(increment) {
+    m_Desc = desc;
+  }
+
+  RHICPUDescriptor GetCPUStart() const override {
+    return {Heap->GetCPUDescriptorHandleForHeapStart().ptr};
+  }
+  RHIGPUDescriptor GetGPUStart() const override {
+    if (!m_Desc.ShaderVisible)
+      return {0};
+    return {Heap->GetGPUDescriptorHandleForHeapStart().ptr};
+  }
+  uint32_t GetIncrementSize() const override { return m_Increment; }
+
+  ComPtr<ID3D12DescriptorHeap> Heap;
+
+private:
+  uint32_t m_Increment;
+};
+
+class DX12RHIFence : public RHIFence {
+public:
+  explicit DX12RHIFence(ComPtr<ID3D12Fence> fence) : Fence(std::move(fence)) {
+    m_Event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+  }
+  ~DX12RHIFence() override { CloseHandle(m_Event); }
+
+  uint64_t GetCompletedValue() const override {
+    return Fence->GetCompletedValue();
+  }
+
+  void Wait(uint64_t value) override {
+    if (Fence->GetCompletedValue() >= value)
+      return;
+    Fence->SetEventOnCompletion(value, m_Event);
+    WaitForSingleObject(m_Event, INFINITE);
+  }
+
+  ComPtr<ID3D12Fence> Fence;
+
+private:
+  HANDLE m_Event;
+};
+
+class DX12RHICommandList : public RHICommandList {
+public:
+  DX12RHICommandList(RHIQueueType type, ComPtr<ID3D12CommandAllocator> alloc,
+                     ComPtr<ID3D12GraphicsCommandList> list)
+      : Allocator(std::move(alloc)), List(std::move(list)), m_Type(type) {}
+
+  RHIQueueType GetType() const override { return m_Type; }
+
+  void Reset() override {
+    Allocator->Reset();
+    List->Reset(Allocator.Get(), nullptr);
+  }
+  void Close() override { List->Close(); }
+
+  void ResourceBarriers(const RHIBarrier *barriers, uint32_t count) override {
+    // Small batches stay on the stack
+    D3D12_RESOURCE_BARRIER local[16];
+    std::vector<D3D12_RESOURCE_BARRIER> heap;
+    D3D12_RESOURCE_BARRIER *native = local;
+    if (count > 16) {
+      heap.resize(count);
+      native = heap.data();
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+      D3D12_RESOURCE_BARRIER &b = native[i];
+      b = {};
+      if (barriers[i].Type == RHIBarrierType::Aliasing) {
+        b.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+        b.Aliasing.pResourceBefore =
+            DX12RHIDevice::GetNative(barriers[i].AliasBefore);
+        b.Aliasing.pResourceAfter =
+            DX12RHIDevice::GetNative(barriers[i].Resource);
+        continue;
+      }
+      b.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+      b.Transition.pResource = DX12RHIDevice::GetNative(barriers[i].Resource);
+      b.Transition.StateBefore = ToD3D12States(barriers[i].Before);
+      b.Transition.StateAfter = ToD3D12States(barriers[i].After);
+      b.Transition.Subresource = barriers[i].Subresource;
+    }
+    List->ResourceBarrier(count, native);
+  }
+
+  void SetDescriptorHeaps(RHIDescriptorHeap *const *heaps,
+                          uint32_t count) override {
+    ID3D12DescriptorHeap *native[2] = {};
+    for (uint32_t i = 0; i < count && i < 2; i++) {
+      native[i] = DX12RHIDevice::GetNative(heaps[i]);
+    }
+    List->SetDescriptorHeaps(count, native);
+  }
+
+  void SetRenderTargets(const RHICPUDescriptor *rtvs, uint32_t count,
+                        const RHICPUDescriptor *dsv) override {
+    D3D12_CPU_DESCRIPTOR_HANDLE native[D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT];
+    for (uint32_t i = 0; i < count; i++) {
+      native[i].ptr = (SIZE_T)rtvs[i].Ptr;
+    }
+    D3D12_CPU_DESCRIPTOR_HANDLE depth = {dsv ? (SIZE_T)dsv->Ptr : 0};
+    List->OMSetRenderTargets(count, native, FALSE, dsv ? &depth : nullptr);
+  }
+
+  void ClearRenderTarget(RHICPUDescriptor rtv, const float color[4]) override {
+    List->ClearRenderTargetView({(SIZE_T)rtv.Ptr}, color, 0, nullptr);
+  }
+
+  void ClearDepthStencil(RHICPUDescriptor dsv, float depth,
+                         uint8_t stencil) override {
+    List->ClearDepthStencilView({(SIZE_T)dsv.Ptr}, D3D12_CLEAR_FLAG_DEPTH,
+                                depth, stencil, 0, nullptr);
+  }
+
+  void SetViewport(const RHIViewport &v) override {
+    D3D12_VIEWPORT viewport = {v.X,     v.Y,        v.Width,
+                               v.Height, v.MinDepth, v.MaxDepth};
+    List->RSSetViewports(1, &viewport);
+  }
+
+  void SetScissor(const RHIRect &r) override {
+    D3D12_RECT rect = {r.Left, r.Top, r.Right, r.Bottom};
+    List->RSSetScissorRects(1, &rect);
+  }
+
+  void SetPipelineState(RHIPipelineState *pipeline) override {
+    auto *dx = static_cast<DX12RHIPipelineState *>(pipeline);
+    List->SetPipelineState(dx->PipelineState.Get());
+    List->SetGraphicsRootSignature(dx->RootSignature.Get());
+  }
+
+  void SetGraphicsConstants(uint32_t rootIndex, uint32_t count,
+                            const void *data) override {
+    List->SetGraphicsRoot32BitConstants(rootIndex, count, data, 0);
+  }
+
+  void SetGraphicsConstantBuffer(uint32_t rootIndex,
+                                 uint64_t gpuAddress) override {
+    List->SetGraphicsRootConstantBufferView(rootIndex, gpuAddress);
+  }
+
+  void SetGraphicsDescriptorTable(uint32_t rootIndex,
+                                  RHIGPUDescriptor base) override {
+    List->SetGraphicsRootDescriptorTable(rootIndex, {base.Ptr});
+  }
+
+  void SetPrimitiveTopology(RHIPrimitiveTopology topology) override {
+    List->IASetPrimitiveTopology(ToTopology(topology));
+  }
+
+  void SetVertexBuffer(uint32_t slot, RHIResource *buffer, uint64_t offset,
+                       uint32_t size, uint32_t stride) override {
+    D3D12_VERTEX_BUFFER_VIEW view = {};
+    view.BufferLocation = buffer->GetGPUAddress() + offset;
+    view.SizeInBytes = size;
+    view.StrideInBytes = stride;
+    List->IASetVertexBuffers(slot, 1, &view);
+  }
+
+  void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex,
+            uint32_t firstInstance) override {
+    List->DrawInstanced(vertexCount, instanceCount, firstVertex,
+                        firstInstance);
+  }
+
+  void CopyBufferRegion(RHIResource *dst, uint64_t dstOffset, RHIResource *src,
+                        uint64_t srcOffset, uint64_t size) override {
+    List->CopyBufferRegion(DX12RHIDevice::GetNative(dst), dstOffset,
+                           DX12RHIDevice::GetNative(src), srcOffset, size);
+  }
+
+  void CopyBufferToTexture(RHIResource *dst, uint32_t subresource,
+                           RHIResource *src, uint64_t srcOffset,
+                           uint32_t rowPitch) override {
+    const RHIResourceDesc &desc = dst->GetDesc();
+    uint32_t mip = subresource % desc.MipLevels;
+
+    D3D12_TEXTURE_COPY_LOCATION dstLocation = {};
+    dstLocation.pResource = DX12RHIDevice::GetNative(dst);
+    dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    dstLocation.SubresourceIndex = subresource;
+
+    D3D12_TEXTURE_COPY_LOCATION srcLocation = {};
+    srcLocation.pResource = DX12RHIDevice::GetNative(src);
+    srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    srcLocation.PlacedFootprint.Offset = srcOffset;
+    srcLocation.PlacedFootprint.Footprint.Format = ToDXGIFormat(desc.Format);
+    // Block-compressed footprints cover whole 4x4 blocks
+    uint32_t align = IsBlockCompressed(desc.Format) ? 4 : 1;
+    srcLocation.PlacedFootprint.Footprint.Width =
+        (GetMipSize((uint32_t)desc.Width, mip) + align - 1) / align * align;
+    srcLocation.PlacedFootprint.Footprint.Height =
+        (GetMipSize(desc.Height, mip) + align - 1) / align * align;
+    srcLocation.PlacedFootprint.Footprint.Depth = 1;
+    srcLocation.PlacedFootprint.Footprint.RowPitch = rowPitch;
+    List->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, nullptr);
+  }
+
+  void WriteTimestamp(RHIQueryHeap *heap, uint32_t index) override {
+    List->EndQuery(static_cast<DX12RHIQueryHeap *>(heap)->Heap.Get(),
+                   D3D12_QUERY_TYPE_TIMESTAMP, index);
+  }
+
+  void ResolveQueries(RHIQueryHeap *heap, uint32_t first, uint32_t count,
+                      RHIResource *dst, uint64_t dstOffset) override {
+    List->ResolveQueryData(static_cast<DX12RHIQueryHeap *>(heap)->Heap.Get(),
+                           D3D12_QUERY_TYPE_TIMESTAMP, first, count,
+                           DX12RHIDevice::GetNative(dst), dstOffset);
+  }
+
+  ComPtr<ID3D12CommandAllocator> Allocator;
+  ComPtr<ID3D12GraphicsCommandList> List;
+
+private:
+  RHIQueueType m_Type;
+};
+
+class DX12RHICommandQueue : public RHICommandQueue {
+public:
+  DX12RHICommandQueue(RHIQueueType type, ComPtr<ID3D12CommandQueue> queue)
+      : Queue(std::move(queue)), m_Type(type) {}
+
+  RHIQueueType GetType() const override { return m_Type; }
+
+  void Execute(RHICommandList *const *lists, uint32_t count) override {
+    ID3D12CommandList *local[16];
+    std::vector<ID3D12CommandList *> heap;
+    ID3D12CommandList **native = local;
+    if (count > 16) {
+      heap.resize(count);
+      native = heap.data();
+    }
+    for (uint32_t i = 0; i < count; i++) {
+      native[i] = DX12RHIDevice::GetNative(lists[i]);
+    }
+    Queue->ExecuteCommandLists(count, native);
+  }
+
+  void Signal(RHIFence *fence, uint64_t value) override {
+    Queue->Signal(static_cast<DX12RHIFence *>(fence)->Fence.Get(), value);
+  }
+
+  void Wait(RHIFence *fence, uint64_t value) override {
+    Queue->Wait(static_cast<DX12RHIFence *>(fence)->Fence.Get(), value);
+  }
+
+  uint64_t GetTimestampFrequency() const override {
+    UINT64 frequency = 0;
+    if (FAILED(Queue->GetTimestampFrequency(&frequency)))
+      return 0;
+    return frequency;
+  }
+
+  uint64_t GetCurrentTimestamp() override {
+    UINT64 gpuTimestamp = 0, cpuTimestamp = 0;
+    Queue->GetClockCalibration(&gpuTimestamp, &cpuTimestamp);
+    return gpuTimestamp;
+  }
+
+  ComPtr<ID3D12CommandQueue> Queue;
+
+private:
+  RHIQueueType m_Type;
+};
+
+} // namespace
+
+DX12RHIDevice::DX12RHIDevice(ID3D12Device *device) : m_Device(device) {}
+
+std::unique_ptr<RHICommandQueue>
+DX12RHIDevice::CreateCommandQueue(RHIQueueType type) {
+  D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+  queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+  queueDesc.Type = ToCommandListType(type);
+
+  ComPtr<ID3D12CommandQueue> queue;
+  if (FAILED(m_Device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&queue)))) {
+    std::cerr << "[DX12RHI] Failed to create Command Queue" << std::endl;
+    return nullptr;
+  }
+  return std::make_unique<DX12RHICommandQueue>(type, queue);
+}
+
+std::unique_ptr<RHICommandList>
+DX12RHIDevice::CreateCommandList(RHIQueueType type) {
+  ComPtr<ID3D12CommandAllocator> allocator;
+  if (FAILED(m_Device->CreateCommandAllocator(ToCommandListType(type),
+                                              IID_PPV_ARGS(&allocator)))) {
+    std::cerr << "[DX12RHI] Failed to create Command Allocator" << std::endl;
+    return nullptr;
+  }
+
+  ComPtr<ID3D12GraphicsCommandList> list;
+  if (FAILED(m_Device->CreateCommandList(0, ToCommandListType(type),
+                                         allocator.Get(), nullptr,
+                                         IID_PPV_ARGS(&list)))) {
+    std::cerr << "[DX12RHI] Failed to create Command List" << std::endl;
+    return nullptr;
+  }
+  // RHI command lists start closed
+  list->Close();
+  return std::make_unique<DX12RHICommandList>(type, allocator, list);
+}
+
+std::unique_ptr<RHIFence> DX12RHIDevice::CreateFence(uint64_t initialValue) {
+  ComPtr<ID3D12Fence> fence;
+  if (FAILED(m_Device->CreateFence(initialValue, D3D12_FENCE_FLAG_NONE,
+                                   IID_PPV_ARGS(&fence)))) {
+    std::cerr << "[DX12RHI] Failed to create Fence" << std::endl;
+    return nullptr;
+  }
+  return std::make_unique<DX12RHIFence>(fence);
+}
+
+static D3D12_HEAP_TYPE ToD3D12HeapType(RHIHeapType type) {
+  switch (type) {
+  case RHIHeapType::Upload:
+    return D3D12_HEAP_TYPE_UPLOAD;
+  case RHIHeapType::Readback:
+    return D3D12_HEAP_TYPE_READBACK;
+  default:
+    return D3D12_HEAP_TYPE_DEFAULT;
+  }
+}
+
+static D3D12_RESOURCE_DESC ToD3D12ResourceDesc(const RHIResourceDesc &desc) {
+  D3D12_RESOURCE_DESC resourceDesc = {};
+  resourceDesc.Width = desc.Width;
+  resourceDesc.Height = desc.Height;
+  resourceDesc.DepthOrArraySize = 1;
+  resourceDesc.MipLevels = desc.MipLevels;
+  resourceDesc.SampleDesc.Count = 1;
+  if (desc.Dimension == RHIResourceDimension::Buffer) {
+    resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
+    resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+  } else {
+    resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    resourceDesc.Format = ToDXGIFormat(desc.Format);
+  }
+  if (desc.Flags & RHIResourceFlag_RenderTarget)
+    resourceDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+  if (desc.Flags & RHIResourceFlag_DepthStencil)
+    resourceDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+  if (desc.Flags & RHIResourceFlag_UnorderedAccess)
+    resourceDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+  return resourceDesc;
+}
+
+static D3D12_CLEAR_VALUE ToD3D12ClearValue(const RHIClearValue &value) {
+  D3D12_CLEAR_VALUE clearValue = {};
+  clearValue.Format = ToDXGIFormat(value.Format);
+  if (IsDepthFormat(value.Format)) {
+    clearValue.DepthStencil.Depth = value.Depth;
+    clearValue.DepthStencil.Stencil = value.Stencil;
+  } else {
+    for (int i = 0; i < 4; i++)
+      clearValue.Color[i] = value.Color[i];
+  }
+  return clearValue;
+}
+
+std::unique_ptr<RHIResource>
+DX12RHIDevice::CreateResource(const RHIResourceDesc &desc) {
+  D3D12_HEAP_PROPERTIES heapProps = {};
+  heapProps.Type = ToD3D12HeapType(desc.Heap);
+  D3D12_RESOURCE_DESC resourceDesc = ToD3D12ResourceDesc(desc);
+  D3D12_CLEAR_VALUE clearValue = {};
+  if (desc.ClearValue)
+    clearValue = ToD3D12ClearValue(*desc.ClearValue);
+
+  ComPtr<ID3D12Resource> resource;
+  HRESULT hr = m_Device->CreateCommittedResource(
+      &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc,
+      ToD3D12States(desc.InitialState), desc.ClearValue ? &clearValue : nullptr,
+      IID_PPV_ARGS(&resource));
+  if (FAILED(hr)) {
+    std::cerr << "[DX12RHI] Failed to create resource '" << desc.DebugName
+              << "'" << std::endl;
+    return nullptr;
+  }
+  return std::make_unique<DX12RHIResource>(resource, desc);
+}
+
+std::unique_ptr<RHIHeap> DX12RHIDevice::CreateHeap(const RHIHeapDesc &desc) {
+  D3D12_HEAP_DESC heapDesc = {};
+  heapDesc.SizeInBytes = desc.Size;
+  heapDesc.Properties.Type = ToD3D12HeapType(desc.Type);
+  heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+  switch (desc.Usage) {
+  case RHIHeapUsage::Buffers:
+    heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+    break;
+  case RHIHeapUsage::Textures:
+    heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+    break;
+  case RHIHeapUsage::RenderTargets:
+    heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+    break;
+  }
+
+  ComPtr<ID3D12Heap> heap;
+  if (FAILED(m_Device->CreateHeap(&heapDesc, IID_PPV_ARGS(&heap)))) {
+    std::cerr << "[DX12RHI] Failed to create heap '" << desc.DebugName << "'"
+              << std::endl;
+    return nullptr;
+  }
+  return std::make_unique<DX12RHIHeap>(heap, desc);
+}
+
+std::unique_ptr<RHIQueryHeap>
+DX12RHIDevice::CreateQueryHeap(const RHIQueryHeapDesc &desc) {
+  D3D12_QUERY_HEAP_DESC heapDesc = {};
+  heapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+  heapDesc.Count = desc.Count;
+
+  ComPtr<ID3D12QueryHeap> heap;
+  if (FAILED(m_Device->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(&heap)))) {
+    std::cerr << "[DX12RHI] Failed to create query heap '" << desc.DebugName
+              << "'" << std::endl;
+    return nullptr;
+  }
+  return std::make_unique<DX12RHIQueryHeap>(heap, desc);
+}
+
+std::unique_ptr<RHIResource>
+DX12RHIDevice::CreatePlacedResource(RHIHeap *heap, uint64_t offset,
+                                    const RHIResourceDesc &desc) {
+  D3D12_RESOURCE_DESC resourceDesc = ToD3D12ResourceDesc(desc);
+  D3D12_CLEAR_VALUE clearValue = {};
+  if (desc.ClearValue)
+    clearValue = ToD3D12ClearValue(*desc.ClearValue);
+
+  ComPtr<ID3D12Resource> resource;
+  HRESULT hr = m_Device->CreatePlacedResource(
+      static_cast<DX12RHIHeap *>(heap)->Heap.Get(), offset, &resourceDesc,
+      ToD3D12States(desc.InitialState), desc.ClearValue ? &clearValue : nullptr,
+      IID_PPV_ARGS(&resource));
+  if (FAILED(hr)) {
+    std::cerr << "[DX12RHI] Failed to create placed resource '"
+              << desc.DebugName << "'" << std::endl;
+    return nullptr;
+  }
+  return std::make_unique<DX12RHIResource>(resource, desc);
+}
+
+RHIAllocationInfo
+DX12RHIDevice::GetAllocationInfo(const RHIResourceDesc &desc) const {
+  D3D12_RESOURCE_DESC resourceDesc = ToD3D12ResourceDesc(desc);
+  D3D12_RESOURCE_ALLOCATION_INFO info =
+      m_Device->GetResourceAllocationInfo(0, 1, &resourceDesc);
+  return {info.SizeInBytes, info.Alignment};
+}
+
+std::unique_ptr<RHIDescriptorHeap>
+DX12RHIDevice::CreateDescriptorHeap(const RHIDescriptorHeapDesc &desc) {
+  D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+  heapDesc.NumDescriptors = desc.Count;
+  heapDesc.Type = ToHeapType(desc.Type);
+  heapDesc.Flags = desc.ShaderVisible
+                       ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE
+                       : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+  ComPtr<ID3D12DescriptorHeap> heap;
+  if (FAILED(m_Device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&heap)))) {
+    std::cerr << "[DX12RHI] Failed to create Descriptor Heap" << std::endl;
+    return nullptr;
+  }
+  return std::make_unique<DX12RHIDescriptorHeap>(
+      heap, desc, m_Device->GetDescriptorHandleIncrementSize(heapDesc.Type));
+}
+
+std::unique_ptr<RHIPipelineState>
+DX12RHIDevice::CreateGraphicsPipeline(const RHIGraphicsPipelineDesc &desc) {
+  return CreateGraphicsPipeline(desc, nullptr, nullptr);
+}
+
+std::unique_ptr<RHIPipelineState>
+DX12RHIDevice::CreateGraphicsPipeline(const RHIGraphicsPipelineDesc &desc,
+                                      ID3D12PipelineLibrary *library,
+                                      const wchar_t *name) {
+  // 1. Root Signature
+  std::vector<D3D12_ROOT_PARAMETER> rootParameters(desc.RootParameters.size());
+  std::vector<D3D12_DESCRIPTOR_RANGE> ranges(desc.RootParameters.size());
+  for (size_t i = 0; i < desc.RootParameters.size(); i++) {
+    const RHIRootParameter &src = desc.RootParameters[i];
+    D3D12_ROOT_PARAMETER &dst = rootParameters[i];
+    dst.ShaderVisibility = ToVisibility(src.Visibility);
+
+    switch (src.ParameterType) {
+    case RHIRootParameter::Type::Constants:
+      dst.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+      dst.Constants.ShaderRegister = src.ShaderRegister;
+      dst.Constants.Num32BitValues = src.Num32BitValues;
+      break;
+    case RHIRootParameter::Type::ConstantBuffer:
+      dst.ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+      dst.Descriptor.ShaderRegister = src.ShaderRegister;
+      break;
+    case RHIRootParameter::Type::DescriptorTable:
+      ranges[i] = {D3D12_DESCRIPTOR_RANGE_TYPE_SRV, src.DescriptorCount,
+                   src.ShaderRegister, 0,
+                   D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND};
+      dst.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+      dst.DescriptorTable.NumDescriptorRanges = 1;
+      dst.DescriptorTable.pDescriptorRanges = &ranges[i];
+      break;
+    }
+  }
+
+  D3D12_ROOT_SIGNATURE_DESC rootSigDesc = {
+      (UINT)rootParameters.size(), rootParameters.data(), 0, nullptr,
+      D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT};
+
+  ComPtr<ID3DBlob> signature;
+  ComPtr<ID3DBlob> error;
+  HRESULT hr = D3D12SerializeRootSignature(
+      &rootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
+  if (FAILED(hr)) {
+    std::cerr << "[DX12RHI] Failed to serialize root signature for '"
+              << desc.DebugName << "'" << std::endl;
+    return nullptr;
+  }
+
+  auto pipeline = std::make_unique<DX12RHIPipelineState>();
+  hr = m_Device->CreateRootSignature(0, signature->GetBufferPointer(),
+                                     signature->GetBufferSize(),
+                                     IID_PPV_ARGS(&pipeline->RootSignature));
+  if (FAILED(hr)) {
+    std::cerr << "[DX12RHI] Failed to create root signature for '"
+              << desc.DebugName << "'" << std::endl;
+    return nullptr;
+  }
+
+  // 2. Input Layout
+  std::vector<D3D12_INPUT_ELEMENT_DESC> inputElements;
+  for (const RHIInputElement &element : desc.InputLayout) {
+    inputElements.push_back(
+        {element.SemanticName, element.SemanticIndex,
+         ToDXGIFormat(element.Format), element.InputSlot,
+         element.AlignedByteOffset,
+         element.PerInstance ? D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA
+                             : D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
+         element.PerInstance ? 1u : 0u});
+  }
+
+  // 3. PSO
+  D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
+  psoDesc.InputLayout = {inputElements.data(), (UINT)inputElements.size()};
+  psoDesc.pRootSignature = pipeline->RootSignature.Get();
+  psoDesc.VS = {desc.VS.Data, desc.VS.Size};
+  psoDesc.PS = {desc.PS.Data, desc.PS.Size};
+
+  psoDesc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+  psoDesc.RasterizerState.CullMode =
+      desc.CullBackFaces ? D3D12_CULL_MODE_BACK : D3D12_CULL_MODE_NONE;
+  psoDesc.RasterizerState.DepthClipEnable = TRUE;
+
+  psoDesc.BlendState.AlphaToCoverageEnable = FALSE;
+  psoDesc.BlendState.IndependentBlendEnable = FALSE;
+  const D3D12_RENDER_TARGET_BLEND_DESC defaultRtbDesc = {
+      FALSE,
+      FALSE,
+      D3D12_BLEND_ONE,
+      D3D12_BLEND_ZERO,
+      D3D12_BLEND_OP_ADD,
+      D3D12_BLEND_ONE,
+      D3D12_BLEND_ZERO,
+      D3D12_BLEND_OP_ADD,
+      D3D12_LOGIC_OP_NOOP,
+      D3D12_COLOR_WRITE_ENABLE_ALL,
+  };
+  for (UINT i = 0; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i)
+    psoDesc.BlendState.RenderTarget[i] = defaultRtbDesc;
+
+  psoDesc.DepthStencilState.DepthEnable = desc.DepthEnable ? TRUE : FALSE;
+  psoDesc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
+  psoDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
+  psoDesc.DepthStencilState.StencilEnable = FALSE;
+
+  psoDesc.SampleMask = UINT_MAX;
+  psoDesc.PrimitiveTopologyType = ToTopologyType(desc.Topology);
+  psoDesc.NumRenderTargets = 1;
+  psoDesc.RTVFormats[0] = ToDXGIFormat(desc.RTVFormat);
+  psoDesc.DSVFormat = ToDXGIFormat(desc.DSVFormat);
+  psoDesc.SampleDesc.Count = 1;
+
+  if (library) {
+    // E_INVALIDARG = not in the library or desc changed; caller recreates
+    hr = library->LoadGraphicsPipeline(
+        name, &psoDesc, IID_PPV_ARGS(&pipeline->PipelineState));
+    return SUCCEEDED(hr) ? std::move(pipeline) : nullptr;
+  }
+
+  hr = m_Device->CreateGraphicsPipelineState(
+      &psoDesc, IID_PPV_ARGS(&pipeline->PipelineState));
+  if (FAILED(hr)) {
+    std::cerr << "[DX12RHI] Failed to create PSO '" << desc.DebugName << "'"
+              << std::endl;
+    return nullptr;
+  }
+  return pipeline;
+}
+
+std::unique_ptr<RHIPipelineLibrary>
+DX12RHIDevice::CreatePipelineLibrary(const void *data, size_t size) {
+  ComPtr<ID3D12Device1> device1;
+  if (FAILED(m_Device->QueryInterface(IID_PPV_ARGS(&device1))))
+    return nullptr; // pre-Anniversary Update runtime
+
+  auto library = std::make_unique<DX12RHIPipelineLibrary>(this, data, size);
+  HRESULT hr = device1->CreatePipelineLibrary(
+      size ? library->GetBlob().data() : nullptr, size,
+      IID_PPV_ARGS(&library->Library));
+  if (FAILED(hr)) {
+    // D3D12_ERROR_DRIVER_VERSION_MISMATCH / ADAPTER_NOT_FOUND: stale cache
+    std::cerr << "[DX12RHI] Pipeline library rejected (0x" << std::hex << hr
+              << std::dec << ")" << std::endl;
+    return nullptr;
+  }
+  return library;
+}
+
+void DX12RHIDevice::CreateRenderTargetView(RHIResource *resource,
+                                           RHICPUDescriptor dest) {
+  m_Device->CreateRenderTargetView(GetNative(resource), nullptr,
+                                   {(SIZE_T)dest.Ptr});
+}
+
+void DX12RHIDevice::CreateDepthStencilView(RHIResource *resource,
+                                           RHICPUDescriptor dest) {
+  m_Device->CreateDepthStencilView(GetNative(resource), nullptr,
+                                   {(SIZE_T)dest.Ptr});
+}
+
+void DX12RHIDevice::CreateShaderResourceView(RHIResource *resource,
+                                             RHICPUDescriptor dest) {
+  m_Device->CreateShaderResourceView(GetNative(resource), nullptr,
+                                     {(SIZE_T)dest.Ptr});
+}
+
+void DX12RHIDevice::CopyDescriptors(RHICPUDescriptor dest,
+                                    const RHICPUDescriptor *sources,
+                                    uint32_t count,
+                                    RHIDescriptorHeapType type) {
+  std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> sourceHandles(count);
+  std::vector<UINT> sourceSizes(count, 1);
+  for (uint32_t i = 0; i < count; i++) {
+    sourceHandles[i].ptr = (SIZE_T)sources[i].Ptr;
+  }
+
+  D3D12_CPU_DESCRIPTOR_HANDLE destHandle = {(SIZE_T)dest.Ptr};
+  UINT destSize = count;
+  m_Device->CopyDescriptors(1, &destHandle, &destSize, count,
+                            sourceHandles.data(), sourceSizes.data(),
+                            ToHeapType(type));
+}
+
+std::unique_ptr<RHIResource>
+DX12RHIDevice::WrapResource(ID3D12Resource *resource,
+                            RHIResourceState currentState,
+                            const std::string &name) {
+  D3D12_RESOURCE_DESC nativeDesc = resource->GetDesc();
+  RHIResourceDesc desc = RHIResourceDesc::Texture2D(
+      (uint32_t)nativeDesc.Width, nativeDesc.Height, RHIFormat::Unknown,
+      RHIResourceFlag_RenderTarget, currentState, name);
+  return std::make_unique<DX12RHIResource>(resource, desc);
+}
+
+ID3D12Resource *DX12RHIDevice::GetNative(RHIResource *resource) {
+  return resource ? static_cast<DX12RHIResource *>(resource)->Resource.Get()
+                  : nullptr;
+}
+
+ID3D12CommandQueue *DX12RHIDevice::GetNative(RHICommandQueue *queue) {
+  return static_cast<DX12RHICommandQueue *>(queue)->Queue.Get();
+}
+
+ID3D12GraphicsCommandList *
+DX12RHIDevice::GetNative(RHICommandList *commandList) {
+  return static_cast<DX12RHICommandList *>(commandList)->List.Get();
+}
+
+ID3D12DescriptorHeap *DX12RHIDevice::GetNative(RHIDescriptorHeap *heap) {
+  return static_cast<DX12RHIDescriptorHeap *>(heap)->Heap.Get();
+}
+
+} // namespace Forge
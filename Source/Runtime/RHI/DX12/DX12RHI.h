@@ -0,0 +1,72 @@
+#pragma once
+#include "../RHI.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+
+namespace Forge {
+
+DXGI_FORMAT ToDXGIFormat(RHIFormat format);
+D3D12_RESOURCE_STATES ToD3D12States(RHIResourceState state);
+
+// D3D12 backend. 1:1 wrapper, no extra state tracking (the debug layer
+// validates; the Null backend covers headless validation).
+class DX12RHIDevice : public RHIDevice {
+public:
+  explicit DX12RHIDevice(ID3D12Device *device);
+  ~DX12RHIDevice() override = default;
+
+  RHIBackend GetBackend() const override { return RHIBackend::DX12; }
+
+  std::unique_ptr<RHICommandQueue> CreateCommandQueue(RHIQueueType type) override;
+  std::unique_ptr<RHICommandList> CreateCommandList(RHIQueueType type) override;
+  std::unique_ptr<RHIFence> CreateFence(uint64_t initialValue) override;
+  std::unique_ptr<RHIResource>
+  CreateResource(const RHIResourceDesc &desc) override;
+  std::unique_ptr<RHIDescriptorHeap>
+  CreateDescriptorHeap(const RHIDescriptorHeapDesc &desc) override;
+  std::unique_ptr<RHIHeap> CreateHeap(const RHIHeapDesc &desc) override;
+  std::unique_ptr<RHIQueryHeap>
+  CreateQueryHeap(const RHIQueryHeapDesc &desc) override;
+  std::unique_ptr<RHIResource>
+  CreatePlacedResource(RHIHeap *heap, uint64_t offset,
+                       const RHIResourceDesc &desc) override;
+  RHIAllocationInfo
+  GetAllocationInfo(const RHIResourceDesc &desc) const override;
+  std::unique_ptr<RHIPipelineState>
+  CreateGraphicsPipeline(const RHIGraphicsPipelineDesc &desc) override;
+  std::unique_ptr<RHIPipelineLibrary>
+  CreatePipelineLibrary(const void *data, size_t size) override;
+
+  // library != nullptr: LoadGraphicsPipeline(name) instead of compiling;
+  // returns nullptr if the library has no matching entry
+  std::unique_ptr<RHIPipelineState>
+  CreateGraphicsPipeline(const RHIGraphicsPipelineDesc &desc,
+                         ID3D12PipelineLibrary *library, const wchar_t *name);
+
+  void CreateRenderTargetView(RHIResource *resource,
+                              RHICPUDescriptor dest) override;
+  void CreateDepthStencilView(RHIResource *resource,
+                              RHICPUDescriptor dest) override;
+  void CreateShaderResourceView(RHIResource *resource,
+                                RHICPUDescriptor dest) override;
+  void CopyDescriptors(RHICPUDescriptor dest, const RHICPUDescriptor *sources,
+                       uint32_t count, RHIDescriptorHeapType type) override;
+
+  // Wraps an externally created resource (swap chain back buffers)
+  std::unique_ptr<RHIResource> WrapResource(ID3D12Resource *resource,
+                                            RHIResourceState currentState,
+                                            const std::string &name);
+
+  ID3D12Device *GetNativeDevice() const { return m_Device; }
+
+  // Native access for code that still talks to D3D12 (swap chain, ImGui)
+  static ID3D12Resource *GetNative(RHIResource *resource);
+  static ID3D12CommandQueue *GetNative(RHICommandQueue *queue);
+  static ID3D12GraphicsCommandList *GetNative(RHICommandList *commandList);
+  static ID3D12DescriptorHeap *GetNative(RHIDescriptorHeap *heap);
+
+private:
+  ID3D12Device *m_Device;
+};
+
+} // namespace Forge
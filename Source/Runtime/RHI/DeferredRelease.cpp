@@ -0,0 +1,41 @@
+#include "DeferredRelease.h"
+#include <algorithm>
+
+namespace Forge {
+
+DeferredReleaseQueue::~DeferredReleaseQueue() { Shutdown(); }
+
+void DeferredReleaseQueue::Shutdown() {
+  while (!m_Entries.empty()) {
+    m_Entries.pop_front();
+    m_Stats.Released++;
+  }
+  m_Stats.Pending = 0;
+}
+
+void DeferredReleaseQueue::BeginFrame(uint64_t completedFenceValue) {
+  // Entries are stamped in submission order: stop at the first unfinished
+  while (!m_Entries.empty() && m_Entries.front().FenceValue != 0 &&
+         m_Entries.front().FenceValue <= completedFenceValue) {
+    m_Entries.pop_front();
+    m_Stats.Released++;
+  }
+  m_Stats.Pending = (uint32_t)m_Entries.size();
+}
+
+void DeferredReleaseQueue::EndFrame(uint64_t fenceValue) {
+  for (auto it = m_Entries.rbegin(); it != m_Entries.rend(); ++it) {
+    if (it->FenceValue != 0)
+      break;
+    it->FenceValue = fenceValue;
+  }
+}
+
+void DeferredReleaseQueue::Push(std::shared_ptr<void> object) {
+  m_Entries.push_back({0, std::move(object)});
+  m_Stats.Retired++;
+  m_Stats.Pending = (uint32_t)m_Entries.size();
+  m_Stats.PeakPending = std::max(m_Stats.PeakPending, m_Stats.Pending);
+}
+
+} // namespace Forge
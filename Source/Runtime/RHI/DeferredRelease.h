@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+namespace Forge {
+
+struct DeferredReleaseStats {
+  uint64_t Retired = 0;  // objects handed to the queue
+  uint64_t Released = 0; // objects actually destroyed
+  uint32_t Pending = 0;  // waiting on a fence
+  uint32_t PeakPending = 0;
+};
+
+// Keeps RHI objects alive until the GPU is past the last frame that could
+// reference them, so replacing a resource never needs a WaitIdle. Objects
+// are released in the order they were retired: retire placed resources
+// before their heap. BeginFrame / EndFrame follow UploadRing.
+class DeferredReleaseQueue {
+public:
+  DeferredReleaseQueue() = default;
+  ~DeferredReleaseQueue();
+
+  // Releases everything still pending. The caller waits for the GPU first
+  void Shutdown();
+
+  // completedFenceValue: last fence value the GPU finished
+  void BeginFrame(uint64_t completedFenceValue);
+  // fenceValue: value signaled after this frame's command lists
+  void EndFrame(uint64_t fenceValue);
+
+  // Destroyed once the current frame has completed on the GPU
+  template <typename T> void Retire(std::unique_ptr<T> object) {
+    if (object)
+      Push(std::shared_ptr<void>(std::move(object)));
+  }
+
+  const DeferredReleaseStats &GetStats() const { return m_Stats; }
+
+private:
+  struct Entry {
+    uint64_t FenceValue = 0; // 0 = current frame, not submitted yet
+    std::shared_ptr<void> Object;
+  };
+
+  void Push(std::shared_ptr<void> object);
+
+  std::deque<Entry> m_Entries;
+  DeferredReleaseStats m_Stats;
+};
+
+} // namespace Forge
@@ -0,0 +1,150 @@
+#include "DescriptorAllocator.h"
+#include <iostream>
+
+namespace Forge {
+
+DescriptorAllocator::~DescriptorAllocator() { Shutdown(); }
+
+bool DescriptorAllocator::Initialize(RHIDevice *device,
+                                     const DescriptorAllocatorConfig &config) {
+  m_Device = device;
+  m_Config = config;
+
+  m_Heap = device->CreateDescriptorHeap(
+      {RHIDescriptorHeapType::CBV_SRV_UAV,
+       config.PersistentCount + config.TransientCount, true});
+  m_StagingHeap = device->CreateDescriptorHeap(
+      {RHIDescriptorHeapType::CBV_SRV_UAV, config.StagingCount, false});
+  if (!m_Heap || !m_StagingHeap) {
+    std::cerr << "[DescriptorAllocator] Failed to create descriptor heaps"
+              << std::endl;
+    return false;
+  }
+
+  m_Persistent.Reset(config.PersistentCount);
+  m_Transient.Reset(config.TransientCount);
+  m_Staging.Reset(config.StagingCount);
+
+  std::cout << "[DescriptorAllocator] persistent " << config.PersistentCount
+            << ", transient " << config.TransientCount << ", staging "
+            << config.StagingCount << std::endl;
+  return true;
+}
+
+void DescriptorAllocator::Shutdown() {
+  m_CurrentFrees.clear();
+  m_RetiredFrees.clear();
+  m_StagingHeap.reset();
+  m_Heap.reset();
+  m_Device = nullptr;
+}
+
+void DescriptorAllocator::BeginFrame(uint64_t completedFenceValue) {
+  m_Transient.Reclaim(completedFenceValue);
+
+  size_t kept = 0;
+  for (size_t i = 0; i < m_RetiredFrees.size(); i++) {
+    RetiredFrame &frame = m_RetiredFrees[i];
+    if (frame.FenceValue <= completedFenceValue) {
+      for (const PendingFree &pending : frame.Frees) {
+        m_Persistent.Free(pending.Index, pending.Count);
+      }
+    } else if (kept++ != i) {
+      // A self-move would empty the frame's list
+      m_RetiredFrees[kept - 1] = std::move(frame);
+    }
+  }
+  m_RetiredFrees.resize(kept);
+}
+
+void DescriptorAllocator::EndFrame(uint64_t fenceValue) {
+  m_Transient.FinishFrame(fenceValue);
+  if (!m_CurrentFrees.empty()) {
+    m_RetiredFrees.push_back({fenceValue, std::move(m_CurrentFrees)});
+    m_CurrentFrees.clear();
+  }
+}
+
+DescriptorRange DescriptorAllocator::MakeRange(RHIDescriptorHeap *heap,
+                                               uint32_t index,
+                                               uint32_t count) const {
+  DescriptorRange range;
+  range.Index = index;
+  range.Count = count;
+  range.CPU = heap->GetCPU(index);
+  range.GPU = heap->GetDesc().ShaderVisible ? heap->GetGPU(index)
+                                            : RHIGPUDescriptor{};
+  return range;
+}
+
+DescriptorRange DescriptorAllocator::AllocatePersistent(uint32_t count) {
+  uint64_t offset = m_Persistent.Allocate(count);
+  if (offset == FreeListAllocator::InvalidOffset) {
+    std::cerr << "[DescriptorAllocator] Persistent range exhausted ("
+              << count << " requested)" << std::endl;
+    return {};
+  }
+  return MakeRange(m_Heap.get(), (uint32_t)offset, count);
+}
+
+void DescriptorAllocator::FreePersistent(DescriptorRange &range) {
+  if (!range.IsValid())
+    return;
+  m_CurrentFrees.push_back({range.Index, range.Count});
+  range = {};
+}
+
+DescriptorRange DescriptorAllocator::AllocateTransient(uint32_t count) {
+  uint64_t offset = m_Transient.Allocate(count, 1);
+  if (offset == RingAllocator::InvalidOffset) {
+    std::cerr << "[DescriptorAllocator] Transient ring exhausted (" << count
+              << " requested)" << std::endl;
+    return {};
+  }
+  return MakeRange(m_Heap.get(), m_Config.PersistentCount + (uint32_t)offset,
+                   count);
+}
+
+DescriptorRange DescriptorAllocator::AllocateStaging(uint32_t count) {
+  uint64_t offset = m_Staging.Allocate(count);
+  if (offset == FreeListAllocator::InvalidOffset) {
+    std::cerr << "[DescriptorAllocator] Staging heap exhausted (" << count
+              << " requested)" << std::endl;
+    return {};
+  }
+  return MakeRange(m_StagingHeap.get(), (uint32_t)offset, count);
+}
+
+void DescriptorAllocator::FreeStaging(DescriptorRange &range) {
+  if (!range.IsValid())
+    return;
+  m_Staging.Free(range.Index, range.Count);
+  range = {};
+}
+
+DescriptorRange
+DescriptorAllocator::CopyToTransient(const RHICPUDescriptor *sources,
+                                     uint32_t count) {
+  DescriptorRange table = AllocateTransient(count);
+  if (table.IsValid()) {
+    m_Device->CopyDescriptors(table.CPU, sources, count,
+                              RHIDescriptorHeapType::CBV_SRV_UAV);
+  }
+  return table;
+}
+
+DescriptorAllocatorStats DescriptorAllocator::GetStats() const {
+  DescriptorAllocatorStats stats;
+  stats.Persistent = m_Persistent.GetStats();
+  stats.Staging = m_Staging.GetStats();
+  stats.Transient = m_Transient.GetStats();
+
+  uint32_t pending = (uint32_t)m_CurrentFrees.size();
+  for (const RetiredFrame &frame : m_RetiredFrees) {
+    pending += (uint32_t)frame.Frees.size();
+  }
+  stats.PendingFrees = pending;
+  return stats;
+}
+
+} // namespace Forge
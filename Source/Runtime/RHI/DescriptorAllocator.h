@@ -0,0 +1,95 @@
+#pragma once
+#include "../Core/FreeListAllocator.h"
+#include "../Core/RingAllocator.h"
+#include "RHI.h"
+#include <memory>
+#include <vector>
+
+namespace Forge {
+
+struct DescriptorRange {
+  uint32_t Index = UINT32_MAX; // first slot in its heap
+  uint32_t Count = 0;
+  RHICPUDescriptor CPU;
+  RHIGPUDescriptor GPU; // 0 for staging ranges
+
+  bool IsValid() const { return Count > 0; }
+};
+
+struct DescriptorAllocatorConfig {
+  uint32_t PersistentCount = 1024; // long-lived SRVs (textures, viewports)
+  uint32_t TransientCount = 4096;  // per-frame tables, shared by all frames
+  uint32_t StagingCount = 1024;    // CPU-only, copied into transient tables
+};
+
+struct DescriptorAllocatorStats {
+  FreeListStats Persistent;
+  FreeListStats Staging;
+  RingAllocatorStats Transient;
+  uint32_t PendingFrees = 0; // persistent ranges waiting on a fence
+};
+
+// CBV/SRV/UAV descriptors for one shader-visible heap:
+//  [0, PersistentCount)                - free-list, freed after a fence
+//  [PersistentCount, +TransientCount)  - per-frame ring, reclaimed by fence
+// plus a CPU-only staging heap whose descriptors are gathered into
+// contiguous transient tables with one CopyDescriptors call.
+class DescriptorAllocator {
+public:
+  DescriptorAllocator() = default;
+  ~DescriptorAllocator();
+
+  bool Initialize(RHIDevice *device, const DescriptorAllocatorConfig &config);
+  void Shutdown();
+
+  // completedFenceValue: last fence value the GPU finished
+  void BeginFrame(uint64_t completedFenceValue);
+  // fenceValue: value signaled after this frame's command lists
+  void EndFrame(uint64_t fenceValue);
+
+  DescriptorRange AllocatePersistent(uint32_t count = 1);
+  // Deferred: the slots are reused once the current frame has completed
+  void FreePersistent(DescriptorRange &range);
+
+  // Valid for the current frame only
+  DescriptorRange AllocateTransient(uint32_t count);
+
+  DescriptorRange AllocateStaging(uint32_t count = 1);
+  // Immediate: staging descriptors are never read by the GPU
+  void FreeStaging(DescriptorRange &range);
+
+  // Bulk-copies staging descriptors into one contiguous transient table
+  DescriptorRange CopyToTransient(const RHICPUDescriptor *sources,
+                                  uint32_t count);
+
+  RHIDescriptorHeap *GetHeap() const { return m_Heap.get(); }
+  DescriptorAllocatorStats GetStats() const;
+
+private:
+  DescriptorRange MakeRange(RHIDescriptorHeap *heap, uint32_t index,
+                            uint32_t count) const;
+
+  struct PendingFree {
+    uint32_t Index;
+    uint32_t Count;
+  };
+  struct RetiredFrame {
+    uint64_t FenceValue;
+    std::vector<PendingFree> Frees;
+  };
+
+  RHIDevice *m_Device = nullptr;
+  DescriptorAllocatorConfig m_Config;
+
+  std::unique_ptr<RHIDescriptorHeap> m_Heap;        // shader visible
+  std::unique_ptr<RHIDescriptorHeap> m_StagingHeap; // CPU only
+
+  FreeListAllocator m_Persistent;
+  RingAllocator m_Transient;
+  FreeListAllocator m_Staging;
+
+  std::vector<PendingFree> m_CurrentFrees;
+  std::vector<RetiredFrame> m_RetiredFrees;
+};
+
+} // namespace Forge
@@ -0,0 +1,122 @@
+#include "FrameContext.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace Forge {
+
+FrameContextRing::~FrameContextRing() { Shutdown(); }
+
+bool FrameContextRing::Initialize(RHIDevice *device, RHICommandQueue *queue,
+                                  uint32_t framesInFlight) {
+  m_Device = device;
+  m_Queue = queue;
+  framesInFlight = std::clamp(framesInFlight, 1u, MaxFramesInFlight);
+
+  m_Frames.resize(framesInFlight);
+  for (Frame &frame : m_Frames) {
+    frame.CommandLists.push_back(device->CreateCommandList(queue->GetType()));
+    if (!frame.CommandLists[0])
+      return false;
+  }
+
+  m_Fence = device->CreateFence(0);
+  if (!m_Fence)
+    return false;
+
+  std::cout << "[FrameContext] " << framesInFlight << " frame(s) in flight"
+            << std::endl;
+  return true;
+}
+
+void FrameContextRing::Shutdown() {
+  if (m_Fence)
+    WaitIdle();
+  m_Frames.clear();
+  m_Fence.reset();
+  m_Queue = nullptr;
+  m_Device = nullptr;
+}
+
+RHICommandList *FrameContextRing::BeginFrame() {
+  Frame &frame = m_Frames[m_FrameIndex];
+
+  // Slot is reused N frames later: only block if the GPU is still on it
+  if (m_Fence->GetCompletedValue() < frame.FenceValue) {
+    auto start = std::chrono::high_resolution_clock::now();
+    m_Fence->Wait(frame.FenceValue);
+    m_Stats.LastStallMs = std::chrono::duration<double, std::milli>(
+                              std::chrono::high_resolution_clock::now() -
+                              start)
+                              .count();
+    m_Stats.CPUStallMs += m_Stats.LastStallMs;
+    m_Stats.CPUStalls++;
+  } else {
+    m_Stats.LastStallMs = 0.0;
+  }
+
+  frame.UsedLists = 0;
+  m_FrameOpen = true;
+  RHICommandList *commandList = OpenNextList();
+  m_MainList = 0;
+  return commandList;
+}
+
+RHICommandList *FrameContextRing::OpenNextList() {
+  Frame &frame = m_Frames[m_FrameIndex];
+  if (frame.UsedLists == frame.CommandLists.size()) {
+    // Safe to create lazily: the slot's previous submission has completed
+    frame.CommandLists.push_back(
+        m_Device->CreateCommandList(m_Queue->GetType()));
+  }
+  RHICommandList *commandList = frame.CommandLists[frame.UsedLists++].get();
+  commandList->Reset();
+  return commandList;
+}
+
+const std::vector<RHICommandList *> &
+FrameContextRing::ForkCommandLists(uint32_t count) {
+  m_Forked.clear();
+  if (!m_FrameOpen)
+    return m_Forked;
+
+  for (uint32_t i = 0; i < count; i++)
+    m_Forked.push_back(OpenNextList());
+
+  RHICommandList *continuation = OpenNextList();
+  m_MainList = m_Frames[m_FrameIndex].UsedLists - 1;
+  if (m_ContinuationSetup)
+    m_ContinuationSetup(continuation);
+  return m_Forked;
+}
+
+uint64_t FrameContextRing::Submit() {
+  if (!m_FrameOpen)
+    return 0;
+
+  Frame &frame = m_Frames[m_FrameIndex];
+  m_Submission.clear();
+  for (uint32_t i = 0; i < frame.UsedLists; i++) {
+    frame.CommandLists[i]->Close();
+    m_Submission.push_back(frame.CommandLists[i].get());
+  }
+  // One Execute for the whole frame, in recording order
+  m_Queue->Execute(m_Submission.data(), (uint32_t)m_Submission.size());
+  m_Stats.LastCommandLists = frame.UsedLists;
+
+  frame.FenceValue = m_NextFenceValue++;
+  m_Queue->Signal(m_Fence.get(), frame.FenceValue);
+
+  m_FrameOpen = false;
+  m_FrameIndex = (m_FrameIndex + 1) % (uint32_t)m_Frames.size();
+  m_Stats.FramesSubmitted++;
+  return frame.FenceValue;
+}
+
+void FrameContextRing::WaitIdle() {
+  uint64_t last = m_NextFenceValue - 1;
+  if (last > 0)
+    m_Fence->Wait(last);
+}
+
+} // namespace Forge
@@ -0,0 +1,94 @@
+#pragma once
+#include "RHI.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Forge {
+
+static constexpr uint32_t MaxFramesInFlight = 4;
+
+struct FrameSyncStats {
+  uint64_t FramesSubmitted = 0;
+  uint64_t CPUStalls = 0;      // BeginFrame had to wait for the GPU
+  double CPUStallMs = 0.0;     // total time blocked in BeginFrame
+  double LastStallMs = 0.0;
+  uint32_t LastCommandLists = 0; // lists in the last Execute
+};
+
+// Ring of per-frame command lists (each owns its allocator) plus one fence
+// value per slot. The CPU only blocks when it is about to reuse a slot the
+// GPU has not finished, i.e. when it gets more than N frames ahead.
+// A frame may fork extra lists for parallel recording; every list of the
+// frame is submitted in order by a single Execute.
+class FrameContextRing {
+public:
+  FrameContextRing() = default;
+  ~FrameContextRing();
+
+  bool Initialize(RHIDevice *device, RHICommandQueue *queue,
+                  uint32_t framesInFlight);
+  void Shutdown();
+
+  // Waits for this slot's previous submission, resets and opens its list
+  RHICommandList *BeginFrame();
+  // Opens `count` lists that execute after everything recorded so far and
+  // continues the main list in a new list after them (GetCommandList()
+  // changes). Each forked list may be recorded on its own thread. No bound
+  // state carries over between lists.
+  const std::vector<RHICommandList *> &ForkCommandLists(uint32_t count);
+  // Called on every continuation list to re-bind frame-wide state (back
+  // buffer render target, descriptor heaps)
+  void SetContinuationSetup(std::function<void(RHICommandList *)> setup) {
+    m_ContinuationSetup = std::move(setup);
+  }
+
+  // Closes + executes the frame's lists, signals and returns the slot's
+  // fence value (0 if no frame was open)
+  uint64_t Submit();
+  // Blocks until every submitted frame has completed
+  void WaitIdle();
+
+  RHICommandList *GetCommandList() const {
+    return m_Frames[m_FrameIndex].CommandLists[m_MainList].get();
+  }
+  uint32_t GetFrameIndex() const { return m_FrameIndex; }
+  uint32_t GetFramesInFlight() const { return (uint32_t)m_Frames.size(); }
+
+  // Fence value the current frame will signal / last value the GPU reached
+  uint64_t GetCurrentFenceValue() const { return m_NextFenceValue; }
+  uint64_t GetCompletedFenceValue() const {
+    return m_Fence ? m_Fence->GetCompletedValue() : 0;
+  }
+  RHIFence *GetFence() const { return m_Fence.get(); }
+
+  const FrameSyncStats &GetStats() const { return m_Stats; }
+
+private:
+  struct Frame {
+    // [0, UsedLists) are submitted in order; the pool only grows
+    std::vector<std::unique_ptr<RHICommandList>> CommandLists;
+    uint32_t UsedLists = 0;
+    uint64_t FenceValue = 0; // 0 = never submitted
+  };
+
+  RHICommandList *OpenNextList();
+
+  RHIDevice *m_Device = nullptr;
+  RHICommandQueue *m_Queue = nullptr;
+  std::vector<Frame> m_Frames;
+  std::unique_ptr<RHIFence> m_Fence;
+  uint64_t m_NextFenceValue = 1;
+  uint32_t m_FrameIndex = 0;
+  uint32_t m_MainList = 0; // index of the main thread's current list
+  bool m_FrameOpen = false;
+
+  std::function<void(RHICommandList *)> m_ContinuationSetup;
+  std::vector<RHICommandList *> m_Forked;
+  std::vector<RHICommandList *> m_Submission;
+
+  FrameSyncStats m_Stats;
+};
+
+} // namespace Forge
@@ -0,0 +1,172 @@
+#include "GPUProfiler.h"
+#include "../Core/Profiler.h"
+#include <algorithm>
+#include <iostream>
+
+namespace Forge {
+
+GPUProfiler::~GPUProfiler() { Shutdown(); }
+
+bool GPUProfiler::Initialize(RHIDevice *device, RHICommandQueue *queue,
+                             uint32_t framesInFlight,
+                             const std::string &trackName) {
+  m_Queue = queue;
+  m_Frequency = queue->GetTimestampFrequency();
+  if (m_Frequency == 0) {
+    std::cerr << "[GPUProfiler] Queue has no timestamps" << std::endl;
+    return false;
+  }
+
+  const uint32_t queryCount = framesInFlight * MaxScopesPerFrame * 2;
+  m_QueryHeap = device->CreateQueryHeap({queryCount, "GPUProfiler Queries"});
+  // Readback heaps stay in CopyDest and may stay mapped
+  m_Readback = device->CreateResource(RHIResourceDesc::Buffer(
+      queryCount * sizeof(uint64_t), RHIHeapType::Readback,
+      RHIResourceState::CopyDest, "GPUProfiler Readback"));
+  m_ReadbackData =
+      m_Readback ? static_cast<const uint64_t *>(m_Readback->Map()) : nullptr;
+  if (!m_QueryHeap || !m_ReadbackData) {
+    std::cerr << "[GPUProfiler] Failed to create query heap / readback buffer"
+              << std::endl;
+    Shutdown();
+    return false;
+  }
+
+  m_Frames.assign(framesInFlight, {});
+  m_Current = 0;
+  m_Depth = 0;
+  m_Track = Profiler::CreateTrack(trackName);
+  std::cout << "[GPUProfiler] " << framesInFlight << " x "
+            << MaxScopesPerFrame << " scopes, "
+            << m_Frequency / 1000 << " kHz timestamps" << std::endl;
+  return true;
+}
+
+void GPUProfiler::Shutdown() {
+  if (m_Readback && m_ReadbackData)
+    m_Readback->Unmap();
+  m_ReadbackData = nullptr;
+  m_Readback.reset();
+  m_QueryHeap.reset();
+  m_Frames.clear();
+}
+
+void GPUProfiler::BeginFrame(uint64_t completedFenceValue) {
+  if (!m_QueryHeap)
+    return;
+
+  m_CalibrationTicks = m_Queue->GetCurrentTimestamp();
+  m_CalibrationNs = Profiler::GetTimeNs();
+
+  // Oldest first: the slot about to be recorded, then the ones after it
+  m_Stats.PendingFrames = 0;
+  const uint32_t slots = (uint32_t)m_Frames.size();
+  for (uint32_t i = 0; i < slots; i++) {
+    uint32_t slot = (m_Current + i) % slots;
+    if (m_Frames[slot].FenceValue == 0)
+      continue;
+    if (m_Frames[slot].FenceValue <= completedFenceValue)
+      ReadBack(slot);
+    else
+      m_Stats.PendingFrames++;
+  }
+
+  Frame &frame = m_Frames[m_Current];
+  if (frame.FenceValue != 0) {
+    // The caller did not wait for this slot's frame; its queries are about
+    // to be overwritten
+    m_Stats.FramesLost++;
+    m_Stats.PendingFrames--;
+  }
+  frame.Scopes.clear();
+  frame.FenceValue = 0;
+  m_Depth = 0;
+}
+
+void GPUProfiler::Resolve(RHICommandList *commandList, uint64_t fenceValue) {
+  if (!m_QueryHeap)
+    return;
+
+  Frame &frame = m_Frames[m_Current];
+  for (uint32_t scope = 0; scope < (uint32_t)frame.Scopes.size(); scope++) {
+    if (!frame.Scopes[scope].Ended) {
+      commandList->WriteTimestamp(m_QueryHeap.get(),
+                                  GetQuery(m_Current, scope, true));
+      frame.Scopes[scope].Ended = true;
+    }
+  }
+  if (!frame.Scopes.empty()) {
+    const uint32_t first = GetQuery(m_Current, 0, false);
+    commandList->ResolveQueries(m_QueryHeap.get(), first,
+                                (uint32_t)frame.Scopes.size() * 2,
+                                m_Readback.get(), first * sizeof(uint64_t));
+    frame.FenceValue = fenceValue;
+  }
+  m_Current = (m_Current + 1) % (uint32_t)m_Frames.size();
+}
+
+uint32_t GPUProfiler::BeginScope(RHICommandList *commandList,
+                                 const char *name) {
+  if (!m_QueryHeap)
+    return InvalidScope;
+  Frame &frame = m_Frames[m_Current];
+  if (frame.Scopes.size() >= MaxScopesPerFrame) {
+    m_Stats.DroppedScopes++;
+    return InvalidScope;
+  }
+
+  uint32_t scope = (uint32_t)frame.Scopes.size();
+  frame.Scopes.push_back({name, m_Depth++, false});
+  commandList->WriteTimestamp(m_QueryHeap.get(),
+                              GetQuery(m_Current, scope, false));
+  return scope;
+}
+
+void GPUProfiler::EndScope(RHICommandList *commandList, uint32_t scope) {
+  if (scope == InvalidScope)
+    return;
+  Frame &frame = m_Frames[m_Current];
+  if (scope >= frame.Scopes.size() || frame.Scopes[scope].Ended)
+    return;
+
+  frame.Scopes[scope].Ended = true;
+  m_Depth = frame.Scopes[scope].Depth;
+  commandList->WriteTimestamp(m_QueryHeap.get(),
+                              GetQuery(m_Current, scope, true));
+}
+
+void GPUProfiler::ReadBack(uint32_t slot) {
+  Frame &frame = m_Frames[slot];
+  const double nsPerTick = 1e9 / (double)m_Frequency;
+  auto toNs = [&](uint64_t ticks) {
+    return m_CalibrationNs +
+           (int64_t)((double)(int64_t)(ticks - m_CalibrationTicks) *
+                     nsPerTick);
+  };
+
+  m_LastFrame.clear();
+  int64_t frameStart = INT64_MAX, frameEnd = INT64_MIN;
+  const bool profiling = Profiler::IsEnabled();
+  for (uint32_t scope = 0; scope < (uint32_t)frame.Scopes.size(); scope++) {
+    GPUScopeTiming timing;
+    timing.Name = frame.Scopes[scope].Name;
+    timing.Depth = frame.Scopes[scope].Depth;
+    timing.StartNs = toNs(m_ReadbackData[GetQuery(slot, scope, false)]);
+    timing.EndNs = std::max(
+        timing.StartNs, toNs(m_ReadbackData[GetQuery(slot, scope, true)]));
+    frameStart = std::min(frameStart, timing.StartNs);
+    frameEnd = std::max(frameEnd, timing.EndNs);
+    if (profiling) {
+      Profiler::AddTrackEvent(m_Track, timing.Name, timing.StartNs,
+                              timing.EndNs, timing.Depth);
+    }
+    m_LastFrame.push_back(timing);
+  }
+
+  m_Stats.FramesResolved++;
+  m_Stats.Scopes += frame.Scopes.size();
+  m_Stats.LastFrameMs = (frameEnd - frameStart) / 1e6;
+  frame.FenceValue = 0;
+}
+
+} // namespace Forge
@@ -0,0 +1,131 @@
+#pragma once
+#include "RHI.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Forge {
+
+struct GPUScopeTiming {
+  const char *Name = nullptr;
+  uint32_t Depth = 0;
+  // On the CPU profiler's timescale (Profiler::GetTimeNs)
+  int64_t StartNs = 0;
+  int64_t EndNs = 0;
+
+  double GetMs() const { return (EndNs - StartNs) / 1e6; }
+};
+
+struct GPUProfilerStats {
+  uint64_t FramesResolved = 0; // read back
+  uint64_t FramesLost = 0;     // slot reused before the GPU finished it
+  uint64_t Scopes = 0;
+  uint64_t DroppedScopes = 0; // past MaxScopesPerFrame
+  uint32_t PendingFrames = 0; // resolved on the GPU, not read yet
+  double LastFrameMs = 0.0;   // first begin to last end, newest frame read
+};
+
+// GPU time per scope (render graph passes, ImGui) from timestamp queries.
+// Every frame in flight owns a range of one query heap and of one readback
+// buffer: Resolve copies the frame's timestamps at the end of its command
+// lists, and a later BeginFrame reads the frames whose fence the GPU has
+// passed (BeginFrame / Resolve follow UploadRing). Timestamps are mapped
+// onto the CPU profiler's clock through the queue's current timestamp and
+// added to its timeline as a track.
+//
+// Scopes nest and are recorded from one thread in submission order; the
+// lists of a frame execute in order, so a scope may begin and end on
+// different lists. Names must outlive the profiler (string literals or
+// Profiler::InternName).
+class GPUProfiler {
+public:
+  static constexpr uint32_t MaxScopesPerFrame = 256;
+  static constexpr uint32_t InvalidScope = 0xffffffff;
+
+  GPUProfiler() = default;
+  ~GPUProfiler();
+
+  // False if the queue cannot write timestamps; scopes are then no-ops
+  bool Initialize(RHIDevice *device, RHICommandQueue *queue,
+                  uint32_t framesInFlight, const std::string &trackName);
+  void Shutdown();
+
+  // completedFenceValue: last fence value the GPU finished
+  void BeginFrame(uint64_t completedFenceValue);
+  // Records the resolve into the frame's last list; scopes still open end
+  // here. fenceValue: value signaled after this frame's command lists
+  void Resolve(RHICommandList *commandList, uint64_t fenceValue);
+
+  // InvalidScope when unavailable or the frame is full
+  uint32_t BeginScope(RHICommandList *commandList, const char *name);
+  void EndScope(RHICommandList *commandList, uint32_t scope);
+
+  bool IsAvailable() const { return m_QueryHeap != nullptr; }
+  // ProfileEvent::Thread of the scopes on the CPU profiler's timeline
+  uint32_t GetTrack() const { return m_Track; }
+  // The newest frame read back, scopes in begin order
+  const std::vector<GPUScopeTiming> &GetLastFrame() const {
+    return m_LastFrame;
+  }
+  const GPUProfilerStats &GetStats() const { return m_Stats; }
+
+private:
+  struct Scope {
+    const char *Name;
+    uint32_t Depth;
+    bool Ended;
+  };
+  struct Frame {
+    std::vector<Scope> Scopes;
+    uint64_t FenceValue = 0; // 0 = nothing to read back
+  };
+
+  void ReadBack(uint32_t slot);
+  uint32_t GetQuery(uint32_t slot, uint32_t scope, bool end) const {
+    return (slot * MaxScopesPerFrame + scope) * 2 + (end ? 1 : 0);
+  }
+
+  RHICommandQueue *m_Queue = nullptr;
+  std::unique_ptr<RHIQueryHeap> m_QueryHeap;
+  std::unique_ptr<RHIResource> m_Readback;
+  const uint64_t *m_ReadbackData = nullptr;
+  uint64_t m_Frequency = 0;
+  uint32_t m_Track = 0;
+
+  std::vector<Frame> m_Frames;
+  uint32_t m_Current = 0; // slot being recorded, its last frame the oldest
+  uint32_t m_Depth = 0;
+
+  // Queue clock to profiler time, sampled each BeginFrame
+  uint64_t m_CalibrationTicks = 0;
+  int64_t m_CalibrationNs = 0;
+
+  std::vector<GPUScopeTiming> m_LastFrame;
+  GPUProfilerStats m_Stats;
+};
+
+// Times the rest of the block on the GPU; profiler may be null. The list
+// must still be the one recorded on at the end of the block (no fork).
+class GPUProfileScope {
+public:
+  GPUProfileScope(GPUProfiler *profiler, RHICommandList *commandList,
+                  const char *name)
+      : m_Profiler(profiler), m_CommandList(commandList) {
+    if (m_Profiler)
+      m_Scope = m_Profiler->BeginScope(commandList, name);
+  }
+  ~GPUProfileScope() {
+    if (m_Profiler)
+      m_Profiler->EndScope(m_CommandList, m_Scope);
+  }
+  GPUProfileScope(const GPUProfileScope &) = delete;
+  GPUProfileScope &operator=(const GPUProfileScope &) = delete;
+
+private:
+  GPUProfiler *m_Profiler;
+  RHICommandList *m_CommandList;
+  uint32_t m_Scope = GPUProfiler::InvalidScope;
+};
+
+} // namespace Forge
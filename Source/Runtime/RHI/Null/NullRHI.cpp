@@ -0,0 +1,1267 @@
+#include "NullRHI.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace Forge {
+
+namespace {
+
+// Present and Common are the same state on D3D12
+RHIResourceState Normalize(RHIResourceState state) {
+  return state == RHIResourceState::Present ? RHIResourceState::Common
+                                            : state;
+}
+
+constexpr uint32_t DescriptorIncrement = 32;
+constexpr uint64_t GPUAddressShift = 32;
+constexpr uint64_t PlacementAlignment = 64 * 1024; // D3D12 default
+constexpr uint64_t TimestampFrequency = 1000000000;  // fake clock, ns
+
+} // namespace
+
+// --- Objects ---
+
+class NullRHIHeap;
+
+class NullRHIResource : public RHIResource {
+public:
+  NullRHIResource(NullRHIDevice *device, const RHIResourceDesc &desc)
+      : m_Device(device) {
+    m_Desc = desc;
+    State = Normalize(desc.InitialState);
+    ID = device->RegisterResource(this);
+
+    if (desc.Heap != RHIHeapType::Default &&
+        desc.Dimension == RHIResourceDimension::Buffer) {
+      m_Memory.resize((size_t)desc.Width);
+    }
+  }
+
+  ~NullRHIResource() override;
+
+  void *Map() override {
+    if (m_Memory.empty()) {
+      m_Device->ReportError("Map on non-CPU-visible resource '" +
+                            m_Desc.DebugName + "'");
+      return nullptr;
+    }
+    return m_Memory.data();
+  }
+  void Unmap() override {}
+
+  uint64_t GetGPUAddress() const override {
+    return (uint64_t)ID << GPUAddressShift;
+  }
+
+  uint32_t ID = 0;
+  RHIResourceState State = RHIResourceState::Common; // GPU timeline state
+  uint64_t LastUseSerial = 0;
+  // Last copy into the resource; other queues may only use it once that
+  // submission completed (or after a queue Wait on its fence)
+  const RHICommandQueue *WriteQueue = nullptr;
+  uint64_t WriteSerial = 0;
+
+  // Placed resources: memory range inside Heap. Only the resource that
+  // last received an aliasing barrier for a range may use it.
+  NullRHIHeap *Heap = nullptr;
+  uint64_t HeapOffset = 0;
+  uint64_t HeapSize = 0;
+  bool Active = true;
+
+  bool Overlaps(const NullRHIResource &other) const {
+    return HeapOffset < other.HeapOffset + other.HeapSize &&
+           other.HeapOffset < HeapOffset + HeapSize;
+  }
+
+private:
+  NullRHIDevice *m_Device;
+  std::vector<uint8_t> m_Memory;
+};
+
+class NullRHIHeap : public RHIHeap {
+public:
+  NullRHIHeap(NullRHIDevice *device, const RHIHeapDesc &desc)
+      : m_Device(device) {
+    m_Desc = desc;
+  }
+  ~NullRHIHeap() override {
+    for (NullRHIResource *resource : Placed) {
+      m_Device->ReportError("Heap '" + m_Desc.DebugName +
+                            "' destroyed before placed resource '" +
+                            resource->GetDesc().DebugName + "'");
+      resource->Heap = nullptr;
+    }
+  }
+
+  // Makes `resource` the owner of its range (aliasing barrier on the GPU
+  // timeline)
+  void Activate(NullRHIResource *resource) {
+    for (NullRHIResource *other : Placed) {
+      if (other != resource && other->Overlaps(*resource))
+        other->Active = false;
+    }
+    resource->Active = true;
+  }
+
+  std::vector<NullRHIResource *> Placed;
+
+private:
+  NullRHIDevice *m_Device;
+};
+
+NullRHIResource::~NullRHIResource() {
+  if (LastUseSerial > m_Device->GetCompletedSerial()) {
+    m_Device->ReportError("Resource '" + m_Desc.DebugName +
+                          "' destroyed while still in use by the GPU "
+                          "(submission " +
+                          std::to_string(LastUseSerial) + ", completed " +
+                          std::to_string(m_Device->GetCompletedSerial()) +
+                          ")");
+  }
+  if (Heap) {
+    auto &placed = Heap->Placed;
+    placed.erase(std::find(placed.begin(), placed.end(), this));
+  }
+  m_Device->UnregisterResource(ID);
+}
+
+class NullRHIDescriptorHeap : public RHIDescriptorHeap {
+public:
+  NullRHIDescriptorHeap(NullRHIDevice *device,
+                        const RHIDescriptorHeapDesc &desc)
+      : m_Device(device), Slots(desc.Count, 0) {
+    m_Desc = desc;
+    ID = device->RegisterHeap(this);
+  }
+  ~NullRHIDescriptorHeap() override { m_Device->UnregisterHeap(ID); }
+
+  RHICPUDescriptor GetCPUStart() const override {
+    return {(uint64_t)ID << 32};
+  }
+  RHIGPUDescriptor GetGPUStart() const override {
+    if (!m_Desc.ShaderVisible)
+      return {0};
+    return {(uint64_t)ID << 32};
+  }
+  uint32_t GetIncrementSize() const override { return DescriptorIncrement; }
+
+private:
+  NullRHIDevice *m_Device;
+
+public:
+  std::vector<uint32_t> Slots; // resource id per descriptor
+  uint32_t ID = 0;
+};
+
+class NullRHIQueryHeap : public RHIQueryHeap {
+public:
+  NullRHIQueryHeap(NullRHIDevice *device, const RHIQueryHeapDesc &desc)
+      : Values(desc.Count, 0), Written(desc.Count, false), m_Device(device) {
+    m_Desc = desc;
+    ID = device->RegisterQueryHeap(this);
+  }
+  ~NullRHIQueryHeap() override { m_Device->UnregisterQueryHeap(ID); }
+
+  uint32_t ID = 0;
+  // GPU side, updated at replay
+  std::vector<uint64_t> Values;
+  std::vector<bool> Written;
+
+private:
+  NullRHIDevice *m_Device;
+};
+
+class NullRHIFence : public RHIFence {
+public:
+  NullRHIFence(NullRHIDevice *device, uint64_t initialValue)
+      : m_Device(device), Value(initialValue) {}
+  ~NullRHIFence() override { m_Device->UnregisterFence(this); }
+
+  uint64_t GetCompletedValue() const override { return Value; }
+
+  void Wait(uint64_t value) override {
+    if (Value >= value)
+      return;
+    if (!m_Device->RetireUntilFence(this, value)) {
+      m_Device->ReportError("Fence wait for " + std::to_string(value) +
+                            " can never complete (value never signaled)");
+    }
+  }
+
+private:
+  NullRHIDevice *m_Device;
+
+public:
+  uint64_t Value;
+};
+
+class NullRHIPipelineState : public RHIPipelineState {
+public:
+  explicit NullRHIPipelineState(const RHIGraphicsPipelineDesc &desc)
+      : Name(desc.DebugName),
+        RootParameterCount((uint32_t)desc.RootParameters.size()),
+        DescHash(HashPipelineDesc(desc)) {}
+
+  std::string Name;
+  uint32_t RootParameterCount;
+  uint64_t DescHash;
+};
+
+// Stores desc hashes by name; Load mirrors ID3D12PipelineLibrary by refusing
+// a desc that differs from the stored one.
+class NullRHIPipelineLibrary : public RHIPipelineLibrary {
+public:
+  static constexpr uint32_t Magic = 0x314c504e; // "NPL1"
+
+  explicit NullRHIPipelineLibrary(NullRHIDevice *device) : m_Device(device) {}
+
+  bool Deserialize(const uint8_t *data, size_t size) {
+    size_t pos = 0;
+    auto read = [&](void *out, size_t bytes) {
+      if (pos + bytes > size)
+        return false;
+      memcpy(out, data + pos, bytes);
+      pos += bytes;
+      return true;
+    };
+    uint32_t magic = 0, count = 0;
+    if (!read(&magic, 4) || magic != Magic || !read(&count, 4))
+      return false;
+    for (uint32_t i = 0; i < count; i++) {
+      uint32_t length = 0;
+      uint64_t hash = 0;
+      if (!read(&length, 4) || pos + length > size)
+        return false;
+      std::string name((const char *)data + pos, length);
+      pos += length;
+      if (!read(&hash, 8))
+        return false;
+      m_Entries[name] = hash;
+    }
+    return true;
+  }
+
+  std::unique_ptr<RHIPipelineState>
+  Load(const std::string &name, const RHIGraphicsPipelineDesc &desc) override {
+    auto it = m_Entries.find(name);
+    if (it == m_Entries.end() || it->second != HashPipelineDesc(desc))
+      return nullptr;
+    m_Device->GetStats().PipelinesLoaded++;
+    return std::make_unique<NullRHIPipelineState>(desc);
+  }
+
+  bool Store(const std::string &name, RHIPipelineState *pipeline) override {
+    if (!pipeline || m_Entries.count(name))
+      return false; // D3D12 also rejects duplicate names
+    m_Entries[name] = static_cast<NullRHIPipelineState *>(pipeline)->DescHash;
+    return true;
+  }
+
+  std::vector<uint8_t> Serialize() const override {
+    std::vector<uint8_t> out;
+    auto write = [&](const void *bytes, size_t count) {
+      size_t offset = out.size();
+      out.resize(offset + count);
+      memcpy(out.data() + offset, bytes, count);
+    };
+    uint32_t count = (uint32_t)m_Entries.size();
+    write(&Magic, 4);
+    write(&count, 4);
+    for (const auto &[name, hash] : m_Entries) {
+      uint32_t length = (uint32_t)name.size();
+      write(&length, 4);
+      write(name.data(), length);
+      write(&hash, 8);
+    }
+    return out;
+  }
+
+private:
+  NullRHIDevice *m_Device;
+  std::unordered_map<std::string, uint64_t> m_Entries;
+};
+
+struct NullCommand {
+  enum class Type : uint8_t {
+    Barrier,
+    AliasingBarrier,
+    SetRenderTargets,
+    ClearRenderTarget,
+    ClearDepthStencil,
+    SetPipeline,
+    SetVertexBuffer,
+    SetDescriptorTable,
+    Draw,
+    CopyBuffer,
+    CopyTexture,
+    WriteTimestamp,
+    ResolveQueries,
+    Other,
+  };
+
+  Type CommandType = Type::Other;
+  uint32_t ResourceA = 0; // resource ids (captured at record time)
+  uint32_t ResourceB = 0;
+  RHIResourceState Before = RHIResourceState::Common;
+  RHIResourceState After = RHIResourceState::Common;
+  uint32_t DescriptorOffset = 0; // into NullRHICommandList::m_Descriptors
+  uint32_t DescriptorCount = 0;
+  uint64_t Extra = 0;
+  uint32_t QueryHeap = 0; // query heap id, queries [FirstQuery, +QueryCount)
+  uint32_t FirstQuery = 0;
+  uint32_t QueryCount = 0;
+};
+
+class NullRHICommandList : public RHICommandList {
+public:
+  NullRHICommandList(NullRHIDevice *device, RHIQueueType type)
+      : m_Device(device), m_Type(type) {}
+
+  RHIQueueType GetType() const override { return m_Type; }
+
+  void Reset() override {
+    if (LastSubmitSerial > m_Device->GetCompletedSerial()) {
+      m_Device->ReportError("Command list reset while its previous "
+                            "submission is still executing");
+    }
+    if (m_Open)
+      m_Device->ReportError("Command list reset while still recording");
+
+    Commands.clear();
+    m_Descriptors.clear();
+    m_Open = true;
+  }
+
+  void Close() override {
+    if (!m_Open)
+      m_Device->ReportError("Close on a command list that is not recording");
+    m_Open = false;
+    // Counters are list-local while recording (lists may be recorded on
+    // worker threads); fold them into the device on the submitting thread
+    NullRHIStats &stats = m_Device->GetStats();
+    stats.CommandsRecorded += m_Recorded.CommandsRecorded;
+    stats.Barriers += m_Recorded.Barriers;
+    stats.BarrierBatches += m_Recorded.BarrierBatches;
+    stats.Draws += m_Recorded.Draws;
+    stats.PipelineChanges += m_Recorded.PipelineChanges;
+    m_Recorded = {};
+  }
+
+  void ResourceBarriers(const RHIBarrier *barriers, uint32_t count) override {
+    if (!CheckOpen("ResourceBarriers"))
+      return;
+
+    m_Recorded.BarrierBatches++;
+    for (uint32_t i = 0; i < count; i++) {
+      NullCommand cmd;
+      cmd.ResourceA = GetID(barriers[i].Resource);
+      if (barriers[i].Type == RHIBarrierType::Aliasing) {
+        cmd.CommandType = NullCommand::Type::AliasingBarrier;
+        cmd.ResourceB = GetID(barriers[i].AliasBefore);
+      } else {
+        cmd.CommandType = NullCommand::Type::Barrier;
+        cmd.Before = Normalize(barriers[i].Before);
+        cmd.After = Normalize(barriers[i].After);
+      }
+      Push(cmd);
+      m_Recorded.Barriers++;
+    }
+  }
+
+  void SetDescriptorHeaps(RHIDescriptorHeap *const *, uint32_t) override {
+    PushOther("SetDescriptorHeaps");
+  }
+
+  void SetRenderTargets(const RHICPUDescriptor *rtvs, uint32_t count,
+                        const RHICPUDescriptor *dsv) override {
+    if (!CheckOpen("SetRenderTargets"))
+      return;
+
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::SetRenderTargets;
+    cmd.DescriptorOffset = (uint32_t)m_Descriptors.size();
+    cmd.DescriptorCount = count;
+    for (uint32_t i = 0; i < count; i++) {
+      m_Descriptors.push_back(rtvs[i]);
+    }
+    cmd.Extra = dsv ? dsv->Ptr : 0;
+    Push(cmd);
+  }
+
+  void ClearRenderTarget(RHICPUDescriptor rtv, const float *) override {
+    if (!CheckOpen("ClearRenderTarget"))
+      return;
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::ClearRenderTarget;
+    cmd.Extra = rtv.Ptr;
+    Push(cmd);
+  }
+
+  void ClearDepthStencil(RHICPUDescriptor dsv, float, uint8_t) override {
+    if (!CheckOpen("ClearDepthStencil"))
+      return;
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::ClearDepthStencil;
+    cmd.Extra = dsv.Ptr;
+    Push(cmd);
+  }
+
+  void SetViewport(const RHIViewport &) override { PushOther("SetViewport"); }
+  void SetScissor(const RHIRect &) override { PushOther("SetScissor"); }
+
+  void SetPipelineState(RHIPipelineState *pipeline) override {
+    if (!CheckOpen("SetPipelineState"))
+      return;
+    if (!pipeline)
+      m_Device->ReportError("SetPipelineState(nullptr)");
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::SetPipeline;
+    cmd.Extra = (uint64_t)(uintptr_t)pipeline;
+    Push(cmd);
+    m_Recorded.PipelineChanges++;
+  }
+
+  void SetGraphicsConstants(uint32_t, uint32_t, const void *) override {
+    PushOther("SetGraphicsConstants");
+  }
+  void SetGraphicsConstantBuffer(uint32_t, uint64_t gpuAddress) override {
+    if (!CheckOpen("SetGraphicsConstantBuffer"))
+      return;
+    // The resource id is encoded in the fake GPU address
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::Other;
+    cmd.ResourceA = (uint32_t)(gpuAddress >> GPUAddressShift);
+    Push(cmd);
+  }
+  void SetGraphicsDescriptorTable(uint32_t, RHIGPUDescriptor base) override {
+    if (!CheckOpen("SetGraphicsDescriptorTable"))
+      return;
+    // Shader-visible descriptors share their heap's CPU addresses
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::SetDescriptorTable;
+    cmd.Extra = base.Ptr;
+    Push(cmd);
+  }
+  void SetPrimitiveTopology(RHIPrimitiveTopology) override {
+    PushOther("SetPrimitiveTopology");
+  }
+
+  void SetVertexBuffer(uint32_t, RHIResource *buffer, uint64_t offset,
+                       uint32_t size, uint32_t) override {
+    if (!CheckOpen("SetVertexBuffer"))
+      return;
+    if (buffer && offset + size > buffer->GetDesc().Width) {
+      m_Device->ReportError("Vertex buffer view exceeds buffer '" +
+                            buffer->GetDesc().DebugName + "'");
+    }
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::SetVertexBuffer;
+    cmd.ResourceA = GetID(buffer);
+    Push(cmd);
+  }
+
+  void Draw(uint32_t, uint32_t instanceCount, uint32_t, uint32_t) override {
+    if (!CheckOpen("Draw"))
+      return;
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::Draw;
+    cmd.Extra = instanceCount;
+    Push(cmd);
+    m_Recorded.Draws++;
+  }
+
+  void CopyBufferRegion(RHIResource *dst, uint64_t dstOffset,
+                        RHIResource *src, uint64_t srcOffset,
+                        uint64_t size) override {
+    if (!CheckOpen("CopyBufferRegion"))
+      return;
+    if (dst && dstOffset + size > dst->GetDesc().Width)
+      m_Device->ReportError("CopyBufferRegion writes past the destination");
+    if (src && srcOffset + size > src->GetDesc().Width)
+      m_Device->ReportError("CopyBufferRegion reads past the source");
+
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::CopyBuffer;
+    cmd.ResourceA = GetID(dst);
+    cmd.ResourceB = GetID(src);
+    Push(cmd);
+  }
+
+  void CopyBufferToTexture(RHIResource *dst, uint32_t subresource,
+                           RHIResource *src, uint64_t srcOffset,
+                           uint32_t rowPitch) override {
+    if (!CheckOpen("CopyBufferToTexture"))
+      return;
+    if (dst && src) {
+      const RHIResourceDesc &desc = dst->GetDesc();
+      uint32_t mip = subresource % desc.MipLevels;
+      uint64_t rowBytes =
+          GetRowBytes(desc.Format, GetMipSize((uint32_t)desc.Width, mip));
+      uint64_t rows = GetRowCount(desc.Format, GetMipSize(desc.Height, mip));
+      if (desc.Dimension != RHIResourceDimension::Texture2D ||
+          subresource >= desc.MipLevels) {
+        m_Device->ReportError("CopyBufferToTexture: '" + desc.DebugName +
+                              "' has no subresource " +
+                              std::to_string(subresource));
+      }
+      if (rowPitch < rowBytes || rowPitch % RHITextureRowPitchAlignment ||
+          srcOffset % RHITexturePlacementAlignment) {
+        m_Device->ReportError("CopyBufferToTexture: misaligned footprint "
+                              "for '" + desc.DebugName + "'");
+      }
+      if (srcOffset + rowPitch * rows > src->GetDesc().Width)
+        m_Device->ReportError("CopyBufferToTexture reads past the source");
+    }
+
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::CopyTexture;
+    cmd.ResourceA = GetID(dst);
+    cmd.ResourceB = GetID(src);
+    Push(cmd);
+  }
+
+  void WriteTimestamp(RHIQueryHeap *heap, uint32_t index) override {
+    if (!CheckOpen("WriteTimestamp"))
+      return;
+    if (index >= heap->GetDesc().Count) {
+      m_Device->ReportError("WriteTimestamp: query " + std::to_string(index) +
+                            " is outside '" + heap->GetDesc().DebugName +
+                            "'");
+      return;
+    }
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::WriteTimestamp;
+    cmd.QueryHeap = static_cast<NullRHIQueryHeap *>(heap)->ID;
+    cmd.FirstQuery = index;
+    cmd.QueryCount = 1;
+    Push(cmd);
+  }
+
+  void ResolveQueries(RHIQueryHeap *heap, uint32_t first, uint32_t count,
+                      RHIResource *dst, uint64_t dstOffset) override {
+    if (!CheckOpen("ResolveQueries"))
+      return;
+    if ((uint64_t)first + count > heap->GetDesc().Count) {
+      m_Device->ReportError("ResolveQueries reads past '" +
+                            heap->GetDesc().DebugName + "'");
+      return;
+    }
+    if (dst->GetDesc().Heap != RHIHeapType::Readback ||
+        dstOffset % sizeof(uint64_t) != 0 ||
+        dstOffset + count * sizeof(uint64_t) > dst->GetDesc().Width) {
+      m_Device->ReportError("ResolveQueries: '" + dst->GetDesc().DebugName +
+                            "' is not a readback buffer with room at offset " +
+                            std::to_string(dstOffset));
+      return;
+    }
+    NullCommand cmd;
+    cmd.CommandType = NullCommand::Type::ResolveQueries;
+    cmd.ResourceA = GetID(dst);
+    cmd.Extra = dstOffset;
+    cmd.QueryHeap = static_cast<NullRHIQueryHeap *>(heap)->ID;
+    cmd.FirstQuery = first;
+    cmd.QueryCount = count;
+    Push(cmd);
+  }
+
+  bool IsOpen() const { return m_Open; }
+  const RHICPUDescriptor *GetDescriptors() const {
+    return m_Descriptors.data();
+  }
+
+  std::vector<NullCommand> Commands;
+  uint64_t LastSubmitSerial = 0;
+
+private:
+  bool CheckOpen(const char *what) {
+    if (m_Open)
+      return true;
+    m_Device->ReportError(std::string(what) +
+                          " recorded into a closed command list");
+    return false;
+  }
+
+  void Push(const NullCommand &cmd) {
+    Commands.push_back(cmd);
+    m_Recorded.CommandsRecorded++;
+  }
+
+  void PushOther(const char *what) {
+    if (CheckOpen(what))
+      Push({});
+  }
+
+  static uint32_t GetID(RHIResource *resource) {
+    return resource ? static_cast<NullRHIResource *>(resource)->ID : 0;
+  }
+
+  NullRHIDevice *m_Device;
+  RHIQueueType m_Type;
+  NullRHIStats m_Recorded;
+  bool m_Open = false;
+  std::vector<RHICPUDescriptor> m_Descriptors;
+};
+
+class NullRHICommandQueue : public RHICommandQueue {
+public:
+  NullRHICommandQueue(NullRHIDevice *device, RHIQueueType type)
+      : m_Device(device), m_Type(type) {}
+
+  RHIQueueType GetType() const override { return m_Type; }
+
+  void Execute(RHICommandList *const *lists, uint32_t count) override {
+    NullRHIStats &stats = m_Device->GetStats();
+    stats.ExecuteCalls++;
+
+    uint64_t serial = m_Device->Submit();
+    for (uint32_t i = 0; i < count; i++) {
+      auto *list = static_cast<NullRHICommandList *>(lists[i]);
+      if (list->IsOpen()) {
+        m_Device->ReportError("Executing a command list that was not closed");
+      }
+      if (list->GetType() != m_Type && m_Type != RHIQueueType::Direct) {
+        m_Device->ReportError("Command list type does not match queue");
+      }
+      Replay(*list, serial);
+      list->LastSubmitSerial = serial;
+      stats.CommandListsExecuted++;
+    }
+    m_Device->RetireUntil(0); // apply latency policy
+  }
+
+  void Signal(RHIFence *fence, uint64_t value) override {
+    m_Device->AddSignal(static_cast<NullRHIFence *>(fence), value);
+  }
+
+  uint64_t GetTimestampFrequency() const override {
+    return m_Type == RHIQueueType::Copy ? 0 : TimestampFrequency;
+  }
+
+  uint64_t GetCurrentTimestamp() override {
+    return NullRHIDevice::GetTimestampNow();
+  }
+
+  void Wait(RHIFence *fence, uint64_t value) override {
+    // GPU-side wait: the fake GPU executes in submission order, so the
+    // only thing to check is that the value was ever requested.
+    auto *nullFence = static_cast<NullRHIFence *>(fence);
+    if (nullFence->Value < value && !m_Device->RetireUntilFence(nullFence,
+                                                               value)) {
+      m_Device->ReportError("Queue waits on fence value " +
+                            std::to_string(value) +
+                            " that is never signaled (GPU deadlock)");
+    }
+  }
+
+private:
+  // D3D12 copy queues only copy, and only transition between the states
+  // copies use
+  static bool IsCopyQueueCommand(const NullCommand &cmd) {
+    const RHIResourceState copyStates = RHIResourceState::CopyDest |
+                                        RHIResourceState::CopySource;
+    switch (cmd.CommandType) {
+    case NullCommand::Type::CopyBuffer:
+    case NullCommand::Type::CopyTexture:
+      return true;
+    case NullCommand::Type::Barrier:
+      return ((uint32_t)cmd.Before & ~(uint32_t)copyStates) == 0 &&
+             ((uint32_t)cmd.After & ~(uint32_t)copyStates) == 0;
+    default:
+      return false;
+    }
+  }
+
+  NullRHIResource *Use(uint32_t id, uint64_t serial, const char *what) {
+    if (id == 0)
+      return nullptr;
+    NullRHIResource *resource = m_Device->FindResource(id);
+    if (!resource) {
+      m_Device->ReportError(std::string(what) +
+                            " references a destroyed resource");
+      return nullptr;
+    }
+    resource->LastUseSerial = serial;
+    if (resource->WriteQueue && resource->WriteQueue != this &&
+        resource->WriteSerial > m_Device->GetCompletedSerial()) {
+      m_Device->ReportError(std::string(what) + ": '" +
+                            resource->GetDesc().DebugName +
+                            "' is still being written by another queue "
+                            "(missing fence wait)");
+    }
+    if (resource->Heap && !resource->Active) {
+      m_Device->ReportError(std::string(what) + ": placed resource '" +
+                            resource->GetDesc().DebugName +
+                            "' used without an aliasing barrier after "
+                            "another resource took its memory");
+    }
+    return resource;
+  }
+
+  void ExpectState(NullRHIResource *resource, RHIResourceState required,
+                   const char *what) {
+    if (!resource)
+      return;
+    // Upload heaps live in GenericRead for their whole lifetime
+    if (resource->GetDesc().Heap == RHIHeapType::Upload)
+      return;
+    if (!HasAnyState(resource->State, required)) {
+      m_Device->ReportError(std::string(what) + ": resource '" +
+                            resource->GetDesc().DebugName + "' is in " +
+                            GetStateName(resource->State) + ", expected " +
+                            GetStateName(required));
+    }
+  }
+
+  NullRHIResource *UseDescriptor(uint64_t ptr, uint64_t serial,
+                                 const char *what) {
+    uint32_t id = m_Device->ResolveDescriptor({ptr});
+    if (id == 0) {
+      m_Device->ReportError(std::string(what) + " uses an empty descriptor");
+      return nullptr;
+    }
+    return Use(id, serial, what);
+  }
+
+  NullRHIQueryHeap *UseQueryHeap(uint32_t id, const char *what) {
+    NullRHIQueryHeap *heap = m_Device->FindQueryHeap(id);
+    if (!heap) {
+      m_Device->ReportError(std::string(what) +
+                            " references a destroyed query heap");
+    }
+    return heap;
+  }
+
+  void Replay(NullRHICommandList &list, uint64_t serial) {
+    bool pipelineBound = false;
+    bool renderTargetBound = false;
+
+    m_Device->BeginGPUWork();
+    for (const NullCommand &cmd : list.Commands) {
+      const uint64_t gpuClock = m_Device->AdvanceGPUClock();
+      if (m_Type == RHIQueueType::Copy && !IsCopyQueueCommand(cmd)) {
+        m_Device->ReportError("Copy queue executes a non-copy command");
+        continue;
+      }
+      switch (cmd.CommandType) {
+      case NullCommand::Type::Barrier: {
+        NullRHIResource *resource = Use(cmd.ResourceA, serial, "Barrier");
+        if (!resource)
+          break;
+        if (resource->GetDesc().Heap != RHIHeapType::Default) {
+          m_Device->ReportError("Barrier on upload/readback resource '" +
+                                resource->GetDesc().DebugName + "'");
+        }
+        if (cmd.Before == cmd.After) {
+          m_Device->ReportError("Redundant barrier on '" +
+                                resource->GetDesc().DebugName + "' (" +
+                                GetStateName(cmd.Before) + ")");
+        }
+        if (resource->State != cmd.Before) {
+          m_Device->ReportError(
+              "Barrier on '" + resource->GetDesc().DebugName +
+              "' expects " + GetStateName(cmd.Before) + " but resource is " +
+              GetStateName(resource->State));
+        }
+        resource->State = cmd.After;
+        break;
+      }
+      case NullCommand::Type::AliasingBarrier: {
+        NullRHIResource *after = m_Device->FindResource(cmd.ResourceA);
+        NullRHIResource *before = m_Device->FindResource(cmd.ResourceB);
+        if (!after || (cmd.ResourceB && !before)) {
+          m_Device->ReportError("Aliasing barrier references a destroyed "
+                                "resource");
+          break;
+        }
+        after->LastUseSerial = serial;
+        if (!after->Heap) {
+          m_Device->ReportError("Aliasing barrier on non-placed resource '" +
+                                after->GetDesc().DebugName + "'");
+          break;
+        }
+        if (before && (before->Heap != after->Heap ||
+                       !before->Overlaps(*after))) {
+          m_Device->ReportError("Aliasing barrier between '" +
+                                before->GetDesc().DebugName + "' and '" +
+                                after->GetDesc().DebugName +
+                                "' that do not share memory");
+        }
+        after->Heap->Activate(after);
+        break;
+      }
+      case NullCommand::Type::SetRenderTargets: {
+        const RHICPUDescriptor *rtvs =
+            list.GetDescriptors() + cmd.DescriptorOffset;
+        for (uint32_t i = 0; i < cmd.DescriptorCount; i++) {
+          ExpectState(UseDescriptor(rtvs[i].Ptr, serial, "SetRenderTargets"),
+                      RHIResourceState::RenderTarget, "SetRenderTargets");
+        }
+        if (cmd.Extra) {
+          ExpectState(UseDescriptor(cmd.Extra, serial, "SetRenderTargets"),
+                      RHIResourceState::DepthWrite |
+                          RHIResourceState::DepthRead,
+                      "SetRenderTargets (depth)");
+        }
+        renderTargetBound = cmd.DescriptorCount > 0 || cmd.Extra != 0;
+        break;
+      }
+      case NullCommand::Type::ClearRenderTarget:
+        ExpectState(UseDescriptor(cmd.Extra, serial, "ClearRenderTarget"),
+                    RHIResourceState::RenderTarget, "ClearRenderTarget");
+        break;
+      case NullCommand::Type::ClearDepthStencil:
+        ExpectState(UseDescriptor(cmd.Extra, serial, "ClearDepthStencil"),
+                    RHIResourceState::DepthWrite, "ClearDepthStencil");
+        break;
+      case NullCommand::Type::SetPipeline:
+        pipelineBound = cmd.Extra != 0;
+        break;
+      case NullCommand::Type::SetVertexBuffer:
+        ExpectState(Use(cmd.ResourceA, serial, "SetVertexBuffer"),
+                    RHIResourceState::VertexAndConstantBuffer,
+                    "SetVertexBuffer");
+        break;
+      case NullCommand::Type::SetDescriptorTable:
+        // The table's first view is checked (tables are not sized here);
+        // empty slots are not an error
+        if (m_Device->ResolveDescriptor({cmd.Extra}) != 0) {
+          ExpectState(UseDescriptor(cmd.Extra, serial,
+                                    "SetGraphicsDescriptorTable"),
+                      RHIResourceState::NonPixelShaderResource |
+                          RHIResourceState::PixelShaderResource,
+                      "SetGraphicsDescriptorTable");
+        }
+        break;
+      case NullCommand::Type::Draw:
+        if (!pipelineBound)
+          m_Device->ReportError("Draw without a pipeline state");
+        if (!renderTargetBound)
+          m_Device->ReportError("Draw without render targets");
+        break;
+      case NullCommand::Type::CopyBuffer:
+      case NullCommand::Type::CopyTexture: {
+        const char *what = cmd.CommandType == NullCommand::Type::CopyBuffer
+                               ? "CopyBufferRegion"
+                               : "CopyBufferToTexture";
+        NullRHIResource *dst = Use(cmd.ResourceA, serial, what);
+        ExpectState(dst, RHIResourceState::CopyDest, what);
+        ExpectState(Use(cmd.ResourceB, serial, what),
+                    RHIResourceState::CopySource, what);
+        if (dst) {
+          dst->WriteQueue = this;
+          dst->WriteSerial = serial;
+        }
+        break;
+      }
+      case NullCommand::Type::WriteTimestamp:
+        if (NullRHIQueryHeap *heap =
+                UseQueryHeap(cmd.QueryHeap, "WriteTimestamp")) {
+          heap->Values[cmd.FirstQuery] = gpuClock;
+          heap->Written[cmd.FirstQuery] = true;
+          m_Device->GetStats().TimestampsWritten++;
+        }
+        break;
+      case NullCommand::Type::ResolveQueries: {
+        NullRHIResource *dst = Use(cmd.ResourceA, serial, "ResolveQueries");
+        NullRHIQueryHeap *heap = UseQueryHeap(cmd.QueryHeap, "ResolveQueries");
+        if (!dst || !heap)
+          break;
+        ExpectState(dst, RHIResourceState::CopyDest, "ResolveQueries");
+        std::vector<uint64_t> values(
+            heap->Values.begin() + cmd.FirstQuery,
+            heap->Values.begin() + cmd.FirstQuery + cmd.QueryCount);
+        for (uint32_t i = cmd.FirstQuery; i < cmd.FirstQuery + cmd.QueryCount;
+             i++) {
+          if (!heap->Written[i]) {
+            m_Device->ReportError("ResolveQueries: query " +
+                                  std::to_string(i) + " of '" +
+                                  heap->GetDesc().DebugName +
+                                  "' was never written");
+            break;
+          }
+        }
+        m_Device->AddDeferredWrite(cmd.ResourceA, cmd.Extra,
+                                   std::move(values));
+        m_Device->GetStats().QueriesResolved += cmd.QueryCount;
+        dst->WriteQueue = this;
+        dst->WriteSerial = serial;
+        break;
+      }
+      case NullCommand::Type::Other:
+        Use(cmd.ResourceA, serial, "Command");
+        break;
+      }
+    }
+  }
+
+  NullRHIDevice *m_Device;
+  RHIQueueType m_Type;
+};
+
+// --- Device ---
+
+NullRHIDevice::NullRHIDevice(const NullRHIConfig &config) : m_Config(config) {}
+
+NullRHIDevice::~NullRHIDevice() {
+  for (const auto &[id, resource] : m_Resources) {
+    ReportError("Resource '" + resource->GetDesc().DebugName +
+                "' leaked (device destroyed first)");
+  }
+}
+
+std::unique_ptr<RHICommandQueue>
+NullRHIDevice::CreateCommandQueue(RHIQueueType type) {
+  return std::make_unique<NullRHICommandQueue>(this, type);
+}
+
+std::unique_ptr<RHICommandList>
+NullRHIDevice::CreateCommandList(RHIQueueType type) {
+  return std::make_unique<NullRHICommandList>(this, type);
+}
+
+std::unique_ptr<RHIFence> NullRHIDevice::CreateFence(uint64_t initialValue) {
+  return std::make_unique<NullRHIFence>(this, initialValue);
+}
+
+std::unique_ptr<RHIResource>
+NullRHIDevice::CreateResource(const RHIResourceDesc &desc) {
+  if (desc.Heap == RHIHeapType::Upload &&
+      desc.InitialState != RHIResourceState::GenericRead) {
+    ReportError("Upload heap resource '" + desc.DebugName +
+                "' must start in GenericRead");
+  }
+  if (desc.Width == 0)
+    ReportError("Zero-sized resource '" + desc.DebugName + "'");
+
+  m_Stats.ResourcesCreated++;
+  return std::make_unique<NullRHIResource>(this, desc);
+}
+
+std::unique_ptr<RHIDescriptorHeap>
+NullRHIDevice::CreateDescriptorHeap(const RHIDescriptorHeapDesc &desc) {
+  if (desc.ShaderVisible && (desc.Type == RHIDescriptorHeapType::RTV ||
+                             desc.Type == RHIDescriptorHeapType::DSV)) {
+    ReportError("RTV/DSV heaps cannot be shader visible");
+  }
+  return std::make_unique<NullRHIDescriptorHeap>(this, desc);
+}
+
+std::unique_ptr<RHIHeap> NullRHIDevice::CreateHeap(const RHIHeapDesc &desc) {
+  if (desc.Size == 0 || desc.Size % PlacementAlignment != 0) {
+    ReportError("Heap '" + desc.DebugName + "' size " +
+                std::to_string(desc.Size) + " is not a multiple of 64 KB");
+  }
+  return std::make_unique<NullRHIHeap>(this, desc);
+}
+
+std::unique_ptr<RHIQueryHeap>
+NullRHIDevice::CreateQueryHeap(const RHIQueryHeapDesc &desc) {
+  if (desc.Count == 0)
+    ReportError("Query heap '" + desc.DebugName + "' has no queries");
+  return std::make_unique<NullRHIQueryHeap>(this, desc);
+}
+
+std::unique_ptr<RHIResource>
+NullRHIDevice::CreatePlacedResource(RHIHeap *heap, uint64_t offset,
+                                    const RHIResourceDesc &desc) {
+  auto *nullHeap = static_cast<NullRHIHeap *>(heap);
+  const RHIHeapDesc &heapDesc = heap->GetDesc();
+  RHIAllocationInfo info = GetAllocationInfo(desc);
+  if (offset % info.Alignment != 0 || offset + info.Size > heapDesc.Size) {
+    ReportError("Placed resource '" + desc.DebugName +
+                "' is misaligned or exceeds heap '" + heapDesc.DebugName +
+                "'");
+    return nullptr;
+  }
+  if (desc.Heap != heapDesc.Type)
+    ReportError("Placed resource '" + desc.DebugName +
+                "' heap type does not match its heap");
+
+  bool renderTarget =
+      (desc.Flags & (RHIResourceFlag_RenderTarget |
+                     RHIResourceFlag_DepthStencil)) != 0;
+  bool buffer = desc.Dimension == RHIResourceDimension::Buffer;
+  bool allowed = false;
+  switch (heapDesc.Usage) {
+  case RHIHeapUsage::Buffers:
+    allowed = buffer;
+    break;
+  case RHIHeapUsage::Textures:
+    allowed = !buffer && !renderTarget;
+    break;
+  case RHIHeapUsage::RenderTargets:
+    allowed = !buffer && renderTarget;
+    break;
+  }
+  if (!allowed)
+    ReportError("Placed resource '" + desc.DebugName +
+                "' does not match the usage of heap '" + heapDesc.DebugName +
+                "'");
+
+  m_Stats.ResourcesCreated++;
+  auto resource = std::make_unique<NullRHIResource>(this, desc);
+  resource->Heap = nullHeap;
+  resource->HeapOffset = offset;
+  resource->HeapSize = info.Size;
+  // A fresh resource over memory another one owns starts aliased out
+  for (NullRHIResource *other : nullHeap->Placed) {
+    if (other->Active && other->Overlaps(*resource))
+      resource->Active = false;
+  }
+  nullHeap->Placed.push_back(resource.get());
+  return resource;
+}
+
+RHIAllocationInfo
+NullRHIDevice::GetAllocationInfo(const RHIResourceDesc &desc) const {
+  uint64_t size = desc.Width;
+  if (desc.Dimension == RHIResourceDimension::Texture2D) {
+    size = 0;
+    for (uint16_t mip = 0; mip < std::max<uint16_t>(desc.MipLevels, 1); mip++) {
+      uint32_t width = GetMipSize((uint32_t)desc.Width, mip);
+      // Unknown formats count one byte per pixel
+      uint64_t rowBytes = GetFormatSize(desc.Format)
+                              ? GetRowBytes(desc.Format, width)
+                              : width;
+      size += rowBytes * GetRowCount(desc.Format, GetMipSize(desc.Height, mip));
+    }
+  }
+  size = (size + PlacementAlignment - 1) / PlacementAlignment *
+         PlacementAlignment;
+  return {std::max(size, PlacementAlignment), PlacementAlignment};
+}
+
+std::unique_ptr<RHIPipelineState>
+NullRHIDevice::CreateGraphicsPipeline(const RHIGraphicsPipelineDesc &desc) {
+  if (desc.DepthEnable && desc.DSVFormat == RHIFormat::Unknown)
+    ReportError("Pipeline '" + desc.DebugName + "' enables depth without "
+                                                "a DSV format");
+  m_Stats.PipelinesCreated++;
+  return std::make_unique<NullRHIPipelineState>(desc);
+}
+
+std::unique_ptr<RHIPipelineLibrary>
+NullRHIDevice::CreatePipelineLibrary(const void *data, size_t size) {
+  auto library = std::make_unique<NullRHIPipelineLibrary>(this);
+  if (size > 0 && !library->Deserialize((const uint8_t *)data, size))
+    return nullptr; // stale / corrupt blob: caller starts a new library
+  return library;
+}
+
+void NullRHIDevice::WriteDescriptor(uint32_t resourceID,
+                                    RHICPUDescriptor dest,
+                                    RHIDescriptorHeapType expectedType,
+                                    const char *what) {
+  uint32_t heapID = (uint32_t)(dest.Ptr >> 32);
+  uint32_t index = (uint32_t)(dest.Ptr & 0xffffffff) / DescriptorIncrement;
+
+  auto it = m_Heaps.find(heapID);
+  if (it == m_Heaps.end()) {
+    ReportError(std::string(what) + " into an unknown descriptor heap");
+    return;
+  }
+  NullRHIDescriptorHeap *heap = it->second;
+  if (heap->GetDesc().Type != expectedType)
+    ReportError(std::string(what) + " into a heap of the wrong type");
+  if (index >= heap->Slots.size()) {
+    ReportError(std::string(what) + " out of heap bounds");
+    return;
+  }
+  heap->Slots[index] = resourceID;
+}
+
+static uint32_t GetResourceID(RHIResource *resource) {
+  return resource ? static_cast<NullRHIResource *>(resource)->ID : 0;
+}
+
+void NullRHIDevice::CreateRenderTargetView(RHIResource *resource,
+                                           RHICPUDescriptor dest) {
+  if (resource &&
+      !(resource->GetDesc().Flags & RHIResourceFlag_RenderTarget)) {
+    ReportError("RTV for resource '" + resource->GetDesc().DebugName +
+                "' without RenderTarget flag");
+  }
+  WriteDescriptor(GetResourceID(resource), dest, RHIDescriptorHeapType::RTV,
+                  "CreateRenderTargetView");
+}
+
+void NullRHIDevice::CreateDepthStencilView(RHIResource *resource,
+                                           RHICPUDescriptor dest) {
+  if (resource &&
+      !(resource->GetDesc().Flags & RHIResourceFlag_DepthStencil)) {
+    ReportError("DSV for resource '" + resource->GetDesc().DebugName +
+                "' without DepthStencil flag");
+  }
+  WriteDescriptor(GetResourceID(resource), dest, RHIDescriptorHeapType::DSV,
+                  "CreateDepthStencilView");
+}
+
+void NullRHIDevice::CreateShaderResourceView(RHIResource *resource,
+                                             RHICPUDescriptor dest) {
+  WriteDescriptor(GetResourceID(resource), dest,
+                  RHIDescriptorHeapType::CBV_SRV_UAV,
+                  "CreateShaderResourceView");
+}
+
+void NullRHIDevice::CopyDescriptors(RHICPUDescriptor dest,
+                                    const RHICPUDescriptor *sources,
+                                    uint32_t count,
+                                    RHIDescriptorHeapType type) {
+  auto sourceHeap = [this](RHICPUDescriptor descriptor) {
+    auto it = m_Heaps.find((uint32_t)(descriptor.Ptr >> 32));
+    return it != m_Heaps.end() ? it->second : nullptr;
+  };
+
+  for (uint32_t i = 0; i < count; i++) {
+    NullRHIDescriptorHeap *heap = sourceHeap(sources[i]);
+    if (!heap) {
+      ReportError("CopyDescriptors from an unknown descriptor heap");
+      continue;
+    }
+    // D3D12 rule: copy sources must live in CPU-only heaps
+    if (heap->GetDesc().ShaderVisible)
+      ReportError("CopyDescriptors source is a shader-visible heap");
+    WriteDescriptor(ResolveDescriptor(sources[i]),
+                    {dest.Ptr + (uint64_t)i * DescriptorIncrement}, type,
+                    "CopyDescriptors");
+  }
+}
+
+void NullRHIDevice::WaitIdle() {
+  while (!m_Pending.empty()) {
+    RetireUntil(m_Pending.front().Serial);
+  }
+}
+
+void NullRHIDevice::ReportError(const std::string &message) {
+  std::lock_guard<std::mutex> lock(m_ErrorMutex);
+  if (m_Config.LogErrors)
+    std::cerr << "[NullRHI] " << message << std::endl;
+  m_Errors.push_back(message);
+}
+
+uint64_t NullRHIDevice::Submit() {
+  m_Pending.push_back({++m_LastSerial, {}, {}});
+  return m_LastSerial;
+}
+
+void NullRHIDevice::AddSignal(NullRHIFence *fence, uint64_t value) {
+  if (m_Pending.empty()) {
+    // Queue is idle: the signal executes right away
+    fence->Value = std::max(fence->Value, value);
+    return;
+  }
+  m_Pending.back().Signals.push_back({fence, value});
+}
+
+void NullRHIDevice::RetireUntil(uint64_t serial) {
+  // serial == 0: only enforce the configured latency
+  while (!m_Pending.empty() &&
+         (m_Pending.front().Serial <= serial ||
+          m_Pending.size() > m_Config.GPULatency)) {
+    Submission &submission = m_Pending.front();
+    for (const DeferredWrite &write : submission.Writes) {
+      // Readback memory is CPU-side; the buffer may be gone by now
+      if (NullRHIResource *resource = FindResource(write.ResourceID)) {
+        memcpy((uint8_t *)resource->Map() + write.Offset, write.Values.data(),
+               write.Values.size() * sizeof(uint64_t));
+      }
+    }
+    for (const FenceSignal &signal : submission.Signals) {
+      signal.Fence->Value = std::max(signal.Fence->Value, signal.Value);
+    }
+    m_CompletedSerial = submission.Serial;
+    m_Pending.pop_front();
+  }
+}
+
+bool NullRHIDevice::RetireUntilFence(const NullRHIFence *fence,
+                                     uint64_t value) {
+  while (fence->Value < value) {
+    if (m_Pending.empty())
+      return false;
+    RetireUntil(m_Pending.front().Serial);
+  }
+  return true;
+}
+
+uint32_t NullRHIDevice::RegisterResource(NullRHIResource *resource) {
+  uint32_t id = m_NextResourceID++;
+  m_Resources[id] = resource;
+  return id;
+}
+
+void NullRHIDevice::UnregisterResource(uint32_t id) {
+  m_Resources.erase(id);
+  m_Stats.ResourcesDestroyed++;
+}
+
+NullRHIResource *NullRHIDevice::FindResource(uint32_t id) const {
+  auto it = m_Resources.find(id);
+  return it != m_Resources.end() ? it->second : nullptr;
+}
+
+uint32_t NullRHIDevice::RegisterHeap(NullRHIDescriptorHeap *heap) {
+  uint32_t id = m_NextHeapID++;
+  m_Heaps[id] = heap;
+  return id;
+}
+
+void NullRHIDevice::UnregisterHeap(uint32_t id) { m_Heaps.erase(id); }
+
+uint32_t NullRHIDevice::ResolveDescriptor(RHICPUDescriptor descriptor) const {
+  auto it = m_Heaps.find((uint32_t)(descriptor.Ptr >> 32));
+  if (it == m_Heaps.end())
+    return 0;
+  uint32_t index =
+      (uint32_t)(descriptor.Ptr & 0xffffffff) / DescriptorIncrement;
+  const std::vector<uint32_t> &slots = it->second->Slots;
+  return index < slots.size() ? slots[index] : 0;
+}
+
+void NullRHIDevice::UnregisterFence(NullRHIFence *fence) {
+  for (Submission &submission : m_Pending) {
+    auto &signals = submission.Signals;
+    signals.erase(std::remove_if(signals.begin(), signals.end(),
+                                 [fence](const FenceSignal &signal) {
+                                   return signal.Fence == fence;
+                                 }),
+                  signals.end());
+  }
+}
+
+uint32_t NullRHIDevice::RegisterQueryHeap(NullRHIQueryHeap *heap) {
+  uint32_t id = m_NextQueryHeapID++;
+  m_QueryHeaps[id] = heap;
+  return id;
+}
+
+void NullRHIDevice::UnregisterQueryHeap(uint32_t id) {
+  m_QueryHeaps.erase(id);
+}
+
+NullRHIQueryHeap *NullRHIDevice::FindQueryHeap(uint32_t id) const {
+  auto it = m_QueryHeaps.find(id);
+  return it != m_QueryHeaps.end() ? it->second : nullptr;
+}
+
+uint64_t NullRHIDevice::GetTimestampNow() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void NullRHIDevice::BeginGPUWork() {
+  m_GPUClock = std::max(m_GPUClock, GetTimestampNow());
+}
+
+void NullRHIDevice::AddDeferredWrite(uint32_t resourceID, uint64_t offset,
+                                     std::vector<uint64_t> values) {
+  if (m_Pending.empty())
+    return;
+  m_Pending.back().Writes.push_back({resourceID, offset, std::move(values)});
+}
+
+} // namespace Forge
@@ -0,0 +1,171 @@
+#pragma once
+#include "../RHI.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Forge {
+
+struct NullRHIConfig {
+  // Submissions the fake GPU keeps in flight before retiring the oldest
+  // (0 = everything completes on submission). Raising it exercises the
+  // fence / deferred-release paths the way a real GPU would.
+  uint32_t GPULatency = 0;
+  // Fake GPU clock for timestamp queries, in steady clock nanoseconds: a
+  // submission starts once the previous one is done but not before it was
+  // submitted, and each of its commands takes this long
+  uint64_t TicksPerCommand = 1000;
+  bool LogErrors = true;
+};
+
+struct NullRHIStats {
+  uint64_t CommandsRecorded = 0;
+  uint64_t Barriers = 0;
+  uint64_t BarrierBatches = 0; // ResourceBarriers calls
+  uint64_t Draws = 0;
+  uint64_t PipelineChanges = 0;
+  uint64_t PipelinesCreated = 0; // compiled from scratch
+  uint64_t PipelinesLoaded = 0;  // served by a pipeline library
+  uint64_t ExecuteCalls = 0;
+  uint64_t CommandListsExecuted = 0;
+  uint64_t ResourcesCreated = 0;
+  uint64_t ResourcesDestroyed = 0;
+  uint64_t TimestampsWritten = 0;
+  uint64_t QueriesResolved = 0;
+};
+
+class NullRHIResource;
+class NullRHIDescriptorHeap;
+class NullRHIQueryHeap;
+
+// Headless backend: records commands, replays them at Execute against
+// tracked resource states and reports validation errors (barrier state
+// mismatches, use-after-destroy, placed resources used without an aliasing
+// barrier, destroy / allocator reset while the fake
+// GPU still owns the work). Nothing is rendered. Timestamps come from a fake
+// GPU clock; resolved queries reach their readback buffer only when the
+// submission retires, as on hardware. Different command lists
+// may be recorded on different threads; everything else is single-threaded.
+class NullRHIDevice : public RHIDevice {
+public:
+  explicit NullRHIDevice(const NullRHIConfig &config = {});
+  ~NullRHIDevice() override;
+
+  RHIBackend GetBackend() const override { return RHIBackend::Null; }
+
+  std::unique_ptr<RHICommandQueue> CreateCommandQueue(RHIQueueType type) override;
+  std::unique_ptr<RHICommandList> CreateCommandList(RHIQueueType type) override;
+  std::unique_ptr<RHIFence> CreateFence(uint64_t initialValue) override;
+  std::unique_ptr<RHIResource>
+  CreateResource(const RHIResourceDesc &desc) override;
+  std::unique_ptr<RHIDescriptorHeap>
+  CreateDescriptorHeap(const RHIDescriptorHeapDesc &desc) override;
+  std::unique_ptr<RHIHeap> CreateHeap(const RHIHeapDesc &desc) override;
+  std::unique_ptr<RHIQueryHeap>
+  CreateQueryHeap(const RHIQueryHeapDesc &desc) override;
+  std::unique_ptr<RHIResource>
+  CreatePlacedResource(RHIHeap *heap, uint64_t offset,
+                       const RHIResourceDesc &desc) override;
+  RHIAllocationInfo
+  GetAllocationInfo(const RHIResourceDesc &desc) const override;
+  std::unique_ptr<RHIPipelineState>
+  CreateGraphicsPipeline(const RHIGraphicsPipelineDesc &desc) override;
+  std::unique_ptr<RHIPipelineLibrary>
+  CreatePipelineLibrary(const void *data, size_t size) override;
+
+  void CreateRenderTargetView(RHIResource *resource,
+                              RHICPUDescriptor dest) override;
+  void CreateDepthStencilView(RHIResource *resource,
+                              RHICPUDescriptor dest) override;
+  void CreateShaderResourceView(RHIResource *resource,
+                                RHICPUDescriptor dest) override;
+  void CopyDescriptors(RHICPUDescriptor dest, const RHICPUDescriptor *sources,
+                       uint32_t count, RHIDescriptorHeapType type) override;
+
+  // Retire every pending submission (fake GPU goes idle)
+  void WaitIdle();
+
+  const std::vector<std::string> &GetValidationErrors() const {
+    return m_Errors;
+  }
+  void ClearValidationErrors() { m_Errors.clear(); }
+
+  const NullRHIStats &GetStats() const { return m_Stats; }
+  NullRHIStats &GetStats() { return m_Stats; }
+  void ResetStats() { m_Stats = {}; }
+
+  // --- Backend internals (used by the Null* objects) ---
+
+  struct FenceSignal {
+    class NullRHIFence *Fence;
+    uint64_t Value;
+  };
+
+  void ReportError(const std::string &message);
+
+  uint64_t Submit(); // returns the new submission serial
+  void AddSignal(class NullRHIFence *fence, uint64_t value);
+  void RetireUntil(uint64_t serial);
+  bool RetireUntilFence(const class NullRHIFence *fence, uint64_t value);
+  uint64_t GetCompletedSerial() const { return m_CompletedSerial; }
+  uint64_t GetLastSerial() const { return m_LastSerial; }
+
+  uint32_t RegisterResource(NullRHIResource *resource);
+  void UnregisterResource(uint32_t id);
+  NullRHIResource *FindResource(uint32_t id) const;
+
+  uint32_t RegisterHeap(NullRHIDescriptorHeap *heap);
+  void UnregisterHeap(uint32_t id);
+  // Resource id bound to a CPU descriptor (0 = empty / invalid)
+  uint32_t ResolveDescriptor(RHICPUDescriptor descriptor) const;
+
+  void UnregisterFence(class NullRHIFence *fence);
+
+  uint32_t RegisterQueryHeap(NullRHIQueryHeap *heap);
+  void UnregisterQueryHeap(uint32_t id);
+  NullRHIQueryHeap *FindQueryHeap(uint32_t id) const;
+  // Fake GPU clock (NullRHIConfig::TicksPerCommand)
+  static uint64_t GetTimestampNow();
+  void BeginGPUWork();
+  uint64_t AdvanceGPUClock() { return m_GPUClock += m_Config.TicksPerCommand; }
+  // Written into the resource when the current submission retires
+  void AddDeferredWrite(uint32_t resourceID, uint64_t offset,
+                        std::vector<uint64_t> values);
+
+private:
+  void WriteDescriptor(uint32_t resourceID, RHICPUDescriptor dest,
+                       RHIDescriptorHeapType expectedType, const char *what);
+
+  NullRHIConfig m_Config;
+  NullRHIStats m_Stats;
+  std::vector<std::string> m_Errors;
+  std::mutex m_ErrorMutex; // command lists may record on worker threads
+
+  uint32_t m_NextResourceID = 1;
+  std::unordered_map<uint32_t, NullRHIResource *> m_Resources;
+  uint32_t m_NextHeapID = 1;
+  std::unordered_map<uint32_t, NullRHIDescriptorHeap *> m_Heaps;
+  uint32_t m_NextQueryHeapID = 1;
+  std::unordered_map<uint32_t, NullRHIQueryHeap *> m_QueryHeaps;
+  uint64_t m_GPUClock = 0;
+
+  struct DeferredWrite {
+    uint32_t ResourceID;
+    uint64_t Offset;
+    std::vector<uint64_t> Values;
+  };
+  struct Submission {
+    uint64_t Serial;
+    std::vector<FenceSignal> Signals;
+    std::vector<DeferredWrite> Writes;
+  };
+  std::deque<Submission> m_Pending;
+  uint64_t m_LastSerial = 0;
+  uint64_t m_CompletedSerial = 0;
+};
+
+} // namespace Forge
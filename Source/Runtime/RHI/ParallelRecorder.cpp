@@ -0,0 +1,57 @@
+#include "ParallelRecorder.h"
+#include "../Core/JobSystem.h"
+#include <algorithm>
+
+namespace Forge {
+
+void ParallelCommandRecorder::Initialize(FrameContextRing *frameRing,
+                                         JobSystem *jobs,
+                                         uint32_t minItemsPerList,
+                                         uint32_t maxLists) {
+  m_FrameRing = frameRing;
+  m_Jobs = jobs;
+  m_MinItemsPerList = std::max(minItemsPerList, 1u);
+  m_MaxLists = std::max(maxLists, 1u);
+}
+
+RHICommandList *
+ParallelCommandRecorder::Record(uint32_t itemCount, const SetupFunction &setup,
+                                const RecordFunction &record) {
+  m_Stats.Passes++;
+  RHICommandList *mainList = m_FrameRing->GetCommandList();
+
+  uint32_t listCount = (itemCount + m_MinItemsPerList - 1) / m_MinItemsPerList;
+  listCount = std::min({listCount, m_MaxLists, m_Jobs->GetThreadCount()});
+  if (listCount <= 1) {
+    // Not worth a fork: one list, no extra ExecuteCommandLists entries
+    m_Stats.LastListCount = 0;
+    if (itemCount > 0) {
+      setup(mainList);
+      record(mainList, 0, itemCount);
+    }
+    return mainList;
+  }
+
+  const std::vector<RHICommandList *> &lists =
+      m_FrameRing->ForkCommandLists(listCount);
+
+  // Contiguous slices keep the sorted item order across lists
+  m_Jobs->ParallelFor(listCount, 1,
+                      [&](uint32_t begin, uint32_t end, uint32_t) {
+                        for (uint32_t i = begin; i < end; i++) {
+                          uint32_t first =
+                              (uint32_t)((uint64_t)itemCount * i / listCount);
+                          uint32_t last = (uint32_t)((uint64_t)itemCount *
+                                                     (i + 1) / listCount);
+                          setup(lists[i]);
+                          record(lists[i], first, last);
+                        }
+                      });
+
+  m_Stats.ParallelPasses++;
+  m_Stats.ListsRecorded += listCount;
+  m_Stats.LastListCount = listCount;
+  return m_FrameRing->GetCommandList();
+}
+
+} // namespace Forge
@@ -0,0 +1,48 @@
+#pragma once
+#include "FrameContext.h"
+#include <cstdint>
+#include <functional>
+
+namespace Forge {
+
+class JobSystem;
+
+struct ParallelRecordStats {
+  uint64_t Passes = 0;
+  uint64_t ParallelPasses = 0; // passes that forked lists
+  uint64_t ListsRecorded = 0;  // forked lists
+  uint32_t LastListCount = 0;  // 0 = last pass recorded inline
+};
+
+// Splits a pass of `itemCount` items (draw batches, ...) over several
+// command lists forked from the FrameContextRing and records them on the
+// JobSystem (the calling thread takes part). Submission order is the item
+// order. Small passes are recorded inline on the main list.
+class ParallelCommandRecorder {
+public:
+  // Sets the pass state on a fresh list (render targets, viewport,
+  // pipeline, root arguments): lists share no bound state
+  using SetupFunction = std::function<void(RHICommandList *commandList)>;
+  // Records items [begin, end)
+  using RecordFunction = std::function<void(RHICommandList *commandList,
+                                            uint32_t begin, uint32_t end)>;
+
+  void Initialize(FrameContextRing *frameRing, JobSystem *jobs,
+                  uint32_t minItemsPerList = 256, uint32_t maxLists = 8);
+
+  // Returns the list the main thread continues on (may differ from the one
+  // current before the call)
+  RHICommandList *Record(uint32_t itemCount, const SetupFunction &setup,
+                         const RecordFunction &record);
+
+  const ParallelRecordStats &GetStats() const { return m_Stats; }
+
+private:
+  FrameContextRing *m_FrameRing = nullptr;
+  JobSystem *m_Jobs = nullptr;
+  uint32_t m_MinItemsPerList = 256;
+  uint32_t m_MaxLists = 8;
+  ParallelRecordStats m_Stats;
+};
+
+} // namespace Forge
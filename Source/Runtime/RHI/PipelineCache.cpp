@@ -0,0 +1,123 @@
+#include "PipelineCache.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace Forge {
+
+PipelineCache::~PipelineCache() { Shutdown(); }
+
+bool PipelineCache::Initialize(RHIDevice *device,
+                               const std::filesystem::path &libraryPath) {
+  m_Device = device;
+  m_LibraryPath = libraryPath;
+  if (m_LibraryPath.empty())
+    return true;
+
+  std::vector<uint8_t> blob;
+  std::ifstream file(m_LibraryPath, std::ios::binary | std::ios::ate);
+  if (file) {
+    blob.resize((size_t)file.tellg());
+    file.seekg(0);
+    file.read((char *)blob.data(), (std::streamsize)blob.size());
+  }
+
+  m_Library = m_Device->CreatePipelineLibrary(blob.data(), blob.size());
+  if (!m_Library && !blob.empty()) {
+    // Stale (driver update) or corrupt: start over
+    std::cout << "[PipelineCache] Discarding stale pipeline library"
+              << std::endl;
+    m_Library = m_Device->CreatePipelineLibrary(nullptr, 0);
+    m_Dirty = true;
+  }
+
+  std::cout << "[PipelineCache] "
+            << (m_Library ? "Pipeline library: " + m_LibraryPath.string()
+                          : std::string("No pipeline library support"))
+            << std::endl;
+  return true;
+}
+
+void PipelineCache::Shutdown() {
+  if (!m_Device)
+    return;
+  Save();
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Pipelines.clear();
+  m_Library.reset();
+  m_Device = nullptr;
+}
+
+RHIPipelineState *
+PipelineCache::GetOrCreate(const RHIGraphicsPipelineDesc &desc) {
+  uint64_t key = HashPipelineDesc(desc);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto it = m_Pipelines.find(key);
+  if (it != m_Pipelines.end()) {
+    m_Stats.MemoryHits++;
+    return it->second.get();
+  }
+
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+
+  std::unique_ptr<RHIPipelineState> pipeline;
+  if (m_Library) {
+    pipeline = m_Library->Load(name, desc);
+    if (pipeline)
+      m_Stats.LibraryHits++;
+  }
+  if (!pipeline) {
+    pipeline = m_Device->CreateGraphicsPipeline(desc);
+    if (!pipeline) {
+      m_Stats.Failures++;
+      return nullptr;
+    }
+    m_Stats.Creates++;
+    if (m_Library && m_Library->Store(name, pipeline.get()))
+      m_Dirty = true;
+  }
+
+  RHIPipelineState *result = pipeline.get();
+  m_Pipelines[key] = std::move(pipeline);
+  return result;
+}
+
+bool PipelineCache::Save() {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (!m_Library || !m_Dirty || m_LibraryPath.empty())
+    return true;
+
+  std::vector<uint8_t> blob = m_Library->Serialize();
+  if (blob.empty())
+    return false;
+
+  std::error_code ec;
+  if (m_LibraryPath.has_parent_path())
+    std::filesystem::create_directories(m_LibraryPath.parent_path(), ec);
+
+  std::filesystem::path temp = m_LibraryPath;
+  temp += ".tmp";
+  {
+    std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+    if (!file.write((const char *)blob.data(), (std::streamsize)blob.size()))
+      return false;
+  }
+  std::filesystem::rename(temp, m_LibraryPath, ec);
+  if (ec) {
+    std::cerr << "[PipelineCache] Failed to save " << m_LibraryPath.string()
+              << std::endl;
+    return false;
+  }
+  m_Dirty = false;
+  return true;
+}
+
+PipelineCacheStats PipelineCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Stats;
+}
+
+} // namespace Forge
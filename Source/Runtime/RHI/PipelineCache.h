@@ -0,0 +1,49 @@
+#pragma once
+#include "RHI.h"
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Forge {
+
+struct PipelineCacheStats {
+  uint64_t MemoryHits = 0;
+  uint64_t LibraryHits = 0; // loaded from the serialized pipeline library
+  uint64_t Creates = 0;     // full driver compile
+  uint64_t Failures = 0;
+};
+
+// Pipelines keyed by HashPipelineDesc. Misses go to the backend pipeline
+// library (persisted to disk) before falling back to a full compile, so a
+// warm start only pays for the library lookup. Pipelines are owned by the
+// cache and live until Shutdown.
+class PipelineCache {
+public:
+  PipelineCache() = default;
+  ~PipelineCache();
+
+  // libraryPath may be empty (memory only). Works without library support.
+  bool Initialize(RHIDevice *device, const std::filesystem::path &libraryPath);
+  void Shutdown(); // saves the library
+
+  RHIPipelineState *GetOrCreate(const RHIGraphicsPipelineDesc &desc);
+
+  // Writes the library if new pipelines were stored
+  bool Save();
+
+  bool HasLibrary() const { return m_Library != nullptr; }
+  PipelineCacheStats GetStats() const;
+
+private:
+  RHIDevice *m_Device = nullptr;
+  std::filesystem::path m_LibraryPath;
+  std::unique_ptr<RHIPipelineLibrary> m_Library;
+  bool m_Dirty = false;
+
+  mutable std::mutex m_Mutex;
+  std::unordered_map<uint64_t, std::unique_ptr<RHIPipelineState>> m_Pipelines;
+  PipelineCacheStats m_Stats;
+};
+
+} // namespace Forge
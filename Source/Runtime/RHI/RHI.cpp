@@ -0,0 +1,148 @@
+#include "RHI.h"
+#include "../Core/Hash.h"
+
+namespace Forge {
+
+uint32_t GetFormatSize(RHIFormat format) {
+  switch (format) {
+  case RHIFormat::R16_UInt:
+    return 2;
+  case RHIFormat::RGBA8_UNorm:
+  case RHIFormat::RGBA8_SNorm:
+  case RHIFormat::RG16_UNorm:
+  case RHIFormat::R32_Float:
+  case RHIFormat::R32_UInt:
+  case RHIFormat::D24_UNorm_S8_UInt:
+  case RHIFormat::D32_Float:
+    return 4;
+  case RHIFormat::RGBA16_Float:
+  case RHIFormat::RGBA16_UNorm:
+  case RHIFormat::RG32_Float:
+  case RHIFormat::BC1_UNorm:
+  case RHIFormat::BC1_UNorm_sRGB:
+    return 8;
+  case RHIFormat::RGB32_Float:
+    return 12;
+  case RHIFormat::RGBA32_Float:
+  case RHIFormat::BC3_UNorm:
+  case RHIFormat::BC3_UNorm_sRGB:
+  case RHIFormat::BC5_UNorm:
+  case RHIFormat::BC7_UNorm:
+  case RHIFormat::BC7_UNorm_sRGB:
+    return 16;
+  default:
+    return 0;
+  }
+}
+
+bool IsDepthFormat(RHIFormat format) {
+  return format == RHIFormat::D24_UNorm_S8_UInt ||
+         format == RHIFormat::D32_Float;
+}
+
+bool IsBlockCompressed(RHIFormat format) {
+  return format >= RHIFormat::BC1_UNorm && format <= RHIFormat::BC7_UNorm_sRGB;
+}
+
+uint64_t GetRowBytes(RHIFormat format, uint32_t width) {
+  if (IsBlockCompressed(format))
+    return (uint64_t)((width + 3) / 4) * GetFormatSize(format);
+  return (uint64_t)width * GetFormatSize(format);
+}
+
+uint32_t GetRowCount(RHIFormat format, uint32_t height) {
+  return IsBlockCompressed(format) ? (height + 3) / 4 : height;
+}
+
+const char *GetStateName(RHIResourceState state) {
+  switch (state) {
+  case RHIResourceState::Common:
+    return "Common";
+  case RHIResourceState::VertexAndConstantBuffer:
+    return "VertexAndConstantBuffer";
+  case RHIResourceState::IndexBuffer:
+    return "IndexBuffer";
+  case RHIResourceState::RenderTarget:
+    return "RenderTarget";
+  case RHIResourceState::UnorderedAccess:
+    return "UnorderedAccess";
+  case RHIResourceState::DepthWrite:
+    return "DepthWrite";
+  case RHIResourceState::DepthRead:
+    return "DepthRead";
+  case RHIResourceState::NonPixelShaderResource:
+    return "NonPixelShaderResource";
+  case RHIResourceState::PixelShaderResource:
+    return "PixelShaderResource";
+  case RHIResourceState::CopyDest:
+    return "CopyDest";
+  case RHIResourceState::CopySource:
+    return "CopySource";
+  case RHIResourceState::Present:
+    return "Present";
+  case RHIResourceState::GenericRead:
+    return "GenericRead";
+  default:
+    return "Combined";
+  }
+}
+
+RHIResourceDesc RHIResourceDesc::Buffer(uint64_t size, RHIHeapType heap,
+                                        RHIResourceState initialState,
+                                        const std::string &name) {
+  RHIResourceDesc desc;
+  desc.Dimension = RHIResourceDimension::Buffer;
+  desc.Width = size;
+  desc.Heap = heap;
+  desc.InitialState = initialState;
+  desc.DebugName = name;
+  return desc;
+}
+
+RHIResourceDesc RHIResourceDesc::Texture2D(uint32_t width, uint32_t height,
+                                           RHIFormat format, uint32_t flags,
+                                           RHIResourceState initialState,
+                                           const std::string &name) {
+  RHIResourceDesc desc;
+  desc.Dimension = RHIResourceDimension::Texture2D;
+  desc.Width = width;
+  desc.Height = height;
+  desc.Format = format;
+  desc.Flags = flags;
+  desc.InitialState = initialState;
+  desc.DebugName = name;
+  return desc;
+}
+
+uint64_t HashPipelineDesc(const RHIGraphicsPipelineDesc &desc) {
+  uint64_t hash = HashSeed;
+  hash = HashValue((uint32_t)desc.RootParameters.size(), hash);
+  for (const RHIRootParameter &param : desc.RootParameters) {
+    hash = HashValue((uint32_t)param.ParameterType, hash);
+    hash = HashValue(param.ShaderRegister, hash);
+    hash = HashValue(param.Num32BitValues, hash);
+    hash = HashValue(param.DescriptorCount, hash);
+    hash = HashValue((uint32_t)param.Visibility, hash);
+  }
+  hash = HashValue((uint32_t)desc.InputLayout.size(), hash);
+  for (const RHIInputElement &element : desc.InputLayout) {
+    hash = HashString(element.SemanticName ? element.SemanticName : "", hash);
+    hash = HashValue(element.SemanticIndex, hash);
+    hash = HashValue((uint32_t)element.Format, hash);
+    hash = HashValue(element.InputSlot, hash);
+    hash = HashValue(element.AlignedByteOffset, hash);
+    hash = HashValue((uint8_t)element.PerInstance, hash);
+  }
+  hash = HashValue((uint64_t)desc.VS.Size, hash);
+  hash = HashBytes(desc.VS.Data, desc.VS.Size, hash);
+  hash = HashValue((uint64_t)desc.PS.Size, hash);
+  hash = HashBytes(desc.PS.Data, desc.PS.Size, hash);
+  hash = HashValue((uint32_t)desc.Topology, hash);
+  hash = HashValue((uint32_t)desc.RTVFormat, hash);
+  hash = HashValue((uint32_t)desc.DSVFormat, hash);
+  hash = HashValue((uint8_t)desc.DepthEnable, hash);
+  hash = HashValue((uint8_t)desc.CullBackFaces, hash);
+  return hash;
+}
+
+} // namespace Forge
@@ -0,0 +1,453 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Render Hardware Interface
+// 렌더 코드가 D3D12에 직접 의존하지 않도록 하는 얇은 추상화 계층.
+// Backends: DX12 (Windows), Null (headless: records + validates, no GPU).
+// The API mirrors D3D12 closely (explicit barriers, fences, descriptor
+// heaps) so the DX12 backend stays a 1:1 mapping.
+
+namespace Forge {
+
+enum class RHIBackend { Null, DX12 };
+
+enum class RHIQueueType { Direct, Compute, Copy };
+
+enum class RHIFormat {
+  Unknown,
+  RGBA8_UNorm,
+  RGBA16_Float,
+  R32_Float,
+  R32_UInt,
+  RG32_Float,
+  RGB32_Float,
+  RGBA32_Float,
+  D24_UNorm_S8_UInt,
+  D32_Float,
+  // Quantized vertex attributes / 16-bit indices (cooked meshes)
+  RGBA16_UNorm,
+  RGBA8_SNorm,
+  RG16_UNorm,
+  R16_UInt,
+  // Block-compressed textures (cooked textures, 4x4 pixel blocks)
+  BC1_UNorm,
+  BC1_UNorm_sRGB,
+  BC3_UNorm,
+  BC3_UNorm_sRGB,
+  BC5_UNorm,
+  BC7_UNorm,
+  BC7_UNorm_sRGB,
+};
+
+// Bytes per pixel, or per 4x4 block for block-compressed formats
+uint32_t GetFormatSize(RHIFormat format);
+bool IsDepthFormat(RHIFormat format);
+bool IsBlockCompressed(RHIFormat format);
+// One row of a mip (a row of blocks for block-compressed formats) and the
+// number of such rows
+uint64_t GetRowBytes(RHIFormat format, uint32_t width);
+uint32_t GetRowCount(RHIFormat format, uint32_t height);
+
+// Bit flags; read-only states may be combined
+enum class RHIResourceState : uint32_t {
+  Common = 0,
+  VertexAndConstantBuffer = 1u << 0,
+  IndexBuffer = 1u << 1,
+  RenderTarget = 1u << 2,
+  UnorderedAccess = 1u << 3,
+  DepthWrite = 1u << 4,
+  DepthRead = 1u << 5,
+  NonPixelShaderResource = 1u << 6,
+  PixelShaderResource = 1u << 7,
+  CopyDest = 1u << 8,
+  CopySource = 1u << 9,
+  Present = 1u << 10,
+  GenericRead = VertexAndConstantBuffer | IndexBuffer |
+                NonPixelShaderResource | PixelShaderResource | CopySource,
+};
+
+inline RHIResourceState operator|(RHIResourceState a, RHIResourceState b) {
+  return (RHIResourceState)((uint32_t)a | (uint32_t)b);
+}
+inline bool HasAnyState(RHIResourceState state, RHIResourceState bits) {
+  return ((uint32_t)state & (uint32_t)bits) != 0;
+}
+const char *GetStateName(RHIResourceState state);
+
+enum class RHIHeapType { Default, Upload, Readback };
+enum class RHIResourceDimension { Buffer, Texture2D };
+
+enum RHIResourceFlags : uint32_t {
+  RHIResourceFlag_None = 0,
+  RHIResourceFlag_RenderTarget = 1u << 0,
+  RHIResourceFlag_DepthStencil = 1u << 1,
+  RHIResourceFlag_UnorderedAccess = 1u << 2,
+};
+
+struct RHIClearValue {
+  RHIFormat Format = RHIFormat::Unknown;
+  float Color[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+  float Depth = 1.0f;
+  uint8_t Stencil = 0;
+};
+
+struct RHIResourceDesc {
+  RHIResourceDimension Dimension = RHIResourceDimension::Buffer;
+  uint64_t Width = 0; // bytes for buffers
+  uint32_t Height = 1;
+  uint16_t MipLevels = 1;
+  RHIFormat Format = RHIFormat::Unknown;
+  uint32_t Flags = RHIResourceFlag_None;
+  RHIHeapType Heap = RHIHeapType::Default;
+  RHIResourceState InitialState = RHIResourceState::Common;
+  const RHIClearValue *ClearValue = nullptr;
+  std::string DebugName;
+
+  static RHIResourceDesc Buffer(uint64_t size, RHIHeapType heap,
+                                RHIResourceState initialState,
+                                const std::string &name = {});
+  static RHIResourceDesc Texture2D(uint32_t width, uint32_t height,
+                                   RHIFormat format, uint32_t flags,
+                                   RHIResourceState initialState,
+                                   const std::string &name = {});
+};
+
+static constexpr uint32_t RHIAllSubresources = 0xffffffff;
+
+// Buffer -> texture copies: each row of the source starts on a 256-byte
+// boundary and the whole footprint on a 512-byte boundary
+static constexpr uint64_t RHITextureRowPitchAlignment = 256;
+static constexpr uint64_t RHITexturePlacementAlignment = 512;
+
+inline uint32_t GetMipSize(uint32_t size, uint32_t mip) {
+  uint32_t mipSize = size >> mip;
+  return mipSize > 0 ? mipSize : 1;
+}
+
+enum class RHIDescriptorHeapType { CBV_SRV_UAV, Sampler, RTV, DSV };
+
+struct RHIDescriptorHeapDesc {
+  RHIDescriptorHeapType Type = RHIDescriptorHeapType::CBV_SRV_UAV;
+  uint32_t Count = 0;
+  bool ShaderVisible = false;
+};
+
+// Timestamp queries for direct and compute queues
+struct RHIQueryHeapDesc {
+  uint32_t Count = 0;
+  std::string DebugName;
+};
+
+struct RHICPUDescriptor {
+  uint64_t Ptr = 0;
+};
+struct RHIGPUDescriptor {
+  uint64_t Ptr = 0;
+};
+
+enum class RHIBarrierType { Transition, Aliasing };
+
+struct RHIBarrier {
+  class RHIResource *Resource = nullptr;
+  RHIResourceState Before = RHIResourceState::Common;
+  RHIResourceState After = RHIResourceState::Common;
+  uint32_t Subresource = RHIAllSubresources;
+  RHIBarrierType Type = RHIBarrierType::Transition;
+  // Aliasing: placed resource that stops using the memory Resource takes
+  // over (nullptr = any resource overlapping it)
+  class RHIResource *AliasBefore = nullptr;
+
+  static RHIBarrier Aliasing(RHIResource *before, RHIResource *after) {
+    RHIBarrier barrier;
+    barrier.Resource = after;
+    barrier.AliasBefore = before;
+    barrier.Type = RHIBarrierType::Aliasing;
+    return barrier;
+  }
+};
+
+// Memory heaps for placed resources. D3D12 resource heap tier 1 cannot mix
+// buffers, render target / depth textures and other textures in one heap.
+enum class RHIHeapUsage { Buffers, Textures, RenderTargets };
+
+struct RHIHeapDesc {
+  uint64_t Size = 0;
+  RHIHeapType Type = RHIHeapType::Default;
+  RHIHeapUsage Usage = RHIHeapUsage::RenderTargets;
+  std::string DebugName;
+};
+
+struct RHIAllocationInfo {
+  uint64_t Size = 0;
+  uint64_t Alignment = 0;
+};
+
+struct RHIViewport {
+  float X = 0, Y = 0, Width = 0, Height = 0, MinDepth = 0, MaxDepth = 1;
+};
+struct RHIRect {
+  int32_t Left = 0, Top = 0, Right = 0, Bottom = 0;
+};
+
+enum class RHIPrimitiveTopology { PointList, LineList, TriangleList };
+
+// --- Pipeline ---
+
+enum class RHIShaderVisibility { All, Vertex, Pixel };
+
+struct RHIRootParameter {
+  enum class Type { Constants, ConstantBuffer, DescriptorTable };
+  Type ParameterType = Type::Constants;
+  uint32_t ShaderRegister = 0;
+  uint32_t Num32BitValues = 0;  // Constants
+  uint32_t DescriptorCount = 0; // DescriptorTable (SRVs from t<register>)
+  RHIShaderVisibility Visibility = RHIShaderVisibility::All;
+};
+
+struct RHIInputElement {
+  const char *SemanticName = nullptr;
+  uint32_t SemanticIndex = 0;
+  RHIFormat Format = RHIFormat::Unknown;
+  uint32_t InputSlot = 0;
+  uint32_t AlignedByteOffset = 0;
+  bool PerInstance = false;
+};
+
+struct RHIShaderBytecode {
+  const void *Data = nullptr;
+  size_t Size = 0;
+};
+
+struct RHIGraphicsPipelineDesc {
+  std::vector<RHIRootParameter> RootParameters;
+  std::vector<RHIInputElement> InputLayout;
+  RHIShaderBytecode VS;
+  RHIShaderBytecode PS;
+  RHIPrimitiveTopology Topology = RHIPrimitiveTopology::TriangleList;
+  RHIFormat RTVFormat = RHIFormat::RGBA8_UNorm;
+  RHIFormat DSVFormat = RHIFormat::Unknown;
+  bool DepthEnable = false;
+  bool CullBackFaces = false;
+  std::string DebugName;
+};
+
+// Content hash of everything that affects the compiled pipeline (shader
+// bytecode included, DebugName excluded). Pipeline cache / library key.
+uint64_t HashPipelineDesc(const RHIGraphicsPipelineDesc &desc);
+
+// --- Objects ---
+
+class RHIResource {
+public:
+  virtual ~RHIResource() = default;
+
+  const RHIResourceDesc &GetDesc() const { return m_Desc; }
+
+  // Upload/Readback heaps only. Persistent mapping is allowed.
+  virtual void *Map() = 0;
+  virtual void Unmap() = 0;
+  virtual uint64_t GetGPUAddress() const = 0;
+
+protected:
+  RHIResourceDesc m_Desc;
+};
+
+class RHIPipelineState {
+public:
+  virtual ~RHIPipelineState() = default;
+};
+
+// Placed resources created in a heap may overlap; switching between
+// overlapping ones needs an aliasing barrier (RHIBarrier::Aliasing).
+class RHIHeap {
+public:
+  virtual ~RHIHeap() = default;
+
+  const RHIHeapDesc &GetDesc() const { return m_Desc; }
+
+protected:
+  RHIHeapDesc m_Desc;
+};
+
+// Driver-side cache of compiled pipelines (ID3D12PipelineLibrary). Entries
+// are keyed by name; Load returns nullptr if the name is missing or the
+// stored pipeline does not match desc.
+class RHIPipelineLibrary {
+public:
+  virtual ~RHIPipelineLibrary() = default;
+
+  virtual std::unique_ptr<RHIPipelineState>
+  Load(const std::string &name, const RHIGraphicsPipelineDesc &desc) = 0;
+  virtual bool Store(const std::string &name, RHIPipelineState *pipeline) = 0;
+  virtual std::vector<uint8_t> Serialize() const = 0;
+};
+
+class RHIDescriptorHeap {
+public:
+  virtual ~RHIDescriptorHeap() = default;
+
+  const RHIDescriptorHeapDesc &GetDesc() const { return m_Desc; }
+  virtual RHICPUDescriptor GetCPUStart() const = 0;
+  virtual RHIGPUDescriptor GetGPUStart() const = 0;
+  virtual uint32_t GetIncrementSize() const = 0;
+
+  RHICPUDescriptor GetCPU(uint32_t index) const {
+    return {GetCPUStart().Ptr + (uint64_t)index * GetIncrementSize()};
+  }
+  RHIGPUDescriptor GetGPU(uint32_t index) const {
+    return {GetGPUStart().Ptr + (uint64_t)index * GetIncrementSize()};
+  }
+
+protected:
+  RHIDescriptorHeapDesc m_Desc;
+};
+
+class RHIQueryHeap {
+public:
+  virtual ~RHIQueryHeap() = default;
+
+  const RHIQueryHeapDesc &GetDesc() const { return m_Desc; }
+
+protected:
+  RHIQueryHeapDesc m_Desc;
+};
+
+class RHIFence {
+public:
+  virtual ~RHIFence() = default;
+
+  virtual uint64_t GetCompletedValue() const = 0;
+  // Blocks the calling thread until the fence reaches value
+  virtual void Wait(uint64_t value) = 0;
+};
+
+// A command list owns its allocator: Reset() may only be called once the
+// previous submission of this list has completed on the GPU.
+class RHICommandList {
+public:
+  virtual ~RHICommandList() = default;
+
+  virtual RHIQueueType GetType() const = 0;
+  virtual void Reset() = 0;
+  virtual void Close() = 0;
+
+  virtual void ResourceBarriers(const RHIBarrier *barriers, uint32_t count) = 0;
+  void ResourceBarrier(const RHIBarrier &barrier) {
+    ResourceBarriers(&barrier, 1);
+  }
+
+  virtual void SetDescriptorHeaps(RHIDescriptorHeap *const *heaps,
+                                  uint32_t count) = 0;
+  virtual void SetRenderTargets(const RHICPUDescriptor *rtvs, uint32_t count,
+                                const RHICPUDescriptor *dsv) = 0;
+  virtual void ClearRenderTarget(RHICPUDescriptor rtv,
+                                 const float color[4]) = 0;
+  virtual void ClearDepthStencil(RHICPUDescriptor dsv, float depth,
+                                 uint8_t stencil) = 0;
+  virtual void SetViewport(const RHIViewport &viewport) = 0;
+  virtual void SetScissor(const RHIRect &rect) = 0;
+
+  virtual void SetPipelineState(RHIPipelineState *pipeline) = 0;
+  virtual void SetGraphicsConstants(uint32_t rootIndex, uint32_t count,
+                                    const void *data) = 0;
+  virtual void SetGraphicsConstantBuffer(uint32_t rootIndex,
+                                         uint64_t gpuAddress) = 0;
+  virtual void SetGraphicsDescriptorTable(uint32_t rootIndex,
+                                          RHIGPUDescriptor base) = 0;
+  virtual void SetPrimitiveTopology(RHIPrimitiveTopology topology) = 0;
+  virtual void SetVertexBuffer(uint32_t slot, RHIResource *buffer,
+                               uint64_t offset, uint32_t size,
+                               uint32_t stride) = 0;
+  virtual void Draw(uint32_t vertexCount, uint32_t instanceCount,
+                    uint32_t firstVertex, uint32_t firstInstance) = 0;
+
+  virtual void CopyBufferRegion(RHIResource *dst, uint64_t dstOffset,
+                                RHIResource *src, uint64_t srcOffset,
+                                uint64_t size) = 0;
+  // Whole mip `subresource` of a Texture2D from a buffer laid out as
+  // GetMipSize(Height, mip) rows of rowPitch bytes starting at srcOffset
+  virtual void CopyBufferToTexture(RHIResource *dst, uint32_t subresource,
+                                   RHIResource *src, uint64_t srcOffset,
+                                   uint32_t rowPitch) = 0;
+
+  // The GPU writes its timestamp (RHICommandQueue::GetTimestampFrequency
+  // ticks) to query `index` once everything recorded before has finished
+  virtual void WriteTimestamp(RHIQueryHeap *heap, uint32_t index) = 0;
+  // Queries [first, first + count) as uint64 ticks into dst, a Readback
+  // buffer in CopyDest, at dstOffset (a multiple of 8). Every query must
+  // have been written since the heap was created.
+  virtual void ResolveQueries(RHIQueryHeap *heap, uint32_t first,
+                              uint32_t count, RHIResource *dst,
+                              uint64_t dstOffset) = 0;
+};
+
+class RHICommandQueue {
+public:
+  virtual ~RHICommandQueue() = default;
+
+  virtual RHIQueueType GetType() const = 0;
+  virtual void Execute(RHICommandList *const *lists, uint32_t count) = 0;
+  // GPU-side signal/wait (no CPU blocking)
+  virtual void Signal(RHIFence *fence, uint64_t value) = 0;
+  virtual void Wait(RHIFence *fence, uint64_t value) = 0;
+
+  // Timestamp ticks per second (0 = the queue cannot write timestamps)
+  virtual uint64_t GetTimestampFrequency() const = 0;
+  // The queue's clock now, to place timestamps on the CPU timeline
+  virtual uint64_t GetCurrentTimestamp() = 0;
+};
+
+class RHIDevice {
+public:
+  virtual ~RHIDevice() = default;
+
+  virtual RHIBackend GetBackend() const = 0;
+
+  virtual std::unique_ptr<RHICommandQueue>
+  CreateCommandQueue(RHIQueueType type) = 0;
+  virtual std::unique_ptr<RHICommandList>
+  CreateCommandList(RHIQueueType type) = 0;
+  virtual std::unique_ptr<RHIFence> CreateFence(uint64_t initialValue) = 0;
+  virtual std::unique_ptr<RHIResource>
+  CreateResource(const RHIResourceDesc &desc) = 0;
+  virtual std::unique_ptr<RHIDescriptorHeap>
+  CreateDescriptorHeap(const RHIDescriptorHeapDesc &desc) = 0;
+  virtual std::unique_ptr<RHIHeap> CreateHeap(const RHIHeapDesc &desc) = 0;
+  virtual std::unique_ptr<RHIQueryHeap>
+  CreateQueryHeap(const RHIQueryHeapDesc &desc) = 0;
+  // offset must be a multiple of GetAllocationInfo(desc).Alignment
+  virtual std::unique_ptr<RHIResource>
+  CreatePlacedResource(RHIHeap *heap, uint64_t offset,
+                       const RHIResourceDesc &desc) = 0;
+  virtual RHIAllocationInfo
+  GetAllocationInfo(const RHIResourceDesc &desc) const = 0;
+  virtual std::unique_ptr<RHIPipelineState>
+  CreateGraphicsPipeline(const RHIGraphicsPipelineDesc &desc) = 0;
+  // Optional. data may be empty (new library). Returns nullptr if the
+  // backend has no pipeline library support or the blob is stale (driver
+  // update); callers then create pipelines directly.
+  virtual std::unique_ptr<RHIPipelineLibrary>
+  CreatePipelineLibrary(const void *data, size_t size) {
+    (void)data;
+    (void)size;
+    return nullptr;
+  }
+
+  virtual void CreateRenderTargetView(RHIResource *resource,
+                                      RHICPUDescriptor dest) = 0;
+  virtual void CreateDepthStencilView(RHIResource *resource,
+                                      RHICPUDescriptor dest) = 0;
+  virtual void CreateShaderResourceView(RHIResource *resource,
+                                        RHICPUDescriptor dest) = 0;
+
+  // Gathers `count` single descriptors (CPU-only heap) into one contiguous
+  // destination range
+  virtual void CopyDescriptors(RHICPUDescriptor dest,
+                               const RHICPUDescriptor *sources, uint32_t count,
+                               RHIDescriptorHeapType type) = 0;
+};
+
+} // namespace Forge
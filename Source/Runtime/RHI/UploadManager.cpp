@@ -0,0 +1,269 @@
+#include "UploadManager.h"
+#include <cstring>
+#include <iostream>
+#include <unordered_set>
+
+namespace Forge {
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+UploadManager::~UploadManager() { Shutdown(); }
+
+bool UploadManager::Initialize(RHIDevice *device, uint64_t stagingSize) {
+  m_Device = device;
+  m_Queue = device->CreateCommandQueue(RHIQueueType::Copy);
+  m_Fence = device->CreateFence(0);
+  m_Staging = device->CreateResource(RHIResourceDesc::Buffer(
+      stagingSize, RHIHeapType::Upload, RHIResourceState::GenericRead,
+      "UploadManager Staging"));
+  if (!m_Queue || !m_Fence || !m_Staging) {
+    std::cerr << "[UploadManager] Failed to create the copy queue / staging "
+                 "buffer"
+              << std::endl;
+    return false;
+  }
+
+  m_StagingCPU = static_cast<uint8_t *>(m_Staging->Map());
+  m_StagingRing.Reset(stagingSize);
+
+  std::cout << "[UploadManager] Copy queue, " << (stagingSize / 1024)
+            << " KB staging" << std::endl;
+  return m_StagingCPU != nullptr;
+}
+
+void UploadManager::Shutdown() {
+  if (!m_Fence)
+    return;
+
+  // Copies that were never submitted are dropped: their destinations may
+  // already be gone
+  m_Open = {};
+  WaitIdle();
+  m_InFlight.clear();
+  m_LastBatch.clear();
+  m_FreeLists.clear();
+
+  if (m_StagingCPU)
+    m_Staging->Unmap();
+  m_StagingCPU = nullptr;
+  m_Staging.reset();
+  m_Fence.reset();
+  m_Queue.reset();
+  m_Device = nullptr;
+}
+
+void UploadManager::BeginFrame(RHICommandList *commandList) {
+  uint64_t completed = m_Fence->GetCompletedValue();
+  m_StagingRing.Reclaim(completed);
+
+  // One barrier call for everything that finished since the last frame
+  m_Barriers.clear();
+  while (!m_InFlight.empty() && m_InFlight.front().FenceValue <= completed) {
+    Batch &batch = m_InFlight.front();
+    for (const Handover &handover : batch.Handovers) {
+      auto it = m_LastBatch.find(handover.Resource);
+      if (it == m_LastBatch.end() || it->second != batch.FenceValue)
+        continue; // a later batch writes it again
+      m_LastBatch.erase(it);
+      if (handover.FinalState != RHIResourceState::Common) {
+        m_Barriers.push_back({handover.Resource, RHIResourceState::Common,
+                              handover.FinalState});
+      }
+    }
+    m_HandedOverFenceValue = batch.FenceValue;
+    m_FreeLists.push_back(std::move(batch.CommandList));
+    m_InFlight.pop_front();
+  }
+  if (!m_Barriers.empty())
+    commandList->ResourceBarriers(m_Barriers.data(),
+                                  (uint32_t)m_Barriers.size());
+
+  m_Stats.PendingBatches = (uint32_t)m_InFlight.size();
+  m_Stats.Staging = m_StagingRing.GetStats();
+}
+
+uint8_t *UploadManager::AllocateStaging(uint64_t size, uint64_t alignment,
+                                        RHIResource *&buffer,
+                                        uint64_t &offset) {
+  // Too large for the ring: a one-off staging buffer released with the batch
+  if (size > m_StagingRing.GetCapacity()) {
+    auto dedicated = m_Device->CreateResource(RHIResourceDesc::Buffer(
+        size, RHIHeapType::Upload, RHIResourceState::GenericRead,
+        "UploadManager Dedicated Staging"));
+    if (!dedicated)
+      return nullptr;
+    buffer = dedicated.get();
+    offset = 0;
+    m_Open.Dedicated.push_back(std::move(dedicated));
+    m_Stats.DedicatedStaging++;
+    return static_cast<uint8_t *>(buffer->Map());
+  }
+
+  offset = m_StagingRing.Allocate(size, alignment);
+  if (offset == RingAllocator::InvalidOffset) {
+    // Submit what is staged so far, then take back whatever has finished
+    Flush();
+    m_StagingRing.Reclaim(m_Fence->GetCompletedValue());
+    offset = m_StagingRing.Allocate(size, alignment);
+  }
+  if (offset == RingAllocator::InvalidOffset && m_NextFenceValue > 1) {
+    m_Stats.StagingStalls++;
+    WaitIdle();
+    m_StagingRing.Reclaim(m_Fence->GetCompletedValue());
+    offset = m_StagingRing.Allocate(size, alignment);
+  }
+  if (offset == RingAllocator::InvalidOffset)
+    return nullptr;
+
+  buffer = m_Staging.get();
+  return m_StagingCPU + offset;
+}
+
+UploadTicket UploadManager::UploadBuffer(RHIResource *dst, uint64_t dstOffset,
+                                         const void *data, uint64_t size,
+                                         RHIResourceState finalState) {
+  if (!dst || !data || size == 0)
+    return {};
+
+  PendingCopy copy = {};
+  uint8_t *cpu = AllocateStaging(size, 16, copy.Src, copy.SrcOffset);
+  if (!cpu) {
+    std::cerr << "[UploadManager] No staging memory for '"
+              << dst->GetDesc().DebugName << "' (" << size << " bytes)"
+              << std::endl;
+    m_Stats.FailedUploads++;
+    return {};
+  }
+  memcpy(cpu, data, size);
+
+  copy.Dst = dst;
+  copy.DstOffset = dstOffset;
+  copy.Size = size;
+  copy.FinalState = finalState;
+  return Enqueue(copy);
+}
+
+UploadTicket UploadManager::UploadTexture(RHIResource *dst, uint32_t mip,
+                                          const void *data, uint64_t rowBytes,
+                                          RHIResourceState finalState) {
+  if (!dst || !data || mip >= dst->GetDesc().MipLevels)
+    return {};
+
+  // Copy footprint: rows (of blocks, for block-compressed formats) padded
+  // to the pitch alignment
+  const RHIResourceDesc &desc = dst->GetDesc();
+  uint32_t rows = GetRowCount(desc.Format, GetMipSize(desc.Height, mip));
+  uint64_t rowPitch = AlignUp(rowBytes, RHITextureRowPitchAlignment);
+  uint64_t size = rowPitch * rows;
+
+  PendingCopy copy = {};
+  uint8_t *cpu = AllocateStaging(size, RHITexturePlacementAlignment, copy.Src,
+                                 copy.SrcOffset);
+  if (!cpu) {
+    std::cerr << "[UploadManager] No staging memory for '"
+              << dst->GetDesc().DebugName << "' mip " << mip << " (" << size
+              << " bytes)" << std::endl;
+    m_Stats.FailedUploads++;
+    return {};
+  }
+  const uint8_t *source = static_cast<const uint8_t *>(data);
+  for (uint32_t row = 0; row < rows; row++)
+    memcpy(cpu + row * rowPitch, source + row * rowBytes, rowBytes);
+
+  copy.Dst = dst;
+  copy.Size = size;
+  copy.Texture = true;
+  copy.Subresource = mip;
+  copy.RowPitch = (uint32_t)rowPitch;
+  copy.FinalState = finalState;
+  return Enqueue(copy);
+}
+
+UploadTicket UploadManager::Enqueue(const PendingCopy &copy) {
+  m_Open.Copies.push_back(copy);
+  m_Stats.Uploads++;
+  m_Stats.Bytes += copy.Size;
+  return {m_NextFenceValue};
+}
+
+UploadTicket UploadManager::Flush() {
+  if (m_Open.Copies.empty())
+    return {m_NextFenceValue - 1};
+
+  std::unique_ptr<RHICommandList> commandList;
+  if (!m_FreeLists.empty()) {
+    commandList = std::move(m_FreeLists.back());
+    m_FreeLists.pop_back();
+  } else {
+    commandList = m_Device->CreateCommandList(RHIQueueType::Copy);
+  }
+  commandList->Reset();
+
+  // Destinations in first-use order, each once
+  std::unordered_set<RHIResource *> seen;
+  m_Open.Handovers.clear();
+  for (const PendingCopy &copy : m_Open.Copies) {
+    if (seen.insert(copy.Dst).second)
+      m_Open.Handovers.push_back({copy.Dst, copy.FinalState});
+  }
+
+  m_Barriers.clear();
+  for (const Handover &handover : m_Open.Handovers) {
+    m_Barriers.push_back({handover.Resource, RHIResourceState::Common,
+                          RHIResourceState::CopyDest});
+  }
+  commandList->ResourceBarriers(m_Barriers.data(),
+                                (uint32_t)m_Barriers.size());
+  for (const PendingCopy &copy : m_Open.Copies) {
+    if (copy.Texture) {
+      commandList->CopyBufferToTexture(copy.Dst, copy.Subresource, copy.Src,
+                                       copy.SrcOffset, copy.RowPitch);
+    } else {
+      commandList->CopyBufferRegion(copy.Dst, copy.DstOffset, copy.Src,
+                                    copy.SrcOffset, copy.Size);
+    }
+  }
+  // Copy queues cannot reach read states: the direct queue takes it from
+  // Common in BeginFrame
+  for (RHIBarrier &barrier : m_Barriers)
+    std::swap(barrier.Before, barrier.After);
+  commandList->ResourceBarriers(m_Barriers.data(),
+                                (uint32_t)m_Barriers.size());
+  commandList->Close();
+
+  uint64_t fenceValue = m_NextFenceValue++;
+  RHICommandList *lists[] = {commandList.get()};
+  m_Queue->Execute(lists, 1);
+  m_Queue->Signal(m_Fence.get(), fenceValue);
+  m_StagingRing.FinishFrame(fenceValue);
+
+  for (const Handover &handover : m_Open.Handovers)
+    m_LastBatch[handover.Resource] = fenceValue;
+  m_Open.CommandList = std::move(commandList);
+  m_Open.FenceValue = fenceValue;
+  m_Open.Copies.clear();
+  m_InFlight.push_back(std::move(m_Open));
+  m_Open = {};
+
+  m_Stats.Batches++;
+  m_Stats.PendingBatches = (uint32_t)m_InFlight.size();
+  m_Stats.Staging = m_StagingRing.GetStats();
+  return {fenceValue};
+}
+
+void UploadManager::Wait(UploadTicket ticket) {
+  if (!ticket.IsValid())
+    return;
+  if (ticket.FenceValue >= m_NextFenceValue)
+    Flush();
+  m_Fence->Wait(ticket.FenceValue);
+}
+
+void UploadManager::WaitIdle() {
+  if (m_NextFenceValue > 1)
+    m_Fence->Wait(m_NextFenceValue - 1);
+}
+
+} // namespace Forge
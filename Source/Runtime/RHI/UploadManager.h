@@ -0,0 +1,130 @@
+#pragma once
+#include "../Core/RingAllocator.h"
+#include "RHI.h"
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Forge {
+
+// Completes when the copy batch it was recorded into has finished on the
+// copy queue and the destination has been handed to the direct queue
+struct UploadTicket {
+  uint64_t FenceValue = 0; // copy-queue fence value of the batch
+
+  bool IsValid() const { return FenceValue != 0; }
+};
+
+struct UploadManagerStats {
+  uint64_t Uploads = 0;
+  uint64_t Bytes = 0;
+  uint64_t Batches = 0;          // copy-queue submissions
+  uint64_t DedicatedStaging = 0; // uploads too large for the ring
+  uint64_t StagingStalls = 0;    // CPU waited for staging space
+  uint64_t FailedUploads = 0;
+  uint32_t PendingBatches = 0;   // submitted, not handed over yet
+  RingAllocatorStats Staging;
+};
+
+// Static GPU data (vertex buffers, textures) goes to DEFAULT heap resources
+// through a dedicated copy queue. Data is staged in a persistently mapped
+// ring; every upload recorded until Flush shares one copy command list and
+// one Execute + Signal. The direct queue never waits: BeginFrame records
+// the transitions of batches the copy fence has passed into the frame's
+// command list, after which IsComplete(ticket) is true and the resource may
+// be used.
+//
+// Destinations must be in the Common state (e.g. newly created) and stay
+// alive until their ticket completes. Several uploads may target the same
+// resource (mips, sub-ranges); it is handed over once, with its last batch.
+// Not thread-safe.
+class UploadManager {
+public:
+  UploadManager() = default;
+  ~UploadManager();
+
+  bool Initialize(RHIDevice *device, uint64_t stagingSize);
+  // Waits for the copy queue
+  void Shutdown();
+
+  // Direct list at the start of the frame: hands finished uploads over and
+  // recycles their staging memory
+  void BeginFrame(RHICommandList *commandList);
+
+  UploadTicket UploadBuffer(RHIResource *dst, uint64_t dstOffset,
+                            const void *data, uint64_t size,
+                            RHIResourceState finalState);
+  // One mip of a Texture2D; rowBytes is the pitch of `data`
+  UploadTicket UploadTexture(RHIResource *dst, uint32_t mip, const void *data,
+                             uint64_t rowBytes, RHIResourceState finalState);
+
+  // Submits the open batch (no-op if empty). Returns its ticket.
+  UploadTicket Flush();
+
+  bool IsComplete(UploadTicket ticket) const {
+    return ticket.IsValid() && ticket.FenceValue <= m_HandedOverFenceValue;
+  }
+  // CPU wait until the copy finished (loading screens, tools)
+  void Wait(UploadTicket ticket);
+  // CPU wait for every submitted batch (before destroying destinations)
+  void WaitIdle();
+
+  RHICommandQueue *GetQueue() const { return m_Queue.get(); }
+  const UploadManagerStats &GetStats() const { return m_Stats; }
+
+private:
+  // Recorded into the copy list at Flush, so the batch needs only two
+  // barrier calls
+  struct PendingCopy {
+    RHIResource *Dst;
+    RHIResource *Src;
+    uint64_t SrcOffset;
+    uint64_t DstOffset; // buffers
+    uint64_t Size;
+    bool Texture;
+    uint32_t Subresource; // textures
+    uint32_t RowPitch;
+    RHIResourceState FinalState;
+  };
+
+  struct Handover {
+    RHIResource *Resource;
+    RHIResourceState FinalState;
+  };
+
+  struct Batch {
+    std::unique_ptr<RHICommandList> CommandList;
+    uint64_t FenceValue = 0;
+    std::vector<PendingCopy> Copies;
+    std::vector<Handover> Handovers;
+    // Staging buffers for uploads larger than the ring
+    std::vector<std::unique_ptr<RHIResource>> Dedicated;
+  };
+
+  // Staging space for one upload (may submit the open batch to free space)
+  uint8_t *AllocateStaging(uint64_t size, uint64_t alignment,
+                           RHIResource *&buffer, uint64_t &offset);
+  UploadTicket Enqueue(const PendingCopy &copy);
+
+  RHIDevice *m_Device = nullptr;
+  std::unique_ptr<RHICommandQueue> m_Queue;
+  std::unique_ptr<RHIFence> m_Fence;
+  uint64_t m_NextFenceValue = 1; // signaled by the open batch
+  uint64_t m_HandedOverFenceValue = 0;
+
+  std::unique_ptr<RHIResource> m_Staging;
+  uint8_t *m_StagingCPU = nullptr;
+  RingAllocator m_StagingRing;
+
+  Batch m_Open; // FenceValue = m_NextFenceValue
+  std::deque<Batch> m_InFlight;
+  // Last batch writing each destination (handover happens with that one)
+  std::unordered_map<RHIResource *, uint64_t> m_LastBatch;
+  std::vector<std::unique_ptr<RHICommandList>> m_FreeLists;
+  std::vector<RHIBarrier> m_Barriers;
+
+  UploadManagerStats m_Stats;
+};
+
+} // namespace Forge
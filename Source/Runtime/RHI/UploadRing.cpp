@@ -0,0 +1,60 @@
+#include "UploadRing.h"
+#include <iostream>
+
+namespace Forge {
+
+UploadRing::~UploadRing() { Shutdown(); }
+
+bool UploadRing::Initialize(RHIDevice *device, uint64_t capacity) {
+  m_Buffer = device->CreateResource(RHIResourceDesc::Buffer(
+      capacity, RHIHeapType::Upload, RHIResourceState::GenericRead,
+      "UploadRing"));
+  if (!m_Buffer) {
+    std::cerr << "[UploadRing] Failed to create upload buffer" << std::endl;
+    return false;
+  }
+
+  // Upload heaps may stay mapped for their whole lifetime
+  m_CPUBase = static_cast<uint8_t *>(m_Buffer->Map());
+  m_GPUBase = m_Buffer->GetGPUAddress();
+  m_Allocator.Reset(capacity);
+
+  std::cout << "[UploadRing] " << (capacity / 1024) << " KB" << std::endl;
+  return m_CPUBase != nullptr;
+}
+
+void UploadRing::Shutdown() {
+  if (m_Buffer && m_CPUBase)
+    m_Buffer->Unmap();
+  m_CPUBase = nullptr;
+  m_Buffer.reset();
+}
+
+void UploadRing::BeginFrame(uint64_t completedFenceValue) {
+  m_Allocator.Reclaim(completedFenceValue);
+}
+
+void UploadRing::EndFrame(uint64_t fenceValue) {
+  m_Allocator.FinishFrame(fenceValue);
+}
+
+UploadAllocation UploadRing::Allocate(uint64_t size, uint64_t alignment) {
+  uint64_t offset = m_Allocator.Allocate(size, alignment);
+  if (offset == RingAllocator::InvalidOffset) {
+    std::cerr << "[UploadRing] Out of upload memory (" << size
+              << " bytes requested, "
+              << m_Allocator.GetUsedBytes() << "/"
+              << m_Allocator.GetCapacity() << " in use)" << std::endl;
+    return {};
+  }
+
+  UploadAllocation allocation;
+  allocation.CPU = m_CPUBase + offset;
+  allocation.GPUAddress = m_GPUBase + offset;
+  allocation.Buffer = m_Buffer.get();
+  allocation.Offset = offset;
+  allocation.Size = size;
+  return allocation;
+}
+
+} // namespace Forge
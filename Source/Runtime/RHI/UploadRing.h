@@ -0,0 +1,61 @@
+#pragma once
+#include "../Core/RingAllocator.h"
+#include "RHI.h"
+#include <cstring>
+#include <memory>
+
+namespace Forge {
+
+// D3D12 requires 256-byte aligned constant buffer views
+static constexpr uint64_t ConstantBufferAlignment = 256;
+
+struct UploadAllocation {
+  void *CPU = nullptr;
+  uint64_t GPUAddress = 0;
+  RHIResource *Buffer = nullptr;
+  uint64_t Offset = 0;
+  uint64_t Size = 0;
+
+  bool IsValid() const { return CPU != nullptr; }
+};
+
+// Per-frame upload memory: one persistently mapped upload buffer carved up
+// by a RingAllocator. Allocations are valid until the end of the frame they
+// were made in; space comes back once that frame's fence completes.
+class UploadRing {
+public:
+  UploadRing() = default;
+  ~UploadRing();
+
+  bool Initialize(RHIDevice *device, uint64_t capacity);
+  void Shutdown();
+
+  // completedFenceValue: last fence value the GPU finished
+  void BeginFrame(uint64_t completedFenceValue);
+  // fenceValue: value signaled after this frame's command lists
+  void EndFrame(uint64_t fenceValue);
+
+  UploadAllocation Allocate(uint64_t size,
+                            uint64_t alignment = ConstantBufferAlignment);
+
+  // Allocate + copy, e.g. a per-draw constant block
+  template <typename T>
+  UploadAllocation Upload(const T &data,
+                          uint64_t alignment = ConstantBufferAlignment) {
+    UploadAllocation allocation = Allocate(sizeof(T), alignment);
+    if (allocation.IsValid())
+      memcpy(allocation.CPU, &data, sizeof(T));
+    return allocation;
+  }
+
+  RHIResource *GetBuffer() const { return m_Buffer.get(); }
+  const RingAllocatorStats &GetStats() const { return m_Allocator.GetStats(); }
+
+private:
+  std::unique_ptr<RHIResource> m_Buffer;
+  uint8_t *m_CPUBase = nullptr;
+  uint64_t m_GPUBase = 0;
+  RingAllocator m_Allocator;
+};
+
+} // namespace Forge
@@ -0,0 +1,822 @@
+#include "ClusteredLightCuller.h"
+#include "../Core/JobSystem.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Forge {
+
+// Slice boxes grow by this fraction of their depth, so a shader whose log
+// rounds a point into a neighboring slice still finds its lights there
+static constexpr float SliceDepthSlack = 1e-4f;
+// Coordinate of padding entries: never within any light's reach
+static constexpr float FarAway = 1e30f;
+// Spot cones wider than this half-angle have a differently placed sphere
+static constexpr float WideConeCos = 0.70710678f;
+
+// Grows without shrinking, so per-row scratch is not cleared every time
+template <typename T> static void GrowTo(std::vector<T> &vector, size_t size) {
+  if (vector.size() < size)
+    vector.resize(size);
+}
+
+// log2 from a float's exponent and mantissa: never above the true value
+// and under 0.09 below it (x >= 1)
+static float ApproximateLog2(float x) {
+  uint32_t bits = std::bit_cast<uint32_t>(x);
+  return (float)((int32_t)(bits >> 23) - 127) +
+         (float)(bits & 0x7fffff) * (1.0f / 8388608.0f);
+}
+
+#if defined(__AVX2__)
+// Set lanes of each 8-bit mask packed to the front, one lane index per byte
+static constexpr auto PackTable = [] {
+  std::array<uint64_t, 256> table{};
+  for (uint32_t mask = 0; mask < 256; mask++) {
+    uint32_t count = 0;
+    for (uint32_t lane = 0; lane < 8; lane++) {
+      if (mask & (1u << lane))
+        table[mask] |= (uint64_t)lane << (8 * count++);
+    }
+  }
+  return table;
+}();
+
+// Stores the lanes of values selected by mask contiguously at out
+static void StorePacked(float *out, __m256 values, uint32_t mask) {
+  __m256i permutation =
+      _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long)PackTable[mask]));
+  _mm256_storeu_ps(out, _mm256_permutevar8x32_ps(values, permutation));
+}
+static void StorePacked(uint32_t *out, const uint32_t *values,
+                        uint32_t mask) {
+  StorePacked((float *)out, _mm256_loadu_ps((const float *)values), mask);
+}
+#endif
+
+void ClusteredLightCuller::ViewLights::Resize(size_t size) {
+  for (std::vector<float> *array :
+       {&X, &Y, &Z, &Radius, &OriginX, &OriginY, &OriginZ, &DirectionX,
+        &DirectionY, &DirectionZ, &Range, &Cos, &Sin})
+    array->resize(size);
+  Cone.resize(size);
+  FirstSlice.resize(size);
+  LastSlice.resize(size);
+}
+
+void ClusteredLightCuller::ViewLights::Store(uint32_t index,
+                                             const ViewLight &light) {
+  X[index] = light.Center[0];
+  Y[index] = light.Center[1];
+  Z[index] = light.Center[2];
+  Radius[index] = light.Radius;
+  OriginX[index] = light.Origin[0];
+  OriginY[index] = light.Origin[1];
+  OriginZ[index] = light.Origin[2];
+  DirectionX[index] = light.Direction[0];
+  DirectionY[index] = light.Direction[1];
+  DirectionZ[index] = light.Direction[2];
+  Range[index] = light.Range;
+  Cos[index] = light.CosAngle;
+  Sin[index] = light.SinAngle;
+  Cone[index] = light.Cone ? ~0u : 0u;
+  FirstSlice[index] = light.FirstSlice;
+  LastSlice[index] = light.LastSlice;
+}
+
+ClusteredLightCuller::ViewLight
+ClusteredLightCuller::ViewLights::Load(uint32_t index) const {
+  ViewLight light;
+  light.Center[0] = X[index];
+  light.Center[1] = Y[index];
+  light.Center[2] = Z[index];
+  light.Radius = Radius[index];
+  light.Origin[0] = OriginX[index];
+  light.Origin[1] = OriginY[index];
+  light.Origin[2] = OriginZ[index];
+  light.Direction[0] = DirectionX[index];
+  light.Direction[1] = DirectionY[index];
+  light.Direction[2] = DirectionZ[index];
+  light.Range = Range[index];
+  light.CosAngle = Cos[index];
+  light.SinAngle = Sin[index];
+  light.Cone = Cone[index] != 0;
+  light.FirstSlice = FirstSlice[index];
+  light.LastSlice = LastSlice[index];
+  return light;
+}
+
+void ClusteredLightCuller::SetSettings(const ClusterGridSettings &settings) {
+  m_Settings = settings;
+  m_Settings.TileSize = std::max(m_Settings.TileSize, 1u);
+  m_Settings.DepthSlices = std::clamp(m_Settings.DepthSlices, 1u, 4096u);
+  m_GridDirty = true;
+}
+
+void ClusteredLightCuller::SetResolution(uint32_t width, uint32_t height) {
+  width = std::max(width, 1u);
+  height = std::max(height, 1u);
+  if (width != m_Width || height != m_Height)
+    m_GridDirty = true;
+  m_Width = width;
+  m_Height = height;
+}
+
+void ClusteredLightCuller::SetView(const float view[16], float fovY,
+                                   float nearZ, float farZ) {
+  std::copy(view, view + 16, m_View);
+  float tanHalfFovY = std::tan(fovY * 0.5f);
+  nearZ = std::max(nearZ, 1e-4f);
+  farZ = std::max(farZ, nearZ * 1.001f);
+  if (tanHalfFovY != m_TanHalfFovY || nearZ != m_Near || farZ != m_Far)
+    m_GridDirty = true;
+  m_TanHalfFovY = tanHalfFovY;
+  m_Near = nearZ;
+  m_Far = farZ;
+}
+
+void ClusteredLightCuller::UpdateGrid() {
+  m_GridDirty = false;
+  const uint32_t tileSize = m_Settings.TileSize;
+  const uint32_t slices = m_Settings.DepthSlices;
+  m_TilesX = (m_Width + tileSize - 1) / tileSize;
+  m_TilesY = (m_Height + tileSize - 1) / tileSize;
+
+  m_SliceScale = (float)slices / std::log2(m_Far / m_Near);
+  m_SliceDepths.resize(slices + 1);
+  for (uint32_t s = 0; s <= slices; s++)
+    m_SliceDepths[s] = m_Near * std::pow(m_Far / m_Near, (float)s / slices);
+
+  const float tanY = m_TanHalfFovY;
+  const float tanX = tanY * (float)m_Width / (float)m_Height;
+  auto setPlane = [&](int index, float x, float y, float z) {
+    float length = std::sqrt(x * x + y * y + z * z);
+    m_Planes[index][0] = x / length;
+    m_Planes[index][1] = y / length;
+    m_Planes[index][2] = z / length;
+  };
+  setPlane(0, 1.0f, 0.0f, tanX);  // left
+  setPlane(1, -1.0f, 0.0f, tanX); // right
+  setPlane(2, 0.0f, 1.0f, tanY);  // bottom
+  setPlane(3, 0.0f, -1.0f, tanY); // top
+
+  // A tile's side is a plane through the eye, so its extent is linear in
+  // depth and the slice's near and far depth bound it
+  m_ClusterBoxes.resize((size_t)m_TilesX * m_TilesY * slices);
+  m_RowBoxes.resize((size_t)m_TilesY * slices);
+  m_RowStride = (m_TilesX + 7) & ~7u;
+  m_ColumnMin.assign((size_t)m_RowStride * slices, FarAway);
+  m_ColumnMax.assign((size_t)m_RowStride * slices, FarAway);
+  const size_t sphereCount = (size_t)m_RowStride * m_TilesY * slices;
+  m_ClusterSpheres.X.assign(sphereCount, 0.0f);
+  m_ClusterSpheres.Y.assign(sphereCount, 0.0f);
+  m_ClusterSpheres.Z.assign(sphereCount, 0.0f);
+  m_ClusterSpheres.Radius.assign(sphereCount, 0.0f);
+  for (uint32_t s = 0; s < slices; s++) {
+    float z0 = m_SliceDepths[s] * (1.0f - SliceDepthSlack);
+    float z1 = m_SliceDepths[s + 1] * (1.0f + SliceDepthSlack);
+    auto lower = [&](float ndc, float tan) {
+      return std::min(ndc * z0, ndc * z1) * tan;
+    };
+    auto upper = [&](float ndc, float tan) {
+      return std::max(ndc * z0, ndc * z1) * tan;
+    };
+    for (uint32_t y = 0; y < m_TilesY; y++) {
+      // Pixel rows run down, view-space Y up
+      float top = 1.0f - 2.0f * (float)(y * tileSize) / m_Height;
+      float bottom =
+          1.0f - 2.0f * (float)std::min((y + 1) * tileSize, m_Height) /
+                     m_Height;
+      Box &row = m_RowBoxes[s * m_TilesY + y];
+      row = {{lower(-1.0f, tanX), lower(bottom, tanY), z0},
+             {upper(1.0f, tanX), upper(top, tanY), z1}};
+      for (uint32_t x = 0; x < m_TilesX; x++) {
+        float left = 2.0f * (float)(x * tileSize) / m_Width - 1.0f;
+        float right =
+            2.0f * (float)std::min((x + 1) * tileSize, m_Width) / m_Width -
+            1.0f;
+        size_t cluster = (s * m_TilesY + y) * m_TilesX + x;
+        Box &box = m_ClusterBoxes[cluster];
+        box = {{lower(left, tanX), row.Min[1], z0},
+               {upper(right, tanX), row.Max[1], z1}};
+        m_ColumnMin[s * m_RowStride + x] = box.Min[0];
+        m_ColumnMax[s * m_RowStride + x] = box.Max[0];
+        float half[3];
+        for (int c = 0; c < 3; c++)
+          half[c] = (box.Max[c] - box.Min[c]) * 0.5f;
+        size_t sphere = (s * m_TilesY + y) * m_RowStride + x;
+        m_ClusterSpheres.X[sphere] = box.Min[0] + half[0];
+        m_ClusterSpheres.Y[sphere] = box.Min[1] + half[1];
+        m_ClusterSpheres.Z[sphere] = box.Min[2] + half[2];
+        m_ClusterSpheres.Radius[sphere] = std::sqrt(
+            half[0] * half[0] + half[1] * half[1] + half[2] * half[2]);
+      }
+    }
+  }
+}
+
+// Exact against the slice boundaries: the log2 estimate (at most one slice
+// off at common settings) is corrected by comparisons
+uint32_t ClusteredLightCuller::GetSlice(float viewZ) const {
+  const int32_t last = (int32_t)m_Settings.DepthSlices - 1;
+  float log2 = ApproximateLog2(std::max(viewZ / m_Near, 1.0f));
+  int32_t slice = std::min((int32_t)(log2 * m_SliceScale), last);
+  while (slice > 0 && viewZ < m_SliceDepths[slice])
+    slice--;
+  while (slice < last && viewZ >= m_SliceDepths[slice + 1])
+    slice++;
+  return (uint32_t)slice;
+}
+
+uint32_t ClusteredLightCuller::GetClusterIndex(float pixelX, float pixelY,
+                                               float viewZ) const {
+  if (!(pixelX >= 0.0f && pixelX < (float)m_Width && pixelY >= 0.0f &&
+        pixelY < (float)m_Height && viewZ >= m_Near && viewZ <= m_Far))
+    return UINT32_MAX;
+  uint32_t x = (uint32_t)pixelX / m_Settings.TileSize;
+  uint32_t y = (uint32_t)pixelY / m_Settings.TileSize;
+  return (GetSlice(viewZ) * m_TilesY + y) * m_TilesX + x;
+}
+
+void ClusteredLightCuller::GetClusterBounds(uint32_t cluster,
+                                            float boundsMin[3],
+                                            float boundsMax[3]) const {
+  const Box &box = m_ClusterBoxes[cluster];
+  std::copy(box.Min, box.Min + 3, boundsMin);
+  std::copy(box.Max, box.Max + 3, boundsMax);
+}
+
+void ClusteredLightCuller::TransformLight(const ClusterLight &light,
+                                          ViewLight &out) const {
+  const float *m = m_View;
+  auto toView = [&](const float *p, bool point, float *result) {
+    for (int c = 0; c < 3; c++) {
+      result[c] = p[0] * m[c] + p[1] * m[4 + c] + p[2] * m[8 + c];
+      if (point)
+        result[c] += m[12 + c];
+    }
+  };
+
+  // Bounding sphere of a spot's cone (apex, rim and cap on the sphere for
+  // wide cones, rim on its equator for narrow ones)
+  out = {};
+  float center[3];
+  float radius = light.Range;
+  std::copy(light.Position, light.Position + 3, center);
+  out.Cone = light.Type == ClusterLightType::Spot && light.CosAngle > 0.0f;
+  if (out.Cone) {
+    float cosAngle = std::min(light.CosAngle, 1.0f);
+    float sinAngle = std::sqrt(1.0f - cosAngle * cosAngle);
+    float offset;
+    if (cosAngle < WideConeCos) {
+      offset = light.Range * cosAngle;
+      radius = light.Range * sinAngle;
+    } else {
+      offset = light.Range / (2.0f * cosAngle);
+      radius = offset;
+    }
+    for (int c = 0; c < 3; c++)
+      center[c] = light.Position[c] + light.Direction[c] * offset;
+    toView(light.Position, true, out.Origin);
+    toView(light.Direction, false, out.Direction);
+    out.CosAngle = cosAngle;
+    out.SinAngle = sinAngle;
+  }
+  toView(center, true, out.Center);
+  out.Radius = radius;
+  out.Range = light.Range;
+
+  const float x = out.Center[0], y = out.Center[1], z = out.Center[2];
+  bool visible = light.Range > 0.0f && z + radius >= m_Near &&
+                 z - radius <= m_Far;
+  for (int p = 0; p < 4; p++) {
+    visible = visible && m_Planes[p][0] * x + m_Planes[p][1] * y +
+                                 m_Planes[p][2] * z >=
+                             -radius;
+  }
+  out.FirstSlice = 1;
+  out.LastSlice = 0;
+  if (visible) {
+    out.FirstSlice = (int32_t)GetSlice(std::max(z - radius, m_Near));
+    out.LastSlice = (int32_t)GetSlice(std::min(z + radius, m_Far));
+  }
+}
+
+void ClusteredLightCuller::TransformLightsSIMD(const ClusterLight *lights,
+                                               uint32_t begin) {
+#if defined(__AVX2__)
+  // Same operation order as TransformLight
+  static_assert(sizeof(ClusterLight) % sizeof(float) == 0);
+  const __m256i stride =
+      _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                         _mm256_set1_epi32(sizeof(ClusterLight) / 4));
+  const ClusterLight *block = lights + begin;
+  auto field = [&](const float *member) {
+    return _mm256_i32gather_ps(member, stride, 4);
+  };
+  const __m256 position[3] = {field(&block->Position[0]),
+                              field(&block->Position[1]),
+                              field(&block->Position[2])};
+  const __m256 direction[3] = {field(&block->Direction[0]),
+                               field(&block->Direction[1]),
+                               field(&block->Direction[2])};
+  const __m256 range = field(&block->Range);
+  const __m256 cosine = field(&block->CosAngle);
+  alignas(32) uint32_t spots[8];
+  for (uint32_t lane = 0; lane < 8; lane++)
+    spots[lane] = block[lane].Type == ClusterLightType::Spot ? ~0u : 0u;
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 cone =
+      _mm256_and_ps(_mm256_load_ps((const float *)spots),
+                    _mm256_cmp_ps(cosine, zero, _CMP_GT_OQ));
+
+  const __m256 cosAngle = _mm256_min_ps(cosine, one);
+  const __m256 sinAngle = _mm256_sqrt_ps(
+      _mm256_max_ps(_mm256_sub_ps(one, _mm256_mul_ps(cosAngle, cosAngle)),
+                    zero));
+  const __m256 wide =
+      _mm256_cmp_ps(cosAngle, _mm256_set1_ps(WideConeCos), _CMP_LT_OQ);
+  const __m256 narrow =
+      _mm256_div_ps(range, _mm256_mul_ps(_mm256_set1_ps(2.0f), cosAngle));
+  const __m256 offset =
+      _mm256_blendv_ps(narrow, _mm256_mul_ps(range, cosAngle), wide);
+  const __m256 radius = _mm256_blendv_ps(
+      range, _mm256_blendv_ps(narrow, _mm256_mul_ps(range, sinAngle), wide),
+      cone);
+  __m256 center[3];
+  for (int c = 0; c < 3; c++) {
+    center[c] = _mm256_blendv_ps(
+        position[c],
+        _mm256_add_ps(position[c], _mm256_mul_ps(direction[c], offset)),
+        cone);
+  }
+
+  const float *m = m_View;
+  auto toView = [&](const __m256 *p, bool point, __m256 *result) {
+    for (int c = 0; c < 3; c++) {
+      __m256 sum = _mm256_add_ps(
+          _mm256_add_ps(_mm256_mul_ps(p[0], _mm256_set1_ps(m[c])),
+                        _mm256_mul_ps(p[1], _mm256_set1_ps(m[4 + c]))),
+          _mm256_mul_ps(p[2], _mm256_set1_ps(m[8 + c])));
+      result[c] = point ? _mm256_add_ps(sum, _mm256_set1_ps(m[12 + c])) : sum;
+    }
+  };
+  __m256 viewCenter[3], origin[3], axis[3];
+  toView(center, true, viewCenter);
+  toView(position, true, origin);
+  toView(direction, false, axis);
+
+  const __m256 z = viewCenter[2];
+  const __m256 nearZ = _mm256_set1_ps(m_Near), farZ = _mm256_set1_ps(m_Far);
+  __m256 visible = _mm256_and_ps(
+      _mm256_cmp_ps(range, zero, _CMP_GT_OQ),
+      _mm256_and_ps(
+          _mm256_cmp_ps(_mm256_add_ps(z, radius), nearZ, _CMP_GE_OQ),
+          _mm256_cmp_ps(_mm256_sub_ps(z, radius), farZ, _CMP_LE_OQ)));
+  const __m256 negativeRadius = _mm256_sub_ps(zero, radius);
+  for (int p = 0; p < 4; p++) {
+    __m256 distance = _mm256_add_ps(
+        _mm256_add_ps(
+            _mm256_mul_ps(_mm256_set1_ps(m_Planes[p][0]), viewCenter[0]),
+            _mm256_mul_ps(_mm256_set1_ps(m_Planes[p][1]), viewCenter[1])),
+        _mm256_mul_ps(_mm256_set1_ps(m_Planes[p][2]), z));
+    visible = _mm256_and_ps(
+        visible, _mm256_cmp_ps(distance, negativeRadius, _CMP_GE_OQ));
+  }
+
+  // GetSlice: the log2 estimate, then comparisons with the boundaries
+  const __m256i last = _mm256_set1_epi32((int32_t)m_Settings.DepthSlices - 1);
+  const float *depths = m_SliceDepths.data();
+  auto slice = [&](__m256 depth) {
+    __m256i bits =
+        _mm256_castps_si256(_mm256_max_ps(_mm256_div_ps(depth, nearZ), one));
+    __m256 log2 = _mm256_add_ps(
+        _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23),
+                                            _mm256_set1_epi32(127))),
+        _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(
+                          bits, _mm256_set1_epi32(0x7fffff))),
+                      _mm256_set1_ps(1.0f / 8388608.0f)));
+    __m256i index = _mm256_min_epi32(
+        _mm256_cvttps_epi32(_mm256_mul_ps(log2, _mm256_set1_ps(m_SliceScale))),
+        last);
+    for (;;) {
+      // All ones (-1) in lanes that step down
+      __m256i down = _mm256_and_si256(
+          _mm256_cmpgt_epi32(index, _mm256_setzero_si256()),
+          _mm256_castps_si256(_mm256_cmp_ps(
+              depth, _mm256_i32gather_ps(depths, index, 4), _CMP_LT_OQ)));
+      if (_mm256_testz_si256(down, down))
+        break;
+      index = _mm256_add_epi32(index, down);
+    }
+    for (;;) {
+      __m256i below = _mm256_cmpgt_epi32(last, index);
+      __m256i next =
+          _mm256_sub_epi32(index, below); // index + 1 where below last
+      __m256i up = _mm256_and_si256(
+          below, _mm256_castps_si256(_mm256_cmp_ps(
+                     depth, _mm256_i32gather_ps(depths, next, 4),
+                     _CMP_GE_OQ)));
+      if (_mm256_testz_si256(up, up))
+        break;
+      index = _mm256_sub_epi32(index, up);
+    }
+    return index;
+  };
+  const __m256i visibleMask = _mm256_castps_si256(visible);
+  const __m256i first = _mm256_blendv_epi8(
+      _mm256_set1_epi32(1),
+      slice(_mm256_max_ps(_mm256_sub_ps(z, radius), nearZ)), visibleMask);
+  const __m256i lastSlice = _mm256_and_si256(
+      slice(_mm256_min_ps(_mm256_add_ps(z, radius), farZ)), visibleMask);
+
+  // Cone fields are zero for other lights, as TransformLight leaves them
+  ViewLights &out = m_Lights;
+  auto store = [&](std::vector<float> &array, __m256 values) {
+    _mm256_storeu_ps(array.data() + begin, values);
+  };
+  store(out.X, viewCenter[0]);
+  store(out.Y, viewCenter[1]);
+  store(out.Z, z);
+  store(out.Radius, radius);
+  store(out.OriginX, _mm256_and_ps(origin[0], cone));
+  store(out.OriginY, _mm256_and_ps(origin[1], cone));
+  store(out.OriginZ, _mm256_and_ps(origin[2], cone));
+  store(out.DirectionX, _mm256_and_ps(axis[0], cone));
+  store(out.DirectionY, _mm256_and_ps(axis[1], cone));
+  store(out.DirectionZ, _mm256_and_ps(axis[2], cone));
+  store(out.Range, range);
+  store(out.Cos, _mm256_and_ps(cosAngle, cone));
+  store(out.Sin, _mm256_and_ps(sinAngle, cone));
+  _mm256_storeu_ps((float *)out.Cone.data() + begin, cone);
+  _mm256_storeu_si256((__m256i *)(out.FirstSlice.data() + begin), first);
+  _mm256_storeu_si256((__m256i *)(out.LastSlice.data() + begin), lastSlice);
+#else
+  for (uint32_t i = begin; i < begin + 8; i++) {
+    ViewLight light;
+    TransformLight(lights[i], light);
+    m_Lights.Store(i, light);
+  }
+#endif
+}
+
+// Squared distance from a point to a box, per axis max(min - p, p - max, 0)
+static float BoxDistanceSquared(const float *boxMin, const float *boxMax,
+                                float x, float y, float z) {
+  float dx = std::max(std::max(boxMin[0] - x, x - boxMax[0]), 0.0f);
+  float dy = std::max(std::max(boxMin[1] - y, y - boxMax[1]), 0.0f);
+  float dz = std::max(std::max(boxMin[2] - z, z - boxMax[2]), 0.0f);
+  return dx * dx + dy * dy + dz * dz;
+}
+
+uint32_t ClusteredLightCuller::FilterRow(uint32_t row,
+                                         RowLights &out) const {
+  const SliceLights &in = m_SliceLights;
+  const uint32_t slice = row / m_TilesY;
+  const uint32_t begin = m_SliceOffsets[slice];
+  const uint32_t end = m_SliceOffsets[slice + 1];
+  const Box &box = m_RowBoxes[row];
+  const size_t capacity = end - begin + 8;
+  GrowTo(out.X, capacity);
+  GrowTo(out.DY2, capacity);
+  GrowTo(out.DZ2, capacity);
+  GrowTo(out.Radius2, capacity);
+  GrowTo(out.Light, capacity);
+  GrowTo(out.Cone, capacity);
+
+  uint32_t count = 0;
+#if defined(__AVX2__)
+  if (m_UseSIMD) {
+    // Same operation order as BoxDistanceSquared
+    const __m256 zero = _mm256_setzero_ps();
+    auto axisDistance = [&](const std::vector<float> &axis, uint32_t i,
+                            int c) {
+      __m256 p = _mm256_loadu_ps(axis.data() + i);
+      __m256 d = _mm256_max_ps(
+          _mm256_max_ps(_mm256_sub_ps(_mm256_set1_ps(box.Min[c]), p),
+                        _mm256_sub_ps(p, _mm256_set1_ps(box.Max[c]))),
+          zero);
+      return _mm256_mul_ps(d, d);
+    };
+    for (uint32_t i = begin; i < end; i += 8) {
+      __m256 dx2 = axisDistance(in.X, i, 0);
+      __m256 dy2 = axisDistance(in.Y, i, 1);
+      __m256 dz2 = axisDistance(in.Z, i, 2);
+      __m256 radius = _mm256_loadu_ps(in.Radius.data() + i);
+      __m256 radius2 = _mm256_mul_ps(radius, radius);
+      uint32_t mask = (uint32_t)_mm256_movemask_ps(
+          _mm256_cmp_ps(_mm256_add_ps(_mm256_add_ps(dx2, dy2), dz2), radius2,
+                        _CMP_LE_OQ));
+      StorePacked(out.X.data() + count, _mm256_loadu_ps(in.X.data() + i),
+                  mask);
+      StorePacked(out.DY2.data() + count, dy2, mask);
+      StorePacked(out.DZ2.data() + count, dz2, mask);
+      StorePacked(out.Radius2.data() + count, radius2, mask);
+      StorePacked(out.Light.data() + count, in.Light.data() + i, mask);
+      StorePacked(out.Cone.data() + count, in.Cone.data() + i, mask);
+      count += (uint32_t)std::popcount(mask);
+    }
+  } else
+#endif
+  {
+    for (uint32_t i = begin; i < end; i++) {
+      float x = in.X[i], y = in.Y[i], z = in.Z[i];
+      float dx = std::max(std::max(box.Min[0] - x, x - box.Max[0]), 0.0f);
+      float dy = std::max(std::max(box.Min[1] - y, y - box.Max[1]), 0.0f);
+      float dz = std::max(std::max(box.Min[2] - z, z - box.Max[2]), 0.0f);
+      float radius2 = in.Radius[i] * in.Radius[i];
+      if (dx * dx + dy * dy + dz * dz > radius2)
+        continue;
+      out.X[count] = x;
+      out.DY2[count] = dy * dy;
+      out.DZ2[count] = dz * dz;
+      out.Radius2[count] = radius2;
+      out.Light[count] = in.Light[i];
+      out.Cone[count] = in.Cone[i];
+      count++;
+    }
+  }
+
+  // Padding for the 8-wide column tests
+  for (uint32_t i = count; i < count + 8; i++) {
+    out.X[i] = FarAway;
+    out.DY2[i] = out.DZ2[i] = out.Radius2[i] = 0.0f;
+    out.Light[i] = out.Cone[i] = 0;
+  }
+  return count;
+}
+
+// Cone against the cluster's bounding sphere: culled when the sphere lies
+// entirely outside the cone's angle, past its range or behind its apex
+bool ClusteredLightCuller::TestCone(const ViewLight &light,
+                                    uint32_t cluster) const {
+  const ClusterSpheres &spheres = m_ClusterSpheres;
+  const size_t sphere =
+      (size_t)(cluster / m_TilesX) * m_RowStride + cluster % m_TilesX;
+  const float sphereRadius = spheres.Radius[sphere];
+  float v[3] = {spheres.X[sphere] - light.Origin[0],
+                spheres.Y[sphere] - light.Origin[1],
+                spheres.Z[sphere] - light.Origin[2]};
+  float lengthSquared = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+  float along = v[0] * light.Direction[0] + v[1] * light.Direction[1] +
+                v[2] * light.Direction[2];
+  float across = std::sqrt(std::max(lengthSquared - along * along, 0.0f));
+  float closest = light.CosAngle * across - along * light.SinAngle;
+  return closest <= sphereRadius && along <= sphereRadius + light.Range &&
+         along >= -sphereRadius;
+}
+
+uint32_t ClusteredLightCuller::TestConeSIMD(uint32_t light,
+                                            size_t sphere) const {
+#if defined(__AVX2__)
+  // Same operation order as TestCone
+  const ViewLights &lights = m_Lights;
+  const ClusterSpheres &spheres = m_ClusterSpheres;
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 sphereRadius = _mm256_loadu_ps(spheres.Radius.data() + sphere);
+  __m256 v[3] = {
+      _mm256_sub_ps(_mm256_loadu_ps(spheres.X.data() + sphere),
+                    _mm256_set1_ps(lights.OriginX[light])),
+      _mm256_sub_ps(_mm256_loadu_ps(spheres.Y.data() + sphere),
+                    _mm256_set1_ps(lights.OriginY[light])),
+      _mm256_sub_ps(_mm256_loadu_ps(spheres.Z.data() + sphere),
+                    _mm256_set1_ps(lights.OriginZ[light]))};
+  __m256 lengthSquared = _mm256_add_ps(
+      _mm256_add_ps(_mm256_mul_ps(v[0], v[0]), _mm256_mul_ps(v[1], v[1])),
+      _mm256_mul_ps(v[2], v[2]));
+  __m256 along = _mm256_add_ps(
+      _mm256_add_ps(
+          _mm256_mul_ps(v[0], _mm256_set1_ps(lights.DirectionX[light])),
+          _mm256_mul_ps(v[1], _mm256_set1_ps(lights.DirectionY[light]))),
+      _mm256_mul_ps(v[2], _mm256_set1_ps(lights.DirectionZ[light])));
+  __m256 across = _mm256_sqrt_ps(_mm256_max_ps(
+      _mm256_sub_ps(lengthSquared, _mm256_mul_ps(along, along)), zero));
+  __m256 closest =
+      _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(lights.Cos[light]), across),
+                    _mm256_mul_ps(along, _mm256_set1_ps(lights.Sin[light])));
+  __m256 inside = _mm256_and_ps(
+      _mm256_cmp_ps(closest, sphereRadius, _CMP_LE_OQ),
+      _mm256_and_ps(
+          _mm256_cmp_ps(
+              along,
+              _mm256_add_ps(sphereRadius, _mm256_set1_ps(lights.Range[light])),
+              _CMP_LE_OQ),
+          _mm256_cmp_ps(along, _mm256_sub_ps(zero, sphereRadius),
+                        _CMP_GE_OQ)));
+  return (uint32_t)_mm256_movemask_ps(inside);
+#else
+  (void)light;
+  (void)sphere;
+  return 0;
+#endif
+}
+
+bool ClusteredLightCuller::TestLight(const ClusterLight &light,
+                                     uint32_t cluster) const {
+  ViewLight viewLight;
+  TransformLight(light, viewLight);
+  int32_t slice = (int32_t)(cluster / (m_TilesX * m_TilesY));
+  if (slice < viewLight.FirstSlice || slice > viewLight.LastSlice)
+    return false;
+  const Box &box = m_ClusterBoxes[cluster];
+  const float *center = viewLight.Center;
+  if (BoxDistanceSquared(box.Min, box.Max, center[0], center[1],
+                         center[2]) > viewLight.Radius * viewLight.Radius)
+    return false;
+  return !viewLight.Cone || TestCone(viewLight, cluster);
+}
+
+// ParallelFor when a JobSystem is given, inline otherwise
+template <typename Function>
+static void ForEach(JobSystem *jobs, uint32_t count, uint32_t batchSize,
+                    const Function &function) {
+  if (jobs) {
+    jobs->ParallelFor(count, batchSize,
+                      [&](uint32_t begin, uint32_t end, uint32_t worker) {
+                        for (uint32_t i = begin; i < end; i++)
+                          function(i, worker);
+                      });
+  } else {
+    for (uint32_t i = 0; i < count; i++)
+      function(i, 0u);
+  }
+}
+
+void ClusteredLightCuller::Cull(const ClusterLight *lights, uint32_t count,
+                                JobSystem *jobs) {
+  if (m_GridDirty)
+    UpdateGrid();
+  const uint32_t slices = m_Settings.DepthSlices;
+  const uint32_t rows = slices * m_TilesY;
+  m_Stats = {};
+  m_Stats.Lights = count;
+  m_Stats.Clusters = GetClusterCount();
+#if defined(__AVX2__)
+  m_Stats.SIMD = m_UseSIMD;
+#endif
+
+  // 1. View-space bounds, frustum test and slice range of every light, in
+  // blocks of 8 (the remainder one at a time)
+  m_Lights.Resize(count);
+  const uint32_t blocks = m_UseSIMD ? count / 8 : 0;
+  ForEach(jobs, blocks, 32, [&](uint32_t block, uint32_t) {
+    TransformLightsSIMD(lights, block * 8);
+  });
+  for (uint32_t i = blocks * 8; i < count; i++) {
+    ViewLight light;
+    TransformLight(lights[i], light);
+    m_Lights.Store(i, light);
+  }
+
+  // 2. Bin the lights into the slices they span (in light order, so each
+  // cluster's list comes out sorted)
+  const std::vector<int32_t> &firstSlices = m_Lights.FirstSlice;
+  const std::vector<int32_t> &lastSlices = m_Lights.LastSlice;
+  m_SliceOffsets.assign(slices + 1, 0);
+  for (uint32_t i = 0; i < count; i++) {
+    m_Stats.VisibleLights += firstSlices[i] <= lastSlices[i] ? 1 : 0;
+    for (int32_t s = firstSlices[i]; s <= lastSlices[i]; s++)
+      m_SliceOffsets[s + 1]++;
+  }
+  for (uint32_t s = 0; s < slices; s++) {
+    m_SliceOffsets[s + 1] =
+        m_SliceOffsets[s] + ((m_SliceOffsets[s + 1] + 7) & ~7u);
+  }
+  const uint32_t binned = m_SliceOffsets[slices];
+  m_SliceLights.X.assign(binned, FarAway);
+  m_SliceLights.Y.assign(binned, FarAway);
+  m_SliceLights.Z.assign(binned, FarAway);
+  m_SliceLights.Radius.assign(binned, 0.0f);
+  m_SliceLights.Light.assign(binned, 0);
+  m_SliceLights.Cone.assign(binned, 0);
+  m_SliceCursors.assign(m_SliceOffsets.begin(), m_SliceOffsets.end() - 1);
+  for (uint32_t i = 0; i < count; i++) {
+    for (int32_t s = firstSlices[i]; s <= lastSlices[i]; s++) {
+      uint32_t slot = m_SliceCursors[s]++;
+      m_SliceLights.X[slot] = m_Lights.X[i];
+      m_SliceLights.Y[slot] = m_Lights.Y[i];
+      m_SliceLights.Z[slot] = m_Lights.Z[i];
+      m_SliceLights.Radius[slot] = m_Lights.Radius[i];
+      m_SliceLights.Light[slot] = i;
+      m_SliceLights.Cone[slot] = m_Lights.Cone[i];
+    }
+  }
+
+  // 3. Per row of clusters: row box, then each cluster's box
+  m_Scratch.resize(jobs ? jobs->GetThreadCount() : 1);
+  m_Ranges.resize(GetClusterCount());
+  m_RowIndices.resize(rows);
+  ForEach(jobs, rows, 1,
+          [&](uint32_t row, uint32_t worker) { CullRow(row, worker); });
+
+  // 4. Concatenate the rows
+  m_RowOffsets.resize(rows + 1);
+  m_RowOffsets[0] = 0;
+  for (uint32_t row = 0; row < rows; row++) {
+    m_RowOffsets[row + 1] =
+        m_RowOffsets[row] + (uint32_t)m_RowIndices[row].size();
+  }
+  m_Indices.resize(m_RowOffsets[rows]);
+  ForEach(jobs, rows, 8, [&](uint32_t row, uint32_t) {
+    const std::vector<uint32_t> &indices = m_RowIndices[row];
+    std::copy(indices.begin(), indices.end(),
+              m_Indices.begin() + m_RowOffsets[row]);
+    LightClusterRange *ranges = m_Ranges.data() + (size_t)row * m_TilesX;
+    for (uint32_t x = 0; x < m_TilesX; x++)
+      ranges[x].Offset += m_RowOffsets[row];
+  });
+
+  m_Stats.Indices = (uint32_t)m_Indices.size();
+  for (const LightClusterRange &range : m_Ranges) {
+    m_Stats.OccupiedClusters += range.Count > 0 ? 1 : 0;
+    m_Stats.MaxClusterLights = std::max(m_Stats.MaxClusterLights, range.Count);
+  }
+}
+
+void ClusteredLightCuller::CullRow(uint32_t row, uint32_t workerIndex) {
+  RowScratch &scratch = m_Scratch[workerIndex];
+  const RowLights &lights = scratch.Lights;
+  const uint32_t count = FilterRow(row, scratch.Lights);
+  const uint32_t tiles = m_TilesX;
+  // Each cluster's list gets room for every light of the row, plus the
+  // slot the branch-free SIMD append overwrites; lights are appended in
+  // light order
+  const size_t room = (size_t)count + 1;
+  scratch.Counts.assign(m_RowStride, 0);
+  GrowTo(scratch.Indices, room * m_RowStride);
+  uint32_t *indices = scratch.Indices.data();
+  uint32_t *counts = scratch.Counts.data();
+
+  // The row's y and z distances hold for each of its clusters
+  const Box *boxes = m_ClusterBoxes.data() + (size_t)row * tiles;
+#if defined(__AVX2__)
+  if (m_UseSIMD) {
+    // 8 clusters at a time, same operation order as TestLight
+    const uint32_t stride = m_RowStride;
+    const float *columnMin = m_ColumnMin.data() + row / m_TilesY * stride;
+    const float *columnMax = m_ColumnMax.data() + row / m_TilesY * stride;
+    const size_t sphereBase = (size_t)row * stride;
+    const __m256 zero = _mm256_setzero_ps();
+    for (uint32_t i = 0; i < count; i++) {
+      const uint32_t light = lights.Light[i];
+      const __m256 p = _mm256_set1_ps(lights.X[i]);
+      const __m256 dy2 = _mm256_set1_ps(lights.DY2[i]);
+      const __m256 dz2 = _mm256_set1_ps(lights.DZ2[i]);
+      const __m256 radius2 = _mm256_set1_ps(lights.Radius2[i]);
+      const bool cone = lights.Cone[i] != 0;
+      for (uint32_t x = 0; x < tiles; x += 8) {
+        __m256 d = _mm256_max_ps(
+            _mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(columnMin + x), p),
+                          _mm256_sub_ps(p, _mm256_loadu_ps(columnMax + x))),
+            zero);
+        __m256 distance =
+            _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(d, d), dy2), dz2);
+        uint32_t mask = (uint32_t)_mm256_movemask_ps(
+            _mm256_cmp_ps(distance, radius2, _CMP_LE_OQ));
+        if (cone)
+          mask &= TestConeSIMD(light, sphereBase + x);
+        // Written to all 8 clusters, kept where the count moves
+        for (uint32_t lane = 0; lane < 8; lane++) {
+          indices[(x + lane) * room + counts[x + lane]] = light;
+          counts[x + lane] += (mask >> lane) & 1;
+        }
+      }
+    }
+  } else
+#endif
+  {
+    for (uint32_t i = 0; i < count; i++) {
+      const uint32_t light = lights.Light[i];
+      const float p = lights.X[i];
+      ViewLight cone;
+      if (lights.Cone[i])
+        cone = m_Lights.Load(light);
+      for (uint32_t x = 0; x < tiles; x++) {
+        float d = std::max(
+            std::max(boxes[x].Min[0] - p, p - boxes[x].Max[0]), 0.0f);
+        if (d * d + lights.DY2[i] + lights.DZ2[i] > lights.Radius2[i])
+          continue;
+        if (lights.Cone[i] && !TestCone(cone, row * tiles + x))
+          continue;
+        indices[x * room + counts[x]++] = light;
+      }
+    }
+  }
+
+  LightClusterRange *ranges = m_Ranges.data() + (size_t)row * tiles;
+  std::vector<uint32_t> &out = m_RowIndices[row];
+  out.clear();
+  for (uint32_t x = 0; x < tiles; x++) {
+    ranges[x].Offset = (uint32_t)out.size();
+    ranges[x].Count = counts[x];
+    out.insert(out.end(), indices + x * room, indices + x * room + counts[x]);
+  }
+}
+
+} // namespace Forge
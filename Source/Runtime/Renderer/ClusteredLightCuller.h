@@ -0,0 +1,200 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Forge {
+
+class JobSystem;
+
+enum class ClusterLightType : uint8_t { Point, Spot };
+
+// One punctual light in world space
+struct ClusterLight {
+  float Position[3];
+  float Range;        // influence radius (point) or cone length (spot)
+  float Direction[3]; // spot axis, normalized
+  float CosAngle;     // cosine of the spot's outer half-angle
+  ClusterLightType Type = ClusterLightType::Point;
+};
+
+// A cluster's part of the index list (GPU layout: uint2)
+struct LightClusterRange {
+  uint32_t Offset;
+  uint32_t Count;
+};
+
+struct ClusterGridSettings {
+  uint32_t TileSize = 64;    // cluster width and height in pixels
+  uint32_t DepthSlices = 24; // exponential from the near to the far plane
+};
+
+struct ClusterCullStats {
+  uint32_t Lights = 0;
+  uint32_t VisibleLights = 0; // touching the view frustum
+  uint32_t Clusters = 0;
+  uint32_t OccupiedClusters = 0;
+  uint32_t Indices = 0;
+  uint32_t MaxClusterLights = 0;
+  bool SIMD = false;
+};
+
+// Clustered light assignment on the CPU. The view frustum is split into
+// TileSize x TileSize pixel columns and DepthSlices exponential depth
+// slices; each cluster gets the list of lights whose bounds touch its
+// view-space box, so a pixel shades with the lights of one cluster:
+//
+//   slice   = floor(log(viewZ / near) / log(far / near) * DepthSlices)
+//   cluster = (slice * TilesY + pixelY / TileSize) * TilesX
+//             + pixelX / TileSize
+//   ranges[cluster] = {offset, count} into the light index list
+//
+// Lights are transformed to view space and bounded by a sphere (a spot
+// light by its cone's bounding sphere), frustum culled and binned into the
+// depth slices they span. Every row of clusters in a slice then keeps the
+// slice's lights that touch the row's box, and each cluster of the row
+// tests those against its own box; spot lights that pass are also tested
+// as a cone against the cluster's bounding sphere. With AVX2 the row
+// filter runs 8 lights at a time and the cluster tests 8 clusters of the
+// row at a time. Rows run in parallel on the JobSystem and write their
+// lists in cluster order, so results do not depend on the thread count.
+//
+// Light indices refer to the array given to Cull, which is what the
+// shader's light buffer is expected to hold. View space follows
+// DirectXMath (left-handed, +Z forward).
+class ClusteredLightCuller {
+public:
+  void SetSettings(const ClusterGridSettings &settings);
+  const ClusterGridSettings &GetSettings() const { return m_Settings; }
+  // Render target size in pixels
+  void SetResolution(uint32_t width, uint32_t height);
+  // view: row-major, row vectors (DirectXMath). fovY in radians.
+  void SetView(const float view[16], float fovY, float nearZ, float farZ);
+  // Forces the scalar path (comparisons); ignored without AVX2
+  void SetUseSIMD(bool useSIMD) { m_UseSIMD = useSIMD; }
+
+  // jobs may be null
+  void Cull(const ClusterLight *lights, uint32_t count, JobSystem *jobs);
+
+  // Grid of the last Cull
+  uint32_t GetTilesX() const { return m_TilesX; }
+  uint32_t GetTilesY() const { return m_TilesY; }
+  uint32_t GetDepthSlices() const { return m_Settings.DepthSlices; }
+  uint32_t GetClusterCount() const {
+    return m_TilesX * m_TilesY * m_Settings.DepthSlices;
+  }
+  // Cluster of a pixel at a view-space depth (UINT32_MAX outside the grid)
+  uint32_t GetClusterIndex(float pixelX, float pixelY, float viewZ) const;
+  // View-space box of a cluster
+  void GetClusterBounds(uint32_t cluster, float boundsMin[3],
+                        float boundsMax[3]) const;
+  // The test the last Cull applied to a light and cluster (validation)
+  bool TestLight(const ClusterLight &light, uint32_t cluster) const;
+
+  // Upload-ready results of the last Cull
+  const std::vector<LightClusterRange> &GetClusterRanges() const {
+    return m_Ranges;
+  }
+  const std::vector<uint32_t> &GetLightIndices() const { return m_Indices; }
+  const ClusterCullStats &GetStats() const { return m_Stats; }
+
+private:
+  struct Box {
+    float Min[3];
+    float Max[3];
+  };
+
+  // A light in view space
+  struct ViewLight {
+    float Center[3]; // bounding sphere
+    float Radius;
+    float Origin[3]; // spot cone
+    float Direction[3];
+    float Range;
+    float CosAngle;
+    float SinAngle;
+    bool Cone; // spot with a half-angle under 90 degrees
+    // Slices the sphere spans (none when first > last: outside the view)
+    int32_t FirstSlice;
+    int32_t LastSlice;
+  };
+
+  // Every light of the current Cull, structure of arrays
+  struct ViewLights {
+    std::vector<float> X, Y, Z, Radius;
+    std::vector<float> OriginX, OriginY, OriginZ;
+    std::vector<float> DirectionX, DirectionY, DirectionZ;
+    std::vector<float> Range, Cos, Sin;
+    std::vector<uint32_t> Cone; // ~0u: also test the spot's cone
+    std::vector<int32_t> FirstSlice, LastSlice;
+    void Resize(size_t size);
+    void Store(uint32_t index, const ViewLight &light);
+    ViewLight Load(uint32_t index) const;
+  };
+  // Lights binned per slice, each slice padded to 8
+  struct SliceLights {
+    std::vector<float> X, Y, Z, Radius;
+    std::vector<uint32_t> Light, Cone;
+  };
+  // A slice's lights that touch one row of clusters, with their squared
+  // distances to the row along y and z (the same for all its clusters)
+  struct RowLights {
+    std::vector<float> X, DY2, DZ2, Radius2;
+    std::vector<uint32_t> Light, Cone;
+  };
+  struct RowScratch {
+    RowLights Lights;
+    std::vector<uint32_t> Counts;  // per cluster of the row
+    std::vector<uint32_t> Indices; // per cluster, room for every row light
+  };
+  // Bounding spheres of the clusters, row * m_RowStride + x
+  struct ClusterSpheres {
+    std::vector<float> X, Y, Z, Radius;
+  };
+
+  void UpdateGrid();
+  uint32_t GetSlice(float viewZ) const;
+  void TransformLight(const ClusterLight &light, ViewLight &out) const;
+  // Lights [begin, begin + 8) into m_Lights
+  void TransformLightsSIMD(const ClusterLight *lights, uint32_t begin);
+  // Lights of the row's slice that touch the row's box (count, padded)
+  uint32_t FilterRow(uint32_t row, RowLights &out) const;
+  bool TestCone(const ViewLight &light, uint32_t cluster) const;
+  // TestCone for the 8 clusters from a sphere index: a lane mask
+  uint32_t TestConeSIMD(uint32_t light, size_t sphere) const;
+  void CullRow(uint32_t row, uint32_t workerIndex);
+
+  ClusterGridSettings m_Settings;
+  uint32_t m_Width = 1920, m_Height = 1080;
+  float m_View[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+  float m_TanHalfFovY = 0.57735f;
+  float m_Near = 0.1f, m_Far = 1000.0f;
+  bool m_UseSIMD = true;
+
+  // Grid, rebuilt when the resolution, settings or projection change
+  bool m_GridDirty = true;
+  uint32_t m_TilesX = 0, m_TilesY = 0;
+  float m_SliceScale = 0.0f; // DepthSlices / log2(far / near)
+  std::vector<float> m_SliceDepths; // DepthSlices + 1 boundaries
+  std::vector<Box> m_ClusterBoxes;
+  std::vector<Box> m_RowBoxes;     // slice * TilesY + y
+  uint32_t m_RowStride = 0;        // TilesX rounded up to 8
+  std::vector<float> m_ColumnMin;  // box x bounds, slice * m_RowStride + x
+  std::vector<float> m_ColumnMax;  // (padding lanes out of every reach)
+  ClusterSpheres m_ClusterSpheres;
+  float m_Planes[4][3] = {};       // side planes through the eye, inward
+
+  ViewLights m_Lights;
+  std::vector<uint32_t> m_SliceOffsets; // into m_SliceLights, per slice
+  std::vector<uint32_t> m_SliceCursors;
+  SliceLights m_SliceLights;
+  std::vector<RowScratch> m_Scratch; // per worker
+  std::vector<std::vector<uint32_t>> m_RowIndices;
+  std::vector<uint32_t> m_RowOffsets; // into m_Indices
+
+  std::vector<LightClusterRange> m_Ranges;
+  std::vector<uint32_t> m_Indices;
+  ClusterCullStats m_Stats;
+};
+
+} // namespace Forge
@@ -1,4 +1,8 @@
 #include "DX12Context.h"
+#include "../Core/JobSystem.h"
+#include "../Core/Profiler.h"
+#include "HLSLCompiler.h"
+#include <algorithm>
 #include <d3dcompiler.h>
 #include <iostream>
 #include <stdexcept>
@@ -9,8 +13,16 @@
 
 namespace Forge {
 
-DX12Context::DX12Context(void *windowHandle, int width, int height)
-    : m_WindowHandle(windowHandle), m_Width(width), m_Height(height) {}
+static constexpr uint64_t UploadRingSize = 8 * 1024 * 1024;
+static constexpr uint64_t StaticUploadStagingSize = 32 * 1024 * 1024;
+static constexpr const char *ShaderCacheDirectory = "ShaderCache";
+static constexpr uint64_t ShaderCacheBudget = 64 * 1024 * 1024;
+
+DX12Context::DX12Context(void *windowHandle, int width, int height,
+                         uint32_t framesInFlight)
+    : m_WindowHandle(windowHandle), m_Width(width), m_Height(height),
+      m_FramesInFlight(std::clamp(framesInFlight, 1u, MaxFramesInFlight)),
+      m_BackBufferCount(std::max(m_FramesInFlight, 2u)) {}
 
 DX12Context::~DX12Context() { CleanUp(); }
 
@@ -41,19 +53,18 @@ bool DX12Context::Initialize() {
   }
   std::cout << "[DX12] Device Created" << std::endl;
 
+  m_RHIDevice = std::make_unique<DX12RHIDevice>(m_Device.Get());
+
   // 4. Create Command Queue
-  D3D12_COMMAND_QUEUE_DESC queueDesc = {};
-  queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
-  queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
-  if (FAILED(m_Device->CreateCommandQueue(&queueDesc,
-                                          IID_PPV_ARGS(&m_CommandQueue)))) {
+  m_CommandQueue = m_RHIDevice->CreateCommandQueue(RHIQueueType::Direct);
+  if (!m_CommandQueue) {
     std::cout << "[DX12] Failed to create Command Queue" << std::endl;
     return false;
   }
 
   // 5. Create Swap Chain
   DXGI_SWAP_CHAIN_DESC1 swapChainDesc = {};
-  swapChainDesc.BufferCount = FrameCount;
+  swapChainDesc.BufferCount = m_BackBufferCount;
   swapChainDesc.Width = m_Width;
   swapChainDesc.Height = m_Height;
   swapChainDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
@@ -63,60 +74,64 @@ bool DX12Context::Initialize() {
 
   ComPtr<IDXGISwapChain1> swapChain;
   if (FAILED(factory->CreateSwapChainForHwnd(
-          m_CommandQueue.Get(), static_cast<HWND>(m_WindowHandle),
-          &swapChainDesc, nullptr, nullptr, &swapChain))) {
+          DX12RHIDevice::GetNative(m_CommandQueue.get()),
+          static_cast<HWND>(m_WindowHandle), &swapChainDesc, nullptr, nullptr,
+          &swapChain))) {
     std::cout << "[DX12] Failed to create Swap Chain" << std::endl;
     return false;
   }
 
   swapChain.As(&m_SwapChain);
-  m_FrameIndex = m_SwapChain->GetCurrentBackBufferIndex();
+  m_BackBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
   std::cout << "[DX12] Swap Chain Created" << std::endl;
 
   // 6. Create Descriptor Heaps
-  {
-    D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
-    rtvHeapDesc.NumDescriptors = FrameCount;
-    rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-    rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-    if (FAILED(m_Device->CreateDescriptorHeap(&rtvHeapDesc,
-                                              IID_PPV_ARGS(&m_RtvHeap))))
-      return false;
-    m_RtvDescriptorSize = m_Device->GetDescriptorHandleIncrementSize(
-        D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
-  }
+  m_RtvHeap = m_RHIDevice->CreateDescriptorHeap(
+      {RHIDescriptorHeapType::RTV, m_BackBufferCount, false});
+  if (!m_RtvHeap)
+    return false;
 
-  {
-    // Increased to 64 to be safe for ImGui or other resources
-    D3D12_DESCRIPTOR_HEAP_DESC srvHeapDesc = {};
-    srvHeapDesc.NumDescriptors = 64;
-    srvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    srvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-    if (FAILED(m_Device->CreateDescriptorHeap(&srvHeapDesc,
-                                              IID_PPV_ARGS(&m_SrvHeap))))
-      return false;
-  }
+  if (!m_Descriptors.Initialize(m_RHIDevice.get(), {}))
+    return false;
+  m_ImGuiFontSrv = m_Descriptors.AllocatePersistent();
   std::cout << "[DX12] Descriptor Heaps Created" << std::endl;
 
   // 7. Create Frame Resources
   CreateRenderTarget();
 
-  if (FAILED(m_Device->CreateCommandAllocator(
-          D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_CommandAllocator))))
+  // 8. Per-frame Command Lists + Synchronization Objects
+  if (!m_FrameRing.Initialize(m_RHIDevice.get(), m_CommandQueue.get(),
+                              m_FramesInFlight))
     return false;
-
-  // 8. Create Command List
-  if (FAILED(m_Device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT,
-                                         m_CommandAllocator.Get(), nullptr,
-                                         IID_PPV_ARGS(&m_CommandList))))
+  // Lists opened after a fork start empty: restore the frame's back buffer
+  // target and shader-visible heap for whatever is recorded next (ImGui)
+  m_FrameRing.SetContinuationSetup([this](RHICommandList *commandList) {
+    RHICPUDescriptor rtvHandle = m_RtvHeap->GetCPU(m_BackBufferIndex);
+    commandList->SetRenderTargets(&rtvHandle, 1, nullptr);
+    RHIDescriptorHeap *descriptorHeaps[] = {m_Descriptors.GetHeap()};
+    commandList->SetDescriptorHeaps(descriptorHeaps, 1);
+  });
+  m_Recorder.Initialize(&m_FrameRing, &JobSystem::Get());
+
+  // 9. Upload Ring (shared by every frame in flight)
+  if (!m_UploadRing.Initialize(m_RHIDevice.get(), UploadRingSize))
     return false;
-  m_CommandList->Close();
-
-  // 9. Create Synchronization Objects
-  if (FAILED(m_Device->CreateFence(0, D3D12_FENCE_FLAG_NONE,
-                                   IID_PPV_ARGS(&m_Fence))))
+  // Static data to DEFAULT heaps on the copy queue
+  if (!m_Uploads.Initialize(m_RHIDevice.get(), StaticUploadStagingSize))
     return false;
-  m_FenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+  m_RenderGraph.Initialize(m_RHIDevice.get());
+  // Optional: without timestamps the scopes are no-ops
+  if (m_GPUProfiler.Initialize(m_RHIDevice.get(), m_CommandQueue.get(),
+                               m_FramesInFlight, "GPU: Direct Queue"))
+    m_RenderGraph.SetGPUProfiler(&m_GPUProfiler);
+
+  // 10. Shader / Pipeline Caches
+  m_ShaderCache.Initialize(ShaderCacheDirectory, ShaderCacheBudget,
+                           GetHLSLCompilerTag(), CompileHLSL);
+  m_PipelineCache.Initialize(m_RHIDevice.get(),
+                             std::string(ShaderCacheDirectory) +
+                                 "/Pipelines.bin");
+  m_ShaderHotReload.Initialize(&m_ShaderCache, &m_PipelineCache);
   std::cout
       << "[DX12] Synchronization Objects Created. Initialization Complete."
       << std::endl;
@@ -125,80 +140,91 @@ bool DX12Context::Initialize() {
 }
 
 void DX12Context::CleanUp() {
-  if (m_CommandQueue && m_Fence) {
-    WaitForPreviousFrame();
-  }
-  CloseHandle(m_FenceEvent);
+  // Waits for every frame still in flight
+  m_FrameRing.Shutdown();
+  m_Uploads.Shutdown();
+  m_UploadRing.Shutdown();
+  m_RenderGraph.Shutdown();
+  m_GPUProfiler.Shutdown();
+  m_ReleaseQueue.Shutdown();
+  // Saves the caches; PSOs are no longer referenced by any frame
+  m_ShaderHotReload.Shutdown();
+  m_PipelineCache.Shutdown();
+  m_ShaderCache.Shutdown();
+
+  // Release RHI objects before the device they were created from
+  for (auto &renderTarget : m_RenderTargets)
+    renderTarget.reset();
+  m_Descriptors.Shutdown();
+  m_RtvHeap.reset();
+  m_CommandQueue.reset();
+  m_RHIDevice.reset();
 }
 
 void DX12Context::CreateRenderTarget() {
-  D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle =
-      m_RtvHeap->GetCPUDescriptorHandleForHeapStart();
-  for (UINT i = 0; i < FrameCount; i++) {
-    m_SwapChain->GetBuffer(i, IID_PPV_ARGS(&m_RenderTargets[i]));
-    m_Device->CreateRenderTargetView(m_RenderTargets[i].Get(), nullptr,
-                                     rtvHandle);
-    rtvHandle.ptr += m_RtvDescriptorSize;
+  for (UINT i = 0; i < m_BackBufferCount; i++) {
+    ComPtr<ID3D12Resource> backBuffer;
+    m_SwapChain->GetBuffer(i, IID_PPV_ARGS(&backBuffer));
+    m_RenderTargets[i] = m_RHIDevice->WrapResource(
+        backBuffer.Get(), RHIResourceState::Present, "BackBuffer");
+    m_RHIDevice->CreateRenderTargetView(m_RenderTargets[i].get(),
+                                        m_RtvHeap->GetCPU(i));
   }
 }
 
 void DX12Context::BeginFrame() {
-  m_CommandAllocator->Reset();
-  m_CommandList->Reset(m_CommandAllocator.Get(), nullptr);
-
-  D3D12_RESOURCE_BARRIER barrier = {};
-  barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-  barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-  barrier.Transition.pResource = m_RenderTargets[m_FrameIndex].Get();
-  barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
-  barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-  barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-  m_CommandList->ResourceBarrier(1, &barrier);
-
-  D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle =
-      m_RtvHeap->GetCPUDescriptorHandleForHeapStart();
-  rtvHandle.ptr += (m_FrameIndex * m_RtvDescriptorSize);
-
-  m_CommandList->OMSetRenderTargets(1, &rtvHandle, FALSE, nullptr);
+  FORGE_PROFILE_SCOPE("DX12Context::BeginFrame");
+  // Between frames: swap in pipelines rebuilt since the last frame
+  m_ShaderHotReload.Update();
+
+  // Blocks only if the GPU is still N frames behind
+  RHICommandList *commandList = m_FrameRing.BeginFrame();
+  m_UploadRing.BeginFrame(m_FrameRing.GetCompletedFenceValue());
+  m_Descriptors.BeginFrame(m_FrameRing.GetCompletedFenceValue());
+  m_RenderGraph.BeginFrame(m_FrameRing.GetCompletedFenceValue());
+  m_ReleaseQueue.BeginFrame(m_FrameRing.GetCompletedFenceValue());
+  m_GPUProfiler.BeginFrame(m_FrameRing.GetCompletedFenceValue());
+  // Uploads the copy queue finished become usable from here on
+  m_Uploads.BeginFrame(commandList);
+
+  commandList->ResourceBarrier({m_RenderTargets[m_BackBufferIndex].get(),
+                               RHIResourceState::Present,
+                               RHIResourceState::RenderTarget});
+
+  RHICPUDescriptor rtvHandle = m_RtvHeap->GetCPU(m_BackBufferIndex);
+  commandList->SetRenderTargets(&rtvHandle, 1, nullptr);
 
   const float clearColor[] = {0.1f, 0.11f, 0.12f, 1.0f};
-  m_CommandList->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
+  commandList->ClearRenderTarget(rtvHandle, clearColor);
 
-  ID3D12DescriptorHeap *descriptorHeaps[] = {m_SrvHeap.Get()};
-  m_CommandList->SetDescriptorHeaps(1, descriptorHeaps);
+  RHIDescriptorHeap *descriptorHeaps[] = {m_Descriptors.GetHeap()};
+  commandList->SetDescriptorHeaps(descriptorHeaps, 1);
 }
 
 void DX12Context::EndFrame() {
-  D3D12_RESOURCE_BARRIER barrier = {};
-  barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-  barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-  barrier.Transition.pResource = m_RenderTargets[m_FrameIndex].Get();
-  barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-  barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
-  barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-  m_CommandList->ResourceBarrier(1, &barrier);
-
-  m_CommandList->Close();
-
-  ID3D12CommandList *ppCommandLists[] = {m_CommandList.Get()};
-  m_CommandQueue->ExecuteCommandLists(1, ppCommandLists);
+  FORGE_PROFILE_SCOPE("DX12Context::EndFrame");
+  GetCommandList()->ResourceBarrier({m_RenderTargets[m_BackBufferIndex].get(),
+                                     RHIResourceState::RenderTarget,
+                                     RHIResourceState::Present});
+
+  m_GPUProfiler.Resolve(GetCommandList(),
+                        m_FrameRing.GetCurrentFenceValue());
+
+  // Everything uploaded this frame goes out as one copy-queue batch
+  m_Uploads.Flush();
+  uint64_t fenceValue = m_FrameRing.Submit();
+  m_UploadRing.EndFrame(fenceValue);
+  m_Descriptors.EndFrame(fenceValue);
+  m_RenderGraph.EndFrame(fenceValue);
+  m_ReleaseQueue.EndFrame(fenceValue);
 
-  m_SwapChain->Present(1, 0);
-
-  WaitForPreviousFrame();
-}
-
-void DX12Context::WaitForPreviousFrame() {
-  const UINT64 fence = m_FenceValue;
-  m_CommandQueue->Signal(m_Fence.Get(), fence);
-  m_FenceValue++;
-
-  if (m_Fence->GetCompletedValue() < fence) {
-    m_Fence->SetEventOnCompletion(fence, m_FenceEvent);
-    WaitForSingleObject(m_FenceEvent, INFINITE);
+  {
+    FORGE_PROFILE_SCOPE("Present");
+    m_SwapChain->Present(1, 0);
   }
 
-  m_FrameIndex = m_SwapChain->GetCurrentBackBufferIndex();
+  // No GPU wait here: the next BeginFrame waits on its own slot's fence
+  m_BackBufferIndex = m_SwapChain->GetCurrentBackBufferIndex();
 }
 
 } // namespace Forge
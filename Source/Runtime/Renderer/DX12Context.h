@@ -1,7 +1,20 @@
 #pragma once
 
+#include "../RHI/DX12/DX12RHI.h"
+#include "../RHI/DeferredRelease.h"
+#include "../RHI/DescriptorAllocator.h"
+#include "../RHI/FrameContext.h"
+#include "../RHI/GPUProfiler.h"
+#include "../RHI/ParallelRecorder.h"
+#include "../RHI/PipelineCache.h"
+#include "../RHI/UploadManager.h"
+#include "../RHI/UploadRing.h"
+#include "RenderGraph.h"
+#include "ShaderCache.h"
+#include "ShaderHotReload.h"
 #include <d3d12.h>
 #include <dxgi1_4.h>
+#include <memory>
 #include <vector>
 #include <wrl/client.h>
 
@@ -12,7 +25,9 @@ namespace Forge {
 
 class DX12Context {
 public:
-  DX12Context(void *windowHandle, int width, int height);
+  // framesInFlight: how far the CPU may run ahead of the GPU (1..4)
+  DX12Context(void *windowHandle, int width, int height,
+              uint32_t framesInFlight = 2);
   ~DX12Context();
 
   bool Initialize();
@@ -20,44 +35,87 @@ public:
 
   void BeginFrame();
   void EndFrame();
+  // Blocks until every submitted frame and upload has completed on the GPU
+  void WaitIdle() {
+    m_FrameRing.WaitIdle();
+    m_Uploads.WaitIdle();
+  }
 
   ID3D12Device *GetDevice() const { return m_Device.Get(); }
-  ID3D12GraphicsCommandList *GetCommandList() const {
-    return m_CommandList.Get();
+  RHIDevice *GetRHIDevice() const { return m_RHIDevice.get(); }
+  RHICommandList *GetCommandList() const {
+    return m_FrameRing.GetCommandList();
+  }
+  uint32_t GetFramesInFlight() const { return m_FrameRing.GetFramesInFlight(); }
+  const FrameSyncStats &GetFrameSyncStats() const {
+    return m_FrameRing.GetStats();
   }
+  DescriptorAllocator *GetDescriptorAllocator() { return &m_Descriptors; }
+  UploadRing *GetUploadRing() { return &m_UploadRing; }
+  UploadManager *GetUploadManager() { return &m_Uploads; }
+  ShaderCache *GetShaderCache() { return &m_ShaderCache; }
+  PipelineCache *GetPipelineCache() { return &m_PipelineCache; }
+  ShaderHotReload *GetShaderHotReload() { return &m_ShaderHotReload; }
+  ParallelCommandRecorder *GetParallelRecorder() { return &m_Recorder; }
+  RenderGraph *GetRenderGraph() { return &m_RenderGraph; }
+  DeferredReleaseQueue *GetReleaseQueue() { return &m_ReleaseQueue; }
+  GPUProfiler *GetGPUProfiler() { return &m_GPUProfiler; }
 
   // ImGui needs these
-  ID3D12DescriptorHeap *GetSRVHeap() const { return m_SrvHeap.Get(); }
-  D3D12_CPU_DESCRIPTOR_HANDLE GetSRVDescriptorHandleStartCPU() const {
-    return m_SrvHeap->GetCPUDescriptorHandleForHeapStart();
+  ID3D12GraphicsCommandList *GetNativeCommandList() const {
+    return DX12RHIDevice::GetNative(GetCommandList());
+  }
+  ID3D12DescriptorHeap *GetSRVHeap() const {
+    return DX12RHIDevice::GetNative(m_Descriptors.GetHeap());
   }
-  D3D12_GPU_DESCRIPTOR_HANDLE GetSRVDescriptorHandleStartGPU() const {
-    return m_SrvHeap->GetGPUDescriptorHandleForHeapStart();
+  D3D12_CPU_DESCRIPTOR_HANDLE GetImGuiFontSRVCPU() const {
+    return {(SIZE_T)m_ImGuiFontSrv.CPU.Ptr};
+  }
+  D3D12_GPU_DESCRIPTOR_HANDLE GetImGuiFontSRVGPU() const {
+    return {m_ImGuiFontSrv.GPU.Ptr};
   }
 
 private:
   void CreateRenderTarget();
-  void WaitForPreviousFrame();
 
   void *m_WindowHandle;
   int m_Width;
   int m_Height;
 
-  static const int FrameCount = 2;
+  uint32_t m_FramesInFlight;
+  uint32_t m_BackBufferCount; // flip model needs at least 2
 
   ComPtr<ID3D12Device> m_Device;
-  ComPtr<ID3D12CommandQueue> m_CommandQueue;
   ComPtr<IDXGISwapChain3> m_SwapChain;
-  ComPtr<ID3D12DescriptorHeap> m_RtvHeap;
-  ComPtr<ID3D12DescriptorHeap> m_SrvHeap;
-  UINT m_RtvDescriptorSize;
-  ComPtr<ID3D12Resource> m_RenderTargets[FrameCount];
-  ComPtr<ID3D12CommandAllocator> m_CommandAllocator;
-  ComPtr<ID3D12GraphicsCommandList> m_CommandList;
-  ComPtr<ID3D12Fence> m_Fence;
-  UINT64 m_FenceValue = 0;
-  HANDLE m_FenceEvent;
-  UINT m_FrameIndex = 0;
+
+  // Everything past device / swap chain creation goes through the RHI
+  std::unique_ptr<DX12RHIDevice> m_RHIDevice;
+  std::unique_ptr<RHICommandQueue> m_CommandQueue;
+  std::unique_ptr<RHIDescriptorHeap> m_RtvHeap;
+  // Shader-visible CBV/SRV/UAV heap (persistent + per-frame ranges)
+  DescriptorAllocator m_Descriptors;
+  DescriptorRange m_ImGuiFontSrv;
+  std::unique_ptr<RHIResource> m_RenderTargets[MaxFramesInFlight];
+  // Per-frame command lists/allocators + fence values
+  FrameContextRing m_FrameRing;
+  // Splits large passes over forked command lists (one Execute per frame)
+  ParallelCommandRecorder m_Recorder;
+  // Per-frame constants / dynamic geometry
+  UploadRing m_UploadRing;
+  // Static geometry / textures, copied on their own queue
+  UploadManager m_Uploads;
+  // Scene view passes; owns the aliased transient targets
+  RenderGraph m_RenderGraph;
+  // Replaced resources (viewport resize) live until their frame completes
+  DeferredReleaseQueue m_ReleaseQueue;
+  // Compiled shaders + PSOs persisted across runs (warm start = no compile)
+  ShaderCache m_ShaderCache;
+  PipelineCache m_PipelineCache;
+  // Rebuilds pipelines off-thread when shader sources change
+  ShaderHotReload m_ShaderHotReload;
+  // Timestamp scopes on the direct queue (render graph passes, ImGui)
+  GPUProfiler m_GPUProfiler;
+  UINT m_BackBufferIndex = 0;
 };
 
 } // namespace Forge
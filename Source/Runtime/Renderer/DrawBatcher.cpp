@@ -0,0 +1,109 @@
+#include "DrawBatcher.h"
+#include <cstring>
+
+namespace Forge {
+
+void DrawBatcher::Reset() {
+  m_Keys.clear();
+  m_Transforms.clear();
+  m_Batches.clear();
+  m_Stats = {};
+}
+
+void DrawBatcher::Reserve(size_t count) {
+  m_Keys.reserve(count);
+  m_Transforms.reserve(count);
+}
+
+void DrawBatcher::Submit(uint32_t materialID, uint32_t meshID,
+                         const float world[16]) {
+  m_Keys.push_back(((uint64_t)materialID << 32) | meshID);
+  InstanceTransform &transform = m_Transforms.emplace_back();
+  memcpy(transform.World, world, sizeof(transform.World));
+}
+
+void DrawBatcher::RadixSort() {
+  const size_t count = m_Keys.size();
+  m_SortedKeys.assign(m_Keys.begin(), m_Keys.end());
+  m_Order.resize(count);
+  for (size_t i = 0; i < count; i++)
+    m_Order[i] = (uint32_t)i;
+  m_KeysTemp.resize(count);
+  m_OrderTemp.resize(count);
+
+  // All 8 byte histograms in one read of the keys
+  uint32_t histograms[8][256] = {};
+  for (uint64_t key : m_SortedKeys) {
+    for (int pass = 0; pass < 8; pass++)
+      histograms[pass][(key >> (pass * 8)) & 0xff]++;
+  }
+
+  for (int pass = 0; pass < 8; pass++) {
+    uint32_t *histogram = histograms[pass];
+    // Every key has the same byte here (typical: IDs are small): skip
+    uint32_t firstByte = (m_SortedKeys[0] >> (pass * 8)) & 0xff;
+    if (histogram[firstByte] == count)
+      continue;
+
+    uint32_t offset = 0;
+    for (int bucket = 0; bucket < 256; bucket++) {
+      uint32_t bucketCount = histogram[bucket];
+      histogram[bucket] = offset;
+      offset += bucketCount;
+    }
+    // Stable scatter
+    for (size_t i = 0; i < count; i++) {
+      uint64_t key = m_SortedKeys[i];
+      uint32_t dest = histogram[(key >> (pass * 8)) & 0xff]++;
+      m_KeysTemp[dest] = key;
+      m_OrderTemp[dest] = m_Order[i];
+    }
+    m_SortedKeys.swap(m_KeysTemp);
+    m_Order.swap(m_OrderTemp);
+    m_Stats.SortPasses++;
+  }
+}
+
+void DrawBatcher::Build() {
+  m_Batches.clear();
+  m_Stats.Items = m_Keys.size();
+  if (m_Keys.empty()) {
+    m_Order.clear();
+    return;
+  }
+
+  RadixSort();
+
+  const size_t count = m_SortedKeys.size();
+  uint64_t previousMaterial = UINT64_MAX;
+  uint64_t previousMesh = UINT64_MAX;
+  for (size_t i = 0; i < count;) {
+    uint64_t key = m_SortedKeys[i];
+    size_t end = i + 1;
+    while (end < count && m_SortedKeys[end] == key)
+      end++;
+
+    DrawBatch batch;
+    batch.MaterialID = (uint32_t)(key >> 32);
+    batch.MeshID = (uint32_t)(key & 0xffffffff);
+    batch.FirstInstance = (uint32_t)i;
+    batch.InstanceCount = (uint32_t)(end - i);
+    batch.MaterialChanged = batch.MaterialID != previousMaterial;
+    batch.MeshChanged = batch.MeshID != previousMesh;
+    m_Batches.push_back(batch);
+
+    m_Stats.MaterialChanges += batch.MaterialChanged;
+    m_Stats.MeshChanges += batch.MeshChanged;
+    previousMaterial = batch.MaterialID;
+    previousMesh = batch.MeshID;
+    i = end;
+  }
+  m_Stats.DrawCalls = m_Batches.size();
+}
+
+void DrawBatcher::PackInstances(InstanceTransform *dest) const {
+  for (size_t i = 0; i < m_Order.size(); i++)
+    dest[i] = m_Transforms[m_Order[i]];
+}
+
+} // namespace Forge
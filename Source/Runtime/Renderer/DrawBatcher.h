@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Forge {
+
+// Per-instance data as laid out in the instance vertex buffer (row-major
+// world matrix, DirectXMath convention)
+struct InstanceTransform {
+  float World[16];
+};
+
+// One DrawInstanced: instances [FirstInstance, FirstInstance + Count) of
+// the packed instance buffer
+struct DrawBatch {
+  uint32_t MaterialID;
+  uint32_t MeshID;
+  uint32_t FirstInstance;
+  uint32_t InstanceCount;
+  bool MaterialChanged; // bind material state before drawing
+  bool MeshChanged;     // bind mesh vertex/index buffers before drawing
+};
+
+struct DrawBatchStats {
+  uint64_t Items = 0;           // visible entities submitted
+  uint64_t DrawCalls = 0;       // batches
+  uint64_t MaterialChanges = 0; // state changes after sorting
+  uint64_t MeshChanges = 0;
+  uint32_t SortPasses = 0; // radix passes actually run (others skipped)
+};
+
+// Collects visible (material, mesh, transform) items, sorts them by a
+// 64-bit key (material in the high half: material changes cost more than
+// mesh rebinds) with an LSD radix sort, and emits one batch per run of
+// equal keys. Platform-neutral; the renderer records the batches.
+class DrawBatcher {
+public:
+  void Reset();
+  void Submit(uint32_t materialID, uint32_t meshID, const float world[16]);
+  void Reserve(size_t count);
+
+  // Sorts + builds batches. Call once after the last Submit.
+  void Build();
+  // Writes GetInstanceCount() transforms in batch order
+  void PackInstances(InstanceTransform *dest) const;
+
+  const std::vector<DrawBatch> &GetBatches() const { return m_Batches; }
+  uint32_t GetInstanceCount() const { return (uint32_t)m_Keys.size(); }
+  const DrawBatchStats &GetStats() const { return m_Stats; }
+
+private:
+  void RadixSort();
+
+  std::vector<uint64_t> m_Keys;
+  std::vector<InstanceTransform> m_Transforms; // submit order
+  std::vector<uint32_t> m_Order;               // sorted -> submit index
+
+  // Radix scratch (kept to avoid per-frame allocations)
+  std::vector<uint64_t> m_KeysTemp;
+  std::vector<uint64_t> m_SortedKeys;
+  std::vector<uint32_t> m_OrderTemp;
+
+  std::vector<DrawBatch> m_Batches;
+  DrawBatchStats m_Stats;
+};
+
+} // namespace Forge
@@ -0,0 +1,104 @@
+#include "HLSLCompiler.h"
+#include <algorithm>
+#include <d3dcompiler.h>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <sstream>
+#include <unordered_map>
+#include <wrl/client.h>
+
+#pragma comment(lib, "d3dcompiler.lib")
+
+using Microsoft::WRL::ComPtr;
+
+namespace Forge {
+
+namespace {
+
+// Resolves #include relative to the including file, then to the root
+// shader's directory, and records the path of every file it opens. The
+// contents live until the handler goes away (after D3DCompile returns).
+class RecordingInclude : public ID3DInclude {
+public:
+  RecordingInclude(const std::filesystem::path &rootDirectory,
+                   std::vector<std::string> &outIncludes)
+      : m_RootDirectory(rootDirectory), m_Includes(outIncludes) {}
+
+  HRESULT __stdcall Open(D3D_INCLUDE_TYPE, LPCSTR fileName,
+                         LPCVOID parentData, LPCVOID *outData,
+                         UINT *outBytes) override {
+    std::filesystem::path directory = m_RootDirectory;
+    auto parent = m_Directories.find(parentData);
+    if (parent != m_Directories.end())
+      directory = parent->second;
+
+    std::filesystem::path path = (directory / fileName).lexically_normal();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      path = (m_RootDirectory / fileName).lexically_normal();
+      file.open(path, std::ios::binary);
+      if (!file)
+        return E_FAIL;
+    }
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    const std::string &content = m_Contents.emplace_back(stream.str());
+
+    std::string pathString = path.string();
+    if (std::find(m_Includes.begin(), m_Includes.end(), pathString) ==
+        m_Includes.end())
+      m_Includes.push_back(pathString);
+    m_Directories[content.data()] = path.parent_path();
+
+    *outData = content.data();
+    *outBytes = (UINT)content.size();
+    return S_OK;
+  }
+
+  HRESULT __stdcall Close(LPCVOID) override { return S_OK; }
+
+private:
+  std::filesystem::path m_RootDirectory;
+  std::vector<std::string> &m_Includes;
+  std::list<std::string> m_Contents; // stable addresses
+  std::unordered_map<LPCVOID, std::filesystem::path> m_Directories;
+};
+
+} // namespace
+
+bool CompileHLSL(const ShaderDesc &desc, const std::string &source,
+                 std::vector<uint8_t> &outBytecode,
+                 std::vector<std::string> &outIncludes,
+                 std::string &outErrors) {
+  std::vector<D3D_SHADER_MACRO> macros;
+  for (const auto &[name, value] : desc.Defines)
+    macros.push_back({name.c_str(), value.c_str()});
+  macros.push_back({nullptr, nullptr});
+
+  // Source comes from memory (already hashed by the cache); the path is
+  // only used for error messages and relative #includes
+  RecordingInclude includeHandler(
+      std::filesystem::path(desc.SourcePath).parent_path(), outIncludes);
+  ComPtr<ID3DBlob> code;
+  ComPtr<ID3DBlob> errors;
+  HRESULT hr = D3DCompile(source.data(), source.size(),
+                          desc.SourcePath.c_str(), macros.data(),
+                          &includeHandler, desc.EntryPoint.c_str(),
+                          desc.Target.c_str(), desc.Flags, 0, &code, &errors);
+  if (errors)
+    outErrors.assign((const char *)errors->GetBufferPointer(),
+                     errors->GetBufferSize());
+  if (FAILED(hr))
+    return false;
+
+  const uint8_t *data = (const uint8_t *)code->GetBufferPointer();
+  outBytecode.assign(data, data + code->GetBufferSize());
+  return true;
+}
+
+std::string GetHLSLCompilerTag() {
+  return "d3dcompiler_" + std::to_string(D3D_COMPILER_VERSION);
+}
+
+} // namespace Forge
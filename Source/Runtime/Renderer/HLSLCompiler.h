@@ -0,0 +1,18 @@
+#pragma once
+#include "ShaderCache.h"
+#include <string>
+#include <vector>
+
+namespace Forge {
+
+// D3DCompile backend for ShaderCache (Windows only). #includes resolve
+// like D3D_COMPILE_STANDARD_FILE_INCLUDE; every file opened is reported.
+bool CompileHLSL(const ShaderDesc &desc, const std::string &source,
+                 std::vector<uint8_t> &outBytecode,
+                 std::vector<std::string> &outIncludes,
+                 std::string &outErrors);
+
+// Part of the shader cache key: bump when the compiler changes
+std::string GetHLSLCompilerTag();
+
+} // namespace Forge
@@ -0,0 +1,173 @@
+#include "LODSelector.h"
+#include "../Core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Forge {
+
+LODSelector::Chain::Chain() {
+  std::fill(Errors, Errors + MaxLevels, std::numeric_limits<float>::infinity());
+}
+
+bool LODSelector::SetChain(uint32_t meshID,
+                           const std::vector<LODLevel> &levels) {
+  if (levels.empty() || levels.size() > MaxLevels) {
+    std::cerr << "[LODSelector] Mesh " << meshID << ": " << levels.size()
+              << " levels (1.." << MaxLevels << " supported)" << std::endl;
+    return false;
+  }
+  for (size_t i = 1; i < levels.size(); i++) {
+    if (levels[i].GeometricError < levels[i - 1].GeometricError) {
+      std::cerr << "[LODSelector] Mesh " << meshID
+                << ": geometric error must not decrease along the chain"
+                << std::endl;
+      return false;
+    }
+  }
+
+  if (m_Chains.size() <= meshID)
+    m_Chains.resize(meshID + 1);
+  Chain &chain = m_Chains[meshID];
+  chain = Chain();
+  chain.Count = (uint32_t)levels.size();
+  for (uint32_t i = 0; i < chain.Count; i++) {
+    chain.Errors[i] = levels[i].GeometricError;
+    chain.Meshes[i] = levels[i].MeshID;
+  }
+  return true;
+}
+
+void LODSelector::SetView(const float eye[3], float fovY,
+                          float viewportHeight) {
+  std::copy(eye, eye + 3, m_Eye);
+  m_ProjectionScale = viewportHeight / (2.0f * std::tan(fovY * 0.5f));
+}
+
+void LODSelector::Select(const LODInstance *instances, uint32_t count,
+                         uint8_t *levels, JobSystem *jobs) {
+  m_Stats = {};
+  if (!jobs) {
+    SelectRange(instances, 0, count, levels, m_Stats);
+    return;
+  }
+
+  m_WorkerStats.assign(jobs->GetThreadCount(), {});
+  jobs->ParallelFor(count, 4096,
+                    [&](uint32_t begin, uint32_t end, uint32_t worker) {
+                      SelectRange(instances, begin, end, levels,
+                                  m_WorkerStats[worker]);
+                    });
+  for (const LODSelectionStats &stats : m_WorkerStats) {
+    m_Stats.Instances += stats.Instances;
+    m_Stats.Changes += stats.Changes;
+    for (uint32_t level = 0; level < MaxLevels; level++)
+      m_Stats.PerLevel[level] += stats.PerLevel[level];
+  }
+}
+
+void LODSelector::SelectRange(const LODInstance *instances, uint32_t begin,
+                              uint32_t end, uint8_t *levels,
+                              LODSelectionStats &stats) const {
+  // Allowed world-space error per unit of distance (at scale 1)
+  const float errorPerDistance = m_Settings.MaxScreenError *
+                                 std::exp2(m_Settings.Bias) /
+                                 m_ProjectionScale;
+  const float coarsen = 1.0f - m_Settings.Hysteresis;
+  const uint32_t chainCount = (uint32_t)m_Chains.size();
+  static const Chain noChain;
+
+  // Blocks of instances: allowed errors first (8 at a time with AVX2),
+  // then the chain scans. The scans are branch-free apart from the
+  // per-entity bias: chain IDs and levels are effectively random across a
+  // scene and would mispredict.
+  constexpr uint32_t BlockSize = 64;
+  alignas(32) float limits[BlockSize];
+  for (uint32_t blockBegin = begin; blockBegin < end;
+       blockBegin += BlockSize) {
+    const uint32_t blockEnd = std::min(blockBegin + BlockSize, end);
+    const LODInstance *block = instances + blockBegin;
+    uint32_t i = 0;
+#if defined(__AVX2__)
+    static_assert(sizeof(LODInstance) == 8 * sizeof(float),
+                  "gathers assume 8-float instances");
+    const __m256i stride = _mm256_setr_epi32(0, 8, 16, 24, 32, 40, 48, 56);
+    for (; blockBegin + i + 8 <= blockEnd; i += 8) {
+      const float *base = &block[i].Center[0];
+      __m256 dx = _mm256_sub_ps(_mm256_i32gather_ps(base, stride, 4),
+                                _mm256_set1_ps(m_Eye[0]));
+      __m256 dy = _mm256_sub_ps(_mm256_i32gather_ps(base + 1, stride, 4),
+                                _mm256_set1_ps(m_Eye[1]));
+      __m256 dz = _mm256_sub_ps(_mm256_i32gather_ps(base + 2, stride, 4),
+                                _mm256_set1_ps(m_Eye[2]));
+      __m256 lengthSq = _mm256_add_ps(
+          _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+          _mm256_mul_ps(dz, dz));
+      __m256 distance = _mm256_max_ps(
+          _mm256_sub_ps(_mm256_sqrt_ps(lengthSq),
+                        _mm256_i32gather_ps(base + 3, stride, 4)),
+          _mm256_set1_ps(1e-3f));
+      __m256 limit = _mm256_div_ps(
+          _mm256_mul_ps(_mm256_set1_ps(errorPerDistance), distance),
+          _mm256_i32gather_ps(base + 4, stride, 4));
+      _mm256_store_ps(limits + i, limit);
+    }
+#endif
+    for (; blockBegin + i < blockEnd; i++) {
+      float dx = block[i].Center[0] - m_Eye[0];
+      float dy = block[i].Center[1] - m_Eye[1];
+      float dz = block[i].Center[2] - m_Eye[2];
+      float distance = std::max(
+          std::sqrt(dx * dx + dy * dy + dz * dz) - block[i].Radius, 1e-3f);
+      limits[i] = errorPerDistance * distance / block[i].Scale;
+    }
+
+    for (i = 0; blockBegin + i < blockEnd; i++) {
+      const LODInstance &instance = block[i];
+      const Chain &chain =
+          instance.Chain < chainCount ? m_Chains[instance.Chain] : noChain;
+      const uint32_t last = chain.Count > 0 ? chain.Count - 1 : 0;
+      const uint32_t previous = levels[blockBegin + i];
+      float limit = limits[i];
+      if (instance.Bias != 0.0f)
+        limit *= std::exp2(instance.Bias);
+
+      // Levels within the limit / within the hysteresis band. Errors grow
+      // along the chain, so these are prefix lengths.
+      uint32_t fine = 0, coarse = 0;
+#if defined(__AVX2__)
+      __m256 errors = _mm256_load_ps(chain.Errors);
+      fine = (uint32_t)_mm_popcnt_u32((uint32_t)_mm256_movemask_ps(
+          _mm256_cmp_ps(errors, _mm256_set1_ps(limit), _CMP_LE_OQ)));
+      coarse = (uint32_t)_mm_popcnt_u32((uint32_t)_mm256_movemask_ps(
+          _mm256_cmp_ps(errors, _mm256_set1_ps(limit * coarsen),
+                        _CMP_LE_OQ)));
+#else
+      for (uint32_t l = 0; l < MaxLevels; l++) {
+        fine += chain.Errors[l] <= limit ? 1 : 0;
+        coarse += chain.Errors[l] <= limit * coarsen ? 1 : 0;
+      }
+#endif
+      // Too coarse: refine right away; otherwise only coarsen past the
+      // hysteresis band
+      uint32_t current = std::min(previous, last);
+      uint32_t refined = fine > 0 ? fine - 1 : 0;
+      uint32_t coarsened = std::max(current, coarse > 0 ? coarse - 1 : 0);
+      uint32_t level = current >= fine ? refined : coarsened;
+      if (instance.ForcedLevel >= 0)
+        level = std::min((uint32_t)instance.ForcedLevel, last);
+
+      levels[blockBegin + i] = (uint8_t)level;
+      stats.Changes += level != previous ? 1 : 0;
+      stats.PerLevel[level]++;
+    }
+  }
+  stats.Instances += end - begin;
+}
+
+} // namespace Forge
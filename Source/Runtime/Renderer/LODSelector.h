@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Forge {
+
+class JobSystem;
+
+// One level of a mesh's LOD chain
+struct LODLevel {
+  uint32_t MeshID;      // renderer mesh drawn at this level
+  float GeometricError; // world units at scale 1, increasing along the chain
+};
+
+struct LODSettings {
+  float MaxScreenError = 1.0f; // pixels
+  // A coarser level is only taken once its error is this fraction below
+  // the limit, so a camera hovering at a threshold does not pop
+  float Hysteresis = 0.25f;
+  // Global bias in LOD steps: +1 allows twice the screen error (coarser)
+  float Bias = 0.0f;
+};
+
+// One entity in the batched pass
+struct LODInstance {
+  float Center[3]; // world-space bounding sphere
+  float Radius;
+  float Scale;         // world scale applied to the chain's errors
+  uint32_t Chain;      // mesh ID the chain was registered for
+  float Bias = 0.0f;   // per-entity, added to the global bias
+  int32_t ForcedLevel = -1;
+};
+
+struct LODSelectionStats {
+  static constexpr uint32_t MaxLevels = 8;
+
+  uint32_t Instances = 0;
+  uint32_t Changes = 0; // level differs from the previous selection
+  uint32_t PerLevel[MaxLevels] = {};
+};
+
+// Screen-space-error LOD selection. A level's error in pixels is its
+// geometric error projected at the distance of the instance's bounding
+// sphere; the coarsest level under MaxScreenError (scaled by 2^bias) is
+// selected, with hysteresis on the way to coarser levels. The comparison
+// is done in world units (allowed error = limit * distance / projection
+// scale), so each instance costs one square root and a short scan of its
+// chain. Runs in parallel batches; not thread-safe otherwise.
+class LODSelector {
+public:
+  static constexpr uint32_t MaxLevels = LODSelectionStats::MaxLevels;
+
+  // levels: finest first, at most MaxLevels. Replaces an existing chain.
+  bool SetChain(uint32_t meshID, const std::vector<LODLevel> &levels);
+  bool HasChain(uint32_t meshID) const {
+    return meshID < m_Chains.size() && m_Chains[meshID].Count > 0;
+  }
+  uint32_t GetLevelCount(uint32_t meshID) const {
+    return HasChain(meshID) ? m_Chains[meshID].Count : 0;
+  }
+  uint32_t GetLevelMesh(uint32_t meshID, uint32_t level) const {
+    return m_Chains[meshID].Meshes[level];
+  }
+
+  // Perspective camera: position, vertical field of view (radians) and
+  // viewport height in pixels
+  void SetView(const float eye[3], float fovY, float viewportHeight);
+  void SetSettings(const LODSettings &settings) { m_Settings = settings; }
+  const LODSettings &GetSettings() const { return m_Settings; }
+
+  // levels[i]: previous level on input (0 for new instances), selected
+  // level on output. Instances without a chain get level 0. jobs may be
+  // null.
+  void Select(const LODInstance *instances, uint32_t count, uint8_t *levels,
+              JobSystem *jobs);
+
+  const LODSelectionStats &GetStats() const { return m_Stats; }
+
+private:
+  // An empty chain (all errors +inf) selects level 0, so instances without
+  // a chain go through the same branch-free path
+  struct Chain {
+    Chain();
+
+    alignas(32) float Errors[MaxLevels]; // +inf past Count
+    uint32_t Count = 0;
+    uint32_t Meshes[MaxLevels] = {};
+  };
+
+  void SelectRange(const LODInstance *instances, uint32_t begin, uint32_t end,
+                   uint8_t *levels, LODSelectionStats &stats) const;
+
+  std::vector<Chain> m_Chains; // by mesh ID
+  float m_Eye[3] = {};
+  float m_ProjectionScale = 1.0f; // pixels per world unit at distance 1
+  LODSettings m_Settings;
+
+  std::vector<LODSelectionStats> m_WorkerStats;
+  LODSelectionStats m_Stats;
+};
+
+} // namespace Forge
@@ -0,0 +1,582 @@
+#include "OcclusionCuller.h"
+#include "../Core/JobSystem.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Forge {
+
+static void Multiply(const float *a, const float *b, float *out) {
+  for (int row = 0; row < 4; row++) {
+    for (int column = 0; column < 4; column++) {
+      out[row * 4 + column] = a[row * 4 + 0] * b[0 * 4 + column] +
+                              a[row * 4 + 1] * b[1 * 4 + column] +
+                              a[row * 4 + 2] * b[2 * 4 + column] +
+                              a[row * 4 + 3] * b[3 * 4 + column];
+    }
+  }
+}
+
+#if defined(__AVX2__)
+// Same operation order as Multiply
+static void MultiplySIMD(const float *a, const float *b, float *out) {
+  const __m128 rows[4] = {_mm_loadu_ps(b), _mm_loadu_ps(b + 4),
+                          _mm_loadu_ps(b + 8), _mm_loadu_ps(b + 12)};
+  for (int row = 0; row < 4; row++) {
+    __m128 sum = _mm_mul_ps(_mm_set1_ps(a[row * 4]), rows[0]);
+    for (int k = 1; k < 4; k++)
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(a[row * 4 + k]), rows[k]));
+    _mm_storeu_ps(out + row * 4, sum);
+  }
+}
+#endif
+
+static void Transform(const float *p, const float *m, float (&out)[4]) {
+  for (int c = 0; c < 4; c++)
+    out[c] = p[0] * m[c] + p[1] * m[4 + c] + p[2] * m[8 + c] + m[12 + c];
+}
+
+// ParallelFor when a JobSystem is given, inline otherwise
+template <typename Function>
+static void ForEach(JobSystem *jobs, uint32_t count, uint32_t batchSize,
+                    const Function &function) {
+  if (jobs) {
+    jobs->ParallelFor(count, batchSize,
+                      [&](uint32_t begin, uint32_t end, uint32_t) {
+                        for (uint32_t i = begin; i < end; i++)
+                          function(i);
+                      });
+  } else {
+    for (uint32_t i = 0; i < count; i++)
+      function(i);
+  }
+}
+
+void OcclusionCuller::SetResolution(uint32_t width, uint32_t height) {
+  m_TilesX = std::max((width + TileWidth - 1) / TileWidth, 1u);
+  m_TilesY = std::max((height + TileHeight - 1) / TileHeight, 1u);
+  m_Width = m_TilesX * TileWidth;
+  m_Height = m_TilesY * TileHeight;
+  // Room for an 8-tile load starting at any 8-aligned tile
+  m_TileStride = (m_TilesX + 7) & ~7u;
+}
+
+void OcclusionCuller::SetOccluderSelection(float minScreenArea,
+                                           uint32_t maxOccluders) {
+  m_MinScreenArea = minScreenArea;
+  m_MaxOccluders = maxOccluders;
+}
+
+void OcclusionCuller::Cull(const float viewProj[16],
+                           const OcclusionObject *objects, uint32_t count,
+                           std::vector<uint8_t> &visible, JobSystem *jobs) {
+  m_Stats = {};
+  m_Stats.Objects = count;
+#if defined(__AVX2__)
+  m_Stats.SIMD = m_UseSIMD;
+#endif
+  visible.assign(count, 1);
+
+  // 1. Screen bounds of every object
+  m_Bounds.resize(count);
+  ForEach(jobs, count, 64, [&](uint32_t i) {
+    ProjectBounds(viewProj, objects[i], m_Bounds[i]);
+  });
+
+  // 2. Occluders: the largest candidates, then front to back
+  float minArea = m_MinScreenArea * (float)m_Width * (float)m_Height;
+  auto area = [&](uint32_t i) {
+    const ScreenBounds &bounds = m_Bounds[i];
+    return (std::min(bounds.MaxX, (float)m_Width) -
+            std::max(bounds.MinX, 0.0f)) *
+           (std::min(bounds.MaxY, (float)m_Height) -
+            std::max(bounds.MinY, 0.0f));
+  };
+  m_Occluders.clear();
+  for (uint32_t i = 0; i < count; i++) {
+    if (objects[i].OccluderPositions && objects[i].OccluderVertexCount >= 3 &&
+        m_Bounds[i].State == BoundsState::Inside && area(i) >= minArea)
+      m_Occluders.push_back(i);
+  }
+  if (m_Occluders.size() > m_MaxOccluders) {
+    std::stable_sort(m_Occluders.begin(), m_Occluders.end(),
+                     [&](uint32_t a, uint32_t b) { return area(a) > area(b); });
+    m_Occluders.resize(m_MaxOccluders);
+  }
+  std::stable_sort(m_Occluders.begin(), m_Occluders.end(),
+                   [&](uint32_t a, uint32_t b) {
+                     return m_Bounds[a].ZMin < m_Bounds[b].ZMin;
+                   });
+
+  // 3. Occluder triangle setup (near clipping makes up to two per input)
+  m_TriangleOffsets.resize(m_Occluders.size() + 1);
+  uint32_t triangleCount = 0;
+  for (size_t i = 0; i < m_Occluders.size(); i++) {
+    m_TriangleOffsets[i] = triangleCount;
+    triangleCount += objects[m_Occluders[i]].OccluderVertexCount / 3 * 2;
+  }
+  m_TriangleOffsets[m_Occluders.size()] = triangleCount;
+  m_Triangles.resize(triangleCount);
+  ForEach(jobs, (uint32_t)m_Occluders.size(), 1, [&](uint32_t i) {
+    SetupOccluder(viewProj, objects[m_Occluders[i]],
+                  m_Triangles.data() + m_TriangleOffsets[i]);
+  });
+  m_Stats.Occluders = (uint32_t)m_Occluders.size();
+  for (const Triangle &triangle : m_Triangles)
+    m_Stats.OccluderTriangles += triangle.Valid ? 1 : 0;
+
+  // 4. Masked depth buffer, one job per tile row
+  m_Tiles.resize((size_t)m_TileStride * m_TilesY);
+  m_ZMax0.assign(m_Tiles.size(), -1.0f); // padding never passes the test
+  ForEach(jobs, m_TilesY, 1, [&](uint32_t row) { RasterizeRow(row); });
+
+  // 5. Occludee tests
+  ForEach(jobs, count, 64, [&](uint32_t i) {
+    switch (m_Bounds[i].State) {
+    case BoundsState::Outside:
+      visible[i] = 0;
+      break;
+    case BoundsState::Crossing:
+      visible[i] = 1; // reaches the near plane
+      break;
+    case BoundsState::Inside:
+      visible[i] = TestBounds(m_Bounds[i]) ? 1 : 0;
+      break;
+    }
+  });
+
+  for (uint32_t i = 0; i < count; i++) {
+    if (visible[i])
+      m_Stats.Visible++;
+    else if (m_Bounds[i].State == BoundsState::Outside)
+      m_Stats.FrustumCulled++;
+    else
+      m_Stats.OcclusionCulled++;
+  }
+}
+
+void OcclusionCuller::ProjectBounds(const float viewProj[16],
+                                    const OcclusionObject &object,
+                                    ScreenBounds &bounds) const {
+  float worldViewProj[16];
+#if defined(__AVX2__)
+  if (m_UseSIMD)
+    MultiplySIMD(object.World, viewProj, worldViewProj);
+  else
+#endif
+    Multiply(object.World, viewProj, worldViewProj);
+
+  // Corners = min corner + any of the three (transformed) box edges
+  float base[4], edges[3][4];
+  Transform(object.BoundsMin, worldViewProj, base);
+  for (int axis = 0; axis < 3; axis++) {
+    float extent = object.BoundsMax[axis] - object.BoundsMin[axis];
+    for (int c = 0; c < 4; c++)
+      edges[axis][c] = extent * worldViewProj[axis * 4 + c];
+  }
+
+#if defined(__AVX2__)
+  if (m_UseSIMD) {
+    // The 8 corners in one register per component, same operation order
+    // as the scalar loop below
+    const __m256 cornerBits[3] = {
+        _mm256_setr_ps(0, 1, 0, 1, 0, 1, 0, 1),
+        _mm256_setr_ps(0, 0, 1, 1, 0, 0, 1, 1),
+        _mm256_setr_ps(0, 0, 0, 0, 1, 1, 1, 1)};
+    __m256 clip[4];
+    for (int c = 0; c < 4; c++) {
+      clip[c] = _mm256_set1_ps(base[c]);
+      for (int axis = 0; axis < 3; axis++)
+        clip[c] = _mm256_add_ps(
+            clip[c],
+            _mm256_mul_ps(cornerBits[axis], _mm256_set1_ps(edges[axis][c])));
+    }
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 negW = _mm256_sub_ps(zero, clip[3]);
+    auto all = [](__m256 mask) { return _mm256_movemask_ps(mask) == 0xff; };
+    bool outside =
+        all(_mm256_cmp_ps(clip[0], negW, _CMP_LT_OQ)) ||
+        all(_mm256_cmp_ps(clip[0], clip[3], _CMP_GT_OQ)) ||
+        all(_mm256_cmp_ps(clip[1], negW, _CMP_LT_OQ)) ||
+        all(_mm256_cmp_ps(clip[1], clip[3], _CMP_GT_OQ)) ||
+        all(_mm256_cmp_ps(clip[2], zero, _CMP_LT_OQ)) ||
+        all(_mm256_cmp_ps(clip[2], clip[3], _CMP_GT_OQ));
+    bool crossesNear =
+        _mm256_movemask_ps(
+            _mm256_or_ps(_mm256_cmp_ps(clip[2], zero, _CMP_LT_OQ),
+                         _mm256_cmp_ps(clip[3], zero, _CMP_LE_OQ))) != 0;
+    bounds = {0, 0, 0, 0, 0,
+              outside       ? BoundsState::Outside
+              : crossesNear ? BoundsState::Crossing
+                            : BoundsState::Inside};
+    if (bounds.State != BoundsState::Inside)
+      return;
+
+    const __m256 half = _mm256_set1_ps(0.5f);
+    __m256 invW = _mm256_div_ps(_mm256_set1_ps(1.0f), clip[3]);
+    __m256 x = _mm256_mul_ps(
+        _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(clip[0], invW), half), half),
+        _mm256_set1_ps((float)m_Width));
+    __m256 y = _mm256_mul_ps(
+        _mm256_sub_ps(half, _mm256_mul_ps(_mm256_mul_ps(clip[1], invW), half)),
+        _mm256_set1_ps((float)m_Height));
+    __m256 z = _mm256_mul_ps(clip[2], invW);
+    auto reduce = [](__m256 v, bool maximum) {
+      __m128 r = maximum ? _mm_max_ps(_mm256_castps256_ps128(v),
+                                      _mm256_extractf128_ps(v, 1))
+                         : _mm_min_ps(_mm256_castps256_ps128(v),
+                                      _mm256_extractf128_ps(v, 1));
+      __m128 s = _mm_movehl_ps(r, r);
+      r = maximum ? _mm_max_ps(r, s) : _mm_min_ps(r, s);
+      s = _mm_shuffle_ps(r, r, 1);
+      r = maximum ? _mm_max_ss(r, s) : _mm_min_ss(r, s);
+      return _mm_cvtss_f32(r);
+    };
+    bounds.MinX = reduce(x, false);
+    bounds.MaxX = reduce(x, true);
+    bounds.MinY = reduce(y, false);
+    bounds.MaxY = reduce(y, true);
+    bounds.ZMin = reduce(z, false);
+    return;
+  }
+#endif
+
+  // Outcodes: a plane all corners are outside of rejects the box
+  uint32_t outsideAll = 0x3f;
+  bool crossesNear = false;
+  bounds = {FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX, FLT_MAX,
+            BoundsState::Inside};
+  for (int corner = 0; corner < 8; corner++) {
+    float clip[4];
+    for (int c = 0; c < 4; c++) {
+      clip[c] = base[c] + ((corner & 1) ? edges[0][c] : 0.0f) +
+                ((corner & 2) ? edges[1][c] : 0.0f) +
+                ((corner & 4) ? edges[2][c] : 0.0f);
+    }
+    uint32_t outside = (clip[0] < -clip[3] ? 1 : 0) |
+                       (clip[0] > clip[3] ? 2 : 0) |
+                       (clip[1] < -clip[3] ? 4 : 0) |
+                       (clip[1] > clip[3] ? 8 : 0) |
+                       (clip[2] < 0.0f ? 16 : 0) |
+                       (clip[2] > clip[3] ? 32 : 0);
+    outsideAll &= outside;
+    if (clip[2] < 0.0f || clip[3] <= 0.0f) {
+      crossesNear = true;
+      continue;
+    }
+    float invW = 1.0f / clip[3];
+    float x = (clip[0] * invW * 0.5f + 0.5f) * (float)m_Width;
+    float y = (0.5f - clip[1] * invW * 0.5f) * (float)m_Height;
+    bounds.MinX = std::min(bounds.MinX, x);
+    bounds.MaxX = std::max(bounds.MaxX, x);
+    bounds.MinY = std::min(bounds.MinY, y);
+    bounds.MaxY = std::max(bounds.MaxY, y);
+    bounds.ZMin = std::min(bounds.ZMin, clip[2] * invW);
+  }
+  if (outsideAll)
+    bounds.State = BoundsState::Outside;
+  else if (crossesNear)
+    bounds.State = BoundsState::Crossing;
+}
+
+void OcclusionCuller::SetupOccluder(const float viewProj[16],
+                                    const OcclusionObject &object,
+                                    Triangle *triangles) const {
+  float worldViewProj[16];
+  Multiply(object.World, viewProj, worldViewProj);
+  const uint8_t *bytes = (const uint8_t *)object.OccluderPositions;
+
+  for (uint32_t i = 0; i + 2 < object.OccluderVertexCount; i += 3) {
+    Triangle *out = triangles + (i / 3) * 2;
+    out[0].Valid = out[1].Valid = false;
+
+    float clip[3][4];
+    for (int v = 0; v < 3; v++) {
+      Transform((const float *)(bytes + (size_t)(i + v) *
+                                            object.OccluderStride),
+                worldViewProj, clip[v]);
+    }
+
+    // Near plane (z >= 0) clip
+    float polygon[4][4];
+    uint32_t count = 0;
+    for (int v = 0; v < 3; v++) {
+      const float *a = clip[v];
+      const float *b = clip[(v + 1) % 3];
+      if (a[2] >= 0.0f)
+        std::copy(a, a + 4, polygon[count++]);
+      if ((a[2] >= 0.0f) != (b[2] >= 0.0f)) {
+        float t = a[2] / (a[2] - b[2]);
+        for (int c = 0; c < 4; c++)
+          polygon[count][c] = a[c] + (b[c] - a[c]) * t;
+        polygon[count++][2] = 0.0f;
+      }
+    }
+    if (count < 3)
+      continue;
+
+    float screen[4][3];
+    for (uint32_t v = 0; v < count; v++) {
+      float invW = 1.0f / polygon[v][3];
+      screen[v][0] = (polygon[v][0] * invW * 0.5f + 0.5f) * (float)m_Width;
+      screen[v][1] = (0.5f - polygon[v][1] * invW * 0.5f) * (float)m_Height;
+      screen[v][2] = polygon[v][2] * invW;
+    }
+    for (uint32_t v = 1; v + 1 < count; v++)
+      SetupTriangle(screen[0], screen[v], screen[v + 1], out[v - 1]);
+  }
+}
+
+void OcclusionCuller::SetupTriangle(const float (&v0)[3],
+                                    const float (&v1)[3],
+                                    const float (&v2)[3],
+                                    Triangle &triangle) const {
+  const float *v[3] = {v0, v1, v2};
+  auto edge = [](const float *a, const float *b, float &A, float &B,
+                 float &C) {
+    A = a[1] - b[1];
+    B = b[0] - a[0];
+    C = -(A * a[0] + B * a[1]);
+  };
+  float A, B, C;
+  edge(v[0], v[1], A, B, C);
+  float area = A * v[2][0] + B * v[2][1] + C;
+  if (area == 0.0f || !std::isfinite(area))
+    return;
+  if (area < 0.0f) { // occluders are two-sided
+    std::swap(v[1], v[2]);
+    area = -area;
+  }
+
+  for (int e = 0; e < 3; e++)
+    edge(v[(e + 1) % 3], v[(e + 2) % 3], triangle.A[e], triangle.B[e],
+         triangle.C[e]);
+  float invArea = 1.0f / area;
+  triangle.ZA = (triangle.A[0] * v[0][2] + triangle.A[1] * v[1][2] +
+                 triangle.A[2] * v[2][2]) *
+                invArea;
+  triangle.ZB = (triangle.B[0] * v[0][2] + triangle.B[1] * v[1][2] +
+                 triangle.B[2] * v[2][2]) *
+                invArea;
+  triangle.ZC = (triangle.C[0] * v[0][2] + triangle.C[1] * v[1][2] +
+                 triangle.C[2] * v[2][2]) *
+                invArea;
+  triangle.ZMax = std::max({v[0][2], v[1][2], v[2][2]});
+
+  triangle.MinX = std::max(std::min({v[0][0], v[1][0], v[2][0]}), 0.0f);
+  triangle.MinY = std::max(std::min({v[0][1], v[1][1], v[2][1]}), 0.0f);
+  triangle.MaxX =
+      std::min(std::max({v[0][0], v[1][0], v[2][0]}), (float)m_Width);
+  triangle.MaxY =
+      std::min(std::max({v[0][1], v[1][1], v[2][1]}), (float)m_Height);
+  if (triangle.MinX >= triangle.MaxX || triangle.MinY >= triangle.MaxY)
+    return;
+  triangle.MinTileX = (int32_t)triangle.MinX / (int32_t)TileWidth;
+  triangle.MinTileY = (int32_t)triangle.MinY / (int32_t)TileHeight;
+  triangle.MaxTileX = std::min((int32_t)triangle.MaxX / (int32_t)TileWidth,
+                               (int32_t)m_TilesX - 1);
+  triangle.MaxTileY = std::min((int32_t)triangle.MaxY / (int32_t)TileHeight,
+                               (int32_t)m_TilesY - 1);
+  triangle.Valid = true;
+}
+
+void OcclusionCuller::RasterizeRow(uint32_t tileY) {
+  Tile *row = m_Tiles.data() + (size_t)tileY * m_TileStride;
+  for (uint32_t x = 0; x < m_TilesX; x++)
+    row[x] = {1.0f, 0.0f, 0u};
+
+  bool simd = m_UseSIMD && SoftwareRasterizer::IsSIMDAvailable();
+  int32_t y = (int32_t)tileY;
+  float y0 = (float)(y * (int32_t)TileHeight);
+  float y1 = y0 + TileHeight;
+
+  for (const Triangle &triangle : m_Triangles) {
+    if (!triangle.Valid || y < triangle.MinTileY || y > triangle.MaxTileY)
+      continue;
+    float clampedY0 = std::max(y0, triangle.MinY);
+    float clampedY1 = std::min(y1, triangle.MaxY);
+
+    for (int32_t x = triangle.MinTileX; x <= triangle.MaxTileX; x++) {
+      Tile &tile = row[x];
+      // Farthest triangle depth inside the tile: the plane's maximum over
+      // the tile / bounding box overlap is at one of its corners
+      float x0 = std::max((float)(x * (int32_t)TileWidth), triangle.MinX);
+      float x1 = std::min((float)((x + 1) * (int32_t)TileWidth),
+                          triangle.MaxX);
+      float zRow0 = triangle.ZB * clampedY0 + triangle.ZC;
+      float zRow1 = triangle.ZB * clampedY1 + triangle.ZC;
+      float z = std::max({triangle.ZA * x0 + zRow0, triangle.ZA * x1 + zRow0,
+                          triangle.ZA * x0 + zRow1, triangle.ZA * x1 + zRow1});
+      z = std::min(z, triangle.ZMax);
+      if (z >= tile.ZMax0)
+        continue; // behind what already covers the tile
+
+      uint32_t mask =
+          simd ? CoverageSIMD(triangle, x * (int32_t)TileWidth,
+                              y * (int32_t)TileHeight)
+               : CoverageScalar(triangle, x * (int32_t)TileWidth,
+                                y * (int32_t)TileHeight);
+      if (mask == 0)
+        continue;
+
+      // Much nearer than the working layer: start a new working layer
+      // rather than pushing its max depth back
+      if (tile.Mask != 0 && tile.ZMax1 - z > tile.ZMax0 - tile.ZMax1) {
+        tile.ZMax1 = 0.0f;
+        tile.Mask = 0;
+      }
+      tile.ZMax1 = std::max(tile.ZMax1, z);
+      tile.Mask |= mask;
+      if (tile.Mask == ~0u) {
+        tile.ZMax0 = std::min(tile.ZMax0, tile.ZMax1);
+        tile.ZMax1 = 0.0f;
+        tile.Mask = 0;
+      }
+    }
+  }
+
+  float *zMax0 = m_ZMax0.data() + (size_t)tileY * m_TileStride;
+  for (uint32_t x = 0; x < m_TilesX; x++)
+    zMax0[x] = row[x].ZMax0;
+}
+
+// Pixel centers on an edge count as covered (shared edges of a mesh must
+// not leave holes, or tiles never fill up)
+uint32_t OcclusionCuller::CoverageScalar(const Triangle &triangle, int32_t x,
+                                         int32_t y) const {
+  uint32_t mask = 0;
+  for (uint32_t row = 0; row < TileHeight; row++) {
+    float py = (float)(y + (int32_t)row) + 0.5f;
+    float rowE[3];
+    for (int e = 0; e < 3; e++)
+      rowE[e] = triangle.B[e] * py + triangle.C[e];
+    for (uint32_t column = 0; column < TileWidth; column++) {
+      float px = (float)(x + (int32_t)column) + 0.5f;
+      bool inside = true;
+      for (int e = 0; e < 3; e++)
+        inside = inside && (triangle.A[e] * px + rowE[e] >= 0.0f);
+      if (inside)
+        mask |= 1u << (row * TileWidth + column);
+    }
+  }
+  return mask;
+}
+
+uint32_t OcclusionCuller::CoverageSIMD(const Triangle &triangle, int32_t x,
+                                       int32_t y) const {
+#if defined(__AVX2__)
+  const __m256 px = _mm256_add_ps(
+      _mm256_cvtepi32_ps(_mm256_add_epi32(
+          _mm256_set1_epi32(x), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))),
+      _mm256_set1_ps(0.5f));
+  __m256 columnE[3];
+  for (int e = 0; e < 3; e++)
+    columnE[e] = _mm256_mul_ps(_mm256_set1_ps(triangle.A[e]), px);
+  const __m256 zero = _mm256_setzero_ps();
+
+  uint32_t mask = 0;
+  for (uint32_t row = 0; row < TileHeight; row++) {
+    float py = (float)(y + (int32_t)row) + 0.5f;
+    __m256 inside = _mm256_cmp_ps(
+        _mm256_add_ps(columnE[0],
+                      _mm256_set1_ps(triangle.B[0] * py + triangle.C[0])),
+        zero, _CMP_GE_OQ);
+    for (int e = 1; e < 3; e++) {
+      inside = _mm256_and_ps(
+          inside,
+          _mm256_cmp_ps(_mm256_add_ps(columnE[e],
+                                      _mm256_set1_ps(triangle.B[e] * py +
+                                                     triangle.C[e])),
+                        zero, _CMP_GE_OQ));
+    }
+    mask |= (uint32_t)_mm256_movemask_ps(inside) << (row * TileWidth);
+  }
+  return mask;
+#else
+  return CoverageScalar(triangle, x, y);
+#endif
+}
+
+bool OcclusionCuller::TestBounds(const ScreenBounds &bounds) const {
+  int32_t x0 = (int32_t)std::max(bounds.MinX, 0.0f) / (int32_t)TileWidth;
+  int32_t y0 = (int32_t)std::max(bounds.MinY, 0.0f) / (int32_t)TileHeight;
+  int32_t x1 = std::min((int32_t)std::max(bounds.MaxX, 0.0f) /
+                            (int32_t)TileWidth,
+                        (int32_t)m_TilesX - 1);
+  int32_t y1 = std::min((int32_t)std::max(bounds.MaxY, 0.0f) /
+                            (int32_t)TileHeight,
+                        (int32_t)m_TilesY - 1);
+  if (x0 > x1 || y0 > y1)
+    return false;
+
+#if defined(__AVX2__)
+  if (m_UseSIMD) {
+    const __m256 zMin = _mm256_set1_ps(bounds.ZMin);
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    int32_t start = x0 & ~7;
+    for (int32_t y = y0; y <= y1; y++) {
+      const float *row = m_ZMax0.data() + (size_t)y * m_TileStride;
+      for (int32_t x = start; x <= x1; x += 8) {
+        // Lanes inside [x0, x1]
+        __m256i index = _mm256_add_epi32(_mm256_set1_epi32(x), lane);
+        __m256i inRange = _mm256_andnot_si256(
+            _mm256_cmpgt_epi32(_mm256_set1_epi32(x0), index),
+            _mm256_cmpgt_epi32(_mm256_set1_epi32(x1 + 1), index));
+        __m256 passed =
+            _mm256_cmp_ps(_mm256_loadu_ps(row + x), zMin, _CMP_GE_OQ);
+        if (_mm256_movemask_ps(
+                _mm256_and_ps(passed, _mm256_castsi256_ps(inRange))))
+          return true;
+      }
+    }
+    return false;
+  }
+#endif
+  for (int32_t y = y0; y <= y1; y++) {
+    const float *row = m_ZMax0.data() + (size_t)y * m_TileStride;
+    for (int32_t x = x0; x <= x1; x++) {
+      if (row[x] >= bounds.ZMin)
+        return true;
+    }
+  }
+  return false;
+}
+
+RasterImage OcclusionCuller::GetDepthImage() const {
+  if (m_ZMax0.empty())
+    return {};
+  float nearest = 1.0f, farthest = 0.0f;
+  for (uint32_t y = 0; y < m_TilesY; y++) {
+    for (uint32_t x = 0; x < m_TilesX; x++) {
+      float depth = m_ZMax0[(size_t)y * m_TileStride + x];
+      if (depth < 1.0f) {
+        nearest = std::min(nearest, depth);
+        farthest = std::max(farthest, depth);
+      }
+    }
+  }
+  float range = farthest > nearest ? farthest - nearest : 1.0f;
+
+  RasterImage image;
+  image.Width = m_Width;
+  image.Height = m_Height;
+  image.Pixels.resize((size_t)m_Width * m_Height);
+  for (uint32_t y = 0; y < m_Height; y++) {
+    for (uint32_t x = 0; x < m_Width; x++) {
+      float depth =
+          m_ZMax0[(size_t)(y / TileHeight) * m_TileStride + x / TileWidth];
+      uint32_t gray = 0;
+      if (depth < 1.0f)
+        gray = 255 - (uint32_t)((depth - nearest) / range * 223.0f);
+      image.Pixels[(size_t)y * m_Width + x] =
+          gray | (gray << 8) | (gray << 16) | 0xff000000u;
+    }
+  }
+  return image;
+}
+
+} // namespace Forge
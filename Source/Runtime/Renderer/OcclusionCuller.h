@@ -0,0 +1,119 @@
+#pragma once
+#include "SoftwareRasterizer.h"
+#include <cstdint>
+#include <vector>
+
+namespace Forge {
+
+class JobSystem;
+
+// One cullable object: local bounds + world transform, optionally with a
+// triangle list (float3 positions) that may be rasterized as occluder
+struct OcclusionObject {
+  float World[16]; // row-major, row vectors
+  float BoundsMin[3];
+  float BoundsMax[3];
+  const float *OccluderPositions = nullptr; // null: never an occluder
+  uint32_t OccluderVertexCount = 0;
+  uint32_t OccluderStride = 0;
+};
+
+struct OcclusionStats {
+  uint32_t Objects = 0;
+  uint32_t Occluders = 0;         // rasterized this frame
+  uint32_t OccluderTriangles = 0; // after near clipping
+  uint32_t FrustumCulled = 0;
+  uint32_t OcclusionCulled = 0;
+  uint32_t Visible = 0;
+  bool SIMD = false;
+};
+
+// Masked software occlusion culling. The largest on-screen objects are
+// rasterized front to back into a low-resolution depth buffer that stores,
+// per 8x4 pixel tile, a coverage mask and two max depths (a reference layer
+// that covers the whole tile and a partial working layer merged into it
+// once the mask is full), so no per-pixel depth is kept. The tile max
+// depths are the hierarchical depth the occludees' screen boxes are tested
+// against, 8 tiles at a time with AVX2.
+//
+// Every stage runs on the JobSystem: bounds projection and occludee tests
+// per object, occluder setup per occluder and rasterization per tile row
+// (each row walks the triangles in the same order, so results do not
+// depend on the thread count). Depth follows D3D (0 near, 1 far).
+class OcclusionCuller {
+public:
+  static constexpr uint32_t TileWidth = 8;
+  static constexpr uint32_t TileHeight = 4;
+
+  // Depth buffer size in pixels (rounded up to whole tiles)
+  void SetResolution(uint32_t width, uint32_t height);
+  // Objects whose screen box covers at least minScreenArea (fraction of the
+  // buffer) are occluder candidates; the largest maxOccluders are used
+  void SetOccluderSelection(float minScreenArea, uint32_t maxOccluders);
+  // Forces the scalar path (comparisons); ignored without AVX2
+  void SetUseSIMD(bool useSIMD) { m_UseSIMD = useSIMD; }
+
+  // visible[i] = 1 if objects[i] may be visible. jobs may be null.
+  void Cull(const float viewProj[16], const OcclusionObject *objects,
+            uint32_t count, std::vector<uint8_t> &visible, JobSystem *jobs);
+
+  const OcclusionStats &GetStats() const { return m_Stats; }
+  uint32_t GetWidth() const { return m_Width; }
+  uint32_t GetHeight() const { return m_Height; }
+  // Reference-layer depth per tile, near = white (debug view)
+  RasterImage GetDepthImage() const;
+
+private:
+  enum class BoundsState : uint8_t { Outside, Crossing, Inside };
+
+  // Object bounds in buffer pixels
+  struct ScreenBounds {
+    float MinX, MinY, MaxX, MaxY;
+    float ZMin;
+    BoundsState State;
+  };
+
+  struct Triangle {
+    float A[3], B[3], C[3];
+    float ZA, ZB, ZC, ZMax;
+    int32_t MinTileX, MinTileY, MaxTileX, MaxTileY;
+    float MinX, MinY, MaxX, MaxY;
+    bool Valid;
+  };
+
+  struct Tile {
+    float ZMax0;   // reference layer, covers the tile
+    float ZMax1;   // working layer
+    uint32_t Mask; // working layer coverage (bit = y * 8 + x)
+  };
+
+  void ProjectBounds(const float viewProj[16], const OcclusionObject &object,
+                     ScreenBounds &bounds) const;
+  void SetupOccluder(const float viewProj[16], const OcclusionObject &object,
+                     Triangle *triangles) const;
+  void SetupTriangle(const float (&v0)[3], const float (&v1)[3],
+                     const float (&v2)[3], Triangle &triangle) const;
+  void RasterizeRow(uint32_t tileY);
+  uint32_t CoverageScalar(const Triangle &triangle, int32_t x,
+                          int32_t y) const;
+  uint32_t CoverageSIMD(const Triangle &triangle, int32_t x, int32_t y) const;
+  bool TestBounds(const ScreenBounds &bounds) const;
+
+  uint32_t m_Width = 256, m_Height = 128;
+  uint32_t m_TilesX = 32, m_TilesY = 32;
+  uint32_t m_TileStride = 32; // m_TilesX padded to 8 for the SIMD test
+  float m_MinScreenArea = 0.01f;
+  uint32_t m_MaxOccluders = 64;
+  bool m_UseSIMD = true;
+
+  std::vector<Tile> m_Tiles;
+  std::vector<float> m_ZMax0; // copy of Tile::ZMax0, SIMD-friendly
+  std::vector<ScreenBounds> m_Bounds;
+  std::vector<uint32_t> m_Occluders;
+  std::vector<uint32_t> m_TriangleOffsets; // per occluder, into m_Triangles
+  std::vector<Triangle> m_Triangles;
+
+  OcclusionStats m_Stats;
+};
+
+} // namespace Forge
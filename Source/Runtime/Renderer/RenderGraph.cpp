@@ -0,0 +1,526 @@
+#include "RenderGraph.h"
+#include "../Core/Hash.h"
+#include "../Core/Profiler.h"
+#include <algorithm>
+#include <iostream>
+
+namespace Forge {
+
+static constexpr uint64_t HeapAlignment = 64 * 1024;
+
+// --- Builder / context ---
+
+void RGPassBuilder::Read(RGResourceHandle resource, RHIResourceState state) {
+  if (!resource.IsValid() || resource.Index >= m_Graph->m_Resources.size()) {
+    std::cerr << "[RenderGraph] Pass '" << m_Graph->m_Passes[m_Pass].Name
+              << "' reads an invalid resource" << std::endl;
+    return;
+  }
+  m_Graph->m_Passes[m_Pass].Accesses.push_back({resource.Index, state, false});
+}
+
+void RGPassBuilder::Write(RGResourceHandle resource, RHIResourceState state) {
+  if (!resource.IsValid() || resource.Index >= m_Graph->m_Resources.size()) {
+    std::cerr << "[RenderGraph] Pass '" << m_Graph->m_Passes[m_Pass].Name
+              << "' writes an invalid resource" << std::endl;
+    return;
+  }
+  m_Graph->m_Passes[m_Pass].Accesses.push_back({resource.Index, state, true});
+}
+
+void RGPassBuilder::SetSideEffect() {
+  m_Graph->m_Passes[m_Pass].SideEffect = true;
+}
+
+RHIResource *RGContext::GetResource(RGResourceHandle resource) const {
+  return resource.IsValid() ? m_Graph->m_Resources[resource.Index].Native
+                            : nullptr;
+}
+
+RHICPUDescriptor RGContext::GetRTV(RGResourceHandle resource) const {
+  return resource.IsValid() ? m_Graph->m_Resources[resource.Index].View
+                            : RHICPUDescriptor{};
+}
+
+RHICPUDescriptor RGContext::GetDSV(RGResourceHandle resource) const {
+  return GetRTV(resource); // one view per resource; the type follows flags
+}
+
+// --- Graph ---
+
+RenderGraph::~RenderGraph() { Shutdown(); }
+
+void RenderGraph::Initialize(RHIDevice *device) { m_Device = device; }
+
+void RenderGraph::Shutdown() {
+  Reset();
+  m_Physical.clear();
+  m_Heaps.clear();
+  m_RtvHeap.reset();
+  m_DsvHeap.reset();
+  m_Retired.clear();
+  m_LayoutHash = 0;
+  m_Device = nullptr;
+}
+
+void RenderGraph::BeginFrame(uint64_t completedFenceValue) {
+  while (!m_Retired.empty() && m_Retired.front().FenceValue != 0 &&
+         m_Retired.front().FenceValue <= completedFenceValue) {
+    m_Retired.pop_front();
+  }
+}
+
+void RenderGraph::EndFrame(uint64_t fenceValue) {
+  for (Retired &retired : m_Retired) {
+    if (retired.FenceValue == 0)
+      retired.FenceValue = fenceValue;
+  }
+}
+
+void RenderGraph::Reset() {
+  m_Passes.clear();
+  m_Resources.clear();
+  m_Barriers.clear();
+  m_FinalBarriers.clear();
+  m_Compiled = false;
+}
+
+RGResourceHandle RenderGraph::CreateTexture(const std::string &name,
+                                            uint32_t width, uint32_t height,
+                                            RHIFormat format, uint32_t flags) {
+  Resource resource;
+  resource.Name = name;
+  bool depth = (flags & RHIResourceFlag_DepthStencil) != 0;
+  resource.Desc = RHIResourceDesc::Texture2D(
+      width, height, format, flags,
+      depth ? RHIResourceState::DepthWrite : RHIResourceState::RenderTarget,
+      name);
+  m_Resources.push_back(std::move(resource));
+  return {(uint32_t)m_Resources.size() - 1};
+}
+
+RGResourceHandle RenderGraph::Import(const std::string &name,
+                                     RHIResource *resource,
+                                     RHIResourceState state,
+                                     RHIResourceState finalState) {
+  Resource imported;
+  imported.Name = name;
+  imported.Desc = resource->GetDesc();
+  imported.Imported = resource;
+  imported.InitialState = state;
+  imported.FinalState = finalState;
+  m_Resources.push_back(std::move(imported));
+  return {(uint32_t)m_Resources.size() - 1};
+}
+
+void RenderGraph::AddPass(const std::string &name, const SetupFunction &setup,
+                          ExecuteFunction execute) {
+  Pass pass;
+  pass.Name = name;
+  pass.Execute = std::move(execute);
+  m_Passes.push_back(std::move(pass));
+
+  RGPassBuilder builder(this, (uint32_t)m_Passes.size() - 1);
+  setup(builder);
+}
+
+bool RenderGraph::IsWriteState(RHIResourceState state) {
+  return HasAnyState(state, RHIResourceState::RenderTarget |
+                                RHIResourceState::UnorderedAccess |
+                                RHIResourceState::DepthWrite |
+                                RHIResourceState::CopyDest);
+}
+
+bool RenderGraph::Compile() {
+  m_Stats.Passes = (uint32_t)m_Passes.size();
+  m_Stats.CulledPasses = 0;
+  m_Compiled = false;
+
+  CullPasses();
+  ComputeLifetimes();
+  if (!AllocateTransients())
+    return false;
+  CreateViews();
+  BuildBarriers();
+
+  m_Compiled = true;
+  return true;
+}
+
+void RenderGraph::CullPasses() {
+  // Backwards: a pass lives if it has side effects or writes something a
+  // later living pass (or the outside world, for imports) uses. Writes
+  // count as read-modify-write, so earlier writers of a live resource live.
+  std::vector<bool> needed(m_Resources.size(), false);
+  for (size_t i = 0; i < m_Resources.size(); i++)
+    needed[i] = m_Resources[i].Imported != nullptr;
+
+  for (size_t p = m_Passes.size(); p-- > 0;) {
+    Pass &pass = m_Passes[p];
+    bool alive = pass.SideEffect;
+    for (const Access &access : pass.Accesses) {
+      if (access.Write && needed[access.Resource])
+        alive = true;
+    }
+    pass.Culled = !alive;
+    if (!alive) {
+      m_Stats.CulledPasses++;
+      continue;
+    }
+    for (const Access &access : pass.Accesses)
+      needed[access.Resource] = true;
+  }
+}
+
+void RenderGraph::ComputeLifetimes() {
+  for (Resource &resource : m_Resources) {
+    resource.FirstPass = UINT32_MAX;
+    resource.LastPass = 0;
+    resource.Physical = UINT32_MAX;
+    resource.Native = resource.Imported;
+  }
+  for (uint32_t p = 0; p < m_Passes.size(); p++) {
+    if (m_Passes[p].Culled)
+      continue;
+    for (const Access &access : m_Passes[p].Accesses) {
+      Resource &resource = m_Resources[access.Resource];
+      resource.FirstPass = std::min(resource.FirstPass, p);
+      resource.LastPass = std::max(resource.LastPass, p);
+    }
+  }
+}
+
+bool RenderGraph::AllocateTransients() {
+  struct Placement {
+    uint32_t Resource;
+    uint32_t Heap; // index into usages
+    uint64_t Size;
+    uint64_t Alignment;
+    uint64_t Offset;
+  };
+  std::vector<Placement> placements;
+  for (uint32_t i = 0; i < m_Resources.size(); i++) {
+    const Resource &resource = m_Resources[i];
+    if (resource.Imported || resource.FirstPass == UINT32_MAX)
+      continue; // culled away entirely
+    RHIAllocationInfo info = m_Device->GetAllocationInfo(resource.Desc);
+    bool renderTarget = (resource.Desc.Flags & (RHIResourceFlag_RenderTarget |
+                                                RHIResourceFlag_DepthStencil));
+    placements.push_back(
+        {i, renderTarget ? 0u : 1u, info.Size, info.Alignment, 0});
+  }
+
+  // Largest first, each at the lowest offset that does not overlap a placed
+  // resource whose lifetime overlaps its own
+  std::vector<uint32_t> order(placements.size());
+  for (uint32_t i = 0; i < order.size(); i++)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return placements[a].Size > placements[b].Size;
+  });
+
+  uint64_t heapSizes[2] = {0, 0};
+  uint64_t transientBytes = 0;
+  std::vector<const Placement *> placed;
+  std::vector<const Placement *> conflicts;
+  for (uint32_t index : order) {
+    Placement &placement = placements[index];
+    const Resource &resource = m_Resources[placement.Resource];
+
+    conflicts.clear();
+    for (const Placement *other : placed) {
+      const Resource &otherResource = m_Resources[other->Resource];
+      if (other->Heap == placement.Heap &&
+          otherResource.FirstPass <= resource.LastPass &&
+          resource.FirstPass <= otherResource.LastPass) {
+        conflicts.push_back(other);
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end(),
+              [](const Placement *a, const Placement *b) {
+                return a->Offset < b->Offset;
+              });
+
+    uint64_t offset = 0;
+    for (const Placement *other : conflicts) {
+      if (offset + placement.Size <= other->Offset)
+        break;
+      uint64_t end = other->Offset + other->Size;
+      offset = std::max(offset, (end + placement.Alignment - 1) /
+                                    placement.Alignment *
+                                    placement.Alignment);
+    }
+    placement.Offset = offset;
+    heapSizes[placement.Heap] =
+        std::max(heapSizes[placement.Heap], offset + placement.Size);
+    transientBytes += placement.Size;
+    placed.push_back(&placement);
+  }
+  for (uint64_t &size : heapSizes)
+    size = (size + HeapAlignment - 1) / HeapAlignment * HeapAlignment;
+
+  // Same layout as last frame: keep the placed resources
+  uint64_t hash = HashSeed;
+  for (const Placement &placement : placements) {
+    const RHIResourceDesc &desc = m_Resources[placement.Resource].Desc;
+    hash = HashValue(desc.Width, hash);
+    hash = HashValue(desc.Height, hash);
+    hash = HashValue(desc.Format, hash);
+    hash = HashValue(desc.Flags, hash);
+    hash = HashValue(placement.Heap, hash);
+    hash = HashValue(placement.Offset, hash);
+  }
+  hash = HashValue(heapSizes, hash);
+
+  m_Stats.TransientResources = (uint32_t)placements.size();
+  m_Stats.TransientBytes = transientBytes;
+  m_Stats.HeapBytes = heapSizes[0] + heapSizes[1];
+
+  if (hash != m_LayoutHash || m_Physical.size() != placements.size()) {
+    RetirePhysical();
+    m_LayoutHash = 0;
+
+    static const RHIHeapUsage Usages[2] = {RHIHeapUsage::RenderTargets,
+                                           RHIHeapUsage::Textures};
+    uint32_t heapIndex[2] = {UINT32_MAX, UINT32_MAX};
+    for (uint32_t h = 0; h < 2; h++) {
+      if (heapSizes[h] == 0)
+        continue;
+      RHIHeapDesc heapDesc;
+      heapDesc.Size = heapSizes[h];
+      heapDesc.Usage = Usages[h];
+      heapDesc.DebugName =
+          h == 0 ? "RenderGraph Targets" : "RenderGraph Textures";
+      auto heap = m_Device->CreateHeap(heapDesc);
+      if (!heap) {
+        std::cerr << "[RenderGraph] Failed to create a "
+                  << (heapSizes[h] / 1024) << " KB heap" << std::endl;
+        return false;
+      }
+      heapIndex[h] = (uint32_t)m_Heaps.size();
+      m_Heaps.push_back(std::move(heap));
+    }
+
+    for (const Placement &placement : placements) {
+      const Resource &resource = m_Resources[placement.Resource];
+      RHIResourceDesc desc = resource.Desc;
+      RHIClearValue clearValue;
+      clearValue.Format = desc.Format;
+      desc.ClearValue = &clearValue;
+
+      PhysicalResource physical;
+      physical.Heap = heapIndex[placement.Heap];
+      physical.Offset = placement.Offset;
+      physical.Size = placement.Size;
+      physical.State = desc.InitialState;
+      physical.Resource = m_Device->CreatePlacedResource(
+          m_Heaps[physical.Heap].get(), placement.Offset, desc);
+      if (!physical.Resource) {
+        std::cerr << "[RenderGraph] Failed to place '" << resource.Name << "'"
+                  << std::endl;
+        RetirePhysical();
+        return false;
+      }
+      m_Physical.push_back(std::move(physical));
+    }
+    for (PhysicalResource &physical : m_Physical) {
+      for (const PhysicalResource &other : m_Physical) {
+        if (&other != &physical && other.Heap == physical.Heap &&
+            other.Offset < physical.Offset + physical.Size &&
+            physical.Offset < other.Offset + other.Size) {
+          physical.Aliased = true;
+        }
+      }
+    }
+    m_LayoutHash = hash;
+    m_Stats.Rebuilds++;
+  }
+
+  for (uint32_t i = 0; i < placements.size(); i++) {
+    Resource &resource = m_Resources[placements[i].Resource];
+    resource.Physical = i;
+    resource.Native = m_Physical[i].Resource.get();
+  }
+  return true;
+}
+
+void RenderGraph::CreateViews() {
+  uint32_t rtvCount = 0, dsvCount = 0;
+  for (const Resource &resource : m_Resources) {
+    if (!resource.Native)
+      continue;
+    if (resource.Desc.Flags & RHIResourceFlag_RenderTarget)
+      rtvCount++;
+    else if (resource.Desc.Flags & RHIResourceFlag_DepthStencil)
+      dsvCount++;
+  }
+
+  // Grow-only; replaced heaps may still be referenced by recorded lists
+  auto ensure = [&](std::unique_ptr<RHIDescriptorHeap> &heap, uint32_t count,
+                    RHIDescriptorHeapType type) {
+    if (count == 0 || (heap && heap->GetDesc().Count >= count))
+      return;
+    if (heap) {
+      Retired retired;
+      retired.ViewHeaps.push_back(std::move(heap));
+      m_Retired.push_back(std::move(retired));
+    }
+    heap = m_Device->CreateDescriptorHeap({type, std::max(count, 8u), false});
+  };
+  ensure(m_RtvHeap, rtvCount, RHIDescriptorHeapType::RTV);
+  ensure(m_DsvHeap, dsvCount, RHIDescriptorHeapType::DSV);
+
+  uint32_t rtvIndex = 0, dsvIndex = 0;
+  for (Resource &resource : m_Resources) {
+    resource.View = {};
+    if (!resource.Native)
+      continue;
+    if (resource.Desc.Flags & RHIResourceFlag_RenderTarget) {
+      resource.View = m_RtvHeap->GetCPU(rtvIndex++);
+      m_Device->CreateRenderTargetView(resource.Native, resource.View);
+    } else if (resource.Desc.Flags & RHIResourceFlag_DepthStencil) {
+      resource.View = m_DsvHeap->GetCPU(dsvIndex++);
+      m_Device->CreateDepthStencilView(resource.Native, resource.View);
+    }
+  }
+}
+
+void RenderGraph::BuildBarriers() {
+  std::vector<RHIResourceState> states(m_Resources.size());
+  for (size_t i = 0; i < m_Resources.size(); i++) {
+    const Resource &resource = m_Resources[i];
+    states[i] = resource.Imported ? resource.InitialState
+                : resource.Physical != UINT32_MAX
+                    ? m_Physical[resource.Physical].State
+                    : RHIResourceState::Common;
+  }
+
+  m_Stats.Barriers = 0;
+  m_Stats.AliasingBarriers = 0;
+  m_Stats.BarrierBatches = 0;
+
+  std::vector<std::pair<uint32_t, RHIResourceState>> merged;
+  for (uint32_t p = 0; p < m_Passes.size(); p++) {
+    Pass &pass = m_Passes[p];
+    pass.FirstBarrier = (uint32_t)m_Barriers.size();
+    pass.BarrierCount = 0;
+    if (pass.Culled)
+      continue;
+
+    // One state per resource: read states combine, a write wins
+    merged.clear();
+    for (const Access &access : pass.Accesses) {
+      auto it = std::find_if(merged.begin(), merged.end(), [&](auto &entry) {
+        return entry.first == access.Resource;
+      });
+      if (it == merged.end()) {
+        merged.push_back({access.Resource, access.State});
+      } else if (IsWriteState(access.State) || IsWriteState(it->second)) {
+        if (IsWriteState(it->second) && IsWriteState(access.State) &&
+            it->second != access.State) {
+          std::cerr << "[RenderGraph] Pass '" << pass.Name
+                    << "' writes '" << m_Resources[access.Resource].Name
+                    << "' in two states" << std::endl;
+        }
+        if (IsWriteState(access.State))
+          it->second = access.State;
+      } else {
+        it->second = it->second | access.State;
+      }
+    }
+
+    for (const auto &[index, state] : merged) {
+      Resource &resource = m_Resources[index];
+      if (resource.Physical != UINT32_MAX && resource.FirstPass == p &&
+          m_Physical[resource.Physical].Aliased) {
+        m_Barriers.push_back(RHIBarrier::Aliasing(nullptr, resource.Native));
+        m_Stats.AliasingBarriers++;
+      }
+
+      RHIResourceState current = states[index];
+      bool readOnly = !IsWriteState(state) && !IsWriteState(current) &&
+                      current != RHIResourceState::Common;
+      if (current == state ||
+          (readOnly && ((uint32_t)current & (uint32_t)state) ==
+                           (uint32_t)state)) {
+        continue; // already there (or in a read state that covers it)
+      }
+      m_Barriers.push_back({resource.Native, current, state});
+      states[index] = state;
+    }
+
+    pass.BarrierCount = (uint32_t)m_Barriers.size() - pass.FirstBarrier;
+    if (pass.BarrierCount > 0)
+      m_Stats.BarrierBatches++;
+  }
+  m_Stats.Barriers = (uint32_t)m_Barriers.size();
+
+  for (size_t i = 0; i < m_Resources.size(); i++) {
+    Resource &resource = m_Resources[i];
+    if (resource.Imported) {
+      if (states[i] != resource.FinalState) {
+        m_FinalBarriers.push_back(
+            {resource.Imported, states[i], resource.FinalState});
+      }
+    } else if (resource.Physical != UINT32_MAX) {
+      m_Physical[resource.Physical].State = states[i];
+    }
+  }
+  if (!m_FinalBarriers.empty()) {
+    m_Stats.Barriers += (uint32_t)m_FinalBarriers.size();
+    m_Stats.BarrierBatches++;
+  }
+}
+
+RHICommandList *RenderGraph::Execute(RHICommandList *commandList) {
+  if (!m_Compiled)
+    return commandList;
+
+  RGContext context(this);
+  context.CommandList = commandList;
+  for (Pass &pass : m_Passes) {
+    if (pass.Culled)
+      continue;
+    uint32_t gpuScope = GPUProfiler::InvalidScope;
+    if (m_GPUProfiler) {
+      gpuScope = m_GPUProfiler->BeginScope(context.CommandList,
+                                           Profiler::InternName(pass.Name));
+    }
+    if (pass.BarrierCount > 0) {
+      context.CommandList->ResourceBarriers(&m_Barriers[pass.FirstBarrier],
+                                            pass.BarrierCount);
+    }
+    if (pass.Execute)
+      pass.Execute(context);
+    // On the list the pass continued on
+    if (m_GPUProfiler)
+      m_GPUProfiler->EndScope(context.CommandList, gpuScope);
+  }
+  if (!m_FinalBarriers.empty()) {
+    context.CommandList->ResourceBarriers(m_FinalBarriers.data(),
+                                          (uint32_t)m_FinalBarriers.size());
+  }
+  return context.CommandList;
+}
+
+bool RenderGraph::IsPassCulled(const std::string &name) const {
+  for (const Pass &pass : m_Passes) {
+    if (pass.Name == name)
+      return pass.Culled;
+  }
+  return false;
+}
+
+void RenderGraph::RetirePhysical() {
+  if (m_Physical.empty() && m_Heaps.empty())
+    return;
+  // Last used by a frame that may still be in flight
+  Retired retired;
+  retired.Heaps = std::move(m_Heaps);
+  retired.Resources = std::move(m_Physical);
+  m_Retired.push_back(std::move(retired));
+  m_Physical.clear();
+  m_Heaps.clear();
+}
+
+} // namespace Forge
@@ -0,0 +1,208 @@
+#pragma once
+#include "../RHI/GPUProfiler.h"
+#include "../RHI/RHI.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Forge {
+
+struct RGResourceHandle {
+  uint32_t Index = UINT32_MAX;
+
+  bool IsValid() const { return Index != UINT32_MAX; }
+};
+
+class RenderGraph;
+
+// Passed to a pass's setup callback to declare what the pass touches. The
+// state is the one the pass needs the resource in.
+class RGPassBuilder {
+public:
+  // Read-only states may be combined (PixelShaderResource | DepthRead, ...)
+  void Read(RGResourceHandle resource,
+            RHIResourceState state = RHIResourceState::PixelShaderResource);
+  // RenderTarget, DepthWrite, UnorderedAccess or CopyDest
+  void Write(RGResourceHandle resource,
+             RHIResourceState state = RHIResourceState::RenderTarget);
+  // Keep the pass even if nothing reads what it writes
+  void SetSideEffect();
+
+private:
+  friend class RenderGraph;
+  RGPassBuilder(RenderGraph *graph, uint32_t pass)
+      : m_Graph(graph), m_Pass(pass) {}
+
+  RenderGraph *m_Graph;
+  uint32_t m_Pass;
+};
+
+// Passed to a pass's execute callback. A pass that forks command lists
+// (ParallelCommandRecorder) stores the list to continue on in CommandList.
+class RGContext {
+public:
+  RHICommandList *CommandList = nullptr;
+
+  RHIResource *GetResource(RGResourceHandle resource) const;
+  // Views the graph created for render target / depth resources
+  RHICPUDescriptor GetRTV(RGResourceHandle resource) const;
+  RHICPUDescriptor GetDSV(RGResourceHandle resource) const;
+
+private:
+  friend class RenderGraph;
+  explicit RGContext(const RenderGraph *graph) : m_Graph(graph) {}
+
+  const RenderGraph *m_Graph;
+};
+
+struct RenderGraphStats {
+  uint32_t Passes = 0; // declared
+  uint32_t CulledPasses = 0;
+  uint32_t Barriers = 0; // transitions + aliasing barriers
+  uint32_t AliasingBarriers = 0;
+  uint32_t BarrierBatches = 0; // ResourceBarriers calls
+  uint32_t TransientResources = 0;
+  uint64_t TransientBytes = 0; // what dedicated allocations would take
+  uint64_t HeapBytes = 0;      // what the aliased heaps take
+  uint64_t Rebuilds = 0;       // times the heaps / resources were recreated
+};
+
+// Frame render graph. Each frame: Reset, declare resources and passes,
+// Compile, Execute. Compile culls passes whose outputs nobody uses, merges
+// every transition a pass needs into one ResourceBarriers call and places
+// transient textures with disjoint lifetimes at the same heap offset.
+// Transient contents are undefined at their first write: that pass must
+// clear (or fully overwrite) them.
+//
+// Heaps and placed resources persist while the frame layout is unchanged;
+// replaced ones are released once the GPU is past the last frame that used
+// them (BeginFrame / EndFrame follow UploadRing).
+class RenderGraph {
+public:
+  using SetupFunction = std::function<void(RGPassBuilder &builder)>;
+  using ExecuteFunction = std::function<void(RGContext &context)>;
+
+  RenderGraph() = default;
+  ~RenderGraph();
+
+  void Initialize(RHIDevice *device);
+  // The caller waits for the GPU first
+  void Shutdown();
+
+  // completedFenceValue: last fence value the GPU finished
+  void BeginFrame(uint64_t completedFenceValue);
+  // fenceValue: value signaled after this frame's command lists
+  void EndFrame(uint64_t fenceValue);
+
+  // Starts a new graph (frame)
+  void Reset();
+
+  // Graph-owned texture, placed in an aliased heap. flags must contain
+  // RenderTarget or DepthStencil (tier 1 heaps keep them apart from other
+  // textures)
+  RGResourceHandle CreateTexture(const std::string &name, uint32_t width,
+                                 uint32_t height, RHIFormat format,
+                                 uint32_t flags);
+  // Externally owned resource. It is in `state` when the graph starts and
+  // is transitioned to `finalState` after the last pass.
+  RGResourceHandle Import(const std::string &name, RHIResource *resource,
+                          RHIResourceState state,
+                          RHIResourceState finalState);
+
+  void AddPass(const std::string &name, const SetupFunction &setup,
+               ExecuteFunction execute);
+
+  bool Compile();
+  // Returns the list the caller continues on (passes may fork lists)
+  RHICommandList *Execute(RHICommandList *commandList);
+
+  bool IsPassCulled(const std::string &name) const;
+  const RenderGraphStats &GetStats() const { return m_Stats; }
+
+  // Optional: every pass that runs is a GPU timestamp scope
+  void SetGPUProfiler(GPUProfiler *profiler) { m_GPUProfiler = profiler; }
+  GPUProfiler *GetGPUProfiler() const { return m_GPUProfiler; }
+
+private:
+  friend class RGPassBuilder;
+  friend class RGContext;
+
+  struct Access {
+    uint32_t Resource;
+    RHIResourceState State;
+    bool Write;
+  };
+
+  struct Pass {
+    std::string Name;
+    std::vector<Access> Accesses;
+    ExecuteFunction Execute;
+    bool SideEffect = false;
+    bool Culled = false;
+    uint32_t FirstBarrier = 0;
+    uint32_t BarrierCount = 0;
+  };
+
+  struct Resource {
+    std::string Name;
+    RHIResourceDesc Desc;
+    RHIResource *Imported = nullptr;
+    RHIResourceState InitialState = RHIResourceState::Common;
+    RHIResourceState FinalState = RHIResourceState::Common;
+    // Filled by Compile
+    uint32_t FirstPass = UINT32_MAX;
+    uint32_t LastPass = 0;
+    uint32_t Physical = UINT32_MAX; // index into m_Physical (transients)
+    RHIResource *Native = nullptr;
+    RHICPUDescriptor View = {}; // RTV or DSV
+  };
+
+  // One placed resource (persists across frames)
+  struct PhysicalResource {
+    std::unique_ptr<RHIResource> Resource;
+    uint32_t Heap = 0;
+    uint64_t Offset = 0;
+    uint64_t Size = 0;
+    RHIResourceState State = RHIResourceState::Common;
+    bool Aliased = false; // shares memory with another transient
+  };
+
+  // Members are destroyed bottom-up: placed resources before their heaps
+  struct Retired {
+    uint64_t FenceValue = 0; // 0 = current frame, not submitted yet
+    std::vector<std::unique_ptr<RHIHeap>> Heaps;
+    std::vector<std::unique_ptr<RHIDescriptorHeap>> ViewHeaps;
+    std::vector<PhysicalResource> Resources;
+  };
+
+  void CullPasses();
+  void ComputeLifetimes();
+  bool AllocateTransients();
+  void CreateViews();
+  void BuildBarriers();
+  void RetirePhysical();
+  static bool IsWriteState(RHIResourceState state);
+
+  RHIDevice *m_Device = nullptr;
+  std::vector<Pass> m_Passes;
+  std::vector<Resource> m_Resources;
+  std::vector<RHIBarrier> m_Barriers;
+  std::vector<RHIBarrier> m_FinalBarriers;
+  bool m_Compiled = false;
+
+  // Placement of the current layout; rebuilt only when it changes
+  uint64_t m_LayoutHash = 0;
+  std::vector<std::unique_ptr<RHIHeap>> m_Heaps;
+  std::vector<PhysicalResource> m_Physical;
+  std::unique_ptr<RHIDescriptorHeap> m_RtvHeap;
+  std::unique_ptr<RHIDescriptorHeap> m_DsvHeap;
+  std::deque<Retired> m_Retired;
+
+  GPUProfiler *m_GPUProfiler = nullptr;
+  RenderGraphStats m_Stats;
+};
+
+} // namespace Forge
@@ -0,0 +1,360 @@
+#include "ShaderCache.h"
+#include "../Core/Hash.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace Forge {
+
+namespace {
+
+constexpr uint32_t IndexMagic = 0x49435346; // "FSCI"
+constexpr uint32_t IndexVersion = 2; // 2: include manifests
+
+bool ReadFile(const std::filesystem::path &path, std::string &out) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    return false;
+  std::ostringstream stream;
+  stream << file.rdbuf();
+  out = stream.str();
+  return true;
+}
+
+bool ReadBlob(const std::filesystem::path &path, std::vector<uint8_t> &out) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    return false;
+  std::streamsize size = file.tellg();
+  file.seekg(0);
+  out.resize((size_t)size);
+  return (bool)file.read((char *)out.data(), size);
+}
+
+bool WriteBlob(const std::filesystem::path &path, const void *data,
+               size_t size) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file)
+    return false;
+  file.write((const char *)data, (std::streamsize)size);
+  return (bool)file;
+}
+
+} // namespace
+
+ShaderCache::~ShaderCache() { Shutdown(); }
+
+bool ShaderCache::Initialize(const std::filesystem::path &directory,
+                             uint64_t maxDiskBytes,
+                             const std::string &compilerTag,
+                             ShaderCompileFunction compiler) {
+  m_Directory = directory;
+  m_MaxDiskBytes = maxDiskBytes;
+  m_CompilerTagHash = HashString(compilerTag);
+  m_Compiler = std::move(compiler);
+
+  std::error_code ec;
+  std::filesystem::create_directories(m_Directory, ec);
+  if (ec) {
+    std::cerr << "[ShaderCache] Cannot create " << m_Directory.string()
+              << ": " << ec.message() << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (!LoadIndex()) { // cold start
+    m_Entries.clear();
+    m_Manifests.clear();
+  }
+  EvictLocked();
+
+  std::cout << "[ShaderCache] " << m_Entries.size() << " cached shaders in "
+            << m_Directory.string() << std::endl;
+  return true;
+}
+
+void ShaderCache::Shutdown() {
+  if (m_Directory.empty())
+    return;
+  SaveIndex();
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Entries.clear();
+  m_Manifests.clear();
+  m_Directory.clear();
+}
+
+uint64_t ShaderCache::ComputeKey(const ShaderDesc &desc,
+                                 const std::string &source) const {
+  uint64_t hash = m_CompilerTagHash;
+  hash = HashString(source, hash);
+  hash = HashString(desc.EntryPoint, hash);
+  hash = HashString(desc.Target, hash);
+  hash = HashValue(desc.Flags, hash);
+
+  // Define order does not change the output
+  std::vector<std::pair<std::string, std::string>> defines = desc.Defines;
+  std::sort(defines.begin(), defines.end());
+  for (const auto &[name, value] : defines) {
+    hash = HashString(name, hash);
+    hash = HashString(value, hash);
+  }
+  return hash;
+}
+
+uint64_t
+ShaderCache::ComputeIncludeKey(uint64_t sourceKey,
+                               const std::vector<std::string> &includes) {
+  uint64_t hash = HashValue(includes.size(), sourceKey);
+  std::string content;
+  for (const std::string &include : includes) {
+    hash = HashString(include, hash);
+    // A deleted header must not match its old content
+    if (ReadFile(include, content))
+      hash = HashString(content, hash);
+    else
+      hash = HashValue(UINT64_MAX, hash);
+  }
+  return hash;
+}
+
+std::filesystem::path ShaderCache::GetBlobPath(uint64_t key) const {
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+  return m_Directory / name;
+}
+
+ShaderBytecode
+ShaderCache::GetOrCompile(const ShaderDesc &desc,
+                          std::vector<std::string> *outIncludes) {
+  std::string source;
+  if (!ReadFile(desc.SourcePath, source)) {
+    std::cerr << "[ShaderCache] Cannot read " << desc.SourcePath << std::endl;
+    return nullptr;
+  }
+  uint64_t sourceKey = ComputeKey(desc, source);
+
+  // The include set is only known after a compile: take the one the last
+  // compile of this source reported and hash what those files hold now
+  std::vector<std::string> includes;
+  bool hasManifest = false;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Manifests.find(sourceKey);
+    if (it != m_Manifests.end()) {
+      includes = it->second;
+      hasManifest = true;
+    }
+  }
+  if (outIncludes)
+    *outIncludes = includes;
+
+  if (hasManifest) {
+    uint64_t key = ComputeIncludeKey(sourceKey, includes);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Entries.find(key);
+    if (it != m_Entries.end()) {
+      Entry &entry = it->second;
+      entry.LastUse = ++m_UseCounter;
+      m_Dirty = true;
+      if (entry.Bytecode) {
+        m_Stats.MemoryHits++;
+        return entry.Bytecode;
+      }
+      auto bytes = std::make_shared<std::vector<uint8_t>>();
+      if (ReadBlob(GetBlobPath(key), *bytes) && bytes->size() == entry.Size) {
+        m_Stats.DiskHits++;
+        entry.Bytecode = std::move(bytes);
+        return entry.Bytecode;
+      }
+      // Blob deleted or truncated behind our back
+      m_Entries.erase(it);
+    }
+  }
+
+  // Compile outside the lock so pipelines can compile in parallel
+  if (!m_Compiler)
+    return nullptr;
+  auto bytes = std::make_shared<std::vector<uint8_t>>();
+  std::string errors;
+  includes.clear();
+  bool compiled = m_Compiler(desc, source, *bytes, includes, errors);
+  // Even a failed compile reports what it opened (a broken header)
+  if (outIncludes)
+    *outIncludes = includes;
+  if (!compiled) {
+    std::cerr << "[ShaderCache] " << desc.SourcePath << " (" << desc.EntryPoint
+              << ", " << desc.Target << ") failed:\n"
+              << errors << std::endl;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stats.CompileErrors++;
+    return nullptr;
+  }
+
+  uint64_t key = ComputeIncludeKey(sourceKey, includes);
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Stats.Compiles++;
+  m_Manifests[sourceKey] = includes;
+  if (!WriteBlob(GetBlobPath(key), bytes->data(), bytes->size())) {
+    std::cerr << "[ShaderCache] Cannot write blob for " << desc.SourcePath
+              << std::endl;
+    return bytes; // still usable this session
+  }
+
+  Entry &entry = m_Entries[key];
+  entry.SourceKey = sourceKey;
+  entry.Size = bytes->size();
+  entry.LastUse = ++m_UseCounter;
+  entry.Bytecode = bytes;
+  m_Dirty = true;
+  EvictLocked();
+  return bytes;
+}
+
+void ShaderCache::EvictLocked() {
+  uint64_t total = 0;
+  for (const auto &[key, entry] : m_Entries)
+    total += entry.Size;
+
+  if (total > m_MaxDiskBytes) {
+    // Least recently used first
+    std::vector<std::pair<uint64_t, uint64_t>> order; // (lastUse, key)
+    order.reserve(m_Entries.size());
+    for (const auto &[key, entry] : m_Entries)
+      order.push_back({entry.LastUse, key});
+    std::sort(order.begin(), order.end());
+
+    for (const auto &[lastUse, key] : order) {
+      if (total <= m_MaxDiskBytes)
+        break;
+      total -= m_Entries[key].Size;
+      m_Entries.erase(key);
+      std::error_code ec;
+      std::filesystem::remove(GetBlobPath(key), ec);
+      m_Stats.Evictions++;
+      m_Dirty = true;
+    }
+  }
+
+  m_Stats.DiskBytes = total;
+  m_Stats.EntryCount = m_Entries.size();
+}
+
+bool ShaderCache::LoadIndex() {
+  std::vector<uint8_t> data;
+  if (!ReadBlob(m_Directory / "index.bin", data))
+    return false;
+
+  size_t pos = 0;
+  auto read = [&](void *out, size_t bytes) {
+    if (pos + bytes > data.size())
+      return false;
+    memcpy(out, data.data() + pos, bytes);
+    pos += bytes;
+    return true;
+  };
+
+  uint32_t magic = 0, version = 0, count = 0;
+  if (!read(&magic, 4) || magic != IndexMagic || !read(&version, 4) ||
+      version != IndexVersion || !read(&m_UseCounter, 8) || !read(&count, 4))
+    return false;
+
+  for (uint32_t i = 0; i < count; i++) {
+    uint64_t key = 0;
+    Entry entry;
+    if (!read(&key, 8) || !read(&entry.SourceKey, 8) ||
+        !read(&entry.Size, 8) || !read(&entry.LastUse, 8))
+      return false;
+    std::error_code ec;
+    if (std::filesystem::file_size(GetBlobPath(key), ec) != entry.Size || ec)
+      continue; // stale entry
+    m_Entries[key] = entry;
+  }
+
+  uint32_t manifestCount = 0;
+  if (!read(&manifestCount, 4))
+    return false;
+  for (uint32_t i = 0; i < manifestCount; i++) {
+    uint64_t sourceKey = 0;
+    uint32_t includeCount = 0;
+    if (!read(&sourceKey, 8) || !read(&includeCount, 4))
+      return false;
+    std::vector<std::string> &includes = m_Manifests[sourceKey];
+    includes.resize(includeCount);
+    for (std::string &include : includes) {
+      uint32_t length = 0;
+      if (!read(&length, 4) || pos + length > data.size())
+        return false;
+      include.assign((const char *)data.data() + pos, length);
+      pos += length;
+    }
+  }
+  return true;
+}
+
+bool ShaderCache::SaveIndex() {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (!m_Dirty || m_Directory.empty())
+    return true;
+
+  std::vector<uint8_t> data;
+  auto write = [&](const void *bytes, size_t count) {
+    size_t offset = data.size();
+    data.resize(offset + count);
+    memcpy(data.data() + offset, bytes, count);
+  };
+  uint32_t count = (uint32_t)m_Entries.size();
+  write(&IndexMagic, 4);
+  write(&IndexVersion, 4);
+  write(&m_UseCounter, 8);
+  write(&count, 4);
+  for (const auto &[key, entry] : m_Entries) {
+    write(&key, 8);
+    write(&entry.SourceKey, 8);
+    write(&entry.Size, 8);
+    write(&entry.LastUse, 8);
+  }
+
+  // Only manifests that still lead to a cached blob
+  std::vector<uint64_t> sourceKeys;
+  for (const auto &[key, entry] : m_Entries) {
+    if (m_Manifests.count(entry.SourceKey))
+      sourceKeys.push_back(entry.SourceKey);
+  }
+  std::sort(sourceKeys.begin(), sourceKeys.end());
+  sourceKeys.erase(std::unique(sourceKeys.begin(), sourceKeys.end()),
+                   sourceKeys.end());
+  uint32_t manifestCount = (uint32_t)sourceKeys.size();
+  write(&manifestCount, 4);
+  for (uint64_t sourceKey : sourceKeys) {
+    const std::vector<std::string> &includes = m_Manifests[sourceKey];
+    uint32_t includeCount = (uint32_t)includes.size();
+    write(&sourceKey, 8);
+    write(&includeCount, 4);
+    for (const std::string &include : includes) {
+      uint32_t length = (uint32_t)include.size();
+      write(&length, 4);
+      write(include.data(), length);
+    }
+  }
+
+  // Write-then-rename so a crash never leaves a half-written index
+  std::filesystem::path temp = m_Directory / "index.tmp";
+  if (!WriteBlob(temp, data.data(), data.size()))
+    return false;
+  std::error_code ec;
+  std::filesystem::rename(temp, m_Directory / "index.bin", ec);
+  if (ec)
+    return false;
+  m_Dirty = false;
+  return true;
+}
+
+ShaderCacheStats ShaderCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Stats;
+}
+
+} // namespace Forge
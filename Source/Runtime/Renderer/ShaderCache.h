@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Forge {
+
+struct ShaderDesc {
+  std::string SourcePath;
+  std::string EntryPoint;
+  std::string Target; // e.g. "vs_5_0"
+  std::vector<std::pair<std::string, std::string>> Defines;
+  uint32_t Flags = 0; // compiler flags, part of the key
+};
+
+using ShaderBytecode = std::shared_ptr<const std::vector<uint8_t>>;
+
+// Backend compiler: source text -> bytecode. Returns false + errors.
+// outIncludes: path of every file pulled in through #include.
+using ShaderCompileFunction = std::function<bool(
+    const ShaderDesc &desc, const std::string &source,
+    std::vector<uint8_t> &outBytecode, std::vector<std::string> &outIncludes,
+    std::string &outErrors)>;
+
+struct ShaderCacheStats {
+  uint64_t MemoryHits = 0;
+  uint64_t DiskHits = 0;
+  uint64_t Compiles = 0;
+  uint64_t CompileErrors = 0;
+  uint64_t Evictions = 0;
+  uint64_t DiskBytes = 0;
+  uint64_t EntryCount = 0;
+};
+
+// Content-addressed shader bytecode cache shared by every pipeline.
+// Source key = hash(source text, entry point, target, sorted defines,
+// flags, compiler tag). The include set reported by the last compile of
+// a source key is kept as a manifest; the bytecode key folds in the path
+// and content of every included file, so editing a header recompiles.
+// Bytecode lives in <dir>/<key>.bin with an LRU index.
+// Platform-neutral: the compiler is injected.
+class ShaderCache {
+public:
+  ShaderCache() = default;
+  ~ShaderCache();
+
+  // compilerTag: changes whenever the compiler / its version changes
+  bool Initialize(const std::filesystem::path &directory,
+                  uint64_t maxDiskBytes, const std::string &compilerTag,
+                  ShaderCompileFunction compiler);
+  void Shutdown();
+
+  // Returns nullptr on compile failure (errors go to the log).
+  // outIncludes: the include set of the returned bytecode (hot reload).
+  ShaderBytecode GetOrCompile(const ShaderDesc &desc,
+                              std::vector<std::string> *outIncludes = nullptr);
+
+  // Source key for a given root source text (includes not folded in)
+  uint64_t ComputeKey(const ShaderDesc &desc, const std::string &source) const;
+
+  bool SaveIndex();
+  ShaderCacheStats GetStats() const;
+
+private:
+  struct Entry {
+    uint64_t SourceKey = 0; // manifest it was compiled from
+    uint64_t Size = 0;
+    uint64_t LastUse = 0;
+    ShaderBytecode Bytecode; // loaded lazily
+  };
+
+  bool LoadIndex();
+  std::filesystem::path GetBlobPath(uint64_t key) const;
+  // Source key + path and current content of every include
+  static uint64_t ComputeIncludeKey(uint64_t sourceKey,
+                                    const std::vector<std::string> &includes);
+  void EvictLocked();
+
+  std::filesystem::path m_Directory;
+  uint64_t m_MaxDiskBytes = 0;
+  uint64_t m_CompilerTagHash = 0;
+  ShaderCompileFunction m_Compiler;
+
+  mutable std::mutex m_Mutex;
+  std::unordered_map<uint64_t, Entry> m_Entries;
+  // Source key -> include set of its last compile
+  std::unordered_map<uint64_t, std::vector<std::string>> m_Manifests;
+  uint64_t m_UseCounter = 0;
+  bool m_Dirty = false;
+  ShaderCacheStats m_Stats;
+};
+
+} // namespace Forge
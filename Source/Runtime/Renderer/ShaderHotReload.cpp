@@ -0,0 +1,203 @@
+#include "ShaderHotReload.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+namespace Forge {
+
+ShaderHotReload::~ShaderHotReload() { Shutdown(); }
+
+void ShaderHotReload::Initialize(ShaderCache *shaderCache,
+                                 PipelineCache *pipelineCache,
+                                 uint32_t pollIntervalMs) {
+  m_ShaderCache = shaderCache;
+  m_PipelineCache = pipelineCache;
+  m_PollInterval = std::chrono::milliseconds(pollIntervalMs);
+  m_Quit = false;
+  m_Worker = std::thread(&ShaderHotReload::WorkerMain, this);
+}
+
+void ShaderHotReload::Shutdown() {
+  if (m_Worker.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Quit = true;
+    }
+    m_WakeCondition.notify_all();
+    m_Worker.join();
+  }
+  m_Pending.clear();
+
+  std::lock_guard<std::mutex> lock(m_WatchMutex);
+  m_Pipelines.clear();
+  m_Watcher = FileWatcher();
+  m_ShaderCache = nullptr;
+  m_PipelineCache = nullptr;
+}
+
+RHIPipelineState *
+ShaderHotReload::Build(const ReloadablePipeline &pipeline,
+                       std::vector<std::string> &outDependencies) {
+  std::vector<std::string> vsIncludes, psIncludes;
+  ShaderBytecode vs = m_ShaderCache->GetOrCompile(pipeline.m_VS, &vsIncludes);
+  ShaderBytecode ps = m_ShaderCache->GetOrCompile(pipeline.m_PS, &psIncludes);
+
+  outDependencies = {pipeline.m_VS.SourcePath, pipeline.m_PS.SourcePath};
+  outDependencies.insert(outDependencies.end(), vsIncludes.begin(),
+                         vsIncludes.end());
+  outDependencies.insert(outDependencies.end(), psIncludes.begin(),
+                         psIncludes.end());
+  std::sort(outDependencies.begin(), outDependencies.end());
+  outDependencies.erase(
+      std::unique(outDependencies.begin(), outDependencies.end()),
+      outDependencies.end());
+  if (!vs || !ps)
+    return nullptr;
+
+  // The PSO copies the bytecode; the blobs stay cached either way
+  RHIGraphicsPipelineDesc desc = pipeline.m_Desc;
+  desc.VS = {vs->data(), vs->size()};
+  desc.PS = {ps->data(), ps->size()};
+  return m_PipelineCache->GetOrCreate(desc);
+}
+
+ReloadablePipeline *
+ShaderHotReload::CreatePipeline(const RHIGraphicsPipelineDesc &desc,
+                                const ShaderDesc &vs, const ShaderDesc &ps) {
+  if (!m_ShaderCache || !m_PipelineCache)
+    return nullptr;
+
+  auto pipeline = std::make_unique<ReloadablePipeline>();
+  pipeline->m_Desc = desc;
+  pipeline->m_VS = vs;
+  pipeline->m_PS = ps;
+  std::vector<std::string> dependencies;
+  pipeline->m_Current = Build(*pipeline, dependencies);
+  if (!pipeline->m_Current)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(m_WatchMutex);
+  UpdateDependenciesLocked(*pipeline, std::move(dependencies), true);
+  m_Pipelines.push_back(std::move(pipeline));
+  return m_Pipelines.back().get();
+}
+
+void ShaderHotReload::UpdateDependenciesLocked(
+    ReloadablePipeline &pipeline, std::vector<std::string> dependencies,
+    bool replace) {
+  // Both lists are sorted and unique
+  std::vector<std::string> previous = std::move(pipeline.m_Dependencies);
+  if (!replace) {
+    std::vector<std::string> merged;
+    std::set_union(previous.begin(), previous.end(), dependencies.begin(),
+                   dependencies.end(), std::back_inserter(merged));
+    dependencies = std::move(merged);
+  }
+  pipeline.m_Dependencies = std::move(dependencies);
+
+  for (const std::string &path : pipeline.m_Dependencies) {
+    if (!m_Watcher.IsWatching(path))
+      m_Watcher.Watch(path);
+  }
+  // Headers no longer included by any pipeline
+  for (const std::string &path : previous) {
+    if (std::binary_search(pipeline.m_Dependencies.begin(),
+                           pipeline.m_Dependencies.end(), path))
+      continue;
+    bool used = std::any_of(
+        m_Pipelines.begin(), m_Pipelines.end(), [&](const auto &other) {
+          return std::binary_search(other->m_Dependencies.begin(),
+                                    other->m_Dependencies.end(), path);
+        });
+    if (!used)
+      m_Watcher.Unwatch(path);
+  }
+}
+
+void ShaderHotReload::Update() {
+  if (!m_ShaderCache)
+    return;
+
+  std::vector<PendingSwap> swaps;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    swaps.swap(m_Pending);
+  }
+
+  for (const PendingSwap &swap : swaps) {
+    // Whitespace-only edits hash to the same PSO: nothing to swap
+    if (swap.State == swap.Pipeline->m_Current)
+      continue;
+    swap.Pipeline->m_Current = swap.State;
+    swap.Pipeline->m_Version++;
+    std::cout << "[ShaderHotReload] Reloaded '"
+              << swap.Pipeline->m_Desc.DebugName << "' (v"
+              << swap.Pipeline->m_Version << ")" << std::endl;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stats.Reloads++;
+  }
+}
+
+void ShaderHotReload::WorkerMain() {
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  while (!m_WakeCondition.wait_for(lock, m_PollInterval,
+                                   [this] { return m_Quit; })) {
+    lock.unlock();
+    PollAndRebuild();
+    lock.lock();
+  }
+}
+
+void ShaderHotReload::PollAndRebuild() {
+  std::vector<ReloadablePipeline *> dirty;
+  {
+    std::lock_guard<std::mutex> lock(m_WatchMutex);
+    std::vector<std::string> changed;
+    m_Watcher.Poll(changed);
+    std::sort(changed.begin(), changed.end());
+    for (const auto &pipeline : m_Pipelines) {
+      bool anyChanged = std::any_of(
+          pipeline->m_Dependencies.begin(), pipeline->m_Dependencies.end(),
+          [&](const std::string &path) {
+            return std::binary_search(changed.begin(), changed.end(), path);
+          });
+      if (anyChanged)
+        dirty.push_back(pipeline.get());
+    }
+  }
+
+  // Descs are immutable after CreatePipeline, so no lock while compiling
+  std::vector<PendingSwap> swaps;
+  uint64_t failures = 0;
+  for (ReloadablePipeline *pipeline : dirty) {
+    std::vector<std::string> dependencies;
+    RHIPipelineState *state = Build(*pipeline, dependencies);
+    {
+      // A failed build may not report every include: keep the old ones
+      std::lock_guard<std::mutex> lock(m_WatchMutex);
+      UpdateDependenciesLocked(*pipeline, std::move(dependencies),
+                               state != nullptr);
+    }
+    if (state) {
+      swaps.push_back({pipeline, state});
+    } else {
+      failures++;
+      std::cerr << "[ShaderHotReload] '" << pipeline->m_Desc.DebugName
+                << "' failed to rebuild; keeping the previous pipeline"
+                << std::endl;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Pending.insert(m_Pending.end(), swaps.begin(), swaps.end());
+  m_Stats.Polls++;
+  m_Stats.Failures += failures;
+}
+
+ShaderHotReloadStats ShaderHotReload::GetStats() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Stats;
+}
+
+} // namespace Forge
@@ -0,0 +1,105 @@
+#pragma once
+#include "../Core/FileWatcher.h"
+#include "../RHI/PipelineCache.h"
+#include "ShaderCache.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Forge {
+
+// A pipeline whose shaders are rebuilt when their source changes. Get()
+// only changes inside ShaderHotReload::Update (between frames), so a
+// pointer fetched while recording stays valid for the whole frame.
+class ReloadablePipeline {
+public:
+  RHIPipelineState *Get() const { return m_Current; }
+  uint32_t GetVersion() const { return m_Version; } // bumps on every swap
+
+private:
+  friend class ShaderHotReload;
+
+  // Everything but VS/PS bytecode (filled in on each build). InputLayout
+  // semantic names must outlive the pipeline (string literals).
+  RHIGraphicsPipelineDesc m_Desc;
+  ShaderDesc m_VS;
+  ShaderDesc m_PS;
+  // VS/PS sources + their includes (ShaderHotReload::m_WatchMutex)
+  std::vector<std::string> m_Dependencies;
+  RHIPipelineState *m_Current = nullptr; // owned by the PipelineCache
+  uint32_t m_Version = 0;
+};
+
+struct ShaderHotReloadStats {
+  uint64_t Polls = 0;
+  uint64_t Reloads = 0;  // pipelines swapped
+  uint64_t Failures = 0; // compile / PSO errors (old pipeline kept)
+};
+
+// Watches shader sources and every file they #include (as reported by the
+// last build) and rebuilds dependent pipelines on its own worker thread
+// (not the shared JobSystem: a long compile must not hold up engine jobs,
+// and the pool has no workers on single-core machines). The render
+// thread only calls Update(), which swaps finished pipelines in; it never
+// waits for a compile. Compile errors keep the previous pipeline.
+class ShaderHotReload {
+public:
+  ShaderHotReload() = default;
+  ~ShaderHotReload();
+
+  void Initialize(ShaderCache *shaderCache, PipelineCache *pipelineCache,
+                  uint32_t pollIntervalMs = 250);
+  // Stops the worker (after its current rebuild), releases every handle
+  void Shutdown();
+
+  // First build is synchronous (through the caches). Returns nullptr if it
+  // fails; the handle is owned by ShaderHotReload.
+  ReloadablePipeline *CreatePipeline(const RHIGraphicsPipelineDesc &desc,
+                                     const ShaderDesc &vs,
+                                     const ShaderDesc &ps);
+
+  // Render thread, between frames
+  void Update();
+
+  ShaderCache *GetShaderCache() const { return m_ShaderCache; }
+  PipelineCache *GetPipelineCache() const { return m_PipelineCache; }
+  ShaderHotReloadStats GetStats() const;
+
+private:
+  struct PendingSwap {
+    ReloadablePipeline *Pipeline;
+    RHIPipelineState *State;
+  };
+
+  RHIPipelineState *Build(const ReloadablePipeline &pipeline,
+                          std::vector<std::string> &outDependencies);
+  // Replaces (build succeeded) or extends the pipeline's dependencies and
+  // watches / unwatches files to match
+  void UpdateDependenciesLocked(ReloadablePipeline &pipeline,
+                                std::vector<std::string> dependencies,
+                                bool replace);
+  void WorkerMain();
+  void PollAndRebuild();
+
+  ShaderCache *m_ShaderCache = nullptr;
+  PipelineCache *m_PipelineCache = nullptr;
+  std::chrono::milliseconds m_PollInterval{250};
+  std::thread m_Worker;
+
+  // Pipelines and watcher are shared with the worker
+  std::mutex m_WatchMutex;
+  std::vector<std::unique_ptr<ReloadablePipeline>> m_Pipelines;
+  FileWatcher m_Watcher;
+
+  mutable std::mutex m_Mutex;
+  std::condition_variable m_WakeCondition;
+  bool m_Quit = false;
+  std::vector<PendingSwap> m_Pending;
+  ShaderHotReloadStats m_Stats;
+};
+
+} // namespace Forge
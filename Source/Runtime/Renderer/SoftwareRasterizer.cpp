@@ -0,0 +1,609 @@
+#include "SoftwareRasterizer.h"
+#include "../Core/JobSystem.h"
+#include <algorithm>
+#include <cctype>
+#include <cfloat>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Forge {
+
+// --- RasterImage ---
+
+bool RasterImage::WritePPM(const std::string &path) const {
+  std::ofstream file(path, std::ios::binary);
+  if (!file)
+    return false;
+  file << "P6\n" << Width << " " << Height << "\n255\n";
+  std::vector<uint8_t> rgb((size_t)Width * Height * 3);
+  for (size_t i = 0; i < Pixels.size(); i++) {
+    rgb[i * 3 + 0] = (uint8_t)(Pixels[i]);
+    rgb[i * 3 + 1] = (uint8_t)(Pixels[i] >> 8);
+    rgb[i * 3 + 2] = (uint8_t)(Pixels[i] >> 16);
+  }
+  file.write((const char *)rgb.data(), (std::streamsize)rgb.size());
+  return (bool)file;
+}
+
+bool RasterImage::ReadPPM(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    return false;
+
+  // Header tokens, '#' comments allowed between them
+  auto token = [&]() {
+    std::string value;
+    while (file) {
+      int c = file.get();
+      if (c == '#') {
+        while (file && file.get() != '\n') {
+        }
+      } else if (std::isspace(c)) {
+        if (!value.empty())
+          return value;
+      } else if (c != EOF) {
+        value.push_back((char)c);
+      }
+    }
+    return value;
+  };
+  auto dimension = [&](uint32_t &out) {
+    std::string value = token();
+    auto [end, error] =
+        std::from_chars(value.data(), value.data() + value.size(), out);
+    return error == std::errc() && end == value.data() + value.size() &&
+           out > 0 && out <= MaxPPMDimension;
+  };
+  uint32_t width = 0, height = 0;
+  if (token() != "P6" || !dimension(width) || !dimension(height) ||
+      token() != "255")
+    return false;
+
+  std::vector<uint8_t> rgb((size_t)width * height * 3);
+  file.read((char *)rgb.data(), (std::streamsize)rgb.size());
+  if (!file)
+    return false;
+
+  Width = width;
+  Height = height;
+  Pixels.resize((size_t)width * height);
+  for (size_t i = 0; i < Pixels.size(); i++) {
+    Pixels[i] = rgb[i * 3] | (rgb[i * 3 + 1] << 8) | (rgb[i * 3 + 2] << 16) |
+                0xff000000u;
+  }
+  return true;
+}
+
+uint64_t RasterImage::CountDifferences(const RasterImage &other,
+                                       uint32_t tolerance) const {
+  if (Width != other.Width || Height != other.Height)
+    return (uint64_t)std::max(Width, other.Width) *
+           std::max(Height, other.Height);
+  uint64_t count = 0;
+  for (size_t i = 0; i < Pixels.size(); i++) {
+    for (uint32_t shift = 0; shift < 24; shift += 8) {
+      int a = (Pixels[i] >> shift) & 0xff;
+      int b = (other.Pixels[i] >> shift) & 0xff;
+      if ((uint32_t)std::abs(a - b) > tolerance) {
+        count++;
+        break;
+      }
+    }
+  }
+  return count;
+}
+
+// --- SoftwareRasterizer ---
+
+// Direction towards the light (world space) and the ambient term
+static constexpr float LightDirection[3] = {-0.37f, 0.86f, -0.35f};
+static constexpr float Ambient = 0.35f;
+
+static void Multiply(const float *a, const float *b, float *out) {
+  for (int row = 0; row < 4; row++) {
+    for (int column = 0; column < 4; column++) {
+      out[row * 4 + column] = a[row * 4 + 0] * b[0 * 4 + column] +
+                              a[row * 4 + 1] * b[1 * 4 + column] +
+                              a[row * 4 + 2] * b[2 * 4 + column] +
+                              a[row * 4 + 3] * b[3 * 4 + column];
+    }
+  }
+}
+
+bool SoftwareRasterizer::IsSIMDAvailable() {
+#if defined(__AVX2__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void SoftwareRasterizer::Begin(uint32_t width, uint32_t height,
+                               const float viewProj[16],
+                               const float clearColor[4]) {
+  m_Width = std::max(width, 1u);
+  m_Height = std::max(height, 1u);
+  m_TilesX = (m_Width + TileSize - 1) / TileSize;
+  m_TilesY = (m_Height + TileSize - 1) / TileSize;
+  m_Stride = m_TilesX * TileSize;
+  std::copy(viewProj, viewProj + 16, m_ViewProj);
+  m_ClearColor = PackRGBA8(clearColor);
+
+  // Tiles clear themselves in Render
+  m_Color.resize((size_t)m_Stride * m_TilesY * TileSize);
+  m_Depth.resize(m_Color.size());
+  m_Primitives.clear();
+  m_Stats = {};
+}
+
+void SoftwareRasterizer::DrawTriangles(const float *positions,
+                                       uint32_t vertexCount, uint32_t stride,
+                                       const float world[16],
+                                       const float color[4],
+                                       bool cullBackFaces) {
+  float worldViewProj[16];
+  Multiply(world, m_ViewProj, worldViewProj);
+  const float *m = worldViewProj;
+  const uint8_t *bytes = (const uint8_t *)positions;
+
+  for (uint32_t i = 0; i + 2 < vertexCount; i += 3) {
+    ClipPrimitive primitive;
+    float worldPos[3][3];
+    for (int v = 0; v < 3; v++) {
+      const float *p = (const float *)(bytes + (size_t)(i + v) * stride);
+      primitive.V[v] = {p[0] * m[0] + p[1] * m[4] + p[2] * m[8] + m[12],
+                        p[0] * m[1] + p[1] * m[5] + p[2] * m[9] + m[13],
+                        p[0] * m[2] + p[1] * m[6] + p[2] * m[10] + m[14],
+                        p[0] * m[3] + p[1] * m[7] + p[2] * m[11] + m[15]};
+      for (int c = 0; c < 3; c++) {
+        worldPos[v][c] = p[0] * world[0 * 4 + c] + p[1] * world[1 * 4 + c] +
+                         p[2] * world[2 * 4 + c] + world[12 + c];
+      }
+    }
+
+    // Flat shading: clockwise (front) faces get cross(e1, e2) as normal,
+    // back faces the opposite one
+    float e1[3], e2[3];
+    for (int c = 0; c < 3; c++) {
+      e1[c] = worldPos[1][c] - worldPos[0][c];
+      e2[c] = worldPos[2][c] - worldPos[0][c];
+    }
+    float normal[3] = {e1[1] * e2[2] - e1[2] * e2[1],
+                       e1[2] * e2[0] - e1[0] * e2[2],
+                       e1[0] * e2[1] - e1[1] * e2[0]};
+    float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] +
+                             normal[2] * normal[2]);
+    float facing = 0.0f;
+    if (length > 0.0f) {
+      facing = (normal[0] * LightDirection[0] + normal[1] * LightDirection[1] +
+                normal[2] * LightDirection[2]) /
+               length;
+    }
+    float front = Ambient + (1.0f - Ambient) * std::max(facing, 0.0f);
+    float back = Ambient + (1.0f - Ambient) * std::max(-facing, 0.0f);
+    float frontColor[4] = {color[0] * front, color[1] * front,
+                           color[2] * front, color[3]};
+    float backColor[4] = {color[0] * back, color[1] * back, color[2] * back,
+                          color[3]};
+    primitive.Color = PackRGBA8(frontColor);
+    primitive.BackColor = PackRGBA8(backColor);
+    primitive.Line = false;
+    primitive.CullBackFaces = cullBackFaces;
+    m_Primitives.push_back(primitive);
+    m_Stats.Triangles++;
+  }
+}
+
+void SoftwareRasterizer::DrawLines(const float *positions,
+                                   uint32_t vertexCount, uint32_t stride,
+                                   const float world[16],
+                                   const float color[4]) {
+  float worldViewProj[16];
+  Multiply(world, m_ViewProj, worldViewProj);
+  const float *m = worldViewProj;
+  const uint8_t *bytes = (const uint8_t *)positions;
+
+  for (uint32_t i = 0; i + 1 < vertexCount; i += 2) {
+    ClipPrimitive primitive = {};
+    for (int v = 0; v < 2; v++) {
+      const float *p = (const float *)(bytes + (size_t)(i + v) * stride);
+      primitive.V[v] = {p[0] * m[0] + p[1] * m[4] + p[2] * m[8] + m[12],
+                        p[0] * m[1] + p[1] * m[5] + p[2] * m[9] + m[13],
+                        p[0] * m[2] + p[1] * m[6] + p[2] * m[10] + m[14],
+                        p[0] * m[3] + p[1] * m[7] + p[2] * m[11] + m[15]};
+    }
+    primitive.Color = primitive.BackColor = PackRGBA8(color);
+    primitive.Line = true;
+    m_Primitives.push_back(primitive);
+    m_Stats.Triangles += 2;
+  }
+}
+
+void SoftwareRasterizer::ToScreen(const ClipVertex &v, float (&out)[3]) const {
+  float invW = 1.0f / v.W;
+  out[0] = (v.X * invW * 0.5f + 0.5f) * (float)m_Width;
+  out[1] = (0.5f - v.Y * invW * 0.5f) * (float)m_Height;
+  out[2] = v.Z * invW;
+}
+
+void SoftwareRasterizer::Render(JobSystem *jobs) {
+  const uint32_t tileCount = m_TilesX * m_TilesY;
+  const uint32_t primitiveCount = (uint32_t)m_Primitives.size();
+
+  // 1. Setup + binning, in submission-ordered chunks
+  uint32_t chunkCount =
+      std::clamp((primitiveCount + 511) / 512, primitiveCount ? 1u : 0u, 64u);
+  if (m_Chunks.size() < chunkCount)
+    m_Chunks.resize(chunkCount);
+  uint32_t chunkSize =
+      chunkCount ? (primitiveCount + chunkCount - 1) / chunkCount : 0;
+
+  auto setup = [&](uint32_t begin, uint32_t end, uint32_t) {
+    for (uint32_t c = begin; c < end; c++) {
+      uint32_t first = c * chunkSize;
+      SetupChunk(m_Chunks[c], first,
+                 std::min(first + chunkSize, primitiveCount));
+    }
+  };
+  if (jobs)
+    jobs->ParallelFor(chunkCount, 1, setup);
+  else
+    setup(0, chunkCount, 0);
+
+  // 2. Tiles in parallel; each walks the chunks in submission order
+  m_Stats.Chunks = chunkCount;
+  auto raster = [&](uint32_t begin, uint32_t end, uint32_t) {
+    for (uint32_t tile = begin; tile < end; tile++)
+      RasterizeTile(tile);
+  };
+  m_ActiveChunks = chunkCount;
+  if (jobs)
+    jobs->ParallelFor(tileCount, 1, raster);
+  else
+    raster(0, tileCount, 0);
+
+  m_Stats.Tiles = tileCount;
+  m_Stats.SIMD = m_UseSIMD && IsSIMDAvailable();
+  for (uint32_t c = 0; c < chunkCount; c++) {
+    m_Stats.Clipped += m_Chunks[c].Clipped;
+    m_Stats.Culled += m_Chunks[c].Culled;
+    m_Stats.Binned += m_Chunks[c].Binned;
+  }
+}
+
+void SoftwareRasterizer::SetupChunk(Chunk &chunk, uint32_t begin,
+                                    uint32_t end) {
+  chunk.Triangles.clear();
+  chunk.Bins.resize((size_t)m_TilesX * m_TilesY);
+  for (auto &bin : chunk.Bins)
+    bin.clear();
+  chunk.Clipped = chunk.Culled = chunk.Binned = 0;
+
+  for (uint32_t i = begin; i < end; i++) {
+    const ClipPrimitive &primitive = m_Primitives[i];
+    if (primitive.Line) {
+      SetupLine(chunk, primitive);
+      continue;
+    }
+
+    // Near plane (z >= 0) clip; the other planes are handled by the
+    // screen-space bounding box
+    ClipVertex polygon[4];
+    uint32_t count = 0;
+    bool clipped = false;
+    for (int v = 0; v < 3; v++) {
+      const ClipVertex &a = primitive.V[v];
+      const ClipVertex &b = primitive.V[(v + 1) % 3];
+      if (a.Z >= 0.0f)
+        polygon[count++] = a;
+      if ((a.Z >= 0.0f) != (b.Z >= 0.0f)) {
+        float t = a.Z / (a.Z - b.Z);
+        polygon[count++] = {a.X + (b.X - a.X) * t, a.Y + (b.Y - a.Y) * t,
+                            0.0f, a.W + (b.W - a.W) * t};
+        clipped = true;
+      }
+    }
+    if (count < 3) {
+      chunk.Culled++;
+      continue;
+    }
+    if (clipped)
+      chunk.Clipped++;
+
+    float screen[4][3];
+    for (uint32_t v = 0; v < count; v++)
+      ToScreen(polygon[v], screen[v]);
+    for (uint32_t v = 1; v + 1 < count; v++) {
+      SetupTriangle(chunk, screen[0], screen[v], screen[v + 1],
+                    primitive.Color, primitive.BackColor,
+                    primitive.CullBackFaces);
+    }
+  }
+}
+
+void SoftwareRasterizer::SetupLine(Chunk &chunk, const ClipPrimitive &line) {
+  ClipVertex a = line.V[0], b = line.V[1];
+  if (a.Z < 0.0f && b.Z < 0.0f) {
+    chunk.Culled += 2;
+    return;
+  }
+  if (a.Z < 0.0f || b.Z < 0.0f) {
+    ClipVertex &outside = a.Z < 0.0f ? a : b;
+    const ClipVertex &inside = a.Z < 0.0f ? b : a;
+    float t = inside.Z / (inside.Z - outside.Z);
+    outside = {inside.X + (outside.X - inside.X) * t,
+               inside.Y + (outside.Y - inside.Y) * t, 0.0f,
+               inside.W + (outside.W - inside.W) * t};
+    chunk.Clipped++;
+  }
+
+  float p0[3], p1[3];
+  ToScreen(a, p0);
+  ToScreen(b, p1);
+  float dx = p1[0] - p0[0], dy = p1[1] - p0[1];
+  float length = std::sqrt(dx * dx + dy * dy);
+  if (length < 1e-4f) {
+    chunk.Culled += 2;
+    return;
+  }
+  // One pixel wide quad around the segment
+  float nx = -dy / length * 0.5f, ny = dx / length * 0.5f;
+  float q0[3] = {p0[0] + nx, p0[1] + ny, p0[2]};
+  float q1[3] = {p1[0] + nx, p1[1] + ny, p1[2]};
+  float q2[3] = {p1[0] - nx, p1[1] - ny, p1[2]};
+  float q3[3] = {p0[0] - nx, p0[1] - ny, p0[2]};
+  SetupTriangle(chunk, q0, q1, q2, line.Color, line.Color, false);
+  SetupTriangle(chunk, q0, q2, q3, line.Color, line.Color, false);
+}
+
+void SoftwareRasterizer::SetupTriangle(Chunk &chunk, const float (&v0)[3],
+                                       const float (&v1)[3],
+                                       const float (&v2)[3], uint32_t color,
+                                       uint32_t backColor, bool cull) {
+  const float *v[3] = {v0, v1, v2};
+
+  // Edge v0 -> v1 evaluated at v2: twice the signed area, positive for
+  // clockwise (front-facing) triangles on a y-down screen
+  auto edge = [](const float *a, const float *b, float &A, float &B,
+                 float &C) {
+    A = a[1] - b[1];
+    B = b[0] - a[0];
+    C = -(A * a[0] + B * a[1]);
+  };
+  float A, B, C;
+  edge(v[0], v[1], A, B, C);
+  float area = A * v[2][0] + B * v[2][1] + C;
+  if (area == 0.0f || !std::isfinite(area) || (cull && area < 0.0f)) {
+    chunk.Culled++;
+    return;
+  }
+  if (area < 0.0f) {
+    std::swap(v[1], v[2]);
+    area = -area;
+    color = backColor;
+  }
+
+  ScreenTriangle triangle;
+  for (int e = 0; e < 3; e++) {
+    // Edge e is opposite vertex e
+    edge(v[(e + 1) % 3], v[(e + 2) % 3], triangle.A[e], triangle.B[e],
+         triangle.C[e]);
+    bool topLeft =
+        triangle.A[e] > 0.0f || (triangle.A[e] == 0.0f && triangle.B[e] > 0.0f);
+    triangle.Bias[e] = topLeft ? -FLT_MIN : 0.0f;
+  }
+  float invArea = 1.0f / area;
+  triangle.ZA = (triangle.A[0] * v[0][2] + triangle.A[1] * v[1][2] +
+                 triangle.A[2] * v[2][2]) *
+                invArea;
+  triangle.ZB = (triangle.B[0] * v[0][2] + triangle.B[1] * v[1][2] +
+                 triangle.B[2] * v[2][2]) *
+                invArea;
+  triangle.ZC = (triangle.C[0] * v[0][2] + triangle.C[1] * v[1][2] +
+                 triangle.C[2] * v[2][2]) *
+                invArea;
+  triangle.Color = color;
+
+  float minX = std::min({v[0][0], v[1][0], v[2][0]});
+  float maxX = std::max({v[0][0], v[1][0], v[2][0]});
+  float minY = std::min({v[0][1], v[1][1], v[2][1]});
+  float maxY = std::max({v[0][1], v[1][1], v[2][1]});
+  if (maxX < 0.0f || maxY < 0.0f || minX >= (float)m_Width ||
+      minY >= (float)m_Height) {
+    chunk.Culled++;
+    return;
+  }
+  triangle.MinX = (int32_t)std::max(std::floor(minX), 0.0f);
+  triangle.MinY = (int32_t)std::max(std::floor(minY), 0.0f);
+  triangle.MaxX = (int32_t)std::min(std::ceil(maxX), (float)m_Width - 1);
+  triangle.MaxY = (int32_t)std::min(std::ceil(maxY), (float)m_Height - 1);
+
+  uint32_t index = (uint32_t)chunk.Triangles.size();
+  chunk.Triangles.push_back(triangle);
+
+  // Bin into every tile the box touches unless one edge rejects all four
+  // tile corners
+  for (int32_t ty = triangle.MinY / (int32_t)TileSize;
+       ty <= triangle.MaxY / (int32_t)TileSize; ty++) {
+    for (int32_t tx = triangle.MinX / (int32_t)TileSize;
+         tx <= triangle.MaxX / (int32_t)TileSize; tx++) {
+      float x0 = (float)(tx * TileSize), y0 = (float)(ty * TileSize);
+      float x1 = x0 + TileSize, y1 = y0 + TileSize;
+      bool rejected = false;
+      for (int e = 0; e < 3 && !rejected; e++) {
+        // Corner that maximizes the edge function
+        float x = triangle.A[e] > 0.0f ? x1 : x0;
+        float y = triangle.B[e] > 0.0f ? y1 : y0;
+        rejected = triangle.A[e] * x + triangle.B[e] * y + triangle.C[e] < 0.0f;
+      }
+      if (rejected)
+        continue;
+      chunk.Bins[(size_t)ty * m_TilesX + tx].push_back(index);
+      chunk.Binned++;
+    }
+  }
+}
+
+void SoftwareRasterizer::RasterizeTile(uint32_t tile) {
+  int32_t tileX = (int32_t)((tile % m_TilesX) * TileSize);
+  int32_t tileY = (int32_t)((tile / m_TilesX) * TileSize);
+
+  for (uint32_t y = 0; y < TileSize; y++) {
+    size_t row = (size_t)(tileY + y) * m_Stride + tileX;
+    std::fill_n(m_Color.begin() + row, TileSize, m_ClearColor);
+    std::fill_n(m_Depth.begin() + row, TileSize, 1.0f);
+  }
+
+  bool simd = m_UseSIMD && IsSIMDAvailable();
+  for (uint32_t c = 0; c < m_ActiveChunks; c++) {
+    const Chunk &chunk = m_Chunks[c];
+    for (uint32_t index : chunk.Bins[tile]) {
+      const ScreenTriangle &triangle = chunk.Triangles[index];
+      int32_t x0 = std::max(triangle.MinX, tileX);
+      int32_t y0 = std::max(triangle.MinY, tileY);
+      int32_t x1 = std::min(triangle.MaxX, tileX + (int32_t)TileSize - 1);
+      int32_t y1 = std::min(triangle.MaxY, tileY + (int32_t)TileSize - 1);
+      if (simd)
+        RasterizeSIMD(triangle, x0, y0, x1, y1);
+      else
+        RasterizeScalar(triangle, x0, y0, x1, y1);
+    }
+  }
+}
+
+// Both paths evaluate E = A * x + (B * y + C) with the same operation
+// order (no FMA), so they produce identical images.
+void SoftwareRasterizer::RasterizeScalar(const ScreenTriangle &triangle,
+                                         int32_t x0, int32_t y0, int32_t x1,
+                                         int32_t y1) {
+  for (int32_t y = y0; y <= y1; y++) {
+    float py = (float)y + 0.5f;
+    float row[3];
+    for (int e = 0; e < 3; e++)
+      row[e] = triangle.B[e] * py + triangle.C[e];
+    float rowZ = triangle.ZB * py + triangle.ZC;
+
+    size_t offset = (size_t)y * m_Stride;
+    for (int32_t x = x0; x <= x1; x++) {
+      float px = (float)x + 0.5f;
+      bool inside = true;
+      for (int e = 0; e < 3; e++)
+        inside = inside && (triangle.A[e] * px + row[e] > triangle.Bias[e]);
+      if (!inside)
+        continue;
+      float z = triangle.ZA * px + rowZ;
+      if (z < m_Depth[offset + x]) {
+        m_Depth[offset + x] = z;
+        m_Color[offset + x] = triangle.Color;
+      }
+    }
+  }
+}
+
+void SoftwareRasterizer::RasterizeSIMD(const ScreenTriangle &triangle,
+                                       int32_t x0, int32_t y0, int32_t x1,
+                                       int32_t y1) {
+#if defined(__AVX2__)
+  const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  __m256 A[3], bias[3];
+  for (int e = 0; e < 3; e++) {
+    A[e] = _mm256_set1_ps(triangle.A[e]);
+    bias[e] = _mm256_set1_ps(triangle.Bias[e]);
+  }
+  const __m256 zA = _mm256_set1_ps(triangle.ZA);
+  const __m256 color = _mm256_castsi256_ps(_mm256_set1_epi32(
+      (int32_t)triangle.Color));
+
+  // Tiles are 8-aligned: start on the 8-pixel group holding x0. Extra
+  // pixels left of x0 lie outside the triangle's bounding box.
+  int32_t start = x0 & ~7;
+  for (int32_t y = y0; y <= y1; y++) {
+    float py = (float)y + 0.5f;
+    __m256 row[3];
+    for (int e = 0; e < 3; e++)
+      row[e] = _mm256_set1_ps(triangle.B[e] * py + triangle.C[e]);
+    __m256 rowZ = _mm256_set1_ps(triangle.ZB * py + triangle.ZC);
+
+    float *depthRow = m_Depth.data() + (size_t)y * m_Stride;
+    float *colorRow = (float *)(m_Color.data() + (size_t)y * m_Stride);
+    for (int32_t x = start; x <= x1; x += 8) {
+      __m256 px = _mm256_add_ps(
+          _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(x), lane)),
+          half);
+      __m256 mask = _mm256_cmp_ps(
+          _mm256_add_ps(_mm256_mul_ps(A[0], px), row[0]), bias[0],
+          _CMP_GT_OQ);
+      mask = _mm256_and_ps(
+          mask, _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(A[1], px), row[1]),
+                              bias[1], _CMP_GT_OQ));
+      mask = _mm256_and_ps(
+          mask, _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(A[2], px), row[2]),
+                              bias[2], _CMP_GT_OQ));
+      if (_mm256_movemask_ps(mask) == 0)
+        continue;
+
+      __m256 z = _mm256_add_ps(_mm256_mul_ps(zA, px), rowZ);
+      __m256 depth = _mm256_loadu_ps(depthRow + x);
+      mask = _mm256_and_ps(mask, _mm256_cmp_ps(z, depth, _CMP_LT_OQ));
+      if (_mm256_movemask_ps(mask) == 0)
+        continue;
+      _mm256_storeu_ps(depthRow + x, _mm256_blendv_ps(depth, z, mask));
+      __m256 pixels = _mm256_loadu_ps(colorRow + x);
+      _mm256_storeu_ps(colorRow + x, _mm256_blendv_ps(pixels, color, mask));
+    }
+  }
+#else
+  RasterizeScalar(triangle, x0, y0, x1, y1);
+#endif
+}
+
+RasterImage SoftwareRasterizer::GetColorImage() const {
+  RasterImage image;
+  image.Width = m_Width;
+  image.Height = m_Height;
+  image.Pixels.resize((size_t)m_Width * m_Height);
+  for (uint32_t y = 0; y < m_Height; y++) {
+    std::copy_n(m_Color.begin() + (size_t)y * m_Stride, m_Width,
+                image.Pixels.begin() + (size_t)y * m_Width);
+  }
+  return image;
+}
+
+RasterImage SoftwareRasterizer::GetDepthImage() const {
+  float nearest = 1.0f, farthest = 0.0f;
+  for (uint32_t y = 0; y < m_Height; y++) {
+    for (uint32_t x = 0; x < m_Width; x++) {
+      float depth = GetDepth(x, y);
+      if (depth < 1.0f) {
+        nearest = std::min(nearest, depth);
+        farthest = std::max(farthest, depth);
+      }
+    }
+  }
+  float range = farthest > nearest ? farthest - nearest : 1.0f;
+
+  RasterImage image;
+  image.Width = m_Width;
+  image.Height = m_Height;
+  image.Pixels.resize((size_t)m_Width * m_Height);
+  for (uint32_t y = 0; y < m_Height; y++) {
+    for (uint32_t x = 0; x < m_Width; x++) {
+      float depth = GetDepth(x, y);
+      uint32_t gray = 0;
+      if (depth < 1.0f)
+        gray = 255 - (uint32_t)((depth - nearest) / range * 223.0f);
+      image.Pixels[(size_t)y * m_Width + x] =
+          gray | (gray << 8) | (gray << 16) | 0xff000000u;
+    }
+  }
+  return image;
+}
+
+} // namespace Forge
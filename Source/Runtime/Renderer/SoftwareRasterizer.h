@@ -0,0 +1,150 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Forge {
+
+class JobSystem;
+
+// RGBA8 image (R in the low byte), rows top-down
+struct RasterImage {
+  // ReadPPM rejects larger images (the D3D12 texture limit)
+  static constexpr uint32_t MaxPPMDimension = 16384;
+
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+  std::vector<uint32_t> Pixels;
+
+  // Binary PPM (P6), alpha dropped: diffable and viewable everywhere
+  bool WritePPM(const std::string &path) const;
+  // False on a malformed header or truncated data
+  bool ReadPPM(const std::string &path);
+  // Pixels where any RGB channel differs by more than tolerance (a size
+  // mismatch counts every pixel)
+  uint64_t CountDifferences(const RasterImage &other,
+                            uint32_t tolerance = 0) const;
+};
+
+inline uint32_t PackRGBA8(const float color[4]) {
+  auto channel = [](float value) {
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return (uint32_t)(value * 255.0f + 0.5f);
+  };
+  return channel(color[0]) | (channel(color[1]) << 8) |
+         (channel(color[2]) << 16) | (channel(color[3]) << 24);
+}
+
+struct RasterStats {
+  uint64_t Triangles = 0; // submitted (lines count as two)
+  uint64_t Clipped = 0;   // cut by the near plane
+  uint64_t Culled = 0;    // back-facing, degenerate or off screen
+  uint64_t Binned = 0;    // triangle / tile pairs
+  uint32_t Tiles = 0;
+  uint32_t Chunks = 0;    // setup / binning jobs
+  bool SIMD = false;      // AVX2 path used
+};
+
+// CPU rasterizer for headless scene images (screenshots, thumbnails, build
+// farm diffs). Matrices follow DirectXMath: row-major, row vectors, D3D
+// clip space (0 <= z <= w), so EditorCamera's view * projection can be
+// passed as is. Draws are flat shaded with a fixed light and depth tested
+// (LESS), front faces clockwise like D3D12.
+//
+// Render sets up and bins triangles into TileSize tiles in parallel chunks,
+// then rasterizes tiles in parallel; each tile walks the chunks in order,
+// so the image does not depend on the thread count. With AVX2 (the
+// FORGE_ENABLE_AVX2 build option) edge functions and depth are evaluated 8
+// pixels at a time; the scalar path produces the same image.
+class SoftwareRasterizer {
+public:
+  static constexpr uint32_t TileSize = 64;
+
+  // Starts an image and forgets previous draws
+  void Begin(uint32_t width, uint32_t height, const float viewProj[16],
+             const float clearColor[4]);
+
+  // Non-indexed triangle list, float3 positions `stride` bytes apart
+  void DrawTriangles(const float *positions, uint32_t vertexCount,
+                     uint32_t stride, const float world[16],
+                     const float color[4], bool cullBackFaces = false);
+  // Line list, one pixel wide, unlit
+  void DrawLines(const float *positions, uint32_t vertexCount,
+                 uint32_t stride, const float world[16],
+                 const float color[4]);
+
+  // jobs may be null (single-threaded)
+  void Render(JobSystem *jobs);
+
+  RasterImage GetColorImage() const;
+  // Depth remapped to gray (near = white) over the drawn range
+  RasterImage GetDepthImage() const;
+  float GetDepth(uint32_t x, uint32_t y) const {
+    return m_Depth[(size_t)y * m_Stride + x];
+  }
+
+  // Forces the scalar path (comparisons); ignored without AVX2
+  void SetUseSIMD(bool useSIMD) { m_UseSIMD = useSIMD; }
+  static bool IsSIMDAvailable();
+
+  const RasterStats &GetStats() const { return m_Stats; }
+
+private:
+  // Clip space, after the world * viewProj transform
+  struct ClipVertex {
+    float X, Y, Z, W;
+  };
+  struct ClipPrimitive {
+    ClipVertex V[3];
+    uint32_t Color;     // lit for the front face
+    uint32_t BackColor; // lit for the back face
+    bool Line; // V[0] -> V[1]
+    bool CullBackFaces;
+  };
+
+  // Edge functions E(x, y) = A x + B y + C, inside when all are positive
+  // (>= 0 on top-left edges, via Bias); depth is a plane over the triangle
+  struct ScreenTriangle {
+    float A[3], B[3], C[3], Bias[3];
+    float ZA, ZB, ZC;
+    int32_t MinX, MinY, MaxX, MaxY;
+    uint32_t Color;
+  };
+
+  struct Chunk {
+    std::vector<ScreenTriangle> Triangles;
+    std::vector<std::vector<uint32_t>> Bins; // per tile, into Triangles
+    uint64_t Clipped = 0;
+    uint64_t Culled = 0;
+    uint64_t Binned = 0;
+  };
+
+  void SetupChunk(Chunk &chunk, uint32_t begin, uint32_t end);
+  void SetupTriangle(Chunk &chunk, const float (&v0)[3], const float (&v1)[3],
+                     const float (&v2)[3], uint32_t color, uint32_t backColor,
+                     bool cull);
+  void SetupLine(Chunk &chunk, const ClipPrimitive &line);
+  void RasterizeTile(uint32_t tile);
+  void RasterizeScalar(const ScreenTriangle &triangle, int32_t x0, int32_t y0,
+                       int32_t x1, int32_t y1);
+  void RasterizeSIMD(const ScreenTriangle &triangle, int32_t x0, int32_t y0,
+                     int32_t x1, int32_t y1);
+  void ToScreen(const ClipVertex &v, float (&out)[3]) const;
+
+  uint32_t m_Width = 0, m_Height = 0;
+  uint32_t m_Stride = 0;                   // padded to TileSize
+  uint32_t m_TilesX = 0, m_TilesY = 0;
+  float m_ViewProj[16] = {};
+  uint32_t m_ClearColor = 0;
+  bool m_UseSIMD = true;
+
+  std::vector<ClipPrimitive> m_Primitives;
+  std::vector<Chunk> m_Chunks; // reused between images
+  uint32_t m_ActiveChunks = 0;
+  std::vector<uint32_t> m_Color;
+  std::vector<float> m_Depth;
+
+  RasterStats m_Stats;
+};
+
+} // namespace Forge
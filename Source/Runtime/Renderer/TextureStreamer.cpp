@@ -0,0 +1,395 @@
+#include "TextureStreamer.h"
+#include "../RHI/DeferredRelease.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <queue>
+
+namespace Forge {
+
+TextureStreamer::~TextureStreamer() { Shutdown(); }
+
+bool TextureStreamer::Initialize(RHIDevice *device, UploadManager *uploads,
+                                 DeferredReleaseQueue *releases,
+                                 const TextureStreamerSettings &settings) {
+  if (!device || !uploads || !releases) {
+    std::cerr << "[TextureStreamer] Needs a device, an upload manager and a "
+                 "deferred release queue"
+              << std::endl;
+    return false;
+  }
+  m_Device = device;
+  m_Uploads = uploads;
+  m_Releases = releases;
+  m_Settings = settings;
+  m_Stats = {};
+  return true;
+}
+
+void TextureStreamer::Shutdown() {
+  if (!m_Device)
+    return;
+  m_Uploads->WaitIdle();
+  for (size_t i = 0; i < m_Textures.size(); i++) {
+    if (m_Textures[i].File)
+      Unregister((StreamedTextureID)(i + 1));
+  }
+  for (Orphan &orphan : m_Orphans)
+    m_Releases->Retire(std::move(orphan.Resource));
+  m_Orphans.clear();
+  m_Textures.clear();
+  m_FreeSlots.clear();
+  m_ResidentBytes = m_PendingBytes = 0;
+  m_Device = nullptr;
+  m_Uploads = nullptr;
+  m_Releases = nullptr;
+}
+
+StreamedTextureID TextureStreamer::Register(const std::string &path) {
+  auto file = std::make_unique<TextureFile>();
+  if (!file->Open(path))
+    return 0;
+
+  uint32_t index;
+  if (!m_FreeSlots.empty()) {
+    index = m_FreeSlots.back();
+    m_FreeSlots.pop_back();
+  } else {
+    index = (uint32_t)m_Textures.size();
+    m_Textures.emplace_back();
+  }
+  Texture &texture = m_Textures[index];
+  const TextureLayout &layout = file->GetLayout();
+  texture.File = std::move(file);
+  texture.Name = std::filesystem::path(path).filename().string();
+  texture.MipCount = layout.MipCount;
+  texture.TailMip = 0;
+  while (texture.TailMip + 1 < layout.MipCount &&
+         std::max(GetMipSize(layout.Width, texture.TailMip),
+                  GetMipSize(layout.Height, texture.TailMip)) >
+             m_Settings.TailSize)
+    texture.TailMip++;
+  for (uint32_t mip = 0; mip < layout.MipCount; mip++) {
+    RHIResourceDesc desc = RHIResourceDesc::Texture2D(
+        GetMipSize(layout.Width, mip), GetMipSize(layout.Height, mip),
+        layout.Format, RHIResourceFlag_None, RHIResourceState::Common);
+    desc.MipLevels = (uint16_t)(layout.MipCount - mip);
+    texture.Bytes[mip] = m_Device->GetAllocationInfo(desc).Size;
+  }
+  texture.ResidentMip = texture.MipCount;
+  texture.DesiredMip = texture.TargetMip = texture.TailMip;
+  texture.ScreenPixels = 0.0f;
+  texture.LastUsedFrame = m_Frame;
+
+  // The tail first: usable (blurry) as soon as it lands
+  StartVersion(texture, texture.TailMip);
+  return index + 1;
+}
+
+void TextureStreamer::Unregister(StreamedTextureID id) {
+  if (!IsValid(id))
+    return;
+  Texture &texture = m_Textures[id - 1];
+  if (texture.Resident) {
+    m_ResidentBytes -= texture.Bytes[texture.ResidentMip];
+    m_Releases->Retire(std::move(texture.Resident));
+  }
+  if (texture.Pending) {
+    // The copy queue may still write it
+    m_PendingBytes -= texture.Bytes[texture.PendingMip];
+    m_Orphans.push_back({std::move(texture.Pending), texture.PendingTicket});
+  }
+  texture = Texture();
+  m_FreeSlots.push_back(id - 1);
+}
+
+void TextureStreamer::SetView(const float eye[3], float fovY,
+                              float viewportHeight) {
+  std::copy(eye, eye + 3, m_Eye);
+  m_ProjectionScale = viewportHeight / (2.0f * std::tan(fovY * 0.5f));
+}
+
+void TextureStreamer::ReportUsage(const TextureUsage *usages, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    const TextureUsage &usage = usages[i];
+    if (!IsValid(usage.Texture))
+      continue;
+    float d[3] = {usage.Center[0] - m_Eye[0], usage.Center[1] - m_Eye[1],
+                  usage.Center[2] - m_Eye[2]};
+    // Nearest point of the bounding sphere; inside it, full resolution
+    float distance =
+        std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]) - usage.Radius;
+    float pixels = distance > 1e-3f
+                       ? usage.WorldSize * m_ProjectionScale / distance
+                       : FLT_MAX;
+    RequestScreenSize(usage.Texture, pixels);
+  }
+}
+
+void TextureStreamer::RequestScreenSize(StreamedTextureID id, float pixels) {
+  if (!IsValid(id))
+    return;
+  Texture &texture = m_Textures[id - 1];
+  texture.ScreenPixels = std::max(texture.ScreenPixels, pixels);
+}
+
+uint32_t TextureStreamer::ComputeDesiredMip(uint32_t width, uint32_t height,
+                                            float pixels, float bias,
+                                            uint32_t lastMip) {
+  if (!(pixels > 0.0f))
+    return lastMip;
+  float mip =
+      std::floor(std::log2((float)std::max(width, height) / pixels) + bias);
+  if (!(mip > 0.0f))
+    return 0;
+  return std::min((uint32_t)std::min(mip, 31.0f), lastMip);
+}
+
+uint64_t TextureStreamer::GetUploadBytes(const Texture &texture,
+                                         uint32_t mip) const {
+  uint64_t bytes = 0;
+  for (uint32_t m = mip; m < texture.MipCount; m++)
+    bytes += texture.File->GetMipBytes(m);
+  return bytes;
+}
+
+void TextureStreamer::StartVersion(Texture &texture, uint32_t mip) {
+  const TextureLayout &layout = texture.File->GetLayout();
+  RHIResourceDesc desc = RHIResourceDesc::Texture2D(
+      GetMipSize(layout.Width, mip), GetMipSize(layout.Height, mip),
+      layout.Format, RHIResourceFlag_None, RHIResourceState::Common,
+      texture.Name + " (mip " + std::to_string(mip) + ")");
+  desc.MipLevels = (uint16_t)(texture.MipCount - mip);
+  std::unique_ptr<RHIResource> resource = m_Device->CreateResource(desc);
+  if (!resource) {
+    std::cerr << "[TextureStreamer] Cannot create " << desc.DebugName
+              << std::endl;
+    return;
+  }
+
+  UploadTicket last;
+  bool failed = false;
+  for (uint32_t m = mip; m < texture.MipCount; m++) {
+    UploadTicket ticket = m_Uploads->UploadTexture(
+        resource.get(), m - mip, texture.File->GetMipData(m),
+        texture.File->GetMipRowBytes(m),
+        RHIResourceState::PixelShaderResource);
+    failed |= !ticket.IsValid();
+    if (ticket.FenceValue > last.FenceValue)
+      last = ticket;
+  }
+  if (failed) {
+    // Copies already recorded may still write the resource
+    std::cerr << "[TextureStreamer] Upload of " << desc.DebugName
+              << " failed" << std::endl;
+    if (last.IsValid())
+      m_Orphans.push_back({std::move(resource), last});
+    else
+      m_Releases->Retire(std::move(resource));
+    return;
+  }
+
+  texture.Pending = std::move(resource);
+  texture.PendingMip = mip;
+  texture.PendingTicket = last;
+  m_PendingBytes += texture.Bytes[mip];
+  m_Stats.UploadedBytes += GetUploadBytes(texture, mip);
+}
+
+void TextureStreamer::FitBudget() {
+  const uint64_t budget = m_Settings.BudgetBytes;
+  uint64_t total = 0;
+  std::vector<uint32_t> cached;
+  for (uint32_t i = 0; i < m_Textures.size(); i++) {
+    Texture &texture = m_Textures[i];
+    if (!texture.File)
+      continue;
+    // Keep finer mips that are already there (a cache), never ask for
+    // finer than desired
+    texture.TargetMip = std::min(texture.DesiredMip, texture.GetHeldMip());
+    total += texture.Bytes[texture.TargetMip];
+    if (texture.TargetMip < texture.DesiredMip)
+      cached.push_back(i);
+  }
+
+  // 1. Give back cached mips, least recently used first
+  if (total > budget) {
+    std::sort(cached.begin(), cached.end(), [&](uint32_t a, uint32_t b) {
+      uint64_t frameA = m_Textures[a].LastUsedFrame;
+      uint64_t frameB = m_Textures[b].LastUsedFrame;
+      return frameA != frameB ? frameA < frameB : a < b;
+    });
+    for (uint32_t i : cached) {
+      Texture &texture = m_Textures[i];
+      total -= texture.Bytes[texture.TargetMip] -
+               texture.Bytes[texture.DesiredMip];
+      texture.TargetMip = texture.DesiredMip;
+      if (total <= budget)
+        break;
+    }
+  }
+
+  // 2. Drop wanted mips where it shows least: the texture whose texels
+  // would be magnified the least after losing its finest mip
+  if (total > budget) {
+    using Entry = std::pair<float, uint32_t>; // magnification, index
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    auto push = [&](uint32_t i) {
+      const Texture &texture = m_Textures[i];
+      if (texture.TargetMip >= texture.TailMip)
+        return;
+      const TextureLayout &layout = texture.File->GetLayout();
+      float texels = (float)std::max(
+          GetMipSize(layout.Width, texture.TargetMip + 1),
+          GetMipSize(layout.Height, texture.TargetMip + 1));
+      heap.push({texture.ScreenPixels / texels, i});
+    };
+    for (uint32_t i = 0; i < m_Textures.size(); i++) {
+      if (m_Textures[i].File)
+        push(i);
+    }
+    while (total > budget && !heap.empty()) {
+      Texture &texture = m_Textures[heap.top().second];
+      uint32_t i = heap.top().second;
+      heap.pop();
+      total -= texture.Bytes[texture.TargetMip] -
+               texture.Bytes[texture.TargetMip + 1];
+      texture.TargetMip++;
+      push(i);
+    }
+  }
+}
+
+void TextureStreamer::Update() {
+  if (!m_Device)
+    return;
+  m_Frame++;
+
+  // 1. Versions whose copy finished replace the resident ones
+  for (Texture &texture : m_Textures) {
+    if (!texture.Pending || !m_Uploads->IsComplete(texture.PendingTicket))
+      continue;
+    if (texture.Resident) {
+      m_ResidentBytes -= texture.Bytes[texture.ResidentMip];
+      m_Releases->Retire(std::move(texture.Resident));
+    }
+    m_PendingBytes -= texture.Bytes[texture.PendingMip];
+    m_ResidentBytes += texture.Bytes[texture.PendingMip];
+    texture.Resident = std::move(texture.Pending);
+    texture.ResidentMip = texture.PendingMip;
+    texture.PendingTicket = {};
+  }
+  for (size_t i = 0; i < m_Orphans.size();) {
+    if (m_Uploads->IsComplete(m_Orphans[i].Ticket)) {
+      m_Releases->Retire(std::move(m_Orphans[i].Resource));
+      m_Orphans[i] = std::move(m_Orphans.back());
+      m_Orphans.pop_back();
+    } else {
+      i++;
+    }
+  }
+
+  // 2. Desired mips from this frame's usage
+  uint64_t desiredBytes = 0;
+  for (Texture &texture : m_Textures) {
+    if (!texture.File)
+      continue;
+    const TextureLayout &layout = texture.File->GetLayout();
+    texture.DesiredMip =
+        ComputeDesiredMip(layout.Width, layout.Height, texture.ScreenPixels,
+                          m_Settings.Bias, texture.TailMip);
+    if (texture.ScreenPixels > 0.0f)
+      texture.LastUsedFrame = m_Frame;
+    desiredBytes += texture.Bytes[texture.DesiredMip];
+  }
+
+  // 3. Budget
+  FitBudget();
+
+  // 4. New versions: evictions (and failed tails) first, they free memory
+  std::vector<uint32_t> loads;
+  uint64_t committed = 0; // resident + pending once everything lands
+  for (uint32_t i = 0; i < m_Textures.size(); i++) {
+    Texture &texture = m_Textures[i];
+    if (!texture.File)
+      continue;
+    if (!texture.Pending) {
+      if (!texture.Resident) {
+        StartVersion(texture, texture.TailMip);
+      } else if (texture.TargetMip > texture.ResidentMip) {
+        StartVersion(texture, texture.TargetMip);
+        m_Stats.Evictions += texture.Pending ? 1 : 0;
+      } else if (texture.TargetMip < texture.ResidentMip) {
+        loads.push_back(i);
+      }
+    }
+    committed += texture.Bytes[texture.GetHeldMip()];
+  }
+
+  // Most magnified first: the texture that looks worst now
+  auto magnification = [&](uint32_t i) {
+    const Texture &texture = m_Textures[i];
+    const TextureLayout &layout = texture.File->GetLayout();
+    return texture.ScreenPixels /
+           (float)std::max(GetMipSize(layout.Width, texture.ResidentMip),
+                           GetMipSize(layout.Height, texture.ResidentMip));
+  };
+  std::sort(loads.begin(), loads.end(), [&](uint32_t a, uint32_t b) {
+    float ma = magnification(a), mb = magnification(b);
+    return ma != mb ? ma > mb : a < b;
+  });
+  uint64_t uploadBudget = m_Settings.MaxUploadBytesPerUpdate;
+  bool started = false;
+  for (uint32_t i : loads) {
+    Texture &texture = m_Textures[i];
+    // Finest mip toward the target within the upload and memory budgets;
+    // the memory check is on the steady state after the swap
+    auto fits = [&](uint32_t mip) {
+      return committed - texture.Bytes[texture.ResidentMip] +
+                 texture.Bytes[mip] <=
+             m_Settings.BudgetBytes;
+    };
+    uint32_t mip = texture.TargetMip;
+    while (mip < texture.ResidentMip &&
+           (GetUploadBytes(texture, mip) > uploadBudget || !fits(mip)))
+      mip++;
+    if (mip == texture.ResidentMip) {
+      // Nothing fits the upload budget: one step, if it is the first load
+      mip = texture.ResidentMip - 1;
+      if (started || !fits(mip))
+        continue;
+    }
+    uint64_t bytes = GetUploadBytes(texture, mip);
+    StartVersion(texture, mip);
+    if (!texture.Pending)
+      continue;
+    committed += texture.Bytes[mip] - texture.Bytes[texture.ResidentMip];
+    uploadBudget -= std::min(uploadBudget, bytes);
+    started = true;
+    m_Stats.Loads++;
+  }
+
+  // Stats; usage starts over next frame
+  m_Stats.Textures = 0;
+  m_Stats.PendingLoads = 0;
+  m_Stats.OverBudget = 0;
+  for (Texture &texture : m_Textures) {
+    if (!texture.File)
+      continue;
+    m_Stats.Textures++;
+    m_Stats.PendingLoads += texture.Pending ? 1 : 0;
+    m_Stats.OverBudget += texture.TargetMip > texture.DesiredMip ? 1 : 0;
+    texture.ScreenPixels = 0.0f;
+  }
+  m_Stats.ResidentBytes = m_ResidentBytes;
+  m_Stats.PendingBytes = m_PendingBytes;
+  m_Stats.DesiredBytes = desiredBytes;
+  m_Stats.BudgetBytes = m_Settings.BudgetBytes;
+  m_Stats.PeakBytes =
+      std::max(m_Stats.PeakBytes, m_ResidentBytes + m_PendingBytes);
+}
+
+} // namespace Forge
@@ -0,0 +1,192 @@
+#pragma once
+#include "../Asset/TextureFile.h"
+#include "../RHI/RHI.h"
+#include "../RHI/UploadManager.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Forge {
+
+class DeferredReleaseQueue;
+
+// Handle of a streamed texture (0 = none)
+using StreamedTextureID = uint32_t;
+
+struct TextureStreamerSettings {
+  uint64_t BudgetBytes = 256ull << 20; // GPU memory for streamed textures
+  // Mips of this size and smaller (the tail) are loaded at registration
+  // and stay resident
+  uint32_t TailSize = 64;
+  // Upload volume one Update may start (a single load larger than this
+  // still starts if nothing else did)
+  uint64_t MaxUploadBytesPerUpdate = 16ull << 20;
+  // In mips: +1 asks for half the resolution everywhere
+  float Bias = 0.0f;
+};
+
+// One textured instance seen this frame
+struct TextureUsage {
+  StreamedTextureID Texture;
+  float Center[3]; // world-space bounding sphere
+  float Radius;
+  float WorldSize; // world units the texture's width spans on the surface
+};
+
+struct TextureStreamerStats {
+  uint32_t Textures = 0;
+  uint32_t PendingLoads = 0;
+  uint32_t OverBudget = 0; // textures held coarser than desired
+  uint64_t ResidentBytes = 0;
+  uint64_t PendingBytes = 0; // new versions still being copied
+  uint64_t DesiredBytes = 0; // every texture at its desired mip
+  uint64_t BudgetBytes = 0;
+  uint64_t PeakBytes = 0; // resident + pending, since Initialize
+  // Totals since Initialize
+  uint64_t Loads = 0;     // finer versions started
+  uint64_t Evictions = 0; // coarser versions started
+  uint64_t UploadedBytes = 0;
+};
+
+// Mip streaming for cooked textures (TextureFile DDS). Each texture's GPU
+// resource holds a suffix of its mip chain, [ResidentMip, MipCount), so
+// shaders see the finest resident mip as mip 0 without any change.
+// Registration uploads the tail first; afterwards each Update
+//
+//   1. swaps in versions whose upload finished (the old one is retired
+//      through the deferred release queue),
+//   2. turns this frame's usage into a desired mip per texture: the
+//      coarsest mip with at least one texel per screen pixel, from the
+//      projected size of TextureUsage::WorldSize (unused textures desire
+//      their tail),
+//   3. fits the desired mips into the budget: mips already resident past
+//      their need stay cached until the memory is wanted (least recently
+//      used first), then the texture whose texels would be magnified the
+//      least drops one mip, repeatedly,
+//   4. starts new versions on the copy queue, evictions first, then loads
+//      by how magnified the texture is now, within MaxUploadBytesPerUpdate.
+//
+// A texture changes by recreating its resource with a new mip range and
+// uploading that range from the mapped file: no tiled resources or GPU
+// copies, and the two versions coexist only while the copy runs (counted
+// in PendingBytes). Resources may change in any Update; fetch them with
+// GetResource when binding. Not thread-safe.
+class TextureStreamer {
+public:
+  TextureStreamer() = default;
+  ~TextureStreamer();
+
+  bool Initialize(RHIDevice *device, UploadManager *uploads,
+                  DeferredReleaseQueue *releases,
+                  const TextureStreamerSettings &settings = {});
+  // Waits for the copy queue, then retires every resource
+  void Shutdown();
+
+  // Maps a cooked texture and uploads its tail. 0 on failure.
+  StreamedTextureID Register(const std::string &path);
+  void Unregister(StreamedTextureID texture);
+
+  // Perspective camera, as LODSelector::SetView
+  void SetView(const float eye[3], float fovY, float viewportHeight);
+  // Usage for the current frame; several reports of one texture keep the
+  // largest projection
+  void ReportUsage(const TextureUsage *usages, uint32_t count);
+  // Screen-space extent in pixels decided by the caller (UI, cinematics)
+  void RequestScreenSize(StreamedTextureID texture, float pixels);
+
+  // Once per frame: after UploadManager::BeginFrame and the usage reports,
+  // before the frame binds textures and the uploads are flushed
+  void Update();
+
+  // Coarsest mip whose larger side still has `pixels` texels, shifted by
+  // bias and clamped to lastMip (also the answer for pixels <= 0)
+  static uint32_t ComputeDesiredMip(uint32_t width, uint32_t height,
+                                    float pixels, float bias,
+                                    uint32_t lastMip);
+
+  void SetSettings(const TextureStreamerSettings &settings) {
+    m_Settings = settings;
+  }
+  const TextureStreamerSettings &GetSettings() const { return m_Settings; }
+
+  bool IsValid(StreamedTextureID texture) const {
+    return texture > 0 && texture <= m_Textures.size() &&
+           m_Textures[texture - 1].File != nullptr;
+  }
+  // nullptr until the tail has arrived
+  RHIResource *GetResource(StreamedTextureID texture) const {
+    return m_Textures[texture - 1].Resident.get();
+  }
+  // Mip of the file the resource's mip 0 is (MipCount before the tail)
+  uint32_t GetResidentMip(StreamedTextureID texture) const {
+    return m_Textures[texture - 1].ResidentMip;
+  }
+  uint32_t GetDesiredMip(StreamedTextureID texture) const {
+    return m_Textures[texture - 1].DesiredMip;
+  }
+  // The mip the budget allows (what the streamer is heading to)
+  uint32_t GetTargetMip(StreamedTextureID texture) const {
+    return m_Textures[texture - 1].TargetMip;
+  }
+  uint32_t GetTailMip(StreamedTextureID texture) const {
+    return m_Textures[texture - 1].TailMip;
+  }
+  const TextureFile &GetFile(StreamedTextureID texture) const {
+    return *m_Textures[texture - 1].File;
+  }
+
+  const TextureStreamerStats &GetStats() const { return m_Stats; }
+
+private:
+  struct Texture {
+    std::unique_ptr<TextureFile> File; // nullptr = free slot
+    uint32_t MipCount = 0;
+    uint32_t TailMip = 0;
+    // Resource from mip m to the end ([MipCount] = 0: nothing)
+    uint64_t Bytes[MaxTextureMips + 1] = {};
+
+    std::unique_ptr<RHIResource> Resident;
+    uint32_t ResidentMip = 0;
+    std::unique_ptr<RHIResource> Pending;
+    uint32_t PendingMip = 0;
+    UploadTicket PendingTicket;
+
+    std::string Name; // file name, for resource debug names
+    float ScreenPixels = 0.0f; // this frame's largest projection
+    uint64_t LastUsedFrame = 0;
+    uint32_t DesiredMip = 0;
+    uint32_t TargetMip = 0;
+
+    // The mip it will hold once pending work lands
+    uint32_t GetHeldMip() const { return Pending ? PendingMip : ResidentMip; }
+  };
+
+  // Resource of an unregistered texture whose copy has not finished
+  struct Orphan {
+    std::unique_ptr<RHIResource> Resource;
+    UploadTicket Ticket;
+  };
+
+  void FitBudget();
+  void StartVersion(Texture &texture, uint32_t mip);
+  uint64_t GetUploadBytes(const Texture &texture, uint32_t mip) const;
+
+  RHIDevice *m_Device = nullptr;
+  UploadManager *m_Uploads = nullptr;
+  DeferredReleaseQueue *m_Releases = nullptr;
+  TextureStreamerSettings m_Settings;
+
+  std::vector<Texture> m_Textures; // by ID - 1
+  std::vector<uint32_t> m_FreeSlots;
+  std::vector<Orphan> m_Orphans;
+  float m_Eye[3] = {};
+  float m_ProjectionScale = 1.0f; // pixels per world unit at distance 1
+  uint64_t m_Frame = 0;
+
+  uint64_t m_ResidentBytes = 0;
+  uint64_t m_PendingBytes = 0;
+  TextureStreamerStats m_Stats;
+};
+
+} // namespace Forge
@@ -5,6 +5,13 @@ namespace Forge {
 
 Entity::Entity(uint32_t id, const std::string &name) : m_ID(id), m_Name(name) {}
 
+XMMATRIX Entity::GetWorldTransform() const {
+  XMMATRIX world = m_Transform.GetTransform();
+  for (const Entity *parent = m_Parent; parent; parent = parent->m_Parent)
+    world = world * parent->m_Transform.GetTransform();
+  return world;
+}
+
 void Entity::SetParent(Entity *parent) {
   if (m_Parent == parent)
     return;
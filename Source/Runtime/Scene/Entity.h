@@ -1,5 +1,8 @@
 #pragma once
 #include "../Scripting/ScriptEngine.h"
+#include "LODComponent.h"
+#include "LightComponent.h"
+#include "MeshComponent.h"
 #include "TransformComponent.h"
 #include <memory>
 #include <optional>
@@ -18,6 +21,9 @@ public:
   void SetName(const std::string &name) { m_Name = name; }
 
   TransformComponent &GetTransform() { return m_Transform; }
+  const TransformComponent &GetTransform() const { return m_Transform; }
+  // Local transform composed with every parent's
+  XMMATRIX GetWorldTransform() const;
 
   // Hierarchy
   Entity *GetParent() const { return m_Parent; }
@@ -32,6 +38,34 @@ public:
     return m_Script.has_value() ? &m_Script.value() : nullptr;
   }
 
+  // Rendering
+  void AddMesh(const MeshComponent &mesh = {}) { m_Mesh = mesh; }
+  void RemoveMesh() { m_Mesh.reset(); }
+  MeshComponent *GetMesh() {
+    return m_Mesh.has_value() ? &m_Mesh.value() : nullptr;
+  }
+  const MeshComponent *GetMesh() const {
+    return m_Mesh.has_value() ? &m_Mesh.value() : nullptr;
+  }
+  void AddLOD(const LODComponent &lod = {}) { m_LOD = lod; }
+  void RemoveLOD() { m_LOD.reset(); }
+  LODComponent *GetLOD() {
+    return m_LOD.has_value() ? &m_LOD.value() : nullptr;
+  }
+  const LODComponent *GetLOD() const {
+    return m_LOD.has_value() ? &m_LOD.value() : nullptr;
+  }
+
+  // Lighting
+  void AddLight(const LightComponent &light = {}) { m_Light = light; }
+  void RemoveLight() { m_Light.reset(); }
+  LightComponent *GetLight() {
+    return m_Light.has_value() ? &m_Light.value() : nullptr;
+  }
+  const LightComponent *GetLight() const {
+    return m_Light.has_value() ? &m_Light.value() : nullptr;
+  }
+
   void OnUpdate(float deltaTime);
 
 private:
@@ -43,6 +77,9 @@ private:
   std::vector<Entity *> m_Children;
 
   std::optional<ScriptComponent> m_Script;
+  std::optional<MeshComponent> m_Mesh;
+  std::optional<LODComponent> m_LOD;
+  std::optional<LightComponent> m_Light;
 };
 
 } // namespace Forge
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+namespace Forge {
+
+// Level-of-detail selection for an entity's mesh. Only meshes with a
+// registered LOD chain are affected; the renderer picks the level each
+// frame from the screen-space error of the chain.
+struct LODComponent {
+  int32_t ForcedLOD = -1; // >= 0 pins the level (debugging)
+  float Bias = 0.0f;      // LOD steps, +1 = coarser
+  // Level drawn last frame, written by the renderer (it sees the scene as
+  // const); also the starting point for hysteresis
+  mutable uint8_t CurrentLOD = 0;
+};
+
+} // namespace Forge
@@ -0,0 +1,21 @@
+#pragma once
+#include <DirectXMath.h>
+
+namespace Forge {
+
+using namespace DirectX;
+
+enum class LightType { Directional, Point, Spot };
+
+// A light at the entity's world position. Point and spot lights are
+// assigned to view clusters by the renderer each frame; a spot shines
+// along the entity's +Z axis.
+struct LightComponent {
+  LightType Type = LightType::Point;
+  XMFLOAT3 Color = {1.0f, 1.0f, 1.0f};
+  float Intensity = 1.0f;
+  float Range = 10.0f;     // point and spot: distance of zero influence
+  float SpotAngle = 30.0f; // spot: outer half-angle, degrees
+};
+
+} // namespace Forge
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+
+namespace Forge {
+
+// Built-in meshes until asset import lands. The renderer stores the
+// sphere's coarser LOD levels after Count.
+enum class BuiltinMesh : uint32_t { Cube = 0, Sphere, Count };
+
+struct MeshComponent {
+  uint32_t MeshID = (uint32_t)BuiltinMesh::Cube;
+  uint32_t MaterialID = 0; // index into the renderer's material palette
+};
+
+} // namespace Forge
@@ -4,13 +4,17 @@
 namespace Forge {
 
 Scene::Scene() = default;
-Scene::~Scene() = default;
+Scene::~Scene() {
+  for (const auto &entity : m_Entities)
+    ScriptEngine::OnDestroyEntity(entity.get());
+}
 
 Entity *Scene::CreateEntity(const std::string &name) {
   auto entity = std::make_unique<Entity>(m_NextID++, name);
   Entity *ptr = entity.get();
   m_Entities.push_back(std::move(entity));
   m_RootEntities.push_back(ptr);
+  m_EntityMap[ptr->GetID()] = ptr;
   return ptr;
 }
 
@@ -39,8 +43,15 @@ void Scene::DestroyEntity(Entity *entity) {
       [entity](const std::unique_ptr<Entity> &e) { return e.get() == entity; });
 
   if (it != m_Entities.end()) {
+    ScriptEngine::OnDestroyEntity(entity);
+    m_EntityMap.erase(entity->GetID());
     m_Entities.erase(it);
   }
 }
 
+Entity *Scene::FindEntityByID(uint32_t id) const {
+  auto it = m_EntityMap.find(id);
+  return it != m_EntityMap.end() ? it->second : nullptr;
+}
+
 } // namespace Forge
@@ -1,6 +1,7 @@
 #pragma once
 #include "Entity.h"
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 
@@ -13,6 +14,7 @@ public:
 
   Entity *CreateEntity(const std::string &name = "NewGameObject");
   void DestroyEntity(Entity *entity);
+  Entity *FindEntityByID(uint32_t id) const;
 
   const std::vector<std::unique_ptr<Entity>> &GetEntities() const {
     return m_Entities;
@@ -24,6 +26,7 @@ public:
 private:
   std::vector<std::unique_ptr<Entity>> m_Entities;
   std::vector<Entity *> m_RootEntities; // Entities with no parent
+  std::unordered_map<uint32_t, Entity *> m_EntityMap; // ID lookup
   uint32_t m_NextID = 0;
 };
 
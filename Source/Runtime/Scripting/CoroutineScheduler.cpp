@@ -0,0 +1,72 @@
+#include "CoroutineScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Forge {
+
+void CoroutineScheduler::ScheduleLocked(int32_t coroutineID, TimerWheel &wheel,
+                                        uint64_t dueTick) {
+  auto [it, inserted] = m_Waits.try_emplace(coroutineID);
+  if (!inserted)
+    it->second.Wheel->Cancel(it->second.Timer);
+  it->second.Wheel = &wheel;
+  it->second.Timer = wheel.Schedule((uint32_t)coroutineID, dueTick);
+}
+
+void CoroutineScheduler::WaitSeconds(int32_t coroutineID, float seconds) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  uint64_t delay = (uint64_t)std::ceil(std::fmax(seconds, 0.0f) *
+                                       TicksPerSecond);
+  ScheduleLocked(coroutineID, m_TimeWheel,
+                 m_TimeWheel.GetCurrentTick() + delay);
+}
+
+void CoroutineScheduler::WaitFrames(int32_t coroutineID, int32_t frames) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  uint64_t delay = frames > 1 ? (uint64_t)frames : 1;
+  ScheduleLocked(coroutineID, m_FrameWheel,
+                 m_FrameWheel.GetCurrentTick() + delay);
+}
+
+void CoroutineScheduler::Signal(int32_t coroutineID) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Signaled.push_back(coroutineID);
+}
+
+bool CoroutineScheduler::Cancel(int32_t coroutineID) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  bool cancelled = std::erase(m_Signaled, coroutineID) > 0;
+  auto it = m_Waits.find(coroutineID);
+  if (it != m_Waits.end()) {
+    cancelled |= it->second.Wheel->Cancel(it->second.Timer);
+    m_Waits.erase(it);
+  }
+  return cancelled;
+}
+
+const std::vector<int32_t> &CoroutineScheduler::Tick(float deltaTime) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Time += deltaTime;
+  m_FrameNumber++;
+
+  m_Expired.clear();
+  m_FrameWheel.Advance(m_FrameNumber, m_Expired);
+  m_TimeWheel.Advance((uint64_t)(m_Time * TicksPerSecond), m_Expired);
+
+  m_Due.clear();
+  for (uint64_t payload : m_Expired) {
+    m_Due.push_back((int32_t)(uint32_t)payload);
+    m_Waits.erase((int32_t)(uint32_t)payload);
+  }
+  m_Due.insert(m_Due.end(), m_Signaled.begin(), m_Signaled.end());
+  m_Signaled.clear();
+  return m_Due;
+}
+
+size_t CoroutineScheduler::GetSleepingCount() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_TimeWheel.GetPendingCount() + m_FrameWheel.GetPendingCount();
+}
+
+} // namespace Forge
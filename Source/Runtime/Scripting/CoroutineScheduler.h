@@ -0,0 +1,56 @@
+#pragma once
+#include "../Core/TimerWheel.h"
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Forge {
+
+// Native side of Forge.Coroutine
+// Sleeping coroutines live only in the timer wheels; managed code is
+// entered once per frame, and only when something is actually due.
+class CoroutineScheduler {
+public:
+  // Wait requests may come from script workers and Task continuations on
+  // thread-pool threads; all entry points are thread-safe.
+  void WaitSeconds(int32_t coroutineID, float seconds);
+  void WaitFrames(int32_t coroutineID, int32_t frames);
+  void Signal(int32_t coroutineID); // resume on the next Tick
+  // Coroutine.Stop(): drops its pending wait (timer and signal). False if
+  // nothing was pending.
+  bool Cancel(int32_t coroutineID);
+
+  // Advances both wheels by one frame; returns the IDs to resume.
+  const std::vector<int32_t> &Tick(float deltaTime);
+
+  size_t GetSleepingCount() const;
+  uint64_t GetFrameNumber() const { return m_FrameNumber; }
+
+private:
+  // Time wheel resolution
+  static constexpr double TicksPerSecond = 1000.0;
+
+  struct PendingWait {
+    TimerWheel *Wheel;
+    TimerWheel::TimerID Timer;
+  };
+
+  // Replaces the coroutine's pending wait, if any (m_Mutex held)
+  void ScheduleLocked(int32_t coroutineID, TimerWheel &wheel,
+                      uint64_t dueTick);
+
+  mutable std::mutex m_Mutex;
+  TimerWheel m_TimeWheel;  // 1 tick = 1 ms
+  TimerWheel m_FrameWheel; // 1 tick = 1 frame
+  std::unordered_map<int32_t, PendingWait> m_Waits; // sleeping coroutines
+  std::vector<int32_t> m_Signaled;
+
+  double m_Time = 0.0;
+  uint64_t m_FrameNumber = 0;
+
+  std::vector<uint64_t> m_Expired;
+  std::vector<int32_t> m_Due;
+};
+
+} // namespace Forge
@@ -0,0 +1,77 @@
+#include "GCPacer.h"
+#include <algorithm>
+
+namespace Forge {
+
+namespace {
+constexpr double SmoothingFactor = 0.1;
+constexpr double BytesPerMB = 1024.0 * 1024.0;
+} // namespace
+
+GCPacer::GCPacer(const GCPacingConfig &config) : m_Config(config) {}
+
+GCPacer::Decision GCPacer::OnFrameEnd(uint64_t usedBytes, float frameWorkMs) {
+  // A drop in usage means the runtime collected on its own
+  if (usedBytes < m_LastUsedBytes)
+    m_UsedAfterCollect = usedBytes;
+
+  uint64_t frameGrowth =
+      usedBytes > m_LastUsedBytes ? usedBytes - m_LastUsedBytes : 0;
+  m_LastUsedBytes = usedBytes;
+
+  ScriptHeapStats &stats = m_Stats;
+  stats.UsedBytes = usedBytes;
+  stats.GrowthSinceCollectBytes =
+      usedBytes > m_UsedAfterCollect ? usedBytes - m_UsedAfterCollect : 0;
+  stats.AvgGrowthPerFrameBytes +=
+      (frameGrowth - stats.AvgGrowthPerFrameBytes) * SmoothingFactor;
+
+  double growthMB = stats.GrowthSinceCollectBytes / BytesPerMB;
+  stats.EstimatedMinorMs = m_FixedCostMs + m_CostPerMB * growthMB;
+
+  if (!m_Config.Enabled ||
+      stats.GrowthSinceCollectBytes < m_Config.MinGrowthKB * 1024ull)
+    return Decision::None;
+
+  // Collect before the nursery fills during the next frame's work
+  double nurseryBytes = m_Config.NurserySizeKB * 1024.0;
+  double projected =
+      stats.GrowthSinceCollectBytes + stats.AvgGrowthPerFrameBytes;
+  if (projected >= nurseryBytes * m_Config.UrgentFillRatio)
+    return Decision::Urgent;
+
+  double slackMs = m_Config.TargetFrameMs - frameWorkMs;
+  double allowedMs = std::min<double>(slackMs, m_Config.GCBudgetMs);
+  if (stats.EstimatedMinorMs <= allowedMs)
+    return Decision::Paced;
+
+  return Decision::None;
+}
+
+void GCPacer::OnCollected(Decision decision, double elapsedMs,
+                          uint64_t usedBytes) {
+  if (decision == Decision::None)
+    return;
+
+  // Refit the per-MB cost from the observed pause
+  double growthMB = m_Stats.GrowthSinceCollectBytes / BytesPerMB;
+  if (growthMB > 0.0) {
+    double observedPerMB =
+        std::max(0.0, (elapsedMs - m_FixedCostMs) / growthMB);
+    m_CostPerMB += (observedPerMB - m_CostPerMB) * SmoothingFactor;
+  }
+
+  if (decision == Decision::Paced) {
+    m_Stats.PacedCollections++;
+    m_Stats.LastPacedMs = elapsedMs;
+  } else {
+    m_Stats.UrgentCollections++;
+  }
+
+  m_Stats.UsedBytes = usedBytes;
+  m_Stats.GrowthSinceCollectBytes = 0;
+  m_UsedAfterCollect = usedBytes;
+  m_LastUsedBytes = usedBytes;
+}
+
+} // namespace Forge
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+
+namespace Forge {
+
+struct GCPacingConfig {
+  bool Enabled = true;
+  // Frame time the game is paced to; slack = target - CPU frame time
+  float TargetFrameMs = 16.67f;
+  // Upper bound on paced GC work per frame
+  float GCBudgetMs = 1.0f;
+  // Nursery size handed to SGen (MONO_GC_PARAMS nursery-size)
+  uint32_t NurserySizeKB = 4096;
+  // Ignore trivial growth; a minor GC has a fixed cost floor
+  uint32_t MinGrowthKB = 256;
+  // Collect even without slack once the nursery is this full, so SGen
+  // never triggers a collection at a point we didn't choose
+  float UrgentFillRatio = 0.85f;
+};
+
+struct ScriptHeapStats {
+  uint64_t HeapSizeBytes = 0;
+  uint64_t UsedBytes = 0;
+  uint64_t GrowthSinceCollectBytes = 0;
+  double AvgGrowthPerFrameBytes = 0.0;
+
+  uint64_t MinorCollections = 0; // all nursery collections (runtime count)
+  uint64_t MajorCollections = 0;
+  uint64_t PacedCollections = 0; // triggered by the pacer in slack
+  uint64_t UrgentCollections = 0; // triggered by the pacer without slack
+
+  double LastPacedMs = 0.0; // pause of the last paced (not urgent) collect
+  double EstimatedMinorMs = 0.0;
+};
+
+// Frame-budgeted GC scheduling policy (runtime-agnostic)
+// The caller feeds heap usage and frame timing to OnFrameEnd once per frame;
+// unless it returns Decision::None, the caller runs a minor collection and
+// reports how long it took through OnCollected.
+class GCPacer {
+public:
+  enum class Decision { None, Paced, Urgent };
+
+  explicit GCPacer(const GCPacingConfig &config = {});
+
+  void SetConfig(const GCPacingConfig &config) { m_Config = config; }
+  const GCPacingConfig &GetConfig() const { return m_Config; }
+
+  // usedBytes: live managed heap after this frame's script work
+  // frameWorkMs: CPU time spent on the frame so far
+  Decision OnFrameEnd(uint64_t usedBytes, float frameWorkMs);
+  void OnCollected(Decision decision, double elapsedMs, uint64_t usedBytes);
+
+  ScriptHeapStats &GetStats() { return m_Stats; }
+  const ScriptHeapStats &GetStats() const { return m_Stats; }
+
+private:
+  GCPacingConfig m_Config;
+  ScriptHeapStats m_Stats;
+
+  uint64_t m_LastUsedBytes = 0;
+  uint64_t m_UsedAfterCollect = 0;
+  // Minor GC cost model: fixed + per-MB of nursery growth (EWMA fitted)
+  double m_CostPerMB = 0.25;
+  double m_FixedCostMs = 0.1;
+};
+
+} // namespace Forge
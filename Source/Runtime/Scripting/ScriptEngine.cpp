@@ -1,10 +1,24 @@
 #include "ScriptEngine.h"
+#include "../Core/JobSystem.h"
+#include "../Core/Profiler.h"
 #include "../Scene/Entity.h"
+#include "../Scene/Scene.h"
+#include "CoroutineScheduler.h"
+#include "ScriptGlue.h"
+#include "ScriptProfiler.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
+#include <memory>
 #include <mono/jit/jit.h>
 #include <mono/metadata/assembly.h>
 #include <mono/metadata/debug-helpers.h>
-
+#include <mono/metadata/mono-gc.h>
+#include <mono/metadata/reflection.h>
+#include <mono/metadata/threads.h>
+#include <mutex>
 
 namespace Forge {
 
@@ -14,18 +28,107 @@ struct ScriptEngineData {
   MonoAssembly *CoreAssembly = nullptr;
   MonoImage *CoreAssemblyImage = nullptr;
 
-  MonoMethod *UpdateMethod = nullptr;
-  MonoMethod *StartMethod = nullptr;
+  MonoClass *BehaviourClass = nullptr;
+  MonoClass *ThreadSafeAttributeClass = nullptr;
+  MonoClassField *EntityIDField = nullptr;
+  MonoClass *CoroutineClass = nullptr;
+  MonoMethod *ResumeCoroutinesMethod = nullptr;
 
+  std::unordered_map<std::string, ScriptClassInfo> ScriptClasses;
   std::unordered_map<uint32_t, ScriptComponent *> EntityScripts;
+
+  // Parallel update
+  ScriptEngineConfig Config;
+  std::unique_ptr<JobSystem> Workers;
+  std::atomic<bool> InParallelPhase = false;
+  Scene *SceneContext = nullptr;
+
+  std::vector<Entity *> ParallelEntities;
+  std::vector<Entity *> MainThreadEntities;
+
+  std::mutex DeferredMutex;
+  std::vector<std::function<void()>> DeferredCommands;
+
+  CoroutineScheduler Coroutines;
+  GCPacer Pacer;
+
+  ScriptStartupStats StartupStats;
+  bool FirstFrameDone = false;
 };
 
 static ScriptEngineData *s_Data = nullptr;
 
-void ScriptEngine::Init() {
+using Clock = std::chrono::steady_clock;
+
+static double ElapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+// Mono looks for the AOT image next to the assembly, named
+// <assembly><shared library suffix>.
+static std::string GetAOTImagePath(const std::string &assemblyPath) {
+#ifdef _WIN32
+  return assemblyPath + ".dll";
+#elif defined(__APPLE__)
+  return assemblyPath + ".dylib";
+#else
+  return assemblyPath + ".so";
+#endif
+}
+
+// Virtual lookup that stops at MonoBehaviour: the base OnStart/OnUpdate are
+// empty, so classes that don't override them are never dispatched.
+static MonoMethod *FindOverride(MonoClass *monoClass, const char *name,
+                                int paramCount) {
+  for (MonoClass *c = monoClass; c && c != s_Data->BehaviourClass;
+       c = mono_class_get_parent(c)) {
+    if (MonoMethod *method =
+            mono_class_get_method_from_name(c, name, paramCount))
+      return method;
+  }
+  return nullptr;
+}
+
+static void InvokeMethod(const ScriptClassInfo &info, MonoObject *instance,
+                         MonoMethod *method, void **params) {
+  FORGE_PROFILE_SCOPE("Script Dispatch");
+  ScriptProfiler::Scope scope(info.Class, method);
+
+  MonoObject *exception = nullptr;
+  mono_runtime_invoke(method, instance, params, &exception);
+  if (exception)
+    mono_print_unhandled_exception(exception);
+}
+
+void ScriptEngine::Init(const ScriptEngineConfig &config) {
+  Clock::time_point start = Clock::now();
   s_Data = new ScriptEngineData();
+  s_Data->Config = config;
+  s_Data->StartupStats.AOTEnabled = config.UseAOT;
+
+  // Profiler hooks must be installed before the runtime starts
+  ScriptProfiler::Init(config.ProfileAllocations);
+
+  // AOT mode has to be chosen before the JIT starts. NORMAL (not FULL)
+  // keeps the JIT available for anything without a usable image.
+  if (config.UseAOT)
+    mono_jit_set_aot_mode(MONO_AOT_MODE_NORMAL);
 
-  mono_set_assemblies_path("mono/lib");
+  // SGen reads its parameters once, at startup. Keep the user's value if
+  // one was set in the environment.
+  if (!std::getenv("MONO_GC_PARAMS")) {
+    std::string gcParams =
+        "nursery-size=" + std::to_string(config.GCPacing.NurserySizeKB) + "k";
+#ifdef _WIN32
+    _putenv_s("MONO_GC_PARAMS", gcParams.c_str());
+#else
+    setenv("MONO_GC_PARAMS", gcParams.c_str(), 0);
+#endif
+  }
+  s_Data->Pacer.SetConfig(config.GCPacing);
+
+  mono_set_assemblies_path(config.AssembliesPath.c_str());
   s_Data->RootDomain = mono_jit_init("ForgeJIT");
 
   // In a real engine, we'd create a separate app domain for reloading
@@ -33,20 +136,73 @@ void ScriptEngine::Init() {
       mono_domain_create_appdomain((char *)"ForgeAppDomain", nullptr);
   mono_domain_set(s_Data->AppDomain, true);
 
-  std::cout << "[ScriptEngine] Initialized Mono JIT" << std::endl;
+  ScriptGlue::RegisterInternalCalls();
+
+  // Workers must be attached before they touch managed objects; they stay
+  // attached for their whole lifetime so dispatch pays no attach cost.
+  if (config.ParallelUpdate) {
+    s_Data->Workers = std::make_unique<JobSystem>(
+        config.WorkerThreadCount,
+        [](uint32_t) { mono_thread_attach(s_Data->AppDomain); },
+        [](uint32_t) { mono_thread_detach(mono_thread_current()); });
+  }
+
+  s_Data->StartupStats.InitMs = ElapsedMs(start);
+  std::cout << "[ScriptEngine] Initialized Mono "
+            << (config.UseAOT ? "AOT+JIT" : "JIT") << " ("
+            << (s_Data->Workers ? s_Data->Workers->GetThreadCount() - 1 : 0)
+            << " script workers) in " << s_Data->StartupStats.InitMs << " ms"
+            << std::endl;
 }
 
 void ScriptEngine::Shutdown() {
+  // Detach workers while the runtime is still alive
+  s_Data->Workers.reset();
+
+  for (auto &[id, script] : s_Data->EntityScripts) {
+    if (script->GCHandle)
+      mono_gchandle_free(script->GCHandle);
+  }
+
   mono_jit_cleanup(s_Data->RootDomain);
+  ScriptProfiler::Shutdown();
   delete s_Data;
   s_Data = nullptr;
 }
 
 void ScriptEngine::LoadAssembly(const std::string &path) {
+  Clock::time_point start = Clock::now();
+  if (s_Data->Config.UseAOT) {
+    s_Data->StartupStats.AOTImageFound =
+        std::filesystem::exists(GetAOTImagePath(path));
+    if (!s_Data->StartupStats.AOTImageFound) {
+      std::cout << "[ScriptEngine] No AOT image for " << path
+                << ", using JIT" << std::endl;
+    }
+  }
+
   s_Data->CoreAssembly =
       mono_domain_assembly_open(s_Data->AppDomain, path.c_str());
   s_Data->CoreAssemblyImage = mono_assembly_get_image(s_Data->CoreAssembly);
-  std::cout << "[ScriptEngine] Loaded assembly: " << path << std::endl;
+  s_Data->ScriptClasses.clear();
+
+  s_Data->BehaviourClass =
+      GetClassInImage(s_Data->CoreAssemblyImage, "Forge", "MonoBehaviour");
+  MonoClass *entityClass =
+      GetClassInImage(s_Data->CoreAssemblyImage, "Forge", "Entity");
+  if (entityClass)
+    s_Data->EntityIDField = mono_class_get_field_from_name(entityClass, "ID");
+  s_Data->ThreadSafeAttributeClass = GetClassInImage(
+      s_Data->CoreAssemblyImage, "Forge", "ThreadSafeAttribute");
+  s_Data->CoroutineClass =
+      GetClassInImage(s_Data->CoreAssemblyImage, "Forge", "Coroutine");
+  if (s_Data->CoroutineClass)
+    s_Data->ResumeCoroutinesMethod = mono_class_get_method_from_name(
+        s_Data->CoroutineClass, "ResumeBatch", 1);
+
+  s_Data->StartupStats.LoadAssemblyMs = ElapsedMs(start);
+  std::cout << "[ScriptEngine] Loaded assembly: " << path << " ("
+            << s_Data->StartupStats.LoadAssemblyMs << " ms)" << std::endl;
 }
 
 MonoDomain *ScriptEngine::GetRootDomain() { return s_Data->RootDomain; }
@@ -60,6 +216,40 @@ MonoClass *ScriptEngine::GetClassInImage(MonoImage *image,
   return mono_class_from_name(image, namespaceName.c_str(), className.c_str());
 }
 
+ScriptClassInfo *ScriptEngine::GetScriptClass(const std::string &className) {
+  auto it = s_Data->ScriptClasses.find(className);
+  if (it != s_Data->ScriptClasses.end())
+    return &it->second;
+
+  // "Namespace.Class" or plain "Class"
+  std::string namespaceName;
+  std::string name = className;
+  size_t dot = className.rfind('.');
+  if (dot != std::string::npos) {
+    namespaceName = className.substr(0, dot);
+    name = className.substr(dot + 1);
+  }
+
+  MonoClass *monoClass =
+      GetClassInImage(s_Data->CoreAssemblyImage, namespaceName, name);
+  if (!monoClass)
+    return nullptr;
+
+  ScriptClassInfo info;
+  info.Class = monoClass;
+  info.StartMethod = FindOverride(monoClass, "OnStart", 0);
+  info.UpdateMethod = FindOverride(monoClass, "OnUpdate", 1);
+
+  if (s_Data->ThreadSafeAttributeClass) {
+    if (MonoCustomAttrInfo *attrs = mono_custom_attrs_from_class(monoClass)) {
+      info.ThreadSafe = mono_custom_attrs_has_attr(
+          attrs, s_Data->ThreadSafeAttributeClass);
+      mono_custom_attrs_free(attrs);
+    }
+  }
+  return &s_Data->ScriptClasses.emplace(className, info).first->second;
+}
+
 MonoObject *ScriptEngine::InstantiateClass(MonoClass *monoClass) {
   MonoObject *instance = mono_object_new(s_Data->AppDomain, monoClass);
   mono_runtime_object_init(instance);
@@ -67,20 +257,219 @@ MonoObject *ScriptEngine::InstantiateClass(MonoClass *monoClass) {
 }
 
 void ScriptEngine::InstantiateEntity(Entity *entity) {
-  // Assume for simplicity that we check if entity has a script component
-  // Typically this would be integrated into Entity/Component system
+  ScriptComponent *script = entity->GetScript();
+  if (!script || script->Initialized || !s_Data->CoreAssemblyImage)
+    return;
+
+  ScriptClassInfo *info = GetScriptClass(script->ClassName);
+  if (!info) {
+    std::cerr << "[ScriptEngine] Script class not found: "
+              << script->ClassName << std::endl;
+    return;
+  }
+
+  uint32_t id = entity->GetID();
+  script->Instance = InstantiateClass(info->Class);
+  // The native side only holds the handle; SGen may move the object
+  script->GCHandle = mono_gchandle_new(script->Instance, false);
+  if (s_Data->EntityIDField)
+    mono_field_set_value(script->Instance, s_Data->EntityIDField, &id);
+
+  script->ClassInfo = info;
+  script->Initialized = true;
+  s_Data->EntityScripts[id] = script;
+
+  if (info->StartMethod)
+    InvokeMethod(*info, script->Instance, info->StartMethod, nullptr);
 }
 
 void ScriptEngine::OnUpdateEntity(Entity *entity, float deltaTime) {
-  uint32_t id = entity->GetID();
-  if (s_Data->EntityScripts.find(id) != s_Data->EntityScripts.end()) {
-    ScriptComponent *script = s_Data->EntityScripts[id];
+  auto it = s_Data->EntityScripts.find(entity->GetID());
+  if (it == s_Data->EntityScripts.end())
+    return;
+
+  // ClassInfo is resolved on instantiation, so this path never touches the
+  // class cache and is safe to call from script workers.
+  ScriptComponent *script = it->second;
+  const ScriptClassInfo *info = script->ClassInfo;
+  if (!info || !info->UpdateMethod)
+    return;
+
+  script->Instance = mono_gchandle_get_target(script->GCHandle);
+  void *params[] = {&deltaTime};
+  InvokeMethod(*info, script->Instance, info->UpdateMethod, params);
+}
 
-    // Call OnUpdate(float dt)
-    // MonoMethod* method = ... find method in class ...
-    // void* params[] = { &deltaTime };
-    // mono_runtime_invoke(method, script->Instance, params, nullptr);
+void ScriptEngine::OnDestroyEntity(Entity *entity) {
+  if (!s_Data)
+    return;
+  auto it = s_Data->EntityScripts.find(entity->GetID());
+  if (it == s_Data->EntityScripts.end())
+    return;
+
+  ScriptComponent *script = it->second;
+  if (script->GCHandle)
+    mono_gchandle_free(script->GCHandle);
+  script->GCHandle = 0;
+  script->Instance = nullptr;
+  script->Initialized = false;
+  s_Data->EntityScripts.erase(it);
+}
+
+void ScriptEngine::OnUpdateScene(Scene *scene, float deltaTime) {
+  if (!scene)
+    return;
+  FORGE_PROFILE_SCOPE("ScriptEngine::OnUpdateScene");
+
+  s_Data->SceneContext = scene;
+  s_Data->ParallelEntities.clear();
+  s_Data->MainThreadEntities.clear();
+
+  Clock::time_point start = Clock::now();
+  for (const auto &entity : scene->GetEntities()) {
+    ScriptComponent *script = entity->GetScript();
+    if (!script)
+      continue;
+    if (!script->Initialized)
+      InstantiateEntity(entity.get());
+    if (!script->ClassInfo || !script->ClassInfo->UpdateMethod)
+      continue;
+
+    if (s_Data->Workers && script->ClassInfo->ThreadSafe)
+      s_Data->ParallelEntities.push_back(entity.get());
+    else
+      s_Data->MainThreadEntities.push_back(entity.get());
+  }
+
+  // First-frame cost is where JIT compilation shows up (AOT comparison)
+  bool firstFrame = !s_Data->FirstFrameDone;
+  if (firstFrame) {
+    s_Data->StartupStats.FirstInstantiateMs = ElapsedMs(start);
+    start = Clock::now();
+  }
+
+  if (!s_Data->ParallelEntities.empty()) {
+    s_Data->InParallelPhase = true;
+    s_Data->Workers->ParallelFor(
+        (uint32_t)s_Data->ParallelEntities.size(), 16,
+        [deltaTime](uint32_t begin, uint32_t end, uint32_t) {
+          for (uint32_t i = begin; i < end; i++)
+            OnUpdateEntity(s_Data->ParallelEntities[i], deltaTime);
+        });
+    s_Data->InParallelPhase = false;
+  }
+
+  FlushDeferredCommands();
+
+  for (Entity *entity : s_Data->MainThreadEntities) {
+    OnUpdateEntity(entity, deltaTime);
   }
+
+  TickCoroutines(deltaTime);
+
+  if (firstFrame) {
+    s_Data->FirstFrameDone = true;
+    ScriptStartupStats &stats = s_Data->StartupStats;
+    stats.FirstUpdateMs = ElapsedMs(start);
+    std::cout << "[ScriptEngine] First frame ("
+              << (stats.AOTEnabled && stats.AOTImageFound ? "AOT" : "JIT")
+              << "): instantiate " << stats.FirstInstantiateMs
+              << " ms, update " << stats.FirstUpdateMs << " ms" << std::endl;
+  }
+}
+
+void ScriptEngine::TickCoroutines(float deltaTime) {
+  const std::vector<int32_t> &due = s_Data->Coroutines.Tick(deltaTime);
+  if (due.empty() || !s_Data->ResumeCoroutinesMethod)
+    return;
+
+  // One managed transition per frame for all due coroutines
+  MonoArray *ids = mono_array_new(s_Data->AppDomain, mono_get_int32_class(),
+                                  (uintptr_t)due.size());
+  for (size_t i = 0; i < due.size(); i++) {
+    mono_array_set(ids, int32_t, i, due[i]);
+  }
+
+  ScriptClassInfo info;
+  info.Class = s_Data->CoroutineClass;
+  void *params[] = {ids};
+  InvokeMethod(info, nullptr, s_Data->ResumeCoroutinesMethod, params);
+}
+
+CoroutineScheduler &ScriptEngine::GetCoroutineScheduler() {
+  return s_Data->Coroutines;
+}
+
+void ScriptEngine::OnFrameEnd(float frameWorkMs) {
+  if (!s_Data)
+    return;
+  GCPacer &pacer = s_Data->Pacer;
+  GCPacer::Decision decision =
+      pacer.OnFrameEnd((uint64_t)mono_gc_get_used_size(), frameWorkMs);
+
+  if (decision != GCPacer::Decision::None) {
+    Clock::time_point start = Clock::now();
+    mono_gc_collect(0); // nursery only
+    pacer.OnCollected(decision, ElapsedMs(start),
+                      (uint64_t)mono_gc_get_used_size());
+  }
+
+  ScriptHeapStats &stats = pacer.GetStats();
+  stats.HeapSizeBytes = (uint64_t)mono_gc_get_heap_size();
+  stats.MinorCollections = (uint64_t)mono_gc_collection_count(0);
+  stats.MajorCollections =
+      (uint64_t)mono_gc_collection_count(mono_gc_max_generation());
+}
+
+void ScriptEngine::SetGCPacingConfig(const GCPacingConfig &config) {
+  if (s_Data)
+    s_Data->Pacer.SetConfig(config);
+}
+
+ScriptHeapStats ScriptEngine::GetHeapStats() {
+  return s_Data ? s_Data->Pacer.GetStats() : ScriptHeapStats{};
+}
+
+void ScriptEngine::Defer(std::function<void()> command) {
+  if (!s_Data || !s_Data->InParallelPhase) {
+    command();
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(s_Data->DeferredMutex);
+  s_Data->DeferredCommands.push_back(std::move(command));
+}
+
+bool ScriptEngine::IsInParallelPhase() {
+  return s_Data && s_Data->InParallelPhase;
+}
+
+const ScriptStartupStats &ScriptEngine::GetStartupStats() {
+  static const ScriptStartupStats s_Empty;
+  return s_Data ? s_Data->StartupStats : s_Empty;
+}
+
+Scene *ScriptEngine::GetSceneContext() {
+  return s_Data ? s_Data->SceneContext : nullptr;
+}
+
+void ScriptEngine::FlushDeferredCommands() {
+  std::vector<std::function<void()>> commands;
+  {
+    std::lock_guard<std::mutex> lock(s_Data->DeferredMutex);
+    commands.swap(s_Data->DeferredCommands);
+  }
+
+  // Queue order == submission order within a thread; across threads the
+  // order is arbitrary, as it would be for any parallel producer.
+  for (auto &command : commands) {
+    command();
+  }
+}
+
+Entity *ScriptGlue::GetEntity(uint32_t id) {
+  Scene *scene = ScriptEngine::GetSceneContext();
+  return scene ? scene->FindEntityByID(id) : nullptr;
 }
 
 } // namespace Forge
@@ -1,9 +1,11 @@
 #pragma once
+#include "GCPacer.h"
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
-
 extern "C" {
 typedef struct _MonoDomain MonoDomain;
 typedef struct _MonoAssembly MonoAssembly;
@@ -11,32 +13,107 @@ typedef struct _MonoImage MonoImage;
 typedef struct _MonoClass MonoClass;
 typedef struct _MonoObject MonoObject;
 typedef struct _MonoMethod MonoMethod;
+typedef struct _MonoClassField MonoClassField;
 }
 
 namespace Forge {
 
 class Entity;
+class Scene;
+class CoroutineScheduler;
+
+// Cached per-class dispatch info (resolved once per assembly load)
+struct ScriptClassInfo {
+  MonoClass *Class = nullptr;
+  MonoMethod *StartMethod = nullptr;  // nullptr => not overridden
+  MonoMethod *UpdateMethod = nullptr; // nullptr => not overridden
+  bool ThreadSafe = false;            // [Forge.ThreadSafe]
+};
 
 struct ScriptComponent {
   std::string ClassName;
   MonoObject *Instance = nullptr;
+  uint32_t GCHandle = 0;
+  const ScriptClassInfo *ClassInfo = nullptr;
   bool Initialized = false;
 };
 
+#ifndef FORGE_SCRIPT_AOT
+#define FORGE_SCRIPT_AOT 0
+#endif
+
+struct ScriptEngineConfig {
+  // Worker threads attached to the script domain (0 = cores - 1)
+  uint32_t WorkerThreadCount = 0;
+  // Run [ThreadSafe] scripts' OnUpdate on workers
+  bool ParallelUpdate = true;
+  // Load precompiled native images (<assembly>.dll.so / .dll.dll) produced
+  // by `mono --aot` (CMake: FORGE_SCRIPT_AOT). Mono falls back to the JIT
+  // per assembly when an image is missing or doesn't match.
+  bool UseAOT = FORGE_SCRIPT_AOT;
+  std::string AssembliesPath = "mono/lib";
+  // Per-method allocation stats in the script profiler (slows every
+  // managed allocation, so opt-in; see ScriptProfiler::Init)
+  bool ProfileAllocations = false;
+  // Minor collections scheduled into idle frame slack (see GCPacer)
+  GCPacingConfig GCPacing;
+};
+
+// Startup cost, to compare JIT vs AOT runs
+struct ScriptStartupStats {
+  bool AOTEnabled = false;
+  bool AOTImageFound = false;
+  double InitMs = 0.0;
+  double LoadAssemblyMs = 0.0;
+  double FirstInstantiateMs = 0.0; // first frame: instantiate + OnStart
+  double FirstUpdateMs = 0.0;      // first frame: OnUpdate (all scripts)
+};
+
 class ScriptEngine {
 public:
-  static void Init();
+  static void Init(const ScriptEngineConfig &config = {});
   static void Shutdown();
 
   static void LoadAssembly(const std::string &path);
 
   static void InstantiateEntity(Entity *entity);
   static void OnUpdateEntity(Entity *entity, float deltaTime);
+  // Before the entity is deleted: frees its script's GC handle
+  static void OnDestroyEntity(Entity *entity);
+
+  // Updates every scripted entity in the scene: [ThreadSafe] classes run
+  // in parallel on the script workers, the rest serially on the calling
+  // (main) thread, then deferred commands are flushed.
+  static void OnUpdateScene(Scene *scene, float deltaTime);
+
+  // Structural changes requested by scripts (names, hierarchy, create /
+  // destroy). Executed immediately outside the parallel phase, queued and
+  // replayed on the main thread otherwise.
+  static void Defer(std::function<void()> command);
+  static bool IsInParallelPhase();
+
+  static Scene *GetSceneContext();
+
+  static const ScriptStartupStats &GetStartupStats();
+
+  // Coroutine waits (Forge.Coroutine); resumed at the end of OnUpdateScene
+  static CoroutineScheduler &GetCoroutineScheduler();
+
+  // Call once per frame after all script work, before the frame blocks on
+  // present/vsync. frameWorkMs is the CPU time the frame has used so far;
+  // the pacer may run a nursery collection in the remaining slack. No-op
+  // before Init.
+  static void OnFrameEnd(float frameWorkMs);
+  static void SetGCPacingConfig(const GCPacingConfig &config);
+  static ScriptHeapStats GetHeapStats();
 
   static MonoDomain *GetRootDomain();
   static MonoImage *GetCoreAssemblyImage();
 
 private:
+  static void FlushDeferredCommands();
+  static void TickCoroutines(float deltaTime);
+  static ScriptClassInfo *GetScriptClass(const std::string &className);
   static MonoObject *InstantiateClass(MonoClass *monoClass);
   static MonoClass *GetClassInImage(MonoImage *image,
                                     const std::string &namespaceName,
@@ -1,10 +1,11 @@
 #pragma once
 #include "../Scene/Entity.h"
+#include "CoroutineScheduler.h"
+#include "ScriptEngine.h"
 #include <iostream>
 #include <mono/metadata/loader.h>
 #include <mono/metadata/object.h>
 
-
 namespace Forge {
 
 class ScriptGlue {
@@ -29,44 +30,88 @@ public:
                            (void *)Transform_GetScale);
     mono_add_internal_call("Forge.InternalCalls::Transform_SetScale",
                            (void *)Transform_SetScale);
+
+    // Coroutine
+    mono_add_internal_call("Forge.InternalCalls::Coroutine_WaitSeconds",
+                           (void *)Coroutine_WaitSeconds);
+    mono_add_internal_call("Forge.InternalCalls::Coroutine_WaitFrames",
+                           (void *)Coroutine_WaitFrames);
+    mono_add_internal_call("Forge.InternalCalls::Coroutine_Signal",
+                           (void *)Coroutine_Signal);
+    mono_add_internal_call("Forge.InternalCalls::Coroutine_Cancel",
+                           (void *)Coroutine_Cancel);
   }
 
 private:
-  // Helper to get Entity from ID (This needs access to the active Scene)
+  // Helper to get Entity from ID (resolved against ScriptEngine's scene)
   static Entity *GetEntity(uint32_t id);
 
+  // Component data of the calling script's own entity may be touched from
+  // script workers ([ThreadSafe] contract). Anything structural goes through
+  // ScriptEngine::Defer.
+
   static MonoString *Entity_GetName(uint32_t id) {
-    // Entity* entity = GetEntity(id);
-    // return mono_string_new(mono_domain_get(), entity->GetName().c_str());
-    return mono_string_new(mono_domain_get(), "MockEntityName");
+    Entity *entity = GetEntity(id);
+    return mono_string_new(mono_domain_get(),
+                           entity ? entity->GetName().c_str() : "");
   }
 
   static void Entity_SetName(uint32_t id, MonoString *name) {
     char *nameStr = mono_string_to_utf8(name);
-    // GetEntity(id)->SetName(nameStr);
+    std::string value = nameStr;
     mono_free(nameStr);
+
+    ScriptEngine::Defer([id, value]() {
+      if (Entity *entity = GetEntity(id))
+        entity->SetName(value);
+    });
   }
 
   static void Transform_GetPosition(uint32_t id, XMFLOAT3 *outPos) {
-    // *outPos = GetEntity(id)->GetTransform().Position;
-    *outPos = {0, 0, 0};
+    Entity *entity = GetEntity(id);
+    *outPos = entity ? entity->GetTransform().Position : XMFLOAT3{0, 0, 0};
   }
 
   static void Transform_SetPosition(uint32_t id, XMFLOAT3 *inPos) {
-    // GetEntity(id)->GetTransform().Position = *inPos;
+    if (Entity *entity = GetEntity(id))
+      entity->GetTransform().Position = *inPos;
   }
 
   static void Transform_GetRotation(uint32_t id, XMFLOAT3 *outRot) {
-    *outRot = {0, 0, 0};
+    Entity *entity = GetEntity(id);
+    *outRot = entity ? entity->GetTransform().Rotation : XMFLOAT3{0, 0, 0};
   }
 
-  static void Transform_SetRotation(uint32_t id, XMFLOAT3 *inRot) {}
+  static void Transform_SetRotation(uint32_t id, XMFLOAT3 *inRot) {
+    if (Entity *entity = GetEntity(id))
+      entity->GetTransform().Rotation = *inRot;
+  }
 
   static void Transform_GetScale(uint32_t id, XMFLOAT3 *outScale) {
-    *outScale = {1, 1, 1};
+    Entity *entity = GetEntity(id);
+    *outScale = entity ? entity->GetTransform().Scale : XMFLOAT3{1, 1, 1};
+  }
+
+  static void Transform_SetScale(uint32_t id, XMFLOAT3 *inScale) {
+    if (Entity *entity = GetEntity(id))
+      entity->GetTransform().Scale = *inScale;
   }
 
-  static void Transform_SetScale(uint32_t id, XMFLOAT3 *inScale) {}
+  static void Coroutine_WaitSeconds(int32_t coroutineID, float seconds) {
+    ScriptEngine::GetCoroutineScheduler().WaitSeconds(coroutineID, seconds);
+  }
+
+  static void Coroutine_WaitFrames(int32_t coroutineID, int32_t frames) {
+    ScriptEngine::GetCoroutineScheduler().WaitFrames(coroutineID, frames);
+  }
+
+  static void Coroutine_Signal(int32_t coroutineID) {
+    ScriptEngine::GetCoroutineScheduler().Signal(coroutineID);
+  }
+
+  static void Coroutine_Cancel(int32_t coroutineID) {
+    ScriptEngine::GetCoroutineScheduler().Cancel(coroutineID);
+  }
 };
 
 } // namespace Forge
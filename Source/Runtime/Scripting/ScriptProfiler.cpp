@@ -0,0 +1,423 @@
+#include "ScriptProfiler.h"
+#include "../Core/Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mono/metadata/class.h>
+#include <mono/metadata/object.h>
+#include <mono/metadata/profiler.h>
+#include <mutex>
+#include <unordered_map>
+
+// Mono requires the embedder to define the profiler struct
+struct _MonoProfiler {
+  int Unused;
+};
+
+namespace Forge {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct MethodRecord {
+  MonoClass *Class = nullptr;
+  ScriptMethodStats Stats;
+};
+
+struct CallFrame {
+  MonoMethod *Method;
+  MonoClass *Class;
+  Clock::time_point Start;
+  uint64_t AllocatedBytes;
+  uint64_t AllocationCount;
+};
+
+// Self-contained: the method stats may be Reset mid-capture
+struct TraceEvent {
+  MonoMethod *Method; // nullptr => GC pause
+  MonoClass *Class;
+  uint32_t ThreadID;
+  int64_t StartUs;
+  int64_t DurationUs;
+  uint32_t Generation;
+};
+
+// Trace buffer cap (~32 MB) so a forgotten capture can't eat the heap
+constexpr size_t MaxTraceEvents = 1u << 20;
+
+// One thread's stats and trace. Only the owning thread adds to it; readers
+// merge every thread's buffer on demand. The mutex is uncontended except
+// while a reader merges, so dispatch never serializes across workers.
+struct ThreadStats {
+  std::mutex Mutex;
+  std::unordered_map<MonoMethod *, MethodRecord> Methods;
+  std::vector<TraceEvent> Trace;
+  uint64_t UnattributedAllocatedBytes = 0; // allocations outside dispatch
+  uint32_t ThreadID = 0;
+};
+
+struct ScriptProfilerData {
+  _MonoProfiler Profiler = {};
+  MonoProfilerHandle Handle = nullptr;
+  bool AllocationEvents = false; // chosen at Init, before the runtime
+  uint32_t Generation = 0;
+
+  std::atomic<bool> Enabled = false;
+  std::atomic<bool> Capturing = false;
+  std::atomic<size_t> TraceEvents = 0;
+  Clock::time_point Epoch = Clock::now();
+
+  // Guards Threads (the list) and GC
+  std::mutex Mutex;
+  std::vector<std::unique_ptr<ThreadStats>> Threads;
+  ScriptGCStats GC;
+
+  Clock::time_point GCPauseStart;
+  uint32_t GCGeneration = 0;
+};
+
+ScriptProfilerData *s_Data = nullptr;
+uint32_t s_Generation = 0;
+
+thread_local std::vector<CallFrame> t_CallStack;
+// Owned by s_Data; stale once the profiler is shut down and re-initialized
+thread_local ThreadStats *t_Stats = nullptr;
+thread_local uint32_t t_Generation = 0;
+
+ThreadStats &GetThreadStats() {
+  if (!t_Stats || t_Generation != s_Data->Generation) {
+    std::lock_guard<std::mutex> lock(s_Data->Mutex);
+    auto stats = std::make_unique<ThreadStats>();
+    stats->ThreadID = (uint32_t)s_Data->Threads.size();
+    t_Stats = stats.get();
+    t_Generation = s_Data->Generation;
+    s_Data->Threads.push_back(std::move(stats));
+  }
+  return *t_Stats;
+}
+
+int64_t ToTraceUs(Clock::time_point t) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(t -
+                                                               s_Data->Epoch)
+      .count();
+}
+
+// Adds a trace event to the calling thread's buffer (stats.Mutex held)
+void AddTraceEvent(ThreadStats &stats, MonoMethod *method, MonoClass *cls,
+                   Clock::time_point start, Clock::time_point end,
+                   uint32_t generation) {
+  if (!s_Data->Capturing ||
+      s_Data->TraceEvents.fetch_add(1, std::memory_order_relaxed) >=
+          MaxTraceEvents)
+    return;
+  int64_t startUs = ToTraceUs(start);
+  stats.Trace.push_back({method, cls, stats.ThreadID, startUs,
+                         ToTraceUs(end) - startUs, generation});
+}
+
+// Installed only while profiling is enabled
+void OnAllocation(MonoProfiler *, MonoObject *object) {
+  if (!s_Data || !s_Data->Enabled)
+    return;
+
+  uint64_t size = mono_object_get_size(object);
+  if (!t_CallStack.empty()) {
+    t_CallStack.back().AllocatedBytes += size;
+    t_CallStack.back().AllocationCount++;
+    return;
+  }
+
+  ThreadStats &stats = GetThreadStats();
+  std::lock_guard<std::mutex> lock(stats.Mutex);
+  stats.UnattributedAllocatedBytes += size;
+}
+
+void OnGCEvent(MonoProfiler *, MonoProfilerGCEvent event, uint32_t generation,
+               mono_bool) {
+  if (!s_Data)
+    return;
+
+  switch (event) {
+  case MONO_GC_EVENT_START:
+    s_Data->GCGeneration = generation;
+    break;
+  case MONO_GC_EVENT_PRE_STOP_WORLD:
+    s_Data->GCPauseStart = Clock::now();
+    break;
+  case MONO_GC_EVENT_POST_START_WORLD: {
+    Clock::time_point end = Clock::now();
+    double pauseMs =
+        std::chrono::duration<double, std::milli>(end - s_Data->GCPauseStart)
+            .count();
+
+    {
+      std::lock_guard<std::mutex> lock(s_Data->Mutex);
+      ScriptGCStats &gc = s_Data->GC;
+      gc.CollectionCount++;
+      gc.CollectionsByGeneration[s_Data->GCGeneration == 0 ? 0 : 1]++;
+      gc.TotalPauseMs += pauseMs;
+      gc.LastPauseMs = pauseMs;
+      gc.MaxPauseMs = std::max(gc.MaxPauseMs, pauseMs);
+    }
+
+    ThreadStats &stats = GetThreadStats();
+    std::lock_guard<std::mutex> lock(stats.Mutex);
+    AddTraceEvent(stats, nullptr, nullptr, s_Data->GCPauseStart, end,
+                  s_Data->GCGeneration);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+std::string GetClassName(MonoClass *monoClass) {
+  std::string ns = mono_class_get_namespace(monoClass);
+  std::string name = mono_class_get_name(monoClass);
+  return ns.empty() ? name : ns + "." + name;
+}
+
+} // namespace
+
+void ScriptProfiler::Init(bool allocationEvents) {
+  s_Data = new ScriptProfilerData();
+  s_Data->Generation = ++s_Generation;
+
+  // Mono routes every managed allocation through its slow path once
+  // allocation events are on, whether or not a callback is installed
+  if (allocationEvents) {
+    s_Data->AllocationEvents = mono_profiler_enable_allocations();
+    if (!s_Data->AllocationEvents)
+      std::cerr << "[ScriptProfiler] Allocation events unavailable"
+                << std::endl;
+  }
+
+  s_Data->Handle = mono_profiler_create(&s_Data->Profiler);
+  mono_profiler_set_gc_event_callback(s_Data->Handle, OnGCEvent);
+
+  std::cout << "[ScriptProfiler] Initialized (allocation events "
+            << (s_Data->AllocationEvents ? "on" : "off") << ")" << std::endl;
+}
+
+void ScriptProfiler::Shutdown() {
+  if (!s_Data)
+    return;
+
+  // Mono has no profiler destroy; detach the callbacks instead
+  mono_profiler_set_gc_allocation_callback(s_Data->Handle, nullptr);
+  mono_profiler_set_gc_event_callback(s_Data->Handle, nullptr);
+  delete s_Data;
+  s_Data = nullptr;
+}
+
+void ScriptProfiler::SetEnabled(bool enabled) {
+  if (!s_Data)
+    return;
+  s_Data->Enabled = enabled;
+  // No per-allocation callback while profiling is off
+  if (s_Data->AllocationEvents)
+    mono_profiler_set_gc_allocation_callback(s_Data->Handle,
+                                             enabled ? OnAllocation : nullptr);
+}
+
+bool ScriptProfiler::IsEnabled() { return s_Data && s_Data->Enabled; }
+
+void ScriptProfiler::Reset() {
+  if (!s_Data)
+    return;
+
+  std::lock_guard<std::mutex> lock(s_Data->Mutex);
+  for (const auto &stats : s_Data->Threads) {
+    std::lock_guard<std::mutex> threadLock(stats->Mutex);
+    stats->Methods.clear();
+    stats->UnattributedAllocatedBytes = 0;
+  }
+  s_Data->GC = {};
+}
+
+void ScriptProfiler::StartCapture() {
+  if (!s_Data)
+    return;
+
+  std::lock_guard<std::mutex> lock(s_Data->Mutex);
+  for (const auto &stats : s_Data->Threads) {
+    std::lock_guard<std::mutex> threadLock(stats->Mutex);
+    stats->Trace.clear();
+  }
+  s_Data->TraceEvents = 0;
+  s_Data->Capturing = true;
+}
+
+void ScriptProfiler::StopCapture() {
+  if (s_Data)
+    s_Data->Capturing = false;
+}
+
+bool ScriptProfiler::IsCapturing() { return s_Data && s_Data->Capturing; }
+
+void ScriptProfiler::BeginCall(MonoClass *monoClass, MonoMethod *method) {
+  t_CallStack.push_back({method, monoClass, Clock::now(), 0, 0});
+}
+
+void ScriptProfiler::EndCall() {
+  if (t_CallStack.empty())
+    return;
+
+  Clock::time_point end = Clock::now();
+  CallFrame frame = t_CallStack.back();
+  t_CallStack.pop_back();
+
+  // Inclusive accounting: callee allocations roll up into the caller
+  if (!t_CallStack.empty()) {
+    t_CallStack.back().AllocatedBytes += frame.AllocatedBytes;
+    t_CallStack.back().AllocationCount += frame.AllocationCount;
+  }
+
+  if (!s_Data)
+    return;
+
+  ThreadStats &stats = GetThreadStats();
+  std::lock_guard<std::mutex> lock(stats.Mutex);
+  MethodRecord &record = stats.Methods[frame.Method];
+  if (!record.Class) {
+    record.Class = frame.Class;
+    record.Stats.MethodName = mono_method_get_name(frame.Method);
+  }
+  record.Stats.CallCount++;
+  record.Stats.InclusiveMs +=
+      std::chrono::duration<double, std::milli>(end - frame.Start).count();
+  record.Stats.AllocatedBytes += frame.AllocatedBytes;
+  record.Stats.AllocationCount += frame.AllocationCount;
+  AddTraceEvent(stats, frame.Method, frame.Class, frame.Start, end, 0);
+}
+
+std::vector<ScriptClassStats> ScriptProfiler::GetClassStats() {
+  std::vector<ScriptClassStats> result;
+  if (!s_Data)
+    return result;
+
+  // Merge every thread's records per method
+  std::unordered_map<MonoMethod *, MethodRecord> methods;
+  {
+    std::lock_guard<std::mutex> lock(s_Data->Mutex);
+    for (const auto &stats : s_Data->Threads) {
+      std::lock_guard<std::mutex> threadLock(stats->Mutex);
+      for (const auto &[method, record] : stats->Methods) {
+        MethodRecord &merged = methods[method];
+        if (!merged.Class) {
+          merged = record;
+          continue;
+        }
+        merged.Stats.CallCount += record.Stats.CallCount;
+        merged.Stats.InclusiveMs += record.Stats.InclusiveMs;
+        merged.Stats.AllocatedBytes += record.Stats.AllocatedBytes;
+        merged.Stats.AllocationCount += record.Stats.AllocationCount;
+      }
+    }
+  }
+
+  std::unordered_map<MonoClass *, size_t> classIndex;
+  for (const auto &[method, record] : methods) {
+    if (!record.Class)
+      continue;
+    auto it = classIndex.find(record.Class);
+    if (it == classIndex.end()) {
+      it = classIndex.emplace(record.Class, result.size()).first;
+      result.push_back({});
+      result.back().ClassName = GetClassName(record.Class);
+    }
+
+    ScriptClassStats &cls = result[it->second];
+    cls.CallCount += record.Stats.CallCount;
+    cls.InclusiveMs += record.Stats.InclusiveMs;
+    cls.AllocatedBytes += record.Stats.AllocatedBytes;
+    cls.AllocationCount += record.Stats.AllocationCount;
+    cls.Methods.push_back(record.Stats);
+  }
+
+  for (ScriptClassStats &cls : result) {
+    std::sort(cls.Methods.begin(), cls.Methods.end(),
+              [](const ScriptMethodStats &a, const ScriptMethodStats &b) {
+                return a.InclusiveMs > b.InclusiveMs;
+              });
+  }
+  std::sort(result.begin(), result.end(),
+            [](const ScriptClassStats &a, const ScriptClassStats &b) {
+              return a.InclusiveMs > b.InclusiveMs;
+            });
+  return result;
+}
+
+ScriptGCStats ScriptProfiler::GetGCStats() {
+  if (!s_Data)
+    return {};
+
+  std::lock_guard<std::mutex> lock(s_Data->Mutex);
+  ScriptGCStats gc = s_Data->GC;
+  for (const auto &stats : s_Data->Threads) {
+    std::lock_guard<std::mutex> threadLock(stats->Mutex);
+    gc.UnattributedAllocatedBytes += stats->UnattributedAllocatedBytes;
+  }
+  return gc;
+}
+
+bool ScriptProfiler::ExportTrace(const std::string &path) {
+  if (!s_Data)
+    return false;
+
+  std::ofstream out(path);
+  if (!out) {
+    std::cerr << "[ScriptProfiler] Failed to open " << path << std::endl;
+    return false;
+  }
+
+  std::vector<TraceEvent> trace;
+  {
+    std::lock_guard<std::mutex> lock(s_Data->Mutex);
+    for (const auto &stats : s_Data->Threads) {
+      std::lock_guard<std::mutex> threadLock(stats->Mutex);
+      trace.insert(trace.end(), stats->Trace.begin(), stats->Trace.end());
+    }
+  }
+  std::sort(trace.begin(), trace.end(),
+            [](const TraceEvent &a, const TraceEvent &b) {
+              return a.StartUs < b.StartUs;
+            });
+  std::unordered_map<MonoMethod *, std::string> names;
+
+  out << "{\"traceEvents\":[\n";
+  for (size_t i = 0; i < trace.size(); i++) {
+    const TraceEvent &e = trace[i];
+    if (i > 0)
+      out << ",\n";
+
+    out << "{\"ph\":\"X\",\"pid\":0,\"tid\":" << e.ThreadID
+        << ",\"ts\":" << e.StartUs << ",\"dur\":" << e.DurationUs << ",";
+    if (!e.Method) {
+      out << "\"cat\":\"gc\",\"name\":\"GC Pause\",\"args\":{\"generation\":"
+          << e.Generation << "}}";
+      continue;
+    }
+
+    auto it = names.find(e.Method);
+    if (it == names.end()) {
+      std::string name = e.Class ? GetClassName(e.Class) + "::" : std::string();
+      name += mono_method_get_name(e.Method);
+      it = names.emplace(e.Method, name).first;
+    }
+    out << "\"cat\":\"script\",\"name\":";
+    WriteJsonString(out, it->second);
+    out << "}";
+  }
+  out << "\n]}\n";
+
+  std::cout << "[ScriptProfiler] Exported " << trace.size()
+            << " events to " << path << std::endl;
+  return true;
+}
+
+} // namespace Forge
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+extern "C" {
+typedef struct _MonoClass MonoClass;
+typedef struct _MonoMethod MonoMethod;
+}
+
+namespace Forge {
+
+struct ScriptMethodStats {
+  std::string MethodName;
+  uint64_t CallCount = 0;
+  double InclusiveMs = 0.0;
+  uint64_t AllocatedBytes = 0; // inclusive (callee allocations included)
+  uint64_t AllocationCount = 0;
+};
+
+struct ScriptClassStats {
+  std::string ClassName;
+  uint64_t CallCount = 0;
+  double InclusiveMs = 0.0;
+  uint64_t AllocatedBytes = 0;
+  uint64_t AllocationCount = 0;
+  std::vector<ScriptMethodStats> Methods;
+};
+
+struct ScriptGCStats {
+  uint64_t CollectionCount = 0;
+  uint64_t CollectionsByGeneration[2] = {0, 0}; // [0] nursery, [1] major
+  double TotalPauseMs = 0.0;
+  double LastPauseMs = 0.0;
+  double MaxPauseMs = 0.0;
+  uint64_t UnattributedAllocatedBytes = 0; // allocations outside dispatch
+};
+
+// Script dispatch / GC 계측
+// ScriptEngine이 모든 managed 호출을 Scope로 감싼다.
+class ScriptProfiler {
+public:
+  // Must run before mono_jit_init (allocation events need to be enabled
+  // before the runtime starts). allocationEvents: per-method allocation
+  // stats; Mono then takes its slow allocation path for the whole run.
+  static void Init(bool allocationEvents = false);
+  static void Shutdown();
+
+  // Off by default. The allocation callback is only installed while on.
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled();
+  // Drops the stats; a running or stopped capture is kept
+  static void Reset();
+
+  // Trace capture (Chrome trace JSON, chrome://tracing / Perfetto)
+  static void StartCapture();
+  static void StopCapture();
+  static bool IsCapturing();
+  static bool ExportTrace(const std::string &path);
+
+  static void BeginCall(MonoClass *monoClass, MonoMethod *method);
+  static void EndCall();
+
+  class Scope {
+  public:
+    Scope(MonoClass *monoClass, MonoMethod *method)
+        : m_Active(ScriptProfiler::IsEnabled()) {
+      if (m_Active)
+        ScriptProfiler::BeginCall(monoClass, method);
+    }
+    ~Scope() {
+      if (m_Active)
+        ScriptProfiler::EndCall();
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    bool m_Active;
+  };
+
+  // Snapshot, sorted by inclusive time (descending)
+  static std::vector<ScriptClassStats> GetClassStats();
+  static ScriptGCStats GetGCStats();
+};
+
+} // namespace Forge
@@ -0,0 +1,100 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Forge::Bench {
+
+using Clock = std::chrono::high_resolution_clock;
+
+inline double ElapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+// A named benchmark; returns the process exit code (0 = pass)
+struct BenchEntry {
+  std::string Name;
+  std::string Description;
+  std::function<int(const std::vector<std::string> &args)> Run;
+};
+
+// Each *Bench.cpp registers itself with a static Registrar
+std::vector<BenchEntry> &GetRegistry();
+
+struct Registrar {
+  Registrar(const char *name, const char *description,
+            std::function<int(const std::vector<std::string> &)> run) {
+    GetRegistry().push_back({name, description, std::move(run)});
+  }
+};
+
+// "--name=value" lookup with default
+int GetIntArg(const std::vector<std::string> &args, const char *name,
+              int defaultValue);
+
+// Camera matrices for headless scenes: row-major, row vectors
+// (DirectXMath conventions, like EditorCamera)
+inline void LookAtLH(const float eye[3], const float at[3], float *out) {
+  auto normalize = [](float *v) {
+    float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    for (int i = 0; i < 3; i++)
+      v[i] /= length;
+  };
+  float z[3] = {at[0] - eye[0], at[1] - eye[1], at[2] - eye[2]};
+  normalize(z);
+  float x[3] = {z[2], 0.0f, -z[0]}; // cross(up = +Y, z)
+  normalize(x);
+  float y[3] = {z[1] * x[2] - z[2] * x[1], z[2] * x[0] - z[0] * x[2],
+                z[0] * x[1] - z[1] * x[0]};
+  auto dot = [&](const float *v) {
+    return v[0] * eye[0] + v[1] * eye[1] + v[2] * eye[2];
+  };
+  const float m[16] = {x[0],    y[0],    z[0],    0.0f, x[1],    y[1],
+                       z[1],    0.0f,    x[2],    y[2], z[2],    0.0f,
+                       -dot(x), -dot(y), -dot(z), 1.0f};
+  std::copy(m, m + 16, out);
+}
+
+inline void PerspectiveFovLH(float fovY, float aspect, float nearZ,
+                             float farZ, float *out) {
+  float h = 1.0f / std::tan(fovY * 0.5f);
+  float range = farZ / (farZ - nearZ);
+  const float m[16] = {h / aspect, 0, 0,     0, 0, h, 0, 0, 0, 0, range, 1,
+                       0,          0, -range * nearZ, 0};
+  std::copy(m, m + 16, out);
+}
+
+// SceneViewRenderer's unit cube: non-indexed triangle list, float3
+inline std::vector<float> MakeCubePositions() {
+  const float faces[6][3][3] = {
+      {{1, 0, 0}, {0, 0, 1}, {0, 1, 0}},  {{-1, 0, 0}, {0, 1, 0}, {0, 0, 1}},
+      {{0, 1, 0}, {1, 0, 0}, {0, 0, 1}},  {{0, -1, 0}, {0, 0, 1}, {1, 0, 0}},
+      {{0, 0, 1}, {0, 1, 0}, {1, 0, 0}},  {{0, 0, -1}, {1, 0, 0}, {0, 1, 0}},
+  };
+  const float corners[6][2] = {{-1, -1}, {1, -1}, {1, 1},
+                               {-1, -1}, {1, 1},  {-1, 1}};
+  std::vector<float> positions;
+  for (const auto &face : faces) {
+    for (const auto &corner : corners) {
+      for (int c = 0; c < 3; c++)
+        positions.push_back(0.5f * (face[0][c] + corner[0] * face[1][c] +
+                                    corner[1] * face[2][c]));
+    }
+  }
+  return positions;
+}
+
+inline void Multiply(const float *a, const float *b, float *out) {
+  for (int row = 0; row < 4; row++)
+    for (int column = 0; column < 4; column++)
+      out[row * 4 + column] = a[row * 4] * b[column] +
+                              a[row * 4 + 1] * b[4 + column] +
+                              a[row * 4 + 2] * b[8 + column] +
+                              a[row * 4 + 3] * b[12 + column];
+}
+
+} // namespace Forge::Bench
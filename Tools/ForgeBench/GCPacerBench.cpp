@@ -0,0 +1,143 @@
+#include "Bench.h"
+#include "Scripting/GCPacer.h"
+#include <iostream>
+#include <random>
+
+// GC pacer on a simulated script heap: per-frame allocation with bursts
+// and random CPU frame times. Every decision is checked against the
+// policy (paced only with the estimated pause inside slack and budget,
+// urgent only at the fill threshold, nothing below the minimum growth),
+// the nursery must never overflow (SGen collecting on its own), and
+// only paced collections may update LastPacedMs. A second run has no
+// slack at all (only urgent collections), a third has pacing disabled.
+
+namespace Forge::Bench {
+
+namespace {
+
+struct PacerRun {
+  uint64_t Paced = 0;
+  uint64_t Urgent = 0;
+  uint64_t RuntimeCollections = 0; // nursery overflowed
+  double GCMs = 0.0;
+  uint64_t PolicyErrors = 0;
+  uint64_t StatsErrors = 0;
+  double DecisionMs = 0.0;
+};
+
+PacerRun Simulate(const GCPacingConfig &config, int frames, float minWorkMs,
+                  float maxWorkMs, uint32_t seed) {
+  constexpr double BytesPerMB = 1024.0 * 1024.0;
+  std::mt19937 rng(seed);
+  GCPacer pacer(config);
+  PacerRun run;
+
+  const uint64_t nurseryBytes = config.NurserySizeKB * 1024ull;
+  uint64_t used = 8 * 1024 * 1024; // old generation, never collected
+  const uint64_t baseline = used;
+  for (int frame = 0; frame < frames; frame++) {
+    // Mostly steady allocation, some heavy frames (spawns, UI rebuilds)
+    uint64_t allocated = 16 * 1024 + rng() % (48 * 1024);
+    if (rng() % 32 == 0)
+      allocated += 256 * 1024 + rng() % (256 * 1024);
+    used += allocated;
+    if (used - baseline >= nurseryBytes) {
+      used = baseline; // the runtime collects at a point we didn't choose
+      run.RuntimeCollections++;
+    }
+
+    float workMs =
+        minWorkMs + (maxWorkMs - minWorkMs) * (float)(rng() % 1000) / 1000.0f;
+    auto start = Clock::now();
+    GCPacer::Decision decision = pacer.OnFrameEnd(used, workMs);
+    run.DecisionMs += ElapsedMs(start);
+
+    const ScriptHeapStats &stats = pacer.GetStats();
+    bool enoughGrowth = stats.GrowthSinceCollectBytes >=
+                        config.MinGrowthKB * 1024ull;
+    double projected =
+        stats.GrowthSinceCollectBytes + stats.AvgGrowthPerFrameBytes;
+    bool urgent = projected >= nurseryBytes * (double)config.UrgentFillRatio;
+    double allowedMs =
+        std::min<double>(config.TargetFrameMs - workMs, config.GCBudgetMs);
+    bool fits = stats.EstimatedMinorMs <= allowedMs;
+
+    GCPacer::Decision expected = GCPacer::Decision::None;
+    if (config.Enabled && enoughGrowth)
+      expected = urgent ? GCPacer::Decision::Urgent
+                 : fits ? GCPacer::Decision::Paced
+                        : GCPacer::Decision::None;
+    if (decision != expected)
+      run.PolicyErrors++;
+    if (decision == GCPacer::Decision::None)
+      continue;
+
+    // Fake minor collection: fixed cost + per-MB of nursery survivors
+    double pauseMs = 0.05 + 0.4 * (double)(used - baseline) / BytesPerMB;
+    double lastPaced = stats.LastPacedMs;
+    used = baseline;
+    pacer.OnCollected(decision, pauseMs, used);
+    run.GCMs += pauseMs;
+    if (decision == GCPacer::Decision::Paced) {
+      run.Paced++;
+      if (pacer.GetStats().LastPacedMs != pauseMs)
+        run.StatsErrors++;
+    } else {
+      run.Urgent++;
+      if (pacer.GetStats().LastPacedMs != lastPaced)
+        run.StatsErrors++;
+    }
+    if (pacer.GetStats().GrowthSinceCollectBytes != 0)
+      run.StatsErrors++;
+  }
+
+  const ScriptHeapStats &stats = pacer.GetStats();
+  if (stats.PacedCollections != run.Paced ||
+      stats.UrgentCollections != run.Urgent)
+    run.StatsErrors++;
+  return run;
+}
+
+} // namespace
+
+static int RunGCPacerBench(const std::vector<std::string> &args) {
+  const int frames = GetIntArg(args, "frames", 100000);
+
+  // 8..20 ms of CPU work against a 16.67 ms target: some frames have
+  // slack, some overrun
+  GCPacingConfig config;
+  PacerRun paced = Simulate(config, frames, 8.0f, 20.0f, 99);
+  PacerRun noSlack = Simulate(config, frames, 17.0f, 25.0f, 99);
+  config.Enabled = false;
+  PacerRun unpaced = Simulate(config, frames, 8.0f, 20.0f, 99);
+
+  auto print = [](const char *label, const PacerRun &run) {
+    std::cout << "  " << label << ": " << run.Paced << " paced, "
+              << run.Urgent << " urgent, " << run.RuntimeCollections
+              << " runtime-triggered, " << run.GCMs << " ms GC" << std::endl;
+  };
+  print("slack", paced);
+  print("no slack", noSlack);
+  print("disabled", unpaced);
+  std::cout << "  decision " << paced.DecisionMs * 1e6 / frames << " ns/frame"
+            << std::endl;
+
+  // With pacing on the nursery never fills; with it off the pacer must
+  // never collect
+  uint64_t errors = 0;
+  for (const PacerRun *run : {&paced, &noSlack, &unpaced})
+    errors += run->PolicyErrors + run->StatsErrors;
+  errors += paced.RuntimeCollections + noSlack.RuntimeCollections;
+  errors += noSlack.Paced + unpaced.Paced + unpaced.Urgent;
+  if (paced.Paced == 0 || noSlack.Urgent == 0 ||
+      unpaced.RuntimeCollections == 0)
+    errors++; // the scenarios must exercise every path
+  std::cout << "  validation errors: " << errors << std::endl;
+  return errors == 0 ? 0 : 1;
+}
+
+static Registrar s_GCPacerBench(
+    "gcpacer", "Frame-budgeted script GC pacing: decisions and stats",
+    RunGCPacerBench);
+
+} // namespace Forge::Bench
@@ -0,0 +1,215 @@
+#include "Bench.h"
+#include "Core/Profiler.h"
+#include "RHI/FrameContext.h"
+#include "RHI/GPUProfiler.h"
+#include "RHI/Null/NullRHI.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// GPU timestamp scopes on the null backend, whose fake GPU clock makes every
+// duration exact. Each frame records a "Frame" scope around a "Scene" pass
+// with a frame-dependent amount of work and an "ImGui" pass; the bench then
+// checks that frames come back in order once their fence completes, that
+// no readback ever shows a frame before the GPU finished it (resolved
+// queries only land at retirement), that durations match the work
+// recorded, and that the scopes appear on the CPU profiler's timeline
+// inside the frames they started in. Also reports the CPU cost of a scope.
+
+namespace Forge::Bench {
+
+static int RunGPUProfilerBench(const std::vector<std::string> &args) {
+  const int frames = GetIntArg(args, "frames", 500);
+  const uint32_t framesInFlight = (uint32_t)GetIntArg(args, "inflight", 2);
+
+  NullRHIConfig config;
+  config.GPULatency = (uint32_t)GetIntArg(args, "latency", 2);
+  // Short enough that the fake GPU keeps up with the loop, as the frame
+  // ring's fence waits would make a real one (the null fences only count)
+  config.TicksPerCommand = 50;
+  NullRHIDevice device(config);
+  auto queue = device.CreateCommandQueue(RHIQueueType::Direct);
+  FrameContextRing frameRing;
+  frameRing.Initialize(&device, queue.get(), framesInFlight);
+
+  Profiler::SetEnabled(true);
+  Profiler::NextFrame();
+  Profiler::Reset();
+
+  GPUProfiler gpu;
+  if (!gpu.Initialize(&device, queue.get(), framesInFlight, "Bench GPU")) {
+    std::cout << "  validation errors: 1" << std::endl;
+    return 1;
+  }
+  const uint32_t gpuTrack = gpu.GetTrack();
+
+  // Scene work varies per frame, so a readback of the wrong frame shows
+  const uint64_t tick = config.TicksPerCommand;
+  auto sceneCommands = [](uint64_t frame) { return 3 + frame % 7; };
+  const uint32_t imguiCommands = 2;
+  auto record = [](RHICommandList *list, uint64_t commands) {
+    for (uint64_t i = 0; i < commands; i++)
+      list->SetViewport({0, 0, 1280, 720, 0, 1});
+  };
+
+  uint64_t orderErrors = 0, timingErrors = 0, correlationErrors = 0;
+  uint64_t nextFrame = 0; // oldest frame not read back yet
+  std::vector<int64_t> recordStartNs;
+  double scopeCpuMs = 0.0;
+
+  auto checkReadback = [&](uint64_t resolvedBefore) {
+    uint64_t resolved = gpu.GetStats().FramesResolved - resolvedBefore;
+    if (resolved == 0)
+      return;
+    // Only the newest of the frames read this time is kept
+    uint64_t frame = nextFrame + resolved - 1;
+    nextFrame += resolved;
+    const std::vector<GPUScopeTiming> &timings = gpu.GetLastFrame();
+    if (timings.size() != 3 || std::strcmp(timings[0].Name, "Frame") != 0 ||
+        std::strcmp(timings[1].Name, "Scene") != 0 ||
+        std::strcmp(timings[2].Name, "ImGui") != 0 ||
+        timings[0].Depth != 0 || timings[1].Depth != 1 ||
+        timings[2].Depth != 1) {
+      orderErrors++;
+      return;
+    }
+    // A timestamp lands once its own command runs: scope = work + 1
+    const int64_t scene = (int64_t)((sceneCommands(frame) + 1) * tick);
+    const int64_t imgui = (int64_t)((imguiCommands + 1) * tick);
+    const int64_t whole = (int64_t)((sceneCommands(frame) + imguiCommands +
+                                     4 + 1) * tick);
+    if (timings[1].EndNs - timings[1].StartNs != scene ||
+        timings[2].EndNs - timings[2].StartNs != imgui ||
+        timings[0].EndNs - timings[0].StartNs != whole)
+      timingErrors++;
+    // On the CPU timeline the GPU cannot start before the frame was
+    // recorded (1 us slack for the clock mapping)
+    if (frame >= recordStartNs.size() ||
+        timings[0].StartNs < recordStartNs[frame] - 1000)
+      correlationErrors++;
+  };
+
+  for (int frame = 0; frame < frames; frame++) {
+    recordStartNs.push_back(Profiler::GetTimeNs());
+    RHICommandList *list = frameRing.BeginFrame();
+    uint64_t resolvedBefore = gpu.GetStats().FramesResolved;
+    gpu.BeginFrame(frameRing.GetCompletedFenceValue());
+    checkReadback(resolvedBefore);
+
+    auto start = Clock::now();
+    uint32_t frameScope = gpu.BeginScope(list, "Frame");
+    uint32_t sceneScope = gpu.BeginScope(list, "Scene");
+    scopeCpuMs += ElapsedMs(start);
+    record(list, sceneCommands((uint64_t)frame));
+    start = Clock::now();
+    gpu.EndScope(list, sceneScope);
+    {
+      GPUProfileScope imguiScope(&gpu, list, "ImGui");
+      scopeCpuMs += ElapsedMs(start);
+      record(list, imguiCommands);
+      start = Clock::now();
+    }
+    gpu.EndScope(list, frameScope);
+    gpu.Resolve(list, frameRing.GetCurrentFenceValue());
+    scopeCpuMs += ElapsedMs(start);
+
+    frameRing.Submit();
+    Profiler::NextFrame();
+  }
+
+  // Drain: the remaining frames are read once the GPU is idle
+  frameRing.WaitIdle();
+  uint64_t resolvedBefore = gpu.GetStats().FramesResolved;
+  gpu.BeginFrame(frameRing.GetCompletedFenceValue());
+  checkReadback(resolvedBefore);
+  Profiler::NextFrame();
+  const GPUProfilerStats stats = gpu.GetStats();
+  if (stats.FramesResolved != (uint64_t)frames || stats.FramesLost != 0 ||
+      stats.PendingFrames != 0 || nextFrame != (uint64_t)frames)
+    orderErrors++;
+
+  // The track on the CPU timeline: every event inside the frame it started
+  // in. A GPU frame's scopes may be filed into different CPU frames, some
+  // were dropped at the oldest edge of the history and the newest may still
+  // wait for their frame, so they are matched per GPU frame: only Frame
+  // scopes holding both their Scene and ImGui scopes count, and only scopes
+  // before the oldest Frame may be orphans.
+  uint64_t trackEvents = 0, trackFrames = 0;
+  std::vector<ProfileEvent> roots, children;
+  std::vector<ProfileFrame> history = Profiler::GetHistory();
+  for (size_t i = 0; i < history.size(); i++) {
+    for (const ProfileEvent &e : history[i].Events) {
+      if (e.Thread != gpuTrack)
+        continue;
+      trackEvents++;
+      (e.Depth == 0 ? roots : children).push_back(e);
+      bool before = e.StartNs < history[i].StartNs;
+      bool after = i + 1 < history.size() &&
+                   e.StartNs >= history[i + 1].StartNs;
+      if (before || after)
+        correlationErrors++;
+    }
+  }
+  auto byStart = [](const ProfileEvent &a, const ProfileEvent &b) {
+    return a.StartNs < b.StartNs;
+  };
+  std::sort(roots.begin(), roots.end(), byStart);
+  std::sort(children.begin(), children.end(), byStart);
+  size_t child = 0;
+  for (const ProfileEvent &root : roots) {
+    // Orphans: older than this frame, yet after the previous one
+    for (; child < children.size() && children[child].StartNs < root.StartNs;
+         child++) {
+      if (&root != &roots.front())
+        correlationErrors++;
+    }
+    uint32_t scene = 0, imgui = 0;
+    for (; child < children.size() && children[child].StartNs < root.EndNs;
+         child++) {
+      scene += std::strcmp(children[child].Name, "Scene") == 0 ? 1 : 0;
+      imgui += std::strcmp(children[child].Name, "ImGui") == 0 ? 1 : 0;
+    }
+    if (std::strcmp(root.Name, "Frame") != 0 || scene > 1 || imgui > 1)
+      correlationErrors++;
+    else if (scene == 1 && imgui == 1)
+      trackFrames++;
+  }
+  if (child != children.size())
+    correlationErrors++;
+  const uint64_t expectedTrackFrames =
+      std::min<uint64_t>((uint64_t)frames, Profiler::HistoryFrames);
+  // The oldest history frames may have lost theirs (older than the history
+  // when they arrived), the newest one its children
+  if (trackFrames + framesInFlight + config.GPULatency + 1 <
+      expectedTrackFrames)
+    correlationErrors++;
+
+  gpu.Shutdown();
+  frameRing.Shutdown();
+  Profiler::Reset();
+
+  const NullRHIStats &rhi = device.GetStats();
+  std::cout << "  " << frames << " frames, " << framesInFlight
+            << " in flight, GPU latency " << config.GPULatency << std::endl;
+  std::cout << "  " << stats.FramesResolved << " frames read back ("
+            << stats.Scopes << " scopes, " << rhi.TimestampsWritten
+            << " timestamps, " << rhi.QueriesResolved << " resolved), "
+            << stats.FramesLost << " lost" << std::endl;
+  std::cout << "  last frame: " << stats.LastFrameMs
+            << " ms GPU; profiler track: " << trackEvents << " events, "
+            << trackFrames << " complete GPU frames in " << history.size()
+            << " frames" << std::endl;
+  std::cout << "  scope CPU cost: " << scopeCpuMs * 1e6 / (frames * 3.0)
+            << " ns (incl. resolve)" << std::endl;
+
+  size_t errors = device.GetValidationErrors().size() + orderErrors +
+                  timingErrors + correlationErrors;
+  std::cout << "  validation errors: " << errors << std::endl;
+  return errors == 0 ? 0 : 1;
+}
+
+static Registrar s_GPUProfilerBench(
+    "gpuprofile", "GPU timestamp scopes, readback latency, CPU correlation",
+    RunGPUProfilerBench);
+
+} // namespace Forge::Bench
@@ -0,0 +1,149 @@
+#include "Bench.h"
+#include "RHI/Null/NullRHI.h"
+#include "Renderer/ShaderHotReload.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+// Shader hot reload on a fake render loop: edits the shader source while
+// "frames" tick, then only the header it includes, then saves a broken
+// version. Measures the render-thread cost of Update() (must stay far
+// below the compile cost) and checks that a header edit reloads and a
+// failed compile keeps the previous pipeline bound.
+
+namespace Forge::Bench {
+
+static void WriteShader(const std::string &path, int variant, bool broken) {
+  std::ofstream file(path, std::ios::trunc);
+  file << "#include \"Common.hlsli\"\n";
+  file << "float4 VSMain(float3 p : POSITION) : SV_Position { return "
+          "float4(p, "
+       << variant << ".0); }\n";
+  file << "float4 PSMain() : SV_Target { return 1; }\n";
+  if (broken)
+    file << "#error broken\n";
+}
+
+static int RunHotReloadBench(const std::vector<std::string> &args) {
+  const int compileMs = GetIntArg(args, "compilems", 50);
+  const int frameMs = GetIntArg(args, "framems", 4);
+
+  std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "ForgeBenchHotReload";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  std::string path = (directory / "Test.hlsl").string();
+  std::string headerPath = (directory / "Common.hlsli").string();
+  auto writeHeader = [&](int version) {
+    std::ofstream file(headerPath, std::ios::trunc);
+    file << "static const float Version = " << version << ".0;\n";
+  };
+  writeHeader(0);
+  WriteShader(path, 0, false);
+
+  // Slow fake compiler that splices in Common.hlsli and rejects "#error"
+  ShaderCompileFunction compiler =
+      [compileMs, headerPath](const ShaderDesc &, const std::string &source,
+                              std::vector<uint8_t> &outBytecode,
+                              std::vector<std::string> &outIncludes,
+                              std::string &outErrors) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(compileMs));
+        std::ifstream header(headerPath);
+        std::string text(std::istreambuf_iterator<char>(header), {});
+        outIncludes.push_back(headerPath);
+        if (source.find("#error") != std::string::npos) {
+          outErrors = "Test.hlsl(4): error: broken";
+          return false;
+        }
+        text += source;
+        outBytecode.assign(text.begin(), text.end());
+        return true;
+      };
+
+  NullRHIDevice device;
+  ShaderCache shaderCache;
+  PipelineCache pipelineCache;
+  ShaderHotReload hotReload;
+  shaderCache.Initialize(directory / "cache", 16 * 1024 * 1024, "fake",
+                         compiler);
+  pipelineCache.Initialize(&device, {});
+  hotReload.Initialize(&shaderCache, &pipelineCache, 20);
+
+  RHIGraphicsPipelineDesc desc;
+  desc.InputLayout = {{"POSITION", 0, RHIFormat::RGB32_Float, 0, 0}};
+  desc.DebugName = "Test";
+  ShaderDesc vs, ps;
+  vs.SourcePath = ps.SourcePath = path;
+  vs.EntryPoint = "VSMain";
+  vs.Target = "vs_5_0";
+  ps.EntryPoint = "PSMain";
+  ps.Target = "ps_5_0";
+  ReloadablePipeline *pipeline = hotReload.CreatePipeline(desc, vs, ps);
+  if (!pipeline) {
+    std::cout << "  initial build failed" << std::endl;
+    return 1;
+  }
+
+  double maxUpdateMs = 0.0;
+  auto runFramesUntil = [&](auto condition, int maxFrames) {
+    for (int frame = 0; frame < maxFrames; frame++) {
+      auto start = Clock::now();
+      hotReload.Update();
+      maxUpdateMs = std::max(maxUpdateMs, ElapsedMs(start));
+      if (condition())
+        return frame + 1;
+      std::this_thread::sleep_for(std::chrono::milliseconds(frameMs));
+    }
+    return -1;
+  };
+
+  // Some file systems keep whole-second write times
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  WriteShader(path, 1, false);
+  RHIPipelineState *before = pipeline->Get();
+  int reloadFrames =
+      runFramesUntil([&] { return pipeline->GetVersion() == 1; }, 2000);
+  bool swapped = reloadFrames > 0 && pipeline->Get() != before;
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  writeHeader(1);
+  before = pipeline->Get();
+  int headerFrames =
+      runFramesUntil([&] { return pipeline->GetVersion() == 2; }, 2000);
+  bool headerSwapped = headerFrames > 0 && pipeline->Get() != before;
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  WriteShader(path, 2, true);
+  RHIPipelineState *good = pipeline->Get();
+  runFramesUntil([&] { return hotReload.GetStats().Failures > 0; }, 2000);
+  runFramesUntil([] { return false; }, 10); // drain any pending swap
+  bool keptOld = pipeline->Get() == good && pipeline->GetVersion() == 2;
+
+  hotReload.Shutdown();
+  ShaderHotReloadStats stats = hotReload.GetStats();
+  pipelineCache.Shutdown();
+  shaderCache.Shutdown();
+  std::filesystem::remove_all(directory);
+
+  std::cout << "  reload after " << reloadFrames << " frames, swapped "
+            << (swapped ? "yes" : "no") << ", failed compile kept old PSO "
+            << (keptOld ? "yes" : "no") << std::endl;
+  std::cout << "  header edit reload after " << headerFrames
+            << " frames, swapped " << (headerSwapped ? "yes" : "no")
+            << std::endl;
+  std::cout << "  polls " << stats.Polls << ", reloads " << stats.Reloads
+            << ", failures " << stats.Failures << std::endl;
+  std::cout << "  max Update() " << maxUpdateMs << " ms (compile "
+            << compileMs << " ms x2 per rebuild)" << std::endl;
+  size_t errors = device.GetValidationErrors().size();
+  std::cout << "  validation errors: " << errors << std::endl;
+  bool reloaded = swapped && headerSwapped && keptOld;
+  return (errors == 0 && reloaded && maxUpdateMs < compileMs) ? 0 : 1;
+}
+
+static Registrar s_HotReloadBench("hotreload",
+                                  "Background shader rebuild + PSO swap",
+                                  RunHotReloadBench);
+
+} // namespace Forge::Bench
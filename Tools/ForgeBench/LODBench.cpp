@@ -0,0 +1,169 @@
+#include "Bench.h"
+#include "Core/JobSystem.h"
+#include "Renderer/LODSelector.h"
+#include <iostream>
+#include <random>
+
+// Screen-space-error LOD selection for a large scattered scene while the
+// camera flies across it. Every selection is checked against the rules
+// (never coarser than the error limit allows, never finer than needed
+// beyond the hysteresis band). A camera jittering in place must not make
+// levels pop back and forth, and a positive global bias must coarsen.
+
+namespace Forge::Bench {
+
+static int RunLODBench(const std::vector<std::string> &args) {
+  const int instanceCount = GetIntArg(args, "instances", 100000);
+  const int frames = GetIntArg(args, "frames", 100);
+  const int workers = GetIntArg(args, "workers", 0);
+  const float viewportHeight = (float)GetIntArg(args, "height", 1080);
+  const float fovY = 3.14159265f / 3.0f;
+
+  // Three chains (mesh IDs 0..2), LOD meshes from 100 up
+  LODSelector selector;
+  const float chainErrors[3][5] = {{0.002f, 0.01f, 0.04f, 0.15f, 0.6f},
+                                   {0.005f, 0.03f, 0.12f, 0.5f, 0.5f},
+                                   {0.001f, 0.004f, 0.016f, 0.064f, 0.25f}};
+  const uint32_t chainLevels[3] = {5, 4, 5};
+  for (uint32_t chain = 0; chain < 3; chain++) {
+    std::vector<LODLevel> levels;
+    for (uint32_t level = 0; level < chainLevels[chain]; level++)
+      levels.push_back({100 + chain * 10 + level, chainErrors[chain][level]});
+    selector.SetChain(chain, levels);
+  }
+
+  std::mt19937 rng(44);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  std::vector<LODInstance> instances(instanceCount);
+  for (LODInstance &instance : instances) {
+    instance.Center[0] = -200.0f + unit(rng) * 400.0f;
+    instance.Center[1] = unit(rng) * 5.0f;
+    instance.Center[2] = -200.0f + unit(rng) * 400.0f;
+    instance.Scale = 0.5f + unit(rng) * 2.5f;
+    instance.Radius = 0.87f * instance.Scale;
+    instance.Chain = rng() % 4; // 3 = no chain
+  }
+
+  // Reference check of one selection
+  const float projectionScale = viewportHeight / (2.0f * std::tan(fovY * 0.5f));
+  auto violations = [&](const float eye[3], const std::vector<uint8_t> &levels,
+                        const LODSettings &settings) {
+    uint64_t count = 0;
+    for (size_t i = 0; i < instances.size(); i++) {
+      const LODInstance &instance = instances[i];
+      uint32_t level = levels[i];
+      if (instance.Chain >= 3) {
+        count += level != 0;
+        continue;
+      }
+      float dx = instance.Center[0] - eye[0];
+      float dy = instance.Center[1] - eye[1];
+      float dz = instance.Center[2] - eye[2];
+      float distance = std::max(
+          std::sqrt(dx * dx + dy * dy + dz * dz) - instance.Radius, 1e-3f);
+      float limit = settings.MaxScreenError * std::exp2(settings.Bias) *
+                    distance / (projectionScale * instance.Scale);
+      const float *errors = chainErrors[instance.Chain];
+      uint32_t last = chainLevels[instance.Chain] - 1;
+      bool tooCoarse = level > 0 && errors[level] > limit * 1.0001f;
+      bool tooFine = level < last && errors[level + 1] <=
+                                         limit * (1.0f - settings.Hysteresis) *
+                                             0.9999f;
+      count += (tooCoarse || tooFine) ? 1 : 0;
+    }
+    return count;
+  };
+
+  // 1. Fly-through, single-threaded and on the job system
+  JobSystem jobs((uint32_t)workers);
+  std::vector<uint8_t> levels(instanceCount, 0);
+  uint64_t ruleViolations = 0, changes = 0;
+  double totalMs[2] = {}, maxMs[2] = {};
+  for (int pass = 0; pass < 2; pass++) {
+    std::fill(levels.begin(), levels.end(), 0);
+    for (int frame = 0; frame < frames; frame++) {
+      float t = (float)frame / frames;
+      const float eye[3] = {-150.0f + 300.0f * t, 10.0f,
+                            100.0f * std::sin(t * 6.28f)};
+      selector.SetView(eye, fovY, viewportHeight);
+      auto start = Clock::now();
+      selector.Select(instances.data(), (uint32_t)instances.size(),
+                      levels.data(), pass == 0 ? nullptr : &jobs);
+      double ms = ElapsedMs(start);
+      totalMs[pass] += ms;
+      maxMs[pass] = std::max(maxMs[pass], ms);
+      if (pass == 1) {
+        ruleViolations += violations(eye, levels, selector.GetSettings());
+        if (frame > 0)
+          changes += selector.GetStats().Changes;
+      }
+    }
+  }
+  const LODSelectionStats flyStats = selector.GetStats();
+
+  // 2. Jittering camera: changes after settling, with / without hysteresis
+  auto jitter = [&](float hysteresis) {
+    LODSettings settings;
+    settings.Hysteresis = hysteresis;
+    selector.SetSettings(settings);
+    std::fill(levels.begin(), levels.end(), 0);
+    uint64_t popped = 0;
+    for (int frame = 0; frame < 20; frame++) {
+      const float eye[3] = {0.0f, 10.0f, (frame % 2) ? 1.0f : -1.0f};
+      selector.SetView(eye, fovY, viewportHeight);
+      selector.Select(instances.data(), (uint32_t)instances.size(),
+                      levels.data(), &jobs);
+      if (frame >= 2)
+        popped += selector.GetStats().Changes;
+    }
+    return popped;
+  };
+  uint64_t poppedWith = jitter(0.25f);
+  uint64_t poppedWithout = jitter(0.0f);
+
+  // 3. Global bias
+  auto averageLevel = [&](float bias) {
+    LODSettings settings;
+    settings.Bias = bias;
+    selector.SetSettings(settings);
+    const float eye[3] = {0.0f, 10.0f, 0.0f};
+    selector.SetView(eye, fovY, viewportHeight);
+    std::fill(levels.begin(), levels.end(), 0);
+    selector.Select(instances.data(), (uint32_t)instances.size(),
+                    levels.data(), &jobs);
+    ruleViolations += violations(eye, levels, settings);
+    double sum = 0;
+    for (uint8_t level : levels)
+      sum += level;
+    return sum / levels.size();
+  };
+  double biasFiner = averageLevel(-1.0f);
+  double biasNone = averageLevel(0.0f);
+  double biasCoarser = averageLevel(1.0f);
+
+  std::cout << "  " << instanceCount << " instances, " << frames
+            << " frames: " << (totalMs[0] / frames) << " ms avg / "
+            << maxMs[0] << " ms max (1 thread), " << (totalMs[1] / frames)
+            << " ms avg / " << maxMs[1] << " ms max ("
+            << jobs.GetThreadCount() << " threads)" << std::endl;
+  std::cout << "  last frame per level:";
+  for (uint32_t level = 0; level < 5; level++)
+    std::cout << " " << flyStats.PerLevel[level];
+  std::cout << ", " << (double)changes / std::max(frames - 1, 1)
+            << " changes/frame while flying" << std::endl;
+  std::cout << "  jittering camera: " << poppedWith
+            << " pops with hysteresis, " << poppedWithout << " without"
+            << std::endl;
+  std::cout << "  average level: bias -1 " << biasFiner << ", 0 " << biasNone
+            << ", +1 " << biasCoarser << std::endl;
+
+  size_t errors = ruleViolations + poppedWith;
+  std::cout << "  validation errors: " << errors << std::endl;
+  bool biasWorks = biasFiner < biasNone && biasNone < biasCoarser;
+  return (errors == 0 && biasWorks) ? 0 : 1;
+}
+
+static Registrar s_LODBench("lod", "Screen-space-error LOD selection",
+                            RunLODBench);
+
+} // namespace Forge::Bench
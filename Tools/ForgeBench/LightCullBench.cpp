@@ -0,0 +1,208 @@
+#include "Bench.h"
+#include "Core/JobSystem.h"
+#include "Renderer/ClusteredLightCuller.h"
+#include <iostream>
+#include <random>
+
+// Clustered light assignment for a field of point and spot lights while
+// the camera flies across it at 1080p. The scalar, SIMD and multithreaded
+// culls must produce the same lists. Sampled clusters are compared with a
+// brute-force test of every light, and random points in the view (pixel +
+// depth, as a shader would look them up) must find every light that
+// actually reaches them in their cluster's list.
+
+namespace Forge::Bench {
+
+static int RunLightCullBench(const std::vector<std::string> &args) {
+  const int lightCount = GetIntArg(args, "lights", 10000);
+  const int width = GetIntArg(args, "width", 1920);
+  const int height = GetIntArg(args, "height", 1080);
+  const int frames = GetIntArg(args, "frames", 60);
+  const int workers = GetIntArg(args, "workers", 0);
+  const int tileSize = GetIntArg(args, "tile", 64);
+  const int slices = GetIntArg(args, "slices", 24);
+  const float fovY = 3.14159265f / 3.0f;
+  const float nearZ = 0.1f, farZ = 500.0f;
+
+  // 70% point lights, 30% spots with 10..60 degree half-angles
+  std::mt19937 rng(48);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  std::vector<ClusterLight> lights(lightCount);
+  for (ClusterLight &light : lights) {
+    light.Position[0] = -200.0f + unit(rng) * 400.0f;
+    light.Position[1] = unit(rng) * 20.0f;
+    light.Position[2] = -200.0f + unit(rng) * 400.0f;
+    light.Range = 1.0f + unit(rng) * 7.0f;
+    float direction[3] = {unit(rng) - 0.5f, unit(rng) - 0.5f,
+                          unit(rng) - 0.5f};
+    float length = std::sqrt(direction[0] * direction[0] +
+                             direction[1] * direction[1] +
+                             direction[2] * direction[2]);
+    for (int c = 0; c < 3; c++)
+      light.Direction[c] = direction[c] / length;
+    light.CosAngle = std::cos((10.0f + unit(rng) * 50.0f) * 0.01745329f);
+    light.Type =
+        unit(rng) < 0.3f ? ClusterLightType::Spot : ClusterLightType::Point;
+  }
+
+  ClusterGridSettings settings;
+  settings.TileSize = (uint32_t)tileSize;
+  settings.DepthSlices = (uint32_t)slices;
+  // 0: scalar, 1: SIMD, 2: SIMD on the job system
+  ClusteredLightCuller cullers[3];
+  for (ClusteredLightCuller &culler : cullers) {
+    culler.SetSettings(settings);
+    culler.SetResolution((uint32_t)width, (uint32_t)height);
+  }
+  cullers[0].SetUseSIMD(false);
+  JobSystem jobs((uint32_t)workers);
+
+  // Brute force over a sample of the clusters
+  auto checkClusters = [&](const ClusteredLightCuller &culler) {
+    uint64_t mismatches = 0;
+    const auto &ranges = culler.GetClusterRanges();
+    const auto &indices = culler.GetLightIndices();
+    std::vector<uint32_t> expected;
+    for (uint32_t cluster = 0; cluster < culler.GetClusterCount();
+         cluster += 7) {
+      expected.clear();
+      for (uint32_t i = 0; i < (uint32_t)lights.size(); i++) {
+        if (culler.TestLight(lights[i], cluster))
+          expected.push_back(i);
+      }
+      const LightClusterRange &range = ranges[cluster];
+      if (expected.size() != range.Count ||
+          !std::equal(expected.begin(), expected.end(),
+                      indices.begin() + range.Offset))
+        mismatches++;
+    }
+    return mismatches;
+  };
+
+  // Lights that reach random view points must be in the point's cluster
+  auto checkPoints = [&](const ClusteredLightCuller &culler,
+                         const float *view, uint32_t samples) {
+    const float tanY = std::tan(fovY * 0.5f);
+    const float tanX = tanY * (float)width / (float)height;
+    std::vector<float> viewLights(lights.size() * 6);
+    for (size_t i = 0; i < lights.size(); i++) {
+      const ClusterLight &light = lights[i];
+      for (int c = 0; c < 3; c++) {
+        viewLights[i * 6 + c] =
+            light.Position[0] * view[c] + light.Position[1] * view[4 + c] +
+            light.Position[2] * view[8 + c] + view[12 + c];
+        viewLights[i * 6 + 3 + c] = light.Direction[0] * view[c] +
+                                    light.Direction[1] * view[4 + c] +
+                                    light.Direction[2] * view[8 + c];
+      }
+    }
+    const auto &ranges = culler.GetClusterRanges();
+    const auto &indices = culler.GetLightIndices();
+    uint64_t missed = 0, reached = 0;
+    for (uint32_t sample = 0; sample < samples; sample++) {
+      float px = unit(rng) * width, py = unit(rng) * height;
+      float z = nearZ * std::pow(300.0f / nearZ, unit(rng));
+      float p[3] = {(2.0f * px / width - 1.0f) * z * tanX,
+                    (1.0f - 2.0f * py / height) * z * tanY, z};
+      uint32_t cluster = culler.GetClusterIndex(px, py, z);
+      const LightClusterRange &range = ranges[cluster];
+      auto begin = indices.begin() + range.Offset;
+      auto end = begin + range.Count;
+      for (uint32_t i = 0; i < (uint32_t)lights.size(); i++) {
+        const float *origin = &viewLights[i * 6];
+        float d[3] = {p[0] - origin[0], p[1] - origin[1], p[2] - origin[2]};
+        float distance = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        if (distance > lights[i].Range)
+          continue;
+        if (lights[i].Type == ClusterLightType::Spot && distance > 0.0f) {
+          const float *axis = origin + 3;
+          float along = (d[0] * axis[0] + d[1] * axis[1] + d[2] * axis[2]) /
+                        distance;
+          if (along < lights[i].CosAngle)
+            continue;
+        }
+        reached++;
+        if (!std::binary_search(begin, end, i))
+          missed++;
+      }
+    }
+    return std::make_pair(missed, reached);
+  };
+
+  double totalMs[3] = {}, maxMs[3] = {};
+  uint64_t listMismatches = 0, clusterMismatches = 0, missedLights = 0;
+  uint64_t reachedLights = 0;
+  ClusterCullStats stats;
+  uint64_t indexSum = 0;
+  for (int frame = 0; frame < frames; frame++) {
+    float t = (float)frame / std::max(frames, 1);
+    const float eye[3] = {-150.0f + 300.0f * t, 12.0f,
+                          100.0f * std::sin(t * 6.28f)};
+    const float at[3] = {eye[0] + 40.0f * std::cos(t * 3.0f), 4.0f,
+                         eye[2] + 40.0f * std::sin(t * 3.0f)};
+    float view[16];
+    LookAtLH(eye, at, view);
+    for (int pass = 0; pass < 3; pass++) {
+      cullers[pass].SetView(view, fovY, nearZ, farZ);
+      auto start = Clock::now();
+      cullers[pass].Cull(lights.data(), (uint32_t)lights.size(),
+                         pass == 2 ? &jobs : nullptr);
+      double ms = ElapsedMs(start);
+      totalMs[pass] += ms;
+      maxMs[pass] = std::max(maxMs[pass], ms);
+    }
+    for (int pass = 1; pass < 3; pass++) {
+      const auto &a = cullers[0].GetClusterRanges();
+      const auto &b = cullers[pass].GetClusterRanges();
+      bool same = cullers[0].GetLightIndices() ==
+                      cullers[pass].GetLightIndices() &&
+                  std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                             [](const LightClusterRange &x,
+                                const LightClusterRange &y) {
+                               return x.Offset == y.Offset &&
+                                      x.Count == y.Count;
+                             });
+      listMismatches += same ? 0 : 1;
+    }
+    if (frame % 20 == 0) {
+      clusterMismatches += checkClusters(cullers[2]);
+      auto [missed, reached] = checkPoints(cullers[2], view, 2000);
+      missedLights += missed;
+      reachedLights += reached;
+    }
+    stats = cullers[2].GetStats();
+    indexSum += stats.Indices;
+  }
+
+  std::cout << "  " << lightCount << " lights at " << width << "x" << height
+            << ", " << cullers[0].GetTilesX() << "x" << cullers[0].GetTilesY()
+            << "x" << cullers[0].GetDepthSlices() << " clusters, " << frames
+            << " frames" << std::endl;
+  const char *names[3] = {"scalar", stats.SIMD ? "AVX2" : "SIMD off",
+                          "threaded"};
+  for (int pass = 0; pass < 3; pass++) {
+    std::cout << "  " << names[pass] << ": "
+              << totalMs[pass] / std::max(frames, 1) << " ms avg / "
+              << maxMs[pass] << " ms max";
+    if (pass == 2)
+      std::cout << " (" << jobs.GetThreadCount() << " threads)";
+    std::cout << std::endl;
+  }
+  std::cout << "  last frame: " << stats.VisibleLights << " visible lights, "
+            << stats.OccupiedClusters << " occupied clusters, "
+            << stats.Indices << " indices (max " << stats.MaxClusterLights
+            << " per cluster); " << indexSum / std::max(frames, 1)
+            << " indices/frame avg" << std::endl;
+  std::cout << "  point samples: " << reachedLights << " light hits, "
+            << missedLights << " missing from their cluster" << std::endl;
+
+  size_t errors = listMismatches + clusterMismatches + missedLights;
+  std::cout << "  validation errors: " << errors << std::endl;
+  return errors == 0 ? 0 : 1;
+}
+
+static Registrar s_LightCullBench("lightcull",
+                                  "Clustered light culling on the CPU",
+                                  RunLightCullBench);
+
+} // namespace Forge::Bench
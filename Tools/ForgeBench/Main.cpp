@@ -0,0 +1,60 @@
+#include "Bench.h"
+#include <iostream>
+
+// Headless benchmarks for the platform-neutral runtime code.
+// Usage: ForgeBench <bench|all> [--option=value ...]
+
+namespace Forge::Bench {
+
+std::vector<BenchEntry> &GetRegistry() {
+  static std::vector<BenchEntry> registry;
+  return registry;
+}
+
+int GetIntArg(const std::vector<std::string> &args, const char *name,
+              int defaultValue) {
+  std::string prefix = std::string("--") + name + "=";
+  for (const std::string &arg : args) {
+    if (arg.rfind(prefix, 0) == 0)
+      return std::stoi(arg.substr(prefix.size()));
+  }
+  return defaultValue;
+}
+
+} // namespace Forge::Bench
+
+int main(int argc, char **argv) {
+  using namespace Forge::Bench;
+
+  if (argc < 2) {
+    std::cout << "Usage: ForgeBench <bench|all> [--option=value ...]"
+              << std::endl;
+    for (const BenchEntry &entry : GetRegistry()) {
+      std::cout << "  " << entry.Name << " - " << entry.Description
+                << std::endl;
+    }
+    return 1;
+  }
+
+  std::string name = argv[1];
+  std::vector<std::string> args(argv + 2, argv + argc);
+
+  int result = 0;
+  bool found = false;
+  for (const BenchEntry &entry : GetRegistry()) {
+    if (name != "all" && name != entry.Name)
+      continue;
+    found = true;
+    std::cout << "[ForgeBench] " << entry.Name << std::endl;
+    if (entry.Run(args) != 0) {
+      std::cerr << "[ForgeBench] " << entry.Name << " FAILED" << std::endl;
+      result = 1;
+    }
+  }
+
+  if (!found) {
+    std::cerr << "[ForgeBench] Unknown benchmark: " << name << std::endl;
+    return 1;
+  }
+  return result;
+}
@@ -0,0 +1,337 @@
+#include "Asset/MeshCooker.h"
+#include "Asset/MeshFile.h"
+#include "Bench.h"
+#include "Core/JobSystem.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+// Offline mesh cooking of generated OBJ files with shuffled triangles: a
+// torus (UV seam), a sphere cluster (non-convex, overdraw) and a heightfield
+// without normals (open border, 32-bit indices). Cooking must be the same
+// serially and in parallel, improve the vertex cache and overdraw, keep
+// quantization within half a step, and the mapped file must hold a
+// decreasing LOD chain whose meshlets rebuild every LOD exactly.
+
+namespace Forge::Bench {
+
+namespace {
+
+struct GeneratedMesh {
+  std::vector<float> Positions, Normals, UVs;
+  std::vector<uint32_t> Indices;
+};
+
+// Grid of (columns + 1) x (rows + 1) vertices through f(u, v) -> position,
+// normal; triangles are wound so their front face follows the normal
+template <typename Surface>
+void AddGrid(GeneratedMesh &mesh, uint32_t columns, uint32_t rows,
+             Surface surface) {
+  uint32_t base = (uint32_t)mesh.Positions.size() / 3;
+  for (uint32_t y = 0; y <= rows; y++) {
+    for (uint32_t x = 0; x <= columns; x++) {
+      float u = (float)x / columns, v = (float)y / rows;
+      float position[3], normal[3];
+      surface(u, v, position, normal);
+      mesh.Positions.insert(mesh.Positions.end(), position, position + 3);
+      mesh.Normals.insert(mesh.Normals.end(), normal, normal + 3);
+      mesh.UVs.insert(mesh.UVs.end(), {u, v});
+    }
+  }
+
+  // cross(dP/du, dP/dv) against the normal, away from the poles
+  float p[3][3], n[3], unused[3];
+  surface(0.5f, 0.5f, p[0], n);
+  surface(0.51f, 0.5f, p[1], unused);
+  surface(0.5f, 0.51f, p[2], unused);
+  float du[3], dv[3];
+  for (int c = 0; c < 3; c++) {
+    du[c] = p[1][c] - p[0][c];
+    dv[c] = p[2][c] - p[0][c];
+  }
+  float facing = (du[1] * dv[2] - du[2] * dv[1]) * n[0] +
+                 (du[2] * dv[0] - du[0] * dv[2]) * n[1] +
+                 (du[0] * dv[1] - du[1] * dv[0]) * n[2];
+  uint32_t along = facing > 0.0f ? 1 : columns + 1;
+  uint32_t across = facing > 0.0f ? columns + 1 : 1;
+  for (uint32_t y = 0; y < rows; y++) {
+    for (uint32_t x = 0; x < columns; x++) {
+      uint32_t i = base + y * (columns + 1) + x;
+      mesh.Indices.insert(mesh.Indices.end(),
+                          {i, i + along, i + columns + 2, i,
+                           i + columns + 2, i + across});
+    }
+  }
+}
+
+std::string WriteOBJ(const GeneratedMesh &mesh, bool normals,
+                     std::mt19937 &rng) {
+  // Shuffled triangles: what an exporter with no optimization emits
+  std::vector<uint32_t> order(mesh.Indices.size() / 3);
+  for (uint32_t i = 0; i < order.size(); i++)
+    order[i] = i;
+  std::shuffle(order.begin(), order.end(), rng);
+
+  std::ostringstream obj;
+  obj.precision(7);
+  for (size_t v = 0; v < mesh.Positions.size() / 3; v++) {
+    obj << "v " << mesh.Positions[v * 3] << " " << mesh.Positions[v * 3 + 1]
+        << " " << mesh.Positions[v * 3 + 2] << "\n";
+    obj << "vt " << mesh.UVs[v * 2] << " " << mesh.UVs[v * 2 + 1] << "\n";
+    if (normals) {
+      obj << "vn " << mesh.Normals[v * 3] << " " << mesh.Normals[v * 3 + 1]
+          << " " << mesh.Normals[v * 3 + 2] << "\n";
+    }
+  }
+  for (uint32_t t : order) {
+    obj << "f";
+    for (int corner = 0; corner < 3; corner++) {
+      uint32_t i = mesh.Indices[t * 3 + corner] + 1;
+      obj << " " << i << "/" << i;
+      if (normals)
+        obj << "/" << i;
+    }
+    obj << "\n";
+  }
+  return obj.str();
+}
+
+double TotalArea(const float *positions, const uint32_t *indices,
+                 size_t indexCount) {
+  double area = 0.0;
+  for (size_t t = 0; t + 2 < indexCount; t += 3) {
+    const float *a = positions + indices[t] * 3;
+    const float *b = positions + indices[t + 1] * 3;
+    const float *c = positions + indices[t + 2] * 3;
+    double e0[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    double e1[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    double n[3] = {e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2],
+                   e0[0] * e1[1] - e0[1] * e1[0]};
+    area += 0.5 * std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+  }
+  return area;
+}
+
+} // namespace
+
+static int RunMeshCookBench(const std::vector<std::string> &args) {
+  const int detail = GetIntArg(args, "detail", 128);
+  const int workers = GetIntArg(args, "workers", 0);
+  const float pi = 3.14159265f;
+  const std::filesystem::path directory = "/tmp/ForgeBenchMeshCook";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+
+  // 1. Sources
+  std::mt19937 rng(45);
+  std::vector<std::string> names = {"Torus", "SphereCluster", "Terrain"};
+  {
+    GeneratedMesh torus;
+    AddGrid(torus, detail * 2, detail, [&](float u, float v, float *p,
+                                           float *n) {
+      float theta = u * 2.0f * pi, phi = v * 2.0f * pi;
+      n[0] = std::cos(theta) * std::cos(phi);
+      n[1] = std::sin(phi);
+      n[2] = std::sin(theta) * std::cos(phi);
+      p[0] = std::cos(theta) + 0.35f * n[0];
+      p[1] = 0.35f * n[1];
+      p[2] = std::sin(theta) + 0.35f * n[2];
+    });
+    std::ofstream(directory / "Torus.obj") << WriteOBJ(torus, true, rng);
+
+    GeneratedMesh cluster;
+    for (int sphere = 0; sphere < 8; sphere++) {
+      float center[3] = {(float)(sphere % 2) * 0.7f,
+                         (float)((sphere / 2) % 2) * 0.7f,
+                         (float)(sphere / 4) * 0.7f};
+      AddGrid(cluster, detail / 2, detail / 4,
+              [&](float u, float v, float *p, float *n) {
+                float theta = u * 2.0f * pi, phi = v * pi;
+                n[0] = std::sin(phi) * std::cos(theta);
+                n[1] = std::cos(phi);
+                n[2] = std::sin(phi) * std::sin(theta);
+                for (int c = 0; c < 3; c++)
+                  p[c] = center[c] + 0.5f * n[c];
+              });
+    }
+    std::ofstream(directory / "SphereCluster.obj")
+        << WriteOBJ(cluster, true, rng);
+
+    GeneratedMesh terrain;
+    AddGrid(terrain, detail * 2 + 100, detail * 2 + 100,
+            [&](float u, float v, float *p, float *n) {
+              p[0] = u * 100.0f;
+              p[1] = 3.0f * std::sin(u * 17.0f) * std::cos(v * 13.0f) +
+                     0.5f * std::sin(u * 71.0f + v * 53.0f);
+              p[2] = v * 100.0f;
+              n[0] = 0.0f, n[1] = 1.0f, n[2] = 0.0f;
+            });
+    std::ofstream(directory / "Terrain.obj") << WriteOBJ(terrain, false, rng);
+  }
+
+  // 2. Cook serially (with analysis), then in parallel
+  MeshCookSettings settings;
+  settings.Analyze = true;
+  std::vector<MeshCookStats> stats(names.size());
+  std::vector<std::vector<uint8_t>> serialBytes(names.size());
+  uint64_t errors = 0;
+  auto start = Clock::now();
+  for (size_t i = 0; i < names.size(); i++) {
+    std::string error;
+    std::filesystem::path input = directory / (names[i] + ".obj");
+    std::filesystem::path output = directory / (names[i] + ".fmesh");
+    if (!CookMeshFile(input.string(), output.string(), settings, &stats[i],
+                      error)) {
+      std::cerr << "  " << names[i] << ": " << error << std::endl;
+      errors++;
+      continue;
+    }
+    std::ifstream file(output, std::ios::binary);
+    serialBytes[i].assign(std::istreambuf_iterator<char>(file), {});
+  }
+  double serialMs = ElapsedMs(start);
+
+  settings.Analyze = false;
+  JobSystem jobs((uint32_t)workers);
+  std::vector<std::vector<uint8_t>> parallelBytes(names.size());
+  start = Clock::now();
+  jobs.ParallelFor((uint32_t)names.size(), 1,
+                   [&](uint32_t begin, uint32_t end, uint32_t) {
+                     for (uint32_t i = begin; i < end; i++) {
+                       ImportedMesh mesh;
+                       std::string error;
+                       std::filesystem::path input =
+                           directory / (names[i] + ".obj");
+                       if (ImportMesh(input.string(), mesh, error))
+                         CookMesh(mesh, settings, parallelBytes[i], nullptr,
+                                  error);
+                     }
+                   });
+  double parallelMs = ElapsedMs(start);
+  uint64_t mismatches = 0;
+  for (size_t i = 0; i < names.size(); i++)
+    mismatches += serialBytes[i] != parallelBytes[i] ? 1 : 0;
+
+  // 3. Mapped files against the sources
+  uint64_t ruleViolations = 0;
+  for (size_t i = 0; i < names.size(); i++) {
+    MeshFile file;
+    if (!file.Open((directory / (names[i] + ".fmesh")).string())) {
+      errors++;
+      continue;
+    }
+    const MeshFileHeader &header = file.GetHeader();
+    const MeshCookStats &stat = stats[i];
+    ImportedMesh source;
+    std::string error;
+    ImportMesh((directory / (names[i] + ".obj")).string(), source, error);
+
+    std::vector<float> positions(header.VertexCount * 3);
+    float maxNormalError = 0.0f;
+    for (uint32_t v = 0; v < header.VertexCount; v++) {
+      file.DecodePosition(file.GetVertices()[v], &positions[v * 3]);
+      float normal[3];
+      MeshFile::DecodeNormal(file.GetVertices()[v], normal);
+      float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] +
+                               normal[2] * normal[2]);
+      maxNormalError = std::max(maxNormalError, std::abs(length - 1.0f));
+    }
+    std::vector<uint32_t> indices(header.IndexBytes / header.IndexSize);
+    for (uint32_t j = 0; j < indices.size(); j++)
+      indices[j] = file.GetIndex(j);
+
+    // Quantization: half a step per axis; LOD 0 keeps every triangle
+    float step = 0.0f;
+    for (int c = 0; c < 3; c++)
+      step += std::pow(header.PositionScale[c] / 65535.0f * 0.5f, 2.0f);
+    bool quantized = stat.MaxPositionError <= std::sqrt(step) * 1.01f &&
+                     maxNormalError < 0.02f;
+    const MeshFileLOD *lods = file.GetLODs();
+    double sourceArea = TotalArea(source.Positions.data(),
+                                  source.Indices.data(), source.Indices.size());
+    double cookedArea = TotalArea(positions.data(),
+                                  indices.data() + lods[0].FirstIndex,
+                                  lods[0].IndexCount);
+    bool complete = lods[0].IndexCount == source.Indices.size() &&
+                    std::abs(cookedArea / sourceArea - 1.0) < 1e-3;
+    bool optimized = stat.ACMRAfter < stat.ACMRBefore * 0.5f &&
+                     stat.OverdrawAfter <= stat.OverdrawBefore;
+    bool indexSize = header.IndexSize == (header.VertexCount > 0xFFFF ? 4 : 2);
+
+    // LOD chain, and meshlets rebuilding each LOD in order
+    float diagonal = 0.0f;
+    for (int c = 0; c < 3; c++)
+      diagonal += std::pow(header.BoundsMax[c] - header.BoundsMin[c], 2.0f);
+    bool chain = header.LODCount >= 2 &&
+                 lods[header.LODCount - 1].GeometricError <=
+                     settings.LODMaxError * std::sqrt(diagonal) * 1.001f;
+    bool meshletsMatch = true;
+    for (uint32_t lod = 0; lod < header.LODCount; lod++) {
+      if (lod > 0) {
+        chain &= lods[lod].IndexCount < lods[lod - 1].IndexCount &&
+                 lods[lod].GeometricError >= lods[lod - 1].GeometricError;
+      }
+      uint32_t next = lods[lod].FirstIndex;
+      for (uint32_t m = 0; m < lods[lod].MeshletCount; m++) {
+        const MeshFileMeshlet &meshlet =
+            file.GetMeshlets()[lods[lod].FirstMeshlet + m];
+        const uint32_t *vertices =
+            file.GetMeshletVertices() + meshlet.VertexOffset;
+        const uint8_t *triangles =
+            file.GetMeshletTriangles() + meshlet.TriangleOffset;
+        for (uint32_t t = 0; t < meshlet.TriangleCount * 3u; t++) {
+          uint32_t vertex = vertices[triangles[t]];
+          meshletsMatch &= triangles[t] < meshlet.VertexCount &&
+                           indices[next++] == vertex;
+          const float *p = &positions[vertex * 3];
+          float d[3] = {p[0] - meshlet.Center[0], p[1] - meshlet.Center[1],
+                        p[2] - meshlet.Center[2]};
+          meshletsMatch &= std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]) <=
+                           meshlet.Radius * 1.0001f + 1e-6f;
+        }
+      }
+      meshletsMatch &= next == lods[lod].FirstIndex + lods[lod].IndexCount;
+    }
+
+    std::cout << "  " << names[i] << ": " << header.VertexCount
+              << " vertices (" << header.IndexSize * 8 << "-bit indices), "
+              << stat.Bytes / 1024 << " KB, ACMR " << stat.ACMRBefore
+              << " -> " << stat.ACMRAfter << ", overdraw "
+              << stat.OverdrawBefore << " -> " << stat.OverdrawAfter
+              << std::endl;
+    std::cout << "    LODs (triangles/error):";
+    for (uint32_t lod = 0; lod < header.LODCount; lod++)
+      std::cout << " " << lods[lod].IndexCount / 3 << "/"
+                << lods[lod].GeometricError;
+    std::cout << ", " << header.MeshletCount << " meshlets, position error "
+              << stat.MaxPositionError << std::endl;
+
+    ruleViolations += (quantized ? 0 : 1) + (complete ? 0 : 1) +
+                      (optimized ? 0 : 1) + (indexSize ? 0 : 1) +
+                      (chain ? 0 : 1) + (meshletsMatch ? 0 : 1);
+  }
+
+  // 4. Rejected inputs
+  ImportedMesh rejected;
+  std::string importError;
+  bool fbxRejected = !ImportMesh("Character_01.fbx", rejected, importError);
+  bool badRejected = !ImportOBJ("v 0 0 0\nf 1 2 3\n", rejected, importError);
+
+  std::cout << "  cooked in " << serialMs << " ms serially (with analysis), "
+            << parallelMs << " ms on " << jobs.GetThreadCount()
+            << " threads; serial/parallel mismatches " << mismatches
+            << std::endl;
+
+  size_t total = errors + mismatches + ruleViolations + (fbxRejected ? 0 : 1) +
+                 (badRejected ? 0 : 1);
+  std::cout << "  validation errors: " << total << std::endl;
+  return total == 0 ? 0 : 1;
+}
+
+static Registrar s_MeshCookBench("meshcook",
+                                 "Offline mesh cooking (OBJ -> .fmesh)",
+                                 RunMeshCookBench);
+
+} // namespace Forge::Bench
@@ -0,0 +1,177 @@
+#include "Bench.h"
+#include "Core/JobSystem.h"
+#include "Renderer/OcclusionCuller.h"
+#include "Renderer/SoftwareRasterizer.h"
+#include <iostream>
+#include <random>
+
+// Masked software occlusion culling on a street-level scene: rows of walls
+// in front of a field of small cubes, some of them behind the camera. The
+// scalar, SIMD and multithreaded culls must agree, and culling must stay
+// conservative: every culled object is checked against a full depth render
+// (software rasterizer, same resolution) of everything left visible, its
+// screen box having to be hidden at every pixel.
+
+namespace Forge::Bench {
+
+static int RunOcclusionBench(const std::vector<std::string> &args) {
+  const int objectCount = GetIntArg(args, "objects", 20000);
+  const int width = GetIntArg(args, "width", 256);
+  const int height = GetIntArg(args, "height", 144);
+  const int frames = GetIntArg(args, "frames", 20);
+  const int workers = GetIntArg(args, "workers", 0);
+
+  const std::vector<float> cube = MakeCubePositions();
+  auto makeObject = [&](float x, float y, float z, float sx, float sy,
+                        float sz) {
+    OcclusionObject object;
+    const float world[16] = {sx, 0, 0, 0, 0, sy, 0, 0,
+                             0,  0, sz, 0, x, y, z, 1};
+    std::copy(world, world + 16, object.World);
+    for (int c = 0; c < 3; c++) {
+      object.BoundsMin[c] = -0.5f;
+      object.BoundsMax[c] = 0.5f;
+    }
+    object.OccluderPositions = cube.data();
+    object.OccluderVertexCount = (uint32_t)cube.size() / 3;
+    object.OccluderStride = 3 * sizeof(float);
+    return object;
+  };
+
+  std::vector<OcclusionObject> objects;
+  // Walls: a closed row, then one with gaps
+  for (int i = -4; i <= 4; i++)
+    objects.push_back(makeObject(i * 5.0f, 2.0f, 0.0f, 5.0f, 4.0f, 0.5f));
+  for (int i = -4; i <= 4; i += 2)
+    objects.push_back(makeObject(i * 5.0f, 3.0f, 30.0f, 6.0f, 6.0f, 0.5f));
+  std::mt19937 rng(43);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  while ((int)objects.size() < objectCount) {
+    float size = 0.3f + unit(rng);
+    float z = unit(rng) < 0.1f ? -40.0f + unit(rng) * 35.0f // near / behind
+                               : 2.0f + unit(rng) * 80.0f;
+    objects.push_back(makeObject(-30.0f + unit(rng) * 60.0f, size * 0.5f, z,
+                                 size, size, size));
+  }
+
+  const float eye[3] = {0.0f, 1.7f, -20.0f};
+  const float at[3] = {0.0f, 1.7f, 0.0f};
+  float view[16], projection[16], viewProj[16];
+  LookAtLH(eye, at, view);
+  PerspectiveFovLH(3.14159265f / 3.0f, (float)width / height, 0.1f, 1000.0f,
+                   projection);
+  Multiply(view, projection, viewProj);
+
+  OcclusionCuller culler;
+  culler.SetResolution((uint32_t)width, (uint32_t)height);
+  JobSystem jobs((uint32_t)workers);
+  auto run = [&](JobSystem *jobSystem, bool simd, double &ms) {
+    culler.SetUseSIMD(simd);
+    std::vector<uint8_t> visible;
+    auto start = Clock::now();
+    for (int frame = 0; frame < frames; frame++)
+      culler.Cull(viewProj, objects.data(), (uint32_t)objects.size(), visible,
+                  jobSystem);
+    ms = ElapsedMs(start) / frames;
+    return visible;
+  };
+  double scalarMs = 0, simdMs = 0, threadedMs = 0;
+  std::vector<uint8_t> reference = run(nullptr, false, scalarMs);
+  std::vector<uint8_t> simd = run(nullptr, true, simdMs);
+  std::vector<uint8_t> visible = run(&jobs, true, threadedMs);
+  const OcclusionStats stats = culler.GetStats();
+  uint64_t mismatches = 0;
+  for (size_t i = 0; i < objects.size(); i++)
+    mismatches += (reference[i] != simd[i]) + (reference[i] != visible[i]);
+
+  // Conservativeness: depth of everything drawn, at the culler resolution
+  SoftwareRasterizer rasterizer;
+  const float clear[4] = {0, 0, 0, 1}, white[4] = {1, 1, 1, 1};
+  rasterizer.Begin(culler.GetWidth(), culler.GetHeight(), viewProj, clear);
+  for (size_t i = 0; i < objects.size(); i++) {
+    if (visible[i])
+      rasterizer.DrawTriangles(cube.data(), (uint32_t)cube.size() / 3,
+                               3 * sizeof(float), objects[i].World, white);
+  }
+  rasterizer.Render(&jobs);
+
+  uint64_t wronglyCulled = 0, occluded = 0;
+  for (size_t i = 0; i < objects.size(); i++) {
+    if (visible[i])
+      continue;
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+    float zMin = 1.0f;
+    bool inFront = true, outside = false;
+    uint32_t outsideAll = 0x3f;
+    for (int corner = 0; corner < 8; corner++) {
+      float p[3] = {(corner & 1) ? 0.5f : -0.5f, (corner & 2) ? 0.5f : -0.5f,
+                    (corner & 4) ? 0.5f : -0.5f};
+      float worldViewProj[16], clip[4];
+      Multiply(objects[i].World, viewProj, worldViewProj);
+      for (int c = 0; c < 4; c++)
+        clip[c] = p[0] * worldViewProj[c] + p[1] * worldViewProj[4 + c] +
+                  p[2] * worldViewProj[8 + c] + worldViewProj[12 + c];
+      outsideAll &= (clip[0] < -clip[3] ? 1 : 0) |
+                    (clip[0] > clip[3] ? 2 : 0) |
+                    (clip[1] < -clip[3] ? 4 : 0) |
+                    (clip[1] > clip[3] ? 8 : 0) | (clip[2] < 0 ? 16 : 0) |
+                    (clip[2] > clip[3] ? 32 : 0);
+      if (clip[2] < 0.0f) {
+        inFront = false;
+        continue;
+      }
+      float x = (clip[0] / clip[3] * 0.5f + 0.5f) * culler.GetWidth();
+      float y = (0.5f - clip[1] / clip[3] * 0.5f) * culler.GetHeight();
+      minX = std::min(minX, x);
+      maxX = std::max(maxX, x);
+      minY = std::min(minY, y);
+      maxY = std::max(maxY, y);
+      zMin = std::min(zMin, clip[2] / clip[3]);
+    }
+    outside = outsideAll != 0;
+    if (outside)
+      continue; // frustum culled
+    occluded++;
+    bool hidden = inFront;
+    int x0 = std::max((int)std::floor(minX), 0);
+    int y0 = std::max((int)std::floor(minY), 0);
+    int x1 = std::min((int)std::ceil(maxX), (int)culler.GetWidth() - 1);
+    int y1 = std::min((int)std::ceil(maxY), (int)culler.GetHeight() - 1);
+    for (int y = y0; y <= y1 && hidden; y++) {
+      for (int x = x0; x <= x1 && hidden; x++) {
+        float cx = x + 0.5f, cy = y + 0.5f;
+        if (cx < minX || cx > maxX || cy < minY || cy > maxY)
+          continue;
+        hidden = rasterizer.GetDepth(x, y) <= zMin;
+      }
+    }
+    wronglyCulled += hidden ? 0 : 1;
+  }
+
+  std::cout << "  " << objects.size() << " objects, " << stats.Occluders
+            << " occluders (" << stats.OccluderTriangles << " triangles), "
+            << culler.GetWidth() << "x" << culler.GetHeight()
+            << " masked depth" << std::endl;
+  std::cout << "  frustum culled " << stats.FrustumCulled << ", occluded "
+            << stats.OcclusionCulled << ", visible " << stats.Visible
+            << std::endl;
+  std::cout << "  scalar " << scalarMs << " ms, SIMD " << simdMs
+            << " ms (1 thread); " << threadedMs << " ms ("
+            << jobs.GetThreadCount() << " threads)"
+            << (SoftwareRasterizer::IsSIMDAvailable() ? ""
+                                                      : " [built without AVX2]")
+            << std::endl;
+  std::cout << "  mode mismatches " << mismatches
+            << ", culled but visible in the reference render "
+            << wronglyCulled << " / " << occluded << std::endl;
+
+  size_t errors = mismatches + wronglyCulled;
+  std::cout << "  validation errors: " << errors << std::endl;
+  return (errors == 0 && stats.OcclusionCulled > 0) ? 0 : 1;
+}
+
+static Registrar s_OcclusionBench(
+    "occlusion", "Masked software occlusion culling (walls + cube field)",
+    RunOcclusionBench);
+
+} // namespace Forge::Bench
@@ -0,0 +1,200 @@
+#include "Bench.h"
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// CPU profiler markers: a nested scope tree on the main thread plus
+// ParallelFor batches on the workers, collected frame by frame. Every
+// event must arrive in its frame with the right depth and inside its
+// parent, a thread that overflows its buffer must lose exactly the
+// excess, and the exported trace must hold every captured event. Also
+// reports the cost of a marker while enabled and while disabled.
+
+namespace Forge::Bench {
+
+static int RunProfilerBench(const std::vector<std::string> &args) {
+#if FORGE_PROFILE
+  const int frames = GetIntArg(args, "frames", 200);
+  const int batches = GetIntArg(args, "batches", 64);
+  const int workers = GetIntArg(args, "workers", 0);
+  const int overheadScopes = GetIntArg(args, "scopes", 1000000);
+
+  // Whatever earlier benches left in the buffers goes first
+  Profiler::SetEnabled(true);
+  Profiler::NextFrame();
+  Profiler::Reset();
+  Profiler::SetThreadName("Bench Main");
+  JobSystem jobs((uint32_t)workers);
+
+  auto isNamed = [](const ProfileEvent &e, const char *name) {
+    return std::strcmp(e.Name, name) == 0;
+  };
+  volatile uint64_t sink = 0;
+
+  // 1. Scope tree: Frame > 3 x Update > 2 x Inner, and one Work event per
+  // ParallelFor batch (any thread)
+  uint64_t structureErrors = 0, missingWork = 0;
+  Profiler::StartCapture();
+  for (int frame = 0; frame < frames; frame++) {
+    {
+      FORGE_PROFILE_SCOPE("Frame");
+      for (int update = 0; update < 3; update++) {
+        FORGE_PROFILE_SCOPE("Update");
+        for (int inner = 0; inner < 2; inner++) {
+          FORGE_PROFILE_SCOPE("Inner");
+          sink = sink + (uint64_t)inner;
+        }
+      }
+      jobs.ParallelFor((uint32_t)batches, 1,
+                       [&](uint32_t begin, uint32_t end, uint32_t) {
+                         for (uint32_t i = begin; i < end; i++) {
+                           FORGE_PROFILE_SCOPE("Work");
+                           sink = sink + i;
+                         }
+                       });
+    }
+    Profiler::NextFrame();
+
+    const ProfileFrame last = Profiler::GetHistory().back();
+    uint32_t counts[3] = {}, work = 0;
+    const ProfileEvent *parent = nullptr;
+    for (const ProfileEvent &e : last.Events) {
+      if (isNamed(e, "Work")) {
+        work++;
+        continue;
+      }
+      int level = isNamed(e, "Frame") ? 0 : isNamed(e, "Update") ? 1
+                  : isNamed(e, "Inner")  ? 2
+                                         : -1;
+      if (level < 0)
+        continue;
+      counts[level]++;
+      structureErrors += e.Depth != (uint32_t)level ? 1 : 0;
+      structureErrors += e.StartNs > e.EndNs ? 1 : 0;
+      structureErrors +=
+          e.StartNs < last.StartNs || e.EndNs > last.EndNs ? 1 : 0;
+      if (level == 0)
+        parent = &e;
+    }
+    // Children end first, so the Frame event closes the thread's list
+    for (const ProfileEvent &e : last.Events) {
+      if (parent && e.Thread == parent->Thread && &e != parent &&
+          (e.StartNs < parent->StartNs || e.EndNs > parent->EndNs))
+        structureErrors++;
+    }
+    structureErrors += counts[0] != 1 || counts[1] != 3 || counts[2] != 6;
+    missingWork += work != (uint32_t)batches ? 1 : 0;
+  }
+  Profiler::StopCapture();
+
+  // 2. Export
+  std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "ForgeBenchProfiler";
+  std::filesystem::create_directories(directory);
+  const std::string tracePath = (directory / "trace.json").string();
+  uint64_t capturedEvents = 0;
+  {
+    std::vector<ProfileFrame> history = Profiler::GetHistory();
+    size_t keep = std::min<size_t>(history.size(), (size_t)frames);
+    for (size_t i = history.size() - keep; i < history.size(); i++)
+      capturedEvents += history[i].Events.size();
+  }
+  uint64_t exportErrors = 0;
+  const ProfilerStats captureStats = Profiler::GetStats();
+  if (!Profiler::ExportTrace(tracePath)) {
+    exportErrors++;
+  } else {
+    std::ifstream in(tracePath);
+    std::stringstream text;
+    text << in.rdbuf();
+    const std::string json = text.str();
+    uint64_t completeEvents = 0;
+    for (size_t at = json.find("\"ph\":\"X\""); at != std::string::npos;
+         at = json.find("\"ph\":\"X\"", at + 1))
+      completeEvents++;
+    bool framed = json.rfind("{\"traceEvents\":[", 0) == 0 &&
+                  json.find("]}") == json.size() - 3;
+    // Only the history's last frames could be counted here
+    if (!framed || captureStats.CapturedFrames != (uint32_t)std::min(
+                                                      frames, 3600) ||
+        (frames <= (int)Profiler::HistoryFrames &&
+         completeEvents != capturedEvents))
+      exportErrors++;
+    std::cout << "  trace: " << completeEvents << " events in "
+              << json.size() / 1024 << " KB" << std::endl;
+  }
+  std::filesystem::remove_all(directory);
+
+  // 3. Overflow: the excess of one frame is dropped, nothing else
+  Profiler::NextFrame();
+  Profiler::Reset();
+  const uint32_t overflow = 100;
+  for (uint32_t i = 0; i < Profiler::ThreadBufferEvents + overflow; i++) {
+    FORGE_PROFILE_SCOPE("Flood");
+  }
+  Profiler::NextFrame();
+  const ProfilerStats floodStats = Profiler::GetStats();
+  uint64_t dropErrors =
+      floodStats.DroppedEvents != overflow ||
+              Profiler::GetHistory().back().Events.size() !=
+                  Profiler::ThreadBufferEvents
+          ? 1
+          : 0;
+
+  // 4. Marker cost, enabled and disabled
+  auto timeScopes = [&](bool enabled) {
+    Profiler::SetEnabled(enabled);
+    Profiler::NextFrame();
+    auto start = Clock::now();
+    for (int done = 0; done < overheadScopes;) {
+      int chunk = std::min(overheadScopes - done, 16384);
+      for (int i = 0; i < chunk; i++) {
+        FORGE_PROFILE_SCOPE("Overhead");
+        sink = sink + (uint64_t)i;
+      }
+      done += chunk;
+      Profiler::NextFrame();
+    }
+    return ElapsedMs(start) * 1e6 / std::max(overheadScopes, 1);
+  };
+  double enabledNs = timeScopes(true);
+  double disabledNs = timeScopes(false);
+  Profiler::SetEnabled(true);
+  Profiler::NextFrame();
+  Profiler::Reset();
+
+  std::cout << "  " << frames << " frames, " << batches
+            << " ParallelFor batches each on " << jobs.GetThreadCount()
+            << " thread(s), " << Profiler::GetThreadNames().size()
+            << " profiled thread(s)" << std::endl;
+  std::cout << "  marker: " << enabledNs << " ns enabled, " << disabledNs
+            << " ns disabled (incl. frame collection)" << std::endl;
+  std::cout << "  overflow: " << floodStats.DroppedEvents << " of "
+            << Profiler::ThreadBufferEvents + overflow << " dropped"
+            << std::endl;
+
+  size_t errors = structureErrors + missingWork + exportErrors + dropErrors;
+  std::cout << "  validation errors: " << errors << std::endl;
+  return errors == 0 ? 0 : 1;
+#else
+  (void)args;
+  // Markers must vanish, arguments included
+  int evaluated = 0;
+  FORGE_PROFILE_SCOPE((evaluated++, "Unused"));
+  FORGE_PROFILE_FRAME();
+  std::cout << "  markers compiled out (FORGE_ENABLE_PROFILER=OFF)"
+            << std::endl;
+  std::cout << "  validation errors: " << evaluated << std::endl;
+  return evaluated == 0 ? 0 : 1;
+#endif
+}
+
+static Registrar s_ProfilerBench("profiler",
+                                 "CPU profiler markers and trace export",
+                                 RunProfilerBench);
+
+} // namespace Forge::Bench
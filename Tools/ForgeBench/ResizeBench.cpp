@@ -0,0 +1,195 @@
+#include "Bench.h"
+#include "RHI/DeferredRelease.h"
+#include "RHI/DescriptorAllocator.h"
+#include "RHI/FrameContext.h"
+#include "RHI/Null/NullRHI.h"
+#include "Renderer/RenderGraph.h"
+#include <iostream>
+
+// Viewport resize without WaitIdle: the scene view's color target and SRV
+// are recreated while earlier frames are still in flight (GPU latency 2).
+// The old target goes through the deferred release queue and the SRV slot
+// through the descriptor allocator; the Null backend reports any of them
+// destroyed or reused too early, and leaks are counted at the end. The
+// size is dragged every frame for a while and then held, so debouncing
+// shows up as far fewer recreations than requested sizes.
+
+namespace Forge::Bench {
+
+// Same policy as SceneViewRenderer: a size must hold for settleFrames
+// before the targets are replaced, and only at the start of a frame
+struct BenchViewport {
+  RHIDevice *Device = nullptr;
+  DescriptorAllocator *Descriptors = nullptr;
+  DeferredReleaseQueue *Releases = nullptr;
+  int SettleFrames = 4;
+
+  std::unique_ptr<RHIResource> Color;
+  DescriptorRange Srv;
+  int Width = 0, Height = 0;
+  int PendingWidth = 0, PendingHeight = 0, PendingFrames = 0;
+  uint64_t Recreations = 0;
+
+  void Create() {
+    Color = Device->CreateResource(RHIResourceDesc::Texture2D(
+        Width, Height, RHIFormat::RGBA8_UNorm, RHIResourceFlag_RenderTarget,
+        RHIResourceState::PixelShaderResource, "Viewport Color"));
+    Srv = Descriptors->AllocatePersistent();
+    Device->CreateShaderResourceView(Color.get(), Srv.CPU);
+  }
+
+  void Release() {
+    Descriptors->FreePersistent(Srv);
+    Releases->Retire(std::move(Color));
+  }
+
+  void Request(int width, int height) {
+    if (!Color) {
+      Width = width;
+      Height = height;
+      Create();
+      return;
+    }
+    if (width == Width && height == Height) {
+      PendingWidth = PendingHeight = PendingFrames = 0;
+      return;
+    }
+    if (width != PendingWidth || height != PendingHeight) {
+      PendingWidth = width;
+      PendingHeight = height;
+      PendingFrames = 0;
+      return;
+    }
+    PendingFrames++;
+  }
+
+  void ApplyPending() {
+    if (PendingWidth <= 0 || PendingFrames < SettleFrames)
+      return;
+    Release();
+    Width = PendingWidth;
+    Height = PendingHeight;
+    PendingWidth = PendingHeight = PendingFrames = 0;
+    Create();
+    Recreations++;
+  }
+};
+
+static int RunResizeBench(const std::vector<std::string> &args) {
+  const int frames = GetIntArg(args, "frames", 1000);
+  const int dragFrames = GetIntArg(args, "drag", 30); // size changes/frame
+  const int holdFrames = GetIntArg(args, "hold", 60);
+  const int settleFrames = GetIntArg(args, "settle", 4);
+
+  NullRHIConfig config;
+  config.GPULatency = 2;
+  config.LogErrors = true;
+  NullRHIDevice device(config);
+  auto queue = device.CreateCommandQueue(RHIQueueType::Direct);
+  FrameContextRing frameRing;
+  frameRing.Initialize(&device, queue.get(), 2);
+
+  DescriptorAllocator descriptors;
+  descriptors.Initialize(&device, {});
+  DeferredReleaseQueue releases;
+  RenderGraph graph;
+  graph.Initialize(&device);
+  RHIGraphicsPipelineDesc pipelineDesc;
+  auto pipeline = device.CreateGraphicsPipeline(pipelineDesc);
+
+  BenchViewport viewport;
+  viewport.Device = &device;
+  viewport.Descriptors = &descriptors;
+  viewport.Releases = &releases;
+  viewport.SettleFrames = settleFrames;
+
+  uint64_t sizeChanges = 0;
+  int requestedWidth = 1280, requestedHeight = 720;
+  viewport.Request(requestedWidth, requestedHeight); // first size: immediate
+  auto start = Clock::now();
+  for (int frame = 0; frame < frames; frame++) {
+    RHICommandList *commandList = frameRing.BeginFrame();
+    uint64_t completed = frameRing.GetCompletedFenceValue();
+    descriptors.BeginFrame(completed);
+    graph.BeginFrame(completed);
+    releases.BeginFrame(completed);
+
+    // Scene view render (SceneViewRenderer::Render)
+    viewport.ApplyPending();
+    graph.Reset();
+    RGResourceHandle color = graph.Import(
+        "Viewport Color", viewport.Color.get(),
+        RHIResourceState::PixelShaderResource,
+        RHIResourceState::PixelShaderResource);
+    RGResourceHandle depth = graph.CreateTexture(
+        "Viewport Depth", viewport.Width, viewport.Height,
+        RHIFormat::D24_UNorm_S8_UInt, RHIResourceFlag_DepthStencil);
+    graph.AddPass(
+        "Scene",
+        [&](RGPassBuilder &builder) {
+          builder.Write(color);
+          builder.Write(depth, RHIResourceState::DepthWrite);
+        },
+        [&](RGContext &context) {
+          RHICPUDescriptor rtv = context.GetRTV(color);
+          RHICPUDescriptor dsv = context.GetDSV(depth);
+          RHICommandList *list = context.CommandList;
+          const float clear[] = {0.1f, 0.1f, 0.1f, 1.0f};
+          list->SetRenderTargets(&rtv, 1, &dsv);
+          list->ClearRenderTarget(rtv, clear);
+          list->ClearDepthStencil(dsv, 1.0f, 0);
+          list->SetPipelineState(pipeline.get());
+          list->Draw(3, 1, 0, 0);
+        });
+    if (graph.Compile())
+      commandList = graph.Execute(commandList);
+
+    // ImGui viewport window (EditorUI::DrawViewport): drag, then hold
+    int phase = frame % (dragFrames + holdFrames);
+    if (phase < dragFrames) {
+      requestedWidth = 960 + (frame * 7) % 960;
+      requestedHeight = 540 + (frame * 5) % 540;
+      sizeChanges++;
+    }
+    viewport.Request(requestedWidth, requestedHeight);
+
+    uint64_t fenceValue = frameRing.Submit();
+    descriptors.EndFrame(fenceValue);
+    graph.EndFrame(fenceValue);
+    releases.EndFrame(fenceValue);
+  }
+  double totalMs = ElapsedMs(start);
+  frameRing.Shutdown();
+
+  // Editor shutdown order: renderer first, then the context's queues
+  viewport.Release();
+  graph.Shutdown();
+  releases.Shutdown();
+  descriptors.Shutdown();
+  pipeline.reset();
+
+  const DeferredReleaseStats &stats = releases.GetStats();
+  const NullRHIStats &rhi = device.GetStats();
+  uint64_t leaked = rhi.ResourcesCreated - rhi.ResourcesDestroyed;
+  std::cout << "  frames=" << frames << " drag " << dragFrames << " / hold "
+            << holdFrames << ", settle " << settleFrames << " frame(s)"
+            << std::endl;
+  std::cout << "  " << sizeChanges << " size change(s) -> "
+            << viewport.Recreations << " recreation(s)" << std::endl;
+  std::cout << "  deferred releases " << stats.Released << "/"
+            << stats.Retired << ", peak pending " << stats.PeakPending
+            << ", leaked resources " << leaked << std::endl;
+  std::cout << "  " << (totalMs * 1000.0 / frames) << " us/frame"
+            << std::endl;
+
+  size_t errors = device.GetValidationErrors().size();
+  std::cout << "  validation errors: " << errors << std::endl;
+  bool debounced = viewport.Recreations < sizeChanges;
+  return (errors == 0 && leaked == 0 && debounced) ? 0 : 1;
+}
+
+static Registrar s_ResizeBench(
+    "resize", "Debounced viewport resize with fence-based deferred release",
+    RunResizeBench);
+
+} // namespace Forge::Bench
@@ -0,0 +1,157 @@
+#include "Bench.h"
+#include "Core/Hash.h"
+#include "RHI/Null/NullRHI.h"
+#include "RHI/PipelineCache.h"
+#include "Renderer/ShaderCache.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+// Cold vs. warm start of the shader + pipeline caches. A fake compiler
+// stands in for D3DCompile (--cost = hash passes over the source per
+// compile); the second pass simulates an editor restart on the same
+// cache directory and must not compile anything. Every shader includes a
+// shared header; the third pass edits only that header and must
+// recompile every shader.
+
+namespace Forge::Bench {
+
+static int RunShaderCacheBench(const std::vector<std::string> &args) {
+  const int shaders = GetIntArg(args, "shaders", 200);
+  const int cost = GetIntArg(args, "cost", 500);
+  const int budgetKB = GetIntArg(args, "budget", 64 * 1024);
+
+  std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "ForgeBenchShaderCache";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory / "src");
+
+  auto writeHeader = [&](int version) {
+    std::ofstream file(directory / "src" / "Common.hlsli", std::ios::trunc);
+    file << "static const float Version = " << version << ".0;\n";
+  };
+  writeHeader(1);
+
+  std::vector<std::string> paths;
+  for (int i = 0; i < shaders; i++) {
+    std::string path = (directory / "src" /
+                        ("Shader" + std::to_string(i) + ".hlsl"))
+                           .string();
+    std::ofstream file(path);
+    file << "// shader " << i << "\n";
+    file << "#include \"Common.hlsli\"\n";
+    for (int line = 0; line < 64; line++)
+      file << "float4 f" << line << "(float4 x) { return x * " << i
+           << ".0; }\n";
+    paths.push_back(path);
+  }
+
+  // Splices in `#include "file"` lines (relative to the shader) and
+  // reports them, like the HLSL backend
+  ShaderCompileFunction fakeCompiler =
+      [cost](const ShaderDesc &desc, const std::string &source,
+             std::vector<uint8_t> &outBytecode,
+             std::vector<std::string> &outIncludes, std::string &outErrors) {
+        const std::string directive = "#include \"";
+        std::filesystem::path directory =
+            std::filesystem::path(desc.SourcePath).parent_path();
+        std::string text = source;
+        for (size_t at = source.find(directive); at != std::string::npos;
+             at = source.find(directive, at)) {
+          at += directive.size();
+          size_t end = source.find('"', at);
+          std::string path = (directory / source.substr(at, end - at)).string();
+          std::ifstream file(path);
+          if (!file) {
+            outErrors = "cannot open include " + path;
+            return false;
+          }
+          text.append(std::istreambuf_iterator<char>(file), {});
+          outIncludes.push_back(path);
+        }
+
+        uint64_t hash = HashSeed;
+        for (int pass = 0; pass < cost; pass++)
+          hash = HashString(text, hash);
+        outBytecode.resize(512 + text.size() / 4);
+        for (size_t i = 0; i < outBytecode.size(); i++)
+          outBytecode[i] = (uint8_t)(hash >> ((i % 8) * 8));
+        return !desc.EntryPoint.empty();
+      };
+
+  auto runPass = [&](const char *label, ShaderCacheStats &outShaderStats,
+                     PipelineCacheStats &outPipelineStats,
+                     NullRHIStats &outRHIStats) {
+    NullRHIDevice device;
+    ShaderCache shaderCache;
+    PipelineCache pipelineCache;
+
+    auto start = Clock::now();
+    shaderCache.Initialize(directory / "cache", (uint64_t)budgetKB * 1024,
+                           "fake-compiler-1", fakeCompiler);
+    pipelineCache.Initialize(&device, directory / "cache" / "Pipelines.bin");
+
+    for (const std::string &path : paths) {
+      ShaderDesc vsDesc, psDesc;
+      vsDesc.SourcePath = psDesc.SourcePath = path;
+      vsDesc.EntryPoint = "VSMain";
+      vsDesc.Target = "vs_5_0";
+      psDesc.EntryPoint = "PSMain";
+      psDesc.Target = "ps_5_0";
+      ShaderBytecode vs = shaderCache.GetOrCompile(vsDesc);
+      ShaderBytecode ps = shaderCache.GetOrCompile(psDesc);
+      if (!vs || !ps)
+        continue;
+
+      RHIGraphicsPipelineDesc desc;
+      desc.InputLayout = {{"POSITION", 0, RHIFormat::RGB32_Float, 0, 0}};
+      desc.VS = {vs->data(), vs->size()};
+      desc.PS = {ps->data(), ps->size()};
+      desc.DSVFormat = RHIFormat::D32_Float;
+      desc.DepthEnable = true;
+      pipelineCache.GetOrCreate(desc);
+    }
+    pipelineCache.Shutdown();
+    shaderCache.Shutdown();
+    double ms = ElapsedMs(start);
+
+    outShaderStats = shaderCache.GetStats();
+    outPipelineStats = pipelineCache.GetStats();
+    outRHIStats = device.GetStats();
+    std::cout << "  " << label << ": " << ms << " ms, compiles "
+              << outShaderStats.Compiles << ", disk hits "
+              << outShaderStats.DiskHits << ", evictions "
+              << outShaderStats.Evictions << ", cache "
+              << (outShaderStats.DiskBytes / 1024) << " KB" << std::endl;
+    std::cout << "  " << label << ": pipelines created "
+              << outRHIStats.PipelinesCreated << ", loaded from library "
+              << outRHIStats.PipelinesLoaded << std::endl;
+    return device.GetValidationErrors().size();
+  };
+
+  ShaderCacheStats coldShaders, warmShaders, editedShaders;
+  PipelineCacheStats coldPipelines, warmPipelines, editedPipelines;
+  NullRHIStats coldRHI, warmRHI, editedRHI;
+  size_t errors = runPass("cold", coldShaders, coldPipelines, coldRHI);
+  errors += runPass("warm", warmShaders, warmPipelines, warmRHI);
+  writeHeader(2);
+  errors += runPass("header edited", editedShaders, editedPipelines,
+                    editedRHI);
+
+  std::filesystem::remove_all(directory);
+  std::cout << "  validation errors: " << errors << std::endl;
+
+  // Warm start must not compile unless the budget forced evictions
+  bool warmClean = coldShaders.Evictions > 0 ||
+                   (warmShaders.Compiles == 0 && warmRHI.PipelinesCreated == 0);
+  // A header edit must not be served stale bytecode
+  bool editRecompiled = editedShaders.Compiles == (uint64_t)shaders * 2 &&
+                        editedShaders.DiskHits == 0;
+  return (errors == 0 && warmClean && editRecompiled) ? 0 : 1;
+}
+
+static Registrar s_ShaderCacheBench("shadercache",
+                                    "Shader/pipeline cache cold vs warm start",
+                                    RunShaderCacheBench);
+
+} // namespace Forge::Bench
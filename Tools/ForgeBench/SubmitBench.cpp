@@ -0,0 +1,126 @@
+#include "Bench.h"
+#include "RHI/FrameContext.h"
+#include "RHI/Null/NullRHI.h"
+#include <iostream>
+
+// CPU cost of recording + submitting a frame through the RHI (null backend).
+// Mirrors the editor frame: back buffer barrier, scene view pass with N
+// draws, transition back. --inflight=N runs N frames ahead of the (fake)
+// GPU; --latency=L keeps L submissions pending on the null device.
+
+namespace Forge::Bench {
+
+static int RunSubmitBench(const std::vector<std::string> &args) {
+  const int frames = GetIntArg(args, "frames", 1000);
+  const int draws = GetIntArg(args, "draws", 1000);
+  const uint32_t framesInFlight = (uint32_t)GetIntArg(args, "inflight", 2);
+
+  NullRHIConfig config;
+  config.GPULatency = (uint32_t)GetIntArg(args, "latency", 1);
+  NullRHIDevice device(config);
+
+  auto queue = device.CreateCommandQueue(RHIQueueType::Direct);
+  FrameContextRing frameRing;
+  frameRing.Initialize(&device, queue.get(), framesInFlight);
+
+  auto rtvHeap =
+      device.CreateDescriptorHeap({RHIDescriptorHeapType::RTV, 2, false});
+  auto dsvHeap =
+      device.CreateDescriptorHeap({RHIDescriptorHeapType::DSV, 1, false});
+
+  auto backBuffer = device.CreateResource(RHIResourceDesc::Texture2D(
+      1600, 900, RHIFormat::RGBA8_UNorm, RHIResourceFlag_RenderTarget,
+      RHIResourceState::Present, "BackBuffer"));
+  auto sceneColor = device.CreateResource(RHIResourceDesc::Texture2D(
+      1280, 720, RHIFormat::RGBA8_UNorm, RHIResourceFlag_RenderTarget,
+      RHIResourceState::PixelShaderResource, "SceneView Color"));
+  auto sceneDepth = device.CreateResource(RHIResourceDesc::Texture2D(
+      1280, 720, RHIFormat::D24_UNorm_S8_UInt, RHIResourceFlag_DepthStencil,
+      RHIResourceState::DepthWrite, "SceneView Depth"));
+  auto vertexBuffer = device.CreateResource(
+      RHIResourceDesc::Buffer(84 * 28, RHIHeapType::Upload,
+                              RHIResourceState::GenericRead, "Grid VB"));
+
+  device.CreateRenderTargetView(backBuffer.get(), rtvHeap->GetCPU(0));
+  device.CreateRenderTargetView(sceneColor.get(), rtvHeap->GetCPU(1));
+  device.CreateDepthStencilView(sceneDepth.get(), dsvHeap->GetCPU(0));
+
+  RHIGraphicsPipelineDesc psoDesc;
+  psoDesc.RootParameters.push_back(
+      {RHIRootParameter::Type::Constants, 0, 16, 0,
+       RHIShaderVisibility::Vertex});
+  psoDesc.DSVFormat = RHIFormat::D24_UNorm_S8_UInt;
+  psoDesc.DepthEnable = true;
+  psoDesc.DebugName = "Bench";
+  auto pipeline = device.CreateGraphicsPipeline(psoDesc);
+
+  const float clearColor[] = {0.1f, 0.1f, 0.1f, 1.0f};
+  float viewProj[16] = {};
+
+  device.ResetStats();
+  auto start = Clock::now();
+
+  for (int frame = 0; frame < frames; frame++) {
+    RHICommandList *commandList = frameRing.BeginFrame();
+
+    commandList->ResourceBarrier({backBuffer.get(), RHIResourceState::Present,
+                                  RHIResourceState::RenderTarget});
+
+    RHICPUDescriptor sceneRtv = rtvHeap->GetCPU(1);
+    RHICPUDescriptor sceneDsv = dsvHeap->GetCPU(0);
+    commandList->ResourceBarrier({sceneColor.get(),
+                                  RHIResourceState::PixelShaderResource,
+                                  RHIResourceState::RenderTarget});
+    commandList->SetRenderTargets(&sceneRtv, 1, &sceneDsv);
+    commandList->ClearRenderTarget(sceneRtv, clearColor);
+    commandList->ClearDepthStencil(sceneDsv, 1.0f, 0);
+    commandList->SetViewport({0, 0, 1280, 720, 0, 1});
+    commandList->SetScissor({0, 0, 1280, 720});
+    commandList->SetPipelineState(pipeline.get());
+    commandList->SetPrimitiveTopology(RHIPrimitiveTopology::LineList);
+    commandList->SetVertexBuffer(0, vertexBuffer.get(), 0, 84 * 28, 28);
+    for (int i = 0; i < draws; i++) {
+      viewProj[0] = (float)i;
+      commandList->SetGraphicsConstants(0, 16, viewProj);
+      commandList->Draw(84, 1, 0, 0);
+    }
+    commandList->ResourceBarrier({sceneColor.get(),
+                                  RHIResourceState::RenderTarget,
+                                  RHIResourceState::PixelShaderResource});
+
+    RHICPUDescriptor backRtv = rtvHeap->GetCPU(0);
+    commandList->SetRenderTargets(&backRtv, 1, nullptr);
+    commandList->ClearRenderTarget(backRtv, clearColor);
+    commandList->ResourceBarrier({backBuffer.get(),
+                                  RHIResourceState::RenderTarget,
+                                  RHIResourceState::Present});
+    frameRing.Submit();
+  }
+
+  double totalMs = ElapsedMs(start);
+  const uint32_t usedFramesInFlight = frameRing.GetFramesInFlight();
+  frameRing.Shutdown();
+  device.WaitIdle();
+
+  const NullRHIStats &stats = device.GetStats();
+  std::cout << "  frames=" << frames << " draws/frame=" << draws
+            << " commands=" << stats.CommandsRecorded
+            << " barriers=" << stats.Barriers << std::endl;
+  std::cout << "  frames in flight=" << usedFramesInFlight
+            << " cpu stalls=" << frameRing.GetStats().CPUStalls << " ("
+            << frameRing.GetStats().CPUStallMs << " ms)" << std::endl;
+  std::cout << "  total " << totalMs << " ms, "
+            << (totalMs * 1000.0 / frames) << " us/frame, "
+            << (totalMs * 1.0e6 / (double)stats.CommandsRecorded)
+            << " ns/command" << std::endl;
+
+  size_t errors = device.GetValidationErrors().size();
+  std::cout << "  validation errors: " << errors << std::endl;
+  return errors == 0 ? 0 : 1;
+}
+
+static Registrar s_SubmitBench("submit",
+                               "RHI frame record + submit cost (null backend)",
+                               RunSubmitBench);
+
+} // namespace Forge::Bench
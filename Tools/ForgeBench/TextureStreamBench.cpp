@@ -0,0 +1,315 @@
+#include "Asset/TextureFile.h"
+#include "Bench.h"
+#include "RHI/DeferredRelease.h"
+#include "RHI/FrameContext.h"
+#include "RHI/Null/NullRHI.h"
+#include "RHI/UploadManager.h"
+#include "Renderer/TextureStreamer.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// Mip streaming on the Null backend: a camera flies down a corridor of
+// textured panels (256 to 2048 texels, BC1 and BC7) whose full mip chains
+// need several times the memory budget. Every frame reports usage, runs
+// the streamer and binds each panel's current resource; the Null backend
+// reports use before the copy queue finished and resources destroyed while
+// in use. Checked: tails arrive first, resident memory stays inside the
+// budget (also after it shrinks), nearer panels of a size get at least
+// the resolution of farther ones, the streamer settles on its targets,
+// and with room to spare every panel reaches its desired mip.
+
+namespace Forge::Bench {
+
+namespace {
+
+// Synthetic cooked texture: real DDS layout, arbitrary block contents
+bool WriteTexture(const std::filesystem::path &path, RHIFormat format,
+                  uint32_t size) {
+  uint32_t mips = 1;
+  while ((size >> mips) > 0)
+    mips++;
+  std::vector<uint8_t> file;
+  AppendDDSHeader(file, format, size, size, mips);
+  for (uint32_t mip = 0; mip < mips; mip++) {
+    uint32_t mipSize = GetMipSize(size, mip);
+    uint64_t bytes =
+        GetRowBytes(format, mipSize) * GetRowCount(format, mipSize);
+    file.resize(file.size() + bytes, (uint8_t)(mip * 37 + 11));
+  }
+  std::ofstream out(path, std::ios::binary);
+  out.write((const char *)file.data(), (std::streamsize)file.size());
+  return (bool)out;
+}
+
+} // namespace
+
+static int RunTextureStreamBench(const std::vector<std::string> &args) {
+  const int panelCount = GetIntArg(args, "panels", 64);
+  const int frames = GetIntArg(args, "frames", 600);
+  const int budgetMB = GetIntArg(args, "budget", 6);
+  const std::filesystem::path directory = "/tmp/ForgeBenchTexStream";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+
+  uint64_t errors = 0;
+
+  // Desired mips: texels of the larger side against screen pixels
+  errors += TextureStreamer::ComputeDesiredMip(1024, 1024, 256.0f, 0.0f,
+                                               10) != 2;
+  errors += TextureStreamer::ComputeDesiredMip(1024, 512, 300.0f, 0.0f,
+                                               10) != 1;
+  errors += TextureStreamer::ComputeDesiredMip(1024, 1024, 256.0f, 1.0f,
+                                               10) != 3;
+  errors += TextureStreamer::ComputeDesiredMip(1024, 1024, 5000.0f, 0.0f,
+                                               10) != 0;
+  errors += TextureStreamer::ComputeDesiredMip(1024, 1024, 0.0f, 0.0f, 4) != 4;
+  errors += TextureStreamer::ComputeDesiredMip(1024, 1024, 1.0f, 0.0f, 4) != 4;
+
+  NullRHIConfig config;
+  config.GPULatency = 2;
+  config.LogErrors = true;
+  NullRHIDevice device(config);
+  auto queue = device.CreateCommandQueue(RHIQueueType::Direct);
+  FrameContextRing frameRing;
+  frameRing.Initialize(&device, queue.get(), 2);
+  UploadManager uploads;
+  uploads.Initialize(&device, 32ull << 20);
+  DeferredReleaseQueue releases;
+
+  TextureStreamerSettings settings;
+  settings.BudgetBytes = (uint64_t)budgetMB << 20;
+  settings.MaxUploadBytesPerUpdate = 8ull << 20;
+  TextureStreamer streamer;
+  streamer.Initialize(&device, &uploads, &releases, settings);
+
+  // Panels every 8 units along +Z, alternating sides; sizes cycle
+  struct Panel {
+    StreamedTextureID Texture = 0;
+    uint32_t Size = 0;
+    float Center[3] = {};
+    int FirstResidentMip = -1; // mip of the first version that arrived
+    int ArrivalFrame = -1;
+  };
+  std::vector<Panel> panels(panelCount);
+  auto panelPath = [&](int i) {
+    return (directory / ("panel" + std::to_string(i) + ".dds")).string();
+  };
+  const uint32_t sizes[4] = {256, 512, 1024, 2048};
+  uint64_t fullBytes = 0;
+  for (int i = 0; i < panelCount; i++) {
+    Panel &panel = panels[i];
+    panel.Size = sizes[i % 4];
+    RHIFormat format =
+        i % 8 < 4 ? RHIFormat::BC1_UNorm_sRGB : RHIFormat::BC7_UNorm_sRGB;
+    if (!WriteTexture(panelPath(i), format, panel.Size) ||
+        !(panel.Texture = streamer.Register(panelPath(i)))) {
+      errors++;
+      continue;
+    }
+    panel.Center[0] = i % 2 ? 3.0f : -3.0f;
+    panel.Center[1] = 1.5f;
+    panel.Center[2] = i * 8.0f;
+    const TextureFile &file = streamer.GetFile(panel.Texture);
+    for (uint32_t mip = 0; mip < file.GetMipCount(); mip++)
+      fullBytes += file.GetMipBytes(mip);
+  }
+
+  // One SRV slot per panel and frame in flight
+  auto srvHeap = device.CreateDescriptorHeap(
+      {RHIDescriptorHeapType::CBV_SRV_UAV, (uint32_t)panelCount * 2, true});
+  auto target = device.CreateResource(RHIResourceDesc::Texture2D(
+      256, 256, RHIFormat::RGBA8_UNorm, RHIResourceFlag_RenderTarget,
+      RHIResourceState::RenderTarget, "Target"));
+  auto rtvHeap = device.CreateDescriptorHeap({RHIDescriptorHeapType::RTV, 1});
+  RHICPUDescriptor rtv = rtvHeap->GetCPU(0);
+  device.CreateRenderTargetView(target.get(), rtv);
+  RHIGraphicsPipelineDesc pipelineDesc;
+  auto pipeline = device.CreateGraphicsPipeline(pipelineDesc);
+
+  const float fovY = 1.0472f; // 60 degrees
+  const float viewportHeight = 1080.0f;
+  const float corridorEnd = panelCount * 8.0f;
+  uint64_t overBudgetFrames = 0, draws = 0, unregistered = 0;
+  bool checkBudget = true;
+  double updateMs = 0.0;
+  auto runFrame = [&](int frame, float eyeZ) {
+    RHICommandList *commandList = frameRing.BeginFrame();
+    releases.BeginFrame(frameRing.GetCompletedFenceValue());
+    uploads.BeginFrame(commandList);
+
+    // Panels ahead of the camera, up to 160 units
+    const float eye[3] = {0.0f, 1.7f, eyeZ};
+    std::vector<TextureUsage> usages;
+    for (const Panel &panel : panels) {
+      float ahead = panel.Center[2] - eyeZ;
+      if (panel.Texture && ahead > -2.0f && ahead < 160.0f)
+        usages.push_back({panel.Texture,
+                          {panel.Center[0], panel.Center[1], panel.Center[2]},
+                          4.0f,
+                          8.0f});
+    }
+    auto start = Clock::now();
+    streamer.SetView(eye, fovY, viewportHeight);
+    streamer.ReportUsage(usages.data(), (uint32_t)usages.size());
+    streamer.Update();
+    updateMs += ElapsedMs(start);
+    overBudgetFrames += checkBudget && streamer.GetStats().ResidentBytes >
+                                           streamer.GetSettings().BudgetBytes
+                            ? 1
+                            : 0;
+
+    commandList->SetRenderTargets(&rtv, 1, nullptr);
+    commandList->SetPipelineState(pipeline.get());
+    RHIDescriptorHeap *heaps[] = {srvHeap.get()};
+    commandList->SetDescriptorHeaps(heaps, 1);
+    for (size_t i = 0; i < panels.size(); i++) {
+      Panel &panel = panels[i];
+      if (!panel.Texture)
+        continue;
+      RHIResource *resource = streamer.GetResource(panel.Texture);
+      if (!resource)
+        continue;
+      if (panel.ArrivalFrame < 0) {
+        panel.ArrivalFrame = frame;
+        panel.FirstResidentMip = (int)streamer.GetResidentMip(panel.Texture);
+      }
+      uint32_t slot = frameRing.GetFrameIndex() * (uint32_t)panelCount +
+                      (uint32_t)i;
+      device.CreateShaderResourceView(resource, srvHeap->GetCPU(slot));
+      commandList->SetGraphicsDescriptorTable(0, srvHeap->GetGPU(slot));
+      commandList->Draw(6, 1, 0, 0);
+      draws++;
+    }
+
+    uploads.Flush();
+    releases.EndFrame(frameRing.Submit());
+  };
+
+  // 1. Fly down the corridor, then park two thirds of the way in
+  const float parkZ = corridorEnd * 0.66f;
+  const int flight = frames * 2 / 3;
+  auto start = Clock::now();
+  for (int frame = 0; frame < frames; frame++) {
+    float t = std::min(1.0f, (float)frame / flight);
+    runFrame(frame, -10.0f + t * (parkZ + 10.0f));
+    // Now and then a panel is unloaded and registered again, possibly
+    // with its copies in flight
+    Panel &panel = panels[frame % panelCount];
+    if (frame % 97 == 50 && panel.Texture) {
+      streamer.Unregister(panel.Texture);
+      panel.Texture = streamer.Register(panelPath(frame % panelCount));
+      panel.ArrivalFrame = -1;
+      unregistered++;
+    }
+  }
+  double flightMs = ElapsedMs(start);
+  const TextureStreamerStats parked = streamer.GetStats();
+
+  // Tails first, soon
+  uint32_t lateTails = 0;
+  for (const Panel &panel : panels) {
+    if (!panel.Texture)
+      continue;
+    lateTails += panel.FirstResidentMip !=
+                         (int)streamer.GetTailMip(panel.Texture)
+                     ? 1
+                     : 0;
+  }
+
+  // Panels are held coarser than desired exactly when the budget is short
+  bool heldCoarser = (parked.OverBudget > 0) ==
+                     (parked.DesiredBytes > settings.BudgetBytes);
+
+  // Settled, and per size nearer panels at least as sharp as farther ones
+  bool settled = parked.PendingLoads == 0;
+  uint32_t priorityInversions = 0;
+  for (size_t i = 0; i < panels.size(); i++) {
+    const Panel &panel = panels[i];
+    settled &= streamer.GetResidentMip(panel.Texture) ==
+               streamer.GetTargetMip(panel.Texture);
+    float ahead = panel.Center[2] - parkZ;
+    if (ahead < 0.0f || ahead >= 160.0f)
+      continue;
+    for (size_t j = i + 4; j < panels.size(); j += 4) {
+      float jAhead = panels[j].Center[2] - parkZ;
+      if (jAhead >= 160.0f)
+        break;
+      priorityInversions += streamer.GetResidentMip(panel.Texture) >
+                                    streamer.GetResidentMip(panels[j].Texture)
+                                ? 1
+                                : 0;
+    }
+  }
+
+  // 2. Plenty of room: every panel in view reaches its desired mip
+  TextureStreamerSettings roomy = settings;
+  roomy.BudgetBytes = fullBytes * 2;
+  streamer.SetSettings(roomy);
+  for (int frame = 0; frame < 60; frame++)
+    runFrame(frames + frame, parkZ);
+  uint32_t belowDesired = 0;
+  for (const Panel &panel : panels) {
+    belowDesired += streamer.GetResidentMip(panel.Texture) >
+                            streamer.GetDesiredMip(panel.Texture)
+                        ? 1
+                        : 0;
+  }
+  const uint64_t roomyResident = streamer.GetStats().ResidentBytes;
+
+  // 3. The budget shrinks below what is resident: evictions bring it back
+  TextureStreamerSettings tight = settings;
+  tight.BudgetBytes = settings.BudgetBytes * 3 / 4;
+  streamer.SetSettings(tight);
+  checkBudget = false;
+  for (int frame = 0; frame < 30; frame++)
+    runFrame(frames + 60 + frame, parkZ);
+  const TextureStreamerStats shrunk = streamer.GetStats();
+  bool shrinkHonored = shrunk.ResidentBytes <= tight.BudgetBytes &&
+                       shrunk.PendingLoads == 0;
+
+  frameRing.Shutdown();
+  const TextureStreamerStats totals = streamer.GetStats();
+  streamer.Shutdown();
+  uploads.Shutdown();
+  releases.Shutdown();
+  target.reset();
+
+  std::cout << "  " << panelCount << " panels, full chains "
+            << fullBytes / (1024.0 * 1024.0) << " MB, budget " << budgetMB
+            << " MB" << std::endl;
+  std::cout << "  parked: resident " << parked.ResidentBytes / (1024.0 * 1024.0)
+            << " MB (desired " << parked.DesiredBytes / (1024.0 * 1024.0)
+            << " MB, " << parked.OverBudget
+            << " panels held coarser), peak with copies in flight "
+            << parked.PeakBytes / (1024.0 * 1024.0) << " MB" << std::endl;
+  std::cout << "  " << totals.Loads << " loads, " << totals.Evictions
+            << " evictions, " << totals.UploadedBytes / (1024.0 * 1024.0)
+            << " MB uploaded, " << unregistered << " re-registrations, "
+            << draws << " draws" << std::endl;
+  std::cout << "  roomy budget: resident "
+            << roomyResident / (1024.0 * 1024.0) << " MB, " << belowDesired
+            << " below desired; budget cut to "
+            << tight.BudgetBytes / (1024.0 * 1024.0)
+            << " MB: resident " << shrunk.ResidentBytes / (1024.0 * 1024.0)
+            << " MB" << std::endl;
+  std::cout << "  late tails " << lateTails << ", frames over budget "
+            << overBudgetFrames << ", priority inversions "
+            << priorityInversions << ", settled " << (settled ? "yes" : "no")
+            << std::endl;
+  std::cout << "  " << flightMs * 1000.0 / frames << " us/frame, Update "
+            << updateMs * 1000.0 / (frames + 90) << " us" << std::endl;
+
+  size_t validation = device.GetValidationErrors().size();
+  size_t total = validation + errors + lateTails + overBudgetFrames +
+                 priorityInversions + belowDesired + (settled ? 0 : 1) +
+                 (shrinkHonored ? 0 : 1) + (heldCoarser ? 0 : 1);
+  std::cout << "  validation errors: " << total << std::endl;
+  return total == 0 ? 0 : 1;
+}
+
+static Registrar s_TextureStreamBench(
+    "texstream", "Texture mip streaming under a memory budget",
+    RunTextureStreamBench);
+
+} // namespace Forge::Bench
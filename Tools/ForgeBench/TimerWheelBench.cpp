@@ -0,0 +1,171 @@
+#include "Bench.h"
+#include "Core/TimerWheel.h"
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <unordered_map>
+
+// Timer wheel against a sorted reference (std::multimap by due tick):
+// timers sharing a tick or a slot, delays across every level boundary
+// (cascades), delays past the 2^32 tick range, and cancels before and
+// after firing. Time advances in random steps, from single ticks to huge
+// jumps; each Advance must return exactly the reference's due timers in
+// due order, and a cancelled timer must never fire.
+
+namespace Forge::Bench {
+
+static int RunTimerWheelBench(const std::vector<std::string> &args) {
+  const int rounds = GetIntArg(args, "rounds", 2000);
+  const int timersPerRound = GetIntArg(args, "timers", 64);
+
+  std::mt19937_64 rng(4321);
+  TimerWheel wheel(12345); // not slot aligned
+  std::multimap<uint64_t, uint64_t> reference; // due tick -> payload
+  std::unordered_map<uint64_t, TimerWheel::TimerID> ids; // payload -> ID
+  std::unordered_map<uint64_t, uint64_t> dues;            // payload -> due
+  std::vector<TimerWheel::TimerID> fired;
+  uint64_t nextPayload = 1;
+
+  // Delays at and around every level boundary, and far past the wheel
+  const uint64_t boundaries[] = {
+      1,          255,        256,        257,        65535,
+      65536,      65537,      1ull << 24, (1ull << 24) + 1,
+      1ull << 32, (1ull << 32) + 1, 1ull << 33, (1ull << 40) + 7};
+  auto randomDelay = [&]() -> uint64_t {
+    switch (rng() % 6) {
+    case 0:
+      return boundaries[rng() % std::size(boundaries)];
+    case 1:
+      return 1 + rng() % 256; // level 0
+    case 2:
+      return 1 + rng() % 65536;
+    case 3:
+      return 1 + rng() % (1ull << 26);
+    case 4:
+      return (1ull << 32) + rng() % (1ull << 34); // long delays
+    default:
+      return 0; // due now: fires on the next Advance
+    }
+  };
+
+  uint64_t orderErrors = 0, missingErrors = 0, cancelErrors = 0;
+  uint64_t scheduled = 0, cancelled = 0, expiredTotal = 0, sameSlot = 0;
+  std::vector<uint64_t> expired;
+  double scheduleMs = 0.0, advanceMs = 0.0;
+
+  auto schedule = [&](uint64_t dueTick) {
+    uint64_t payload = nextPayload++;
+    auto start = Clock::now();
+    TimerWheel::TimerID id = wheel.Schedule(payload, dueTick);
+    scheduleMs += ElapsedMs(start);
+    // Already due: the wheel moves it to the next tick
+    uint64_t due = std::max(dueTick, wheel.GetCurrentTick() + 1);
+    reference.emplace(due, payload);
+    ids[payload] = id;
+    dues[payload] = due;
+    scheduled++;
+  };
+
+  for (int round = 0; round < rounds; round++) {
+    const uint64_t now = wheel.GetCurrentTick();
+    for (int i = 0; i < timersPerRound; i++)
+      schedule(now + randomDelay());
+    // Same tick and same level-0 slot one and two turns later
+    uint64_t shared = now + 1 + rng() % 256;
+    for (int i = 0; i < 4; i++) {
+      schedule(shared);
+      schedule(shared + 256 * (uint64_t)(i % 2 + 1));
+      sameSlot += 2;
+    }
+
+    // Cancel about a quarter of the pending timers, and retry a few that
+    // already fired (must fail)
+    for (int i = 0; i < timersPerRound / 4 && !reference.empty(); i++) {
+      auto it = reference.begin();
+      std::advance(it, (ptrdiff_t)(rng() % reference.size()));
+      if (!wheel.Cancel(ids[it->second]))
+        cancelErrors++;
+      ids.erase(it->second);
+      reference.erase(it);
+      cancelled++;
+    }
+    for (int i = 0; i < 2 && !fired.empty(); i++) {
+      if (wheel.Cancel(fired[rng() % fired.size()]))
+        cancelErrors++;
+    }
+
+    // Random step: mostly small, sometimes across a level or far ahead
+    uint64_t step;
+    switch (rng() % 8) {
+    case 0:
+      step = rng() % (1ull << 20);
+      break;
+    case 1:
+      step = rng() % (1ull << 34);
+      break;
+    default:
+      step = 1 + rng() % 300;
+      break;
+    }
+    const uint64_t target = now + step;
+
+    expired.clear();
+    auto start = Clock::now();
+    wheel.Advance(target, expired);
+    advanceMs += ElapsedMs(start);
+    expiredTotal += expired.size();
+
+    // Expected: every reference timer due by the target, in due order
+    // (order within one tick is unspecified)
+    auto end = reference.upper_bound(target);
+    size_t expectedCount = (size_t)std::distance(reference.begin(), end);
+    uint64_t lastDue = 0;
+    for (uint64_t payload : expired) {
+      auto due = dues.find(payload);
+      if (due == dues.end() || ids.find(payload) == ids.end()) {
+        missingErrors++; // cancelled or fired twice
+        continue;
+      }
+      if (due->second > target || due->second < lastDue)
+        orderErrors++;
+      lastDue = due->second;
+      fired.push_back(ids[payload]);
+      ids.erase(payload);
+    }
+    if (expired.size() != expectedCount)
+      missingErrors++;
+    reference.erase(reference.begin(), end);
+    if (wheel.GetPendingCount() != reference.size() ||
+        wheel.GetCurrentTick() != target)
+      missingErrors++;
+    if (fired.size() > 4096)
+      fired.erase(fired.begin(), fired.begin() + 2048);
+  }
+
+  // Drain everything that is left, long delays included
+  expired.clear();
+  uint64_t last = reference.empty() ? wheel.GetCurrentTick()
+                                    : reference.rbegin()->first;
+  wheel.Advance(last, expired);
+  if (expired.size() != reference.size() || wheel.GetPendingCount() != 0)
+    missingErrors++;
+  expiredTotal += expired.size();
+
+  std::cout << "  " << scheduled << " timers (" << sameSlot
+            << " sharing a slot), " << cancelled << " cancelled, "
+            << expiredTotal << " fired" << std::endl;
+  std::cout << "  schedule " << scheduleMs * 1e6 / (double)scheduled
+            << " ns, advance " << advanceMs * 1e3 / rounds << " us/round"
+            << std::endl;
+
+  size_t errors = orderErrors + missingErrors + cancelErrors;
+  std::cout << "  validation errors: " << errors << std::endl;
+  return errors == 0 ? 0 : 1;
+}
+
+static Registrar s_TimerWheelBench(
+    "timerwheel", "Timer wheel vs sorted reference: cascades, cancels",
+    RunTimerWheelBench);
+
+} // namespace Forge::Bench
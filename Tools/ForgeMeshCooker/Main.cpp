@@ -0,0 +1,213 @@
+#include "Asset/MeshCooker.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Offline mesh cooker: imports source meshes and writes GPU-ready .fmesh
+// files (optimized, quantized, with LODs and meshlets). Files are cooked in
+// parallel; outputs newer than their input are skipped unless --force.
+// Usage: ForgeMeshCooker [--option=value ...] <mesh|directory>...
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void PrintUsage() {
+  std::cout
+      << "Usage: ForgeMeshCooker [options] <mesh|directory>...\n"
+         "  --out=<dir>              output directory (default: next to "
+         "the input)\n"
+         "  --lods=<n>               LODs including LOD 0 (default 4, max 8)\n"
+         "  --lod-reduction=<f>      triangle ratio between LODs (0.5)\n"
+         "  --lod-error=<f>          max simplification error, fraction of "
+         "the bounds diagonal (0.02)\n"
+         "  --meshlet-vertices=<n>   (64, max 256)\n"
+         "  --meshlet-triangles=<n>  (124)\n"
+         "  --no-overdraw            vertex cache order only\n"
+         "  --workers=<n>            worker threads (default: cores - 1)\n"
+         "  --force                  re-cook up-to-date outputs\n"
+         "  --stats                  per-file statistics (runs the overdraw "
+         "analysis)\n";
+}
+
+bool IsMeshSource(const fs::path &path) {
+  std::string extension = path.extension().string();
+  for (char &c : extension)
+    c = (char)std::tolower((unsigned char)c);
+  return extension == ".obj" || extension == ".fbx";
+}
+
+struct CookJob {
+  std::string Input;
+  std::string Output;
+  bool UpToDate = false;
+  bool Succeeded = false;
+  std::string Error;
+  Forge::MeshCookStats Stats;
+  double Milliseconds = 0.0;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  using namespace Forge;
+
+  MeshCookSettings settings;
+  std::string outDirectory;
+  uint32_t workers = 0;
+  bool force = false;
+  std::vector<std::string> inputs;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    auto value = [&](const char *name, std::string &out) {
+      std::string prefix = std::string("--") + name + "=";
+      if (arg.rfind(prefix, 0) != 0)
+        return false;
+      out = arg.substr(prefix.size());
+      return true;
+    };
+    std::string text;
+    try {
+      if (value("out", text))
+        outDirectory = text;
+      else if (value("lods", text))
+        settings.MaxLODs = (uint32_t)std::stoul(text);
+      else if (value("lod-reduction", text))
+        settings.LODReduction = std::stof(text);
+      else if (value("lod-error", text))
+        settings.LODMaxError = std::stof(text);
+      else if (value("meshlet-vertices", text))
+        settings.MeshletMaxVertices = (uint32_t)std::stoul(text);
+      else if (value("meshlet-triangles", text))
+        settings.MeshletMaxTriangles = (uint32_t)std::stoul(text);
+      else if (value("workers", text))
+        workers = (uint32_t)std::stoul(text);
+      else if (arg == "--no-overdraw")
+        settings.OptimizeOverdraw = false;
+      else if (arg == "--force")
+        force = true;
+      else if (arg == "--stats")
+        settings.Analyze = true;
+      else if (arg == "--help" || arg == "-h") {
+        PrintUsage();
+        return 0;
+      } else if (arg.rfind("--", 0) == 0) {
+        std::cerr << "[MeshCooker] Unknown option " << arg << std::endl;
+        return 1;
+      } else {
+        inputs.push_back(arg);
+      }
+    } catch (const std::exception &) {
+      std::cerr << "[MeshCooker] Bad value in " << arg << std::endl;
+      return 1;
+    }
+  }
+  if (inputs.empty()) {
+    PrintUsage();
+    return 1;
+  }
+
+  // Expand directories (recursively) into their mesh sources
+  std::vector<CookJob> jobs;
+  auto addJob = [&](const fs::path &input) {
+    CookJob job;
+    job.Input = input.string();
+    fs::path output = input;
+    output.replace_extension(".fmesh");
+    if (!outDirectory.empty())
+      output = fs::path(outDirectory) / output.filename();
+    job.Output = output.string();
+    jobs.push_back(job);
+  };
+  for (const std::string &input : inputs) {
+    std::error_code ec;
+    if (fs::is_directory(input, ec)) {
+      std::vector<fs::path> found;
+      for (const auto &entry : fs::recursive_directory_iterator(input, ec)) {
+        if (entry.is_regular_file() && IsMeshSource(entry.path()))
+          found.push_back(entry.path());
+      }
+      std::sort(found.begin(), found.end());
+      for (const fs::path &path : found)
+        addJob(path);
+    } else if (fs::exists(input, ec)) {
+      addJob(input);
+    } else {
+      std::cerr << "[MeshCooker] Not found: " << input << std::endl;
+      return 1;
+    }
+  }
+
+  for (CookJob &job : jobs) {
+    std::error_code inputError, outputError;
+    auto inputTime = fs::last_write_time(job.Input, inputError);
+    auto outputTime = fs::last_write_time(job.Output, outputError);
+    job.UpToDate = !force && !inputError && !outputError &&
+                   outputTime >= inputTime;
+  }
+
+  // One file per batch: meshes vary wildly in size
+  auto start = std::chrono::steady_clock::now();
+  JobSystem jobSystem(workers);
+  jobSystem.ParallelFor(
+      (uint32_t)jobs.size(), 1, [&](uint32_t begin, uint32_t end, uint32_t) {
+        for (uint32_t i = begin; i < end; i++) {
+          CookJob &job = jobs[i];
+          if (job.UpToDate)
+            continue;
+          auto fileStart = std::chrono::steady_clock::now();
+          job.Succeeded = CookMeshFile(job.Input, job.Output, settings,
+                                       &job.Stats, job.Error);
+          job.Milliseconds = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - fileStart)
+                                 .count();
+        }
+      });
+  double totalMs = std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  uint32_t cooked = 0, upToDate = 0, failed = 0;
+  for (const CookJob &job : jobs) {
+    if (job.UpToDate) {
+      upToDate++;
+      continue;
+    }
+    if (!job.Succeeded) {
+      failed++;
+      std::cerr << "[MeshCooker] " << job.Input << ": " << job.Error
+                << std::endl;
+      continue;
+    }
+    cooked++;
+    const MeshCookStats &stats = job.Stats;
+    std::cout << "[MeshCooker] " << job.Input << " -> " << job.Output << " ("
+              << stats.Vertices << " vertices, " << stats.LODTriangles[0]
+              << " triangles, " << stats.LODs << " LODs, " << stats.Meshlets
+              << " meshlets, " << stats.Bytes / 1024 << " KB, "
+              << job.Milliseconds << " ms)" << std::endl;
+    if (settings.Analyze) {
+      std::cout << "  ACMR " << stats.ACMRBefore << " -> " << stats.ACMRAfter
+                << ", overdraw " << stats.OverdrawBefore << " -> "
+                << stats.OverdrawAfter << ", position error "
+                << stats.MaxPositionError << std::endl;
+      std::cout << "  LOD triangles / error:";
+      for (uint32_t lod = 0; lod < stats.LODs; lod++) {
+        std::cout << " " << stats.LODTriangles[lod] << "/"
+                  << stats.LODErrors[lod];
+      }
+      std::cout << std::endl;
+    }
+  }
+  std::cout << "[MeshCooker] " << cooked << " cooked, " << upToDate
+            << " up to date, " << failed << " failed in " << totalMs
+            << " ms (" << jobSystem.GetThreadCount() << " threads)"
+            << std::endl;
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+#include "Asset/TextureCooker.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Offline texture cooker: imports PNG images and writes block-compressed
+// DDS files with full mip chains. Files are cooked one after another, each
+// one's block rows in parallel; outputs newer than their input are skipped
+// unless --force.
+// Usage: ForgeTextureCooker [--option=value ...] <image|directory>...
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void PrintUsage() {
+  std::cout
+      << "Usage: ForgeTextureCooker [options] <image|directory>...\n"
+         "  --out=<dir>         output directory (default: next to the "
+         "input)\n"
+         "  --format=<f>        auto, bc1, bc3, bc5 or bc7 (default auto)\n"
+         "  --preset=<p>        fast, normal or high (default normal)\n"
+         "  --kind=<k>          color (sRGB), linear or normal (default: "
+         "normal for *_n / *_normal files, else color)\n"
+         "  --no-mips           mip 0 only\n"
+         "  --workers=<n>       worker threads (default: cores - 1)\n"
+         "  --force             re-cook up-to-date outputs\n"
+         "  --stats             decode the result and report PSNR\n";
+}
+
+std::string Lower(std::string text) {
+  for (char &c : text)
+    c = (char)std::tolower((unsigned char)c);
+  return text;
+}
+
+bool IsImageSource(const fs::path &path) {
+  return Lower(path.extension().string()) == ".png";
+}
+
+bool IsNormalMapName(const fs::path &path) {
+  std::string stem = Lower(path.stem().string());
+  auto endsWith = [&](const std::string &suffix) {
+    return stem.size() >= suffix.size() &&
+           stem.compare(stem.size() - suffix.size(), suffix.size(), suffix) ==
+               0;
+  };
+  return endsWith("_n") || endsWith("_normal");
+}
+
+const char *GetFormatName(Forge::RHIFormat format) {
+  switch (format) {
+  case Forge::RHIFormat::BC1_UNorm:
+  case Forge::RHIFormat::BC1_UNorm_sRGB:
+    return "BC1";
+  case Forge::RHIFormat::BC3_UNorm:
+  case Forge::RHIFormat::BC3_UNorm_sRGB:
+    return "BC3";
+  case Forge::RHIFormat::BC5_UNorm:
+    return "BC5";
+  default:
+    return "BC7";
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  using namespace Forge;
+
+  TextureCookSettings settings;
+  bool kindSet = false;
+  std::string outDirectory;
+  uint32_t workers = 0;
+  bool force = false;
+  std::vector<std::string> inputs;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    auto value = [&](const char *name, std::string &out) {
+      std::string prefix = std::string("--") + name + "=";
+      if (arg.rfind(prefix, 0) != 0)
+        return false;
+      out = arg.substr(prefix.size());
+      return true;
+    };
+    std::string text;
+    bool valid = true;
+    try {
+      if (value("out", text)) {
+        outDirectory = text;
+      } else if (value("format", text)) {
+        text = Lower(text);
+        static const char *names[] = {"auto", "bc1", "bc3", "bc5", "bc7"};
+        auto found = std::find(std::begin(names), std::end(names), text);
+        valid = found != std::end(names);
+        settings.Format = (TextureFormat)(found - std::begin(names));
+      } else if (value("preset", text)) {
+        text = Lower(text);
+        valid = text == "fast" || text == "normal" || text == "high";
+        settings.Quality = text == "fast"   ? BCQuality::Fast
+                           : text == "high" ? BCQuality::High
+                                            : BCQuality::Normal;
+      } else if (value("kind", text)) {
+        text = Lower(text);
+        valid = text == "color" || text == "linear" || text == "normal";
+        settings.Kind = text == "linear"   ? TextureKind::Linear
+                        : text == "normal" ? TextureKind::NormalMap
+                                           : TextureKind::Color;
+        kindSet = true;
+      } else if (value("workers", text)) {
+        workers = (uint32_t)std::stoul(text);
+      } else if (arg == "--no-mips") {
+        settings.GenerateMips = false;
+      } else if (arg == "--force") {
+        force = true;
+      } else if (arg == "--stats") {
+        settings.Analyze = true;
+      } else if (arg == "--help" || arg == "-h") {
+        PrintUsage();
+        return 0;
+      } else if (arg.rfind("--", 0) == 0) {
+        std::cerr << "[TextureCooker] Unknown option " << arg << std::endl;
+        return 1;
+      } else {
+        inputs.push_back(arg);
+      }
+    } catch (const std::exception &) {
+      valid = false;
+    }
+    if (!valid) {
+      std::cerr << "[TextureCooker] Bad value in " << arg << std::endl;
+      return 1;
+    }
+  }
+  if (inputs.empty()) {
+    PrintUsage();
+    return 1;
+  }
+
+  // Expand directories (recursively) into their image sources
+  std::vector<fs::path> sources;
+  for (const std::string &input : inputs) {
+    std::error_code ec;
+    if (fs::is_directory(input, ec)) {
+      std::vector<fs::path> found;
+      for (const auto &entry : fs::recursive_directory_iterator(input, ec)) {
+        if (entry.is_regular_file() && IsImageSource(entry.path()))
+          found.push_back(entry.path());
+      }
+      std::sort(found.begin(), found.end());
+      sources.insert(sources.end(), found.begin(), found.end());
+    } else if (fs::exists(input, ec)) {
+      sources.push_back(input);
+    } else {
+      std::cerr << "[TextureCooker] Not found: " << input << std::endl;
+      return 1;
+    }
+  }
+
+  JobSystem jobSystem(workers);
+  uint32_t cooked = 0, upToDate = 0, failed = 0;
+  uint64_t pixels = 0;
+  double encodeMs = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (const fs::path &input : sources) {
+    fs::path output = input;
+    output.replace_extension(".dds");
+    if (!outDirectory.empty())
+      output = fs::path(outDirectory) / output.filename();
+
+    std::error_code inputError, outputError;
+    auto inputTime = fs::last_write_time(input, inputError);
+    auto outputTime = fs::last_write_time(output, outputError);
+    if (!force && !inputError && !outputError && outputTime >= inputTime) {
+      upToDate++;
+      continue;
+    }
+
+    TextureCookSettings fileSettings = settings;
+    if (!kindSet && IsNormalMapName(input))
+      fileSettings.Kind = TextureKind::NormalMap;
+    TextureCookStats stats;
+    std::string error;
+    if (!CookTextureFile(input.string(), output.string(), fileSettings,
+                         &stats, error, &jobSystem)) {
+      failed++;
+      std::cerr << "[TextureCooker] " << input.string() << ": " << error
+                << std::endl;
+      continue;
+    }
+    cooked++;
+    pixels += stats.SourceBytes / 4;
+    encodeMs += stats.EncodeMs;
+    std::cout << "[TextureCooker] " << input.string() << " -> "
+              << output.string() << " (" << stats.Width << "x"
+              << stats.Height << " " << GetFormatName(stats.Format) << ", "
+              << stats.Mips << " mips, " << stats.SourceBytes / 1024
+              << " KB -> " << stats.Bytes / 1024 << " KB, mips "
+              << stats.MipMs << " ms, encode " << stats.EncodeMs << " ms, "
+              << stats.MPixelsPerSecond << " MPix/s)" << std::endl;
+    if (fileSettings.Analyze) {
+      std::cout << "  PSNR color " << stats.ColorPSNR << " dB, alpha "
+                << stats.AlphaPSNR << " dB" << std::endl;
+    }
+  }
+  double totalMs = std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  std::cout << "[TextureCooker] " << cooked << " cooked, " << upToDate
+            << " up to date, " << failed << " failed in " << totalMs
+            << " ms (" << jobSystem.GetThreadCount() << " threads, "
+            << (encodeMs > 0.0 ? pixels / (encodeMs * 1000.0) : 0.0)
+            << " MPix/s encoded)" << std::endl;
+  return failed == 0 ? 0 : 1;
+}